@@ -28,6 +28,7 @@ private:
 /// \brief A stream writer that hashes the data written to it.
 ///
 /// This stream writer allows to conveniently generate a 64 bit hash value for any kind of data.
+/// The hash function depends on NS_HASHING_VERSION, by default the result is identical to nsHashingUtils::xxHash3_64() over all written bytes.
 class NS_FOUNDATION_DLL nsHashStreamWriter64 : public nsStreamWriter
 {
 public:
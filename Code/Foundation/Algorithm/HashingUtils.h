@@ -7,9 +7,25 @@
 class NS_FOUNDATION_DLL nsHashingUtils
 {
 public:
+  /// \brief A 128 bit hash value, as computed by xxHash3_128().
+  struct Hash128
+  {
+    nsUInt64 m_uiLow = 0;
+    nsUInt64 m_uiHigh = 0;
+
+    bool operator==(const Hash128& rhs) const { return m_uiLow == rhs.m_uiLow && m_uiHigh == rhs.m_uiHigh; }
+    bool operator!=(const Hash128& rhs) const { return !(*this == rhs); }
+  };
+
   /// \brief Calculates the CRC32 checksum of the given key.
   static nsUInt32 CRC32Hash(const void* pKey, size_t uiSizeInBytes); // [tested]
 
+  /// \brief Calculates the CRC32C (Castagnoli) checksum of the given key.
+  ///
+  /// Uses the SSE4.2 or ARMv8 CRC32 instructions, if the CPU supports them, and a table based fallback otherwise.
+  /// Pass the result of a previous call as uiCrc to continue the checksum over several pieces of data.
+  static nsUInt32 CRC32cHash(const void* pKey, size_t uiSizeInBytes, nsUInt32 uiCrc = 0); // [tested]
+
   /// \brief Calculates the 32bit murmur hash of the given key.
   static nsUInt32 MurmurHash32(const void* pKey, size_t uiSizeInByte, nsUInt32 uiSeed = 0); // [tested]
 
@@ -31,6 +47,12 @@ public:
   /// \brief Calculates the 64bit xxHash of the given key.
   static nsUInt64 xxHash64(const void* pKey, size_t uiSizeInByte, nsUInt64 uiSeed = 0); // [tested]
 
+  /// \brief Calculates the 64bit XXH3 hash of the given key. Considerably faster than xxHash64, especially for short keys.
+  static nsUInt64 xxHash3_64(const void* pKey, size_t uiSizeInByte, nsUInt64 uiSeed = 0); // [tested]
+
+  /// \brief Calculates the 128bit XXH3 hash of the given key.
+  static Hash128 xxHash3_128(const void* pKey, size_t uiSizeInByte, nsUInt64 uiSeed = 0); // [tested]
+
   /// \brief Calculates the 32bit xxHash of the given string literal at compile time.
   template <size_t N>
   constexpr static nsUInt32 xxHash32String(const char (&str)[N], nsUInt32 uiSeed = 0); // [tested]
@@ -39,6 +61,10 @@ public:
   template <size_t N>
   constexpr static nsUInt64 xxHash64String(const char (&str)[N], nsUInt64 uiSeed = 0); // [tested]
 
+  /// \brief Calculates the 64bit XXH3 hash of the given string literal at compile time.
+  template <size_t N>
+  constexpr static nsUInt64 xxHash3_64String(const char (&str)[N], nsUInt64 uiSeed = 0); // [tested]
+
   /// \brief Calculates the 32bit xxHash of a string pointer during runtime.
   ///
   /// We cannot pass a string pointer directly since a string constant would be treated as pointer as well.
@@ -49,7 +75,14 @@ public:
   /// We cannot pass a string pointer directly since a string constant would be treated as pointer as well.
   static nsUInt64 xxHash64String(nsStringView sStr, nsUInt64 uiSeed = 0); // [tested]
 
+  /// \brief Calculates the 64bit XXH3 hash of a string pointer during runtime.
+  ///
+  /// We cannot pass a string pointer directly since a string constant would be treated as pointer as well.
+  static nsUInt64 xxHash3_64String(nsStringView sStr, nsUInt64 uiSeed = 0); // [tested]
+
   /// \brief Calculates the hash of the given string literal at compile time.
+  ///
+  /// Which hash function is used depends on NS_HASHING_VERSION (XXH3 by default, xxHash64 for version 1).
   template <size_t N>
   constexpr static nsUInt64 StringHash(const char (&str)[N], nsUInt64 uiSeed = 0); // [tested]
 
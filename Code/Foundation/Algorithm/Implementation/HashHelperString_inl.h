@@ -6,7 +6,7 @@ nsUInt32 nsHashHelperString_NoCase::Hash(nsStringView value)
   nsMemoryUtils::Copy(temp.GetData(), value.GetStartPointer(), value.GetElementCount());
   const nsUInt32 uiElemCount = nsStringUtils::ToLowerString(temp.GetData(), temp.GetData() + value.GetElementCount());
 
-  return nsHashingUtils::StringHashTo32(nsHashingUtils::xxHash64((void*)temp.GetData(), uiElemCount));
+  return nsHashingUtils::StringHashTo32(nsHashingUtils::StringHash(nsStringView(temp.GetData(), uiElemCount)));
 }
 
 bool nsHashHelperString_NoCase::Equal(nsStringView lhs, nsStringView rhs)
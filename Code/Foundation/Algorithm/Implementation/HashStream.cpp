@@ -40,13 +40,22 @@ nsUInt32 nsHashStreamWriter32::GetHashValue() const
 
 nsHashStreamWriter64::nsHashStreamWriter64(nsUInt64 uiSeed)
 {
+#if NS_HASHING_VERSION >= 2
+  m_pState = XXH3_createState();
+  NS_VERIFY(XXH_OK == XXH3_64bits_reset_withSeed((XXH3_state_t*)m_pState, uiSeed), "");
+#else
   m_pState = XXH64_createState();
   NS_VERIFY(XXH_OK == XXH64_reset((XXH64_state_t*)m_pState, uiSeed), "");
+#endif
 }
 
 nsHashStreamWriter64::~nsHashStreamWriter64()
 {
+#if NS_HASHING_VERSION >= 2
+  XXH3_freeState((XXH3_state_t*)m_pState);
+#else
   XXH64_freeState((XXH64_state_t*)m_pState);
+#endif
 }
 
 nsResult nsHashStreamWriter64::WriteBytes(const void* pWriteBuffer, nsUInt64 uiBytesToWrite)
@@ -57,13 +66,22 @@ nsResult nsHashStreamWriter64::WriteBytes(const void* pWriteBuffer, nsUInt64 uiB
   if (uiBytesToWrite > std::numeric_limits<size_t>::max())
     return NS_FAILURE;
 
+#if NS_HASHING_VERSION >= 2
+  if (XXH_OK == XXH3_64bits_update((XXH3_state_t*)m_pState, pWriteBuffer, static_cast<size_t>(uiBytesToWrite)))
+    return NS_SUCCESS;
+#else
   if (XXH_OK == XXH64_update((XXH64_state_t*)m_pState, pWriteBuffer, static_cast<size_t>(uiBytesToWrite)))
     return NS_SUCCESS;
+#endif
 
   return NS_FAILURE;
 }
 
 nsUInt64 nsHashStreamWriter64::GetHashValue() const
 {
+#if NS_HASHING_VERSION >= 2
+  return XXH3_64bits_digest((XXH3_state_t*)m_pState);
+#else
   return XXH64_digest((XXH64_state_t*)m_pState);
+#endif
 }
@@ -1,7 +1,15 @@
 #include <Foundation/FoundationPCH.h>
 
 #include <Foundation/Algorithm/HashingUtils.h>
+#include <Foundation/Memory/EndianHelper.h>
 #include <Foundation/Memory/MemoryUtils.h>
+#include <Foundation/System/SystemInformation.h>
+
+#if NS_ENABLED(NS_PLATFORM_ARCH_X86)
+#  include <nmmintrin.h>
+#elif NS_ENABLED(NS_PLATFORM_ARCH_ARM) && defined(__ARM_FEATURE_CRC32)
+#  include <arm_acle.h>
+#endif
 
 // static
 nsUInt32 nsHashingUtils::MurmurHash32(const void* pKey, size_t uiSizeInByte, nsUInt32 uiSeed /*= 0*/)
@@ -198,6 +206,184 @@ nsUInt32 nsHashingUtils::CRC32Hash(const void* pKey, size_t uiSizeInBytes)
   return static_cast<nsUInt32>(uiCRC32 ^ 0xFFFFFFFF);
 }
 
+namespace
+{
+  /// \brief Lookup tables for CRC32C (Castagnoli polynomial, reflected) that process 8 bytes per step ('slicing-by-8').
+  struct nsCRC32cTable
+  {
+    constexpr nsCRC32cTable()
+    {
+      for (nsUInt32 i = 0; i < 256; ++i)
+      {
+        nsUInt32 uiCrc = i;
+        for (nsUInt32 bit = 0; bit < 8; ++bit)
+        {
+          uiCrc = (uiCrc >> 1) ^ ((uiCrc & 1) ? 0x82F63B78u : 0u);
+        }
+
+        m_Values[0][i] = uiCrc;
+      }
+
+      for (nsUInt32 i = 0; i < 256; ++i)
+      {
+        for (nsUInt32 slice = 1; slice < 8; ++slice)
+        {
+          const nsUInt32 uiPrev = m_Values[slice - 1][i];
+          m_Values[slice][i] = (uiPrev >> 8) ^ m_Values[0][uiPrev & 0xFF];
+        }
+      }
+    }
+
+    nsUInt32 m_Values[8][256] = {};
+  };
+
+  static constexpr nsCRC32cTable s_CRC32cTable;
+
+  nsUInt32 CRC32cSoftware(const nsUInt8* pData, size_t uiSizeInBytes, nsUInt32 uiCrc)
+  {
+    const auto& t = s_CRC32cTable.m_Values;
+
+    while (uiSizeInBytes >= 8)
+    {
+      nsUInt32 uiLo = 0;
+      nsUInt32 uiHi = 0;
+      memcpy(&uiLo, pData, 4);
+      memcpy(&uiHi, pData + 4, 4);
+
+#if NS_ENABLED(NS_PLATFORM_BIG_ENDIAN)
+      uiLo = nsEndianHelper::Switch(uiLo);
+      uiHi = nsEndianHelper::Switch(uiHi);
+#endif
+
+      uiLo ^= uiCrc;
+      uiCrc = t[7][uiLo & 0xFF] ^ t[6][(uiLo >> 8) & 0xFF] ^ t[5][(uiLo >> 16) & 0xFF] ^ t[4][uiLo >> 24] ^
+              t[3][uiHi & 0xFF] ^ t[2][(uiHi >> 8) & 0xFF] ^ t[1][(uiHi >> 16) & 0xFF] ^ t[0][uiHi >> 24];
+
+      pData += 8;
+      uiSizeInBytes -= 8;
+    }
+
+    while (uiSizeInBytes > 0)
+    {
+      uiCrc = (uiCrc >> 8) ^ t[0][(uiCrc ^ *pData) & 0xFF];
+      ++pData;
+      --uiSizeInBytes;
+    }
+
+    return uiCrc;
+  }
+
+#if NS_ENABLED(NS_PLATFORM_ARCH_X86)
+
+  // the SSE4.2 instructions are only used after checking the CPU features, so this function is compiled for SSE4.2 independent of NS_SSE_LEVEL
+#  if NS_ENABLED(NS_COMPILER_GCC) || NS_ENABLED(NS_COMPILER_CLANG)
+#    define NS_CRC32C_TARGET __attribute__((target("sse4.2")))
+#  else
+#    define NS_CRC32C_TARGET
+#  endif
+
+  NS_CRC32C_TARGET nsUInt32 CRC32cHardware(const nsUInt8* pData, size_t uiSizeInBytes, nsUInt32 uiCrc)
+  {
+#  if NS_ENABLED(NS_PLATFORM_64BIT)
+    nsUInt64 uiCrc64 = uiCrc;
+    while (uiSizeInBytes >= 8)
+    {
+      nsUInt64 uiValue = 0;
+      memcpy(&uiValue, pData, 8);
+      uiCrc64 = _mm_crc32_u64(uiCrc64, uiValue);
+      pData += 8;
+      uiSizeInBytes -= 8;
+    }
+    uiCrc = static_cast<nsUInt32>(uiCrc64);
+#  endif
+
+    while (uiSizeInBytes >= 4)
+    {
+      nsUInt32 uiValue = 0;
+      memcpy(&uiValue, pData, 4);
+      uiCrc = _mm_crc32_u32(uiCrc, uiValue);
+      pData += 4;
+      uiSizeInBytes -= 4;
+    }
+
+    while (uiSizeInBytes > 0)
+    {
+      uiCrc = _mm_crc32_u8(uiCrc, *pData);
+      ++pData;
+      --uiSizeInBytes;
+    }
+
+    return uiCrc;
+  }
+
+#  undef NS_CRC32C_TARGET
+
+  bool HasHardwareCRC32c()
+  {
+    static const bool s_bSupported = nsSystemInformation::Get().GetCpuFeatures().HW_SSE42;
+    return s_bSupported;
+  }
+
+#elif NS_ENABLED(NS_PLATFORM_ARCH_ARM) && defined(__ARM_FEATURE_CRC32)
+
+  nsUInt32 CRC32cHardware(const nsUInt8* pData, size_t uiSizeInBytes, nsUInt32 uiCrc)
+  {
+    while (uiSizeInBytes >= 8)
+    {
+      nsUInt64 uiValue = 0;
+      memcpy(&uiValue, pData, 8);
+      uiCrc = __crc32cd(uiCrc, uiValue);
+      pData += 8;
+      uiSizeInBytes -= 8;
+    }
+
+    while (uiSizeInBytes > 0)
+    {
+      uiCrc = __crc32cb(uiCrc, *pData);
+      ++pData;
+      --uiSizeInBytes;
+    }
+
+    return uiCrc;
+  }
+
+  // the compiler only defines __ARM_FEATURE_CRC32 when the target architecture guarantees the instructions
+  constexpr bool HasHardwareCRC32c()
+  {
+    return true;
+  }
+
+#else
+
+  nsUInt32 CRC32cHardware(const nsUInt8* pData, size_t uiSizeInBytes, nsUInt32 uiCrc)
+  {
+    return CRC32cSoftware(pData, uiSizeInBytes, uiCrc);
+  }
+
+  constexpr bool HasHardwareCRC32c()
+  {
+    return false;
+  }
+
+#endif
+} // namespace
+
+// static
+nsUInt32 nsHashingUtils::CRC32cHash(const void* pKey, size_t uiSizeInBytes, nsUInt32 uiCrc /*= 0*/)
+{
+  if (pKey == nullptr || uiSizeInBytes == 0)
+    return uiCrc;
+
+  const nsUInt8* pData = static_cast<const nsUInt8*>(pKey);
+
+  if (HasHardwareCRC32c())
+  {
+    return ~CRC32cHardware(pData, uiSizeInBytes, ~uiCrc);
+  }
+
+  return ~CRC32cSoftware(pData, uiSizeInBytes, ~uiCrc);
+}
+
 NS_WARNING_PUSH()
 NS_WARNING_DISABLE_CLANG("-Wunused-function")
 
@@ -217,3 +403,20 @@ nsUInt64 nsHashingUtils::xxHash64(const void* pKey, size_t uiSizeInByte, nsUInt6
 {
   return XXH64(pKey, uiSizeInByte, uiSeed);
 }
+
+// static
+nsUInt64 nsHashingUtils::xxHash3_64(const void* pKey, size_t uiSizeInByte, nsUInt64 uiSeed /*= 0*/)
+{
+  return XXH3_64bits_withSeed(pKey, uiSizeInByte, uiSeed);
+}
+
+// static
+nsHashingUtils::Hash128 nsHashingUtils::xxHash3_128(const void* pKey, size_t uiSizeInByte, nsUInt64 uiSeed /*= 0*/)
+{
+  const XXH128_hash_t hash = XXH3_128bits_withSeed(pKey, uiSizeInByte, uiSeed);
+
+  Hash128 res;
+  res.m_uiLow = hash.low64;
+  res.m_uiHigh = hash.high64;
+  return res;
+}
@@ -127,12 +127,20 @@ struct nsHashHelper<T*>
 template <size_t N>
 constexpr NS_ALWAYS_INLINE nsUInt64 nsHashingUtils::StringHash(const char (&str)[N], nsUInt64 uiSeed)
 {
+#if NS_HASHING_VERSION >= 2
+  return xxHash3_64String(str, uiSeed);
+#else
   return xxHash64String(str, uiSeed);
+#endif
 }
 
 NS_ALWAYS_INLINE nsUInt64 nsHashingUtils::StringHash(nsStringView sStr, nsUInt64 uiSeed)
 {
+#if NS_HASHING_VERSION >= 2
+  return xxHash3_64String(sStr, uiSeed);
+#else
   return xxHash64String(sStr, uiSeed);
+#endif
 }
 
 constexpr NS_ALWAYS_INLINE nsUInt32 nsHashingUtils::StringHashTo32(nsUInt64 uiHash)
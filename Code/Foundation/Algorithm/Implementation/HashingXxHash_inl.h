@@ -174,6 +174,234 @@ namespace nsInternal
       return acc;
     }
   }
+
+  // XXH3, see Foundation/ThirdParty/xxHash/xxhash.h for the reference implementation
+
+  constexpr nsUInt8 XXH3_SECRET[192] = {
+    0xb8, 0xfe, 0x6c, 0x39, 0x23, 0xa4, 0x4b, 0xbe, 0x7c, 0x01, 0x81, 0x2c, 0xf7, 0x21, 0xad, 0x1c,
+    0xde, 0xd4, 0x6d, 0xe9, 0x83, 0x90, 0x97, 0xdb, 0x72, 0x40, 0xa4, 0xa4, 0xb7, 0xb3, 0x67, 0x1f,
+    0xcb, 0x79, 0xe6, 0x4e, 0xcc, 0xc0, 0xe5, 0x78, 0x82, 0x5a, 0xd0, 0x7d, 0xcc, 0xff, 0x72, 0x21,
+    0xb8, 0x08, 0x46, 0x74, 0xf7, 0x43, 0x24, 0x8e, 0xe0, 0x35, 0x90, 0xe6, 0x81, 0x3a, 0x26, 0x4c,
+    0x3c, 0x28, 0x52, 0xbb, 0x91, 0xc3, 0x00, 0xcb, 0x88, 0xd0, 0x65, 0x8b, 0x1b, 0x53, 0x2e, 0xa3,
+    0x71, 0x64, 0x48, 0x97, 0xa2, 0x0d, 0xf9, 0x4e, 0x38, 0x19, 0xef, 0x46, 0xa9, 0xde, 0xac, 0xd8,
+    0xa8, 0xfa, 0x76, 0x3f, 0xe3, 0x9c, 0x34, 0x3f, 0xf9, 0xdc, 0xbb, 0xc7, 0xc7, 0x0b, 0x4f, 0x1d,
+    0x8a, 0x51, 0xe0, 0x4b, 0xcd, 0xb4, 0x59, 0x31, 0xc8, 0x9f, 0x7e, 0xc9, 0xd9, 0x78, 0x73, 0x64,
+    0xea, 0xc5, 0xac, 0x83, 0x34, 0xd3, 0xeb, 0xc3, 0xc5, 0x81, 0xa0, 0xff, 0xfa, 0x13, 0x63, 0xeb,
+    0x17, 0x0d, 0xdd, 0x51, 0xb7, 0xf0, 0xda, 0x49, 0xd3, 0x16, 0x55, 0x26, 0x29, 0xd4, 0x68, 0x9e,
+    0x2b, 0x16, 0xbe, 0x58, 0x7d, 0x47, 0xa1, 0xfc, 0x8f, 0xf8, 0xb8, 0xd1, 0x7a, 0xd0, 0x31, 0xce,
+    0x45, 0xcb, 0x3a, 0x8f, 0x95, 0x16, 0x04, 0x28, 0xaf, 0xd7, 0xfb, 0xca, 0xbb, 0x4b, 0x40, 0x7e};
+
+  template <typename T>
+  constexpr nsUInt32 XXH3Read32(const T* pData)
+  {
+    return (static_cast<nsUInt32>(static_cast<nsUInt8>(pData[0])) << 0) | (static_cast<nsUInt32>(static_cast<nsUInt8>(pData[1])) << 8) |
+           (static_cast<nsUInt32>(static_cast<nsUInt8>(pData[2])) << 16) | (static_cast<nsUInt32>(static_cast<nsUInt8>(pData[3])) << 24);
+  }
+
+  template <typename T>
+  constexpr nsUInt64 XXH3Read64(const T* pData)
+  {
+    return static_cast<nsUInt64>(XXH3Read32(pData)) | (static_cast<nsUInt64>(XXH3Read32(pData + 4)) << 32);
+  }
+
+  constexpr nsUInt64 XXH3Swap64(nsUInt64 x)
+  {
+    return ((x << 56) & 0xff00000000000000ULL) | ((x << 40) & 0x00ff000000000000ULL) | ((x << 24) & 0x0000ff0000000000ULL) |
+           ((x << 8) & 0x000000ff00000000ULL) | ((x >> 8) & 0x00000000ff000000ULL) | ((x >> 24) & 0x0000000000ff0000ULL) |
+           ((x >> 40) & 0x000000000000ff00ULL) | ((x >> 56) & 0x00000000000000ffULL);
+  }
+
+  /// \brief Multiplies two 64 bit values to 128 bit and folds the result by xor-ing the upper and lower half.
+  constexpr nsUInt64 XXH3Mul128Fold64(nsUInt64 uiLhs, nsUInt64 uiRhs)
+  {
+    const nsUInt64 uiLoLo = (uiLhs & 0xFFFFFFFF) * (uiRhs & 0xFFFFFFFF);
+    const nsUInt64 uiHiLo = (uiLhs >> 32) * (uiRhs & 0xFFFFFFFF);
+    const nsUInt64 uiLoHi = (uiLhs & 0xFFFFFFFF) * (uiRhs >> 32);
+    const nsUInt64 uiHiHi = (uiLhs >> 32) * (uiRhs >> 32);
+
+    const nsUInt64 uiCross = (uiLoLo >> 32) + (uiHiLo & 0xFFFFFFFF) + uiLoHi;
+    const nsUInt64 uiUpper = (uiHiLo >> 32) + (uiCross >> 32) + uiHiHi;
+    const nsUInt64 uiLower = (uiCross << 32) | (uiLoLo & 0xFFFFFFFF);
+    return uiLower ^ uiUpper;
+  }
+
+  constexpr nsUInt64 XXH3Avalanche(nsUInt64 h)
+  {
+    h = h ^ (h >> 37);
+    h = h * 0x165667919E3779F9ULL;
+    return h ^ (h >> 32);
+  }
+
+  constexpr nsUInt64 XXH64Avalanche(nsUInt64 h)
+  {
+    h = h ^ (h >> 33);
+    h = h * PRIME64_2;
+    h = h ^ (h >> 29);
+    h = h * PRIME64_3;
+    return h ^ (h >> 32);
+  }
+
+  constexpr nsUInt64 XXH3Rrmxmx(nsUInt64 h, nsUInt64 uiLength)
+  {
+    h = h ^ (nsRotLeft(h, 49ULL) ^ nsRotLeft(h, 24ULL));
+    h = h * 0x9FB21C651E98DF25ULL;
+    h = h ^ ((h >> 35) + uiLength);
+    h = h * 0x9FB21C651E98DF25ULL;
+    return h ^ (h >> 28);
+  }
+
+  constexpr nsUInt64 XXH3Mix16B(const char* pInput, const nsUInt8* pSecret, nsUInt64 uiSeed)
+  {
+    return XXH3Mul128Fold64(XXH3Read64(pInput) ^ (XXH3Read64(pSecret) + uiSeed), XXH3Read64(pInput + 8) ^ (XXH3Read64(pSecret + 8) - uiSeed));
+  }
+
+  constexpr void XXH3Accumulate512(nsUInt64* pAcc, const char* pInput, const nsUInt8* pSecret)
+  {
+    for (nsUInt32 i = 0; i < 8; ++i)
+    {
+      const nsUInt64 uiData = XXH3Read64(pInput + 8 * i);
+      const nsUInt64 uiKey = uiData ^ XXH3Read64(pSecret + 8 * i);
+      pAcc[i ^ 1] += uiData;
+      pAcc[i] += (uiKey & 0xFFFFFFFF) * (uiKey >> 32);
+    }
+  }
+
+  constexpr nsUInt64 CompileTimeXxHash3_64Long(const char* str, nsUInt32 length, nsUInt64 uiSeed)
+  {
+    // a non-zero seed is applied to a copy of the secret
+    nsUInt8 secret[192] = {};
+    for (nsUInt32 i = 0; i < 192; i += 16)
+    {
+      const nsUInt64 uiLo = XXH3Read64(XXH3_SECRET + i) + uiSeed;
+      const nsUInt64 uiHi = XXH3Read64(XXH3_SECRET + i + 8) - uiSeed;
+
+      for (nsUInt32 b = 0; b < 8; ++b)
+      {
+        secret[i + b] = static_cast<nsUInt8>(uiLo >> (8 * b));
+        secret[i + 8 + b] = static_cast<nsUInt8>(uiHi >> (8 * b));
+      }
+    }
+
+    nsUInt64 acc[8] = {PRIME32_3, PRIME64_1, PRIME64_2, PRIME64_3, PRIME64_4, PRIME32_2, PRIME64_5, PRIME32_1};
+
+    constexpr nsUInt32 uiStripeLength = 64;
+    constexpr nsUInt32 uiStripesPerBlock = (192 - uiStripeLength) / 8;
+    constexpr nsUInt32 uiBlockLength = uiStripeLength * uiStripesPerBlock;
+    const nsUInt32 uiNumBlocks = (length - 1) / uiBlockLength;
+
+    for (nsUInt32 n = 0; n < uiNumBlocks; ++n)
+    {
+      for (nsUInt32 s = 0; s < uiStripesPerBlock; ++s)
+      {
+        XXH3Accumulate512(acc, str + n * uiBlockLength + s * uiStripeLength, secret + s * 8);
+      }
+
+      // scramble
+      for (nsUInt32 i = 0; i < 8; ++i)
+      {
+        nsUInt64 a = acc[i];
+        a = a ^ (a >> 47);
+        a = a ^ XXH3Read64(secret + 192 - uiStripeLength + 8 * i);
+        acc[i] = a * PRIME32_1;
+      }
+    }
+
+    const nsUInt32 uiNumStripes = ((length - 1) - (uiBlockLength * uiNumBlocks)) / uiStripeLength;
+    for (nsUInt32 s = 0; s < uiNumStripes; ++s)
+    {
+      XXH3Accumulate512(acc, str + uiNumBlocks * uiBlockLength + s * uiStripeLength, secret + s * 8);
+    }
+
+    XXH3Accumulate512(acc, str + length - uiStripeLength, secret + 192 - uiStripeLength - 7);
+
+    nsUInt64 result = length * PRIME64_1;
+    for (nsUInt32 i = 0; i < 4; ++i)
+    {
+      result += XXH3Mul128Fold64(acc[2 * i] ^ XXH3Read64(secret + 11 + 16 * i), acc[2 * i + 1] ^ XXH3Read64(secret + 11 + 16 * i + 8));
+    }
+
+    return XXH3Avalanche(result);
+  }
+
+  template <size_t N>
+  constexpr nsUInt64 CompileTimeXxHash3_64(const char (&str)[N], nsUInt64 uiSeed)
+  {
+    // Note: N will contain the trailing 0 of a string literal. This needs to be ignored.
+    constexpr nsUInt32 length = static_cast<nsUInt32>(N - 1);
+    const nsUInt8* secret = XXH3_SECRET;
+
+    if constexpr (length == 0)
+    {
+      return XXH64Avalanche(uiSeed ^ (XXH3Read64(secret + 56) ^ XXH3Read64(secret + 64)));
+    }
+    else if constexpr (length <= 3)
+    {
+      const nsUInt32 uiCombined = (static_cast<nsUInt32>(static_cast<nsUInt8>(str[0])) << 16) | (static_cast<nsUInt32>(static_cast<nsUInt8>(str[length >> 1])) << 24) |
+                                  (static_cast<nsUInt32>(static_cast<nsUInt8>(str[length - 1])) << 0) | (length << 8);
+      const nsUInt64 uiBitflip = (XXH3Read32(secret) ^ XXH3Read32(secret + 4)) + uiSeed;
+      return XXH64Avalanche(uiCombined ^ uiBitflip);
+    }
+    else if constexpr (length <= 8)
+    {
+      const nsUInt32 uiSeed32 = static_cast<nsUInt32>(uiSeed);
+      const nsUInt32 uiSwappedSeed32 = (uiSeed32 << 24) | ((uiSeed32 << 8) & 0x00ff0000) | ((uiSeed32 >> 8) & 0x0000ff00) | (uiSeed32 >> 24);
+      uiSeed = uiSeed ^ (static_cast<nsUInt64>(uiSwappedSeed32) << 32);
+
+      const nsUInt64 uiInput = XXH3Read32(str + length - 4) + (static_cast<nsUInt64>(XXH3Read32(str)) << 32);
+      const nsUInt64 uiBitflip = (XXH3Read64(secret + 8) ^ XXH3Read64(secret + 16)) - uiSeed;
+      return XXH3Rrmxmx(uiInput ^ uiBitflip, length);
+    }
+    else if constexpr (length <= 16)
+    {
+      const nsUInt64 uiLo = XXH3Read64(str) ^ ((XXH3Read64(secret + 24) ^ XXH3Read64(secret + 32)) + uiSeed);
+      const nsUInt64 uiHi = XXH3Read64(str + length - 8) ^ ((XXH3Read64(secret + 40) ^ XXH3Read64(secret + 48)) - uiSeed);
+      return XXH3Avalanche(length + XXH3Swap64(uiLo) + uiHi + XXH3Mul128Fold64(uiLo, uiHi));
+    }
+    else if constexpr (length <= 128)
+    {
+      nsUInt64 acc = length * PRIME64_1;
+      if constexpr (length > 96)
+      {
+        acc += XXH3Mix16B(str + 48, secret + 96, uiSeed);
+        acc += XXH3Mix16B(str + length - 64, secret + 112, uiSeed);
+      }
+      if constexpr (length > 64)
+      {
+        acc += XXH3Mix16B(str + 32, secret + 64, uiSeed);
+        acc += XXH3Mix16B(str + length - 48, secret + 80, uiSeed);
+      }
+      if constexpr (length > 32)
+      {
+        acc += XXH3Mix16B(str + 16, secret + 32, uiSeed);
+        acc += XXH3Mix16B(str + length - 32, secret + 48, uiSeed);
+      }
+      acc += XXH3Mix16B(str + 0, secret + 0, uiSeed);
+      acc += XXH3Mix16B(str + length - 16, secret + 16, uiSeed);
+      return XXH3Avalanche(acc);
+    }
+    else if constexpr (length <= 240)
+    {
+      nsUInt64 acc = length * PRIME64_1;
+      for (nsUInt32 i = 0; i < 8; ++i)
+      {
+        acc += XXH3Mix16B(str + 16 * i, secret + 16 * i, uiSeed);
+      }
+
+      acc = XXH3Avalanche(acc);
+
+      for (nsUInt32 i = 8; i < length / 16; ++i)
+      {
+        acc += XXH3Mix16B(str + 16 * i, secret + 16 * (i - 8) + 3, uiSeed);
+      }
+
+      acc += XXH3Mix16B(str + length - 16, secret + 136 - 17, uiSeed);
+      return XXH3Avalanche(acc);
+    }
+    else
+    {
+      return CompileTimeXxHash3_64Long(str, length, uiSeed);
+    }
+  }
 } // namespace nsInternal
 
 template <size_t N>
@@ -188,6 +416,12 @@ constexpr NS_ALWAYS_INLINE nsUInt64 nsHashingUtils::xxHash64String(const char (&
   return nsInternal::CompileTimeXxHash64(str, uiSeed);
 }
 
+template <size_t N>
+constexpr NS_ALWAYS_INLINE nsUInt64 nsHashingUtils::xxHash3_64String(const char (&str)[N], nsUInt64 uiSeed)
+{
+  return nsInternal::CompileTimeXxHash3_64(str, uiSeed);
+}
+
 NS_ALWAYS_INLINE nsUInt32 nsHashingUtils::xxHash32String(nsStringView sStr, nsUInt32 uiSeed)
 {
   return xxHash32(sStr.GetStartPointer(), sStr.GetElementCount(), uiSeed);
@@ -197,3 +431,8 @@ NS_ALWAYS_INLINE nsUInt64 nsHashingUtils::xxHash64String(nsStringView sStr, nsUI
 {
   return xxHash64(sStr.GetStartPointer(), sStr.GetElementCount(), uiSeed);
 }
+
+NS_ALWAYS_INLINE nsUInt64 nsHashingUtils::xxHash3_64String(nsStringView sStr, nsUInt64 uiSeed)
+{
+  return xxHash3_64(sStr.GetStartPointer(), sStr.GetElementCount(), uiSeed);
+}
@@ -59,6 +59,7 @@
 // Platform Features
 #define NS_USE_POSIX_FILE_API NS_OFF
 #define NS_USE_LINUX_POSIX_EXTENSIONS NS_OFF // linux specific posix extensions like pipe2, dup3, etc.
+#define NS_USE_FUTEX_THREADING NS_OFF        // mutex, condition variable and semaphore are implemented on top of futexes instead of pthreads
 #define NS_USE_CPP20_OPERATORS NS_OFF
 #define NS_SUPPORTS_FILE_ITERATORS NS_OFF
 #define NS_SUPPORTS_FILE_STATS NS_OFF
@@ -74,6 +75,7 @@
 
 // Allocators
 #define NS_ALLOC_GUARD_ALLOCATIONS NS_OFF
+#define NS_ALLOC_SIZE_CLASS_HEAP NS_OFF // the default and aligned allocators use nsAllocPolicySizeClassHeap instead of malloc
 #define NS_ALLOC_TRACKING_DEFAULT nsAllocatorTrackingMode::Nothing
 
 // Other Features
@@ -85,6 +87,11 @@
 /// by default.
 #define NS_HASHED_STRING_REF_COUNTING NS_OFF
 
+// String Hashing
+/// \brief Selects the hash function behind nsHashingUtils::StringHash and nsHashStreamWriter64. 1 = xxHash64, 2 = XXH3.
+/// Changing this invalidates all string hashes that were stored on disk. nsArchive detects this and recomputes its path hashes.
+#define NS_HASHING_VERSION 2
+
 // Math Debug Checks
 #define NS_MATH_CHECK_FOR_NAN NS_OFF
 
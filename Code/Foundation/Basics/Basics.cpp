@@ -6,6 +6,10 @@
 using DefaultHeapType = nsGuardingAllocator;
 using DefaultAlignedHeapType = nsGuardingAllocator;
 using DefaultStaticsHeapType = nsAllocatorWithPolicy<nsAllocPolicyGuarding, nsAllocatorTrackingMode::AllocationStatsIgnoreLeaks>;
+#elif NS_ENABLED(NS_ALLOC_SIZE_CLASS_HEAP)
+using DefaultHeapType = nsSizeClassHeapAllocator;
+using DefaultAlignedHeapType = nsSizeClassHeapAllocator;
+using DefaultStaticsHeapType = nsAllocatorWithPolicy<nsAllocPolicyHeap, nsAllocatorTrackingMode::AllocationStatsIgnoreLeaks>;
 #else
 using DefaultHeapType = nsHeapAllocator;
 using DefaultAlignedHeapType = nsAlignedHeapAllocator;
@@ -182,3 +182,32 @@ void nsMessageQueue<MD, A>::operator=(const nsMessageQueueBase<MD>& rhs)
 {
   nsMessageQueueBase<MD>::operator=(rhs);
 }
+
+template <typename MD, typename A>
+nsLockFreeMessageQueue<MD, A>::nsLockFreeMessageQueue(nsUInt32 uiCapacity, nsAllocator* pAllocator)
+  : m_Queue(uiCapacity, pAllocator)
+{
+}
+
+template <typename MD, typename A>
+bool nsLockFreeMessageQueue<MD, A>::TryEnqueue(nsMessage* pMessage, const MD& metaData)
+{
+  Entry entry;
+  entry.m_pMessage = pMessage;
+  entry.m_MetaData = metaData;
+
+  return m_Queue.TryPush(entry);
+}
+
+template <typename MD, typename A>
+bool nsLockFreeMessageQueue<MD, A>::TryDequeue(nsMessage*& out_pMessage, MD& out_metaData)
+{
+  Entry entry;
+
+  if (!m_Queue.TryPop(entry))
+    return false;
+
+  out_pMessage = entry.m_pMessage;
+  out_metaData = entry.m_MetaData;
+  return true;
+}
@@ -3,6 +3,7 @@
 
 #include <Foundation/Communication/Message.h>
 #include <Foundation/Containers/Deque.h>
+#include <Foundation/Containers/MpmcQueue.h>
 #include <Foundation/Threading/Lock.h>
 #include <Foundation/Threading/Mutex.h>
 
@@ -106,4 +107,38 @@ public:
   void operator=(const nsMessageQueueBase<MetaDataType>& rhs);
 };
 
+/// \brief A message queue with a fixed capacity that is built on top of nsMpmcQueue and never takes a lock.
+///
+/// Any number of threads may enqueue and dequeue at the same time. This is meant for handing messages between threads,
+/// where locking the mutex of nsMessageQueue would cost more than processing the message.
+/// In exchange, the queue can't be locked, sorted or indexed, and TryEnqueue() fails when the queue is full.
+/// Lifetime of the enqueued messages needs to be managed by the user.
+template <typename MetaDataType, typename AllocatorWrapper = nsDefaultAllocatorWrapper>
+class nsLockFreeMessageQueue
+{
+public:
+  using Entry = typename nsMessageQueueBase<MetaDataType>::Entry;
+
+  /// \brief Allocates room for at least \a uiCapacity messages.
+  explicit nsLockFreeMessageQueue(nsUInt32 uiCapacity, nsAllocator* pAllocator = AllocatorWrapper::GetAllocator()); // [tested]
+
+  /// \brief Enqueues the given message and meta-data. Returns false, if the queue is full. This method is thread safe.
+  bool TryEnqueue(nsMessage* pMessage, const MetaDataType& metaData); // [tested]
+
+  /// \brief Dequeues the first element if the queue is not empty and returns true. Returns false if the queue is empty. This method is thread safe.
+  bool TryDequeue(nsMessage*& out_pMessage, MetaDataType& out_metaData); // [tested]
+
+  /// \brief Returns the number of messages in the queue. Only a snapshot, if other threads are active at the same time.
+  nsUInt32 GetCount() const { return m_Queue.GetCount(); }
+
+  /// \brief Returns true, if the queue does not contain any elements. Only a snapshot, if other threads are active at the same time.
+  bool IsEmpty() const { return m_Queue.IsEmpty(); }
+
+  /// \brief Returns how many messages the queue can hold.
+  nsUInt32 GetCapacity() const { return m_Queue.GetCapacity(); }
+
+private:
+  nsMpmcQueue<Entry, AllocatorWrapper> m_Queue;
+};
+
 #include <Foundation/Communication/Implementation/MessageQueue_inl.h>
@@ -0,0 +1,391 @@
+#pragma once
+
+#include <Foundation/Algorithm/Comparer.h>
+#include <Foundation/Containers/Implementation/BTree.h>
+#include <Foundation/Memory/AllocatorWrapper.h>
+#include <Foundation/Types/ArrayPtr.h>
+
+template <typename KeyType, typename ValueType, typename Comparer>
+class nsBTreeMapBase;
+
+/// \brief Base class for all iterators.
+template <typename KeyType, typename ValueType, typename Comparer, bool REVERSE>
+struct nsBTreeMapBaseConstIteratorBase
+{
+  using iterator_category = std::forward_iterator_tag;
+  using value_type = nsBTreeMapBaseConstIteratorBase<KeyType, ValueType, Comparer, false>;
+  using difference_type = std::ptrdiff_t;
+  using pointer = nsBTreeMapBaseConstIteratorBase<KeyType, ValueType, Comparer, false>*;
+  using reference = nsBTreeMapBaseConstIteratorBase<KeyType, ValueType, Comparer, false>&;
+
+  NS_DECLARE_POD_TYPE();
+
+  /// \brief Constructs an invalid iterator.
+  NS_ALWAYS_INLINE nsBTreeMapBaseConstIteratorBase() = default; // [tested]
+
+  /// \brief Checks whether this iterator points to a valid element.
+  NS_ALWAYS_INLINE bool IsValid() const { return (m_Position.m_pLeaf != nullptr); } // [tested]
+
+  /// \brief Checks whether the two iterators point to the same element.
+  NS_ALWAYS_INLINE bool operator==(const nsBTreeMapBaseConstIteratorBase& it2) const
+  {
+    return (m_Position.m_pLeaf == it2.m_Position.m_pLeaf) && (m_Position.m_uiIndex == it2.m_Position.m_uiIndex);
+  }
+  NS_ADD_DEFAULT_OPERATOR_NOTEQUAL(const nsBTreeMapBaseConstIteratorBase&);
+
+  /// \brief Returns the 'key' of the element that this iterator points to.
+  NS_FORCE_INLINE const KeyType& Key() const
+  {
+    NS_ASSERT_DEBUG(IsValid(), "Cannot access the 'key' of an invalid iterator.");
+    return m_Position.m_pLeaf->Keys()[m_Position.m_uiIndex];
+  } // [tested]
+
+  /// \brief Returns the 'value' of the element that this iterator points to.
+  NS_FORCE_INLINE const ValueType& Value() const
+  {
+    NS_ASSERT_DEBUG(IsValid(), "Cannot access the 'value' of an invalid iterator.");
+    return m_Position.m_pLeaf->Values()[m_Position.m_uiIndex];
+  } // [tested]
+
+  /// \brief Returns '*this' to enable foreach
+  NS_ALWAYS_INLINE nsBTreeMapBaseConstIteratorBase& operator*() { return *this; } // [tested]
+
+  /// \brief Advances the iterator to the next element in the map. The iterator will not be valid anymore, if the end is reached.
+  void Next(); // [tested]
+
+  /// \brief Advances the iterator to the previous element in the map. The iterator will not be valid anymore, if the end is reached.
+  void Prev(); // [tested]
+
+  /// \brief Shorthand for 'Next'
+  NS_ALWAYS_INLINE void operator++() { Next(); } // [tested]
+
+  /// \brief Shorthand for 'Prev'
+  NS_ALWAYS_INLINE void operator--() { Prev(); } // [tested]
+
+protected:
+  using Tree = nsInternal::nsBTree<KeyType, ValueType, Comparer>;
+
+  friend class nsBTreeMapBase<KeyType, ValueType, Comparer>;
+
+  NS_ALWAYS_INLINE explicit nsBTreeMapBaseConstIteratorBase(const typename Tree::Position& pos)
+    : m_Position(pos)
+  {
+  }
+
+  typename Tree::Position m_Position;
+
+#if NS_ENABLED(NS_USE_CPP20_OPERATORS)
+public:
+  struct Pointer
+  {
+    std::pair<const KeyType&, const ValueType&> value;
+    const std::pair<const KeyType&, const ValueType&>* operator->() const { return &value; }
+  };
+
+  NS_ALWAYS_INLINE Pointer operator->() const
+  {
+    return Pointer{.value = {Key(), Value()}};
+  }
+
+  // This function is used to return the values for structured bindings.
+  // The number and type of each slot are defined in the inl file.
+  template <std::size_t Index>
+  std::tuple_element_t<Index, nsBTreeMapBaseConstIteratorBase>& get() const
+  {
+    if constexpr (Index == 0)
+      return Key();
+    if constexpr (Index == 1)
+      return Value();
+  }
+#endif
+};
+
+/// \brief Forward Iterator to iterate over all elements in sorted order.
+template <typename KeyType, typename ValueType, typename Comparer, bool REVERSE>
+struct nsBTreeMapBaseIteratorBase : public nsBTreeMapBaseConstIteratorBase<KeyType, ValueType, Comparer, REVERSE>
+{
+  using iterator_category = std::forward_iterator_tag;
+  using value_type = nsBTreeMapBaseIteratorBase<KeyType, ValueType, Comparer, REVERSE>;
+  using difference_type = std::ptrdiff_t;
+  using pointer = nsBTreeMapBaseIteratorBase<KeyType, ValueType, Comparer, REVERSE>*;
+  using reference = nsBTreeMapBaseIteratorBase<KeyType, ValueType, Comparer, REVERSE>&;
+
+  NS_DECLARE_POD_TYPE();
+
+  /// \brief Constructs an invalid iterator.
+  NS_ALWAYS_INLINE nsBTreeMapBaseIteratorBase() = default;
+
+  /// \brief Returns the 'value' of the element that this iterator points to.
+  NS_FORCE_INLINE ValueType& Value()
+  {
+    NS_ASSERT_DEBUG(this->IsValid(), "Cannot access the 'value' of an invalid iterator.");
+    return this->m_Position.m_pLeaf->Values()[this->m_Position.m_uiIndex];
+  }
+
+  /// \brief Returns the 'value' of the element that this iterator points to.
+  NS_FORCE_INLINE ValueType& Value() const
+  {
+    NS_ASSERT_DEBUG(this->IsValid(), "Cannot access the 'value' of an invalid iterator.");
+    return this->m_Position.m_pLeaf->Values()[this->m_Position.m_uiIndex];
+  }
+
+  /// \brief Returns '*this' to enable foreach
+  NS_ALWAYS_INLINE nsBTreeMapBaseIteratorBase& operator*() { return *this; } // [tested]
+
+private:
+  friend class nsBTreeMapBase<KeyType, ValueType, Comparer>;
+
+  NS_ALWAYS_INLINE explicit nsBTreeMapBaseIteratorBase(const typename nsInternal::nsBTree<KeyType, ValueType, Comparer>::Position& pos)
+    : nsBTreeMapBaseConstIteratorBase<KeyType, ValueType, Comparer, REVERSE>(pos)
+  {
+  }
+
+#if NS_ENABLED(NS_USE_CPP20_OPERATORS)
+public:
+  struct Pointer
+  {
+    std::pair<const KeyType&, ValueType&> value;
+    const std::pair<const KeyType&, ValueType&>* operator->() const { return &value; }
+  };
+
+  NS_ALWAYS_INLINE Pointer operator->() const
+  {
+    return Pointer{.value = {nsBTreeMapBaseConstIteratorBase<KeyType, ValueType, Comparer, REVERSE>::Key(), Value()}};
+  }
+
+  // These functions are used to return the values for structured bindings.
+  // The number and type of type of each slot are defined in the inl file.
+
+  template <std::size_t Index>
+  std::tuple_element_t<Index, nsBTreeMapBaseIteratorBase>& get()
+  {
+    if constexpr (Index == 0)
+      return nsBTreeMapBaseConstIteratorBase<KeyType, ValueType, Comparer, REVERSE>::Key();
+    if constexpr (Index == 1)
+      return Value();
+  }
+
+  template <std::size_t Index>
+  std::tuple_element_t<Index, nsBTreeMapBaseIteratorBase>& get() const
+  {
+    if constexpr (Index == 0)
+      return nsBTreeMapBaseConstIteratorBase<KeyType, ValueType, Comparer, REVERSE>::Key();
+    if constexpr (Index == 1)
+      return Value();
+  }
+#endif
+};
+
+/// \brief An associative container with the same interface as nsMapBase, implemented as a B+tree.
+///
+/// nsMap allocates one node per element and follows a pointer per tree level. This map stores the elements sorted in arrays
+/// in the leaves of a wide tree instead, so lookups touch far fewer cache lines, iterating is mostly a linear walk through memory
+/// and there is no per element overhead.
+///
+/// Since elements move between and within the nodes, every insertion and removal invalidates all iterators and all pointers
+/// to keys and values, other than nsMap. Remove(Iterator) returns a valid iterator to the next element.
+///
+/// BulkLoad() builds the map from sorted input in O(n).
+template <typename KeyType, typename ValueType, typename Comparer>
+class nsBTreeMapBase
+{
+public:
+  using ConstIterator = nsBTreeMapBaseConstIteratorBase<KeyType, ValueType, Comparer, false>;
+  using ConstReverseIterator = nsBTreeMapBaseConstIteratorBase<KeyType, ValueType, Comparer, true>;
+
+  using Iterator = nsBTreeMapBaseIteratorBase<KeyType, ValueType, Comparer, false>;
+  using ReverseIterator = nsBTreeMapBaseIteratorBase<KeyType, ValueType, Comparer, true>;
+
+protected:
+  /// \brief Initializes the map to be empty.
+  nsBTreeMapBase(const Comparer& comparer, nsAllocator* pAllocator); // [tested]
+
+  /// \brief Copies all key/value pairs from the given map into this one.
+  nsBTreeMapBase(const nsBTreeMapBase<KeyType, ValueType, Comparer>& cc, nsAllocator* pAllocator); // [tested]
+
+  /// \brief Destroys all elements from the map.
+  ~nsBTreeMapBase() = default; // [tested]
+
+  /// \brief Copies all key/value pairs from the given map into this one.
+  void operator=(const nsBTreeMapBase<KeyType, ValueType, Comparer>& rhs);
+
+public:
+  /// \brief Returns whether there are no elements in the map. O(1) operation.
+  bool IsEmpty() const; // [tested]
+
+  /// \brief Returns the number of elements currently stored in the map. O(1) operation.
+  nsUInt32 GetCount() const; // [tested]
+
+  /// \brief Destroys all elements in the map and resets its size to zero.
+  void Clear(); // [tested]
+
+  /// \brief Returns an Iterator to the very first element.
+  Iterator GetIterator(); // [tested]
+
+  /// \brief Returns a ReverseIterator to the very last element.
+  ReverseIterator GetReverseIterator(); // [tested]
+
+  /// \brief Returns a constant Iterator to the very first element.
+  ConstIterator GetIterator() const; // [tested]
+
+  /// \brief Returns a constant ReverseIterator to the very last element.
+  ConstReverseIterator GetReverseIterator() const; // [tested]
+
+  /// \brief Inserts the key/value pair into the tree and returns an Iterator to it. O(log n) operation.
+  template <typename CompatibleKeyType, typename CompatibleValueType>
+  Iterator Insert(CompatibleKeyType&& key, CompatibleValueType&& value); // [tested]
+
+  /// \brief Erases the key/value pair with the given key, if it exists. O(log n) operation.
+  template <typename CompatibleKeyType>
+  bool Remove(const CompatibleKeyType& key); // [tested]
+
+  /// \brief Erases the key/value pair at the given Iterator. O(log n) operation. Returns an iterator to the element after the given
+  /// iterator.
+  Iterator Remove(const Iterator& pos); // [tested]
+
+  /// \brief Searches for the given key and returns an iterator to it. If it did not exist yet, it is default-created. \a bExisted is set to
+  /// true, if the key was found, false if it needed to be created.
+  template <typename CompatibleKeyType>
+  Iterator FindOrAdd(CompatibleKeyType&& key, bool* out_pExisted = nullptr); // [tested]
+
+  /// \brief Allows read/write access to the value stored under the given key. If there is no such key, a new element is
+  /// default-constructed.
+  template <typename CompatibleKeyType>
+  ValueType& operator[](const CompatibleKeyType& key); // [tested]
+
+  /// \brief Returns whether an entry with the given key was found and if found writes out the corresponding value to out_value.
+  template <typename CompatibleKeyType>
+  bool TryGetValue(const CompatibleKeyType& key, ValueType& out_value) const; // [tested]
+
+  /// \brief Returns whether an entry with the given key was found and if found writes out the pointer to the corresponding value to out_pValue.
+  template <typename CompatibleKeyType>
+  bool TryGetValue(const CompatibleKeyType& key, const ValueType*& out_pValue) const; // [tested]
+
+  /// \brief Returns whether an entry with the given key was found and if found writes out the pointer to the corresponding value to out_pValue.
+  template <typename CompatibleKeyType>
+  bool TryGetValue(const CompatibleKeyType& key, ValueType*& out_pValue) const; // [tested]
+
+  /// \brief Returns a pointer to the value of the entry with the given key if found, otherwise returns nullptr.
+  template <typename CompatibleKeyType>
+  const ValueType* GetValue(const CompatibleKeyType& key) const; // [tested]
+
+  /// \brief Returns a pointer to the value of the entry with the given key if found, otherwise returns nullptr.
+  template <typename CompatibleKeyType>
+  ValueType* GetValue(const CompatibleKeyType& key); // [tested]
+
+  /// \brief Either returns the value of the entry with the given key, if found, or the provided default value.
+  template <typename CompatibleKeyType>
+  const ValueType& GetValueOrDefault(const CompatibleKeyType& key, const ValueType& defaultValue) const; // [tested]
+
+  /// \brief Searches for key, returns an Iterator to it or an invalid iterator, if no such key is found. O(log n) operation.
+  template <typename CompatibleKeyType>
+  Iterator Find(const CompatibleKeyType& key); // [tested]
+
+  /// \brief Returns an Iterator to the element with a key equal or larger than the given key. Returns an invalid iterator, if there is no
+  /// such element.
+  template <typename CompatibleKeyType>
+  Iterator LowerBound(const CompatibleKeyType& key); // [tested]
+
+  /// \brief Returns an Iterator to the element with a key that is LARGER than the given key. Returns an invalid iterator, if there is no
+  /// such element.
+  template <typename CompatibleKeyType>
+  Iterator UpperBound(const CompatibleKeyType& key); // [tested]
+
+  /// \brief Searches for key, returns an Iterator to it or an invalid iterator, if no such key is found. O(log n) operation.
+  template <typename CompatibleKeyType>
+  ConstIterator Find(const CompatibleKeyType& key) const; // [tested]
+
+  /// \brief Checks whether the given key is in the container.
+  template <typename CompatibleKeyType>
+  bool Contains(const CompatibleKeyType& key) const; // [tested]
+
+  /// \brief Returns an Iterator to the element with a key equal or larger than the given key. Returns an invalid iterator, if there is no
+  /// such element.
+  template <typename CompatibleKeyType>
+  ConstIterator LowerBound(const CompatibleKeyType& key) const; // [tested]
+
+  /// \brief Returns an Iterator to the element with a key that is LARGER than the given key. Returns an invalid iterator, if there is no
+  /// such element.
+  template <typename CompatibleKeyType>
+  ConstIterator UpperBound(const CompatibleKeyType& key) const; // [tested]
+
+  /// \brief Replaces the content of the map with the given key/value pairs. The keys must be sorted and unique. O(n) operation.
+  ///
+  /// All nodes are filled as much as possible, which makes this much faster than inserting the elements one by one
+  /// and uses less memory.
+  void BulkLoad(nsArrayPtr<const KeyType> keys, nsArrayPtr<const ValueType> values); // [tested]
+
+  /// \brief Returns the allocator that is used by this instance.
+  nsAllocator* GetAllocator() const { return m_Tree.GetAllocator(); }
+
+  /// \brief Comparison operator
+  bool operator==(const nsBTreeMapBase<KeyType, ValueType, Comparer>& rhs) const; // [tested]
+  NS_ADD_DEFAULT_OPERATOR_NOTEQUAL(const nsBTreeMapBase<KeyType, ValueType, Comparer>&);
+
+  /// \brief Returns the amount of bytes that are currently allocated on the heap.
+  nsUInt64 GetHeapMemoryUsage() const { return m_Tree.GetHeapMemoryUsage(); } // [tested]
+
+  /// \brief Swaps this map with the other one.
+  void Swap(nsBTreeMapBase<KeyType, ValueType, Comparer>& other); // [tested]
+
+private:
+  nsInternal::nsBTree<KeyType, ValueType, Comparer> m_Tree;
+};
+
+
+/// \brief \see nsBTreeMapBase
+template <typename KeyType, typename ValueType, typename Comparer = nsCompareHelper<KeyType>, typename AllocatorWrapper = nsDefaultAllocatorWrapper>
+class nsBTreeMap : public nsBTreeMapBase<KeyType, ValueType, Comparer>
+{
+public:
+  nsBTreeMap();
+  explicit nsBTreeMap(nsAllocator* pAllocator);
+  nsBTreeMap(const Comparer& comparer, nsAllocator* pAllocator);
+
+  nsBTreeMap(const nsBTreeMap<KeyType, ValueType, Comparer, AllocatorWrapper>& other);
+  nsBTreeMap(const nsBTreeMapBase<KeyType, ValueType, Comparer>& other);
+
+  void operator=(const nsBTreeMap<KeyType, ValueType, Comparer, AllocatorWrapper>& rhs);
+  void operator=(const nsBTreeMapBase<KeyType, ValueType, Comparer>& rhs);
+};
+
+template <typename KeyType, typename ValueType, typename Comparer>
+typename nsBTreeMapBase<KeyType, ValueType, Comparer>::Iterator begin(nsBTreeMapBase<KeyType, ValueType, Comparer>& ref_container)
+{
+  return ref_container.GetIterator();
+}
+
+template <typename KeyType, typename ValueType, typename Comparer>
+typename nsBTreeMapBase<KeyType, ValueType, Comparer>::ConstIterator begin(const nsBTreeMapBase<KeyType, ValueType, Comparer>& container)
+{
+  return container.GetIterator();
+}
+
+template <typename KeyType, typename ValueType, typename Comparer>
+typename nsBTreeMapBase<KeyType, ValueType, Comparer>::ConstIterator cbegin(const nsBTreeMapBase<KeyType, ValueType, Comparer>& container)
+{
+  return container.GetIterator();
+}
+
+template <typename KeyType, typename ValueType, typename Comparer>
+typename nsBTreeMapBase<KeyType, ValueType, Comparer>::Iterator end(nsBTreeMapBase<KeyType, ValueType, Comparer>& ref_container)
+{
+  NS_IGNORE_UNUSED(ref_container);
+  return typename nsBTreeMapBase<KeyType, ValueType, Comparer>::Iterator();
+}
+
+template <typename KeyType, typename ValueType, typename Comparer>
+typename nsBTreeMapBase<KeyType, ValueType, Comparer>::ConstIterator end(const nsBTreeMapBase<KeyType, ValueType, Comparer>& container)
+{
+  NS_IGNORE_UNUSED(container);
+  return typename nsBTreeMapBase<KeyType, ValueType, Comparer>::ConstIterator();
+}
+
+template <typename KeyType, typename ValueType, typename Comparer>
+typename nsBTreeMapBase<KeyType, ValueType, Comparer>::ConstIterator cend(const nsBTreeMapBase<KeyType, ValueType, Comparer>& container)
+{
+  NS_IGNORE_UNUSED(container);
+  return typename nsBTreeMapBase<KeyType, ValueType, Comparer>::ConstIterator();
+}
+
+#include <Foundation/Containers/Implementation/BTreeMap_inl.h>
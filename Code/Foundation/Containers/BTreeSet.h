@@ -0,0 +1,213 @@
+#pragma once
+
+#include <Foundation/Algorithm/Comparer.h>
+#include <Foundation/Containers/Implementation/BTree.h>
+#include <Foundation/Memory/AllocatorWrapper.h>
+#include <Foundation/Types/ArrayPtr.h>
+
+/// \brief A set container with the same interface as nsSetBase, implemented as a B+tree.
+///
+/// The keys are stored sorted in arrays in the leaves of a wide tree, instead of one node per key like in nsSet, see nsBTreeMapBase.
+/// Every insertion and removal invalidates all iterators. Remove(Iterator) returns a valid iterator to the next element.
+template <typename KeyType, typename Comparer>
+class nsBTreeSetBase
+{
+private:
+  using Tree = nsInternal::nsBTree<KeyType, nsInternal::nsBTreeNoValue, Comparer>;
+
+public:
+  /// \brief Base class for all iterators.
+  template <bool REVERSE>
+  struct IteratorBase
+  {
+    using iterator_category = std::forward_iterator_tag;
+    using value_type = IteratorBase<REVERSE>;
+    using difference_type = std::ptrdiff_t;
+    using pointer = IteratorBase<REVERSE>*;
+    using reference = IteratorBase<REVERSE>&;
+
+    NS_DECLARE_POD_TYPE();
+
+    /// \brief Constructs an invalid iterator.
+    NS_ALWAYS_INLINE IteratorBase() = default; // [tested]
+
+    /// \brief Checks whether this iterator points to a valid element.
+    NS_ALWAYS_INLINE bool IsValid() const { return (m_Position.m_pLeaf != nullptr); } // [tested]
+
+    /// \brief Checks whether the two iterators point to the same element.
+    NS_ALWAYS_INLINE bool operator==(const typename nsBTreeSetBase<KeyType, Comparer>::IteratorBase<REVERSE>& it2) const
+    {
+      return (m_Position.m_pLeaf == it2.m_Position.m_pLeaf) && (m_Position.m_uiIndex == it2.m_Position.m_uiIndex);
+    }
+    NS_ADD_DEFAULT_OPERATOR_NOTEQUAL(const typename nsBTreeSetBase<KeyType, Comparer>::IteratorBase<REVERSE>&);
+
+    /// \brief Returns the 'key' of the element that this iterator points to.
+    NS_FORCE_INLINE const KeyType& Key() const
+    {
+      NS_ASSERT_DEBUG(IsValid(), "Cannot access the 'key' of an invalid iterator.");
+      return m_Position.m_pLeaf->Keys()[m_Position.m_uiIndex];
+    } // [tested]
+
+    /// \brief Returns the 'key' of the element that this iterator points to.
+    NS_ALWAYS_INLINE const KeyType& operator*() const { return Key(); }
+
+    /// \brief Advances the iterator to the next element in the set. The iterator will not be valid anymore, if the end is reached.
+    void Next(); // [tested]
+
+    /// \brief Advances the iterator to the previous element in the set. The iterator will not be valid anymore, if the end is reached.
+    void Prev(); // [tested]
+
+    /// \brief Shorthand for 'Next'
+    NS_ALWAYS_INLINE void operator++() { Next(); } // [tested]
+
+    /// \brief Shorthand for 'Prev'
+    NS_ALWAYS_INLINE void operator--() { Prev(); } // [tested]
+
+  protected:
+    friend class nsBTreeSetBase<KeyType, Comparer>;
+
+    NS_ALWAYS_INLINE explicit IteratorBase(const typename Tree::Position& pos)
+      : m_Position(pos)
+    {
+    }
+
+    typename Tree::Position m_Position;
+  };
+
+  using Iterator = IteratorBase<false>;
+  using ReverseIterator = IteratorBase<true>;
+
+protected:
+  /// \brief Initializes the set to be empty.
+  nsBTreeSetBase(const Comparer& comparer, nsAllocator* pAllocator); // [tested]
+
+  /// \brief Copies all keys from the given set into this one.
+  nsBTreeSetBase(const nsBTreeSetBase<KeyType, Comparer>& cc, nsAllocator* pAllocator); // [tested]
+
+  /// \brief Destroys all elements in the set.
+  ~nsBTreeSetBase() = default; // [tested]
+
+  /// \brief Copies all keys from the given set into this one.
+  void operator=(const nsBTreeSetBase<KeyType, Comparer>& rhs); // [tested]
+
+public:
+  /// \brief Returns whether there are no elements in the set. O(1) operation.
+  bool IsEmpty() const; // [tested]
+
+  /// \brief Returns the number of elements currently stored in the set. O(1) operation.
+  nsUInt32 GetCount() const; // [tested]
+
+  /// \brief Destroys all elements in the set and resets its size to zero.
+  void Clear(); // [tested]
+
+  /// \brief Returns a constant Iterator to the very first element.
+  Iterator GetIterator() const; // [tested]
+
+  /// \brief Returns a constant ReverseIterator to the very last element.
+  ReverseIterator GetReverseIterator() const; // [tested]
+
+  /// \brief Inserts the key into the tree and returns an Iterator to it. O(log n) operation.
+  template <typename CompatibleKeyType>
+  Iterator Insert(CompatibleKeyType&& key); // [tested]
+
+  /// \brief Erases the element with the given key, if it exists. O(log n) operation.
+  template <typename CompatibleKeyType>
+  bool Remove(const CompatibleKeyType& key); // [tested]
+
+  /// \brief Erases the element at the given Iterator. O(log n) operation. Returns an iterator to the element after the given iterator.
+  Iterator Remove(const Iterator& pos); // [tested]
+
+  /// \brief Searches for key, returns an Iterator to it or an invalid iterator, if no such key is found. O(log n) operation.
+  template <typename CompatibleKeyType>
+  Iterator Find(const CompatibleKeyType& key) const; // [tested]
+
+  /// \brief Checks whether the given key is in the container.
+  template <typename CompatibleKeyType>
+  bool Contains(const CompatibleKeyType& key) const; // [tested]
+
+  /// \brief Checks whether all keys of the given set are in the container.
+  bool ContainsSet(const nsBTreeSetBase<KeyType, Comparer>& operand) const; // [tested]
+
+  /// \brief Returns an Iterator to the element with a key equal or larger than the given key. Returns an invalid iterator, if there is no such
+  /// element.
+  template <typename CompatibleKeyType>
+  Iterator LowerBound(const CompatibleKeyType& key) const; // [tested]
+
+  /// \brief Returns an Iterator to the element with a key that is LARGER than the given key. Returns an invalid iterator, if there is no such
+  /// element.
+  template <typename CompatibleKeyType>
+  Iterator UpperBound(const CompatibleKeyType& key) const; // [tested]
+
+  /// \brief Makes this set the union of itself and the operand.
+  void Union(const nsBTreeSetBase<KeyType, Comparer>& operand); // [tested]
+
+  /// \brief Makes this set the difference of itself and the operand, i.e. subtracts operand.
+  void Difference(const nsBTreeSetBase<KeyType, Comparer>& operand); // [tested]
+
+  /// \brief Makes this set the intersection of itself and the operand.
+  void Intersection(const nsBTreeSetBase<KeyType, Comparer>& operand); // [tested]
+
+  /// \brief Replaces the content of the set with the given keys, which must be sorted and unique. O(n) operation.
+  void BulkLoad(nsArrayPtr<const KeyType> keys); // [tested]
+
+  /// \brief Returns the allocator that is used by this instance.
+  nsAllocator* GetAllocator() const { return m_Tree.GetAllocator(); }
+
+  /// \brief Comparison operator
+  bool operator==(const nsBTreeSetBase<KeyType, Comparer>& rhs) const; // [tested]
+  NS_ADD_DEFAULT_OPERATOR_NOTEQUAL(const nsBTreeSetBase<KeyType, Comparer>&);
+
+  /// \brief Returns the amount of bytes that are currently allocated on the heap.
+  nsUInt64 GetHeapMemoryUsage() const { return m_Tree.GetHeapMemoryUsage(); } // [tested]
+
+  /// \brief Swaps this set with the other one.
+  void Swap(nsBTreeSetBase<KeyType, Comparer>& other); // [tested]
+
+private:
+  Tree m_Tree;
+};
+
+/// \brief \see nsBTreeSetBase
+template <typename KeyType, typename Comparer = nsCompareHelper<KeyType>, typename AllocatorWrapper = nsDefaultAllocatorWrapper>
+class nsBTreeSet : public nsBTreeSetBase<KeyType, Comparer>
+{
+public:
+  nsBTreeSet();
+  explicit nsBTreeSet(nsAllocator* pAllocator);
+  nsBTreeSet(const Comparer& comparer, nsAllocator* pAllocator);
+
+  nsBTreeSet(const nsBTreeSet<KeyType, Comparer, AllocatorWrapper>& other);
+  nsBTreeSet(const nsBTreeSetBase<KeyType, Comparer>& other);
+
+  void operator=(const nsBTreeSet<KeyType, Comparer, AllocatorWrapper>& rhs);
+  void operator=(const nsBTreeSetBase<KeyType, Comparer>& rhs);
+};
+
+
+template <typename KeyType, typename Comparer>
+typename nsBTreeSetBase<KeyType, Comparer>::Iterator begin(const nsBTreeSetBase<KeyType, Comparer>& container)
+{
+  return container.GetIterator();
+}
+
+template <typename KeyType, typename Comparer>
+typename nsBTreeSetBase<KeyType, Comparer>::Iterator cbegin(const nsBTreeSetBase<KeyType, Comparer>& container)
+{
+  return container.GetIterator();
+}
+
+template <typename KeyType, typename Comparer>
+typename nsBTreeSetBase<KeyType, Comparer>::Iterator end(const nsBTreeSetBase<KeyType, Comparer>& container)
+{
+  NS_IGNORE_UNUSED(container);
+  return typename nsBTreeSetBase<KeyType, Comparer>::Iterator();
+}
+
+template <typename KeyType, typename Comparer>
+typename nsBTreeSetBase<KeyType, Comparer>::Iterator cend(const nsBTreeSetBase<KeyType, Comparer>& container)
+{
+  NS_IGNORE_UNUSED(container);
+  return typename nsBTreeSetBase<KeyType, Comparer>::Iterator();
+}
+
+#include <Foundation/Containers/Implementation/BTreeSet_inl.h>
@@ -145,7 +145,9 @@ public:
   /// \brief Removes the element at the given index and fills the gap with the last element in the deque.
   void RemoveAtAndSwap(nsUInt32 uiIndex); // [tested]
 
-  /// \brief Removes the element at index and fills the gap by shifting all following elements
+  /// \brief Removes the element at index and fills the gap by shifting all following elements.
+  ///
+  /// Shifts whichever side of the deque is shorter. POD and mem-relocatable types are moved chunk by chunk with memmove.
   void RemoveAtAndCopy(nsUInt32 uiIndex); // [tested]
 
   /// \brief Removes the first occurrence of value and fills the gap by shifting all following elements
@@ -155,8 +157,13 @@ public:
   bool RemoveAndSwap(const T& value); // [tested]
 
   /// \brief Inserts value at index by shifting all following elements. Valid insert positions are [0; GetCount].
+  ///
+  /// Shifts whichever side of the deque is shorter. POD and mem-relocatable types are moved chunk by chunk with memmove.
   void InsertAt(nsUInt32 uiIndex, const T& value); // [tested]
 
+  /// \brief Inserts value at index by shifting all following elements. Valid insert positions are [0; GetCount].
+  void InsertAt(nsUInt32 uiIndex, T&& value); // [tested]
+
   /// \brief Sort with explicit comparer
   template <typename Comparer>
   void Sort(const Comparer& comparer); // [tested]
@@ -248,6 +255,13 @@ private:
   /// \brief Deallocates all data, resets the deque to the state after construction.
   void DeallocateAll();
 
+  /// \brief Moves uiCount elements from uiSourceIndex to uiDestinationIndex with memmove, one contiguous piece at a time. The ranges may
+  /// overlap. Nothing is constructed or destructed, so this is only used for POD and mem-relocatable types.
+  void RawMoveElements(nsUInt32 uiDestinationIndex, nsUInt32 uiSourceIndex, nsUInt32 uiCount);
+
+  template <typename U>
+  void InsertAtImpl(nsUInt32 uiIndex, U&& value);
+
   nsAllocator* m_pAllocator;
   T** m_pChunks;                ///< The chunk index array for redirecting accesses. Not all chunks must be allocated.
   nsUInt32 m_uiChunks;          ///< The size of the m_pChunks array. Determines how many elements could theoretically be stored in the deque.
@@ -190,6 +190,8 @@ template <typename KeyType, typename Hasher = nsHashHelper<KeyType>, typename Al
 class nsHashSet : public nsHashSetBase<KeyType, Hasher>
 {
 public:
+  NS_DECLARE_MEM_RELOCATABLE_TYPE();
+
   nsHashSet();
   explicit nsHashSet(nsAllocator* pAllocator);
 
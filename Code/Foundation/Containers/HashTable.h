@@ -334,6 +334,8 @@ template <typename KeyType, typename ValueType, typename Hasher = nsHashHelper<K
 class nsHashTable : public nsHashTableBase<KeyType, ValueType, Hasher>
 {
 public:
+  NS_DECLARE_MEM_RELOCATABLE_TYPE();
+
   nsHashTable();
   explicit nsHashTable(nsAllocator* pAllocator);
 
@@ -0,0 +1,164 @@
+#pragma once
+
+#include <Foundation/Containers/DynamicArray.h>
+#include <Foundation/Math/Math.h>
+#include <Foundation/Memory/MemoryUtils.h>
+
+namespace nsInternal
+{
+  /// \brief Used as the value type of the tree behind nsBTreeSetBase, no storage is reserved for it.
+  struct nsBTreeNoValue
+  {
+  };
+
+  /// \brief The B+tree that implements nsBTreeMapBase and nsBTreeSetBase.
+  ///
+  /// All elements are stored sorted in the leaves, with the keys and the values of a leaf in separate arrays, so that searching a leaf
+  /// only touches keys. The leaves are linked in order, iterating only follows a pointer every few dozen elements.
+  /// Inner nodes store copies of keys that separate their children. All nodes except the root are at least half full.
+  template <typename KeyType, typename ValueType, typename Comparer>
+  class nsBTree
+  {
+  public:
+    static constexpr bool HasValues = !std::is_same_v<ValueType, nsBTreeNoValue>;
+
+    /// \brief Nodes are sized to fill a few cache lines.
+    static constexpr size_t TargetNodeSize = 512;
+
+    static constexpr nsUInt32 LeafCapacity = nsMath::Clamp<nsUInt32>(static_cast<nsUInt32>(TargetNodeSize / (sizeof(KeyType) + (HasValues ? sizeof(ValueType) : 0))), 4, 64);
+    static constexpr nsUInt32 InnerCapacity = nsMath::Clamp<nsUInt32>(static_cast<nsUInt32>(TargetNodeSize / (sizeof(KeyType) + sizeof(void*))), 4, 64);
+
+    static constexpr nsUInt32 MinLeafCount = LeafCapacity / 2;
+    static constexpr nsUInt32 MinInnerCount = InnerCapacity / 2;
+
+    /// \brief Every inner node has at least three children, so this is never reached.
+    static constexpr nsUInt32 MaxHeight = 32;
+
+    struct Leaf
+    {
+      Leaf* m_pPrev = nullptr;
+      Leaf* m_pNext = nullptr;
+      nsUInt32 m_uiCount = 0;
+
+      // one slot more than the capacity, an element is inserted before an overflowing leaf is split
+      alignas(KeyType) nsUInt8 m_KeyStorage[sizeof(KeyType) * (LeafCapacity + 1)];
+      alignas(ValueType) nsUInt8 m_ValueStorage[HasValues ? sizeof(ValueType) * (LeafCapacity + 1) : 1];
+
+      NS_ALWAYS_INLINE KeyType* Keys() { return reinterpret_cast<KeyType*>(m_KeyStorage); }
+      NS_ALWAYS_INLINE ValueType* Values() { return reinterpret_cast<ValueType*>(m_ValueStorage); }
+    };
+
+    struct Inner
+    {
+      nsUInt32 m_uiCount = 0; // number of keys, there is one child more
+
+      alignas(KeyType) nsUInt8 m_KeyStorage[sizeof(KeyType) * (InnerCapacity + 1)];
+      void* m_pChildren[InnerCapacity + 2];
+
+      NS_ALWAYS_INLINE KeyType* Keys() { return reinterpret_cast<KeyType*>(m_KeyStorage); }
+    };
+
+    /// \brief The location of an element, an invalid position has no leaf.
+    struct Position
+    {
+      Leaf* m_pLeaf = nullptr;
+      nsUInt32 m_uiIndex = 0;
+    };
+
+    nsBTree(const Comparer& comparer, nsAllocator* pAllocator);
+    ~nsBTree();
+
+    nsBTree(const nsBTree&) = delete;
+    void operator=(const nsBTree&) = delete;
+
+    void CopyFrom(const nsBTree& other);
+    void Clear();
+    void Swap(nsBTree& other);
+
+    /// \brief Replaces the content with uiCount elements, sorted by key. \a source is called for each element in order and
+    /// constructs the key and the value at the given locations.
+    template <typename ElementSource>
+    void Build(nsUInt32 uiCount, ElementSource&& source);
+
+    template <typename CompatibleKeyType>
+    Position Find(const CompatibleKeyType& key) const;
+
+    template <typename CompatibleKeyType>
+    Position LowerBound(const CompatibleKeyType& key) const;
+
+    template <typename CompatibleKeyType>
+    Position UpperBound(const CompatibleKeyType& key) const;
+
+    /// \brief Returns the element with the given key, a new element with a default constructed value is inserted, if it doesn't exist.
+    template <typename CompatibleKeyType>
+    Position FindOrAdd(CompatibleKeyType&& key, bool* out_pExisted);
+
+    template <typename CompatibleKeyType>
+    bool Remove(const CompatibleKeyType& key);
+
+    /// \brief Removes the element at the given position and returns the position of the element after it.
+    Position Remove(const Position& pos);
+
+    NS_ALWAYS_INLINE Position GetFirst() const { return {m_pFirstLeaf, 0}; }
+    NS_ALWAYS_INLINE Position GetLast() const { return {m_pLastLeaf, m_pLastLeaf ? m_pLastLeaf->m_uiCount - 1 : 0}; }
+
+    static void Next(Position& ref_pos);
+    static void Prev(Position& ref_pos);
+
+    NS_ALWAYS_INLINE nsUInt32 GetCount() const { return m_uiCount; }
+    NS_ALWAYS_INLINE nsAllocator* GetAllocator() const { return m_pAllocator; }
+    NS_ALWAYS_INLINE const Comparer& GetComparer() const { return m_Comparer; }
+
+    nsUInt64 GetHeapMemoryUsage() const { return m_uiNumLeaves * sizeof(Leaf) + m_uiNumInnerNodes * sizeof(Inner); }
+
+  private:
+    template <typename CompatibleKeyType>
+    NS_ALWAYS_INLINE nsUInt32 LowerBoundInNode(const KeyType* pKeys, nsUInt32 uiCount, const CompatibleKeyType& key) const;
+
+    template <typename CompatibleKeyType>
+    NS_ALWAYS_INLINE nsUInt32 UpperBoundInNode(const KeyType* pKeys, nsUInt32 uiCount, const CompatibleKeyType& key) const;
+
+    /// \brief Returns the leaf that would contain the key and optionally the inner nodes on the way to it.
+    template <typename CompatibleKeyType>
+    Leaf* Descend(const CompatibleKeyType& key, Inner** out_pPath, nsUInt32* out_pChildIndices) const;
+
+    Leaf* AllocateLeaf();
+    Inner* AllocateInner();
+    void FreeLeaf(Leaf* pLeaf);
+    void FreeInner(Inner* pInner);
+    void DestroySubtree(void* pNode, nsUInt32 uiHeight);
+
+    void LinkLeafAfter(Leaf* pLeaf, Leaf* pNewLeaf);
+    void UnlinkLeaf(Leaf* pLeaf);
+
+    /// \brief Moves constructed elements within a node. Unlike nsMemoryUtils::RelocateOverlapped, the slots that are not covered by the
+    /// source range must not be constructed, and the source slots that are not overwritten are left unconstructed.
+    template <typename T>
+    static void RelocateWithinNode(T* pDestination, T* pSource, nsUInt32 uiCount);
+
+    static void RelocateLeafElements(Leaf* pDestination, nsUInt32 uiDestinationIndex, Leaf* pSource, nsUInt32 uiSourceIndex, nsUInt32 uiCount);
+    static void ShiftLeafElements(Leaf* pLeaf, nsUInt32 uiIndex, nsUInt32 uiNewIndex);
+
+    /// \brief Removes the key at the given index and the child after it. The key must have been destructed or relocated.
+    static void EraseInnerSlot(Inner* pInner, nsUInt32 uiKeyIndex);
+
+    /// \brief Inserts the separator and the new right node into the parents, splitting them as necessary.
+    void InsertSeparator(Inner** pPath, const nsUInt32* pChildIndices, nsUInt32 uiLevel, void* pLeft, KeyType& ref_separator, void* pRight);
+
+    Position RemoveAt(Inner** pPath, const nsUInt32* pChildIndices, Leaf* pLeaf, nsUInt32 uiIndex);
+    void RebalanceLeaf(Inner* pParent, nsUInt32 uiChild, Leaf* pLeaf, Position& ref_tracked);
+    void RebalanceInner(Inner* pParent, nsUInt32 uiChild, Inner* pNode);
+
+    void* m_pRoot = nullptr;
+    Leaf* m_pFirstLeaf = nullptr;
+    Leaf* m_pLastLeaf = nullptr;
+    nsUInt32 m_uiCount = 0;
+    nsUInt32 m_uiHeight = 0; // number of levels of inner nodes
+    nsUInt32 m_uiNumLeaves = 0;
+    nsUInt32 m_uiNumInnerNodes = 0;
+    nsAllocator* m_pAllocator = nullptr;
+    Comparer m_Comparer;
+  };
+} // namespace nsInternal
+
+#include <Foundation/Containers/Implementation/BTree_inl.h>
@@ -0,0 +1,387 @@
+#pragma once
+
+// ***** Const Iterator *****
+
+template <typename KeyType, typename ValueType, typename Comparer, bool REVERSE>
+void nsBTreeMapBaseConstIteratorBase<KeyType, ValueType, Comparer, REVERSE>::Next()
+{
+  if constexpr (REVERSE)
+  {
+    Tree::Prev(m_Position);
+  }
+  else
+  {
+    Tree::Next(m_Position);
+  }
+}
+
+template <typename KeyType, typename ValueType, typename Comparer, bool REVERSE>
+void nsBTreeMapBaseConstIteratorBase<KeyType, ValueType, Comparer, REVERSE>::Prev()
+{
+  if constexpr (REVERSE)
+  {
+    Tree::Next(m_Position);
+  }
+  else
+  {
+    Tree::Prev(m_Position);
+  }
+}
+
+#if NS_ENABLED(NS_USE_CPP20_OPERATORS)
+
+// These functions are used for structured bindings.
+// They describe how many elements can be accessed in the binding and which type they are.
+namespace std
+{
+  template <typename KeyType, typename ValueType, typename Comparer, bool REVERSE>
+  struct tuple_size<nsBTreeMapBaseConstIteratorBase<KeyType, ValueType, Comparer, REVERSE>> : integral_constant<size_t, 2>
+  {
+  };
+
+  template <typename KeyType, typename ValueType, typename Comparer, bool REVERSE>
+  struct tuple_element<0, nsBTreeMapBaseConstIteratorBase<KeyType, ValueType, Comparer, REVERSE>>
+  {
+    using type = const KeyType&;
+  };
+
+  template <typename KeyType, typename ValueType, typename Comparer, bool REVERSE>
+  struct tuple_element<1, nsBTreeMapBaseConstIteratorBase<KeyType, ValueType, Comparer, REVERSE>>
+  {
+    using type = const ValueType&;
+  };
+
+
+  template <typename KeyType, typename ValueType, typename Comparer, bool REVERSE>
+  struct tuple_size<nsBTreeMapBaseIteratorBase<KeyType, ValueType, Comparer, REVERSE>> : integral_constant<size_t, 2>
+  {
+  };
+
+  template <typename KeyType, typename ValueType, typename Comparer, bool REVERSE>
+  struct tuple_element<0, nsBTreeMapBaseIteratorBase<KeyType, ValueType, Comparer, REVERSE>>
+  {
+    using type = const KeyType&;
+  };
+
+  template <typename KeyType, typename ValueType, typename Comparer, bool REVERSE>
+  struct tuple_element<1, nsBTreeMapBaseIteratorBase<KeyType, ValueType, Comparer, REVERSE>>
+  {
+    using type = ValueType&;
+  };
+} // namespace std
+#endif
+
+// ***** nsBTreeMapBase *****
+
+template <typename KeyType, typename ValueType, typename Comparer>
+nsBTreeMapBase<KeyType, ValueType, Comparer>::nsBTreeMapBase(const Comparer& comparer, nsAllocator* pAllocator)
+  : m_Tree(comparer, pAllocator)
+{
+}
+
+template <typename KeyType, typename ValueType, typename Comparer>
+nsBTreeMapBase<KeyType, ValueType, Comparer>::nsBTreeMapBase(const nsBTreeMapBase<KeyType, ValueType, Comparer>& cc, nsAllocator* pAllocator)
+  : m_Tree(cc.m_Tree.GetComparer(), pAllocator)
+{
+  m_Tree.CopyFrom(cc.m_Tree);
+}
+
+template <typename KeyType, typename ValueType, typename Comparer>
+void nsBTreeMapBase<KeyType, ValueType, Comparer>::operator=(const nsBTreeMapBase<KeyType, ValueType, Comparer>& rhs)
+{
+  m_Tree.CopyFrom(rhs.m_Tree);
+}
+
+template <typename KeyType, typename ValueType, typename Comparer>
+NS_ALWAYS_INLINE bool nsBTreeMapBase<KeyType, ValueType, Comparer>::IsEmpty() const
+{
+  return m_Tree.GetCount() == 0;
+}
+
+template <typename KeyType, typename ValueType, typename Comparer>
+NS_ALWAYS_INLINE nsUInt32 nsBTreeMapBase<KeyType, ValueType, Comparer>::GetCount() const
+{
+  return m_Tree.GetCount();
+}
+
+template <typename KeyType, typename ValueType, typename Comparer>
+void nsBTreeMapBase<KeyType, ValueType, Comparer>::Clear()
+{
+  m_Tree.Clear();
+}
+
+template <typename KeyType, typename ValueType, typename Comparer>
+NS_ALWAYS_INLINE typename nsBTreeMapBase<KeyType, ValueType, Comparer>::Iterator nsBTreeMapBase<KeyType, ValueType, Comparer>::GetIterator()
+{
+  return Iterator(m_Tree.GetFirst());
+}
+
+template <typename KeyType, typename ValueType, typename Comparer>
+NS_ALWAYS_INLINE typename nsBTreeMapBase<KeyType, ValueType, Comparer>::ReverseIterator nsBTreeMapBase<KeyType, ValueType, Comparer>::GetReverseIterator()
+{
+  return ReverseIterator(m_Tree.GetLast());
+}
+
+template <typename KeyType, typename ValueType, typename Comparer>
+NS_ALWAYS_INLINE typename nsBTreeMapBase<KeyType, ValueType, Comparer>::ConstIterator nsBTreeMapBase<KeyType, ValueType, Comparer>::GetIterator() const
+{
+  return ConstIterator(m_Tree.GetFirst());
+}
+
+template <typename KeyType, typename ValueType, typename Comparer>
+NS_ALWAYS_INLINE typename nsBTreeMapBase<KeyType, ValueType, Comparer>::ConstReverseIterator nsBTreeMapBase<KeyType, ValueType, Comparer>::GetReverseIterator() const
+{
+  return ConstReverseIterator(m_Tree.GetLast());
+}
+
+template <typename KeyType, typename ValueType, typename Comparer>
+template <typename CompatibleKeyType, typename CompatibleValueType>
+typename nsBTreeMapBase<KeyType, ValueType, Comparer>::Iterator nsBTreeMapBase<KeyType, ValueType, Comparer>::Insert(CompatibleKeyType&& key, CompatibleValueType&& value)
+{
+  auto it = FindOrAdd(std::forward<CompatibleKeyType>(key));
+  it.Value() = std::forward<CompatibleValueType>(value);
+
+  return it;
+}
+
+template <typename KeyType, typename ValueType, typename Comparer>
+template <typename CompatibleKeyType>
+bool nsBTreeMapBase<KeyType, ValueType, Comparer>::Remove(const CompatibleKeyType& key)
+{
+  return m_Tree.Remove(key);
+}
+
+template <typename KeyType, typename ValueType, typename Comparer>
+typename nsBTreeMapBase<KeyType, ValueType, Comparer>::Iterator nsBTreeMapBase<KeyType, ValueType, Comparer>::Remove(const Iterator& pos)
+{
+  NS_ASSERT_DEV(pos.IsValid(), "The Iterator(pos) is invalid.");
+
+  return Iterator(m_Tree.Remove(pos.m_Position));
+}
+
+template <typename KeyType, typename ValueType, typename Comparer>
+template <typename CompatibleKeyType>
+typename nsBTreeMapBase<KeyType, ValueType, Comparer>::Iterator nsBTreeMapBase<KeyType, ValueType, Comparer>::FindOrAdd(CompatibleKeyType&& key, bool* out_pExisted)
+{
+  return Iterator(m_Tree.FindOrAdd(std::forward<CompatibleKeyType>(key), out_pExisted));
+}
+
+template <typename KeyType, typename ValueType, typename Comparer>
+template <typename CompatibleKeyType>
+ValueType& nsBTreeMapBase<KeyType, ValueType, Comparer>::operator[](const CompatibleKeyType& key)
+{
+  return FindOrAdd(key).Value();
+}
+
+template <typename KeyType, typename ValueType, typename Comparer>
+template <typename CompatibleKeyType>
+bool nsBTreeMapBase<KeyType, ValueType, Comparer>::TryGetValue(const CompatibleKeyType& key, ValueType& out_value) const
+{
+  const auto pos = m_Tree.Find(key);
+
+  if (pos.m_pLeaf != nullptr)
+  {
+    out_value = pos.m_pLeaf->Values()[pos.m_uiIndex];
+    return true;
+  }
+
+  return false;
+}
+
+template <typename KeyType, typename ValueType, typename Comparer>
+template <typename CompatibleKeyType>
+bool nsBTreeMapBase<KeyType, ValueType, Comparer>::TryGetValue(const CompatibleKeyType& key, const ValueType*& out_pValue) const
+{
+  const auto pos = m_Tree.Find(key);
+
+  if (pos.m_pLeaf != nullptr)
+  {
+    out_pValue = &pos.m_pLeaf->Values()[pos.m_uiIndex];
+    return true;
+  }
+
+  return false;
+}
+
+template <typename KeyType, typename ValueType, typename Comparer>
+template <typename CompatibleKeyType>
+bool nsBTreeMapBase<KeyType, ValueType, Comparer>::TryGetValue(const CompatibleKeyType& key, ValueType*& out_pValue) const
+{
+  const auto pos = m_Tree.Find(key);
+
+  if (pos.m_pLeaf != nullptr)
+  {
+    out_pValue = &pos.m_pLeaf->Values()[pos.m_uiIndex];
+    return true;
+  }
+
+  return false;
+}
+
+template <typename KeyType, typename ValueType, typename Comparer>
+template <typename CompatibleKeyType>
+const ValueType* nsBTreeMapBase<KeyType, ValueType, Comparer>::GetValue(const CompatibleKeyType& key) const
+{
+  const auto pos = m_Tree.Find(key);
+  return pos.m_pLeaf != nullptr ? &pos.m_pLeaf->Values()[pos.m_uiIndex] : nullptr;
+}
+
+template <typename KeyType, typename ValueType, typename Comparer>
+template <typename CompatibleKeyType>
+ValueType* nsBTreeMapBase<KeyType, ValueType, Comparer>::GetValue(const CompatibleKeyType& key)
+{
+  const auto pos = m_Tree.Find(key);
+  return pos.m_pLeaf != nullptr ? &pos.m_pLeaf->Values()[pos.m_uiIndex] : nullptr;
+}
+
+template <typename KeyType, typename ValueType, typename Comparer>
+template <typename CompatibleKeyType>
+const ValueType& nsBTreeMapBase<KeyType, ValueType, Comparer>::GetValueOrDefault(const CompatibleKeyType& key, const ValueType& defaultValue) const
+{
+  const auto pos = m_Tree.Find(key);
+  return pos.m_pLeaf != nullptr ? pos.m_pLeaf->Values()[pos.m_uiIndex] : defaultValue;
+}
+
+template <typename KeyType, typename ValueType, typename Comparer>
+template <typename CompatibleKeyType>
+NS_ALWAYS_INLINE typename nsBTreeMapBase<KeyType, ValueType, Comparer>::Iterator nsBTreeMapBase<KeyType, ValueType, Comparer>::Find(const CompatibleKeyType& key)
+{
+  return Iterator(m_Tree.Find(key));
+}
+
+template <typename KeyType, typename ValueType, typename Comparer>
+template <typename CompatibleKeyType>
+NS_ALWAYS_INLINE typename nsBTreeMapBase<KeyType, ValueType, Comparer>::ConstIterator nsBTreeMapBase<KeyType, ValueType, Comparer>::Find(const CompatibleKeyType& key) const
+{
+  return ConstIterator(m_Tree.Find(key));
+}
+
+template <typename KeyType, typename ValueType, typename Comparer>
+template <typename CompatibleKeyType>
+NS_ALWAYS_INLINE bool nsBTreeMapBase<KeyType, ValueType, Comparer>::Contains(const CompatibleKeyType& key) const
+{
+  return m_Tree.Find(key).m_pLeaf != nullptr;
+}
+
+template <typename KeyType, typename ValueType, typename Comparer>
+template <typename CompatibleKeyType>
+NS_ALWAYS_INLINE typename nsBTreeMapBase<KeyType, ValueType, Comparer>::Iterator nsBTreeMapBase<KeyType, ValueType, Comparer>::LowerBound(const CompatibleKeyType& key)
+{
+  return Iterator(m_Tree.LowerBound(key));
+}
+
+template <typename KeyType, typename ValueType, typename Comparer>
+template <typename CompatibleKeyType>
+NS_ALWAYS_INLINE typename nsBTreeMapBase<KeyType, ValueType, Comparer>::ConstIterator nsBTreeMapBase<KeyType, ValueType, Comparer>::LowerBound(const CompatibleKeyType& key) const
+{
+  return ConstIterator(m_Tree.LowerBound(key));
+}
+
+template <typename KeyType, typename ValueType, typename Comparer>
+template <typename CompatibleKeyType>
+NS_ALWAYS_INLINE typename nsBTreeMapBase<KeyType, ValueType, Comparer>::Iterator nsBTreeMapBase<KeyType, ValueType, Comparer>::UpperBound(const CompatibleKeyType& key)
+{
+  return Iterator(m_Tree.UpperBound(key));
+}
+
+template <typename KeyType, typename ValueType, typename Comparer>
+template <typename CompatibleKeyType>
+NS_ALWAYS_INLINE typename nsBTreeMapBase<KeyType, ValueType, Comparer>::ConstIterator nsBTreeMapBase<KeyType, ValueType, Comparer>::UpperBound(const CompatibleKeyType& key) const
+{
+  return ConstIterator(m_Tree.UpperBound(key));
+}
+
+template <typename KeyType, typename ValueType, typename Comparer>
+void nsBTreeMapBase<KeyType, ValueType, Comparer>::BulkLoad(nsArrayPtr<const KeyType> keys, nsArrayPtr<const ValueType> values)
+{
+  NS_ASSERT_DEV(keys.GetCount() == values.GetCount(), "The number of keys ({0}) and values ({1}) must be equal.", keys.GetCount(), values.GetCount());
+
+#if NS_ENABLED(NS_COMPILE_FOR_DEVELOPMENT)
+  for (nsUInt32 i = 1; i < keys.GetCount(); ++i)
+  {
+    NS_ASSERT_DEV(m_Tree.GetComparer().Less(keys[i - 1], keys[i]), "The keys must be sorted and unique.");
+  }
+#endif
+
+  nsUInt32 uiNext = 0;
+
+  m_Tree.Build(keys.GetCount(), [&](KeyType* pKey, ValueType* pValue)
+    {
+      nsMemoryUtils::CopyConstruct(pKey, keys[uiNext], 1);
+      nsMemoryUtils::CopyConstruct(pValue, values[uiNext], 1);
+      ++uiNext; });
+}
+
+template <typename KeyType, typename ValueType, typename Comparer>
+bool nsBTreeMapBase<KeyType, ValueType, Comparer>::operator==(const nsBTreeMapBase<KeyType, ValueType, Comparer>& rhs) const
+{
+  if (GetCount() != rhs.GetCount())
+    return false;
+
+  auto itLhs = GetIterator();
+  auto itRhs = rhs.GetIterator();
+
+  while (itLhs.IsValid())
+  {
+    if (!m_Tree.GetComparer().Equal(itLhs.Key(), itRhs.Key()))
+      return false;
+
+    if (itLhs.Value() != itRhs.Value())
+      return false;
+
+    ++itLhs;
+    ++itRhs;
+  }
+
+  return true;
+}
+
+template <typename KeyType, typename ValueType, typename Comparer>
+void nsBTreeMapBase<KeyType, ValueType, Comparer>::Swap(nsBTreeMapBase<KeyType, ValueType, Comparer>& other)
+{
+  m_Tree.Swap(other.m_Tree);
+}
+
+// ***** nsBTreeMap *****
+
+template <typename KeyType, typename ValueType, typename Comparer, typename AllocatorWrapper>
+nsBTreeMap<KeyType, ValueType, Comparer, AllocatorWrapper>::nsBTreeMap()
+  : nsBTreeMapBase<KeyType, ValueType, Comparer>(Comparer(), AllocatorWrapper::GetAllocator())
+{
+}
+
+template <typename KeyType, typename ValueType, typename Comparer, typename AllocatorWrapper>
+nsBTreeMap<KeyType, ValueType, Comparer, AllocatorWrapper>::nsBTreeMap(nsAllocator* pAllocator)
+  : nsBTreeMapBase<KeyType, ValueType, Comparer>(Comparer(), pAllocator)
+{
+}
+
+template <typename KeyType, typename ValueType, typename Comparer, typename AllocatorWrapper>
+nsBTreeMap<KeyType, ValueType, Comparer, AllocatorWrapper>::nsBTreeMap(const Comparer& comparer, nsAllocator* pAllocator)
+  : nsBTreeMapBase<KeyType, ValueType, Comparer>(comparer, pAllocator)
+{
+}
+
+template <typename KeyType, typename ValueType, typename Comparer, typename AllocatorWrapper>
+nsBTreeMap<KeyType, ValueType, Comparer, AllocatorWrapper>::nsBTreeMap(const nsBTreeMap<KeyType, ValueType, Comparer, AllocatorWrapper>& other)
+  : nsBTreeMapBase<KeyType, ValueType, Comparer>(other, AllocatorWrapper::GetAllocator())
+{
+}
+
+template <typename KeyType, typename ValueType, typename Comparer, typename AllocatorWrapper>
+nsBTreeMap<KeyType, ValueType, Comparer, AllocatorWrapper>::nsBTreeMap(const nsBTreeMapBase<KeyType, ValueType, Comparer>& other)
+  : nsBTreeMapBase<KeyType, ValueType, Comparer>(other, AllocatorWrapper::GetAllocator())
+{
+}
+
+template <typename KeyType, typename ValueType, typename Comparer, typename AllocatorWrapper>
+void nsBTreeMap<KeyType, ValueType, Comparer, AllocatorWrapper>::operator=(const nsBTreeMap<KeyType, ValueType, Comparer, AllocatorWrapper>& rhs)
+{
+  nsBTreeMapBase<KeyType, ValueType, Comparer>::operator=(rhs);
+}
+
+template <typename KeyType, typename ValueType, typename Comparer, typename AllocatorWrapper>
+void nsBTreeMap<KeyType, ValueType, Comparer, AllocatorWrapper>::operator=(const nsBTreeMapBase<KeyType, ValueType, Comparer>& rhs)
+{
+  nsBTreeMapBase<KeyType, ValueType, Comparer>::operator=(rhs);
+}
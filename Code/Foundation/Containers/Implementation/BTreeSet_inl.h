@@ -0,0 +1,261 @@
+#pragma once
+
+// ***** Const Iterator *****
+
+template <typename KeyType, typename Comparer>
+template <bool REVERSE>
+void nsBTreeSetBase<KeyType, Comparer>::IteratorBase<REVERSE>::Next()
+{
+  if constexpr (REVERSE)
+  {
+    Tree::Prev(m_Position);
+  }
+  else
+  {
+    Tree::Next(m_Position);
+  }
+}
+
+template <typename KeyType, typename Comparer>
+template <bool REVERSE>
+void nsBTreeSetBase<KeyType, Comparer>::IteratorBase<REVERSE>::Prev()
+{
+  if constexpr (REVERSE)
+  {
+    Tree::Next(m_Position);
+  }
+  else
+  {
+    Tree::Prev(m_Position);
+  }
+}
+
+// ***** nsBTreeSetBase *****
+
+template <typename KeyType, typename Comparer>
+nsBTreeSetBase<KeyType, Comparer>::nsBTreeSetBase(const Comparer& comparer, nsAllocator* pAllocator)
+  : m_Tree(comparer, pAllocator)
+{
+}
+
+template <typename KeyType, typename Comparer>
+nsBTreeSetBase<KeyType, Comparer>::nsBTreeSetBase(const nsBTreeSetBase<KeyType, Comparer>& cc, nsAllocator* pAllocator)
+  : m_Tree(cc.m_Tree.GetComparer(), pAllocator)
+{
+  m_Tree.CopyFrom(cc.m_Tree);
+}
+
+template <typename KeyType, typename Comparer>
+void nsBTreeSetBase<KeyType, Comparer>::operator=(const nsBTreeSetBase<KeyType, Comparer>& rhs)
+{
+  m_Tree.CopyFrom(rhs.m_Tree);
+}
+
+template <typename KeyType, typename Comparer>
+NS_ALWAYS_INLINE bool nsBTreeSetBase<KeyType, Comparer>::IsEmpty() const
+{
+  return m_Tree.GetCount() == 0;
+}
+
+template <typename KeyType, typename Comparer>
+NS_ALWAYS_INLINE nsUInt32 nsBTreeSetBase<KeyType, Comparer>::GetCount() const
+{
+  return m_Tree.GetCount();
+}
+
+template <typename KeyType, typename Comparer>
+void nsBTreeSetBase<KeyType, Comparer>::Clear()
+{
+  m_Tree.Clear();
+}
+
+template <typename KeyType, typename Comparer>
+NS_ALWAYS_INLINE typename nsBTreeSetBase<KeyType, Comparer>::Iterator nsBTreeSetBase<KeyType, Comparer>::GetIterator() const
+{
+  return Iterator(m_Tree.GetFirst());
+}
+
+template <typename KeyType, typename Comparer>
+NS_ALWAYS_INLINE typename nsBTreeSetBase<KeyType, Comparer>::ReverseIterator nsBTreeSetBase<KeyType, Comparer>::GetReverseIterator() const
+{
+  return ReverseIterator(m_Tree.GetLast());
+}
+
+template <typename KeyType, typename Comparer>
+template <typename CompatibleKeyType>
+typename nsBTreeSetBase<KeyType, Comparer>::Iterator nsBTreeSetBase<KeyType, Comparer>::Insert(CompatibleKeyType&& key)
+{
+  return Iterator(m_Tree.FindOrAdd(std::forward<CompatibleKeyType>(key), nullptr));
+}
+
+template <typename KeyType, typename Comparer>
+template <typename CompatibleKeyType>
+bool nsBTreeSetBase<KeyType, Comparer>::Remove(const CompatibleKeyType& key)
+{
+  return m_Tree.Remove(key);
+}
+
+template <typename KeyType, typename Comparer>
+typename nsBTreeSetBase<KeyType, Comparer>::Iterator nsBTreeSetBase<KeyType, Comparer>::Remove(const Iterator& pos)
+{
+  NS_ASSERT_DEV(pos.IsValid(), "The Iterator(pos) is invalid.");
+
+  return Iterator(m_Tree.Remove(pos.m_Position));
+}
+
+template <typename KeyType, typename Comparer>
+template <typename CompatibleKeyType>
+NS_ALWAYS_INLINE typename nsBTreeSetBase<KeyType, Comparer>::Iterator nsBTreeSetBase<KeyType, Comparer>::Find(const CompatibleKeyType& key) const
+{
+  return Iterator(m_Tree.Find(key));
+}
+
+template <typename KeyType, typename Comparer>
+template <typename CompatibleKeyType>
+NS_ALWAYS_INLINE bool nsBTreeSetBase<KeyType, Comparer>::Contains(const CompatibleKeyType& key) const
+{
+  return m_Tree.Find(key).m_pLeaf != nullptr;
+}
+
+template <typename KeyType, typename Comparer>
+bool nsBTreeSetBase<KeyType, Comparer>::ContainsSet(const nsBTreeSetBase<KeyType, Comparer>& operand) const
+{
+  for (const KeyType& key : operand)
+  {
+    if (!Contains(key))
+      return false;
+  }
+
+  return true;
+}
+
+template <typename KeyType, typename Comparer>
+template <typename CompatibleKeyType>
+NS_ALWAYS_INLINE typename nsBTreeSetBase<KeyType, Comparer>::Iterator nsBTreeSetBase<KeyType, Comparer>::LowerBound(const CompatibleKeyType& key) const
+{
+  return Iterator(m_Tree.LowerBound(key));
+}
+
+template <typename KeyType, typename Comparer>
+template <typename CompatibleKeyType>
+NS_ALWAYS_INLINE typename nsBTreeSetBase<KeyType, Comparer>::Iterator nsBTreeSetBase<KeyType, Comparer>::UpperBound(const CompatibleKeyType& key) const
+{
+  return Iterator(m_Tree.UpperBound(key));
+}
+
+template <typename KeyType, typename Comparer>
+void nsBTreeSetBase<KeyType, Comparer>::Union(const nsBTreeSetBase<KeyType, Comparer>& operand)
+{
+  for (const auto& key : operand)
+  {
+    Insert(key);
+  }
+}
+
+template <typename KeyType, typename Comparer>
+void nsBTreeSetBase<KeyType, Comparer>::Difference(const nsBTreeSetBase<KeyType, Comparer>& operand)
+{
+  for (const auto& key : operand)
+  {
+    Remove(key);
+  }
+}
+
+template <typename KeyType, typename Comparer>
+void nsBTreeSetBase<KeyType, Comparer>::Intersection(const nsBTreeSetBase<KeyType, Comparer>& operand)
+{
+  for (auto it = GetIterator(); it.IsValid();)
+  {
+    if (!operand.Contains(it.Key()))
+      it = Remove(it);
+    else
+      ++it;
+  }
+}
+
+template <typename KeyType, typename Comparer>
+void nsBTreeSetBase<KeyType, Comparer>::BulkLoad(nsArrayPtr<const KeyType> keys)
+{
+#if NS_ENABLED(NS_COMPILE_FOR_DEVELOPMENT)
+  for (nsUInt32 i = 1; i < keys.GetCount(); ++i)
+  {
+    NS_ASSERT_DEV(m_Tree.GetComparer().Less(keys[i - 1], keys[i]), "The keys must be sorted and unique.");
+  }
+#endif
+
+  nsUInt32 uiNext = 0;
+
+  m_Tree.Build(keys.GetCount(), [&](KeyType* pKey, nsInternal::nsBTreeNoValue*)
+    { nsMemoryUtils::CopyConstruct(pKey, keys[uiNext++], 1); });
+}
+
+template <typename KeyType, typename Comparer>
+bool nsBTreeSetBase<KeyType, Comparer>::operator==(const nsBTreeSetBase<KeyType, Comparer>& rhs) const
+{
+  if (GetCount() != rhs.GetCount())
+    return false;
+
+  auto itLhs = GetIterator();
+  auto itRhs = rhs.GetIterator();
+
+  while (itLhs.IsValid())
+  {
+    if (!m_Tree.GetComparer().Equal(itLhs.Key(), itRhs.Key()))
+      return false;
+
+    ++itLhs;
+    ++itRhs;
+  }
+
+  return true;
+}
+
+template <typename KeyType, typename Comparer>
+void nsBTreeSetBase<KeyType, Comparer>::Swap(nsBTreeSetBase<KeyType, Comparer>& other)
+{
+  m_Tree.Swap(other.m_Tree);
+}
+
+// ***** nsBTreeSet *****
+
+template <typename KeyType, typename Comparer, typename AllocatorWrapper>
+nsBTreeSet<KeyType, Comparer, AllocatorWrapper>::nsBTreeSet()
+  : nsBTreeSetBase<KeyType, Comparer>(Comparer(), AllocatorWrapper::GetAllocator())
+{
+}
+
+template <typename KeyType, typename Comparer, typename AllocatorWrapper>
+nsBTreeSet<KeyType, Comparer, AllocatorWrapper>::nsBTreeSet(nsAllocator* pAllocator)
+  : nsBTreeSetBase<KeyType, Comparer>(Comparer(), pAllocator)
+{
+}
+
+template <typename KeyType, typename Comparer, typename AllocatorWrapper>
+nsBTreeSet<KeyType, Comparer, AllocatorWrapper>::nsBTreeSet(const Comparer& comparer, nsAllocator* pAllocator)
+  : nsBTreeSetBase<KeyType, Comparer>(comparer, pAllocator)
+{
+}
+
+template <typename KeyType, typename Comparer, typename AllocatorWrapper>
+nsBTreeSet<KeyType, Comparer, AllocatorWrapper>::nsBTreeSet(const nsBTreeSet<KeyType, Comparer, AllocatorWrapper>& other)
+  : nsBTreeSetBase<KeyType, Comparer>(other, AllocatorWrapper::GetAllocator())
+{
+}
+
+template <typename KeyType, typename Comparer, typename AllocatorWrapper>
+nsBTreeSet<KeyType, Comparer, AllocatorWrapper>::nsBTreeSet(const nsBTreeSetBase<KeyType, Comparer>& other)
+  : nsBTreeSetBase<KeyType, Comparer>(other, AllocatorWrapper::GetAllocator())
+{
+}
+
+template <typename KeyType, typename Comparer, typename AllocatorWrapper>
+void nsBTreeSet<KeyType, Comparer, AllocatorWrapper>::operator=(const nsBTreeSet<KeyType, Comparer, AllocatorWrapper>& rhs)
+{
+  nsBTreeSetBase<KeyType, Comparer>::operator=(rhs);
+}
+
+template <typename KeyType, typename Comparer, typename AllocatorWrapper>
+void nsBTreeSet<KeyType, Comparer, AllocatorWrapper>::operator=(const nsBTreeSetBase<KeyType, Comparer>& rhs)
+{
+  nsBTreeSetBase<KeyType, Comparer>::operator=(rhs);
+}
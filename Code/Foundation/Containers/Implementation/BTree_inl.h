@@ -0,0 +1,746 @@
+#pragma once
+
+namespace nsInternal
+{
+  template <typename KeyType, typename ValueType, typename Comparer>
+  nsBTree<KeyType, ValueType, Comparer>::nsBTree(const Comparer& comparer, nsAllocator* pAllocator)
+    : m_pAllocator(pAllocator)
+    , m_Comparer(comparer)
+  {
+  }
+
+  template <typename KeyType, typename ValueType, typename Comparer>
+  nsBTree<KeyType, ValueType, Comparer>::~nsBTree()
+  {
+    Clear();
+  }
+
+  template <typename KeyType, typename ValueType, typename Comparer>
+  void nsBTree<KeyType, ValueType, Comparer>::CopyFrom(const nsBTree& other)
+  {
+    if (this == &other)
+      return;
+
+    Position pos = other.GetFirst();
+
+    Build(other.m_uiCount, [&](KeyType* pKey, ValueType* pValue)
+      {
+        nsMemoryUtils::CopyConstruct(pKey, pos.m_pLeaf->Keys()[pos.m_uiIndex], 1);
+
+        if constexpr (HasValues)
+          nsMemoryUtils::CopyConstruct(pValue, pos.m_pLeaf->Values()[pos.m_uiIndex], 1);
+        else
+          NS_IGNORE_UNUSED(pValue);
+
+        Next(pos); });
+  }
+
+  template <typename KeyType, typename ValueType, typename Comparer>
+  void nsBTree<KeyType, ValueType, Comparer>::Clear()
+  {
+    if (m_pRoot != nullptr)
+    {
+      DestroySubtree(m_pRoot, m_uiHeight);
+    }
+
+    m_pRoot = nullptr;
+    m_pFirstLeaf = nullptr;
+    m_pLastLeaf = nullptr;
+    m_uiCount = 0;
+    m_uiHeight = 0;
+  }
+
+  template <typename KeyType, typename ValueType, typename Comparer>
+  void nsBTree<KeyType, ValueType, Comparer>::Swap(nsBTree& other)
+  {
+    nsMath::Swap(m_pRoot, other.m_pRoot);
+    nsMath::Swap(m_pFirstLeaf, other.m_pFirstLeaf);
+    nsMath::Swap(m_pLastLeaf, other.m_pLastLeaf);
+    nsMath::Swap(m_uiCount, other.m_uiCount);
+    nsMath::Swap(m_uiHeight, other.m_uiHeight);
+    nsMath::Swap(m_uiNumLeaves, other.m_uiNumLeaves);
+    nsMath::Swap(m_uiNumInnerNodes, other.m_uiNumInnerNodes);
+    nsMath::Swap(m_pAllocator, other.m_pAllocator);
+    nsMath::Swap(m_Comparer, other.m_Comparer);
+  }
+
+  template <typename KeyType, typename ValueType, typename Comparer>
+  template <typename ElementSource>
+  void nsBTree<KeyType, ValueType, Comparer>::Build(nsUInt32 uiCount, ElementSource&& source)
+  {
+    Clear();
+
+    if (uiCount == 0)
+      return;
+
+    // the nodes of the level that is currently built and the smallest key in each of them
+    nsDynamicArray<void*> nodes(m_pAllocator);
+    nsDynamicArray<const KeyType*> firstKeys(m_pAllocator);
+
+    const nsUInt32 uiNumLeaves = (uiCount + LeafCapacity - 1) / LeafCapacity;
+    nodes.Reserve(uiNumLeaves);
+    firstKeys.Reserve(uiNumLeaves);
+
+    Leaf* pPrevLeaf = nullptr;
+
+    for (nsUInt32 i = 0; i < uiNumLeaves; ++i)
+    {
+      // the elements are distributed evenly, so that all leaves are at least half full
+      const nsUInt32 uiLeafCount = uiCount / uiNumLeaves + (i < uiCount % uiNumLeaves ? 1 : 0);
+
+      Leaf* pLeaf = AllocateLeaf();
+
+      for (nsUInt32 j = 0; j < uiLeafCount; ++j)
+      {
+        source(pLeaf->Keys() + j, pLeaf->Values() + j);
+      }
+
+      pLeaf->m_uiCount = uiLeafCount;
+      pLeaf->m_pPrev = pPrevLeaf;
+
+      if (pPrevLeaf != nullptr)
+        pPrevLeaf->m_pNext = pLeaf;
+      else
+        m_pFirstLeaf = pLeaf;
+
+      pPrevLeaf = pLeaf;
+
+      nodes.PushBack(pLeaf);
+      firstKeys.PushBack(pLeaf->Keys());
+    }
+
+    m_pLastLeaf = pPrevLeaf;
+    m_uiCount = uiCount;
+
+    while (nodes.GetCount() > 1)
+    {
+      const nsUInt32 uiNumChildren = nodes.GetCount();
+      const nsUInt32 uiNumParents = (uiNumChildren + InnerCapacity) / (InnerCapacity + 1);
+
+      nsUInt32 uiChild = 0;
+
+      for (nsUInt32 i = 0; i < uiNumParents; ++i)
+      {
+        const nsUInt32 uiNumParentChildren = uiNumChildren / uiNumParents + (i < uiNumChildren % uiNumParents ? 1 : 0);
+
+        Inner* pInner = AllocateInner();
+        pInner->m_pChildren[0] = nodes[uiChild];
+
+        for (nsUInt32 j = 1; j < uiNumParentChildren; ++j)
+        {
+          pInner->m_pChildren[j] = nodes[uiChild + j];
+          nsMemoryUtils::CopyConstruct(pInner->Keys() + j - 1, *firstKeys[uiChild + j], 1);
+        }
+
+        pInner->m_uiCount = uiNumParentChildren - 1;
+
+        // the parents overwrite children that were already consumed
+        nodes[i] = pInner;
+        firstKeys[i] = firstKeys[uiChild];
+
+        uiChild += uiNumParentChildren;
+      }
+
+      nodes.SetCount(uiNumParents);
+      firstKeys.SetCount(uiNumParents);
+      ++m_uiHeight;
+    }
+
+    m_pRoot = nodes[0];
+  }
+
+  template <typename KeyType, typename ValueType, typename Comparer>
+  template <typename CompatibleKeyType>
+  NS_ALWAYS_INLINE nsUInt32 nsBTree<KeyType, ValueType, Comparer>::LowerBoundInNode(const KeyType* pKeys, nsUInt32 uiCount, const CompatibleKeyType& key) const
+  {
+    nsUInt32 uiLow = 0;
+    nsUInt32 uiHigh = uiCount;
+
+    while (uiLow < uiHigh)
+    {
+      const nsUInt32 uiMiddle = (uiLow + uiHigh) / 2;
+
+      if (m_Comparer.Less(pKeys[uiMiddle], key))
+        uiLow = uiMiddle + 1;
+      else
+        uiHigh = uiMiddle;
+    }
+
+    return uiLow;
+  }
+
+  template <typename KeyType, typename ValueType, typename Comparer>
+  template <typename CompatibleKeyType>
+  NS_ALWAYS_INLINE nsUInt32 nsBTree<KeyType, ValueType, Comparer>::UpperBoundInNode(const KeyType* pKeys, nsUInt32 uiCount, const CompatibleKeyType& key) const
+  {
+    nsUInt32 uiLow = 0;
+    nsUInt32 uiHigh = uiCount;
+
+    while (uiLow < uiHigh)
+    {
+      const nsUInt32 uiMiddle = (uiLow + uiHigh) / 2;
+
+      if (m_Comparer.Less(key, pKeys[uiMiddle]))
+        uiHigh = uiMiddle;
+      else
+        uiLow = uiMiddle + 1;
+    }
+
+    return uiLow;
+  }
+
+  template <typename KeyType, typename ValueType, typename Comparer>
+  template <typename CompatibleKeyType>
+  typename nsBTree<KeyType, ValueType, Comparer>::Leaf* nsBTree<KeyType, ValueType, Comparer>::Descend(const CompatibleKeyType& key, Inner** out_pPath, nsUInt32* out_pChildIndices) const
+  {
+    void* pNode = m_pRoot;
+
+    for (nsUInt32 uiLevel = 0; uiLevel < m_uiHeight; ++uiLevel)
+    {
+      Inner* pInner = static_cast<Inner*>(pNode);
+
+      // child i holds the keys that are not smaller than separator i - 1 and smaller than separator i
+      const nsUInt32 uiChild = UpperBoundInNode(pInner->Keys(), pInner->m_uiCount, key);
+
+      if (out_pPath != nullptr)
+      {
+        out_pPath[uiLevel] = pInner;
+        out_pChildIndices[uiLevel] = uiChild;
+      }
+
+      pNode = pInner->m_pChildren[uiChild];
+    }
+
+    return static_cast<Leaf*>(pNode);
+  }
+
+  template <typename KeyType, typename ValueType, typename Comparer>
+  template <typename CompatibleKeyType>
+  typename nsBTree<KeyType, ValueType, Comparer>::Position nsBTree<KeyType, ValueType, Comparer>::Find(const CompatibleKeyType& key) const
+  {
+    if (m_pRoot == nullptr)
+      return {};
+
+    Leaf* pLeaf = Descend(key, nullptr, nullptr);
+    const nsUInt32 uiIndex = LowerBoundInNode(pLeaf->Keys(), pLeaf->m_uiCount, key);
+
+    if (uiIndex < pLeaf->m_uiCount && !m_Comparer.Less(key, pLeaf->Keys()[uiIndex]))
+      return {pLeaf, uiIndex};
+
+    return {};
+  }
+
+  template <typename KeyType, typename ValueType, typename Comparer>
+  template <typename CompatibleKeyType>
+  typename nsBTree<KeyType, ValueType, Comparer>::Position nsBTree<KeyType, ValueType, Comparer>::LowerBound(const CompatibleKeyType& key) const
+  {
+    if (m_pRoot == nullptr)
+      return {};
+
+    Leaf* pLeaf = Descend(key, nullptr, nullptr);
+    const nsUInt32 uiIndex = LowerBoundInNode(pLeaf->Keys(), pLeaf->m_uiCount, key);
+
+    if (uiIndex < pLeaf->m_uiCount)
+      return {pLeaf, uiIndex};
+
+    // all keys in the following leaves are larger
+    return {pLeaf->m_pNext, 0};
+  }
+
+  template <typename KeyType, typename ValueType, typename Comparer>
+  template <typename CompatibleKeyType>
+  typename nsBTree<KeyType, ValueType, Comparer>::Position nsBTree<KeyType, ValueType, Comparer>::UpperBound(const CompatibleKeyType& key) const
+  {
+    if (m_pRoot == nullptr)
+      return {};
+
+    Leaf* pLeaf = Descend(key, nullptr, nullptr);
+    const nsUInt32 uiIndex = UpperBoundInNode(pLeaf->Keys(), pLeaf->m_uiCount, key);
+
+    if (uiIndex < pLeaf->m_uiCount)
+      return {pLeaf, uiIndex};
+
+    return {pLeaf->m_pNext, 0};
+  }
+
+  template <typename KeyType, typename ValueType, typename Comparer>
+  template <typename CompatibleKeyType>
+  typename nsBTree<KeyType, ValueType, Comparer>::Position nsBTree<KeyType, ValueType, Comparer>::FindOrAdd(CompatibleKeyType&& key, bool* out_pExisted)
+  {
+    if (m_pRoot == nullptr)
+    {
+      Leaf* pLeaf = AllocateLeaf();
+      m_pRoot = pLeaf;
+      m_pFirstLeaf = pLeaf;
+      m_pLastLeaf = pLeaf;
+    }
+
+    Inner* path[MaxHeight];
+    nsUInt32 childIndices[MaxHeight];
+
+    Leaf* pLeaf = Descend(key, path, childIndices);
+    const nsUInt32 uiIndex = LowerBoundInNode(pLeaf->Keys(), pLeaf->m_uiCount, key);
+
+    if (uiIndex < pLeaf->m_uiCount && !m_Comparer.Less(key, pLeaf->Keys()[uiIndex]))
+    {
+      if (out_pExisted)
+        *out_pExisted = true;
+
+      return {pLeaf, uiIndex};
+    }
+
+    if (out_pExisted)
+      *out_pExisted = false;
+
+    ShiftLeafElements(pLeaf, uiIndex, uiIndex + 1);
+    nsMemoryUtils::CopyOrMoveConstruct(pLeaf->Keys() + uiIndex, std::forward<CompatibleKeyType>(key));
+
+    if constexpr (HasValues)
+      new (pLeaf->Values() + uiIndex) ValueType();
+
+    ++pLeaf->m_uiCount;
+    ++m_uiCount;
+
+    if (pLeaf->m_uiCount <= LeafCapacity)
+      return {pLeaf, uiIndex};
+
+    // the leaf overflows, the upper half moves into a new leaf
+    Leaf* pRight = AllocateLeaf();
+    LinkLeafAfter(pLeaf, pRight);
+
+    const nsUInt32 uiLeftCount = pLeaf->m_uiCount / 2;
+    pRight->m_uiCount = pLeaf->m_uiCount - uiLeftCount;
+    RelocateLeafElements(pRight, 0, pLeaf, uiLeftCount, pRight->m_uiCount);
+    pLeaf->m_uiCount = uiLeftCount;
+
+    const Position result = uiIndex < uiLeftCount ? Position{pLeaf, uiIndex} : Position{pRight, uiIndex - uiLeftCount};
+
+    KeyType separator = pRight->Keys()[0];
+    InsertSeparator(path, childIndices, m_uiHeight, pLeaf, separator, pRight);
+
+    return result;
+  }
+
+  template <typename KeyType, typename ValueType, typename Comparer>
+  void nsBTree<KeyType, ValueType, Comparer>::InsertSeparator(Inner** pPath, const nsUInt32* pChildIndices, nsUInt32 uiLevel, void* pLeft, KeyType& ref_separator, void* pRight)
+  {
+    while (uiLevel > 0)
+    {
+      --uiLevel;
+
+      Inner* pParent = pPath[uiLevel];
+      const nsUInt32 uiChild = pChildIndices[uiLevel];
+
+      // pLeft is child uiChild, the separator goes right after it, followed by pRight
+      RelocateWithinNode(pParent->Keys() + uiChild + 1, pParent->Keys() + uiChild, pParent->m_uiCount - uiChild);
+      nsMemoryUtils::CopyOverlapped(pParent->m_pChildren + uiChild + 2, pParent->m_pChildren + uiChild + 1, pParent->m_uiCount - uiChild);
+
+      nsMemoryUtils::MoveConstruct(pParent->Keys() + uiChild, std::move(ref_separator));
+      pParent->m_pChildren[uiChild + 1] = pRight;
+      ++pParent->m_uiCount;
+
+      if (pParent->m_uiCount <= InnerCapacity)
+        return;
+
+      // the parent overflows as well, its middle key moves up and the keys after it into a new node
+      Inner* pNewRight = AllocateInner();
+
+      const nsUInt32 uiMiddle = pParent->m_uiCount / 2;
+      pNewRight->m_uiCount = pParent->m_uiCount - uiMiddle - 1;
+
+      nsMemoryUtils::RelocateConstruct(pNewRight->Keys(), pParent->Keys() + uiMiddle + 1, pNewRight->m_uiCount);
+      nsMemoryUtils::Copy(pNewRight->m_pChildren, pParent->m_pChildren + uiMiddle + 1, pNewRight->m_uiCount + 1);
+
+      ref_separator = std::move(pParent->Keys()[uiMiddle]);
+      nsMemoryUtils::Destruct(pParent->Keys() + uiMiddle, 1);
+      pParent->m_uiCount = uiMiddle;
+
+      pLeft = pParent;
+      pRight = pNewRight;
+    }
+
+    // the root was split, the tree grows by one level
+    Inner* pRoot = AllocateInner();
+    nsMemoryUtils::MoveConstruct(pRoot->Keys(), std::move(ref_separator));
+    pRoot->m_pChildren[0] = pLeft;
+    pRoot->m_pChildren[1] = pRight;
+    pRoot->m_uiCount = 1;
+
+    m_pRoot = pRoot;
+    ++m_uiHeight;
+
+    NS_ASSERT_DEV(m_uiHeight < MaxHeight, "The B-tree is too high.");
+  }
+
+  template <typename KeyType, typename ValueType, typename Comparer>
+  template <typename CompatibleKeyType>
+  bool nsBTree<KeyType, ValueType, Comparer>::Remove(const CompatibleKeyType& key)
+  {
+    if (m_pRoot == nullptr)
+      return false;
+
+    Inner* path[MaxHeight];
+    nsUInt32 childIndices[MaxHeight];
+
+    Leaf* pLeaf = Descend(key, path, childIndices);
+    const nsUInt32 uiIndex = LowerBoundInNode(pLeaf->Keys(), pLeaf->m_uiCount, key);
+
+    if (uiIndex == pLeaf->m_uiCount || m_Comparer.Less(key, pLeaf->Keys()[uiIndex]))
+      return false;
+
+    RemoveAt(path, childIndices, pLeaf, uiIndex);
+    return true;
+  }
+
+  template <typename KeyType, typename ValueType, typename Comparer>
+  typename nsBTree<KeyType, ValueType, Comparer>::Position nsBTree<KeyType, ValueType, Comparer>::Remove(const Position& pos)
+  {
+    NS_ASSERT_DEV(pos.m_pLeaf != nullptr, "The Iterator(pos) is invalid.");
+
+    Inner* path[MaxHeight];
+    nsUInt32 childIndices[MaxHeight];
+
+    // the path to the leaf is needed for rebalancing
+    Leaf* pLeaf = Descend(pos.m_pLeaf->Keys()[pos.m_uiIndex], path, childIndices);
+    NS_ASSERT_DEBUG(pLeaf == pos.m_pLeaf, "The Iterator(pos) does not belong to this container.");
+
+    return RemoveAt(path, childIndices, pLeaf, pos.m_uiIndex);
+  }
+
+  template <typename KeyType, typename ValueType, typename Comparer>
+  typename nsBTree<KeyType, ValueType, Comparer>::Position nsBTree<KeyType, ValueType, Comparer>::RemoveAt(Inner** pPath, const nsUInt32* pChildIndices, Leaf* pLeaf, nsUInt32 uiIndex)
+  {
+    nsMemoryUtils::Destruct(pLeaf->Keys() + uiIndex, 1);
+
+    if constexpr (HasValues)
+      nsMemoryUtils::Destruct(pLeaf->Values() + uiIndex, 1);
+
+    ShiftLeafElements(pLeaf, uiIndex + 1, uiIndex);
+    --pLeaf->m_uiCount;
+    --m_uiCount;
+
+    // the element after the removed one, it may move while the tree is rebalanced
+    Position next = {pLeaf, uiIndex};
+
+    if (m_uiHeight == 0)
+    {
+      if (pLeaf->m_uiCount == 0)
+      {
+        Clear();
+        return {};
+      }
+    }
+    else if (pLeaf->m_uiCount < MinLeafCount)
+    {
+      RebalanceLeaf(pPath[m_uiHeight - 1], pChildIndices[m_uiHeight - 1], pLeaf, next);
+
+      for (nsUInt32 uiLevel = m_uiHeight - 1; uiLevel > 0 && pPath[uiLevel]->m_uiCount < MinInnerCount; --uiLevel)
+      {
+        RebalanceInner(pPath[uiLevel - 1], pChildIndices[uiLevel - 1], pPath[uiLevel]);
+      }
+
+      Inner* pRoot = static_cast<Inner*>(m_pRoot);
+      if (pRoot->m_uiCount == 0)
+      {
+        // the root lost its last separator, its only child becomes the new root
+        m_pRoot = pRoot->m_pChildren[0];
+        FreeInner(pRoot);
+        --m_uiHeight;
+      }
+    }
+
+    if (next.m_uiIndex == next.m_pLeaf->m_uiCount)
+    {
+      next.m_pLeaf = next.m_pLeaf->m_pNext;
+      next.m_uiIndex = 0;
+    }
+
+    return next;
+  }
+
+  template <typename KeyType, typename ValueType, typename Comparer>
+  void nsBTree<KeyType, ValueType, Comparer>::RebalanceLeaf(Inner* pParent, nsUInt32 uiChild, Leaf* pLeaf, Position& ref_tracked)
+  {
+    Leaf* pLeft = uiChild > 0 ? static_cast<Leaf*>(pParent->m_pChildren[uiChild - 1]) : nullptr;
+    Leaf* pRight = uiChild < pParent->m_uiCount ? static_cast<Leaf*>(pParent->m_pChildren[uiChild + 1]) : nullptr;
+
+    if (pLeft != nullptr && pLeft->m_uiCount > MinLeafCount)
+    {
+      // take the last element of the left sibling
+      ShiftLeafElements(pLeaf, 0, 1);
+      RelocateLeafElements(pLeaf, 0, pLeft, pLeft->m_uiCount - 1, 1);
+      --pLeft->m_uiCount;
+      ++pLeaf->m_uiCount;
+
+      pParent->Keys()[uiChild - 1] = pLeaf->Keys()[0];
+      ++ref_tracked.m_uiIndex;
+    }
+    else if (pRight != nullptr && pRight->m_uiCount > MinLeafCount)
+    {
+      // take the first element of the right sibling
+      RelocateLeafElements(pLeaf, pLeaf->m_uiCount, pRight, 0, 1);
+      ShiftLeafElements(pRight, 1, 0);
+      --pRight->m_uiCount;
+      ++pLeaf->m_uiCount;
+
+      pParent->Keys()[uiChild] = pRight->Keys()[0];
+    }
+    else if (pLeft != nullptr)
+    {
+      // merge into the left sibling
+      ref_tracked.m_pLeaf = pLeft;
+      ref_tracked.m_uiIndex += pLeft->m_uiCount;
+
+      RelocateLeafElements(pLeft, pLeft->m_uiCount, pLeaf, 0, pLeaf->m_uiCount);
+      pLeft->m_uiCount += pLeaf->m_uiCount;
+
+      UnlinkLeaf(pLeaf);
+      FreeLeaf(pLeaf);
+
+      nsMemoryUtils::Destruct(pParent->Keys() + uiChild - 1, 1);
+      EraseInnerSlot(pParent, uiChild - 1);
+    }
+    else
+    {
+      NS_ASSERT_DEBUG(pRight != nullptr, "Inner nodes always have at least two children.");
+
+      // merge the right sibling into this leaf
+      RelocateLeafElements(pLeaf, pLeaf->m_uiCount, pRight, 0, pRight->m_uiCount);
+      pLeaf->m_uiCount += pRight->m_uiCount;
+
+      UnlinkLeaf(pRight);
+      FreeLeaf(pRight);
+
+      nsMemoryUtils::Destruct(pParent->Keys() + uiChild, 1);
+      EraseInnerSlot(pParent, uiChild);
+    }
+  }
+
+  template <typename KeyType, typename ValueType, typename Comparer>
+  void nsBTree<KeyType, ValueType, Comparer>::RebalanceInner(Inner* pParent, nsUInt32 uiChild, Inner* pNode)
+  {
+    Inner* pLeft = uiChild > 0 ? static_cast<Inner*>(pParent->m_pChildren[uiChild - 1]) : nullptr;
+    Inner* pRight = uiChild < pParent->m_uiCount ? static_cast<Inner*>(pParent->m_pChildren[uiChild + 1]) : nullptr;
+
+    if (pLeft != nullptr && pLeft->m_uiCount > MinInnerCount)
+    {
+      // the separator moves down to the front of this node and the last key of the left sibling replaces it
+      RelocateWithinNode(pNode->Keys() + 1, pNode->Keys(), pNode->m_uiCount);
+      nsMemoryUtils::CopyOverlapped(pNode->m_pChildren + 1, pNode->m_pChildren, pNode->m_uiCount + 1);
+
+      nsMemoryUtils::RelocateConstruct(pNode->Keys(), pParent->Keys() + uiChild - 1, 1);
+      nsMemoryUtils::RelocateConstruct(pParent->Keys() + uiChild - 1, pLeft->Keys() + pLeft->m_uiCount - 1, 1);
+      pNode->m_pChildren[0] = pLeft->m_pChildren[pLeft->m_uiCount];
+
+      --pLeft->m_uiCount;
+      ++pNode->m_uiCount;
+    }
+    else if (pRight != nullptr && pRight->m_uiCount > MinInnerCount)
+    {
+      // the separator moves down to the end of this node and the first key of the right sibling replaces it
+      nsMemoryUtils::RelocateConstruct(pNode->Keys() + pNode->m_uiCount, pParent->Keys() + uiChild, 1);
+      nsMemoryUtils::RelocateConstruct(pParent->Keys() + uiChild, pRight->Keys(), 1);
+      pNode->m_pChildren[pNode->m_uiCount + 1] = pRight->m_pChildren[0];
+
+      RelocateWithinNode(pRight->Keys(), pRight->Keys() + 1, pRight->m_uiCount - 1);
+      nsMemoryUtils::CopyOverlapped(pRight->m_pChildren, pRight->m_pChildren + 1, pRight->m_uiCount);
+
+      --pRight->m_uiCount;
+      ++pNode->m_uiCount;
+    }
+    else if (pLeft != nullptr)
+    {
+      // the separator and this node are appended to the left sibling
+      nsMemoryUtils::RelocateConstruct(pLeft->Keys() + pLeft->m_uiCount, pParent->Keys() + uiChild - 1, 1);
+      nsMemoryUtils::RelocateConstruct(pLeft->Keys() + pLeft->m_uiCount + 1, pNode->Keys(), pNode->m_uiCount);
+      nsMemoryUtils::Copy(pLeft->m_pChildren + pLeft->m_uiCount + 1, pNode->m_pChildren, pNode->m_uiCount + 1);
+      pLeft->m_uiCount += pNode->m_uiCount + 1;
+
+      FreeInner(pNode);
+      EraseInnerSlot(pParent, uiChild - 1);
+    }
+    else
+    {
+      NS_ASSERT_DEBUG(pRight != nullptr, "Inner nodes always have at least two children.");
+
+      // the separator and the right sibling are appended to this node
+      nsMemoryUtils::RelocateConstruct(pNode->Keys() + pNode->m_uiCount, pParent->Keys() + uiChild, 1);
+      nsMemoryUtils::RelocateConstruct(pNode->Keys() + pNode->m_uiCount + 1, pRight->Keys(), pRight->m_uiCount);
+      nsMemoryUtils::Copy(pNode->m_pChildren + pNode->m_uiCount + 1, pRight->m_pChildren, pRight->m_uiCount + 1);
+      pNode->m_uiCount += pRight->m_uiCount + 1;
+
+      FreeInner(pRight);
+      EraseInnerSlot(pParent, uiChild);
+    }
+  }
+
+  template <typename KeyType, typename ValueType, typename Comparer>
+  void nsBTree<KeyType, ValueType, Comparer>::EraseInnerSlot(Inner* pInner, nsUInt32 uiKeyIndex)
+  {
+    RelocateWithinNode(pInner->Keys() + uiKeyIndex, pInner->Keys() + uiKeyIndex + 1, pInner->m_uiCount - uiKeyIndex - 1);
+    nsMemoryUtils::CopyOverlapped(pInner->m_pChildren + uiKeyIndex + 1, pInner->m_pChildren + uiKeyIndex + 2, pInner->m_uiCount - uiKeyIndex - 1);
+    --pInner->m_uiCount;
+  }
+
+  template <typename KeyType, typename ValueType, typename Comparer>
+  template <typename T>
+  void nsBTree<KeyType, ValueType, Comparer>::RelocateWithinNode(T* pDestination, T* pSource, nsUInt32 uiCount)
+  {
+    if constexpr (nsGetTypeClass<T>::value != 0) // POD or mem-relocatable
+    {
+      memmove(static_cast<void*>(pDestination), pSource, uiCount * sizeof(T));
+    }
+    else if (pDestination < pSource)
+    {
+      for (nsUInt32 i = 0; i < uiCount; ++i)
+      {
+        nsMemoryUtils::RelocateConstruct(pDestination + i, pSource + i, 1);
+      }
+    }
+    else
+    {
+      for (nsUInt32 i = uiCount; i > 0; --i)
+      {
+        nsMemoryUtils::RelocateConstruct(pDestination + i - 1, pSource + i - 1, 1);
+      }
+    }
+  }
+
+  template <typename KeyType, typename ValueType, typename Comparer>
+  void nsBTree<KeyType, ValueType, Comparer>::RelocateLeafElements(Leaf* pDestination, nsUInt32 uiDestinationIndex, Leaf* pSource, nsUInt32 uiSourceIndex, nsUInt32 uiCount)
+  {
+    nsMemoryUtils::RelocateConstruct(pDestination->Keys() + uiDestinationIndex, pSource->Keys() + uiSourceIndex, uiCount);
+
+    if constexpr (HasValues)
+      nsMemoryUtils::RelocateConstruct(pDestination->Values() + uiDestinationIndex, pSource->Values() + uiSourceIndex, uiCount);
+  }
+
+  template <typename KeyType, typename ValueType, typename Comparer>
+  void nsBTree<KeyType, ValueType, Comparer>::ShiftLeafElements(Leaf* pLeaf, nsUInt32 uiIndex, nsUInt32 uiNewIndex)
+  {
+    // moves all elements starting at uiIndex, the count is not changed
+    const nsUInt32 uiCount = pLeaf->m_uiCount - uiIndex;
+
+    RelocateWithinNode(pLeaf->Keys() + uiNewIndex, pLeaf->Keys() + uiIndex, uiCount);
+
+    if constexpr (HasValues)
+      RelocateWithinNode(pLeaf->Values() + uiNewIndex, pLeaf->Values() + uiIndex, uiCount);
+  }
+
+  template <typename KeyType, typename ValueType, typename Comparer>
+  void nsBTree<KeyType, ValueType, Comparer>::Next(Position& ref_pos)
+  {
+    if (ref_pos.m_pLeaf == nullptr)
+    {
+      NS_ASSERT_DEBUG(ref_pos.m_pLeaf != nullptr, "The Iterator is invalid (end).");
+      return;
+    }
+
+    if (++ref_pos.m_uiIndex == ref_pos.m_pLeaf->m_uiCount)
+    {
+      ref_pos.m_pLeaf = ref_pos.m_pLeaf->m_pNext;
+      ref_pos.m_uiIndex = 0;
+    }
+  }
+
+  template <typename KeyType, typename ValueType, typename Comparer>
+  void nsBTree<KeyType, ValueType, Comparer>::Prev(Position& ref_pos)
+  {
+    if (ref_pos.m_pLeaf == nullptr)
+    {
+      NS_ASSERT_DEBUG(ref_pos.m_pLeaf != nullptr, "The Iterator is invalid (end).");
+      return;
+    }
+
+    if (ref_pos.m_uiIndex > 0)
+    {
+      --ref_pos.m_uiIndex;
+      return;
+    }
+
+    ref_pos.m_pLeaf = ref_pos.m_pLeaf->m_pPrev;
+    ref_pos.m_uiIndex = ref_pos.m_pLeaf != nullptr ? ref_pos.m_pLeaf->m_uiCount - 1 : 0;
+  }
+
+  template <typename KeyType, typename ValueType, typename Comparer>
+  typename nsBTree<KeyType, ValueType, Comparer>::Leaf* nsBTree<KeyType, ValueType, Comparer>::AllocateLeaf()
+  {
+    ++m_uiNumLeaves;
+    return NS_NEW(m_pAllocator, Leaf);
+  }
+
+  template <typename KeyType, typename ValueType, typename Comparer>
+  typename nsBTree<KeyType, ValueType, Comparer>::Inner* nsBTree<KeyType, ValueType, Comparer>::AllocateInner()
+  {
+    ++m_uiNumInnerNodes;
+    return NS_NEW(m_pAllocator, Inner);
+  }
+
+  template <typename KeyType, typename ValueType, typename Comparer>
+  void nsBTree<KeyType, ValueType, Comparer>::FreeLeaf(Leaf* pLeaf)
+  {
+    --m_uiNumLeaves;
+    NS_DELETE(m_pAllocator, pLeaf);
+  }
+
+  template <typename KeyType, typename ValueType, typename Comparer>
+  void nsBTree<KeyType, ValueType, Comparer>::FreeInner(Inner* pInner)
+  {
+    --m_uiNumInnerNodes;
+    NS_DELETE(m_pAllocator, pInner);
+  }
+
+  template <typename KeyType, typename ValueType, typename Comparer>
+  void nsBTree<KeyType, ValueType, Comparer>::DestroySubtree(void* pNode, nsUInt32 uiHeight)
+  {
+    if (uiHeight == 0)
+    {
+      Leaf* pLeaf = static_cast<Leaf*>(pNode);
+      nsMemoryUtils::Destruct(pLeaf->Keys(), pLeaf->m_uiCount);
+
+      if constexpr (HasValues)
+        nsMemoryUtils::Destruct(pLeaf->Values(), pLeaf->m_uiCount);
+
+      FreeLeaf(pLeaf);
+      return;
+    }
+
+    Inner* pInner = static_cast<Inner*>(pNode);
+
+    for (nsUInt32 i = 0; i <= pInner->m_uiCount; ++i)
+    {
+      DestroySubtree(pInner->m_pChildren[i], uiHeight - 1);
+    }
+
+    nsMemoryUtils::Destruct(pInner->Keys(), pInner->m_uiCount);
+    FreeInner(pInner);
+  }
+
+  template <typename KeyType, typename ValueType, typename Comparer>
+  void nsBTree<KeyType, ValueType, Comparer>::LinkLeafAfter(Leaf* pLeaf, Leaf* pNewLeaf)
+  {
+    pNewLeaf->m_pPrev = pLeaf;
+    pNewLeaf->m_pNext = pLeaf->m_pNext;
+
+    if (pLeaf->m_pNext != nullptr)
+      pLeaf->m_pNext->m_pPrev = pNewLeaf;
+    else
+      m_pLastLeaf = pNewLeaf;
+
+    pLeaf->m_pNext = pNewLeaf;
+  }
+
+  template <typename KeyType, typename ValueType, typename Comparer>
+  void nsBTree<KeyType, ValueType, Comparer>::UnlinkLeaf(Leaf* pLeaf)
+  {
+    if (pLeaf->m_pPrev != nullptr)
+      pLeaf->m_pPrev->m_pNext = pLeaf->m_pNext;
+    else
+      m_pFirstLeaf = pLeaf->m_pNext;
+
+    if (pLeaf->m_pNext != nullptr)
+      pLeaf->m_pNext->m_pPrev = pLeaf->m_pPrev;
+    else
+      m_pLastLeaf = pLeaf->m_pPrev;
+  }
+} // namespace nsInternal
@@ -670,7 +670,7 @@ void nsDequeBase<T, Construct>::RemoveAtAndSwap(nsUInt32 uiIndex)
   NS_ASSERT_DEV(uiIndex < m_uiCount, "Cannot remove element {0}, the deque only contains {1} elements.", uiIndex, m_uiCount);
 
   if (uiIndex + 1 < m_uiCount) // do not copy over the same element, if uiIndex is actually the last element
-    operator[](uiIndex) = PeekBack();
+    operator[](uiIndex) = std::move(PeekBack());
 
   PopBack();
 }
@@ -890,6 +890,52 @@ void nsDequeBase<T, Construct>::DeallocateAll()
   Constructor(m_pAllocator);
 }
 
+template <typename T, bool Construct>
+void nsDequeBase<T, Construct>::RawMoveElements(nsUInt32 uiDestinationIndex, nsUInt32 uiSourceIndex, nsUInt32 uiCount)
+{
+  const nsUInt32 uiChunkSize = CHUNK_SIZE(T);
+
+  if (uiDestinationIndex < uiSourceIndex)
+  {
+    // front to back, so that no piece overwrites source elements that have not been moved yet
+    while (uiCount > 0)
+    {
+      const nsUInt32 uiRealSource = m_uiFirstElement + uiSourceIndex;
+      const nsUInt32 uiRealDestination = m_uiFirstElement + uiDestinationIndex;
+
+      nsUInt32 uiPiece = nsMath::Min(uiChunkSize - (uiRealSource % uiChunkSize), uiChunkSize - (uiRealDestination % uiChunkSize));
+      uiPiece = nsMath::Min(uiPiece, uiCount);
+
+      memmove(static_cast<void*>(&m_pChunks[uiRealDestination / uiChunkSize][uiRealDestination % uiChunkSize]),
+        static_cast<const void*>(&m_pChunks[uiRealSource / uiChunkSize][uiRealSource % uiChunkSize]), uiPiece * sizeof(T));
+
+      uiSourceIndex += uiPiece;
+      uiDestinationIndex += uiPiece;
+      uiCount -= uiPiece;
+    }
+  }
+  else if (uiDestinationIndex > uiSourceIndex)
+  {
+    // back to front
+    while (uiCount > 0)
+    {
+      const nsUInt32 uiRealSourceLast = m_uiFirstElement + uiSourceIndex + uiCount - 1;
+      const nsUInt32 uiRealDestinationLast = m_uiFirstElement + uiDestinationIndex + uiCount - 1;
+
+      nsUInt32 uiPiece = nsMath::Min((uiRealSourceLast % uiChunkSize) + 1, (uiRealDestinationLast % uiChunkSize) + 1);
+      uiPiece = nsMath::Min(uiPiece, uiCount);
+
+      const nsUInt32 uiRealSource = uiRealSourceLast + 1 - uiPiece;
+      const nsUInt32 uiRealDestination = uiRealDestinationLast + 1 - uiPiece;
+
+      memmove(static_cast<void*>(&m_pChunks[uiRealDestination / uiChunkSize][uiRealDestination % uiChunkSize]),
+        static_cast<const void*>(&m_pChunks[uiRealSource / uiChunkSize][uiRealSource % uiChunkSize]), uiPiece * sizeof(T));
+
+      uiCount -= uiPiece;
+    }
+  }
+}
+
 template <typename T, bool Construct>
 void nsDequeBase<T, Construct>::RemoveAtAndCopy(nsUInt32 uiIndex)
 {
@@ -897,12 +943,48 @@ void nsDequeBase<T, Construct>::RemoveAtAndCopy(nsUInt32 uiIndex)
 
   NS_ASSERT_DEV(uiIndex < m_uiCount, "Out of bounds access. Array has {0} elements, trying to remove element at index {1}.", m_uiCount, uiIndex);
 
-  for (nsUInt32 i = uiIndex + 1; i < m_uiCount; ++i)
+  const bool bShiftFront = uiIndex < m_uiCount / 2;
+
+  if constexpr (nsGetTypeClass<T>::value != 0) // POD or mem-relocatable
   {
-    nsMemoryUtils::CopyOverlapped(&operator[](i - 1), &operator[](i), 1);
+    nsMemoryUtils::Destruct(&operator[](uiIndex), 1);
+
+    if (bShiftFront)
+    {
+      RawMoveElements(1, 0, uiIndex);
+      ++m_uiFirstElement;
+    }
+    else
+    {
+      RawMoveElements(uiIndex, uiIndex + 1, m_uiCount - uiIndex - 1);
+    }
+
+    --m_uiCount;
+
+    // might trigger a memory reduction
+    REDUCE_SIZE(1);
   }
+  else
+  {
+    if (bShiftFront)
+    {
+      for (nsUInt32 i = uiIndex; i > 0; --i)
+      {
+        operator[](i) = std::move(operator[](i - 1));
+      }
 
-  PopBack();
+      PopFront();
+    }
+    else
+    {
+      for (nsUInt32 i = uiIndex + 1; i < m_uiCount; ++i)
+      {
+        operator[](i - 1) = std::move(operator[](i));
+      }
+
+      PopBack();
+    }
+  }
 }
 
 template <typename T, bool Construct>
@@ -935,20 +1017,71 @@ bool nsDequeBase<T, Construct>::RemoveAndSwap(const T& value)
 
 template <typename T, bool Construct>
 void nsDequeBase<T, Construct>::InsertAt(nsUInt32 uiIndex, const T& value)
+{
+  InsertAtImpl(uiIndex, value);
+}
+
+template <typename T, bool Construct>
+void nsDequeBase<T, Construct>::InsertAt(nsUInt32 uiIndex, T&& value)
+{
+  InsertAtImpl(uiIndex, std::move(value));
+}
+
+template <typename T, bool Construct>
+template <typename U>
+void nsDequeBase<T, Construct>::InsertAtImpl(nsUInt32 uiIndex, U&& value)
 {
   static_assert(Construct, "This function is not supported on Deques that do not construct their data.");
 
   // Index 0 inserts before the first element, Index m_uiCount inserts after the last element.
   NS_ASSERT_DEV(uiIndex <= m_uiCount, "The deque has {0} elements. Cannot insert an element at index {1}.", m_uiCount, uiIndex);
 
-  PushBack();
+  const bool bShiftFront = uiIndex < m_uiCount / 2;
 
-  for (nsUInt32 i = m_uiCount - 1; i > uiIndex; --i)
+  if constexpr (nsGetTypeClass<T>::value != 0) // POD or mem-relocatable
   {
-    nsMemoryUtils::Copy(&operator[](i), &operator[](i - 1), 1);
+    RESERVE(m_uiCount + 1);
+    ++m_uiCount;
+
+    if (bShiftFront)
+    {
+      --m_uiFirstElement;
+      ElementAt(0);
+
+      RawMoveElements(0, 1, uiIndex);
+    }
+    else
+    {
+      ElementAt(m_uiCount - 1);
+
+      RawMoveElements(uiIndex + 1, uiIndex, m_uiCount - 1 - uiIndex);
+    }
+
+    nsMemoryUtils::CopyOrMoveConstruct<T>(&operator[](uiIndex), std::forward<U>(value));
   }
+  else
+  {
+    if (bShiftFront)
+    {
+      PushFront();
 
-  nsMemoryUtils::Copy(&operator[](uiIndex), &value, 1);
+      for (nsUInt32 i = 0; i < uiIndex; ++i)
+      {
+        operator[](i) = std::move(operator[](i + 1));
+      }
+    }
+    else
+    {
+      PushBack();
+
+      for (nsUInt32 i = m_uiCount - 1; i > uiIndex; --i)
+      {
+        operator[](i) = std::move(operator[](i - 1));
+      }
+    }
+
+    operator[](uiIndex) = std::forward<U>(value);
+  }
 }
 
 template <typename T, bool Construct>
@@ -0,0 +1,127 @@
+#pragma once
+
+template <typename T, typename A>
+nsMpmcQueue<T, A>::nsMpmcQueue(nsUInt32 uiCapacity, nsAllocator* pAllocator)
+  : m_pAllocator(pAllocator)
+{
+  NS_ASSERT_DEV(uiCapacity > 0 && uiCapacity <= 0x40000000, "Invalid capacity {0}", uiCapacity);
+
+  // with a single cell, the sequence numbers of 'written' and 'free in the next round' would be the same
+  const nsUInt32 uiSize = nsMath::PowerOfTwo_Ceil(nsMath::Max(uiCapacity, 2u));
+  m_uiMask = uiSize - 1;
+  m_Cells = NS_NEW_ARRAY(m_pAllocator, Cell, uiSize);
+
+  for (nsUInt32 i = 0; i < uiSize; ++i)
+  {
+    m_Cells[i].m_iSequence = i;
+  }
+}
+
+template <typename T, typename A>
+nsMpmcQueue<T, A>::~nsMpmcQueue()
+{
+  for (nsInt64 iPos = m_iPopPos; iPos != m_iPushPos; ++iPos)
+  {
+    nsMemoryUtils::Destruct(m_Cells[static_cast<nsUInt32>(iPos) & m_uiMask].GetElement(), 1);
+  }
+
+  NS_DELETE_ARRAY(m_pAllocator, m_Cells);
+}
+
+template <typename T, typename A>
+NS_ALWAYS_INLINE bool nsMpmcQueue<T, A>::TryPush(const T& element)
+{
+  return Push(element);
+}
+
+template <typename T, typename A>
+NS_ALWAYS_INLINE bool nsMpmcQueue<T, A>::TryPush(T&& element)
+{
+  return Push(std::move(element));
+}
+
+template <typename T, typename A>
+template <typename U>
+bool nsMpmcQueue<T, A>::Push(U&& element)
+{
+  nsInt64 iPos = m_iPushPos;
+  Cell* pCell;
+
+  while (true)
+  {
+    pCell = &m_Cells[static_cast<nsUInt32>(iPos) & m_uiMask];
+    const nsInt64 iDiff = pCell->m_iSequence - iPos;
+
+    if (iDiff == 0)
+    {
+      // the cell is free in this round, try to claim the position
+      const nsInt64 iPrevPos = m_iPushPos.CompareAndSwap(iPos, iPos + 1);
+      if (iPrevPos == iPos)
+        break;
+
+      iPos = iPrevPos;
+    }
+    else if (iDiff < 0)
+    {
+      // the cell still holds the element of the previous round, the queue is full
+      return false;
+    }
+    else
+    {
+      // another producer was faster
+      iPos = m_iPushPos;
+    }
+  }
+
+  nsMemoryUtils::CopyOrMoveConstruct(pCell->GetElement(), std::forward<U>(element));
+  pCell->m_iSequence = iPos + 1;
+  return true;
+}
+
+template <typename T, typename A>
+bool nsMpmcQueue<T, A>::TryPop(T& out_element)
+{
+  nsInt64 iPos = m_iPopPos;
+  Cell* pCell;
+
+  while (true)
+  {
+    pCell = &m_Cells[static_cast<nsUInt32>(iPos) & m_uiMask];
+    const nsInt64 iDiff = pCell->m_iSequence - (iPos + 1);
+
+    if (iDiff == 0)
+    {
+      const nsInt64 iPrevPos = m_iPopPos.CompareAndSwap(iPos, iPos + 1);
+      if (iPrevPos == iPos)
+        break;
+
+      iPos = iPrevPos;
+    }
+    else if (iDiff < 0)
+    {
+      // the element for this position hasn't been written yet, the queue is empty
+      return false;
+    }
+    else
+    {
+      // another consumer was faster
+      iPos = m_iPopPos;
+    }
+  }
+
+  T* pElement = pCell->GetElement();
+  out_element = std::move(*pElement);
+  nsMemoryUtils::Destruct(pElement, 1);
+
+  // makes the cell available for the next round
+  pCell->m_iSequence = iPos + m_uiMask + 1;
+  return true;
+}
+
+template <typename T, typename A>
+nsUInt32 nsMpmcQueue<T, A>::GetCount() const
+{
+  const nsInt64 iPopPos = m_iPopPos;
+  const nsInt64 iPushPos = m_iPushPos;
+  return iPushPos > iPopPos ? static_cast<nsUInt32>(iPushPos - iPopPos) : 0;
+}
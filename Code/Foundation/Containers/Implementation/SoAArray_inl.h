@@ -0,0 +1,310 @@
+#pragma once
+
+template <typename... Types>
+nsSoAArray<Types...>::nsSoAArray()
+  : m_pAllocator(nsAlignedAllocatorWrapper::GetAllocator())
+{
+}
+
+template <typename... Types>
+nsSoAArray<Types...>::nsSoAArray(nsAllocator* pAllocator)
+  : m_pAllocator(pAllocator)
+{
+}
+
+template <typename... Types>
+nsSoAArray<Types...>::nsSoAArray(const nsSoAArray<Types...>& other)
+  : m_pAllocator(other.m_pAllocator)
+{
+  *this = other;
+}
+
+template <typename... Types>
+nsSoAArray<Types...>::nsSoAArray(nsSoAArray<Types...>&& other)
+  : m_pAllocator(other.m_pAllocator)
+{
+  Swap(other);
+}
+
+template <typename... Types>
+nsSoAArray<Types...>::~nsSoAArray()
+{
+  Clear();
+
+  if (m_pData != nullptr)
+  {
+    m_pAllocator->Deallocate(m_pData);
+  }
+}
+
+template <typename... Types>
+void nsSoAArray<Types...>::operator=(const nsSoAArray<Types...>& rhs)
+{
+  if (this == &rhs)
+    return;
+
+  Clear();
+  Reserve(rhs.m_uiCount);
+
+  ForEachColumn([&](auto column)
+    {
+      constexpr nsUInt32 Column = decltype(column)::value;
+      nsMemoryUtils::CopyConstructArray(GetColumnPtr<Column>(), rhs.template GetColumnPtr<Column>(), rhs.m_uiCount); });
+
+  m_uiCount = rhs.m_uiCount;
+}
+
+template <typename... Types>
+void nsSoAArray<Types...>::operator=(nsSoAArray<Types...>&& rhs)
+{
+  if (this == &rhs)
+    return;
+
+  if (m_pAllocator != rhs.m_pAllocator)
+  {
+    // the memory of rhs can't be taken over
+    *this = static_cast<const nsSoAArray<Types...>&>(rhs);
+    rhs.Clear();
+    return;
+  }
+
+  Clear();
+  Swap(rhs);
+}
+
+template <typename... Types>
+void nsSoAArray<Types...>::Clear()
+{
+  ForEachColumn([&](auto column)
+    {
+      constexpr nsUInt32 Column = decltype(column)::value;
+      nsMemoryUtils::Destruct(GetColumnPtr<Column>(), m_uiCount); });
+
+  m_uiCount = 0;
+}
+
+template <typename... Types>
+void nsSoAArray<Types...>::Reserve(nsUInt32 uiCapacity)
+{
+  if (m_uiCapacity >= uiCapacity)
+    return;
+
+  const nsUInt64 uiCurCap64 = static_cast<nsUInt64>(m_uiCapacity);
+  nsUInt64 uiNewCapacity64 = uiCurCap64 + (uiCurCap64 / 2);
+
+  uiNewCapacity64 = nsMath::Max<nsUInt64>(uiNewCapacity64, uiCapacity);
+
+  constexpr nsUInt64 uiMaxCapacity = 0xFFFFFFFFllu - (CAPACITY_ALIGNMENT - 1);
+
+  uiNewCapacity64 = nsMath::Min<nsUInt64>(uiNewCapacity64, uiMaxCapacity);
+  uiNewCapacity64 = (uiNewCapacity64 + (CAPACITY_ALIGNMENT - 1)) & ~static_cast<nsUInt64>(CAPACITY_ALIGNMENT - 1);
+
+  NS_ASSERT_DEV(uiCapacity <= uiNewCapacity64, "The requested capacity of {0} elements exceeds the maximum possible capacity of {1} elements.", uiCapacity, uiMaxCapacity);
+
+  SetCapacity(static_cast<nsUInt32>(uiNewCapacity64 & 0xFFFFFFFF));
+}
+
+template <typename... Types>
+void nsSoAArray<Types...>::Compact()
+{
+  if (IsEmpty())
+  {
+    if (m_pData != nullptr)
+    {
+      m_pAllocator->Deallocate(m_pData);
+      m_pData = nullptr;
+    }
+
+    nsMemoryUtils::ZeroFillArray(m_pColumns);
+    m_uiCapacity = 0;
+  }
+  else
+  {
+    const nsUInt32 uiNewCapacity = (m_uiCount + (CAPACITY_ALIGNMENT - 1)) & ~(CAPACITY_ALIGNMENT - 1);
+    if (m_uiCapacity != uiNewCapacity)
+      SetCapacity(uiNewCapacity);
+  }
+}
+
+template <typename... Types>
+void nsSoAArray<Types...>::SetCount(nsUInt32 uiCount)
+{
+  if (uiCount > m_uiCount)
+  {
+    Reserve(uiCount);
+
+    ForEachColumn([&](auto column)
+      {
+        constexpr nsUInt32 Column = decltype(column)::value;
+        nsMemoryUtils::Construct<ConstructAll>(GetColumnPtr<Column>() + m_uiCount, uiCount - m_uiCount); });
+  }
+  else
+  {
+    ForEachColumn([&](auto column)
+      {
+        constexpr nsUInt32 Column = decltype(column)::value;
+        nsMemoryUtils::Destruct(GetColumnPtr<Column>() + uiCount, m_uiCount - uiCount); });
+  }
+
+  m_uiCount = uiCount;
+}
+
+template <typename... Types>
+nsUInt32 nsSoAArray<Types...>::PushBack(const Types&... values)
+{
+  Reserve(m_uiCount + 1);
+  PushBackCopy(std::index_sequence_for<Types...>(), values...);
+  return m_uiCount++;
+}
+
+template <typename... Types>
+nsUInt32 nsSoAArray<Types...>::PushBack(Types&&... values)
+{
+  Reserve(m_uiCount + 1);
+  PushBackMove(std::index_sequence_for<Types...>(), std::move(values)...);
+  return m_uiCount++;
+}
+
+template <typename... Types>
+nsUInt32 nsSoAArray<Types...>::ExpandAndGetIndex()
+{
+  SetCount(m_uiCount + 1);
+  return m_uiCount - 1;
+}
+
+template <typename... Types>
+void nsSoAArray<Types...>::PopBack()
+{
+  NS_ASSERT_DEBUG(m_uiCount > 0, "Cannot remove elements from an empty array.");
+
+  SetCount(m_uiCount - 1);
+}
+
+template <typename... Types>
+void nsSoAArray<Types...>::RemoveAtAndSwap(nsUInt32 uiIndex)
+{
+  NS_ASSERT_DEV(uiIndex < m_uiCount, "Out of bounds access. Array has {0} elements, trying to remove element at index {1}.", m_uiCount, uiIndex);
+
+  const nsUInt32 uiLast = m_uiCount - 1;
+
+  ForEachColumn([&](auto column)
+    {
+      constexpr nsUInt32 Column = decltype(column)::value;
+      auto* pValues = GetColumnPtr<Column>();
+
+      if (uiIndex != uiLast)
+      {
+        pValues[uiIndex] = std::move(pValues[uiLast]);
+      }
+
+      nsMemoryUtils::Destruct(pValues + uiLast, 1); });
+
+  --m_uiCount;
+}
+
+template <typename... Types>
+void nsSoAArray<Types...>::RemoveAtAndCopy(nsUInt32 uiIndex)
+{
+  NS_ASSERT_DEV(uiIndex < m_uiCount, "Out of bounds access. Array has {0} elements, trying to remove element at index {1}.", m_uiCount, uiIndex);
+
+  ForEachColumn([&](auto column)
+    {
+      constexpr nsUInt32 Column = decltype(column)::value;
+      auto* pValues = GetColumnPtr<Column>();
+
+      nsMemoryUtils::RelocateOverlapped(pValues + uiIndex, pValues + uiIndex + 1, m_uiCount - uiIndex - 1); });
+
+  --m_uiCount;
+}
+
+template <typename... Types>
+void nsSoAArray<Types...>::Swap(nsSoAArray<Types...>& other)
+{
+  nsMath::Swap(m_pAllocator, other.m_pAllocator);
+  nsMath::Swap(m_pData, other.m_pData);
+  nsMath::Swap(m_uiCount, other.m_uiCount);
+  nsMath::Swap(m_uiCapacity, other.m_uiCapacity);
+
+  for (nsUInt32 i = 0; i < NumColumns; ++i)
+  {
+    nsMath::Swap(m_pColumns[i], other.m_pColumns[i]);
+  }
+}
+
+template <typename... Types>
+template <typename Func>
+NS_ALWAYS_INLINE void nsSoAArray<Types...>::ForEachColumn(Func&& func)
+{
+  ForEachColumn(func, std::index_sequence_for<Types...>());
+}
+
+template <typename... Types>
+template <typename Func, size_t... Indices>
+NS_ALWAYS_INLINE void nsSoAArray<Types...>::ForEachColumn(Func& func, std::index_sequence<Indices...>)
+{
+  (func(std::integral_constant<nsUInt32, static_cast<nsUInt32>(Indices)>()), ...);
+}
+
+template <typename... Types>
+size_t nsSoAArray<Types...>::ComputeLayout(nsUInt32 uiCapacity, size_t* out_pOffsets)
+{
+  size_t uiSize = 0;
+
+  ForEachColumn([&](auto column)
+    {
+      constexpr nsUInt32 Column = decltype(column)::value;
+
+      uiSize = nsMemoryUtils::AlignSize(uiSize, GetColumnAlignment<Column>());
+
+      if (out_pOffsets != nullptr)
+      {
+        out_pOffsets[Column] = uiSize;
+      }
+
+      uiSize += sizeof(ColumnType<Column>) * uiCapacity; });
+
+  return uiSize;
+}
+
+template <typename... Types>
+void nsSoAArray<Types...>::SetCapacity(nsUInt32 uiCapacity)
+{
+  size_t offsets[NumColumns];
+  const size_t uiSize = ComputeLayout(uiCapacity, offsets);
+
+  size_t uiAlignment = COLUMN_ALIGNMENT;
+  ForEachColumn([&](auto column)
+    { uiAlignment = nsMath::Max(uiAlignment, GetColumnAlignment<decltype(column)::value>()); });
+
+  void* pNewData = m_pAllocator->Allocate(uiSize, uiAlignment);
+
+  ForEachColumn([&](auto column)
+    {
+      constexpr nsUInt32 Column = decltype(column)::value;
+      auto* pNewValues = static_cast<ColumnType<Column>*>(nsMemoryUtils::AddByteOffset(pNewData, static_cast<std::ptrdiff_t>(offsets[Column])));
+
+      nsMemoryUtils::RelocateConstruct(pNewValues, GetColumnPtr<Column>(), m_uiCount);
+      m_pColumns[Column] = pNewValues; });
+
+  if (m_pData != nullptr)
+  {
+    m_pAllocator->Deallocate(m_pData);
+  }
+
+  m_pData = pNewData;
+  m_uiCapacity = uiCapacity;
+}
+
+template <typename... Types>
+template <size_t... Indices>
+NS_ALWAYS_INLINE void nsSoAArray<Types...>::PushBackCopy(std::index_sequence<Indices...>, const Types&... values)
+{
+  (nsMemoryUtils::CopyConstruct(GetColumnPtr<Indices>() + m_uiCount, values, 1), ...);
+}
+
+template <typename... Types>
+template <size_t... Indices>
+NS_ALWAYS_INLINE void nsSoAArray<Types...>::PushBackMove(std::index_sequence<Indices...>, Types&&... values)
+{
+  (nsMemoryUtils::MoveConstruct(GetColumnPtr<Indices>() + m_uiCount, std::move(values)), ...);
+}
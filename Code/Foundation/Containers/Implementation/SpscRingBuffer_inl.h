@@ -0,0 +1,97 @@
+#pragma once
+
+template <typename T, typename A>
+nsSpscRingBuffer<T, A>::nsSpscRingBuffer(nsUInt32 uiCapacity, nsAllocator* pAllocator)
+  : m_pAllocator(pAllocator)
+{
+  NS_ASSERT_DEV(uiCapacity > 0 && uiCapacity <= 0x40000000, "Invalid capacity {0}", uiCapacity);
+
+  const nsUInt32 uiSize = nsMath::PowerOfTwo_Ceil(uiCapacity);
+  m_uiMask = uiSize - 1;
+  m_pElements = NS_NEW_RAW_BUFFER(m_pAllocator, T, uiSize);
+}
+
+template <typename T, typename A>
+nsSpscRingBuffer<T, A>::~nsSpscRingBuffer()
+{
+  for (nsUInt32 uiPos = static_cast<nsUInt32>(m_iReadPos); uiPos != static_cast<nsUInt32>(m_iWritePos); ++uiPos)
+  {
+    nsMemoryUtils::Destruct(&m_pElements[uiPos & m_uiMask], 1);
+  }
+
+  NS_DELETE_RAW_BUFFER(m_pAllocator, m_pElements);
+}
+
+template <typename T, typename A>
+NS_ALWAYS_INLINE bool nsSpscRingBuffer<T, A>::TryPush(const T& element)
+{
+  return Push(element);
+}
+
+template <typename T, typename A>
+NS_ALWAYS_INLINE bool nsSpscRingBuffer<T, A>::TryPush(T&& element)
+{
+  return Push(std::move(element));
+}
+
+template <typename T, typename A>
+template <typename U>
+bool nsSpscRingBuffer<T, A>::Push(U&& element)
+{
+  // only the producer writes the write position, so it can be read without synchronization
+  const nsUInt32 uiWritePos = static_cast<nsUInt32>(m_iWritePos);
+
+  if (uiWritePos - m_uiCachedReadPos > m_uiMask)
+  {
+    // looks full, find out how far the consumer actually is
+    m_uiCachedReadPos = static_cast<nsUInt32>(m_iReadPos);
+
+    if (uiWritePos - m_uiCachedReadPos > m_uiMask)
+      return false;
+  }
+
+  nsMemoryUtils::CopyOrMoveConstruct(&m_pElements[uiWritePos & m_uiMask], std::forward<U>(element));
+
+  // publishes the element to the consumer
+  m_iWritePos = static_cast<nsInt32>(uiWritePos + 1);
+  return true;
+}
+
+template <typename T, typename A>
+bool nsSpscRingBuffer<T, A>::TryPop(T& out_element)
+{
+  T* pElement = TryPeek();
+
+  if (pElement == nullptr)
+    return false;
+
+  out_element = std::move(*pElement);
+  nsMemoryUtils::Destruct(pElement, 1);
+
+  // hands the slot back to the producer
+  m_iReadPos.Increment();
+  return true;
+}
+
+template <typename T, typename A>
+T* nsSpscRingBuffer<T, A>::TryPeek()
+{
+  const nsUInt32 uiReadPos = static_cast<nsUInt32>(m_iReadPos);
+
+  if (uiReadPos == m_uiCachedWritePos)
+  {
+    // looks empty, find out whether the producer has added something in the meantime
+    m_uiCachedWritePos = static_cast<nsUInt32>(m_iWritePos);
+
+    if (uiReadPos == m_uiCachedWritePos)
+      return nullptr;
+  }
+
+  return &m_pElements[uiReadPos & m_uiMask];
+}
+
+template <typename T, typename A>
+nsUInt32 nsSpscRingBuffer<T, A>::GetCount() const
+{
+  return static_cast<nsUInt32>(m_iWritePos) - static_cast<nsUInt32>(m_iReadPos);
+}
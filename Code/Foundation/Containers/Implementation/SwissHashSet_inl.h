@@ -0,0 +1,555 @@
+/// \brief Value used by containers for indices to indicate an invalid index.
+#ifndef nsInvalidIndex
+#  define nsInvalidIndex 0xFFFFFFFF
+#endif
+
+// ***** Const Iterator *****
+
+template <typename K, typename H>
+nsSwissHashSetBase<K, H>::ConstIterator::ConstIterator(const nsSwissHashSetBase<K, H>& hashSet)
+  : m_pHashSet(&hashSet)
+{
+}
+
+template <typename K, typename H>
+void nsSwissHashSetBase<K, H>::ConstIterator::SetToBegin()
+{
+  if (m_pHashSet->IsEmpty())
+  {
+    m_uiCurrentIndex = m_pHashSet->m_uiCapacity;
+    return;
+  }
+
+  m_uiCurrentIndex = Control::FindNextFull(m_pHashSet->m_pControl, m_pHashSet->m_uiCapacity, 0);
+}
+
+template <typename K, typename H>
+inline void nsSwissHashSetBase<K, H>::ConstIterator::SetToEnd()
+{
+  m_uiCurrentIndex = m_pHashSet->m_uiCapacity;
+}
+
+template <typename K, typename H>
+NS_ALWAYS_INLINE bool nsSwissHashSetBase<K, H>::ConstIterator::IsValid() const
+{
+  return m_uiCurrentIndex < m_pHashSet->m_uiCapacity;
+}
+
+template <typename K, typename H>
+NS_ALWAYS_INLINE bool nsSwissHashSetBase<K, H>::ConstIterator::operator==(const typename nsSwissHashSetBase<K, H>::ConstIterator& rhs) const
+{
+  return m_uiCurrentIndex == rhs.m_uiCurrentIndex && m_pHashSet->m_pEntries == rhs.m_pHashSet->m_pEntries;
+}
+
+template <typename K, typename H>
+NS_FORCE_INLINE const K& nsSwissHashSetBase<K, H>::ConstIterator::Key() const
+{
+  return m_pHashSet->m_pEntries[m_uiCurrentIndex];
+}
+
+template <typename K, typename H>
+void nsSwissHashSetBase<K, H>::ConstIterator::Next()
+{
+  if (m_uiCurrentIndex >= m_pHashSet->m_uiCapacity)
+    return;
+
+  m_uiCurrentIndex = Control::FindNextFull(m_pHashSet->m_pControl, m_pHashSet->m_uiCapacity, m_uiCurrentIndex + 1);
+}
+
+template <typename K, typename H>
+NS_ALWAYS_INLINE void nsSwissHashSetBase<K, H>::ConstIterator::operator++()
+{
+  Next();
+}
+
+// ***** nsSwissHashSetBase *****
+
+template <typename K, typename H>
+nsSwissHashSetBase<K, H>::nsSwissHashSetBase(nsAllocator* pAllocator)
+{
+  m_pAllocator = pAllocator;
+}
+
+template <typename K, typename H>
+nsSwissHashSetBase<K, H>::nsSwissHashSetBase(const nsSwissHashSetBase<K, H>& other, nsAllocator* pAllocator)
+{
+  m_pAllocator = pAllocator;
+
+  *this = other;
+}
+
+template <typename K, typename H>
+nsSwissHashSetBase<K, H>::nsSwissHashSetBase(nsSwissHashSetBase<K, H>&& other, nsAllocator* pAllocator)
+{
+  m_pAllocator = pAllocator;
+
+  *this = std::move(other);
+}
+
+template <typename K, typename H>
+nsSwissHashSetBase<K, H>::~nsSwissHashSetBase()
+{
+  Clear();
+  DeallocateStorage();
+}
+
+template <typename K, typename H>
+void nsSwissHashSetBase<K, H>::operator=(const nsSwissHashSetBase<K, H>& rhs)
+{
+  Clear();
+  Reserve(rhs.GetCount());
+
+  for (nsUInt32 i = Control::FindNextFull(rhs.m_pControl, rhs.m_uiCapacity, 0); i < rhs.m_uiCapacity; i = Control::FindNextFull(rhs.m_pControl, rhs.m_uiCapacity, i + 1))
+  {
+    Insert(rhs.m_pEntries[i]);
+  }
+}
+
+template <typename K, typename H>
+void nsSwissHashSetBase<K, H>::operator=(nsSwissHashSetBase<K, H>&& rhs)
+{
+  // Clear any existing data (calls destructors if necessary)
+  Clear();
+
+  if (m_pAllocator != rhs.m_pAllocator)
+  {
+    Reserve(rhs.GetCount());
+
+    for (nsUInt32 i = Control::FindNextFull(rhs.m_pControl, rhs.m_uiCapacity, 0); i < rhs.m_uiCapacity; i = Control::FindNextFull(rhs.m_pControl, rhs.m_uiCapacity, i + 1))
+    {
+      Insert(std::move(rhs.m_pEntries[i]));
+    }
+
+    rhs.Clear();
+  }
+  else
+  {
+    DeallocateStorage();
+
+    // Move all data over.
+    m_pEntries = rhs.m_pEntries;
+    m_pControl = rhs.m_pControl;
+    m_uiCount = rhs.m_uiCount;
+    m_uiCapacity = rhs.m_uiCapacity;
+    m_uiGrowthLeft = rhs.m_uiGrowthLeft;
+
+    // Temp copy forgets all its state.
+    rhs.m_pEntries = nullptr;
+    rhs.m_pControl = nullptr;
+    rhs.m_uiCount = 0;
+    rhs.m_uiCapacity = 0;
+    rhs.m_uiGrowthLeft = 0;
+  }
+}
+
+template <typename K, typename H>
+bool nsSwissHashSetBase<K, H>::operator==(const nsSwissHashSetBase<K, H>& rhs) const
+{
+  if (m_uiCount != rhs.m_uiCount)
+    return false;
+
+  for (nsUInt32 i = Control::FindNextFull(m_pControl, m_uiCapacity, 0); i < m_uiCapacity; i = Control::FindNextFull(m_pControl, m_uiCapacity, i + 1))
+  {
+    if (!rhs.Contains(m_pEntries[i]))
+      return false;
+  }
+
+  return true;
+}
+
+template <typename K, typename H>
+void nsSwissHashSetBase<K, H>::Reserve(nsUInt32 uiCapacity)
+{
+  if (uiCapacity <= m_uiCount + m_uiGrowthLeft)
+    return;
+
+  SetCapacity(nsMath::Max(Control::GetCapacityForCount(uiCapacity), m_uiCapacity));
+}
+
+template <typename K, typename H>
+void nsSwissHashSetBase<K, H>::Compact()
+{
+  if (IsEmpty())
+  {
+    // completely deallocate all data, if the table is empty.
+    DeallocateStorage();
+  }
+  else
+  {
+    const nsUInt32 uiNewCapacity = Control::GetCapacityForCount(m_uiCount);
+    if (m_uiCapacity != uiNewCapacity)
+      SetCapacity(uiNewCapacity);
+  }
+}
+
+template <typename K, typename H>
+NS_ALWAYS_INLINE nsUInt32 nsSwissHashSetBase<K, H>::GetCount() const
+{
+  return m_uiCount;
+}
+
+template <typename K, typename H>
+NS_ALWAYS_INLINE bool nsSwissHashSetBase<K, H>::IsEmpty() const
+{
+  return m_uiCount == 0;
+}
+
+template <typename K, typename H>
+void nsSwissHashSetBase<K, H>::Clear()
+{
+  if (m_uiCapacity == 0)
+    return;
+
+  if constexpr (!std::is_trivially_destructible<K>::value)
+  {
+    for (nsUInt32 i = Control::FindNextFull(m_pControl, m_uiCapacity, 0); i < m_uiCapacity; i = Control::FindNextFull(m_pControl, m_uiCapacity, i + 1))
+    {
+      nsMemoryUtils::Destruct(&m_pEntries[i], 1);
+    }
+  }
+
+  Control::ResetControl(m_pControl, m_uiCapacity);
+  m_uiCount = 0;
+  m_uiGrowthLeft = Control::GetMaxLoad(m_uiCapacity);
+}
+
+template <typename K, typename H>
+template <typename CompatibleKeyType>
+bool nsSwissHashSetBase<K, H>::Insert(CompatibleKeyType&& key)
+{
+  const nsUInt32 uiMixedHash = Control::MixHash(H::Hash(key));
+
+  if (FindEntry(uiMixedHash, key) != nsInvalidIndex)
+    return true;
+
+  const nsUInt32 uiIndex = PrepareInsert(uiMixedHash);
+  nsMemoryUtils::CopyOrMoveConstruct(&m_pEntries[uiIndex], std::forward<CompatibleKeyType>(key));
+
+  return false;
+}
+
+template <typename K, typename H>
+template <typename CompatibleKeyType>
+bool nsSwissHashSetBase<K, H>::Remove(const CompatibleKeyType& key)
+{
+  nsUInt32 uiIndex = FindEntry(key);
+  if (uiIndex != nsInvalidIndex)
+  {
+    RemoveInternal(uiIndex);
+    return true;
+  }
+
+  return false;
+}
+
+template <typename K, typename H>
+typename nsSwissHashSetBase<K, H>::ConstIterator nsSwissHashSetBase<K, H>::Remove(const typename nsSwissHashSetBase<K, H>::ConstIterator& pos)
+{
+  ConstIterator it = pos;
+  nsUInt32 uiIndex = pos.m_uiCurrentIndex;
+  ++it;
+  RemoveInternal(uiIndex);
+  return it;
+}
+
+template <typename K, typename H>
+void nsSwissHashSetBase<K, H>::RemoveInternal(nsUInt32 uiIndex)
+{
+  nsMemoryUtils::Destruct(&m_pEntries[uiIndex], 1);
+
+  if (Control::EraseControl(m_pControl, m_uiCapacity, uiIndex))
+  {
+    ++m_uiGrowthLeft;
+  }
+
+  --m_uiCount;
+}
+
+template <typename K, typename H>
+template <typename CompatibleKeyType>
+NS_FORCE_INLINE bool nsSwissHashSetBase<K, H>::Contains(const CompatibleKeyType& key) const
+{
+  return FindEntry(key) != nsInvalidIndex;
+}
+
+template <typename K, typename H>
+bool nsSwissHashSetBase<K, H>::ContainsSet(const nsSwissHashSetBase<K, H>& operand) const
+{
+  for (const K& key : operand)
+  {
+    if (!Contains(key))
+      return false;
+  }
+
+  return true;
+}
+
+template <typename K, typename H>
+void nsSwissHashSetBase<K, H>::Union(const nsSwissHashSetBase<K, H>& operand)
+{
+  Reserve(GetCount() + operand.GetCount());
+  for (const auto& key : operand)
+  {
+    Insert(key);
+  }
+}
+
+template <typename K, typename H>
+void nsSwissHashSetBase<K, H>::Difference(const nsSwissHashSetBase<K, H>& operand)
+{
+  for (const auto& key : operand)
+  {
+    Remove(key);
+  }
+}
+
+template <typename K, typename H>
+void nsSwissHashSetBase<K, H>::Intersection(const nsSwissHashSetBase<K, H>& operand)
+{
+  for (auto it = GetIterator(); it.IsValid();)
+  {
+    if (!operand.Contains(it.Key()))
+      it = Remove(it);
+    else
+      ++it;
+  }
+}
+
+template <typename K, typename H>
+NS_FORCE_INLINE typename nsSwissHashSetBase<K, H>::ConstIterator nsSwissHashSetBase<K, H>::GetIterator() const
+{
+  ConstIterator iterator(*this);
+  iterator.SetToBegin();
+  return iterator;
+}
+
+template <typename K, typename H>
+NS_FORCE_INLINE typename nsSwissHashSetBase<K, H>::ConstIterator nsSwissHashSetBase<K, H>::GetEndIterator() const
+{
+  ConstIterator iterator(*this);
+  iterator.SetToEnd();
+  return iterator;
+}
+
+template <typename K, typename H>
+NS_ALWAYS_INLINE nsAllocator* nsSwissHashSetBase<K, H>::GetAllocator() const
+{
+  return m_pAllocator;
+}
+
+template <typename K, typename H>
+nsUInt64 nsSwissHashSetBase<K, H>::GetHeapMemoryUsage() const
+{
+  if (m_uiCapacity == 0)
+    return 0;
+
+  return ((nsUInt64)m_uiCapacity * sizeof(K)) + Control::GetControlBytesCount(m_uiCapacity);
+}
+
+template <typename K, typename H>
+template <typename CompatibleKeyType>
+typename nsSwissHashSetBase<K, H>::ConstIterator nsSwissHashSetBase<K, H>::Find(const CompatibleKeyType& key) const
+{
+  nsUInt32 uiIndex = FindEntry(key);
+  if (uiIndex == nsInvalidIndex)
+  {
+    return GetEndIterator();
+  }
+
+  ConstIterator it(*this);
+  it.m_uiCurrentIndex = uiIndex;
+  return it;
+}
+
+// private methods
+template <typename K, typename H>
+void nsSwissHashSetBase<K, H>::SetCapacity(nsUInt32 uiCapacity)
+{
+  NS_ASSERT_DEBUG(nsMath::IsPowerOf2(uiCapacity) && uiCapacity >= Control::MinCapacity, "Invalid capacity {0}", uiCapacity);
+  NS_ASSERT_DEBUG(Control::GetMaxLoad(uiCapacity) >= m_uiCount, "The capacity is too small");
+
+  const nsUInt32 uiOldCapacity = m_uiCapacity;
+  K* pOldEntries = m_pEntries;
+  nsUInt8* pOldControl = m_pControl;
+
+  const nsUInt64 uiEntriesSize = nsMath::SafeMultiply64(uiCapacity, sizeof(K));
+  void* pData = m_pAllocator->Allocate(static_cast<size_t>(uiEntriesSize + Control::GetControlBytesCount(uiCapacity)), alignof(K));
+
+  m_pEntries = static_cast<K*>(pData);
+  m_pControl = static_cast<nsUInt8*>(pData) + uiEntriesSize;
+  m_uiCapacity = uiCapacity;
+  m_uiGrowthLeft = Control::GetMaxLoad(uiCapacity) - m_uiCount;
+  Control::ResetControl(m_pControl, uiCapacity);
+
+  // the new table has no deleted slots, so every entry goes to the first free slot of its probe sequence
+  for (nsUInt32 i = Control::FindNextFull(pOldControl, uiOldCapacity, 0); i < uiOldCapacity; i = Control::FindNextFull(pOldControl, uiOldCapacity, i + 1))
+  {
+    const nsUInt32 uiMixedHash = Control::MixHash(H::Hash(pOldEntries[i]));
+    const nsUInt32 uiIndex = Control::FindFirstNonFull(m_pControl, m_uiCapacity, uiMixedHash);
+    Control::SetControl(m_pControl, m_uiCapacity, uiIndex, Control::H2(uiMixedHash));
+
+    nsMemoryUtils::RelocateConstruct(&m_pEntries[uiIndex], &pOldEntries[i], 1);
+  }
+
+  if (pOldEntries != nullptr)
+  {
+    m_pAllocator->Deallocate(pOldEntries);
+  }
+}
+
+template <typename K, typename H>
+void nsSwissHashSetBase<K, H>::DeallocateStorage()
+{
+  NS_ASSERT_DEBUG(m_uiCount == 0, "The set must be cleared first");
+
+  if (m_pEntries != nullptr)
+  {
+    m_pAllocator->Deallocate(m_pEntries);
+  }
+
+  m_pEntries = nullptr;
+  m_pControl = nullptr;
+  m_uiCapacity = 0;
+  m_uiGrowthLeft = 0;
+}
+
+template <typename K, typename H>
+nsUInt32 nsSwissHashSetBase<K, H>::PrepareInsert(nsUInt32 uiMixedHash)
+{
+  if (m_uiCapacity == 0)
+  {
+    SetCapacity(Control::MinCapacity);
+  }
+
+  nsUInt32 uiIndex = Control::FindFirstNonFull(m_pControl, m_uiCapacity, uiMixedHash);
+
+  // deleted slots can always be reused, empty ones only as long as the maximum load is not reached
+  if (m_uiGrowthLeft == 0 && m_pControl[uiIndex] == Control::Empty)
+  {
+    // if enough of the used slots are deleted ones, rehashing at the same size is enough to get rid of them
+    const nsUInt32 uiNewCapacity = Control::ShouldRehashInPlace(m_uiCount, m_uiCapacity) ? m_uiCapacity : m_uiCapacity * 2;
+    SetCapacity(uiNewCapacity);
+
+    uiIndex = Control::FindFirstNonFull(m_pControl, m_uiCapacity, uiMixedHash);
+  }
+
+  if (m_pControl[uiIndex] == Control::Empty)
+  {
+    --m_uiGrowthLeft;
+  }
+
+  Control::SetControl(m_pControl, m_uiCapacity, uiIndex, Control::H2(uiMixedHash));
+  ++m_uiCount;
+
+  return uiIndex;
+}
+
+template <typename K, typename H>
+template <typename CompatibleKeyType>
+NS_ALWAYS_INLINE nsUInt32 nsSwissHashSetBase<K, H>::FindEntry(const CompatibleKeyType& key) const
+{
+  return FindEntry(Control::MixHash(H::Hash(key)), key);
+}
+
+template <typename K, typename H>
+template <typename CompatibleKeyType>
+inline nsUInt32 nsSwissHashSetBase<K, H>::FindEntry(nsUInt32 uiMixedHash, const CompatibleKeyType& key) const
+{
+  if (m_uiCapacity > 0)
+  {
+    const nsUInt8 uiH2 = Control::H2(uiMixedHash);
+    Control::ProbeSequence seq(uiMixedHash, m_uiCapacity);
+
+    while (true)
+    {
+      const Control::Group group(m_pControl + seq.GetOffset());
+
+      for (Control::BitMask match = group.Match(uiH2); match.HasAny(); match.ClearLowest())
+      {
+        const nsUInt32 uiIndex = seq.GetOffset(match.GetLowest());
+        if (H::Equal(m_pEntries[uiIndex], key))
+          return uiIndex;
+      }
+
+      // the key would have been inserted into the first group that has an empty slot
+      if (group.MatchEmpty().HasAny())
+        break;
+
+      seq.Next();
+    }
+  }
+
+  // not found
+  return nsInvalidIndex;
+}
+
+template <typename K, typename H, typename A>
+nsSwissHashSet<K, H, A>::nsSwissHashSet()
+  : nsSwissHashSetBase<K, H>(A::GetAllocator())
+{
+}
+
+template <typename K, typename H, typename A>
+nsSwissHashSet<K, H, A>::nsSwissHashSet(nsAllocator* pAllocator)
+  : nsSwissHashSetBase<K, H>(pAllocator)
+{
+}
+
+template <typename K, typename H, typename A>
+nsSwissHashSet<K, H, A>::nsSwissHashSet(const nsSwissHashSet<K, H, A>& other)
+  : nsSwissHashSetBase<K, H>(other, A::GetAllocator())
+{
+}
+
+template <typename K, typename H, typename A>
+nsSwissHashSet<K, H, A>::nsSwissHashSet(const nsSwissHashSetBase<K, H>& other)
+  : nsSwissHashSetBase<K, H>(other, A::GetAllocator())
+{
+}
+
+template <typename K, typename H, typename A>
+nsSwissHashSet<K, H, A>::nsSwissHashSet(nsSwissHashSet<K, H, A>&& other)
+  : nsSwissHashSetBase<K, H>(std::move(other), other.GetAllocator())
+{
+}
+
+template <typename K, typename H, typename A>
+nsSwissHashSet<K, H, A>::nsSwissHashSet(nsSwissHashSetBase<K, H>&& other)
+  : nsSwissHashSetBase<K, H>(std::move(other), other.GetAllocator())
+{
+}
+
+template <typename K, typename H, typename A>
+void nsSwissHashSet<K, H, A>::operator=(const nsSwissHashSet<K, H, A>& rhs)
+{
+  nsSwissHashSetBase<K, H>::operator=(rhs);
+}
+
+template <typename K, typename H, typename A>
+void nsSwissHashSet<K, H, A>::operator=(const nsSwissHashSetBase<K, H>& rhs)
+{
+  nsSwissHashSetBase<K, H>::operator=(rhs);
+}
+
+template <typename K, typename H, typename A>
+void nsSwissHashSet<K, H, A>::operator=(nsSwissHashSet<K, H, A>&& rhs)
+{
+  nsSwissHashSetBase<K, H>::operator=(std::move(rhs));
+}
+
+template <typename K, typename H, typename A>
+void nsSwissHashSet<K, H, A>::operator=(nsSwissHashSetBase<K, H>&& rhs)
+{
+  nsSwissHashSetBase<K, H>::operator=(std::move(rhs));
+}
+
+template <typename KeyType, typename Hasher>
+void nsSwissHashSetBase<KeyType, Hasher>::Swap(nsSwissHashSetBase<KeyType, Hasher>& other)
+{
+  nsMath::Swap(this->m_pEntries, other.m_pEntries);
+  nsMath::Swap(this->m_pControl, other.m_pControl);
+  nsMath::Swap(this->m_uiCount, other.m_uiCount);
+  nsMath::Swap(this->m_uiCapacity, other.m_uiCapacity);
+  nsMath::Swap(this->m_uiGrowthLeft, other.m_uiGrowthLeft);
+  nsMath::Swap(this->m_pAllocator, other.m_pAllocator);
+}
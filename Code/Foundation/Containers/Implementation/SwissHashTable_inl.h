@@ -0,0 +1,751 @@
+/// \brief Value used by containers for indices to indicate an invalid index.
+#ifndef nsInvalidIndex
+#  define nsInvalidIndex 0xFFFFFFFF
+#endif
+
+// ***** Const Iterator *****
+
+template <typename K, typename V, typename H>
+nsSwissHashTableBaseConstIterator<K, V, H>::nsSwissHashTableBaseConstIterator(const nsSwissHashTableBase<K, V, H>& hashTable)
+  : m_pHashTable(&hashTable)
+{
+}
+
+template <typename K, typename V, typename H>
+void nsSwissHashTableBaseConstIterator<K, V, H>::SetToBegin()
+{
+  if (m_pHashTable->IsEmpty())
+  {
+    m_uiCurrentIndex = m_pHashTable->m_uiCapacity;
+    return;
+  }
+
+  m_uiCurrentIndex = nsInternal::nsSwissTable::FindNextFull(m_pHashTable->m_pControl, m_pHashTable->m_uiCapacity, 0);
+}
+
+template <typename K, typename V, typename H>
+inline void nsSwissHashTableBaseConstIterator<K, V, H>::SetToEnd()
+{
+  m_uiCurrentIndex = m_pHashTable->m_uiCapacity;
+}
+
+template <typename K, typename V, typename H>
+NS_FORCE_INLINE bool nsSwissHashTableBaseConstIterator<K, V, H>::IsValid() const
+{
+  return m_uiCurrentIndex < m_pHashTable->m_uiCapacity;
+}
+
+template <typename K, typename V, typename H>
+NS_FORCE_INLINE bool nsSwissHashTableBaseConstIterator<K, V, H>::operator==(const nsSwissHashTableBaseConstIterator<K, V, H>& rhs) const
+{
+  return m_uiCurrentIndex == rhs.m_uiCurrentIndex && m_pHashTable->m_pEntries == rhs.m_pHashTable->m_pEntries;
+}
+
+template <typename K, typename V, typename H>
+NS_ALWAYS_INLINE const K& nsSwissHashTableBaseConstIterator<K, V, H>::Key() const
+{
+  return m_pHashTable->m_pEntries[m_uiCurrentIndex].key;
+}
+
+template <typename K, typename V, typename H>
+NS_ALWAYS_INLINE const V& nsSwissHashTableBaseConstIterator<K, V, H>::Value() const
+{
+  return m_pHashTable->m_pEntries[m_uiCurrentIndex].value;
+}
+
+template <typename K, typename V, typename H>
+void nsSwissHashTableBaseConstIterator<K, V, H>::Next()
+{
+  if (m_uiCurrentIndex >= m_pHashTable->m_uiCapacity)
+    return;
+
+  m_uiCurrentIndex = nsInternal::nsSwissTable::FindNextFull(m_pHashTable->m_pControl, m_pHashTable->m_uiCapacity, m_uiCurrentIndex + 1);
+}
+
+template <typename K, typename V, typename H>
+NS_ALWAYS_INLINE void nsSwissHashTableBaseConstIterator<K, V, H>::operator++()
+{
+  Next();
+}
+
+#if NS_ENABLED(NS_USE_CPP20_OPERATORS)
+// These functions are used for structured bindings.
+// They describe how many elements can be accessed in the binding and which type they are.
+namespace std
+{
+  template <typename K, typename V, typename H>
+  struct tuple_size<nsSwissHashTableBaseConstIterator<K, V, H>> : integral_constant<size_t, 2>
+  {
+  };
+
+  template <typename K, typename V, typename H>
+  struct tuple_element<0, nsSwissHashTableBaseConstIterator<K, V, H>>
+  {
+    using type = const K&;
+  };
+
+  template <typename K, typename V, typename H>
+  struct tuple_element<1, nsSwissHashTableBaseConstIterator<K, V, H>>
+  {
+    using type = const V&;
+  };
+} // namespace std
+#endif
+
+// ***** Iterator *****
+
+template <typename K, typename V, typename H>
+nsSwissHashTableBaseIterator<K, V, H>::nsSwissHashTableBaseIterator(const nsSwissHashTableBase<K, V, H>& hashTable)
+  : nsSwissHashTableBaseConstIterator<K, V, H>(hashTable)
+{
+}
+
+template <typename K, typename V, typename H>
+nsSwissHashTableBaseIterator<K, V, H>::nsSwissHashTableBaseIterator(const nsSwissHashTableBaseIterator<K, V, H>& rhs)
+  : nsSwissHashTableBaseConstIterator<K, V, H>(*rhs.m_pHashTable)
+{
+  this->m_uiCurrentIndex = rhs.m_uiCurrentIndex;
+}
+
+template <typename K, typename V, typename H>
+NS_ALWAYS_INLINE void nsSwissHashTableBaseIterator<K, V, H>::operator=(const nsSwissHashTableBaseIterator& rhs) // [tested]
+{
+  this->m_pHashTable = rhs.m_pHashTable;
+  this->m_uiCurrentIndex = rhs.m_uiCurrentIndex;
+}
+
+template <typename K, typename V, typename H>
+NS_FORCE_INLINE V& nsSwissHashTableBaseIterator<K, V, H>::Value()
+{
+  return this->m_pHashTable->m_pEntries[this->m_uiCurrentIndex].value;
+}
+
+template <typename K, typename V, typename H>
+NS_FORCE_INLINE V& nsSwissHashTableBaseIterator<K, V, H>::Value() const
+{
+  return this->m_pHashTable->m_pEntries[this->m_uiCurrentIndex].value;
+}
+
+
+#if NS_ENABLED(NS_USE_CPP20_OPERATORS)
+// These functions are used for structured bindings.
+// They describe how many elements can be accessed in the binding and which type they are.
+namespace std
+{
+  template <typename K, typename V, typename H>
+  struct tuple_size<nsSwissHashTableBaseIterator<K, V, H>> : integral_constant<size_t, 2>
+  {
+  };
+
+  template <typename K, typename V, typename H>
+  struct tuple_element<0, nsSwissHashTableBaseIterator<K, V, H>>
+  {
+    using type = const K&;
+  };
+
+  template <typename K, typename V, typename H>
+  struct tuple_element<1, nsSwissHashTableBaseIterator<K, V, H>>
+  {
+    using type = V&;
+  };
+} // namespace std
+#endif
+
+// ***** nsSwissHashTableBase *****
+
+template <typename K, typename V, typename H>
+nsSwissHashTableBase<K, V, H>::nsSwissHashTableBase(nsAllocator* pAllocator)
+{
+  m_pAllocator = pAllocator;
+}
+
+template <typename K, typename V, typename H>
+nsSwissHashTableBase<K, V, H>::nsSwissHashTableBase(const nsSwissHashTableBase<K, V, H>& other, nsAllocator* pAllocator)
+{
+  m_pAllocator = pAllocator;
+
+  *this = other;
+}
+
+template <typename K, typename V, typename H>
+nsSwissHashTableBase<K, V, H>::nsSwissHashTableBase(nsSwissHashTableBase<K, V, H>&& other, nsAllocator* pAllocator)
+{
+  m_pAllocator = pAllocator;
+
+  *this = std::move(other);
+}
+
+template <typename K, typename V, typename H>
+nsSwissHashTableBase<K, V, H>::~nsSwissHashTableBase()
+{
+  Clear();
+  DeallocateStorage();
+}
+
+template <typename K, typename V, typename H>
+void nsSwissHashTableBase<K, V, H>::operator=(const nsSwissHashTableBase<K, V, H>& rhs)
+{
+  Clear();
+  Reserve(rhs.GetCount());
+
+  for (nsUInt32 i = Control::FindNextFull(rhs.m_pControl, rhs.m_uiCapacity, 0); i < rhs.m_uiCapacity; i = Control::FindNextFull(rhs.m_pControl, rhs.m_uiCapacity, i + 1))
+  {
+    Insert(rhs.m_pEntries[i].key, rhs.m_pEntries[i].value);
+  }
+}
+
+template <typename K, typename V, typename H>
+void nsSwissHashTableBase<K, V, H>::operator=(nsSwissHashTableBase<K, V, H>&& rhs)
+{
+  // Clear any existing data (calls destructors if necessary)
+  Clear();
+
+  if (m_pAllocator != rhs.m_pAllocator)
+  {
+    Reserve(rhs.GetCount());
+
+    for (nsUInt32 i = Control::FindNextFull(rhs.m_pControl, rhs.m_uiCapacity, 0); i < rhs.m_uiCapacity; i = Control::FindNextFull(rhs.m_pControl, rhs.m_uiCapacity, i + 1))
+    {
+      Insert(std::move(rhs.m_pEntries[i].key), std::move(rhs.m_pEntries[i].value));
+    }
+
+    rhs.Clear();
+  }
+  else
+  {
+    DeallocateStorage();
+
+    // Move all data over.
+    m_pEntries = rhs.m_pEntries;
+    m_pControl = rhs.m_pControl;
+    m_uiCount = rhs.m_uiCount;
+    m_uiCapacity = rhs.m_uiCapacity;
+    m_uiGrowthLeft = rhs.m_uiGrowthLeft;
+
+    // Temp copy forgets all its state.
+    rhs.m_pEntries = nullptr;
+    rhs.m_pControl = nullptr;
+    rhs.m_uiCount = 0;
+    rhs.m_uiCapacity = 0;
+    rhs.m_uiGrowthLeft = 0;
+  }
+}
+
+template <typename K, typename V, typename H>
+bool nsSwissHashTableBase<K, V, H>::operator==(const nsSwissHashTableBase<K, V, H>& rhs) const
+{
+  if (m_uiCount != rhs.m_uiCount)
+    return false;
+
+  for (nsUInt32 i = Control::FindNextFull(m_pControl, m_uiCapacity, 0); i < m_uiCapacity; i = Control::FindNextFull(m_pControl, m_uiCapacity, i + 1))
+  {
+    const V* pRhsValue = nullptr;
+    if (!rhs.TryGetValue(m_pEntries[i].key, pRhsValue))
+      return false;
+
+    if (m_pEntries[i].value != *pRhsValue)
+      return false;
+  }
+
+  return true;
+}
+
+template <typename K, typename V, typename H>
+void nsSwissHashTableBase<K, V, H>::Reserve(nsUInt32 uiCapacity)
+{
+  if (uiCapacity <= m_uiCount + m_uiGrowthLeft)
+    return;
+
+  SetCapacity(nsMath::Max(Control::GetCapacityForCount(uiCapacity), m_uiCapacity));
+}
+
+template <typename K, typename V, typename H>
+void nsSwissHashTableBase<K, V, H>::Compact()
+{
+  if (IsEmpty())
+  {
+    // completely deallocate all data, if the table is empty.
+    DeallocateStorage();
+  }
+  else
+  {
+    const nsUInt32 uiNewCapacity = Control::GetCapacityForCount(m_uiCount);
+    if (m_uiCapacity != uiNewCapacity)
+      SetCapacity(uiNewCapacity);
+  }
+}
+
+template <typename K, typename V, typename H>
+NS_ALWAYS_INLINE nsUInt32 nsSwissHashTableBase<K, V, H>::GetCount() const
+{
+  return m_uiCount;
+}
+
+template <typename K, typename V, typename H>
+NS_ALWAYS_INLINE bool nsSwissHashTableBase<K, V, H>::IsEmpty() const
+{
+  return m_uiCount == 0;
+}
+
+template <typename K, typename V, typename H>
+void nsSwissHashTableBase<K, V, H>::Clear()
+{
+  if (m_uiCapacity == 0)
+    return;
+
+  if constexpr (!std::is_trivially_destructible<K>::value || !std::is_trivially_destructible<V>::value)
+  {
+    for (nsUInt32 i = Control::FindNextFull(m_pControl, m_uiCapacity, 0); i < m_uiCapacity; i = Control::FindNextFull(m_pControl, m_uiCapacity, i + 1))
+    {
+      nsMemoryUtils::Destruct(&m_pEntries[i].key, 1);
+      nsMemoryUtils::Destruct(&m_pEntries[i].value, 1);
+    }
+  }
+
+  Control::ResetControl(m_pControl, m_uiCapacity);
+  m_uiCount = 0;
+  m_uiGrowthLeft = Control::GetMaxLoad(m_uiCapacity);
+}
+
+template <typename K, typename V, typename H>
+template <typename CompatibleKeyType, typename CompatibleValueType>
+bool nsSwissHashTableBase<K, V, H>::Insert(CompatibleKeyType&& key, CompatibleValueType&& value, V* out_pOldValue /*= nullptr*/)
+{
+  const nsUInt32 uiMixedHash = Control::MixHash(H::Hash(key));
+  nsUInt32 uiIndex = FindEntry(uiMixedHash, key);
+
+  if (uiIndex != nsInvalidIndex)
+  {
+    if (out_pOldValue != nullptr)
+      *out_pOldValue = std::move(m_pEntries[uiIndex].value);
+
+    m_pEntries[uiIndex].value = std::forward<CompatibleValueType>(value); // Either move or copy assignment.
+    return true;
+  }
+
+  uiIndex = PrepareInsert(uiMixedHash);
+
+  // Both constructions might either be a move or a copy.
+  nsMemoryUtils::CopyOrMoveConstruct(&m_pEntries[uiIndex].key, std::forward<CompatibleKeyType>(key));
+  nsMemoryUtils::CopyOrMoveConstruct(&m_pEntries[uiIndex].value, std::forward<CompatibleValueType>(value));
+
+  return false;
+}
+
+template <typename K, typename V, typename H>
+template <typename CompatibleKeyType>
+bool nsSwissHashTableBase<K, V, H>::Remove(const CompatibleKeyType& key, V* out_pOldValue /*= nullptr*/)
+{
+  nsUInt32 uiIndex = FindEntry(key);
+  if (uiIndex != nsInvalidIndex)
+  {
+    if (out_pOldValue != nullptr)
+      *out_pOldValue = std::move(m_pEntries[uiIndex].value);
+
+    RemoveInternal(uiIndex);
+    return true;
+  }
+
+  return false;
+}
+
+template <typename K, typename V, typename H>
+typename nsSwissHashTableBase<K, V, H>::Iterator nsSwissHashTableBase<K, V, H>::Remove(const typename nsSwissHashTableBase<K, V, H>::Iterator& pos)
+{
+  NS_ASSERT_DEBUG(pos.m_pHashTable == this, "Iterator from wrong hashtable");
+  Iterator it = pos;
+  nsUInt32 uiIndex = pos.m_uiCurrentIndex;
+  ++it;
+  RemoveInternal(uiIndex);
+  return it;
+}
+
+template <typename K, typename V, typename H>
+void nsSwissHashTableBase<K, V, H>::RemoveInternal(nsUInt32 uiIndex)
+{
+  nsMemoryUtils::Destruct(&m_pEntries[uiIndex].key, 1);
+  nsMemoryUtils::Destruct(&m_pEntries[uiIndex].value, 1);
+
+  if (Control::EraseControl(m_pControl, m_uiCapacity, uiIndex))
+  {
+    ++m_uiGrowthLeft;
+  }
+
+  --m_uiCount;
+}
+
+template <typename K, typename V, typename H>
+template <typename CompatibleKeyType>
+inline bool nsSwissHashTableBase<K, V, H>::TryGetValue(const CompatibleKeyType& key, V& out_value) const
+{
+  nsUInt32 uiIndex = FindEntry(key);
+  if (uiIndex != nsInvalidIndex)
+  {
+    NS_ASSERT_DEBUG(m_pEntries != nullptr, "No entries present"); // To fix static analysis
+    out_value = m_pEntries[uiIndex].value;
+    return true;
+  }
+
+  return false;
+}
+
+template <typename K, typename V, typename H>
+template <typename CompatibleKeyType>
+inline bool nsSwissHashTableBase<K, V, H>::TryGetValue(const CompatibleKeyType& key, const V*& out_pValue) const
+{
+  nsUInt32 uiIndex = FindEntry(key);
+  if (uiIndex != nsInvalidIndex)
+  {
+    out_pValue = &m_pEntries[uiIndex].value;
+    NS_ANALYSIS_ASSUME(out_pValue != nullptr);
+    return true;
+  }
+
+  return false;
+}
+
+template <typename K, typename V, typename H>
+template <typename CompatibleKeyType>
+inline bool nsSwissHashTableBase<K, V, H>::TryGetValue(const CompatibleKeyType& key, V*& out_pValue) const
+{
+  nsUInt32 uiIndex = FindEntry(key);
+  if (uiIndex != nsInvalidIndex)
+  {
+    out_pValue = &m_pEntries[uiIndex].value;
+    NS_ANALYSIS_ASSUME(out_pValue != nullptr);
+    return true;
+  }
+
+  return false;
+}
+
+template <typename K, typename V, typename H>
+template <typename CompatibleKeyType>
+inline typename nsSwissHashTableBase<K, V, H>::ConstIterator nsSwissHashTableBase<K, V, H>::Find(const CompatibleKeyType& key) const
+{
+  nsUInt32 uiIndex = FindEntry(key);
+  if (uiIndex == nsInvalidIndex)
+  {
+    return GetEndIterator();
+  }
+
+  ConstIterator it(*this);
+  it.m_uiCurrentIndex = uiIndex;
+  return it;
+}
+
+template <typename K, typename V, typename H>
+template <typename CompatibleKeyType>
+inline typename nsSwissHashTableBase<K, V, H>::Iterator nsSwissHashTableBase<K, V, H>::Find(const CompatibleKeyType& key)
+{
+  nsUInt32 uiIndex = FindEntry(key);
+  if (uiIndex == nsInvalidIndex)
+  {
+    return GetEndIterator();
+  }
+
+  Iterator it(*this);
+  it.m_uiCurrentIndex = uiIndex;
+  return it;
+}
+
+template <typename K, typename V, typename H>
+template <typename CompatibleKeyType>
+inline const V* nsSwissHashTableBase<K, V, H>::GetValue(const CompatibleKeyType& key) const
+{
+  nsUInt32 uiIndex = FindEntry(key);
+  return (uiIndex != nsInvalidIndex) ? &m_pEntries[uiIndex].value : nullptr;
+}
+
+template <typename K, typename V, typename H>
+template <typename CompatibleKeyType>
+inline V* nsSwissHashTableBase<K, V, H>::GetValue(const CompatibleKeyType& key)
+{
+  nsUInt32 uiIndex = FindEntry(key);
+  return (uiIndex != nsInvalidIndex) ? &m_pEntries[uiIndex].value : nullptr;
+}
+
+template <typename K, typename V, typename H>
+inline V& nsSwissHashTableBase<K, V, H>::operator[](const K& key)
+{
+  return FindOrAdd(key, nullptr);
+}
+
+template <typename K, typename V, typename H>
+V& nsSwissHashTableBase<K, V, H>::FindOrAdd(const K& key, bool* out_pExisted)
+{
+  const nsUInt32 uiMixedHash = Control::MixHash(H::Hash(key));
+  nsUInt32 uiIndex = FindEntry(uiMixedHash, key);
+
+  if (out_pExisted)
+  {
+    *out_pExisted = uiIndex != nsInvalidIndex;
+  }
+
+  if (uiIndex == nsInvalidIndex)
+  {
+    uiIndex = PrepareInsert(uiMixedHash);
+
+    // new entry
+    nsMemoryUtils::CopyConstruct(&m_pEntries[uiIndex].key, key, 1);
+    nsMemoryUtils::Construct<ConstructAll>(&m_pEntries[uiIndex].value, 1);
+  }
+
+  NS_ASSERT_DEBUG(m_pEntries != nullptr, "Entries should be present");
+  return m_pEntries[uiIndex].value;
+}
+
+template <typename K, typename V, typename H>
+template <typename CompatibleKeyType>
+NS_FORCE_INLINE bool nsSwissHashTableBase<K, V, H>::Contains(const CompatibleKeyType& key) const
+{
+  return FindEntry(key) != nsInvalidIndex;
+}
+
+template <typename K, typename V, typename H>
+NS_ALWAYS_INLINE typename nsSwissHashTableBase<K, V, H>::Iterator nsSwissHashTableBase<K, V, H>::GetIterator()
+{
+  Iterator iterator(*this);
+  iterator.SetToBegin();
+  return iterator;
+}
+
+template <typename K, typename V, typename H>
+NS_ALWAYS_INLINE typename nsSwissHashTableBase<K, V, H>::Iterator nsSwissHashTableBase<K, V, H>::GetEndIterator()
+{
+  Iterator iterator(*this);
+  iterator.SetToEnd();
+  return iterator;
+}
+
+template <typename K, typename V, typename H>
+NS_ALWAYS_INLINE typename nsSwissHashTableBase<K, V, H>::ConstIterator nsSwissHashTableBase<K, V, H>::GetIterator() const
+{
+  ConstIterator iterator(*this);
+  iterator.SetToBegin();
+  return iterator;
+}
+
+template <typename K, typename V, typename H>
+NS_ALWAYS_INLINE typename nsSwissHashTableBase<K, V, H>::ConstIterator nsSwissHashTableBase<K, V, H>::GetEndIterator() const
+{
+  ConstIterator iterator(*this);
+  iterator.SetToEnd();
+  return iterator;
+}
+
+template <typename K, typename V, typename H>
+NS_ALWAYS_INLINE nsAllocator* nsSwissHashTableBase<K, V, H>::GetAllocator() const
+{
+  return m_pAllocator;
+}
+
+template <typename K, typename V, typename H>
+nsUInt64 nsSwissHashTableBase<K, V, H>::GetHeapMemoryUsage() const
+{
+  if (m_uiCapacity == 0)
+    return 0;
+
+  return ((nsUInt64)m_uiCapacity * sizeof(Entry)) + Control::GetControlBytesCount(m_uiCapacity);
+}
+
+template <typename KeyType, typename ValueType, typename Hasher>
+void nsSwissHashTableBase<KeyType, ValueType, Hasher>::Swap(nsSwissHashTableBase<KeyType, ValueType, Hasher>& other)
+{
+  nsMath::Swap(this->m_pEntries, other.m_pEntries);
+  nsMath::Swap(this->m_pControl, other.m_pControl);
+  nsMath::Swap(this->m_uiCount, other.m_uiCount);
+  nsMath::Swap(this->m_uiCapacity, other.m_uiCapacity);
+  nsMath::Swap(this->m_uiGrowthLeft, other.m_uiGrowthLeft);
+  nsMath::Swap(this->m_pAllocator, other.m_pAllocator);
+}
+
+// private methods
+template <typename K, typename V, typename H>
+void nsSwissHashTableBase<K, V, H>::SetCapacity(nsUInt32 uiCapacity)
+{
+  NS_ASSERT_DEBUG(nsMath::IsPowerOf2(uiCapacity) && uiCapacity >= Control::MinCapacity, "Invalid capacity {0}", uiCapacity);
+  NS_ASSERT_DEBUG(Control::GetMaxLoad(uiCapacity) >= m_uiCount, "The capacity is too small");
+
+  const nsUInt32 uiOldCapacity = m_uiCapacity;
+  Entry* pOldEntries = m_pEntries;
+  nsUInt8* pOldControl = m_pControl;
+
+  const nsUInt64 uiEntriesSize = nsMath::SafeMultiply64(uiCapacity, sizeof(Entry));
+  void* pData = m_pAllocator->Allocate(static_cast<size_t>(uiEntriesSize + Control::GetControlBytesCount(uiCapacity)), alignof(Entry));
+
+  m_pEntries = static_cast<Entry*>(pData);
+  m_pControl = static_cast<nsUInt8*>(pData) + uiEntriesSize;
+  m_uiCapacity = uiCapacity;
+  m_uiGrowthLeft = Control::GetMaxLoad(uiCapacity) - m_uiCount;
+  Control::ResetControl(m_pControl, uiCapacity);
+
+  // the new table has no deleted slots, so every entry goes to the first free slot of its probe sequence
+  for (nsUInt32 i = Control::FindNextFull(pOldControl, uiOldCapacity, 0); i < uiOldCapacity; i = Control::FindNextFull(pOldControl, uiOldCapacity, i + 1))
+  {
+    const nsUInt32 uiMixedHash = Control::MixHash(H::Hash(pOldEntries[i].key));
+    const nsUInt32 uiIndex = Control::FindFirstNonFull(m_pControl, m_uiCapacity, uiMixedHash);
+    Control::SetControl(m_pControl, m_uiCapacity, uiIndex, Control::H2(uiMixedHash));
+
+    nsMemoryUtils::RelocateConstruct(&m_pEntries[uiIndex].key, &pOldEntries[i].key, 1);
+    nsMemoryUtils::RelocateConstruct(&m_pEntries[uiIndex].value, &pOldEntries[i].value, 1);
+  }
+
+  if (pOldEntries != nullptr)
+  {
+    m_pAllocator->Deallocate(pOldEntries);
+  }
+}
+
+template <typename K, typename V, typename H>
+void nsSwissHashTableBase<K, V, H>::DeallocateStorage()
+{
+  NS_ASSERT_DEBUG(m_uiCount == 0, "The table must be cleared first");
+
+  if (m_pEntries != nullptr)
+  {
+    m_pAllocator->Deallocate(m_pEntries);
+  }
+
+  m_pEntries = nullptr;
+  m_pControl = nullptr;
+  m_uiCapacity = 0;
+  m_uiGrowthLeft = 0;
+}
+
+template <typename K, typename V, typename H>
+nsUInt32 nsSwissHashTableBase<K, V, H>::PrepareInsert(nsUInt32 uiMixedHash)
+{
+  if (m_uiCapacity == 0)
+  {
+    SetCapacity(Control::MinCapacity);
+  }
+
+  nsUInt32 uiIndex = Control::FindFirstNonFull(m_pControl, m_uiCapacity, uiMixedHash);
+
+  // deleted slots can always be reused, empty ones only as long as the maximum load is not reached
+  if (m_uiGrowthLeft == 0 && m_pControl[uiIndex] == Control::Empty)
+  {
+    // if enough of the used slots are deleted ones, rehashing at the same size is enough to get rid of them
+    const nsUInt32 uiNewCapacity = Control::ShouldRehashInPlace(m_uiCount, m_uiCapacity) ? m_uiCapacity : m_uiCapacity * 2;
+    SetCapacity(uiNewCapacity);
+
+    uiIndex = Control::FindFirstNonFull(m_pControl, m_uiCapacity, uiMixedHash);
+  }
+
+  if (m_pControl[uiIndex] == Control::Empty)
+  {
+    --m_uiGrowthLeft;
+  }
+
+  Control::SetControl(m_pControl, m_uiCapacity, uiIndex, Control::H2(uiMixedHash));
+  ++m_uiCount;
+
+  return uiIndex;
+}
+
+template <typename K, typename V, typename H>
+template <typename CompatibleKeyType>
+NS_ALWAYS_INLINE nsUInt32 nsSwissHashTableBase<K, V, H>::FindEntry(const CompatibleKeyType& key) const
+{
+  return FindEntry(Control::MixHash(H::Hash(key)), key);
+}
+
+template <typename K, typename V, typename H>
+template <typename CompatibleKeyType>
+inline nsUInt32 nsSwissHashTableBase<K, V, H>::FindEntry(nsUInt32 uiMixedHash, const CompatibleKeyType& key) const
+{
+  if (m_uiCapacity > 0)
+  {
+    const nsUInt8 uiH2 = Control::H2(uiMixedHash);
+    Control::ProbeSequence seq(uiMixedHash, m_uiCapacity);
+
+    while (true)
+    {
+      const Control::Group group(m_pControl + seq.GetOffset());
+
+      for (Control::BitMask match = group.Match(uiH2); match.HasAny(); match.ClearLowest())
+      {
+        const nsUInt32 uiIndex = seq.GetOffset(match.GetLowest());
+        if (H::Equal(m_pEntries[uiIndex].key, key))
+          return uiIndex;
+      }
+
+      // the key would have been inserted into the first group that has an empty slot
+      if (group.MatchEmpty().HasAny())
+        break;
+
+      seq.Next();
+    }
+  }
+
+  // not found
+  return nsInvalidIndex;
+}
+
+template <typename K, typename V, typename H>
+NS_FORCE_INLINE bool nsSwissHashTableBase<K, V, H>::IsValidEntry(nsUInt32 uiEntryIndex) const
+{
+  return Control::IsFull(m_pControl[uiEntryIndex]);
+}
+
+
+template <typename K, typename V, typename H, typename A>
+nsSwissHashTable<K, V, H, A>::nsSwissHashTable()
+  : nsSwissHashTableBase<K, V, H>(A::GetAllocator())
+{
+}
+
+template <typename K, typename V, typename H, typename A>
+nsSwissHashTable<K, V, H, A>::nsSwissHashTable(nsAllocator* pAllocator)
+  : nsSwissHashTableBase<K, V, H>(pAllocator)
+{
+}
+
+template <typename K, typename V, typename H, typename A>
+nsSwissHashTable<K, V, H, A>::nsSwissHashTable(const nsSwissHashTable<K, V, H, A>& other)
+  : nsSwissHashTableBase<K, V, H>(other, A::GetAllocator())
+{
+}
+
+template <typename K, typename V, typename H, typename A>
+nsSwissHashTable<K, V, H, A>::nsSwissHashTable(const nsSwissHashTableBase<K, V, H>& other)
+  : nsSwissHashTableBase<K, V, H>(other, A::GetAllocator())
+{
+}
+
+template <typename K, typename V, typename H, typename A>
+nsSwissHashTable<K, V, H, A>::nsSwissHashTable(nsSwissHashTable<K, V, H, A>&& other)
+  : nsSwissHashTableBase<K, V, H>(std::move(other), other.GetAllocator())
+{
+}
+
+template <typename K, typename V, typename H, typename A>
+nsSwissHashTable<K, V, H, A>::nsSwissHashTable(nsSwissHashTableBase<K, V, H>&& other)
+  : nsSwissHashTableBase<K, V, H>(std::move(other), other.GetAllocator())
+{
+}
+
+template <typename K, typename V, typename H, typename A>
+void nsSwissHashTable<K, V, H, A>::operator=(const nsSwissHashTable<K, V, H, A>& rhs)
+{
+  nsSwissHashTableBase<K, V, H>::operator=(rhs);
+}
+
+template <typename K, typename V, typename H, typename A>
+void nsSwissHashTable<K, V, H, A>::operator=(const nsSwissHashTableBase<K, V, H>& rhs)
+{
+  nsSwissHashTableBase<K, V, H>::operator=(rhs);
+}
+
+template <typename K, typename V, typename H, typename A>
+void nsSwissHashTable<K, V, H, A>::operator=(nsSwissHashTable<K, V, H, A>&& rhs)
+{
+  nsSwissHashTableBase<K, V, H>::operator=(std::move(rhs));
+}
+
+template <typename K, typename V, typename H, typename A>
+void nsSwissHashTable<K, V, H, A>::operator=(nsSwissHashTableBase<K, V, H>&& rhs)
+{
+  nsSwissHashTableBase<K, V, H>::operator=(std::move(rhs));
+}
@@ -0,0 +1,269 @@
+#pragma once
+
+#include <Foundation/Math/Math.h>
+#include <Foundation/Memory/MemoryUtils.h>
+
+#if NS_ENABLED(NS_PLATFORM_ARCH_X86) && (defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2))
+#  define NS_SWISS_TABLE_SSE2 NS_ON
+#  define NS_SWISS_TABLE_NEON NS_OFF
+#  include <emmintrin.h>
+#elif NS_ENABLED(NS_PLATFORM_ARCH_ARM) && NS_ENABLED(NS_PLATFORM_64BIT) && (defined(__ARM_NEON) || defined(_M_ARM64))
+#  define NS_SWISS_TABLE_SSE2 NS_OFF
+#  define NS_SWISS_TABLE_NEON NS_ON
+#  include <arm_neon.h>
+#else
+#  define NS_SWISS_TABLE_SSE2 NS_OFF
+#  define NS_SWISS_TABLE_NEON NS_OFF
+#endif
+
+namespace nsInternal
+{
+  /// \brief Helpers for the control bytes of nsSwissHashTable and nsSwissHashSet.
+  ///
+  /// Every slot of the table has one control byte. It is either Empty, Deleted or, if the slot is in use, the upper 7 bits of the hash
+  /// of its key (H2). The lower bits of the hash (H1) select the group where the search for a key starts. Groups of GroupWidth control
+  /// bytes are compared against H2 at once, so a key comparison only happens for slots whose H2 matches, which is rare for other keys.
+  ///
+  /// The control byte array has GroupWidth - 1 additional bytes at its end, which mirror the first bytes of the table,
+  /// so that a group can be loaded at any position without wrapping around.
+  struct nsSwissTable
+  {
+    static constexpr nsUInt32 GroupWidth = 16;
+    static constexpr nsUInt32 MinCapacity = GroupWidth;
+
+    static constexpr nsUInt8 Empty = 0x80;
+    static constexpr nsUInt8 Deleted = 0xFE;
+
+    NS_ALWAYS_INLINE static bool IsFull(nsUInt8 uiControl) { return (uiControl & 0x80) == 0; }
+
+    /// \brief Hashers like nsHashHelper<nsUInt32> don't mix their lower bits well, so the hash is scrambled once more before it is split.
+    NS_ALWAYS_INLINE static nsUInt32 MixHash(nsUInt32 uiHash)
+    {
+      uiHash ^= uiHash >> 16;
+      uiHash *= 0x85ebca6bu;
+      uiHash ^= uiHash >> 13;
+      return uiHash;
+    }
+
+    /// \brief Where the probing starts.
+    NS_ALWAYS_INLINE static nsUInt32 H1(nsUInt32 uiMixedHash) { return uiMixedHash; }
+
+    /// \brief What is stored in the control byte.
+    NS_ALWAYS_INLINE static nsUInt8 H2(nsUInt32 uiMixedHash) { return static_cast<nsUInt8>(uiMixedHash >> 25); }
+
+    /// \brief How many elements a table with the given capacity can hold before it has to grow (a maximum load of 87.5%).
+    NS_ALWAYS_INLINE static nsUInt32 GetMaxLoad(nsUInt32 uiCapacity) { return uiCapacity - uiCapacity / 8; }
+
+    /// \brief Whether a full table should only drop its deleted slots instead of growing. Must leave enough room to not rehash again soon.
+    NS_ALWAYS_INLINE static bool ShouldRehashInPlace(nsUInt32 uiCount, nsUInt32 uiCapacity)
+    {
+      return static_cast<nsUInt64>(uiCount) * 32 <= static_cast<nsUInt64>(uiCapacity) * 25;
+    }
+
+    /// \brief Returns the smallest capacity that can hold the given number of elements.
+    static nsUInt32 GetCapacityForCount(nsUInt32 uiCount)
+    {
+      nsUInt32 uiCapacity = MinCapacity;
+      while (GetMaxLoad(uiCapacity) < uiCount)
+      {
+        NS_ASSERT_DEBUG(uiCapacity < 0x80000000u, "nsSwissHashTable/Set do not support more than 1.8 billion entries.");
+        uiCapacity *= 2;
+      }
+      return uiCapacity;
+    }
+
+    NS_ALWAYS_INLINE static nsUInt32 GetControlBytesCount(nsUInt32 uiCapacity) { return uiCapacity + GroupWidth; }
+
+    /// \brief The set bits of a group match, one bit (or one nibble with NEON) per slot.
+    struct BitMask
+    {
+#if NS_ENABLED(NS_SWISS_TABLE_NEON)
+      static constexpr nsUInt32 Shift = 2;
+#else
+      static constexpr nsUInt32 Shift = 0;
+#endif
+
+      NS_ALWAYS_INLINE bool HasAny() const { return m_uiMask != 0; }
+
+      /// \brief The index of the first matching slot within the group.
+      NS_ALWAYS_INLINE nsUInt32 GetLowest() const { return nsMath::CountTrailingZeros(m_uiMask) >> Shift; }
+
+      /// \brief The index of the last matching slot within the group.
+      NS_ALWAYS_INLINE nsUInt32 GetHighest() const { return nsMath::FirstBitHigh(m_uiMask) >> Shift; }
+
+      NS_ALWAYS_INLINE void ClearLowest() { m_uiMask &= m_uiMask - 1; }
+
+      nsUInt64 m_uiMask = 0;
+    };
+
+    /// \brief GroupWidth control bytes, compared with SSE2 or NEON if available.
+    struct Group
+    {
+      NS_ALWAYS_INLINE explicit Group(const nsUInt8* pControl)
+      {
+#if NS_ENABLED(NS_SWISS_TABLE_SSE2)
+        m_Data = _mm_loadu_si128(reinterpret_cast<const __m128i*>(pControl));
+#elif NS_ENABLED(NS_SWISS_TABLE_NEON)
+        m_Data = vld1q_u8(pControl);
+#else
+        nsMemoryUtils::RawByteCopy(m_Data, pControl, GroupWidth);
+#endif
+      }
+
+      /// \brief Slots whose control byte is the given H2.
+      NS_ALWAYS_INLINE BitMask Match(nsUInt8 uiH2) const
+      {
+#if NS_ENABLED(NS_SWISS_TABLE_SSE2)
+        return {static_cast<nsUInt64>(_mm_movemask_epi8(_mm_cmpeq_epi8(m_Data, _mm_set1_epi8(static_cast<char>(uiH2)))))};
+#elif NS_ENABLED(NS_SWISS_TABLE_NEON)
+        return ToBitMask(vceqq_u8(m_Data, vdupq_n_u8(uiH2)));
+#else
+        nsUInt64 uiMask = 0;
+        for (nsUInt32 i = 0; i < GroupWidth; ++i)
+        {
+          uiMask |= static_cast<nsUInt64>(m_Data[i] == uiH2) << i;
+        }
+        return {uiMask};
+#endif
+      }
+
+      NS_ALWAYS_INLINE BitMask MatchEmpty() const { return Match(Empty); }
+
+      /// \brief Slots that are not in use. Both Empty and Deleted have the highest bit set, full slots don't.
+      NS_ALWAYS_INLINE BitMask MatchEmptyOrDeleted() const
+      {
+#if NS_ENABLED(NS_SWISS_TABLE_SSE2)
+        return {static_cast<nsUInt64>(_mm_movemask_epi8(m_Data))};
+#elif NS_ENABLED(NS_SWISS_TABLE_NEON)
+        return ToBitMask(vcltzq_s8(vreinterpretq_s8_u8(m_Data)));
+#else
+        nsUInt64 uiMask = 0;
+        for (nsUInt32 i = 0; i < GroupWidth; ++i)
+        {
+          uiMask |= static_cast<nsUInt64>(m_Data[i] >> 7) << i;
+        }
+        return {uiMask};
+#endif
+      }
+
+      NS_ALWAYS_INLINE BitMask MatchFull() const
+      {
+        BitMask mask = MatchEmptyOrDeleted();
+#if NS_ENABLED(NS_SWISS_TABLE_NEON)
+        mask.m_uiMask ^= 0x8888888888888888ull;
+#else
+        mask.m_uiMask ^= (1ull << GroupWidth) - 1;
+#endif
+        return mask;
+      }
+
+    private:
+#if NS_ENABLED(NS_SWISS_TABLE_SSE2)
+      __m128i m_Data;
+#elif NS_ENABLED(NS_SWISS_TABLE_NEON)
+      NS_ALWAYS_INLINE static BitMask ToBitMask(uint8x16_t cmp)
+      {
+        // NEON has no movemask, narrowing shifts every 16 bit lane right by 4, which leaves one nibble per byte
+        const uint8x8_t nibbles = vshrn_n_u16(vreinterpretq_u16_u8(cmp), 4);
+        return {vget_lane_u64(vreinterpret_u64_u8(nibbles), 0) & 0x8888888888888888ull};
+      }
+
+      uint8x16_t m_Data;
+#else
+      nsUInt8 m_Data[GroupWidth];
+#endif
+    };
+
+    /// \brief Visits the groups of a table in triangular steps, which reaches every group once if the capacity is a power of two.
+    struct ProbeSequence
+    {
+      NS_ALWAYS_INLINE ProbeSequence(nsUInt32 uiMixedHash, nsUInt32 uiCapacity)
+        : m_uiMask(uiCapacity - 1)
+        , m_uiOffset(H1(uiMixedHash) & m_uiMask)
+      {
+      }
+
+      NS_ALWAYS_INLINE nsUInt32 GetOffset() const { return m_uiOffset; }
+      NS_ALWAYS_INLINE nsUInt32 GetOffset(nsUInt32 uiSlot) const { return (m_uiOffset + uiSlot) & m_uiMask; }
+
+      NS_ALWAYS_INLINE void Next()
+      {
+        m_uiStride += GroupWidth;
+        m_uiOffset = (m_uiOffset + m_uiStride) & m_uiMask;
+      }
+
+      nsUInt32 m_uiMask;
+      nsUInt32 m_uiOffset;
+      nsUInt32 m_uiStride = 0;
+    };
+
+    /// \brief Writes a control byte and its mirror at the end of the array.
+    NS_ALWAYS_INLINE static void SetControl(nsUInt8* pControl, nsUInt32 uiCapacity, nsUInt32 uiIndex, nsUInt8 uiValue)
+    {
+      pControl[uiIndex] = uiValue;
+
+      if (uiIndex < GroupWidth - 1)
+      {
+        pControl[uiCapacity + uiIndex] = uiValue;
+      }
+    }
+
+    static void ResetControl(nsUInt8* pControl, nsUInt32 uiCapacity)
+    {
+      nsMemoryUtils::PatternFill(pControl, Empty, GetControlBytesCount(uiCapacity));
+    }
+
+    /// \brief Returns the first slot along the probe sequence of the hash that is empty or deleted, so deleted slots are reused.
+    static nsUInt32 FindFirstNonFull(const nsUInt8* pControl, nsUInt32 uiCapacity, nsUInt32 uiMixedHash)
+    {
+      ProbeSequence seq(uiMixedHash, uiCapacity);
+
+      while (true)
+      {
+        const BitMask mask = Group(pControl + seq.GetOffset()).MatchEmptyOrDeleted();
+
+        if (mask.HasAny())
+          return seq.GetOffset(mask.GetLowest());
+
+        seq.Next();
+      }
+    }
+
+    /// \brief Marks the slot as unused. Returns true, if it could be marked as Empty instead of Deleted.
+    ///
+    /// A slot can only become Empty, if no search could ever have passed it: Searches stop at groups that contain an empty slot.
+    /// If every window of GroupWidth slots that contains this one also contains an empty slot, no group that included the slot
+    /// was ever full.
+    static bool EraseControl(nsUInt8* pControl, nsUInt32 uiCapacity, nsUInt32 uiIndex)
+    {
+      const nsUInt32 uiIndexBefore = (uiIndex - GroupWidth) & (uiCapacity - 1);
+      const BitMask emptyBefore = Group(pControl + uiIndexBefore).MatchEmpty();
+      const BitMask emptyAfter = Group(pControl + uiIndex).MatchEmpty();
+
+      const bool bWasNeverFull = emptyBefore.HasAny() && emptyAfter.HasAny() &&
+                                 emptyAfter.GetLowest() + (GroupWidth - 1 - emptyBefore.GetHighest()) < GroupWidth;
+
+      SetControl(pControl, uiCapacity, uiIndex, bWasNeverFull ? Empty : Deleted);
+      return bWasNeverFull;
+    }
+
+    /// \brief Returns the index of the first full slot at or after uiIndex, or uiCapacity if there is none.
+    static nsUInt32 FindNextFull(const nsUInt8* pControl, nsUInt32 uiCapacity, nsUInt32 uiIndex)
+    {
+      while (uiIndex < uiCapacity)
+      {
+        const BitMask mask = Group(pControl + uiIndex).MatchFull();
+
+        if (mask.HasAny())
+        {
+          // the group may reach into the mirrored bytes
+          return nsMath::Min(uiIndex + mask.GetLowest(), uiCapacity);
+        }
+
+        uiIndex += GroupWidth;
+      }
+
+      return uiCapacity;
+    }
+  };
+} // namespace nsInternal
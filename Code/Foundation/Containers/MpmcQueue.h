@@ -0,0 +1,67 @@
+#pragma once
+
+#include <Foundation/Math/Math.h>
+#include <Foundation/Memory/AllocatorWrapper.h>
+#include <Foundation/Threading/AtomicInteger.h>
+#include <Foundation/Types/ArrayPtr.h>
+
+/// \brief A bounded, lock-free queue that any number of threads may push to and pop from at the same time.
+///
+/// Every slot stores a sequence number that tells whether it is ready to be written or read in the current round.
+/// A thread claims a position with a single compare-and-swap and then constructs or moves out the element without
+/// interfering with other threads. Producers and consumers keep their positions on separate cache lines.
+///
+/// The capacity is fixed at construction and rounded up to the next power of two, but it is at least two. Elements may be move-only types.
+/// If there is only a single producer and a single consumer, nsSpscRingBuffer is cheaper.
+template <typename T, typename AllocatorWrapper = nsDefaultAllocatorWrapper>
+class nsMpmcQueue
+{
+  NS_DISALLOW_COPY_AND_ASSIGN(nsMpmcQueue);
+
+public:
+  /// \brief Allocates room for at least \a uiCapacity elements.
+  explicit nsMpmcQueue(nsUInt32 uiCapacity, nsAllocator* pAllocator = AllocatorWrapper::GetAllocator()); // [tested]
+
+  /// \brief Destructs all remaining elements. No thread may access the queue anymore at this point.
+  ~nsMpmcQueue(); // [tested]
+
+  /// \brief Appends a copy of \a element. Returns false, if the queue is full.
+  bool TryPush(const T& element); // [tested]
+
+  /// \brief Moves \a element into the queue. Returns false, if the queue is full, \a element is untouched then.
+  bool TryPush(T&& element); // [tested]
+
+  /// \brief Moves the oldest element into \a out_element. Returns false, if the queue is empty.
+  bool TryPop(T& out_element); // [tested]
+
+  /// \brief Returns the number of elements in the queue. Only a snapshot, if other threads are active at the same time.
+  nsUInt32 GetCount() const; // [tested]
+
+  /// \brief Returns whether the queue contains no elements. Only a snapshot, if other threads are active at the same time.
+  bool IsEmpty() const { return GetCount() == 0; } // [tested]
+
+  /// \brief Returns how many elements the queue can hold.
+  nsUInt32 GetCapacity() const { return m_uiMask + 1; } // [tested]
+
+private:
+  struct Cell
+  {
+    // equals the position for which the cell can be written, and the position + 1 once the element can be read
+    nsAtomicInteger64 m_iSequence;
+    alignas(T) nsUInt8 m_Element[sizeof(T)];
+
+    T* GetElement() { return reinterpret_cast<T*>(m_Element); }
+  };
+
+  template <typename U>
+  bool Push(U&& element);
+
+  nsAllocator* m_pAllocator;
+  nsArrayPtr<Cell> m_Cells;
+  nsUInt32 m_uiMask;
+
+  alignas(64) nsAtomicInteger64 m_iPushPos;
+  alignas(64) nsAtomicInteger64 m_iPopPos;
+};
+
+#include <Foundation/Containers/Implementation/MpmcQueue_inl.h>
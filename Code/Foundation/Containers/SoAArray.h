@@ -0,0 +1,177 @@
+#pragma once
+
+#include <Foundation/Memory/AllocatorWrapper.h>
+#include <Foundation/Memory/MemoryUtils.h>
+#include <Foundation/Types/ArrayPtr.h>
+
+#include <tuple>
+
+/// \brief A dynamic array that stores every member of its elements in a separate column (structure of arrays).
+///
+/// nsSoAArray<nsVec3, float, nsUInt32> behaves like an array of structs with three members, but all values of the first member are
+/// stored contiguously, followed by all values of the second member, and so on. Code that only touches some of the members only pulls
+/// those columns through the cache, and columns of floats can be processed directly with nsSimdVec4f or split up with nsTaskSystem::ParallelFor.
+///
+/// All columns live in a single allocation. Every column starts at a 16 byte aligned address and the capacity is always a multiple of 16,
+/// so SIMD loops over a column may process the last partial group of elements without a scalar tail (the values beyond GetCount() are
+/// not initialized). By default the aligned allocator is used, since most allocators only guarantee an alignment of 8 bytes.
+///
+/// Elements are identified by index. RemoveAtAndSwap() fills the gap with the last element, which is what most systems that iterate over
+/// all elements want. Like nsDynamicArray, adding elements may reallocate and invalidates all pointers into the columns.
+template <typename... Types>
+class nsSoAArray
+{
+  static_assert(sizeof...(Types) > 0, "An nsSoAArray needs at least one column.");
+
+public:
+  /// \brief The number of columns, i.e. members per element.
+  static constexpr nsUInt32 NumColumns = sizeof...(Types);
+
+  /// \brief The type of the values stored in the given column.
+  template <nsUInt32 Column>
+  using ColumnType = std::tuple_element_t<Column, std::tuple<Types...>>;
+
+  /// \brief Creates an empty array that uses the aligned allocator. Does not allocate any data yet.
+  nsSoAArray(); // [tested]
+
+  /// \brief Creates an empty array that uses the given allocator. Does not allocate any data yet.
+  explicit nsSoAArray(nsAllocator* pAllocator); // [tested]
+
+  /// \brief Creates a copy of the given array.
+  nsSoAArray(const nsSoAArray<Types...>& other); // [tested]
+
+  /// \brief Moves the given array into this one.
+  nsSoAArray(nsSoAArray<Types...>&& other); // [tested]
+
+  ~nsSoAArray(); // [tested]
+
+  /// \brief Copies the data from the given array into this one.
+  void operator=(const nsSoAArray<Types...>& rhs); // [tested]
+
+  /// \brief Moves the data from the given array into this one.
+  void operator=(nsSoAArray<Types...>&& rhs); // [tested]
+
+  /// \brief Returns the number of elements in the array.
+  NS_ALWAYS_INLINE nsUInt32 GetCount() const { return m_uiCount; } // [tested]
+
+  /// \brief Returns true, if the array does not contain any elements.
+  NS_ALWAYS_INLINE bool IsEmpty() const { return m_uiCount == 0; } // [tested]
+
+  /// \brief Returns the number of elements that fit into the array without reallocating.
+  NS_ALWAYS_INLINE nsUInt32 GetCapacity() const { return m_uiCapacity; } // [tested]
+
+  /// \brief Destructs all elements. The capacity is kept.
+  void Clear(); // [tested]
+
+  /// \brief Expands the array so it can at least store the given capacity.
+  void Reserve(nsUInt32 uiCapacity); // [tested]
+
+  /// \brief Shrinks the allocation to the current count. Deallocates everything, if the array is empty.
+  void Compact(); // [tested]
+
+  /// \brief Resizes the array to the given count. New elements are default constructed in all columns.
+  void SetCount(nsUInt32 uiCount); // [tested]
+
+  /// \brief Appends an element, one value per column, and returns its index.
+  nsUInt32 PushBack(const Types&... values); // [tested]
+
+  /// \brief Appends an element, one value per column, and returns its index.
+  nsUInt32 PushBack(Types&&... values); // [tested]
+
+  /// \brief Appends an element that is default constructed in all columns and returns its index.
+  nsUInt32 ExpandAndGetIndex(); // [tested]
+
+  /// \brief Removes the last element.
+  void PopBack(); // [tested]
+
+  /// \brief Removes the element at the given index by moving the last element into its place. O(1), does not preserve the order.
+  void RemoveAtAndSwap(nsUInt32 uiIndex); // [tested]
+
+  /// \brief Removes the element at the given index by moving all following elements one slot forward. Preserves the order.
+  void RemoveAtAndCopy(nsUInt32 uiIndex); // [tested]
+
+  /// \brief Returns all values of one column.
+  template <nsUInt32 Column>
+  NS_ALWAYS_INLINE nsArrayPtr<ColumnType<Column>> GetColumn() // [tested]
+  {
+    return nsArrayPtr<ColumnType<Column>>(GetColumnPtr<Column>(), m_uiCount);
+  }
+
+  /// \brief Returns all values of one column.
+  template <nsUInt32 Column>
+  NS_ALWAYS_INLINE nsArrayPtr<const ColumnType<Column>> GetColumn() const // [tested]
+  {
+    return nsArrayPtr<const ColumnType<Column>>(GetColumnPtr<Column>(), m_uiCount);
+  }
+
+  /// \brief Returns the value of the given column for the element at the given index.
+  template <nsUInt32 Column>
+  NS_FORCE_INLINE ColumnType<Column>& Get(nsUInt32 uiIndex) // [tested]
+  {
+    NS_ASSERT_DEBUG(uiIndex < m_uiCount, "Out of bounds access. Array has {0} elements, trying to access element at index {1}.", m_uiCount, uiIndex);
+    return GetColumnPtr<Column>()[uiIndex];
+  }
+
+  /// \brief Returns the value of the given column for the element at the given index.
+  template <nsUInt32 Column>
+  NS_FORCE_INLINE const ColumnType<Column>& Get(nsUInt32 uiIndex) const // [tested]
+  {
+    NS_ASSERT_DEBUG(uiIndex < m_uiCount, "Out of bounds access. Array has {0} elements, trying to access element at index {1}.", m_uiCount, uiIndex);
+    return GetColumnPtr<Column>()[uiIndex];
+  }
+
+  /// \brief Returns the allocator that is used by this instance.
+  nsAllocator* GetAllocator() const { return m_pAllocator; }
+
+  /// \brief Returns the amount of bytes that are currently allocated on the heap.
+  nsUInt64 GetHeapMemoryUsage() const { return m_uiCapacity > 0 ? ComputeLayout(m_uiCapacity, nullptr) : 0; } // [tested]
+
+  /// \brief Swaps the contents of this array with another one.
+  void Swap(nsSoAArray<Types...>& other); // [tested]
+
+private:
+  enum
+  {
+    CAPACITY_ALIGNMENT = 16
+  };
+
+  static constexpr size_t COLUMN_ALIGNMENT = 16;
+
+  template <nsUInt32 Column>
+  static constexpr size_t GetColumnAlignment()
+  {
+    return alignof(ColumnType<Column>) > COLUMN_ALIGNMENT ? alignof(ColumnType<Column>) : COLUMN_ALIGNMENT;
+  }
+
+  template <nsUInt32 Column>
+  NS_ALWAYS_INLINE ColumnType<Column>* GetColumnPtr() const
+  {
+    return static_cast<ColumnType<Column>*>(m_pColumns[Column]);
+  }
+
+  /// \brief Calls func(std::integral_constant<nsUInt32, Column>) for every column.
+  template <typename Func>
+  static void ForEachColumn(Func&& func);
+
+  template <typename Func, size_t... Indices>
+  static void ForEachColumn(Func& func, std::index_sequence<Indices...>);
+
+  /// \brief Returns the number of bytes needed for the given capacity and optionally the byte offset of every column.
+  static size_t ComputeLayout(nsUInt32 uiCapacity, size_t* out_pOffsets);
+
+  void SetCapacity(nsUInt32 uiCapacity);
+
+  template <size_t... Indices>
+  void PushBackCopy(std::index_sequence<Indices...>, const Types&... values);
+
+  template <size_t... Indices>
+  void PushBackMove(std::index_sequence<Indices...>, Types&&... values);
+
+  nsAllocator* m_pAllocator = nullptr;
+  void* m_pData = nullptr;
+  void* m_pColumns[NumColumns] = {};
+  nsUInt32 m_uiCount = 0;
+  nsUInt32 m_uiCapacity = 0;
+};
+
+#include <Foundation/Containers/Implementation/SoAArray_inl.h>
@@ -0,0 +1,65 @@
+#pragma once
+
+#include <Foundation/Math/Math.h>
+#include <Foundation/Memory/AllocatorWrapper.h>
+#include <Foundation/Threading/AtomicInteger.h>
+
+/// \brief A bounded, lock-free queue for handing elements from exactly one producer thread to exactly one consumer thread.
+///
+/// TryPush() may only be called by the producer and TryPop() only by the consumer, but both may run at the same time.
+/// Neither side ever blocks or takes a lock. The two sides keep their positions on separate cache lines
+/// and each side caches the last position it has seen of the other one, so that they rarely touch the same memory.
+///
+/// The capacity is fixed at construction and rounded up to the next power of two. Elements may be move-only types.
+/// If more than one thread needs to push or pop, use nsMpmcQueue instead.
+template <typename T, typename AllocatorWrapper = nsDefaultAllocatorWrapper>
+class nsSpscRingBuffer
+{
+  NS_DISALLOW_COPY_AND_ASSIGN(nsSpscRingBuffer);
+
+public:
+  /// \brief Allocates room for at least \a uiCapacity elements.
+  explicit nsSpscRingBuffer(nsUInt32 uiCapacity, nsAllocator* pAllocator = AllocatorWrapper::GetAllocator()); // [tested]
+
+  /// \brief Destructs all remaining elements. No thread may access the queue anymore at this point.
+  ~nsSpscRingBuffer(); // [tested]
+
+  /// \brief Appends a copy of \a element. Returns false, if the queue is full. Only to be called by the producer thread.
+  bool TryPush(const T& element); // [tested]
+
+  /// \brief Moves \a element into the queue. Returns false, if the queue is full, \a element is untouched then. Only to be called by the producer thread.
+  bool TryPush(T&& element); // [tested]
+
+  /// \brief Moves the oldest element into \a out_element. Returns false, if the queue is empty. Only to be called by the consumer thread.
+  bool TryPop(T& out_element); // [tested]
+
+  /// \brief Returns the oldest element without removing it, or nullptr if the queue is empty. Only to be called by the consumer thread.
+  T* TryPeek(); // [tested]
+
+  /// \brief Returns the number of elements in the queue. Only a snapshot, if the other thread is active at the same time.
+  nsUInt32 GetCount() const; // [tested]
+
+  /// \brief Returns whether the queue contains no elements. Only a snapshot, if the other thread is active at the same time.
+  bool IsEmpty() const { return GetCount() == 0; } // [tested]
+
+  /// \brief Returns how many elements the queue can hold.
+  nsUInt32 GetCapacity() const { return m_uiMask + 1; } // [tested]
+
+private:
+  template <typename U>
+  bool Push(U&& element);
+
+  nsAllocator* m_pAllocator;
+  T* m_pElements;
+  nsUInt32 m_uiMask;
+
+  // written by the producer
+  alignas(64) nsAtomicInteger32 m_iWritePos;
+  nsUInt32 m_uiCachedReadPos = 0;
+
+  // written by the consumer
+  alignas(64) nsAtomicInteger32 m_iReadPos;
+  nsUInt32 m_uiCachedWritePos = 0;
+};
+
+#include <Foundation/Containers/Implementation/SpscRingBuffer_inl.h>
@@ -0,0 +1,219 @@
+#pragma once
+
+#include <Foundation/Algorithm/HashingUtils.h>
+#include <Foundation/Containers/Implementation/SwissTableGroup.h>
+#include <Foundation/Math/Math.h>
+#include <Foundation/Memory/AllocatorWrapper.h>
+
+/// \brief Implementation of a hashset with the same interface as nsHashSetBase.
+///
+/// Uses the same storage layout as nsSwissHashTableBase: one control byte per entry, which is compared 16 at a time
+/// with SSE2 or NEON during lookups, and removed entries are reused by later insertions.
+///
+/// \see nsSwissHashTableBase, nsHashSetBase
+template <typename KeyType, typename Hasher>
+class nsSwissHashSetBase
+{
+public:
+  /// \brief Const iterator.
+  class ConstIterator
+  {
+  public:
+    /// \brief Checks whether this iterator points to a valid element.
+    bool IsValid() const; // [tested]
+
+    /// \brief Checks whether the two iterators point to the same element.
+    bool operator==(const typename nsSwissHashSetBase<KeyType, Hasher>::ConstIterator& rhs) const;
+
+    NS_ADD_DEFAULT_OPERATOR_NOTEQUAL(const typename nsSwissHashSetBase<KeyType, Hasher>::ConstIterator&);
+
+    /// \brief Returns the 'key' of the element that this iterator points to.
+    const KeyType& Key() const; // [tested]
+
+    /// \brief Returns the 'key' of the element that this iterator points to.
+    NS_ALWAYS_INLINE const KeyType& operator*() const { return Key(); } // [tested]
+
+    /// \brief Advances the iterator to the next element in the map. The iterator will not be valid anymore, if the end is reached.
+    void Next(); // [tested]
+
+    /// \brief Shorthand for 'Next'
+    void operator++(); // [tested]
+
+  protected:
+    friend class nsSwissHashSetBase<KeyType, Hasher>;
+
+    explicit ConstIterator(const nsSwissHashSetBase<KeyType, Hasher>& hashSet);
+    void SetToBegin();
+    void SetToEnd();
+
+    const nsSwissHashSetBase<KeyType, Hasher>* m_pHashSet = nullptr;
+    nsUInt32 m_uiCurrentIndex = 0; // current element index that this iterator points to.
+  };
+
+protected:
+  /// \brief Creates an empty hashset. Does not allocate any data yet.
+  explicit nsSwissHashSetBase(nsAllocator* pAllocator); // [tested]
+
+  /// \brief Creates a copy of the given hashset.
+  nsSwissHashSetBase(const nsSwissHashSetBase<KeyType, Hasher>& rhs, nsAllocator* pAllocator); // [tested]
+
+  /// \brief Moves data from an existing hashtable into this one.
+  nsSwissHashSetBase(nsSwissHashSetBase<KeyType, Hasher>&& rhs, nsAllocator* pAllocator); // [tested]
+
+  /// \brief Destructor.
+  ~nsSwissHashSetBase(); // [tested]
+
+  /// \brief Copies the data from another hashset into this one.
+  void operator=(const nsSwissHashSetBase<KeyType, Hasher>& rhs); // [tested]
+
+  /// \brief Moves data from an existing hashset into this one.
+  void operator=(nsSwissHashSetBase<KeyType, Hasher>&& rhs); // [tested]
+
+public:
+  /// \brief Compares this table to another table.
+  bool operator==(const nsSwissHashSetBase<KeyType, Hasher>& rhs) const; // [tested]
+  NS_ADD_DEFAULT_OPERATOR_NOTEQUAL(const nsSwissHashSetBase<KeyType, Hasher>&);
+
+  /// \brief Expands the hashset so that the given number of entries can be inserted without growing it again.
+  void Reserve(nsUInt32 uiCapacity); // [tested]
+
+  /// \brief Tries to compact the hashset to avoid wasting memory.
+  ///
+  /// The resulting capacity is at least 'GetCount' (no elements get removed).
+  /// Will deallocate all data, if the hashset is empty.
+  void Compact(); // [tested]
+
+  /// \brief Returns the number of active entries in the table.
+  nsUInt32 GetCount() const; // [tested]
+
+  /// \brief Returns true, if the hashset does not contain any elements.
+  bool IsEmpty() const; // [tested]
+
+  /// \brief Clears the table.
+  void Clear(); // [tested]
+
+  /// \brief Inserts the key. Returns whether the key was already existing.
+  template <typename CompatibleKeyType>
+  bool Insert(CompatibleKeyType&& key); // [tested]
+
+  /// \brief Removes the entry with the given key. Returns if an entry was removed.
+  template <typename CompatibleKeyType>
+  bool Remove(const CompatibleKeyType& key); // [tested]
+
+  /// \brief Erases the key at the given Iterator. Returns an iterator to the element after the given iterator.
+  ConstIterator Remove(const ConstIterator& pos); // [tested]
+
+  /// \brief Returns if an entry with given key exists in the table.
+  template <typename CompatibleKeyType>
+  bool Contains(const CompatibleKeyType& key) const; // [tested]
+
+  /// \brief Checks whether all keys of the given set are in the container.
+  bool ContainsSet(const nsSwissHashSetBase<KeyType, Hasher>& operand) const; // [tested]
+
+  /// \brief Makes this set the union of itself and the operand.
+  void Union(const nsSwissHashSetBase<KeyType, Hasher>& operand); // [tested]
+
+  /// \brief Makes this set the difference of itself and the operand, i.e. subtracts operand.
+  void Difference(const nsSwissHashSetBase<KeyType, Hasher>& operand); // [tested]
+
+  /// \brief Makes this set the intersection of itself and the operand.
+  void Intersection(const nsSwissHashSetBase<KeyType, Hasher>& operand); // [tested]
+
+  /// \brief Returns a constant Iterator to the very first element.
+  ConstIterator GetIterator() const; // [tested]
+
+  /// \brief Returns a constant Iterator to the first element that is not part of the hashset. Needed to implement range based for loop
+  /// support.
+  ConstIterator GetEndIterator() const;
+
+  /// \brief Returns the allocator that is used by this instance.
+  nsAllocator* GetAllocator() const;
+
+  /// \brief Returns the amount of bytes that are currently allocated on the heap.
+  nsUInt64 GetHeapMemoryUsage() const; // [tested]
+
+  /// \brief Swaps this map with the other one.
+  void Swap(nsSwissHashSetBase<KeyType, Hasher>& other); // [tested]
+
+  /// \brief Searches for key, returns a ConstIterator to it or an invalid iterator, if no such key is found. O(1) operation.
+  template <typename CompatibleKeyType>
+  ConstIterator Find(const CompatibleKeyType& key) const;
+
+private:
+  using Control = nsInternal::nsSwissTable;
+
+  // the control bytes are stored in the same allocation, right after the entries
+  KeyType* m_pEntries = nullptr;
+  nsUInt8* m_pControl = nullptr;
+
+  nsUInt32 m_uiCount = 0;
+  nsUInt32 m_uiCapacity = 0;
+
+  // how many more entries can be inserted into empty slots before the table has to be rehashed, deleted slots don't count
+  nsUInt32 m_uiGrowthLeft = 0;
+
+  nsAllocator* m_pAllocator = nullptr;
+
+  void SetCapacity(nsUInt32 uiCapacity);
+  void DeallocateStorage();
+
+  /// \brief Returns the index of a free slot for a new entry with the given hash and marks it as used. Grows the table, if necessary.
+  nsUInt32 PrepareInsert(nsUInt32 uiMixedHash);
+
+  void RemoveInternal(nsUInt32 uiIndex);
+
+  template <typename CompatibleKeyType>
+  nsUInt32 FindEntry(const CompatibleKeyType& key) const;
+
+  template <typename CompatibleKeyType>
+  nsUInt32 FindEntry(nsUInt32 uiMixedHash, const CompatibleKeyType& key) const;
+};
+
+/// \brief \see nsSwissHashSetBase
+template <typename KeyType, typename Hasher = nsHashHelper<KeyType>, typename AllocatorWrapper = nsDefaultAllocatorWrapper>
+class nsSwissHashSet : public nsSwissHashSetBase<KeyType, Hasher>
+{
+public:
+  NS_DECLARE_MEM_RELOCATABLE_TYPE();
+
+  nsSwissHashSet();
+  explicit nsSwissHashSet(nsAllocator* pAllocator);
+
+  nsSwissHashSet(const nsSwissHashSet<KeyType, Hasher, AllocatorWrapper>& other);
+  nsSwissHashSet(const nsSwissHashSetBase<KeyType, Hasher>& other);
+
+  nsSwissHashSet(nsSwissHashSet<KeyType, Hasher, AllocatorWrapper>&& other);
+  nsSwissHashSet(nsSwissHashSetBase<KeyType, Hasher>&& other);
+
+  void operator=(const nsSwissHashSet<KeyType, Hasher, AllocatorWrapper>& rhs);
+  void operator=(const nsSwissHashSetBase<KeyType, Hasher>& rhs);
+
+  void operator=(nsSwissHashSet<KeyType, Hasher, AllocatorWrapper>&& rhs);
+  void operator=(nsSwissHashSetBase<KeyType, Hasher>&& rhs);
+};
+
+template <typename KeyType, typename Hasher>
+typename nsSwissHashSetBase<KeyType, Hasher>::ConstIterator begin(const nsSwissHashSetBase<KeyType, Hasher>& set)
+{
+  return set.GetIterator();
+}
+
+template <typename KeyType, typename Hasher>
+typename nsSwissHashSetBase<KeyType, Hasher>::ConstIterator cbegin(const nsSwissHashSetBase<KeyType, Hasher>& set)
+{
+  return set.GetIterator();
+}
+
+template <typename KeyType, typename Hasher>
+typename nsSwissHashSetBase<KeyType, Hasher>::ConstIterator end(const nsSwissHashSetBase<KeyType, Hasher>& set)
+{
+  return set.GetEndIterator();
+}
+
+template <typename KeyType, typename Hasher>
+typename nsSwissHashSetBase<KeyType, Hasher>::ConstIterator cend(const nsSwissHashSetBase<KeyType, Hasher>& set)
+{
+  return set.GetEndIterator();
+}
+
+#include <Foundation/Containers/Implementation/SwissHashSet_inl.h>
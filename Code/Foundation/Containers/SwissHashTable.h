@@ -0,0 +1,388 @@
+#pragma once
+
+#include <Foundation/Algorithm/HashingUtils.h>
+#include <Foundation/Containers/Implementation/SwissTableGroup.h>
+#include <Foundation/Math/Math.h>
+#include <Foundation/Memory/AllocatorWrapper.h>
+
+template <typename KeyType, typename ValueType, typename Hasher>
+class nsSwissHashTableBase;
+
+/// \brief Const iterator.
+template <typename KeyType, typename ValueType, typename Hasher>
+struct nsSwissHashTableBaseConstIterator
+{
+  using iterator_category = std::forward_iterator_tag;
+  using value_type = nsSwissHashTableBaseConstIterator;
+  using difference_type = std::ptrdiff_t;
+  using pointer = nsSwissHashTableBaseConstIterator*;
+  using reference = nsSwissHashTableBaseConstIterator&;
+
+  NS_DECLARE_POD_TYPE();
+
+  nsSwissHashTableBaseConstIterator() = default;
+
+  /// \brief Checks whether this iterator points to a valid element.
+  bool IsValid() const; // [tested]
+
+  /// \brief Checks whether the two iterators point to the same element.
+  bool operator==(const nsSwissHashTableBaseConstIterator& rhs) const;
+  NS_ADD_DEFAULT_OPERATOR_NOTEQUAL(const nsSwissHashTableBaseConstIterator&);
+
+  /// \brief Returns the 'key' of the element that this iterator points to.
+  const KeyType& Key() const; // [tested]
+
+  /// \brief Returns the 'value' of the element that this iterator points to.
+  const ValueType& Value() const; // [tested]
+
+  /// \brief Advances the iterator to the next element in the map. The iterator will not be valid anymore, if the end is reached.
+  void Next(); // [tested]
+
+  /// \brief Shorthand for 'Next'
+  void operator++(); // [tested]
+
+  /// \brief Returns '*this' to enable foreach
+  NS_ALWAYS_INLINE nsSwissHashTableBaseConstIterator& operator*() { return *this; } // [tested]
+
+protected:
+  friend class nsSwissHashTableBase<KeyType, ValueType, Hasher>;
+
+  explicit nsSwissHashTableBaseConstIterator(const nsSwissHashTableBase<KeyType, ValueType, Hasher>& hashTable);
+  void SetToBegin();
+  void SetToEnd();
+
+  const nsSwissHashTableBase<KeyType, ValueType, Hasher>* m_pHashTable = nullptr;
+  nsUInt32 m_uiCurrentIndex = 0; // current element index that this iterator points to.
+
+#if NS_ENABLED(NS_USE_CPP20_OPERATORS)
+public:
+  struct Pointer
+  {
+    std::pair<const KeyType&, const ValueType&> value;
+    const std::pair<const KeyType&, const ValueType&>* operator->() const { return &value; }
+  };
+
+  NS_ALWAYS_INLINE Pointer operator->() const
+  {
+    return Pointer{.value = {Key(), Value()}};
+  }
+
+  // These function is used to return the values for structured bindings.
+  // The number and type of type of each slot are defined in the inl file.
+  template <std::size_t Index>
+  std::tuple_element_t<Index, nsSwissHashTableBaseConstIterator>& get() const
+  {
+    if constexpr (Index == 0)
+      return Key();
+    if constexpr (Index == 1)
+      return Value();
+  }
+#endif
+};
+
+/// \brief Iterator with write access.
+template <typename KeyType, typename ValueType, typename Hasher>
+struct nsSwissHashTableBaseIterator : public nsSwissHashTableBaseConstIterator<KeyType, ValueType, Hasher>
+{
+  NS_DECLARE_POD_TYPE();
+
+  /// \brief Creates a new iterator from another.
+  NS_ALWAYS_INLINE nsSwissHashTableBaseIterator(const nsSwissHashTableBaseIterator& rhs); // [tested]
+
+  /// \brief Assigns one iterator no another.
+  NS_ALWAYS_INLINE void operator=(const nsSwissHashTableBaseIterator& rhs); // [tested]
+
+  // this is required to pull in the const version of this function
+  using nsSwissHashTableBaseConstIterator<KeyType, ValueType, Hasher>::Value;
+
+  /// \brief Returns the 'value' of the element that this iterator points to.
+  NS_FORCE_INLINE ValueType& Value(); // [tested]
+
+  /// \brief Returns the 'value' of the element that this iterator points to.
+  NS_FORCE_INLINE ValueType& Value() const;
+
+  /// \brief Returns '*this' to enable foreach
+  NS_ALWAYS_INLINE nsSwissHashTableBaseIterator& operator*() { return *this; } // [tested]
+
+private:
+  friend class nsSwissHashTableBase<KeyType, ValueType, Hasher>;
+
+  explicit nsSwissHashTableBaseIterator(const nsSwissHashTableBase<KeyType, ValueType, Hasher>& hashTable);
+
+#if NS_ENABLED(NS_USE_CPP20_OPERATORS)
+public:
+  struct Pointer
+  {
+    std::pair<const KeyType&, ValueType&> value;
+    const std::pair<const KeyType&, ValueType&>* operator->() const { return &value; }
+  };
+
+  NS_ALWAYS_INLINE Pointer operator->() const
+  {
+    return Pointer{.value = {nsSwissHashTableBaseConstIterator<KeyType, ValueType, Hasher>::Key(), Value()}};
+  }
+
+  // These functions are used to return the values for structured bindings.
+  // The number and type of type of each slot are defined in the inl file.
+  template <std::size_t Index>
+  std::tuple_element_t<Index, nsSwissHashTableBaseIterator>& get()
+  {
+    if constexpr (Index == 0)
+      return nsSwissHashTableBaseConstIterator<KeyType, ValueType, Hasher>::Key();
+    if constexpr (Index == 1)
+      return Value();
+  }
+
+  template <std::size_t Index>
+  std::tuple_element_t<Index, nsSwissHashTableBaseIterator>& get() const
+  {
+    if constexpr (Index == 0)
+      return nsSwissHashTableBaseConstIterator<KeyType, ValueType, Hasher>::Key();
+    if constexpr (Index == 1)
+      return Value();
+  }
+#endif
+};
+
+/// \brief Implementation of a hashtable which stores key/value pairs, with the same interface as nsHashTableBase.
+///
+/// The entries are stored in one array and every entry has a one byte 'control' value in a second array, which is either
+/// 'empty', 'deleted' or 7 bits of the hash of the key. A lookup compares 16 control bytes at once with SSE2 or NEON,
+/// so keys are only compared for entries whose 7 bits of the hash match, and the search stops at the first group that
+/// has an empty entry. Removed entries are reused by the next insertion on the same probe sequence, and become empty
+/// right away if no lookup could ever have passed them. Thus, lookups stay fast with many removals and a maximum load
+/// of 87.5%.
+///
+/// nsSwissHashTable can replace nsHashTable with a typedef. Unlike nsHashTable, it does not use the hash directly but scrambles
+/// it once more, so a Hasher with a weak hash function is fine.
+///
+/// \see nsHashTableBase, nsSwissHashSetBase
+template <typename KeyType, typename ValueType, typename Hasher>
+class nsSwissHashTableBase
+{
+public:
+  using Iterator = nsSwissHashTableBaseIterator<KeyType, ValueType, Hasher>;
+  using ConstIterator = nsSwissHashTableBaseConstIterator<KeyType, ValueType, Hasher>;
+
+protected:
+  /// \brief Creates an empty hashtable. Does not allocate any data yet.
+  explicit nsSwissHashTableBase(nsAllocator* pAllocator); // [tested]
+
+  /// \brief Creates a copy of the given hashtable.
+  nsSwissHashTableBase(const nsSwissHashTableBase<KeyType, ValueType, Hasher>& rhs, nsAllocator* pAllocator); // [tested]
+
+  /// \brief Moves data from an existing hashtable into this one.
+  nsSwissHashTableBase(nsSwissHashTableBase<KeyType, ValueType, Hasher>&& rhs, nsAllocator* pAllocator); // [tested]
+
+  /// \brief Destructor.
+  ~nsSwissHashTableBase(); // [tested]
+
+  /// \brief Copies the data from another hashtable into this one.
+  void operator=(const nsSwissHashTableBase<KeyType, ValueType, Hasher>& rhs); // [tested]
+
+  /// \brief Moves data from an existing hashtable into this one.
+  void operator=(nsSwissHashTableBase<KeyType, ValueType, Hasher>&& rhs); // [tested]
+
+public:
+  /// \brief Compares this table to another table.
+  bool operator==(const nsSwissHashTableBase<KeyType, ValueType, Hasher>& rhs) const; // [tested]
+  NS_ADD_DEFAULT_OPERATOR_NOTEQUAL(const nsSwissHashTableBase<KeyType, ValueType, Hasher>&);
+
+  /// \brief Expands the hashtable so that the given number of entries can be inserted without growing it again.
+  void Reserve(nsUInt32 uiCapacity); // [tested]
+
+  /// \brief Tries to compact the hashtable to avoid wasting memory.
+  ///
+  /// The resulting capacity is at least 'GetCount' (no elements get removed).
+  /// Will deallocate all data, if the hashtable is empty.
+  void Compact(); // [tested]
+
+  /// \brief Returns the number of active entries in the table.
+  nsUInt32 GetCount() const; // [tested]
+
+  /// \brief Returns true, if the hashtable does not contain any elements.
+  bool IsEmpty() const; // [tested]
+
+  /// \brief Clears the table.
+  void Clear(); // [tested]
+
+  /// \brief Inserts the key value pair or replaces value if an entry with the given key already exists.
+  ///
+  /// Returns true if an existing value was replaced and optionally writes out the old value to out_oldValue.
+  template <typename CompatibleKeyType, typename CompatibleValueType>
+  bool Insert(CompatibleKeyType&& key, CompatibleValueType&& value, ValueType* out_pOldValue = nullptr); // [tested]
+
+  /// \brief Removes the entry with the given key. Returns whether an entry was removed and optionally writes out the old value to out_oldValue.
+  template <typename CompatibleKeyType>
+  bool Remove(const CompatibleKeyType& key, ValueType* out_pOldValue = nullptr); // [tested]
+
+  /// \brief Erases the key/value pair at the given Iterator. Returns an iterator to the element after the given iterator.
+  Iterator Remove(const Iterator& pos); // [tested]
+
+  /// \brief Cannot remove an element with just a nsSwissHashTableBaseConstIterator
+  void Remove(const ConstIterator& pos) = delete;
+
+  /// \brief Returns whether an entry with the given key was found and if found writes out the corresponding value to out_value.
+  template <typename CompatibleKeyType>
+  bool TryGetValue(const CompatibleKeyType& key, ValueType& out_value) const; // [tested]
+
+  /// \brief Returns whether an entry with the given key was found and if found writes out the pointer to the corresponding value to out_pValue.
+  template <typename CompatibleKeyType>
+  bool TryGetValue(const CompatibleKeyType& key, const ValueType*& out_pValue) const; // [tested]
+
+  /// \brief Returns whether an entry with the given key was found and if found writes out the pointer to the corresponding value to out_pValue.
+  template <typename CompatibleKeyType>
+  bool TryGetValue(const CompatibleKeyType& key, ValueType*& out_pValue) const; // [tested]
+
+  /// \brief Searches for key, returns a ConstIterator to it or an invalid iterator, if no such key is found. O(1) operation.
+  template <typename CompatibleKeyType>
+  ConstIterator Find(const CompatibleKeyType& key) const;
+
+  /// \brief Searches for key, returns an Iterator to it or an invalid iterator, if no such key is found. O(1) operation.
+  template <typename CompatibleKeyType>
+  Iterator Find(const CompatibleKeyType& key);
+
+  /// \brief Returns a pointer to the value of the entry with the given key if found, otherwise returns nullptr.
+  template <typename CompatibleKeyType>
+  const ValueType* GetValue(const CompatibleKeyType& key) const; // [tested]
+
+  /// \brief Returns a pointer to the value of the entry with the given key if found, otherwise returns nullptr.
+  template <typename CompatibleKeyType>
+  ValueType* GetValue(const CompatibleKeyType& key); // [tested]
+
+  /// \brief Returns the value to the given key if found or creates a new entry with the given key and a default constructed value.
+  ValueType& operator[](const KeyType& key); // [tested]
+
+  /// \brief Returns the value stored at the given key. If none exists, one is created. \a bExisted indicates whether an element needed to be created.
+  ValueType& FindOrAdd(const KeyType& key, bool* out_pExisted = nullptr); // [tested]
+
+  /// \brief Returns if an entry with given key exists in the table.
+  template <typename CompatibleKeyType>
+  bool Contains(const CompatibleKeyType& key) const; // [tested]
+
+  /// \brief Returns an Iterator to the very first element.
+  Iterator GetIterator(); // [tested]
+
+  /// \brief Returns an Iterator to the first element that is not part of the hash-table. Needed to support range based for loops.
+  Iterator GetEndIterator(); // [tested]
+
+  /// \brief Returns a constant Iterator to the very first element.
+  ConstIterator GetIterator() const; // [tested]
+
+  /// \brief Returns a ConstIterator to the first element that is not part of the hash-table. Needed to support range based for loops.
+  ConstIterator GetEndIterator() const; // [tested]
+
+  /// \brief Returns the allocator that is used by this instance.
+  nsAllocator* GetAllocator() const;
+
+  /// \brief Returns the amount of bytes that are currently allocated on the heap.
+  nsUInt64 GetHeapMemoryUsage() const; // [tested]
+
+  /// \brief Swaps this map with the other one.
+  void Swap(nsSwissHashTableBase<KeyType, ValueType, Hasher>& other); // [tested]
+
+private:
+  friend struct nsSwissHashTableBaseConstIterator<KeyType, ValueType, Hasher>;
+  friend struct nsSwissHashTableBaseIterator<KeyType, ValueType, Hasher>;
+
+  using Control = nsInternal::nsSwissTable;
+
+  struct Entry
+  {
+    KeyType key;
+    ValueType value;
+  };
+
+  // the control bytes are stored in the same allocation, right after the entries
+  Entry* m_pEntries = nullptr;
+  nsUInt8* m_pControl = nullptr;
+
+  nsUInt32 m_uiCount = 0;
+  nsUInt32 m_uiCapacity = 0;
+
+  // how many more entries can be inserted into empty slots before the table has to be rehashed, deleted slots don't count
+  nsUInt32 m_uiGrowthLeft = 0;
+
+  nsAllocator* m_pAllocator = nullptr;
+
+  void SetCapacity(nsUInt32 uiCapacity);
+  void DeallocateStorage();
+
+  /// \brief Returns the index of a free slot for a new entry with the given hash and marks it as used. Grows the table, if necessary.
+  nsUInt32 PrepareInsert(nsUInt32 uiMixedHash);
+
+  void RemoveInternal(nsUInt32 uiIndex);
+
+  template <typename CompatibleKeyType>
+  nsUInt32 FindEntry(const CompatibleKeyType& key) const;
+
+  template <typename CompatibleKeyType>
+  nsUInt32 FindEntry(nsUInt32 uiMixedHash, const CompatibleKeyType& key) const;
+
+  bool IsValidEntry(nsUInt32 uiEntryIndex) const;
+};
+
+/// \brief \see nsSwissHashTableBase
+template <typename KeyType, typename ValueType, typename Hasher = nsHashHelper<KeyType>, typename AllocatorWrapper = nsDefaultAllocatorWrapper>
+class nsSwissHashTable : public nsSwissHashTableBase<KeyType, ValueType, Hasher>
+{
+public:
+  NS_DECLARE_MEM_RELOCATABLE_TYPE();
+
+  nsSwissHashTable();
+  explicit nsSwissHashTable(nsAllocator* pAllocator);
+
+  nsSwissHashTable(const nsSwissHashTable<KeyType, ValueType, Hasher, AllocatorWrapper>& other);
+  nsSwissHashTable(const nsSwissHashTableBase<KeyType, ValueType, Hasher>& other);
+
+  nsSwissHashTable(nsSwissHashTable<KeyType, ValueType, Hasher, AllocatorWrapper>&& other);
+  nsSwissHashTable(nsSwissHashTableBase<KeyType, ValueType, Hasher>&& other);
+
+
+  void operator=(const nsSwissHashTable<KeyType, ValueType, Hasher, AllocatorWrapper>& rhs);
+  void operator=(const nsSwissHashTableBase<KeyType, ValueType, Hasher>& rhs);
+
+  void operator=(nsSwissHashTable<KeyType, ValueType, Hasher, AllocatorWrapper>&& rhs);
+  void operator=(nsSwissHashTableBase<KeyType, ValueType, Hasher>&& rhs);
+};
+
+//////////////////////////////////////////////////////////////////////////
+// begin() /end() for range-based for-loop support
+
+template <typename KeyType, typename ValueType, typename Hasher>
+typename nsSwissHashTableBase<KeyType, ValueType, Hasher>::Iterator begin(nsSwissHashTableBase<KeyType, ValueType, Hasher>& ref_container)
+{
+  return ref_container.GetIterator();
+}
+
+template <typename KeyType, typename ValueType, typename Hasher>
+typename nsSwissHashTableBase<KeyType, ValueType, Hasher>::ConstIterator begin(const nsSwissHashTableBase<KeyType, ValueType, Hasher>& container)
+{
+  return container.GetIterator();
+}
+
+template <typename KeyType, typename ValueType, typename Hasher>
+typename nsSwissHashTableBase<KeyType, ValueType, Hasher>::ConstIterator cbegin(const nsSwissHashTableBase<KeyType, ValueType, Hasher>& container)
+{
+  return container.GetIterator();
+}
+
+template <typename KeyType, typename ValueType, typename Hasher>
+typename nsSwissHashTableBase<KeyType, ValueType, Hasher>::Iterator end(nsSwissHashTableBase<KeyType, ValueType, Hasher>& ref_container)
+{
+  return ref_container.GetEndIterator();
+}
+
+template <typename KeyType, typename ValueType, typename Hasher>
+typename nsSwissHashTableBase<KeyType, ValueType, Hasher>::ConstIterator end(const nsSwissHashTableBase<KeyType, ValueType, Hasher>& container)
+{
+  return container.GetEndIterator();
+}
+
+template <typename KeyType, typename ValueType, typename Hasher>
+typename nsSwissHashTableBase<KeyType, ValueType, Hasher>::ConstIterator cend(const nsSwissHashTableBase<KeyType, ValueType, Hasher>& container)
+{
+  return container.GetEndIterator();
+}
+
+#include <Foundation/Containers/Implementation/SwissHashTable_inl.h>
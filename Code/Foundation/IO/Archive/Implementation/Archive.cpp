@@ -117,7 +117,7 @@ struct nsHashHelper<nsOldTempHashedString>
 
 nsResult nsArchiveTOC::Deserialize(nsStreamReader& inout_stream, nsUInt8 uiArchiveVersion)
 {
-  NS_ASSERT_ALWAYS(uiArchiveVersion <= 4, "Unsupported archive version {}", uiArchiveVersion);
+  NS_ASSERT_ALWAYS(uiArchiveVersion <= 5, "Unsupported archive version {}", uiArchiveVersion);
 
   // we don't use the TOC version anymore, but the archive version instead
   const nsTypeVersion version = inout_stream.ReadVersion(2);
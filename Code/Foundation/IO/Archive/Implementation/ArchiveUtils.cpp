@@ -40,11 +40,16 @@ nsResult nsArchiveUtils::WriteHeader(nsStreamWriter& inout_stream)
   const char* szTag = "EZARCHIVE";
   NS_SUCCEED_OR_RETURN(inout_stream.WriteBytes(szTag, 10));
 
-  const nsUInt8 uiArchiveVersion = 4;
-
   // Version 2: Added end-of-file marker for file corruption (cutoff) detection
   // Version 3: HashedStrings changed from MurmurHash to xxHash
   // Version 4: use 64 Bit string hashes
+  // Version 5: the TOC hash uses XXH3 (nsHashStreamWriter64 with NS_HASHING_VERSION 2)
+#if NS_HASHING_VERSION >= 2
+  const nsUInt8 uiArchiveVersion = 5;
+#else
+  const nsUInt8 uiArchiveVersion = 4;
+#endif
+
   inout_stream << uiArchiveVersion;
 
   const nsUInt8 uiPadding[5] = {0, 0, 0, 0, 0};
@@ -67,7 +72,7 @@ nsResult nsArchiveUtils::ReadHeader(nsStreamReader& inout_stream, nsUInt8& out_u
   out_uiVersion = 0;
   inout_stream >> out_uiVersion;
 
-  if (out_uiVersion != 1 && out_uiVersion != 2 && out_uiVersion != 3 && out_uiVersion != 4)
+  if (out_uiVersion < 1 || out_uiVersion > 5)
   {
     nsLog::Error("Unsupported archive version '{}'.", out_uiVersion);
     return NS_FAILURE;
@@ -457,7 +462,7 @@ nsResult nsArchiveUtils::ExtractTOC(nsUInt64 uiArchiveEndingDataSize, const void
   // validate the TOC hash
   if (uiArchiveVersion >= 2)
   {
-    const nsUInt64 uiActualTocHash = nsHashingUtils::xxHash64(pTocStart, tocMeta.m_uiTocSize);
+    const nsUInt64 uiActualTocHash = uiArchiveVersion >= 5 ? nsHashingUtils::xxHash3_64(pTocStart, tocMeta.m_uiTocSize) : nsHashingUtils::xxHash64(pTocStart, tocMeta.m_uiTocSize);
     if (tocMeta.m_uiExpectedTocHash != uiActualTocHash)
     {
       nsLog::Error("Archive TOC is corrupted. Hashes do not match.");
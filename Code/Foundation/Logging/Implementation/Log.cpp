@@ -314,10 +314,8 @@ nsLogMsgType::Enum nsLog::GetDefaultLogLevel()
   return s_DefaultLogLevel;
 }
 
-#define LOG_LEVEL_FILTER(MaxLevel)                                                                                                  \
-  if (pInterface == nullptr)                                                                                                        \
-    return;                                                                                                                         \
-  if ((pInterface->GetLogLevel() == nsLogMsgType::GlobalDefault ? nsLog::s_DefaultLogLevel : pInterface->GetLogLevel()) < MaxLevel) \
+#define LOG_LEVEL_FILTER(MaxLevel)              \
+  if (!IsLogLevelEnabled(MaxLevel, pInterface)) \
     return;
 
 
@@ -181,6 +181,19 @@ public:
   /// \brief Returns the currently set default log level.
   static nsLogMsgType::Enum GetDefaultLogLevel();
 
+  /// \brief Returns whether pInterface passes on messages of the given type, or filters them out because of its log level.
+  ///
+  /// The logging functions check this before they format a message. Call it directly only to skip expensive work that is
+  /// done just to prepare a log message.
+  NS_ALWAYS_INLINE static bool IsLogLevelEnabled(nsLogMsgType::Enum type, nsLogInterface* pInterface = GetThreadLocalLogSystem())
+  {
+    if (pInterface == nullptr)
+      return false;
+
+    const nsLogMsgType::Enum logLevel = pInterface->m_LogLevel == nsLogMsgType::GlobalDefault ? s_DefaultLogLevel : pInterface->m_LogLevel;
+    return logLevel >= type;
+  }
+
   /// \brief An error that needs to be fixed as soon as possible.
   static void Error(nsLogInterface* pInterface, const nsFormatString& string);
 
@@ -188,14 +201,38 @@ public:
   template <typename... ARGS>
   static void Error(nsStringView sFormat, ARGS&&... args)
   {
-    Error(GetThreadLocalLogSystem(), nsFormatStringImpl<ARGS...>(sFormat, std::forward<ARGS>(args)...));
+    nsLogInterface* pInterface = GetThreadLocalLogSystem();
+    if (IsLogLevelEnabled(nsLogMsgType::ErrorMsg, pInterface))
+    {
+      Error(pInterface, nsFormatStringImpl<ARGS...>(sFormat, std::forward<ARGS>(args)...));
+    }
   }
 
   /// \brief Overload of Error() to output messages to a specific log.
   template <typename... ARGS>
   static void Error(nsLogInterface* pInterface, nsStringView sFormat, ARGS&&... args)
   {
-    Error(pInterface, nsFormatStringImpl<ARGS...>(sFormat, std::forward<ARGS>(args)...));
+    if (IsLogLevelEnabled(nsLogMsgType::ErrorMsg, pInterface))
+    {
+      Error(pInterface, nsFormatStringImpl<ARGS...>(sFormat, std::forward<ARGS>(args)...));
+    }
+  }
+
+  /// \brief Overload of Error() for format strings that are parsed at compile time, see NS_FMT.
+  template <typename FORMAT, typename... ARGS>
+  static void Error(nsFormatStringLiteral<FORMAT> format, ARGS&&... args)
+  {
+    Error(GetThreadLocalLogSystem(), format, std::forward<ARGS>(args)...);
+  }
+
+  /// \brief Overload of Error() for format strings that are parsed at compile time, to output messages to a specific log.
+  template <typename FORMAT, typename... ARGS>
+  static void Error(nsLogInterface* pInterface, nsFormatStringLiteral<FORMAT>, ARGS&&... args)
+  {
+    if (IsLogLevelEnabled(nsLogMsgType::ErrorMsg, pInterface))
+    {
+      Error(pInterface, nsFormatStringLiteralImpl<FORMAT, ARGS...>(std::forward<ARGS>(args)...));
+    }
   }
 
   /// \brief Not an error, but definitely a big problem, that should be looked into very soon.
@@ -205,14 +242,38 @@ public:
   template <typename... ARGS>
   static void SeriousWarning(nsStringView sFormat, ARGS&&... args)
   {
-    SeriousWarning(GetThreadLocalLogSystem(), nsFormatStringImpl<ARGS...>(sFormat, std::forward<ARGS>(args)...));
+    nsLogInterface* pInterface = GetThreadLocalLogSystem();
+    if (IsLogLevelEnabled(nsLogMsgType::SeriousWarningMsg, pInterface))
+    {
+      SeriousWarning(pInterface, nsFormatStringImpl<ARGS...>(sFormat, std::forward<ARGS>(args)...));
+    }
   }
 
   /// \brief Overload of SeriousWarning() to output messages to a specific log.
   template <typename... ARGS>
   static void SeriousWarning(nsLogInterface* pInterface, nsStringView sFormat, ARGS&&... args)
   {
-    SeriousWarning(pInterface, nsFormatStringImpl<ARGS...>(sFormat, std::forward<ARGS>(args)...));
+    if (IsLogLevelEnabled(nsLogMsgType::SeriousWarningMsg, pInterface))
+    {
+      SeriousWarning(pInterface, nsFormatStringImpl<ARGS...>(sFormat, std::forward<ARGS>(args)...));
+    }
+  }
+
+  /// \brief Overload of SeriousWarning() for format strings that are parsed at compile time, see NS_FMT.
+  template <typename FORMAT, typename... ARGS>
+  static void SeriousWarning(nsFormatStringLiteral<FORMAT> format, ARGS&&... args)
+  {
+    SeriousWarning(GetThreadLocalLogSystem(), format, std::forward<ARGS>(args)...);
+  }
+
+  /// \brief Overload of SeriousWarning() for format strings that are parsed at compile time, to output messages to a specific log.
+  template <typename FORMAT, typename... ARGS>
+  static void SeriousWarning(nsLogInterface* pInterface, nsFormatStringLiteral<FORMAT>, ARGS&&... args)
+  {
+    if (IsLogLevelEnabled(nsLogMsgType::SeriousWarningMsg, pInterface))
+    {
+      SeriousWarning(pInterface, nsFormatStringLiteralImpl<FORMAT, ARGS...>(std::forward<ARGS>(args)...));
+    }
   }
 
   /// \brief A potential problem or a performance warning. Might be possible to ignore it.
@@ -222,14 +283,38 @@ public:
   template <typename... ARGS>
   static void Warning(nsStringView sFormat, ARGS&&... args)
   {
-    Warning(GetThreadLocalLogSystem(), nsFormatStringImpl<ARGS...>(sFormat, std::forward<ARGS>(args)...));
+    nsLogInterface* pInterface = GetThreadLocalLogSystem();
+    if (IsLogLevelEnabled(nsLogMsgType::WarningMsg, pInterface))
+    {
+      Warning(pInterface, nsFormatStringImpl<ARGS...>(sFormat, std::forward<ARGS>(args)...));
+    }
   }
 
   /// \brief Overload of Warning() to output messages to a specific log.
   template <typename... ARGS>
   static void Warning(nsLogInterface* pInterface, nsStringView sFormat, ARGS&&... args)
   {
-    Warning(pInterface, nsFormatStringImpl<ARGS...>(sFormat, std::forward<ARGS>(args)...));
+    if (IsLogLevelEnabled(nsLogMsgType::WarningMsg, pInterface))
+    {
+      Warning(pInterface, nsFormatStringImpl<ARGS...>(sFormat, std::forward<ARGS>(args)...));
+    }
+  }
+
+  /// \brief Overload of Warning() for format strings that are parsed at compile time, see NS_FMT.
+  template <typename FORMAT, typename... ARGS>
+  static void Warning(nsFormatStringLiteral<FORMAT> format, ARGS&&... args)
+  {
+    Warning(GetThreadLocalLogSystem(), format, std::forward<ARGS>(args)...);
+  }
+
+  /// \brief Overload of Warning() for format strings that are parsed at compile time, to output messages to a specific log.
+  template <typename FORMAT, typename... ARGS>
+  static void Warning(nsLogInterface* pInterface, nsFormatStringLiteral<FORMAT>, ARGS&&... args)
+  {
+    if (IsLogLevelEnabled(nsLogMsgType::WarningMsg, pInterface))
+    {
+      Warning(pInterface, nsFormatStringLiteralImpl<FORMAT, ARGS...>(std::forward<ARGS>(args)...));
+    }
   }
 
   /// \brief Status information that something was completed successfully.
@@ -239,14 +324,38 @@ public:
   template <typename... ARGS>
   static void Success(nsStringView sFormat, ARGS&&... args)
   {
-    Success(GetThreadLocalLogSystem(), nsFormatStringImpl<ARGS...>(sFormat, std::forward<ARGS>(args)...));
+    nsLogInterface* pInterface = GetThreadLocalLogSystem();
+    if (IsLogLevelEnabled(nsLogMsgType::SuccessMsg, pInterface))
+    {
+      Success(pInterface, nsFormatStringImpl<ARGS...>(sFormat, std::forward<ARGS>(args)...));
+    }
   }
 
   /// \brief Overload of Success() to output messages to a specific log.
   template <typename... ARGS>
   static void Success(nsLogInterface* pInterface, nsStringView sFormat, ARGS&&... args)
   {
-    Success(pInterface, nsFormatStringImpl<ARGS...>(sFormat, std::forward<ARGS>(args)...));
+    if (IsLogLevelEnabled(nsLogMsgType::SuccessMsg, pInterface))
+    {
+      Success(pInterface, nsFormatStringImpl<ARGS...>(sFormat, std::forward<ARGS>(args)...));
+    }
+  }
+
+  /// \brief Overload of Success() for format strings that are parsed at compile time, see NS_FMT.
+  template <typename FORMAT, typename... ARGS>
+  static void Success(nsFormatStringLiteral<FORMAT> format, ARGS&&... args)
+  {
+    Success(GetThreadLocalLogSystem(), format, std::forward<ARGS>(args)...);
+  }
+
+  /// \brief Overload of Success() for format strings that are parsed at compile time, to output messages to a specific log.
+  template <typename FORMAT, typename... ARGS>
+  static void Success(nsLogInterface* pInterface, nsFormatStringLiteral<FORMAT>, ARGS&&... args)
+  {
+    if (IsLogLevelEnabled(nsLogMsgType::SuccessMsg, pInterface))
+    {
+      Success(pInterface, nsFormatStringLiteralImpl<FORMAT, ARGS...>(std::forward<ARGS>(args)...));
+    }
   }
 
   /// \brief Status information that is important.
@@ -256,14 +365,38 @@ public:
   template <typename... ARGS>
   static void Info(nsStringView sFormat, ARGS&&... args)
   {
-    Info(GetThreadLocalLogSystem(), nsFormatStringImpl<ARGS...>(sFormat, std::forward<ARGS>(args)...));
+    nsLogInterface* pInterface = GetThreadLocalLogSystem();
+    if (IsLogLevelEnabled(nsLogMsgType::InfoMsg, pInterface))
+    {
+      Info(pInterface, nsFormatStringImpl<ARGS...>(sFormat, std::forward<ARGS>(args)...));
+    }
   }
 
   /// \brief Overload of Info() to output messages to a specific log.
   template <typename... ARGS>
   static void Info(nsLogInterface* pInterface, nsStringView sFormat, ARGS&&... args)
   {
-    Info(pInterface, nsFormatStringImpl<ARGS...>(sFormat, std::forward<ARGS>(args)...));
+    if (IsLogLevelEnabled(nsLogMsgType::InfoMsg, pInterface))
+    {
+      Info(pInterface, nsFormatStringImpl<ARGS...>(sFormat, std::forward<ARGS>(args)...));
+    }
+  }
+
+  /// \brief Overload of Info() for format strings that are parsed at compile time, see NS_FMT.
+  template <typename FORMAT, typename... ARGS>
+  static void Info(nsFormatStringLiteral<FORMAT> format, ARGS&&... args)
+  {
+    Info(GetThreadLocalLogSystem(), format, std::forward<ARGS>(args)...);
+  }
+
+  /// \brief Overload of Info() for format strings that are parsed at compile time, to output messages to a specific log.
+  template <typename FORMAT, typename... ARGS>
+  static void Info(nsLogInterface* pInterface, nsFormatStringLiteral<FORMAT>, ARGS&&... args)
+  {
+    if (IsLogLevelEnabled(nsLogMsgType::InfoMsg, pInterface))
+    {
+      Info(pInterface, nsFormatStringLiteralImpl<FORMAT, ARGS...>(std::forward<ARGS>(args)...));
+    }
   }
 
   /// \brief Status information that is nice to have during development.
@@ -277,14 +410,38 @@ public:
   template <typename... ARGS>
   static void Dev(nsStringView sFormat, ARGS&&... args)
   {
-    Dev(GetThreadLocalLogSystem(), nsFormatStringImpl<ARGS...>(sFormat, std::forward<ARGS>(args)...));
+    nsLogInterface* pInterface = GetThreadLocalLogSystem();
+    if (IsLogLevelEnabled(nsLogMsgType::DevMsg, pInterface))
+    {
+      Dev(pInterface, nsFormatStringImpl<ARGS...>(sFormat, std::forward<ARGS>(args)...));
+    }
   }
 
   /// \brief Overload of Dev() to output messages to a specific log.
   template <typename... ARGS>
   static void Dev(nsLogInterface* pInterface, nsStringView sFormat, ARGS&&... args)
   {
-    Dev(pInterface, nsFormatStringImpl<ARGS...>(sFormat, std::forward<ARGS>(args)...));
+    if (IsLogLevelEnabled(nsLogMsgType::DevMsg, pInterface))
+    {
+      Dev(pInterface, nsFormatStringImpl<ARGS...>(sFormat, std::forward<ARGS>(args)...));
+    }
+  }
+
+  /// \brief Overload of Dev() for format strings that are parsed at compile time, see NS_FMT.
+  template <typename FORMAT, typename... ARGS>
+  static void Dev(nsFormatStringLiteral<FORMAT> format, ARGS&&... args)
+  {
+    Dev(GetThreadLocalLogSystem(), format, std::forward<ARGS>(args)...);
+  }
+
+  /// \brief Overload of Dev() for format strings that are parsed at compile time, to output messages to a specific log.
+  template <typename FORMAT, typename... ARGS>
+  static void Dev(nsLogInterface* pInterface, nsFormatStringLiteral<FORMAT>, ARGS&&... args)
+  {
+    if (IsLogLevelEnabled(nsLogMsgType::DevMsg, pInterface))
+    {
+      Dev(pInterface, nsFormatStringLiteralImpl<FORMAT, ARGS...>(std::forward<ARGS>(args)...));
+    }
   }
 
   /// \brief Status information during debugging. Very verbose. Usually only temporarily added to the code.
@@ -298,14 +455,38 @@ public:
   template <typename... ARGS>
   static void Debug(nsStringView sFormat, ARGS&&... args)
   {
-    Debug(GetThreadLocalLogSystem(), nsFormatStringImpl<ARGS...>(sFormat, std::forward<ARGS>(args)...));
+    nsLogInterface* pInterface = GetThreadLocalLogSystem();
+    if (IsLogLevelEnabled(nsLogMsgType::DebugMsg, pInterface))
+    {
+      Debug(pInterface, nsFormatStringImpl<ARGS...>(sFormat, std::forward<ARGS>(args)...));
+    }
   }
 
   /// \brief Overload of Debug() to output messages to a specific log.
   template <typename... ARGS>
   static void Debug(nsLogInterface* pInterface, nsStringView sFormat, ARGS&&... args)
   {
-    Debug(pInterface, nsFormatStringImpl<ARGS...>(sFormat, std::forward<ARGS>(args)...));
+    if (IsLogLevelEnabled(nsLogMsgType::DebugMsg, pInterface))
+    {
+      Debug(pInterface, nsFormatStringImpl<ARGS...>(sFormat, std::forward<ARGS>(args)...));
+    }
+  }
+
+  /// \brief Overload of Debug() for format strings that are parsed at compile time, see NS_FMT.
+  template <typename FORMAT, typename... ARGS>
+  static void Debug(nsFormatStringLiteral<FORMAT> format, ARGS&&... args)
+  {
+    Debug(GetThreadLocalLogSystem(), format, std::forward<ARGS>(args)...);
+  }
+
+  /// \brief Overload of Debug() for format strings that are parsed at compile time, to output messages to a specific log.
+  template <typename FORMAT, typename... ARGS>
+  static void Debug(nsLogInterface* pInterface, nsFormatStringLiteral<FORMAT>, ARGS&&... args)
+  {
+    if (IsLogLevelEnabled(nsLogMsgType::DebugMsg, pInterface))
+    {
+      Debug(pInterface, nsFormatStringLiteralImpl<FORMAT, ARGS...>(std::forward<ARGS>(args)...));
+    }
   }
 
   /// \brief Instructs log writers to flush their caches, to ensure all log output (even non-critical information) is written.
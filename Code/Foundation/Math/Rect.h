@@ -32,7 +32,7 @@ public:
   nsRectTemplate(Type width, Type height);
 
   /// \brief Initializes x and y from pos, width and height from vSize.
-  nsRectTemplate<Type>(const nsVec2Template<Type>& vTopLeftPosition, const nsVec2Template<Type>& vSize);
+  nsRectTemplate(const nsVec2Template<Type>& vTopLeftPosition, const nsVec2Template<Type>& vSize);
 
   /// \brief Creates an 'invalid' rect.
   ///
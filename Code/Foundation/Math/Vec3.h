@@ -20,13 +20,13 @@ public:
   // *** Constructors ***
 public:
   /// \brief default-constructed vector is uninitialized (for speed)
-  nsVec3Template<Type>(); // [tested]
+  nsVec3Template(); // [tested]
 
   /// \brief Initializes the vector with x,y,z
-  nsVec3Template<Type>(Type x, Type y, Type z); // [tested]
+  nsVec3Template(Type x, Type y, Type z); // [tested]
 
   /// \brief Initializes all 3 components with xyz
-  explicit nsVec3Template<Type>(Type v); // [tested]
+  explicit nsVec3Template(Type v); // [tested]
 
   // no copy-constructor and operator= since the default-generated ones will be faster
 
@@ -8,7 +8,9 @@
 #include <Foundation/Memory/Policies/AllocPolicyAlignedHeap.h>
 #include <Foundation/Memory/Policies/AllocPolicyGuarding.h>
 #include <Foundation/Memory/Policies/AllocPolicyHeap.h>
+#include <Foundation/Memory/Policies/AllocPolicyPool.h>
 #include <Foundation/Memory/Policies/AllocPolicyProxy.h>
+#include <Foundation/Memory/Policies/AllocPolicySizeClassHeap.h>
 
 
 /// \brief Default heap allocator
@@ -17,6 +19,18 @@ using nsAlignedHeapAllocator = nsAllocatorWithPolicy<nsAllocPolicyAlignedHeap>;
 /// \brief Default heap allocator
 using nsHeapAllocator = nsAllocatorWithPolicy<nsAllocPolicyHeap>;
 
+/// \brief Heap allocator with thread local caches for small allocations, see nsAllocPolicySizeClassHeap
+using nsSizeClassHeapAllocator = nsAllocatorWithPolicy<nsAllocPolicySizeClassHeap>;
+
+/// \brief Allocator for many objects of the same size, with thread local magazines and lock-free global free lists, see nsAllocPolicyPool
+using nsPoolAllocator = nsAllocatorWithPolicy<nsAllocPolicyPool>;
+
+/// \brief Allocator wrapper for containers with many small nodes, like nsMap, nsSet or nsList. All of them share one nsPoolAllocator.
+struct NS_FOUNDATION_DLL nsPoolAllocatorWrapper
+{
+  static nsAllocator* GetAllocator();
+};
+
 /// \brief Guarded allocator
 using nsGuardingAllocator = nsAllocatorWithPolicy<nsAllocPolicyGuarding>;
 
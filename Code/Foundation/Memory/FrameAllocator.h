@@ -1,6 +1,7 @@
 #pragma once
 
 #include <Foundation/Memory/LinearAllocator.h>
+#include <Foundation/Threading/AtomicInteger.h>
 
 /// \brief A double buffered stack allocator
 class NS_FOUNDATION_DLL nsDoubleBufferedLinearAllocator
@@ -26,11 +27,104 @@ private:
   StackAllocatorType* m_pOtherAllocator;
 };
 
+/// \brief A linear allocator that is only allocated from by a single thread and therefore doesn't need to take a lock.
+///
+/// Deallocate() may be called from any thread. It doesn't free any memory, it only makes sure that the destructor of an object
+/// that was deleted is not called again by Rewind() or Reset(). Deallocating memory that has no destructor doesn't take a lock.
+///
+/// \see nsFrameAllocator::GetThreadAllocator()
+class NS_FOUNDATION_DLL nsThreadLinearAllocator
+  : public nsAllocatorWithPolicy<nsAllocPolicyLinear<nsDoubleBufferedLinearAllocator::OverwriteMemoryOnReset>, nsAllocatorTrackingMode::Basics>
+{
+  using PolicyStack = nsAllocPolicyLinear<nsDoubleBufferedLinearAllocator::OverwriteMemoryOnReset>;
+  using BaseType = nsAllocatorWithPolicy<PolicyStack, nsAllocatorTrackingMode::Basics>;
+
+public:
+  /// \brief A position in the allocator, see GetMarker() and Rewind().
+  struct Marker
+  {
+    PolicyStack::Marker m_PolicyMarker;
+    nsUInt64 m_uiUsedBytes = 0;
+    nsUInt32 m_uiNumDestructors = 0;
+  };
+
+  nsThreadLinearAllocator(nsStringView sName, nsAllocator* pParent);
+  ~nsThreadLinearAllocator();
+
+  virtual void* Allocate(size_t uiSize, size_t uiAlign, nsMemoryUtils::DestructorFunction destructorFunc = nullptr) override;
+  virtual void Deallocate(void* pPtr) override;
+
+  /// \brief Returns the current position, which can be passed to Rewind() later.
+  Marker GetMarker() const;
+
+  /// \brief Frees everything that was allocated after the marker was taken and calls the destructors of those objects.
+  ///
+  /// Markers must be rewound in the reverse order in which they were taken. Must only be called by the thread that allocates.
+  void Rewind(const Marker& marker);
+
+  /// \brief Frees all memory and calls the destructors of all objects that are still alive.
+  void Reset();
+
+  /// \brief Returns how many bytes are currently allocated.
+  NS_ALWAYS_INLINE nsUInt64 GetUsedBytes() const { return m_uiUsedBytes; }
+
+  /// \brief Returns the largest number of bytes that were allocated at the same time, since the last call to ResetHighWaterMark().
+  NS_ALWAYS_INLINE nsUInt64 GetHighWaterMark() const { return nsMath::Max(m_uiHighWaterMark, m_uiUsedBytes); }
+
+  NS_ALWAYS_INLINE void ResetHighWaterMark() { m_uiHighWaterMark = m_uiUsedBytes; }
+
+  /// \brief Returns how much memory the allocator got from its parent allocator.
+  nsUInt64 GetReservedBytes() const;
+
+private:
+  void RunDestructors(nsUInt32 uiFirstIndex);
+
+  struct DestructData
+  {
+    NS_DECLARE_POD_TYPE();
+
+    nsMemoryUtils::DestructorFunction m_Func;
+    void* m_Ptr;
+  };
+
+  nsUInt64 m_uiUsedBytes = 0;
+  nsUInt64 m_uiHighWaterMark = 0;
+
+  // only objects with a destructor need to be tracked, the counter allows to skip the lock for all other deallocations
+  nsAtomicInteger32 m_iNumDestructors;
+  nsMutex m_DestructorMutex;
+  nsDynamicArray<DestructData> m_DestructData;
+  nsHashTable<void*, nsUInt32> m_PtrToDestructDataIndexTable;
+};
+
 class NS_FOUNDATION_DLL nsFrameAllocator
 {
 public:
   NS_ALWAYS_INLINE static nsAllocator* GetCurrentAllocator() { return s_pAllocator->GetCurrentAllocator(); }
 
+  /// \brief Returns the frame allocator of the calling thread.
+  ///
+  /// Every thread gets its own pair of linear allocators, so allocations only cost a pointer increment and never contend with other threads.
+  /// This is the preferred way to get scratch memory inside of tasks and nsTaskSystem::ParallelFor() bodies.
+  /// Just like with GetCurrentAllocator(), the memory stays valid until Swap() was called twice. Use nsFrameAllocatorScope to
+  /// give it back earlier.
+  static nsThreadLinearAllocator* GetThreadAllocator();
+
+  struct ThreadStats
+  {
+    nsThreadID m_ThreadID = {};
+    nsUInt64 m_uiLastFrameBytes = 0;         ///< How many bytes were still allocated when the last frame ended.
+    nsUInt64 m_uiLastFrameHighWaterMark = 0; ///< The largest number of bytes that were allocated at the same time during the last frame.
+    nsUInt64 m_uiHighWaterMark = 0;          ///< The largest number of bytes that were allocated at the same time during any frame.
+    nsUInt64 m_uiReservedBytes = 0;          ///< How much memory the thread's allocators hold.
+  };
+
+  /// \brief Returns the stats of every thread that used GetThreadAllocator(). The stats are updated in Swap().
+  static void GetThreadStats(nsDynamicArray<ThreadStats>& out_stats);
+
+  /// \brief Swaps the shared allocator and the allocators of all threads.
+  ///
+  /// Must not be called while other threads allocate from the frame allocators.
   static void Swap();
   static void Reset();
 
@@ -42,3 +136,22 @@ private:
 
   static nsDoubleBufferedLinearAllocator* s_pAllocator;
 };
+
+/// \brief Gives back everything that was allocated from the calling thread's frame allocator during the lifetime of the scope.
+///
+/// Scopes can be nested to reuse the same scratch memory several times per frame. The memory must not be used after the scope ended and
+/// a scope must not span a call to nsFrameAllocator::Swap().
+class NS_FOUNDATION_DLL nsFrameAllocatorScope
+{
+  NS_DISALLOW_COPY_AND_ASSIGN(nsFrameAllocatorScope);
+
+public:
+  nsFrameAllocatorScope();
+  ~nsFrameAllocatorScope();
+
+  NS_ALWAYS_INLINE nsThreadLinearAllocator* GetAllocator() const { return m_pAllocator; }
+
+private:
+  nsThreadLinearAllocator* m_pAllocator;
+  nsThreadLinearAllocator::Marker m_Marker;
+};
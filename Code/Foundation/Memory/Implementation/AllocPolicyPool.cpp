@@ -0,0 +1,571 @@
+#include <Foundation/FoundationPCH.h>
+
+#include <Foundation/Memory/CommonAllocators.h>
+#include <Foundation/Memory/PageAllocator.h>
+#include <Foundation/Threading/AtomicUtils.h>
+#include <Foundation/Threading/Lock.h>
+
+namespace
+{
+  // the first object of a slab follows the header, so objects are aligned to up to this many bytes
+  constexpr size_t SlabHeaderSize = 64;
+
+  // the number of allocators that can have thread local caches at the same time, all others always go through the global lists
+  constexpr nsUInt32 MaxCachedAllocators = 16;
+
+  // the upper bits of user space addresses are always zero, they hold a counter that changes with every push and pop
+  constexpr nsUInt32 PointerBits = sizeof(void*) == 8 ? 48 : 32;
+  constexpr nsUInt64 PointerMask = (nsUInt64(1) << PointerBits) - 1;
+
+  NS_ALWAYS_INLINE size_t GetObjectSize(nsUInt32 uiPool)
+  {
+    return (uiPool + 1) * 16;
+  }
+
+  // How many objects are exchanged with the global list at once. A thread cache holds at most twice as many.
+  NS_ALWAYS_INLINE nsUInt32 GetMagazineSize(nsUInt32 uiPool)
+  {
+    return nsMath::Clamp<nsUInt32>(static_cast<nsUInt32>(4096 / GetObjectSize(uiPool)), 4, 64);
+  }
+
+  NS_ALWAYS_INLINE nsUInt32 GetSlabHash(size_t uiAddress)
+  {
+    return static_cast<nsUInt32>((static_cast<nsUInt64>(uiAddress / nsAllocPolicyPool::SlabSize) * 0x9E3779B97F4A7C15ull) >> 32);
+  }
+} // namespace
+
+struct nsAllocPolicyPool::FreeObject
+{
+  FreeObject* m_pNext;         // the next object in the same magazine
+  FreeObject* m_pNextMagazine; // only used by the first object of a magazine, while it is in the global list
+};
+
+struct nsAllocPolicyPool::SlabHeader
+{
+  nsUInt32 m_uiPool = 0;
+  SlabHeader* m_pNext = nullptr;
+};
+
+/// Open addressing hash set of slab addresses, followed by its entries. It is at most half full, so that searches for addresses that
+/// are not in it end quickly. The entries are accessed with atomics, because Deallocate() reads them while another thread adds a slab.
+struct alignas(8) nsAllocPolicyPool::SlabSet
+{
+  nsInt64* GetEntries() { return reinterpret_cast<nsInt64*>(this + 1); }
+  const nsInt64* GetEntries() const { return reinterpret_cast<const nsInt64*>(this + 1); }
+
+  bool Contains(size_t uiAddress) const
+  {
+    const nsInt64* pEntries = GetEntries();
+
+    for (nsUInt32 i = GetSlabHash(uiAddress) & m_uiMask;; i = (i + 1) & m_uiMask)
+    {
+      const nsInt64 iEntry = nsAtomicUtils::Read(pEntries[i]);
+
+      if (iEntry == static_cast<nsInt64>(uiAddress))
+        return true;
+
+      if (iEntry == 0)
+        return false;
+    }
+  }
+
+  void Insert(size_t uiAddress)
+  {
+    nsInt64* pEntries = GetEntries();
+
+    nsUInt32 i = GetSlabHash(uiAddress) & m_uiMask;
+    while (pEntries[i] != 0)
+    {
+      i = (i + 1) & m_uiMask;
+    }
+
+    nsAtomicUtils::Set(pEntries[i], static_cast<nsInt64>(uiAddress));
+    ++m_uiCount;
+  }
+
+  // a replaced set is kept until the allocator is destroyed, other threads may still be searching it
+  SlabSet* m_pPrevious = nullptr;
+  nsUInt32 m_uiMask = 0;
+  nsUInt32 m_uiCount = 0;
+};
+
+static_assert(sizeof(void*) * 2 <= SlabHeaderSize, "The slab header doesn't fit");
+
+struct nsAllocPolicyPool::ThreadCache
+{
+  Magazine m_Magazines[NumPools];
+};
+
+static_assert((sizeof(void*) + sizeof(nsUInt32) + 15) / 16 * 16 * nsAllocPolicyPool::NumPools <= nsAllocPolicyPool::MaxObjectSize, "The thread cache must fit into a pool");
+
+struct nsAllocPolicyPool::ThreadCacheSlots
+{
+  ThreadCache* m_pCaches[MaxCachedAllocators];
+
+  // a cache is only valid, if its generation matches the one of the allocator, otherwise it belonged to a destroyed allocator
+  nsUInt32 m_uiGenerations[MaxCachedAllocators];
+
+  bool m_bThreadExited;
+};
+
+struct nsAllocPolicyPool::CacheSlotTable
+{
+  nsMutex m_Mutex;
+  nsAllocPolicyPool* m_pOwners[MaxCachedAllocators] = {};
+  nsUInt32 m_uiGenerations[MaxCachedAllocators] = {};
+};
+
+struct nsAllocPolicyPool::ThreadCacheFlusher
+{
+  ~ThreadCacheFlusher()
+  {
+    ThreadCacheSlots& slots = GetThreadCacheSlots();
+    CacheSlotTable& table = GetCacheSlotTable();
+
+    NS_LOCK(table.m_Mutex);
+
+    for (nsUInt32 i = 0; i < MaxCachedAllocators; ++i)
+    {
+      if (slots.m_uiGenerations[i] != 0 && slots.m_uiGenerations[i] == table.m_uiGenerations[i] && table.m_pOwners[i] != nullptr)
+      {
+        table.m_pOwners[i]->ReleaseThreadCache(slots.m_pCaches[i]);
+      }
+
+      slots.m_pCaches[i] = nullptr;
+      slots.m_uiGenerations[i] = 0;
+    }
+
+    // thread local objects that get destroyed after this one may still deallocate, they have to use the global lists
+    slots.m_bThreadExited = true;
+  }
+};
+
+namespace
+{
+  NS_ALWAYS_INLINE void* UnpackPointer(nsInt64 iHead)
+  {
+    return reinterpret_cast<void*>(static_cast<size_t>(static_cast<nsUInt64>(iHead) & PointerMask));
+  }
+
+  NS_ALWAYS_INLINE nsInt64 PackHead(void* pObject, nsInt64 iPreviousHead)
+  {
+    NS_ASSERT_DEBUG((reinterpret_cast<size_t>(pObject) & ~PointerMask) == 0, "The address doesn't fit into the list head");
+
+    const nsUInt64 uiCounter = (static_cast<nsUInt64>(iPreviousHead) >> PointerBits) + 1;
+    return static_cast<nsInt64>((uiCounter << PointerBits) | reinterpret_cast<size_t>(pObject));
+  }
+} // namespace
+
+nsAllocPolicyPool::ThreadCacheSlots& nsAllocPolicyPool::GetThreadCacheSlots()
+{
+  static thread_local ThreadCacheSlots s_Slots;
+  return s_Slots;
+}
+
+nsAllocPolicyPool::CacheSlotTable& nsAllocPolicyPool::GetCacheSlotTable()
+{
+  // never destroyed, threads may exit after the static destructors ran
+  alignas(CacheSlotTable) static nsUInt8 s_TableBuffer[sizeof(CacheSlotTable)];
+  static CacheSlotTable* s_pTable = new (s_TableBuffer) CacheSlotTable();
+  return *s_pTable;
+}
+
+nsAllocPolicyPool::nsAllocPolicyPool(nsAllocator* pParent)
+  : m_pParent(pParent)
+{
+  CacheSlotTable& table = GetCacheSlotTable();
+  NS_LOCK(table.m_Mutex);
+
+  for (nsUInt32 i = 0; i < MaxCachedAllocators; ++i)
+  {
+    if (table.m_pOwners[i] == nullptr)
+    {
+      // zero is reserved for 'no cache'
+      if (++table.m_uiGenerations[i] == 0)
+        ++table.m_uiGenerations[i];
+
+      table.m_pOwners[i] = this;
+      m_uiCacheSlot = i;
+      m_uiCacheGeneration = table.m_uiGenerations[i];
+      break;
+    }
+  }
+}
+
+nsAllocPolicyPool::~nsAllocPolicyPool()
+{
+  if (m_uiCacheGeneration != 0)
+  {
+    CacheSlotTable& table = GetCacheSlotTable();
+    NS_LOCK(table.m_Mutex);
+
+    // the caches of all threads become invalid, their memory is released with the slabs below
+    table.m_pOwners[m_uiCacheSlot] = nullptr;
+    ++table.m_uiGenerations[m_uiCacheSlot];
+  }
+
+  for (Pool& pool : m_Pools)
+  {
+    while (pool.m_pSlabs != nullptr)
+    {
+      SlabHeader* pSlab = pool.m_pSlabs;
+      pool.m_pSlabs = pSlab->m_pNext;
+      DeallocateFromParent(pSlab);
+    }
+  }
+
+  SlabSet* pSet = reinterpret_cast<SlabSet*>(static_cast<size_t>(m_iSlabSet));
+  while (pSet != nullptr)
+  {
+    SlabSet* pPrevious = pSet->m_pPrevious;
+    pSet->~SlabSet();
+    DeallocateFromParent(pSet);
+    pSet = pPrevious;
+  }
+}
+
+nsUInt32 nsAllocPolicyPool::GetPoolIndex(size_t uiSize, size_t uiAlign)
+{
+  if (uiSize > MaxObjectSize || uiAlign > SlabHeaderSize)
+    return NumPools;
+
+  // objects are placed at multiples of their size after the header, so a multiple of the alignment is aligned as well
+  const size_t uiObjectSize = nsMemoryUtils::AlignSize(nsMath::Max<size_t>(uiSize, 16), nsMath::Max<size_t>(uiAlign, 16));
+  return static_cast<nsUInt32>(uiObjectSize / 16) - 1;
+}
+
+size_t nsAllocPolicyPool::GetAllocationSize(size_t uiSize, size_t uiAlign)
+{
+  const nsUInt32 uiPool = GetPoolIndex(uiSize, uiAlign);
+  return uiPool < NumPools ? GetObjectSize(uiPool) : uiSize;
+}
+
+void* nsAllocPolicyPool::Allocate(size_t uiSize, size_t uiAlign)
+{
+  const nsUInt32 uiPool = GetPoolIndex(uiSize, uiAlign);
+
+  if (uiPool >= NumPools)
+    return AllocateFromParent(uiSize, uiAlign);
+
+  if (ThreadCache* pCache = GetThreadCache())
+  {
+    Magazine& magazine = pCache->m_Magazines[uiPool];
+
+    if (FreeObject* pObject = magazine.m_pHead)
+    {
+      magazine.m_pHead = pObject->m_pNext;
+      --magazine.m_uiCount;
+      return pObject;
+    }
+
+    return Refill(magazine, uiPool);
+  }
+
+  return AllocateUncached(uiPool);
+}
+
+void nsAllocPolicyPool::Deallocate(void* pPtr)
+{
+  if (pPtr == nullptr)
+    return;
+
+  // a pooled object lies in a slab, which starts with a header at the beginning of its slab sized block
+  const size_t uiSlabAddress = reinterpret_cast<size_t>(pPtr) & ~(SlabSize - 1);
+
+  if (!IsSlab(uiSlabAddress))
+  {
+    DeallocateFromParent(pPtr);
+    return;
+  }
+
+  const nsUInt32 uiPool = reinterpret_cast<SlabHeader*>(uiSlabAddress)->m_uiPool;
+
+  FreeObject* pObject = static_cast<FreeObject*>(pPtr);
+
+  if (ThreadCache* pCache = GetThreadCache())
+  {
+    Magazine& magazine = pCache->m_Magazines[uiPool];
+    pObject->m_pNext = magazine.m_pHead;
+    magazine.m_pHead = pObject;
+    ++magazine.m_uiCount;
+
+    const nsUInt32 uiMagazineSize = GetMagazineSize(uiPool);
+
+    if (magazine.m_uiCount >= uiMagazineSize * 2)
+    {
+      // hand one full magazine to the other threads, keep the rest for the next allocations
+      FreeObject* pLast = magazine.m_pHead;
+
+      for (nsUInt32 i = 1; i < uiMagazineSize; ++i)
+      {
+        pLast = pLast->m_pNext;
+      }
+
+      FreeObject* pFirst = magazine.m_pHead;
+      magazine.m_pHead = pLast->m_pNext;
+      magazine.m_uiCount -= uiMagazineSize;
+      pLast->m_pNext = nullptr;
+
+      PushMagazines(uiPool, pFirst, pFirst);
+    }
+
+    return;
+  }
+
+  // a magazine with a single object
+  pObject->m_pNext = nullptr;
+  PushMagazines(uiPool, pObject, pObject);
+}
+
+nsAllocPolicyPool::ThreadCache* nsAllocPolicyPool::GetThreadCache()
+{
+  if (m_uiCacheGeneration == 0)
+    return nullptr;
+
+  ThreadCacheSlots& slots = GetThreadCacheSlots();
+
+  if (slots.m_uiGenerations[m_uiCacheSlot] == m_uiCacheGeneration)
+    return slots.m_pCaches[m_uiCacheSlot];
+
+  return CreateThreadCache(slots);
+}
+
+nsAllocPolicyPool::ThreadCache* nsAllocPolicyPool::CreateThreadCache(ThreadCacheSlots& ref_slots)
+{
+  if (ref_slots.m_bThreadExited)
+    return nullptr;
+
+  // returns the thread's magazines to their allocators when the thread exits
+  static thread_local ThreadCacheFlusher s_Flusher;
+  NS_IGNORE_UNUSED(s_Flusher);
+
+  // a cache that is still in the slot belonged to a destroyed allocator, its memory is gone already
+  ThreadCache* pCache = new (AllocateUncached(GetPoolIndex(sizeof(ThreadCache), alignof(ThreadCache)))) ThreadCache();
+
+  ref_slots.m_pCaches[m_uiCacheSlot] = pCache;
+  ref_slots.m_uiGenerations[m_uiCacheSlot] = m_uiCacheGeneration;
+  return pCache;
+}
+
+void nsAllocPolicyPool::ReleaseThreadCache(ThreadCache* pCache)
+{
+  for (nsUInt32 uiPool = 0; uiPool < NumPools; ++uiPool)
+  {
+    Magazine& magazine = pCache->m_Magazines[uiPool];
+
+    if (magazine.m_pHead != nullptr)
+    {
+      PushMagazines(uiPool, magazine.m_pHead, magazine.m_pHead);
+    }
+  }
+
+  pCache->~ThreadCache();
+
+  FreeObject* pObject = reinterpret_cast<FreeObject*>(pCache);
+  pObject->m_pNext = nullptr;
+  PushMagazines(GetPoolIndex(sizeof(ThreadCache), alignof(ThreadCache)), pObject, pObject);
+}
+
+void* nsAllocPolicyPool::AllocateUncached(nsUInt32 uiPool)
+{
+  FreeObject* pObject = PopMagazine(uiPool);
+
+  if (FreeObject* pRest = pObject->m_pNext)
+  {
+    PushMagazines(uiPool, pRest, pRest);
+  }
+
+  return pObject;
+}
+
+void* nsAllocPolicyPool::Refill(Magazine& ref_magazine, nsUInt32 uiPool)
+{
+  NS_ASSERT_DEBUG(ref_magazine.m_pHead == nullptr, "The magazine is not empty");
+
+  FreeObject* pObject = PopMagazine(uiPool);
+
+  // magazines from exiting threads or threads without a cache may not be full, so the objects are counted
+  nsUInt32 uiCount = 0;
+  for (FreeObject* pRest = pObject->m_pNext; pRest != nullptr; pRest = pRest->m_pNext)
+  {
+    ++uiCount;
+  }
+
+  ref_magazine.m_pHead = pObject->m_pNext;
+  ref_magazine.m_uiCount = uiCount;
+  return pObject;
+}
+
+nsAllocPolicyPool::FreeObject* nsAllocPolicyPool::PopMagazine(nsUInt32 uiPool)
+{
+  Pool& pool = m_Pools[uiPool];
+  nsInt64 iHead = nsAtomicUtils::Read(pool.m_iMagazines);
+
+  while (FreeObject* pMagazine = static_cast<FreeObject*>(UnpackPointer(iHead)))
+  {
+    // The slabs are never freed while the allocator exists, so this can be read even if another thread took the magazine in the meantime.
+    // The counter in the head has changed then and the exchange fails.
+    FreeObject* pNext = pMagazine->m_pNextMagazine;
+
+    if (nsAtomicUtils::TestAndSet(pool.m_iMagazines, iHead, PackHead(pNext, iHead)))
+      return pMagazine;
+
+    iHead = nsAtomicUtils::Read(pool.m_iMagazines);
+  }
+
+  return Grow(uiPool);
+}
+
+void nsAllocPolicyPool::PushMagazines(nsUInt32 uiPool, FreeObject* pFirst, FreeObject* pLast)
+{
+  Pool& pool = m_Pools[uiPool];
+
+  while (true)
+  {
+    const nsInt64 iHead = nsAtomicUtils::Read(pool.m_iMagazines);
+    pLast->m_pNextMagazine = static_cast<FreeObject*>(UnpackPointer(iHead));
+
+    if (nsAtomicUtils::TestAndSet(pool.m_iMagazines, iHead, PackHead(pFirst, iHead)))
+      return;
+  }
+}
+
+nsAllocPolicyPool::FreeObject* nsAllocPolicyPool::Grow(nsUInt32 uiPool)
+{
+  Pool& pool = m_Pools[uiPool];
+  NS_LOCK(pool.m_Mutex);
+
+  // another thread may have grown the pool or returned a magazine while this one was waiting for the lock
+  nsInt64 iHead = nsAtomicUtils::Read(pool.m_iMagazines);
+
+  while (FreeObject* pMagazine = static_cast<FreeObject*>(UnpackPointer(iHead)))
+  {
+    if (nsAtomicUtils::TestAndSet(pool.m_iMagazines, iHead, PackHead(pMagazine->m_pNextMagazine, iHead)))
+      return pMagazine;
+
+    iHead = nsAtomicUtils::Read(pool.m_iMagazines);
+  }
+
+  nsUInt8* pMemory = static_cast<nsUInt8*>(AllocateFromParent(SlabSize, SlabSize));
+
+  SlabHeader* pSlab = new (pMemory) SlabHeader();
+  pSlab->m_uiPool = uiPool;
+  pSlab->m_pNext = pool.m_pSlabs;
+  pool.m_pSlabs = pSlab;
+
+  AddSlab(pSlab);
+
+  const size_t uiObjectSize = GetObjectSize(uiPool);
+  const nsUInt32 uiNumObjects = static_cast<nsUInt32>((SlabSize - SlabHeaderSize) / uiObjectSize);
+  const nsUInt32 uiMagazineSize = GetMagazineSize(uiPool);
+
+  auto GetObject = [&](nsUInt32 uiIndex)
+  { return reinterpret_cast<FreeObject*>(pMemory + SlabHeaderSize + uiIndex * uiObjectSize); };
+
+  // the objects of a magazine are linked in address order, the magazines are chained like in the global list
+  FreeObject* pFirstMagazine = nullptr;
+  FreeObject* pLastMagazine = nullptr;
+
+  for (nsUInt32 uiStart = 0; uiStart < uiNumObjects; uiStart += uiMagazineSize)
+  {
+    const nsUInt32 uiEnd = nsMath::Min(uiStart + uiMagazineSize, uiNumObjects);
+
+    for (nsUInt32 i = uiStart; i < uiEnd; ++i)
+    {
+      GetObject(i)->m_pNext = (i + 1 < uiEnd) ? GetObject(i + 1) : nullptr;
+    }
+
+    FreeObject* pMagazine = GetObject(uiStart);
+    pMagazine->m_pNextMagazine = nullptr;
+
+    if (pLastMagazine != nullptr)
+      pLastMagazine->m_pNextMagazine = pMagazine;
+    else
+      pFirstMagazine = pMagazine;
+
+    pLastMagazine = pMagazine;
+  }
+
+  // the first magazine goes to the caller
+  if (pFirstMagazine != pLastMagazine)
+  {
+    PushMagazines(uiPool, pFirstMagazine->m_pNextMagazine, pLastMagazine);
+  }
+
+  return pFirstMagazine;
+}
+
+bool nsAllocPolicyPool::IsSlab(size_t uiAddress) const
+{
+  const SlabSet* pSet = reinterpret_cast<const SlabSet*>(static_cast<size_t>(nsAtomicUtils::Read(m_iSlabSet)));
+  return pSet != nullptr && pSet->Contains(uiAddress);
+}
+
+void nsAllocPolicyPool::AddSlab(void* pSlab)
+{
+  NS_LOCK(m_SlabSetMutex);
+
+  SlabSet* pSet = reinterpret_cast<SlabSet*>(static_cast<size_t>(m_iSlabSet));
+
+  if (pSet == nullptr || (pSet->m_uiCount + 1) * 2 > pSet->m_uiMask + 1)
+  {
+    const nsUInt32 uiCapacity = (pSet != nullptr) ? (pSet->m_uiMask + 1) * 2 : 64;
+
+    SlabSet* pNewSet = new (AllocateFromParent(sizeof(SlabSet) + uiCapacity * sizeof(nsInt64), alignof(SlabSet))) SlabSet();
+    pNewSet->m_pPrevious = pSet;
+    pNewSet->m_uiMask = uiCapacity - 1;
+    nsMemoryUtils::ZeroFill(pNewSet->GetEntries(), uiCapacity);
+
+    if (pSet != nullptr)
+    {
+      for (nsUInt32 i = 0; i <= pSet->m_uiMask; ++i)
+      {
+        if (const nsInt64 iEntry = pSet->GetEntries()[i])
+        {
+          pNewSet->Insert(static_cast<size_t>(iEntry));
+        }
+      }
+    }
+
+    // the new set is complete before other threads can see it
+    nsAtomicUtils::Set(m_iSlabSet, static_cast<nsInt64>(reinterpret_cast<size_t>(pNewSet)));
+    pSet = pNewSet;
+  }
+
+  pSet->Insert(reinterpret_cast<size_t>(pSlab));
+}
+
+void* nsAllocPolicyPool::AllocateFromParent(size_t uiSize, size_t uiAlign)
+{
+  if (m_pParent != nullptr)
+    return m_pParent->Allocate(uiSize, uiAlign);
+
+  return nsPageAllocator::AllocatePage(uiSize, uiAlign);
+}
+
+void nsAllocPolicyPool::DeallocateFromParent(void* pPtr)
+{
+  if (m_pParent != nullptr)
+  {
+    m_pParent->Deallocate(pPtr);
+    return;
+  }
+
+  nsPageAllocator::DeallocatePage(pPtr);
+}
+
+nsAllocator* nsPoolAllocatorWrapper::GetAllocator()
+{
+  using SlabAllocator = nsAllocatorWithPolicy<nsAllocPolicyAlignedHeap, nsAllocatorTrackingMode::AllocationStatsIgnoreLeaks>;
+
+  // Never destroyed, containers that use it may be destroyed after the static destructors ran.
+  // The slabs are never returned either, so they come from an allocator that doesn't report them as leaks. Objects that are still
+  // allocated from the pool at shutdown are reported as usual.
+  alignas(SlabAllocator) static nsUInt8 s_SlabAllocatorBuffer[sizeof(SlabAllocator)];
+  alignas(nsPoolAllocator) static nsUInt8 s_AllocatorBuffer[sizeof(nsPoolAllocator)];
+
+  static nsAllocator* s_pAllocator = new (s_AllocatorBuffer) nsPoolAllocator("Pool", new (s_SlabAllocatorBuffer) SlabAllocator("PoolSlabs"));
+  return s_pAllocator;
+}
+
+NS_STATICLINK_FILE(Foundation, Foundation_Memory_Implementation_AllocPolicyPool);
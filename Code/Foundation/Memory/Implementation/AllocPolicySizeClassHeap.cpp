@@ -0,0 +1,432 @@
+#include <Foundation/FoundationPCH.h>
+
+#include <Foundation/Memory/MemoryTracker.h>
+#include <Foundation/Memory/PageAllocator.h>
+#include <Foundation/Memory/Policies/AllocPolicySizeClassHeap.h>
+#include <Foundation/Threading/Lock.h>
+
+namespace
+{
+  // the first object of a span follows the header, all objects of a class are aligned to the largest power of two that divides the class size
+  constexpr size_t SpanHeaderSize = 256;
+
+  // the number of allocators that can have thread local caches at the same time, all others always go through the central lists
+  constexpr nsUInt32 MaxCachedAllocators = 8;
+
+  // 16 byte steps up to 128 bytes, then four classes per power of two
+  constexpr nsUInt32 s_ClassSizes[nsAllocPolicySizeClassHeap::NumSizeClasses] = {
+    16, 32, 48, 64, 80, 96, 112, 128,
+    160, 192, 224, 256,
+    320, 384, 448, 512,
+    640, 768, 896, 1024,
+    1280, 1536, 1792, 2048,
+    2560, 3072, 3584, 4096,
+    5120, 6144, 7168, 8192};
+
+  static_assert(s_ClassSizes[nsAllocPolicySizeClassHeap::NumSizeClasses - 1] == nsAllocPolicySizeClassHeap::MaxSmallSize);
+
+  // maps the size in 16 byte steps (rounded up) to the smallest class that fits
+  struct SizeClassLookup
+  {
+    constexpr SizeClassLookup()
+    {
+      nsUInt32 uiClass = 0;
+
+      for (nsUInt32 i = 0; i <= nsAllocPolicySizeClassHeap::MaxSmallSize / 16; ++i)
+      {
+        while (s_ClassSizes[uiClass] < i * 16)
+          ++uiClass;
+
+        m_Classes[i] = static_cast<nsUInt8>(uiClass);
+      }
+    }
+
+    nsUInt8 m_Classes[nsAllocPolicySizeClassHeap::MaxSmallSize / 16 + 1] = {};
+  };
+
+  constexpr SizeClassLookup s_SizeClassLookup;
+
+  // How many objects are moved between a thread cache and the central list at once. A cache holds at most twice as many.
+  // Small objects are moved in larger batches, so that the central lock is rarely needed, large ones in small batches to not waste memory.
+  NS_ALWAYS_INLINE nsUInt32 GetBatchSize(nsUInt32 uiSizeClass)
+  {
+    return nsMath::Clamp<nsUInt32>(4096 / s_ClassSizes[uiSizeClass], 2, 32);
+  }
+} // namespace
+
+struct nsAllocPolicySizeClassHeap::FreeObject
+{
+  FreeObject* m_pNext;
+};
+
+struct nsAllocPolicySizeClassHeap::SpanHeader
+{
+  nsUInt32 m_uiSizeClass = 0; // NumSizeClasses for a large allocation
+  SpanHeader* m_pNext = nullptr;
+};
+
+static_assert(sizeof(void*) * 2 <= SpanHeaderSize, "The span header doesn't fit");
+
+struct nsAllocPolicySizeClassHeap::ThreadCache
+{
+  FreeList m_Lists[NumSizeClasses];
+};
+
+struct nsAllocPolicySizeClassHeap::ThreadCacheSlots
+{
+  ThreadCache* m_pCaches[MaxCachedAllocators];
+
+  // a cache is only valid, if its generation matches the one of the allocator, otherwise it belonged to a destroyed allocator
+  nsUInt32 m_uiGenerations[MaxCachedAllocators];
+
+  bool m_bThreadExited;
+};
+
+struct nsAllocPolicySizeClassHeap::CacheSlotTable
+{
+  nsMutex m_Mutex;
+  nsAllocPolicySizeClassHeap* m_pOwners[MaxCachedAllocators] = {};
+  nsUInt32 m_uiGenerations[MaxCachedAllocators] = {};
+};
+
+struct nsAllocPolicySizeClassHeap::ThreadCacheFlusher
+{
+  ~ThreadCacheFlusher()
+  {
+    ThreadCacheSlots& slots = GetThreadCacheSlots();
+    CacheSlotTable& table = GetCacheSlotTable();
+
+    NS_LOCK(table.m_Mutex);
+
+    for (nsUInt32 i = 0; i < MaxCachedAllocators; ++i)
+    {
+      if (slots.m_uiGenerations[i] != 0 && slots.m_uiGenerations[i] == table.m_uiGenerations[i] && table.m_pOwners[i] != nullptr)
+      {
+        table.m_pOwners[i]->ReleaseThreadCache(slots.m_pCaches[i]);
+      }
+
+      slots.m_pCaches[i] = nullptr;
+      slots.m_uiGenerations[i] = 0;
+    }
+
+    // thread local objects that get destroyed after this one may still deallocate, they have to use the central lists
+    slots.m_bThreadExited = true;
+  }
+};
+
+nsAllocPolicySizeClassHeap::ThreadCacheSlots& nsAllocPolicySizeClassHeap::GetThreadCacheSlots()
+{
+  static thread_local ThreadCacheSlots s_Slots;
+  return s_Slots;
+}
+
+nsAllocPolicySizeClassHeap::CacheSlotTable& nsAllocPolicySizeClassHeap::GetCacheSlotTable()
+{
+  // never destroyed, threads may exit after the static destructors ran
+  alignas(CacheSlotTable) static nsUInt8 s_TableBuffer[sizeof(CacheSlotTable)];
+  static CacheSlotTable* s_pTable = new (s_TableBuffer) CacheSlotTable();
+  return *s_pTable;
+}
+
+nsAllocPolicySizeClassHeap::nsAllocPolicySizeClassHeap(nsAllocator* pParent)
+{
+  NS_IGNORE_UNUSED(pParent);
+
+  CacheSlotTable& table = GetCacheSlotTable();
+  NS_LOCK(table.m_Mutex);
+
+  for (nsUInt32 i = 0; i < MaxCachedAllocators; ++i)
+  {
+    if (table.m_pOwners[i] == nullptr)
+    {
+      // zero is reserved for 'no cache'
+      if (++table.m_uiGenerations[i] == 0)
+        ++table.m_uiGenerations[i];
+
+      table.m_pOwners[i] = this;
+      m_uiCacheSlot = i;
+      m_uiCacheGeneration = table.m_uiGenerations[i];
+      break;
+    }
+  }
+}
+
+nsAllocPolicySizeClassHeap::~nsAllocPolicySizeClassHeap()
+{
+  if (m_uiCacheGeneration != 0)
+  {
+    CacheSlotTable& table = GetCacheSlotTable();
+    NS_LOCK(table.m_Mutex);
+
+    // the caches of all threads become invalid, their memory is released with the spans below
+    table.m_pOwners[m_uiCacheSlot] = nullptr;
+    ++table.m_uiGenerations[m_uiCacheSlot];
+  }
+
+  while (m_pSpans != nullptr)
+  {
+    SpanHeader* pSpan = m_pSpans;
+    m_pSpans = pSpan->m_pNext;
+    nsPageAllocator::DeallocatePage(pSpan);
+  }
+}
+
+nsUInt32 nsAllocPolicySizeClassHeap::GetSizeClass(size_t uiSize, size_t uiAlign)
+{
+  if (uiSize > MaxSmallSize || uiAlign > SpanHeaderSize)
+    return NumSizeClasses;
+
+  nsUInt32 uiSizeClass = s_SizeClassLookup.m_Classes[(uiSize + 15) / 16];
+
+  while (uiAlign > 16 && uiSizeClass < NumSizeClasses && (s_ClassSizes[uiSizeClass] & (uiAlign - 1)) != 0)
+  {
+    ++uiSizeClass;
+  }
+
+  return uiSizeClass;
+}
+
+size_t nsAllocPolicySizeClassHeap::GetAllocationSize(size_t uiSize, size_t uiAlign)
+{
+  const nsUInt32 uiSizeClass = GetSizeClass(uiSize, uiAlign);
+  return uiSizeClass < NumSizeClasses ? s_ClassSizes[uiSizeClass] : uiSize;
+}
+
+void* nsAllocPolicySizeClassHeap::Allocate(size_t uiSize, size_t uiAlign)
+{
+  const nsUInt32 uiSizeClass = GetSizeClass(uiSize, uiAlign);
+
+  if (uiSizeClass >= NumSizeClasses)
+    return AllocateLarge(uiSize, uiAlign);
+
+  if (ThreadCache* pCache = GetThreadCache())
+  {
+    FreeList& list = pCache->m_Lists[uiSizeClass];
+
+    if (FreeObject* pObject = list.m_pHead)
+    {
+      list.m_pHead = pObject->m_pNext;
+      --list.m_uiCount;
+      return pObject;
+    }
+
+    return FetchFromCentral(list, uiSizeClass);
+  }
+
+  return AllocateFromCentral(uiSizeClass);
+}
+
+void nsAllocPolicySizeClassHeap::Deallocate(void* pPtr)
+{
+  if (pPtr == nullptr)
+    return;
+
+  // small objects and large allocations both start within the first span sized block of their memory, which starts with a header
+  SpanHeader* pSpan = reinterpret_cast<SpanHeader*>(reinterpret_cast<size_t>(pPtr) & ~(SpanSize - 1));
+  const nsUInt32 uiSizeClass = pSpan->m_uiSizeClass;
+
+  if (uiSizeClass >= NumSizeClasses)
+  {
+    nsPageAllocator::DeallocatePage(pSpan);
+    return;
+  }
+
+  FreeObject* pObject = static_cast<FreeObject*>(pPtr);
+
+  if (ThreadCache* pCache = GetThreadCache())
+  {
+    FreeList& list = pCache->m_Lists[uiSizeClass];
+    pObject->m_pNext = list.m_pHead;
+    list.m_pHead = pObject;
+    ++list.m_uiCount;
+
+    const nsUInt32 uiBatchSize = GetBatchSize(uiSizeClass);
+
+    if (list.m_uiCount > uiBatchSize * 2)
+    {
+      ReleaseToCentral(list, uiSizeClass, uiBatchSize);
+    }
+
+    return;
+  }
+
+  DeallocateToCentral(pObject, uiSizeClass);
+}
+
+nsAllocPolicySizeClassHeap::ThreadCache* nsAllocPolicySizeClassHeap::GetThreadCache()
+{
+  if (m_uiCacheGeneration == 0)
+    return nullptr;
+
+  ThreadCacheSlots& slots = GetThreadCacheSlots();
+
+  if (slots.m_uiGenerations[m_uiCacheSlot] == m_uiCacheGeneration)
+    return slots.m_pCaches[m_uiCacheSlot];
+
+  return CreateThreadCache(slots);
+}
+
+nsAllocPolicySizeClassHeap::ThreadCache* nsAllocPolicySizeClassHeap::CreateThreadCache(ThreadCacheSlots& ref_slots)
+{
+  if (ref_slots.m_bThreadExited)
+    return nullptr;
+
+  // returns the thread's caches to their allocators when the thread exits
+  static thread_local ThreadCacheFlusher s_Flusher;
+  NS_IGNORE_UNUSED(s_Flusher);
+
+  // a cache that is still in the slot belonged to a destroyed allocator, its memory is gone already
+  ThreadCache* pCache = new (AllocateFromCentral(GetSizeClass(sizeof(ThreadCache), alignof(ThreadCache)))) ThreadCache();
+
+  ref_slots.m_pCaches[m_uiCacheSlot] = pCache;
+  ref_slots.m_uiGenerations[m_uiCacheSlot] = m_uiCacheGeneration;
+  return pCache;
+}
+
+void nsAllocPolicySizeClassHeap::ReleaseThreadCache(ThreadCache* pCache)
+{
+  for (nsUInt32 uiSizeClass = 0; uiSizeClass < NumSizeClasses; ++uiSizeClass)
+  {
+    FreeList& list = pCache->m_Lists[uiSizeClass];
+
+    if (list.m_uiCount > 0)
+    {
+      ReleaseToCentral(list, uiSizeClass, list.m_uiCount);
+    }
+  }
+
+  pCache->~ThreadCache();
+  DeallocateToCentral(reinterpret_cast<FreeObject*>(pCache), GetSizeClass(sizeof(ThreadCache), alignof(ThreadCache)));
+}
+
+void* nsAllocPolicySizeClassHeap::AllocateFromCentral(nsUInt32 uiSizeClass)
+{
+  CentralFreeList& central = m_CentralLists[uiSizeClass];
+  NS_LOCK(central.m_Mutex);
+
+  if (central.m_List.m_pHead == nullptr)
+  {
+    AllocateSpan(uiSizeClass);
+  }
+
+  FreeObject* pObject = central.m_List.m_pHead;
+  central.m_List.m_pHead = pObject->m_pNext;
+  --central.m_List.m_uiCount;
+  return pObject;
+}
+
+void nsAllocPolicySizeClassHeap::DeallocateToCentral(FreeObject* pObject, nsUInt32 uiSizeClass)
+{
+  CentralFreeList& central = m_CentralLists[uiSizeClass];
+  NS_LOCK(central.m_Mutex);
+
+  pObject->m_pNext = central.m_List.m_pHead;
+  central.m_List.m_pHead = pObject;
+  ++central.m_List.m_uiCount;
+}
+
+void* nsAllocPolicySizeClassHeap::FetchFromCentral(FreeList& ref_list, nsUInt32 uiSizeClass)
+{
+  CentralFreeList& central = m_CentralLists[uiSizeClass];
+  NS_LOCK(central.m_Mutex);
+
+  if (central.m_List.m_pHead == nullptr)
+  {
+    AllocateSpan(uiSizeClass);
+  }
+
+  FreeObject* pResult = central.m_List.m_pHead;
+  central.m_List.m_pHead = pResult->m_pNext;
+  --central.m_List.m_uiCount;
+
+  const nsUInt32 uiBatchSize = nsMath::Min(GetBatchSize(uiSizeClass), central.m_List.m_uiCount);
+
+  if (uiBatchSize > 0)
+  {
+    FreeObject* pFirst = central.m_List.m_pHead;
+    FreeObject* pLast = pFirst;
+
+    for (nsUInt32 i = 1; i < uiBatchSize; ++i)
+    {
+      pLast = pLast->m_pNext;
+    }
+
+    central.m_List.m_pHead = pLast->m_pNext;
+    central.m_List.m_uiCount -= uiBatchSize;
+
+    pLast->m_pNext = ref_list.m_pHead;
+    ref_list.m_pHead = pFirst;
+    ref_list.m_uiCount += uiBatchSize;
+  }
+
+  return pResult;
+}
+
+void nsAllocPolicySizeClassHeap::ReleaseToCentral(FreeList& ref_list, nsUInt32 uiSizeClass, nsUInt32 uiCount)
+{
+  NS_ASSERT_DEBUG(uiCount > 0 && uiCount <= ref_list.m_uiCount, "Invalid number of objects to release");
+
+  // detach the objects before taking the lock
+  FreeObject* pFirst = ref_list.m_pHead;
+  FreeObject* pLast = pFirst;
+
+  for (nsUInt32 i = 1; i < uiCount; ++i)
+  {
+    pLast = pLast->m_pNext;
+  }
+
+  ref_list.m_pHead = pLast->m_pNext;
+  ref_list.m_uiCount -= uiCount;
+
+  CentralFreeList& central = m_CentralLists[uiSizeClass];
+  NS_LOCK(central.m_Mutex);
+
+  pLast->m_pNext = central.m_List.m_pHead;
+  central.m_List.m_pHead = pFirst;
+  central.m_List.m_uiCount += uiCount;
+}
+
+void nsAllocPolicySizeClassHeap::AllocateSpan(nsUInt32 uiSizeClass)
+{
+  nsUInt8* pMemory = static_cast<nsUInt8*>(nsPageAllocator::AllocatePage(SpanSize, SpanSize));
+
+  SpanHeader* pSpan = new (pMemory) SpanHeader();
+  pSpan->m_uiSizeClass = uiSizeClass;
+
+  {
+    NS_LOCK(m_SpanMutex);
+    pSpan->m_pNext = m_pSpans;
+    m_pSpans = pSpan;
+  }
+
+  const size_t uiObjectSize = s_ClassSizes[uiSizeClass];
+  const nsUInt32 uiNumObjects = static_cast<nsUInt32>((SpanSize - SpanHeaderSize) / uiObjectSize);
+
+  // link the objects back to front, so that they are handed out in address order
+  FreeList& list = m_CentralLists[uiSizeClass].m_List;
+
+  for (nsUInt32 i = uiNumObjects; i > 0; --i)
+  {
+    FreeObject* pObject = reinterpret_cast<FreeObject*>(pMemory + SpanHeaderSize + (i - 1) * uiObjectSize);
+    pObject->m_pNext = list.m_pHead;
+    list.m_pHead = pObject;
+  }
+
+  list.m_uiCount += uiNumObjects;
+}
+
+void* nsAllocPolicySizeClassHeap::AllocateLarge(size_t uiSize, size_t uiAlign)
+{
+  NS_ASSERT_DEV(uiAlign <= SpanSize / 2, "Alignment of {} bytes is not supported by nsAllocPolicySizeClassHeap.", uiAlign);
+
+  // the header sits at the start of the first span sized block, just like for small objects
+  const size_t uiOffset = nsMath::Max(SpanHeaderSize, uiAlign);
+  nsUInt8* pMemory = static_cast<nsUInt8*>(nsPageAllocator::AllocatePage(uiOffset + uiSize, SpanSize));
+
+  SpanHeader* pHeader = new (pMemory) SpanHeader();
+  pHeader->m_uiSizeClass = NumSizeClasses;
+
+  return pMemory + uiOffset;
+}
+
+NS_STATICLINK_FILE(Foundation, Foundation_Memory_Implementation_AllocPolicySizeClassHeap);
@@ -85,6 +85,11 @@ void* nsInternal::nsAllocatorImpl<A, TrackingMode>::Allocate(size_t uiSize, size
     nsMemoryTracker::AddAllocation(this->m_Id, TrackingMode, ptr, uiSize, uiAlign, nsTime::Now() - fAllocationTime);
   }
 
+  if constexpr (TrackingMode >= nsAllocatorTrackingMode::Basics)
+  {
+    nsMemoryTracker::SampleAllocation(this->m_Id, ptr, uiSize);
+  }
+
   return ptr;
 }
 
@@ -96,6 +101,11 @@ void nsInternal::nsAllocatorImpl<A, TrackingMode>::Deallocate(void* pPtr)
     nsMemoryTracker::RemoveAllocation(this->m_Id, pPtr);
   }
 
+  if constexpr (TrackingMode >= nsAllocatorTrackingMode::Basics)
+  {
+    nsMemoryTracker::RemoveSampledAllocation(pPtr);
+  }
+
   m_allocator.Deallocate(pPtr);
 }
 
@@ -160,6 +170,11 @@ void* nsInternal::nsAllocatorMixinReallocate<A, TrackingMode, true>::Reallocate(
     fAllocationTime = nsTime::Now();
   }
 
+  if constexpr (TrackingMode >= nsAllocatorTrackingMode::Basics)
+  {
+    nsMemoryTracker::RemoveSampledAllocation(pPtr);
+  }
+
   void* pNewMem = this->m_allocator.Reallocate(pPtr, uiCurrentSize, uiNewSize, uiAlign);
 
   if constexpr (TrackingMode >= nsAllocatorTrackingMode::AllocationStats)
@@ -167,5 +182,10 @@ void* nsInternal::nsAllocatorMixinReallocate<A, TrackingMode, true>::Reallocate(
     nsMemoryTracker::AddAllocation(this->m_Id, TrackingMode, pNewMem, uiNewSize, uiAlign, nsTime::Now() - fAllocationTime);
   }
 
+  if constexpr (TrackingMode >= nsAllocatorTrackingMode::Basics)
+  {
+    nsMemoryTracker::SampleAllocation(this->m_Id, pNewMem, uiNewSize);
+  }
+
   return pNewMem;
 }
@@ -4,6 +4,7 @@
 #include <Foundation/Memory/FrameAllocator.h>
 #include <Foundation/Profiling/Profiling.h>
 #include <Foundation/Strings/StringBuilder.h>
+#include <Foundation/Threading/Lock.h>
 
 nsDoubleBufferedLinearAllocator::nsDoubleBufferedLinearAllocator(nsStringView sName0, nsAllocator* pParent)
 {
@@ -37,6 +38,204 @@ void nsDoubleBufferedLinearAllocator::Reset()
   m_pOtherAllocator->Reset();
 }
 
+nsThreadLinearAllocator::nsThreadLinearAllocator(nsStringView sName, nsAllocator* pParent)
+  : BaseType(sName, pParent)
+  , m_DestructData(pParent)
+  , m_PtrToDestructDataIndexTable(pParent)
+{
+}
+
+nsThreadLinearAllocator::~nsThreadLinearAllocator()
+{
+  Reset();
+}
+
+void* nsThreadLinearAllocator::Allocate(size_t uiSize, size_t uiAlign, nsMemoryUtils::DestructorFunction destructorFunc)
+{
+  void* ptr = BaseType::Allocate(uiSize, uiAlign, destructorFunc);
+
+  m_uiUsedBytes += nsMemoryUtils::AlignSize(uiSize, static_cast<size_t>(PolicyStack::Alignment));
+
+  if (destructorFunc != nullptr)
+  {
+    NS_LOCK(m_DestructorMutex);
+
+    nsUInt32 uiIndex = m_DestructData.GetCount();
+    m_PtrToDestructDataIndexTable.Insert(ptr, uiIndex);
+
+    auto& data = m_DestructData.ExpandAndGetRef();
+    data.m_Func = destructorFunc;
+    data.m_Ptr = ptr;
+
+    m_iNumDestructors.Increment();
+  }
+
+  return ptr;
+}
+
+void nsThreadLinearAllocator::Deallocate(void* pPtr)
+{
+  BaseType::Deallocate(pPtr);
+
+  if (m_iNumDestructors == 0)
+    return;
+
+  NS_LOCK(m_DestructorMutex);
+
+  nsUInt32 uiIndex;
+  if (m_PtrToDestructDataIndexTable.Remove(pPtr, &uiIndex))
+  {
+    auto& data = m_DestructData[uiIndex];
+    data.m_Func = nullptr;
+    data.m_Ptr = nullptr;
+  }
+}
+
+nsThreadLinearAllocator::Marker nsThreadLinearAllocator::GetMarker() const
+{
+  Marker marker;
+  marker.m_PolicyMarker = m_allocator.GetMarker();
+  marker.m_uiUsedBytes = m_uiUsedBytes;
+  marker.m_uiNumDestructors = static_cast<nsUInt32>(m_iNumDestructors);
+  return marker;
+}
+
+void nsThreadLinearAllocator::Rewind(const Marker& marker)
+{
+  NS_ASSERT_DEBUG(marker.m_uiUsedBytes <= m_uiUsedBytes, "Markers must be rewound in reverse order");
+
+  RunDestructors(marker.m_uiNumDestructors);
+
+  m_uiHighWaterMark = nsMath::Max(m_uiHighWaterMark, m_uiUsedBytes);
+  m_uiUsedBytes = marker.m_uiUsedBytes;
+
+  m_allocator.Rewind(marker.m_PolicyMarker);
+}
+
+void nsThreadLinearAllocator::Reset()
+{
+  RunDestructors(0);
+
+  m_uiHighWaterMark = nsMath::Max(m_uiHighWaterMark, m_uiUsedBytes);
+  m_uiUsedBytes = 0;
+
+  m_allocator.Reset();
+
+  nsAllocator::Stats stats;
+  m_allocator.FillStats(stats);
+
+  nsMemoryTracker::SetAllocatorStats(m_Id, stats);
+}
+
+nsUInt64 nsThreadLinearAllocator::GetReservedBytes() const
+{
+  nsAllocator::Stats stats;
+  const_cast<PolicyStack&>(m_allocator).FillStats(stats);
+
+  return stats.m_uiAllocationSize;
+}
+
+void nsThreadLinearAllocator::RunDestructors(nsUInt32 uiFirstIndex)
+{
+  if (m_iNumDestructors == 0)
+    return;
+
+  NS_LOCK(m_DestructorMutex);
+
+  for (nsUInt32 i = m_DestructData.GetCount(); i-- > uiFirstIndex;)
+  {
+    const DestructData data = m_DestructData[i];
+    if (data.m_Func != nullptr)
+    {
+      m_PtrToDestructDataIndexTable.Remove(data.m_Ptr);
+      data.m_Func(data.m_Ptr);
+    }
+  }
+
+  m_DestructData.SetCountUninitialized(uiFirstIndex);
+  m_iNumDestructors = static_cast<nsInt32>(uiFirstIndex);
+}
+
+namespace
+{
+  struct ThreadAllocators
+  {
+    nsThreadLinearAllocator* m_pCurrentAllocator = nullptr;
+    nsThreadLinearAllocator* m_pOtherAllocator = nullptr;
+
+    nsFrameAllocator::ThreadStats m_Stats;
+
+    // once the thread exits, its allocators are handed to the next thread that needs some
+    bool m_bThreadAlive = true;
+  };
+
+  struct ThreadAllocatorsRef
+  {
+    ~ThreadAllocatorsRef();
+
+    ThreadAllocators* m_pAllocators = nullptr;
+    nsUInt32 m_uiGeneration = 0;
+  };
+
+  static nsMutex s_ThreadAllocatorsMutex;
+  static nsDynamicArray<ThreadAllocators*>* s_pThreadAllocators = nullptr;
+
+  // changes on every startup and shutdown, so that threads don't use allocators of a previous run
+  static nsUInt32 s_uiThreadAllocatorsGeneration = 0;
+
+  static thread_local ThreadAllocatorsRef tl_ThreadAllocators;
+
+  ThreadAllocatorsRef::~ThreadAllocatorsRef()
+  {
+    if (m_pAllocators == nullptr)
+      return;
+
+    NS_LOCK(s_ThreadAllocatorsMutex);
+
+    if (m_uiGeneration == s_uiThreadAllocatorsGeneration)
+    {
+      m_pAllocators->m_bThreadAlive = false;
+    }
+  }
+
+  static ThreadAllocators* AcquireThreadAllocators()
+  {
+    NS_LOCK(s_ThreadAllocatorsMutex);
+    NS_ASSERT_DEV(s_pThreadAllocators != nullptr, "The frame allocator has not been started up");
+
+    ThreadAllocators* pAllocators = nullptr;
+
+    for (ThreadAllocators* pExisting : *s_pThreadAllocators)
+    {
+      if (!pExisting->m_bThreadAlive)
+      {
+        pAllocators = pExisting;
+        break;
+      }
+    }
+
+    if (pAllocators == nullptr)
+    {
+      nsStringBuilder sName;
+      sName.SetFormat("ThreadFrameAllocator{}_", s_pThreadAllocators->GetCount());
+
+      pAllocators = NS_DEFAULT_NEW(ThreadAllocators);
+      pAllocators->m_pCurrentAllocator = NS_DEFAULT_NEW(nsThreadLinearAllocator, nsStringBuilder(sName, "0"), nsFoundation::GetAlignedAllocator());
+      pAllocators->m_pOtherAllocator = NS_DEFAULT_NEW(nsThreadLinearAllocator, nsStringBuilder(sName, "1"), nsFoundation::GetAlignedAllocator());
+
+      s_pThreadAllocators->PushBack(pAllocators);
+    }
+
+    pAllocators->m_bThreadAlive = true;
+    pAllocators->m_Stats.m_ThreadID = nsThreadUtils::GetCurrentThreadID();
+
+    tl_ThreadAllocators.m_pAllocators = pAllocators;
+    tl_ThreadAllocators.m_uiGeneration = s_uiThreadAllocatorsGeneration;
+
+    return pAllocators;
+  }
+} // namespace
+
 
 // clang-format off
 NS_BEGIN_SUBSYSTEM_DECLARATION(Foundation, FrameAllocator)
@@ -56,12 +255,58 @@ NS_END_SUBSYSTEM_DECLARATION;
 
 nsDoubleBufferedLinearAllocator* nsFrameAllocator::s_pAllocator;
 
+// static
+nsThreadLinearAllocator* nsFrameAllocator::GetThreadAllocator()
+{
+  ThreadAllocators* pAllocators = tl_ThreadAllocators.m_pAllocators;
+
+  if (pAllocators == nullptr || tl_ThreadAllocators.m_uiGeneration != s_uiThreadAllocatorsGeneration)
+  {
+    pAllocators = AcquireThreadAllocators();
+  }
+
+  return pAllocators->m_pCurrentAllocator;
+}
+
+// static
+void nsFrameAllocator::GetThreadStats(nsDynamicArray<ThreadStats>& out_stats)
+{
+  out_stats.Clear();
+
+  NS_LOCK(s_ThreadAllocatorsMutex);
+
+  if (s_pThreadAllocators == nullptr)
+    return;
+
+  for (const ThreadAllocators* pAllocators : *s_pThreadAllocators)
+  {
+    out_stats.PushBack(pAllocators->m_Stats);
+  }
+}
+
 // static
 void nsFrameAllocator::Swap()
 {
   NS_PROFILE_SCOPE("FrameAllocator.Swap");
 
   s_pAllocator->Swap();
+
+  NS_LOCK(s_ThreadAllocatorsMutex);
+
+  for (ThreadAllocators* pAllocators : *s_pThreadAllocators)
+  {
+    ThreadStats& stats = pAllocators->m_Stats;
+    stats.m_uiLastFrameBytes = pAllocators->m_pCurrentAllocator->GetUsedBytes();
+    stats.m_uiLastFrameHighWaterMark = pAllocators->m_pCurrentAllocator->GetHighWaterMark();
+    stats.m_uiHighWaterMark = nsMath::Max(stats.m_uiHighWaterMark, stats.m_uiLastFrameHighWaterMark);
+
+    nsMath::Swap(pAllocators->m_pCurrentAllocator, pAllocators->m_pOtherAllocator);
+
+    pAllocators->m_pCurrentAllocator->Reset();
+    pAllocators->m_pCurrentAllocator->ResetHighWaterMark();
+
+    stats.m_uiReservedBytes = pAllocators->m_pCurrentAllocator->GetReservedBytes() + pAllocators->m_pOtherAllocator->GetReservedBytes();
+  }
 }
 
 // static
@@ -71,18 +316,58 @@ void nsFrameAllocator::Reset()
   {
     s_pAllocator->Reset();
   }
+
+  NS_LOCK(s_ThreadAllocatorsMutex);
+
+  if (s_pThreadAllocators)
+  {
+    for (ThreadAllocators* pAllocators : *s_pThreadAllocators)
+    {
+      pAllocators->m_pCurrentAllocator->Reset();
+      pAllocators->m_pOtherAllocator->Reset();
+    }
+  }
 }
 
 // static
 void nsFrameAllocator::Startup()
 {
   s_pAllocator = NS_DEFAULT_NEW(nsDoubleBufferedLinearAllocator, "FrameAllocator", nsFoundation::GetAlignedAllocator());
+
+  NS_LOCK(s_ThreadAllocatorsMutex);
+  s_pThreadAllocators = NS_DEFAULT_NEW(nsDynamicArray<ThreadAllocators*>);
+  ++s_uiThreadAllocatorsGeneration;
 }
 
 // static
 void nsFrameAllocator::Shutdown()
 {
   NS_DEFAULT_DELETE(s_pAllocator);
+
+  NS_LOCK(s_ThreadAllocatorsMutex);
+
+  for (ThreadAllocators* pAllocators : *s_pThreadAllocators)
+  {
+    NS_DEFAULT_DELETE(pAllocators->m_pCurrentAllocator);
+    NS_DEFAULT_DELETE(pAllocators->m_pOtherAllocator);
+    NS_DEFAULT_DELETE(pAllocators);
+  }
+
+  NS_DEFAULT_DELETE(s_pThreadAllocators);
+  ++s_uiThreadAllocatorsGeneration;
+}
+
+nsFrameAllocatorScope::nsFrameAllocatorScope()
+  : m_pAllocator(nsFrameAllocator::GetThreadAllocator())
+  , m_Marker(m_pAllocator->GetMarker())
+{
+}
+
+nsFrameAllocatorScope::~nsFrameAllocatorScope()
+{
+  NS_ASSERT_DEV(m_pAllocator == nsFrameAllocator::GetThreadAllocator(), "nsFrameAllocator::Swap() was called while a nsFrameAllocatorScope was active");
+
+  m_pAllocator->Rewind(m_Marker);
 }
 
 NS_STATICLINK_FILE(Foundation, Foundation_Memory_Implementation_FrameAllocator);
@@ -43,8 +43,9 @@ NS_FORCE_INLINE T& nsDataBlock<T, SizeInBytes>::operator[](nsUInt32 uiIndex) con
 ///////////////////////////////////////////////////////////////////////////////////////////////////
 
 template <nsUInt32 BlockSize>
-nsLargeBlockAllocator<BlockSize>::nsLargeBlockAllocator(nsStringView sName, nsAllocator* pParent, nsAllocatorTrackingMode mode)
+nsLargeBlockAllocator<BlockSize>::nsLargeBlockAllocator(nsStringView sName, nsAllocator* pParent, nsAllocatorTrackingMode mode, nsBitflags<nsPageAllocationFlags> pageFlags)
   : m_TrackingMode(mode)
+  , m_PageFlags(pageFlags)
   , m_SuperBlocks(pParent)
   , m_FreeBlocks(pParent)
 {
@@ -110,7 +111,7 @@ NS_ALWAYS_INLINE nsAllocatorId nsLargeBlockAllocator<BlockSize>::GetId() const
 }
 
 template <nsUInt32 BlockSize>
-NS_ALWAYS_INLINE const nsAllocator::Stats& nsLargeBlockAllocator<BlockSize>::GetStats() const
+NS_ALWAYS_INLINE nsAllocator::Stats nsLargeBlockAllocator<BlockSize>::GetStats() const
 {
   return nsMemoryTracker::GetAllocatorStats(m_Id);
 }
@@ -142,7 +143,7 @@ void* nsLargeBlockAllocator<BlockSize>::Allocate(size_t uiAlign)
   else
   {
     // Allocate a new super block
-    void* pMemory = nsPageAllocator::AllocatePage(SuperBlock::SIZE_IN_BYTES);
+    void* pMemory = nsPageAllocator::AllocatePage(SuperBlock::SIZE_IN_BYTES, 0, m_PageFlags);
     NS_CHECK_ALIGNMENT(pMemory, uiAlign);
 
     SuperBlock superBlock;
@@ -1,14 +1,19 @@
 #include <Foundation/FoundationPCH.h>
 
+#include <Foundation/Containers/DynamicArray.h>
 #include <Foundation/Containers/HashTable.h>
 #include <Foundation/Containers/IdTable.h>
+#include <Foundation/IO/Stream.h>
 #include <Foundation/Logging/Log.h>
 #include <Foundation/Memory/AllocatorWithPolicy.h>
 #include <Foundation/Memory/Policies/AllocPolicyHeap.h>
 #include <Foundation/Strings/String.h>
+#include <Foundation/Strings/StringBuilder.h>
 #include <Foundation/System/StackTracer.h>
+#include <Foundation/Threading/AtomicInteger.h>
 #include <Foundation/Threading/Lock.h>
 #include <Foundation/Threading/Mutex.h>
+#include <Foundation/Threading/ReadWriteLock.h>
 
 #if NS_ENABLED(NS_COMPILE_FOR_DEVELOPMENT) && TRACY_ENABLE && TRACY_ENABLE_MEMORY_TRACKING
 #  include <tracy/tracy/Tracy.hpp>
@@ -38,6 +43,57 @@ namespace
   };
 
 
+  // The allocations of each allocator are spread over several tables by pointer hash, each with its own lock,
+  // so that threads that allocate from the same allocator at the same time rarely wait for each other.
+  constexpr nsUInt32 NumAllocationShards = 16;
+
+  using AllocationTable = nsHashTable<const void*, nsMemoryTracker::AllocationInfo, nsHashHelper<const void*>, TrackerDataAllocatorWrapper>;
+
+  struct AllocationShard
+  {
+    nsMutex m_Mutex;
+    AllocationTable m_Allocations;
+  };
+
+  NS_ALWAYS_INLINE nsUInt32 GetShardIndex(const void* pPtr)
+  {
+    // the lower bits are mostly zero due to alignment, the multiplication mixes the remaining ones into the upper bits
+    const nsUInt64 uiHash = (static_cast<nsUInt64>(reinterpret_cast<size_t>(pPtr)) >> 4) * 0x9E3779B97F4A7C15ull;
+    return static_cast<nsUInt32>(uiHash >> 60);
+  }
+
+  static_assert(NumAllocationShards == 16, "GetShardIndex() needs to be adjusted");
+
+  // updated without a lock, a snapshot may be slightly inconsistent while other threads allocate
+  struct AtomicStats
+  {
+    nsAtomicInteger64 m_iNumAllocations;
+    nsAtomicInteger64 m_iNumDeallocations;
+    nsAtomicInteger64 m_iAllocationSize;
+    nsAtomicInteger64 m_iPerFrameAllocationSize;
+    nsAtomicInteger64 m_iPerFrameAllocationTimeNs;
+
+    nsAllocator::Stats GetSnapshot() const
+    {
+      nsAllocator::Stats stats;
+      stats.m_uiNumAllocations = static_cast<nsUInt64>(static_cast<nsInt64>(m_iNumAllocations));
+      stats.m_uiNumDeallocations = static_cast<nsUInt64>(static_cast<nsInt64>(m_iNumDeallocations));
+      stats.m_uiAllocationSize = static_cast<nsUInt64>(static_cast<nsInt64>(m_iAllocationSize));
+      stats.m_uiPerFrameAllocationSize = static_cast<nsUInt64>(static_cast<nsInt64>(m_iPerFrameAllocationSize));
+      stats.m_PerFrameAllocationTime = nsTime::MakeFromNanoseconds(static_cast<double>(static_cast<nsInt64>(m_iPerFrameAllocationTimeNs)));
+      return stats;
+    }
+
+    void SetSnapshot(const nsAllocator::Stats& stats)
+    {
+      m_iNumAllocations = static_cast<nsInt64>(stats.m_uiNumAllocations);
+      m_iNumDeallocations = static_cast<nsInt64>(stats.m_uiNumDeallocations);
+      m_iAllocationSize = static_cast<nsInt64>(stats.m_uiAllocationSize);
+      m_iPerFrameAllocationSize = static_cast<nsInt64>(stats.m_uiPerFrameAllocationSize);
+      m_iPerFrameAllocationTimeNs = static_cast<nsInt64>(stats.m_PerFrameAllocationTime.GetNanoseconds());
+    }
+  };
+
   struct AllocatorData
   {
     NS_ALWAYS_INLINE AllocatorData() = default;
@@ -47,19 +103,35 @@ namespace
 
     nsAllocatorId m_ParentId;
 
-    nsAllocator::Stats m_Stats;
+    AtomicStats m_Stats;
+
+    AllocationShard m_Shards[NumAllocationShards];
+
+    NS_ALWAYS_INLINE AllocationShard& GetShard(const void* pPtr) { return m_Shards[GetShardIndex(pPtr)]; }
+
+    nsUInt32 GetNumAllocations() const
+    {
+      nsUInt32 uiCount = 0;
+      for (const AllocationShard& shard : m_Shards)
+      {
+        uiCount += shard.m_Allocations.GetCount();
+      }
+      return uiCount;
+    }
 
-    nsHashTable<const void*, nsMemoryTracker::AllocationInfo, nsHashHelper<const void*>, TrackerDataAllocatorWrapper> m_Allocations;
+    bool TryGetAllocationInfo(const void* pPtr, const nsMemoryTracker::AllocationInfo*& out_pInfo) const
+    {
+      return m_Shards[GetShardIndex(pPtr)].m_Allocations.TryGetValue(pPtr, out_pInfo);
+    }
   };
 
+  // The table lock is only taken exclusively to add or remove allocators and for leak reports.
+  // Tracking an allocation only needs a shared lock on the table and the lock of one shard.
   struct TrackerData
   {
-    NS_ALWAYS_INLINE void Lock() { m_Mutex.Lock(); }
-    NS_ALWAYS_INLINE void Unlock() { m_Mutex.Unlock(); }
+    nsReadWriteLock m_TableLock;
 
-    nsMutex m_Mutex;
-
-    using AllocatorTable = nsIdTable<nsAllocatorId, AllocatorData, TrackerDataAllocatorWrapper>;
+    using AllocatorTable = nsIdTable<nsAllocatorId, AllocatorData*, TrackerDataAllocatorWrapper>;
     AllocatorTable m_AllocatorData;
   };
 
@@ -108,6 +180,8 @@ namespace
 
     nsLog::Print("--------------------------------------------------------------------\n\n");
   }
+
+  static void RemoveSamplesOfAllocator(nsAllocatorId allocatorId);
 } // namespace
 
 // Iterator
@@ -120,17 +194,17 @@ nsAllocatorId nsMemoryTracker::Iterator::Id() const
 
 nsStringView nsMemoryTracker::Iterator::Name() const
 {
-  return CAST_ITER(m_pData)->Value().m_sName;
+  return CAST_ITER(m_pData)->Value()->m_sName;
 }
 
 nsAllocatorId nsMemoryTracker::Iterator::ParentId() const
 {
-  return CAST_ITER(m_pData)->Value().m_ParentId;
+  return CAST_ITER(m_pData)->Value()->m_ParentId;
 }
 
-const nsAllocator::Stats& nsMemoryTracker::Iterator::Stats() const
+nsAllocator::Stats nsMemoryTracker::Iterator::Stats() const
 {
-  return CAST_ITER(m_pData)->Value().m_Stats;
+  return CAST_ITER(m_pData)->Value()->m_Stats.GetSnapshot();
 }
 
 void nsMemoryTracker::Iterator::Next()
@@ -156,41 +230,52 @@ nsAllocatorId nsMemoryTracker::RegisterAllocator(nsStringView sName, nsAllocator
 {
   Initialize();
 
-  NS_LOCK(*s_pTrackerData);
+  AllocatorData* pData = NS_NEW(s_pTrackerDataAllocator, AllocatorData);
+  pData->m_sName = sName;
+  pData->m_TrackingMode = mode;
+  pData->m_ParentId = parentId;
 
-  AllocatorData data;
-  data.m_sName = sName;
-  data.m_TrackingMode = mode;
-  data.m_ParentId = parentId;
+  NS_LOCK_WRITE(s_pTrackerData->m_TableLock);
 
-  return s_pTrackerData->m_AllocatorData.Insert(data);
+  return s_pTrackerData->m_AllocatorData.Insert(pData);
 }
 
 // static
 void nsMemoryTracker::DeregisterAllocator(nsAllocatorId allocatorId)
 {
-  NS_LOCK(*s_pTrackerData);
+  AllocatorData* pData = nullptr;
 
-  const AllocatorData& data = s_pTrackerData->m_AllocatorData[allocatorId];
-
-  nsUInt32 uiLiveAllocations = data.m_Allocations.GetCount();
-  if (uiLiveAllocations != 0 && data.m_TrackingMode > nsAllocatorTrackingMode::AllocationStatsIgnoreLeaks)
   {
-    for (auto it = data.m_Allocations.GetIterator(); it.IsValid(); ++it)
+    NS_LOCK_WRITE(s_pTrackerData->m_TableLock);
+
+    pData = s_pTrackerData->m_AllocatorData[allocatorId];
+
+    nsUInt32 uiLiveAllocations = pData->GetNumAllocations();
+    if (uiLiveAllocations != 0 && pData->m_TrackingMode > nsAllocatorTrackingMode::AllocationStatsIgnoreLeaks)
     {
-      DumpLeak(it.Value(), data.m_sName.GetData());
+      for (const AllocationShard& shard : pData->m_Shards)
+      {
+        for (auto it = shard.m_Allocations.GetIterator(); it.IsValid(); ++it)
+        {
+          DumpLeak(it.Value(), pData->m_sName.GetData());
+        }
+      }
+
+      NS_REPORT_FAILURE("Allocator '{0}' leaked {1} allocation(s)", pData->m_sName.GetData(), uiLiveAllocations);
     }
 
-    NS_REPORT_FAILURE("Allocator '{0}' leaked {1} allocation(s)", data.m_sName.GetData(), uiLiveAllocations);
+    s_pTrackerData->m_AllocatorData.Remove(allocatorId);
   }
 
-  s_pTrackerData->m_AllocatorData.Remove(allocatorId);
+  RemoveSamplesOfAllocator(allocatorId);
+
+  NS_DELETE(s_pTrackerDataAllocator, pData);
 }
 
 // static
 void nsMemoryTracker::AddAllocation(nsAllocatorId allocatorId, nsAllocatorTrackingMode mode, const void* pPtr, size_t uiSize, size_t uiAlign, nsTime allocationTime)
 {
-  NS_ASSERT_DEV(uiAlign < 0xFFFF, "Alignment too big");
+  NS_ASSERT_DEV(uiAlign <= 0xFFFFFFFF, "Alignment too big");
 
   nsArrayPtr<void*> stackTrace;
   if (mode >= nsAllocatorTrackingMode::AllocationStatsAndStacktraces)
@@ -204,18 +289,23 @@ void nsMemoryTracker::AddAllocation(nsAllocatorId allocatorId, nsAllocatorTracki
   }
 
   {
-    NS_LOCK(*s_pTrackerData);
+    NS_LOCK_READ(s_pTrackerData->m_TableLock);
 
-    AllocatorData& data = s_pTrackerData->m_AllocatorData[allocatorId];
-    data.m_Stats.m_uiNumAllocations++;
-    data.m_Stats.m_uiAllocationSize += uiSize;
-    data.m_Stats.m_uiPerFrameAllocationSize += uiSize;
-    data.m_Stats.m_PerFrameAllocationTime += allocationTime;
+    AllocatorData& data = *s_pTrackerData->m_AllocatorData[allocatorId];
+    data.m_Stats.m_iNumAllocations.Increment();
+    data.m_Stats.m_iAllocationSize.Add(static_cast<nsInt64>(uiSize));
+    data.m_Stats.m_iPerFrameAllocationSize.Add(static_cast<nsInt64>(uiSize));
+    data.m_Stats.m_iPerFrameAllocationTimeNs.Add(static_cast<nsInt64>(allocationTime.GetNanoseconds()));
 
-    auto pInfo = &data.m_Allocations[pPtr];
-    pInfo->m_uiSize = uiSize;
-    pInfo->m_uiAlignment = (nsUInt16)uiAlign;
-    pInfo->SetStackTrace(stackTrace);
+    {
+      AllocationShard& shard = data.GetShard(pPtr);
+      NS_LOCK(shard.m_Mutex);
+
+      auto pInfo = &shard.m_Allocations[pPtr];
+      pInfo->m_uiSize = uiSize;
+      pInfo->m_uiAlignment = (nsUInt32)uiAlign;
+      pInfo->SetStackTrace(stackTrace);
+    }
 
     if (mode >= nsAllocatorTrackingMode::AllocationStatsAndStacktraces)
     {
@@ -234,15 +324,24 @@ void nsMemoryTracker::RemoveAllocation(nsAllocatorId allocatorId, const void* pP
   nsArrayPtr<void*> stackTrace;
 
   {
-    NS_LOCK(*s_pTrackerData);
+    NS_LOCK_READ(s_pTrackerData->m_TableLock);
 
-    AllocatorData& data = s_pTrackerData->m_AllocatorData[allocatorId];
+    AllocatorData& data = *s_pTrackerData->m_AllocatorData[allocatorId];
 
     AllocationInfo info;
-    if (data.m_Allocations.Remove(pPtr, &info))
+    bool bFound = false;
+
     {
-      data.m_Stats.m_uiNumDeallocations++;
-      data.m_Stats.m_uiAllocationSize -= info.m_uiSize;
+      AllocationShard& shard = data.GetShard(pPtr);
+      NS_LOCK(shard.m_Mutex);
+
+      bFound = shard.m_Allocations.Remove(pPtr, &info);
+    }
+
+    if (bFound)
+    {
+      data.m_Stats.m_iNumDeallocations.Increment();
+      data.m_Stats.m_iAllocationSize.Subtract(static_cast<nsInt64>(info.m_uiSize));
 
       stackTrace = info.GetStackTrace();
 
@@ -267,89 +366,90 @@ void nsMemoryTracker::RemoveAllocation(nsAllocatorId allocatorId, const void* pP
 // static
 void nsMemoryTracker::RemoveAllAllocations(nsAllocatorId allocatorId)
 {
-  NS_LOCK(*s_pTrackerData);
-  AllocatorData& data = s_pTrackerData->m_AllocatorData[allocatorId];
-  for (auto it = data.m_Allocations.GetIterator(); it.IsValid(); ++it)
+  NS_LOCK_READ(s_pTrackerData->m_TableLock);
+  AllocatorData& data = *s_pTrackerData->m_AllocatorData[allocatorId];
+
+  for (AllocationShard& shard : data.m_Shards)
   {
-    auto& info = it.Value();
-    data.m_Stats.m_uiNumDeallocations++;
-    data.m_Stats.m_uiAllocationSize -= info.m_uiSize;
+    NS_LOCK(shard.m_Mutex);
 
-    if (data.m_TrackingMode >= nsAllocatorTrackingMode::AllocationStatsAndStacktraces)
+    for (auto it = shard.m_Allocations.GetIterator(); it.IsValid(); ++it)
     {
-      for (const auto& alloc : data.m_Allocations)
+      auto& info = it.Value();
+      data.m_Stats.m_iNumDeallocations.Increment();
+      data.m_Stats.m_iAllocationSize.Subtract(static_cast<nsInt64>(info.m_uiSize));
+
+      if (data.m_TrackingMode >= nsAllocatorTrackingMode::AllocationStatsAndStacktraces)
       {
-        NS_IGNORE_UNUSED(alloc);
-        NS_TRACY_FREE_CS(alloc.Key(), data.m_sName.GetData());
+        NS_TRACY_FREE_CS(it.Key(), data.m_sName.GetData());
       }
-    }
-    else
-    {
-      for (const auto& alloc : data.m_Allocations)
+      else
       {
-        NS_IGNORE_UNUSED(alloc);
-        NS_TRACY_FREE(alloc.Key(), data.m_sName.GetData());
+        NS_TRACY_FREE(it.Key(), data.m_sName.GetData());
       }
+
+      NS_DELETE_ARRAY(s_pTrackerDataAllocator, info.GetStackTrace());
     }
 
-    NS_DELETE_ARRAY(s_pTrackerDataAllocator, info.GetStackTrace());
+    shard.m_Allocations.Clear();
   }
-  data.m_Allocations.Clear();
 }
 
 // static
 void nsMemoryTracker::SetAllocatorStats(nsAllocatorId allocatorId, const nsAllocator::Stats& stats)
 {
-  NS_LOCK(*s_pTrackerData);
+  NS_LOCK_READ(s_pTrackerData->m_TableLock);
 
-  s_pTrackerData->m_AllocatorData[allocatorId].m_Stats = stats;
+  s_pTrackerData->m_AllocatorData[allocatorId]->m_Stats.SetSnapshot(stats);
 }
 
 // static
 void nsMemoryTracker::ResetPerFrameAllocatorStats()
 {
-  NS_LOCK(*s_pTrackerData);
+  NS_LOCK_READ(s_pTrackerData->m_TableLock);
 
   for (auto it = s_pTrackerData->m_AllocatorData.GetIterator(); it.IsValid(); ++it)
   {
-    AllocatorData& data = it.Value();
-    data.m_Stats.m_uiPerFrameAllocationSize = 0;
-    data.m_Stats.m_PerFrameAllocationTime = nsTime::MakeZero();
+    AllocatorData& data = *it.Value();
+    data.m_Stats.m_iPerFrameAllocationSize = 0;
+    data.m_Stats.m_iPerFrameAllocationTimeNs = 0;
   }
 }
 
 // static
 nsStringView nsMemoryTracker::GetAllocatorName(nsAllocatorId allocatorId)
 {
-  NS_LOCK(*s_pTrackerData);
+  NS_LOCK_READ(s_pTrackerData->m_TableLock);
 
-  return s_pTrackerData->m_AllocatorData[allocatorId].m_sName;
+  return s_pTrackerData->m_AllocatorData[allocatorId]->m_sName;
 }
 
 // static
-const nsAllocator::Stats& nsMemoryTracker::GetAllocatorStats(nsAllocatorId allocatorId)
+nsAllocator::Stats nsMemoryTracker::GetAllocatorStats(nsAllocatorId allocatorId)
 {
-  NS_LOCK(*s_pTrackerData);
+  NS_LOCK_READ(s_pTrackerData->m_TableLock);
 
-  return s_pTrackerData->m_AllocatorData[allocatorId].m_Stats;
+  return s_pTrackerData->m_AllocatorData[allocatorId]->m_Stats.GetSnapshot();
 }
 
 // static
 nsAllocatorId nsMemoryTracker::GetAllocatorParentId(nsAllocatorId allocatorId)
 {
-  NS_LOCK(*s_pTrackerData);
+  NS_LOCK_READ(s_pTrackerData->m_TableLock);
 
-  return s_pTrackerData->m_AllocatorData[allocatorId].m_ParentId;
+  return s_pTrackerData->m_AllocatorData[allocatorId]->m_ParentId;
 }
 
 // static
 const nsMemoryTracker::AllocationInfo& nsMemoryTracker::GetAllocationInfo(nsAllocatorId allocatorId, const void* pPtr)
 {
-  NS_LOCK(*s_pTrackerData);
+  NS_LOCK_READ(s_pTrackerData->m_TableLock);
+
+  AllocationShard& shard = s_pTrackerData->m_AllocatorData[allocatorId]->GetShard(pPtr);
+  NS_LOCK(shard.m_Mutex);
 
-  const AllocatorData& data = s_pTrackerData->m_AllocatorData[allocatorId];
   const AllocationInfo* info = nullptr;
-  if (data.m_Allocations.TryGetValue(pPtr, info))
+  if (shard.m_Allocations.TryGetValue(pPtr, info))
   {
     return *info;
   }
@@ -375,26 +475,30 @@ nsUInt32 nsMemoryTracker::PrintMemoryLeaks(PrintFunc printfunc)
   if (s_pTrackerData == nullptr) // if both tracking and tracing is disabled there is no tracker data
     return 0;
 
-  NS_LOCK(*s_pTrackerData);
+  // blocks all tracking while the leaks are collected
+  NS_LOCK_WRITE(s_pTrackerData->m_TableLock);
 
   nsHashTable<const void*, LeakInfo, nsHashHelper<const void*>, TrackerDataAllocatorWrapper> leakTable;
 
   // first collect all leaks
   for (auto it = s_pTrackerData->m_AllocatorData.GetIterator(); it.IsValid(); ++it)
   {
-    const AllocatorData& data = it.Value();
-    for (auto it2 = data.m_Allocations.GetIterator(); it2.IsValid(); ++it2)
+    const AllocatorData& data = *it.Value();
+    for (const AllocationShard& shard : data.m_Shards)
     {
-      LeakInfo leak;
-      leak.m_AllocatorId = it.Id();
-      leak.m_uiSize = it2.Value().m_uiSize;
-
-      if (data.m_TrackingMode == nsAllocatorTrackingMode::AllocationStatsIgnoreLeaks)
+      for (auto it2 = shard.m_Allocations.GetIterator(); it2.IsValid(); ++it2)
       {
-        leak.m_bIsRootLeak = false;
-      }
+        LeakInfo leak;
+        leak.m_AllocatorId = it.Id();
+        leak.m_uiSize = it2.Value().m_uiSize;
 
-      leakTable.Insert(it2.Key(), leak);
+        if (data.m_TrackingMode == nsAllocatorTrackingMode::AllocationStatsIgnoreLeaks)
+        {
+          leak.m_bIsRootLeak = false;
+        }
+
+        leakTable.Insert(it2.Key(), leak);
+      }
     }
   }
 
@@ -431,7 +535,7 @@ nsUInt32 nsMemoryTracker::PrintMemoryLeaks(PrintFunc printfunc)
 
     if (leak.m_bIsRootLeak)
     {
-      const AllocatorData& data = s_pTrackerData->m_AllocatorData[leak.m_AllocatorId];
+      const AllocatorData& data = *s_pTrackerData->m_AllocatorData[leak.m_AllocatorId];
 
       if (data.m_TrackingMode != nsAllocatorTrackingMode::AllocationStatsIgnoreLeaks)
       {
@@ -442,10 +546,10 @@ nsUInt32 nsMemoryTracker::PrintMemoryLeaks(PrintFunc printfunc)
                     "\n--------------------------------------------------------------------\n\n");
         }
 
-        nsMemoryTracker::AllocationInfo info;
-        data.m_Allocations.TryGetValue(ptr, info);
+        const nsMemoryTracker::AllocationInfo* pInfo = nullptr;
+        data.TryGetAllocationInfo(ptr, pInfo);
 
-        DumpLeak(info, data.m_sName.GetData());
+        DumpLeak(*pInfo, data.m_sName.GetData());
 
         ++uiNumLeaks;
       }
@@ -483,3 +587,347 @@ nsMemoryTracker::Iterator nsMemoryTracker::GetIterator()
   auto pInnerIt = NS_NEW(s_pTrackerDataAllocator, TrackerData::AllocatorTable::Iterator, s_pTrackerData->m_AllocatorData.GetIterator());
   return Iterator(pInnerIt);
 }
+
+//////////////////////////////////////////////////////////////////////////
+// Allocation Sampling
+
+namespace
+{
+  constexpr nsUInt32 MaxSampledStackDepth = 48;
+
+  struct SampledCallSite
+  {
+    nsAllocatorId m_AllocatorId;
+    nsUInt32 m_uiStackTraceLength = 0;
+    void* m_StackTrace[MaxSampledStackDepth];
+
+    nsUInt64 m_uiNumLiveSamples = 0;
+    nsUInt64 m_uiEstimatedLiveBytes = 0;
+  };
+
+  struct SampledAllocation
+  {
+    NS_DECLARE_POD_TYPE();
+
+    nsUInt64 m_uiCallSite;
+    nsUInt64 m_uiEstimatedBytes;
+  };
+
+  // Sampled allocations are rare, so a single lock is fine. Deallocations only take it, if the pointer may have been sampled.
+  struct SamplingData
+  {
+    nsMutex m_Mutex;
+    nsHashTable<const void*, SampledAllocation, nsHashHelper<const void*>, TrackerDataAllocatorWrapper> m_Allocations;
+    nsHashTable<nsUInt64, SampledCallSite*, nsHashHelper<nsUInt64>, TrackerDataAllocatorWrapper> m_CallSites;
+  };
+
+  static SamplingData* s_pSamplingData;
+  static nsAtomicInteger32 s_iSamplingInterval;
+
+  // Counts the live samples per pointer hash, a deallocation whose counter is zero can't have been sampled.
+  constexpr nsUInt32 SampleFilterSize = 4096;
+  static nsAtomicInteger32 s_SampleFilter[SampleFilterSize];
+  static nsAtomicInteger32 s_iNumLiveSamples;
+
+  NS_ALWAYS_INLINE nsUInt32 GetSampleFilterIndex(const void* pPtr)
+  {
+    const nsUInt64 uiHash = (static_cast<nsUInt64>(reinterpret_cast<size_t>(pPtr)) >> 4) * 0x9E3779B97F4A7C15ull;
+    return static_cast<nsUInt32>(uiHash >> 52);
+  }
+
+  static_assert(SampleFilterSize == 4096, "GetSampleFilterIndex() needs to be adjusted");
+
+  struct SamplingThreadState
+  {
+    nsInt64 m_iBytesUntilSample = 0;
+    nsUInt32 m_uiInterval = 0;
+    nsUInt64 m_uiRandomState = 0;
+  };
+
+  static thread_local SamplingThreadState t_SamplingState;
+
+  // exponentially distributed with the interval as mean value, this makes the chance to be sampled the same for every byte
+  static nsInt64 DrawSampleDistance(SamplingThreadState& ref_state)
+  {
+    if (ref_state.m_uiRandomState == 0)
+    {
+      static nsAtomicInteger64 s_iSeed;
+      ref_state.m_uiRandomState = static_cast<nsUInt64>(s_iSeed.Increment()) * 0x9E3779B97F4A7C15ull | 1;
+    }
+
+    // xorshift64*
+    ref_state.m_uiRandomState ^= ref_state.m_uiRandomState >> 12;
+    ref_state.m_uiRandomState ^= ref_state.m_uiRandomState << 25;
+    ref_state.m_uiRandomState ^= ref_state.m_uiRandomState >> 27;
+    const nsUInt64 uiRandom = ref_state.m_uiRandomState * 0x2545F4914F6CDD1Dull;
+
+    // uniform in (0, 1]
+    const float fUniform = static_cast<float>((uiRandom >> 40) + 1) * (1.0f / 16777216.0f);
+    return static_cast<nsInt64>(-nsMath::Ln(fUniform) * ref_state.m_uiInterval) + 1;
+  }
+
+  static SamplingData& GetSamplingData()
+  {
+    if (s_pSamplingData == nullptr)
+    {
+      Initialize();
+
+      alignas(alignof(SamplingData)) static nsUInt8 SamplingDataBuffer[sizeof(SamplingData)];
+      s_pSamplingData = new (SamplingDataBuffer) SamplingData();
+    }
+
+    return *s_pSamplingData;
+  }
+
+  static void RemoveSample(SamplingData& data, const void* pPtr, const SampledAllocation& sample)
+  {
+    SampledCallSite* pCallSite = nullptr;
+    if (data.m_CallSites.TryGetValue(sample.m_uiCallSite, pCallSite))
+    {
+      pCallSite->m_uiNumLiveSamples--;
+      pCallSite->m_uiEstimatedLiveBytes -= sample.m_uiEstimatedBytes;
+    }
+
+    s_SampleFilter[GetSampleFilterIndex(pPtr)].Decrement();
+    s_iNumLiveSamples.Decrement();
+  }
+
+  static void RemoveSamplesOfAllocator(nsAllocatorId allocatorId)
+  {
+    if (s_pSamplingData == nullptr)
+      return;
+
+    SamplingData& data = *s_pSamplingData;
+    NS_LOCK(data.m_Mutex);
+
+    for (auto it = data.m_Allocations.GetIterator(); it.IsValid();)
+    {
+      SampledCallSite* pCallSite = nullptr;
+      if (data.m_CallSites.TryGetValue(it.Value().m_uiCallSite, pCallSite) && pCallSite->m_AllocatorId == allocatorId)
+      {
+        RemoveSample(data, it.Key(), it.Value());
+        it = data.m_Allocations.Remove(it);
+      }
+      else
+      {
+        ++it;
+      }
+    }
+  }
+} // namespace
+
+// static
+void nsMemoryTracker::SetSamplingInterval(nsUInt32 uiBytes)
+{
+  if (uiBytes != 0)
+  {
+    // make sure everything exists before the first sample is taken
+    GetSamplingData();
+  }
+
+  s_iSamplingInterval = static_cast<nsInt32>(nsMath::Min<nsUInt32>(uiBytes, nsMath::MaxValue<nsInt32>()));
+}
+
+// static
+nsUInt32 nsMemoryTracker::GetSamplingInterval()
+{
+  return static_cast<nsUInt32>(static_cast<nsInt32>(s_iSamplingInterval));
+}
+
+// static
+void nsMemoryTracker::SampleAllocation(nsAllocatorId allocatorId, const void* pPtr, size_t uiSize)
+{
+  const nsUInt32 uiInterval = static_cast<nsUInt32>(static_cast<nsInt32>(s_iSamplingInterval));
+
+  if (uiInterval == 0 || pPtr == nullptr)
+    return;
+
+  SamplingThreadState& state = t_SamplingState;
+
+  if (state.m_uiInterval != uiInterval)
+  {
+    state.m_uiInterval = uiInterval;
+    state.m_iBytesUntilSample = DrawSampleDistance(state);
+  }
+
+  state.m_iBytesUntilSample -= static_cast<nsInt64>(uiSize);
+
+  if (state.m_iBytesUntilSample > 0)
+    return;
+
+  state.m_iBytesUntilSample = DrawSampleDistance(state);
+
+  void* pBuffer[MaxSampledStackDepth];
+  nsArrayPtr<void*> stackTrace(pBuffer);
+  const nsUInt32 uiStackTraceLength = nsStackTracer::GetStackTrace(stackTrace);
+
+  nsUInt64 uiCallSite = nsHashingUtils::xxHash64(pBuffer, uiStackTraceLength * sizeof(void*), allocatorId.m_Data);
+
+  // An allocation of size s is sampled with a probability of 1 - e^(-s/interval).
+  // Dividing by that probability gives the expected amount of memory this sample represents.
+  const float fSize = static_cast<float>(uiSize);
+  const float fProbability = 1.0f - nsMath::Exp(-fSize / uiInterval);
+  const nsUInt64 uiEstimatedBytes = static_cast<nsUInt64>(fSize / nsMath::Max(fProbability, 0.000001f));
+
+  SamplingData& data = *s_pSamplingData;
+  NS_LOCK(data.m_Mutex);
+
+  SampledCallSite* pCallSite = nullptr;
+  if (!data.m_CallSites.TryGetValue(uiCallSite, pCallSite))
+  {
+    pCallSite = NS_NEW(s_pTrackerDataAllocator, SampledCallSite);
+    pCallSite->m_AllocatorId = allocatorId;
+    pCallSite->m_uiStackTraceLength = uiStackTraceLength;
+    nsMemoryUtils::Copy(pCallSite->m_StackTrace, pBuffer, uiStackTraceLength);
+
+    data.m_CallSites.Insert(uiCallSite, pCallSite);
+  }
+
+  pCallSite->m_uiNumLiveSamples++;
+  pCallSite->m_uiEstimatedLiveBytes += uiEstimatedBytes;
+
+  SampledAllocation sample;
+  sample.m_uiCallSite = uiCallSite;
+  sample.m_uiEstimatedBytes = uiEstimatedBytes;
+
+  SampledAllocation oldSample;
+  if (data.m_Allocations.Insert(pPtr, sample, &oldSample))
+  {
+    // the memory was freed without telling us, e.g. by nsLinearAllocator::Reset()
+    RemoveSample(data, pPtr, oldSample);
+  }
+
+  s_SampleFilter[GetSampleFilterIndex(pPtr)].Increment();
+  s_iNumLiveSamples.Increment();
+}
+
+// static
+void nsMemoryTracker::RemoveSampledAllocation(const void* pPtr)
+{
+  if (s_iNumLiveSamples == 0 || s_SampleFilter[GetSampleFilterIndex(pPtr)] == 0)
+    return;
+
+  SamplingData& data = *s_pSamplingData;
+  NS_LOCK(data.m_Mutex);
+
+  SampledAllocation sample;
+  if (data.m_Allocations.Remove(pPtr, &sample))
+  {
+    RemoveSample(data, pPtr, sample);
+  }
+}
+
+// static
+nsMemoryTracker::SamplingStats nsMemoryTracker::GetSamplingStats(nsAllocatorId allocatorId)
+{
+  SamplingStats stats;
+
+  if (s_pSamplingData == nullptr)
+    return stats;
+
+  SamplingData& data = *s_pSamplingData;
+  NS_LOCK(data.m_Mutex);
+
+  for (auto it = data.m_CallSites.GetIterator(); it.IsValid(); ++it)
+  {
+    const SampledCallSite& callSite = *it.Value();
+
+    if (!allocatorId.IsInvalidated() && callSite.m_AllocatorId != allocatorId)
+      continue;
+
+    stats.m_uiNumLiveSamples += callSite.m_uiNumLiveSamples;
+    stats.m_uiEstimatedLiveBytes += callSite.m_uiEstimatedLiveBytes;
+    stats.m_uiNumCallSites++;
+  }
+
+  return stats;
+}
+
+// static
+nsResult nsMemoryTracker::WriteSampledAllocations(nsStreamWriter& inout_stream)
+{
+  if (s_pSamplingData == nullptr)
+    return NS_SUCCESS;
+
+  // Copy the call sites first. Resolving symbols and writing to the stream may allocate, which may take samples.
+  nsDynamicArray<SampledCallSite, TrackerDataAllocatorWrapper> callSites;
+
+  {
+    SamplingData& data = *s_pSamplingData;
+    NS_LOCK(data.m_Mutex);
+
+    callSites.Reserve(data.m_CallSites.GetCount());
+
+    for (auto it = data.m_CallSites.GetIterator(); it.IsValid(); ++it)
+    {
+      if (it.Value()->m_uiEstimatedLiveBytes > 0)
+      {
+        callSites.PushBack(*it.Value());
+      }
+    }
+  }
+
+  nsStringBuilder sLine;
+  nsDynamicArray<nsString> frames;
+
+  for (const SampledCallSite& callSite : callSites)
+  {
+    frames.Clear();
+    nsStackTracer::ResolveStackTrace(nsArrayPtr<void*>(const_cast<void**>(callSite.m_StackTrace), callSite.m_uiStackTraceLength), [&](const char* szText)
+      {
+        nsStringBuilder sFrame = szText;
+        sFrame.Trim(" \t\r\n");
+        sFrame.ReplaceAll(";", ":");
+        frames.PushBack(sFrame);
+      });
+
+    {
+      // the allocator may have been destroyed in the meantime
+      NS_LOCK_READ(s_pTrackerData->m_TableLock);
+
+      AllocatorData* pAllocatorData = nullptr;
+      if (s_pTrackerData->m_AllocatorData.TryGetValue(callSite.m_AllocatorId, pAllocatorData))
+        sLine = pAllocatorData->m_sName;
+      else
+        sLine = "<unknown allocator>";
+    }
+
+    sLine.ReplaceAll(";", ":");
+
+    // stack traces start with the innermost frame
+    for (nsUInt32 i = frames.GetCount(); i > 0; --i)
+    {
+      sLine.Append(";", frames[i - 1]);
+    }
+
+    sLine.AppendFormat(" {}\n", callSite.m_uiEstimatedLiveBytes);
+
+    NS_SUCCEED_OR_RETURN(inout_stream.WriteBytes(sLine.GetData(), sLine.GetElementCount()));
+  }
+
+  return NS_SUCCESS;
+}
+
+// static
+void nsMemoryTracker::ResetSampledAllocations()
+{
+  if (s_pSamplingData == nullptr)
+    return;
+
+  SamplingData& data = *s_pSamplingData;
+  NS_LOCK(data.m_Mutex);
+
+  for (auto it = data.m_Allocations.GetIterator(); it.IsValid(); ++it)
+  {
+    s_SampleFilter[GetSampleFilterIndex(it.Key())].Decrement();
+    s_iNumLiveSamples.Decrement();
+  }
+
+  for (auto it = data.m_CallSites.GetIterator(); it.IsValid(); ++it)
+  {
+    NS_DELETE(s_pTrackerDataAllocator, it.Value());
+  }
+
+  data.m_Allocations.Clear();
+  data.m_CallSites.Clear();
+}
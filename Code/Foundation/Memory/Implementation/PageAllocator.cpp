@@ -1,7 +1,76 @@
 #include <Foundation/FoundationPCH.h>
 
+#include <Foundation/Containers/HashTable.h>
+#include <Foundation/Containers/HybridArray.h>
+#include <Foundation/Memory/AllocatorWithPolicy.h>
 #include <Foundation/Memory/MemoryTracker.h>
 #include <Foundation/Memory/PageAllocator.h>
+#include <Foundation/Memory/Policies/AllocPolicyHeap.h>
+#include <Foundation/Threading/AtomicInteger.h>
+#include <Foundation/Threading/Lock.h>
+#include <Foundation/Threading/Mutex.h>
+
+namespace
+{
+  // page allocations are used by other allocators, so the bookkeeping must not use any of them
+  using PageDataAllocator = nsAllocatorWithPolicy<nsAllocPolicyHeap, nsAllocatorTrackingMode::Nothing>;
+
+  static PageDataAllocator* s_pPageDataAllocator;
+
+  struct PageDataAllocatorWrapper
+  {
+    NS_ALWAYS_INLINE static nsAllocator* GetAllocator() { return s_pPageDataAllocator; }
+  };
+
+  struct Reservation
+  {
+    void* m_pPtr = nullptr;
+    size_t m_uiSize = 0;
+    nsUInt64 m_uiCommittedBytes = 0;
+    bool m_bHugePages = false;
+  };
+
+  struct PageData
+  {
+    // only protects the recorded pages and the reservations, the stats are updated without it
+    nsMutex m_Mutex;
+
+    // plain allocations are not recorded, only those that have to be unmapped or count towards the huge page stats
+    nsHashTable<void*, nsUInt64, nsHashHelper<void*>, PageDataAllocatorWrapper> m_Pages;
+    nsAtomicInteger32 m_iNumRecordedPages;
+
+    // there are only few reservations, they are searched linearly
+    nsHybridArray<Reservation, 16, PageDataAllocatorWrapper> m_Reservations;
+
+    nsAtomicInteger64 m_iAllocatedBytes;
+    nsAtomicInteger64 m_iReservedBytes;
+    nsAtomicInteger64 m_iCommittedBytes;
+    nsAtomicInteger64 m_iHugePageRequestedBytes;
+    nsAtomicInteger64 m_iExplicitHugePageBytes;
+    nsAtomicInteger64 m_iNumExplicitHugePageFailures;
+  };
+
+  static PageData& GetPageData()
+  {
+    alignas(PageDataAllocator) static nsUInt8 s_AllocatorBuffer[sizeof(PageDataAllocator)];
+    alignas(PageData) static nsUInt8 s_DataBuffer[sizeof(PageData)];
+
+    // never destroyed, pages may still be freed by static destructors
+    static PageData* s_pData = []()
+    {
+      s_pPageDataAllocator = new (s_AllocatorBuffer) PageDataAllocator("PageAllocatorData");
+      return new (s_DataBuffer) PageData();
+    }();
+
+    return *s_pData;
+  }
+
+  // the page info is packed into one value: the size, and the flags in the top bits
+  constexpr nsUInt64 ExplicitHugePagesBit = 1ull << 63;
+  constexpr nsUInt64 HugePagesRequestedBit = 1ull << 62;
+  constexpr nsUInt64 MappedBit = 1ull << 61;
+  constexpr nsUInt64 SizeMask = MappedBit - 1;
+} // namespace
 
 nsAllocatorId nsPageAllocator::GetId()
 {
@@ -14,3 +83,161 @@ nsAllocatorId nsPageAllocator::GetId()
 
   return id;
 }
+
+// static
+nsPageAllocator::Stats nsPageAllocator::GetStats()
+{
+  PageData& data = GetPageData();
+
+  Stats stats;
+  stats.m_uiAllocatedBytes = static_cast<nsUInt64>(data.m_iAllocatedBytes);
+  stats.m_uiReservedBytes = static_cast<nsUInt64>(data.m_iReservedBytes);
+  stats.m_uiCommittedBytes = static_cast<nsUInt64>(data.m_iCommittedBytes);
+  stats.m_uiHugePageRequestedBytes = static_cast<nsUInt64>(data.m_iHugePageRequestedBytes);
+  stats.m_uiExplicitHugePageBytes = static_cast<nsUInt64>(data.m_iExplicitHugePageBytes);
+  stats.m_uiNumExplicitHugePageFailures = static_cast<nsUInt64>(data.m_iNumExplicitHugePageFailures);
+  stats.m_uiProcessTransparentHugePageBytes = GetProcessTransparentHugePageBytes();
+  return stats;
+}
+
+// static
+void nsPageAllocator::AddPages(void* pPtr, const PageInfo& info)
+{
+  PageData& data = GetPageData();
+
+  const nsInt64 iSize = static_cast<nsInt64>(info.m_uiSize);
+  data.m_iAllocatedBytes.Add(iSize);
+
+  if (!info.IsRecorded())
+    return;
+
+  const bool bHugePages = info.m_Flags.IsAnySet(nsPageAllocationFlags::TransparentHugePages | nsPageAllocationFlags::ExplicitHugePages);
+
+  nsUInt64 uiValue = info.m_uiSize;
+  uiValue |= info.m_bExplicitHugePages ? ExplicitHugePagesBit : 0;
+  uiValue |= bHugePages ? HugePagesRequestedBit : 0;
+  uiValue |= info.m_bMapped ? MappedBit : 0;
+
+  {
+    NS_LOCK(data.m_Mutex);
+    data.m_Pages.Insert(pPtr, uiValue);
+  }
+
+  data.m_iNumRecordedPages.Increment();
+
+  if (bHugePages)
+    data.m_iHugePageRequestedBytes.Add(iSize);
+
+  if (info.m_bExplicitHugePages)
+    data.m_iExplicitHugePageBytes.Add(iSize);
+}
+
+// static
+bool nsPageAllocator::RemoveRecordedPages(void* pPtr, PageInfo& out_info)
+{
+  PageData& data = GetPageData();
+
+  // the page must have been recorded before its pointer was handed out, so this can't miss it
+  if (data.m_iNumRecordedPages == 0)
+    return false;
+
+  nsUInt64 uiValue = 0;
+
+  {
+    NS_LOCK(data.m_Mutex);
+
+    if (!data.m_Pages.Remove(pPtr, &uiValue))
+      return false;
+  }
+
+  data.m_iNumRecordedPages.Decrement();
+
+  out_info.m_uiSize = static_cast<size_t>(uiValue & SizeMask);
+  out_info.m_bExplicitHugePages = (uiValue & ExplicitHugePagesBit) != 0;
+  out_info.m_bMapped = (uiValue & MappedBit) != 0;
+
+  const nsInt64 iSize = static_cast<nsInt64>(out_info.m_uiSize);
+  data.m_iAllocatedBytes.Subtract(iSize);
+
+  if ((uiValue & HugePagesRequestedBit) != 0)
+    data.m_iHugePageRequestedBytes.Subtract(iSize);
+
+  if (out_info.m_bExplicitHugePages)
+    data.m_iExplicitHugePageBytes.Subtract(iSize);
+
+  return true;
+}
+
+// static
+void nsPageAllocator::RemovePlainPages(size_t uiSize)
+{
+  GetPageData().m_iAllocatedBytes.Subtract(static_cast<nsInt64>(uiSize));
+}
+
+// static
+void nsPageAllocator::AddReservation(void* pPtr, size_t uiSize, bool bHugePages)
+{
+  PageData& data = GetPageData();
+  NS_LOCK(data.m_Mutex);
+
+  Reservation& reservation = data.m_Reservations.ExpandAndGetRef();
+  reservation.m_pPtr = pPtr;
+  reservation.m_uiSize = uiSize;
+  reservation.m_bHugePages = bHugePages;
+
+  data.m_iReservedBytes.Add(static_cast<nsInt64>(uiSize));
+
+  if (bHugePages)
+    data.m_iHugePageRequestedBytes.Add(static_cast<nsInt64>(uiSize));
+}
+
+// static
+void nsPageAllocator::RemoveReservation(void* pPtr)
+{
+  PageData& data = GetPageData();
+  NS_LOCK(data.m_Mutex);
+
+  for (nsUInt32 i = 0; i < data.m_Reservations.GetCount(); ++i)
+  {
+    const Reservation& reservation = data.m_Reservations[i];
+
+    if (reservation.m_pPtr == pPtr)
+    {
+      data.m_iReservedBytes.Subtract(static_cast<nsInt64>(reservation.m_uiSize));
+      data.m_iCommittedBytes.Subtract(static_cast<nsInt64>(reservation.m_uiCommittedBytes));
+
+      if (reservation.m_bHugePages)
+        data.m_iHugePageRequestedBytes.Subtract(static_cast<nsInt64>(reservation.m_uiSize));
+
+      data.m_Reservations.RemoveAtAndSwap(i);
+      return;
+    }
+  }
+
+  NS_REPORT_FAILURE("'{0}' was not reserved with nsPageAllocator", nsArgP(pPtr));
+}
+
+// static
+void nsPageAllocator::AddCommittedBytes(void* pPtr, nsInt64 iBytes)
+{
+  PageData& data = GetPageData();
+  NS_LOCK(data.m_Mutex);
+
+  for (Reservation& reservation : data.m_Reservations)
+  {
+    if (pPtr >= reservation.m_pPtr && pPtr < nsMemoryUtils::AddByteOffset(reservation.m_pPtr, reservation.m_uiSize))
+    {
+      reservation.m_uiCommittedBytes += iBytes;
+      data.m_iCommittedBytes.Add(iBytes);
+      return;
+    }
+  }
+
+  NS_REPORT_FAILURE("'{0}' is not within a range that was reserved with nsPageAllocator", nsArgP(pPtr));
+}
+
+// static
+void nsPageAllocator::AddExplicitHugePageFailure()
+{
+  GetPageData().m_iNumExplicitHugePageFailures.Increment();
+}
@@ -35,11 +35,14 @@ struct nsDataBlock
 };
 
 /// \brief A block allocator which can only allocates blocks of memory at once.
+///
+/// The blocks are taken from super blocks of 16 blocks each, which are requested from nsPageAllocator with the given page flags.
+/// Huge pages only have an effect, if a super block is at least as large as a huge page.
 template <nsUInt32 BlockSizeInByte>
 class nsLargeBlockAllocator
 {
 public:
-  nsLargeBlockAllocator(nsStringView sName, nsAllocator* pParent, nsAllocatorTrackingMode mode = nsAllocatorTrackingMode::Default);
+  nsLargeBlockAllocator(nsStringView sName, nsAllocator* pParent, nsAllocatorTrackingMode mode = nsAllocatorTrackingMode::Default, nsBitflags<nsPageAllocationFlags> pageFlags = nsPageAllocationFlags::Default);
   ~nsLargeBlockAllocator();
 
   template <typename T>
@@ -53,7 +56,7 @@ public:
 
   nsAllocatorId GetId() const;
 
-  const nsAllocator::Stats& GetStats() const;
+  nsAllocator::Stats GetStats() const;
 
 private:
   void* Allocate(size_t uiAlign);
@@ -61,6 +64,7 @@ private:
 
   nsAllocatorId m_Id;
   nsAllocatorTrackingMode m_TrackingMode;
+  nsBitflags<nsPageAllocationFlags> m_PageFlags;
 
   nsMutex m_Mutex;
 
@@ -6,6 +6,8 @@
 #include <Foundation/Types/ArrayPtr.h>
 #include <Foundation/Types/Bitflags.h>
 
+class nsStreamWriter;
+
 enum class nsAllocatorTrackingMode : nsUInt32
 {
   Nothing,                       ///< The allocator doesn't track anything. Use this for best performance.
@@ -18,6 +20,10 @@ enum class nsAllocatorTrackingMode : nsUInt32
 };
 
 /// \brief Memory tracker which keeps track of all allocations and constructions
+///
+/// Tracking an allocation doesn't serialize all threads. The statistics of each allocator are atomic counters and its allocations are
+/// spread over several tables by pointer hash, each with its own lock. Only registering and deregistering allocators and printing leaks
+/// block all other tracking.
 class NS_FOUNDATION_DLL nsMemoryTracker
 {
 public:
@@ -31,7 +37,7 @@ public:
 
     void** m_pStackTrace = nullptr;
     size_t m_uiSize = 0;
-    nsUInt16 m_uiAlignment = 0;
+    nsUInt32 m_uiAlignment = 0;
     nsUInt16 m_uiStackTraceLength = 0;
 
     NS_ALWAYS_INLINE const nsArrayPtr<void*> GetStackTrace() const { return nsArrayPtr<void*>(m_pStackTrace, (nsUInt32)m_uiStackTraceLength); }
@@ -54,7 +60,7 @@ public:
     nsAllocatorId Id() const;
     nsStringView Name() const;
     nsAllocatorId ParentId() const;
-    const nsAllocator::Stats& Stats() const;
+    nsAllocator::Stats Stats() const;
 
     void Next();
     bool IsValid() const;
@@ -83,7 +89,10 @@ public:
   static void ResetPerFrameAllocatorStats();
 
   static nsStringView GetAllocatorName(nsAllocatorId allocatorId);
-  static const nsAllocator::Stats& GetAllocatorStats(nsAllocatorId allocatorId);
+  /// \brief Returns a snapshot of the allocator's statistics.
+  ///
+  /// The counters are updated without a lock, so while other threads allocate the values may not be consistent with each other.
+  static nsAllocator::Stats GetAllocatorStats(nsAllocatorId allocatorId);
   static nsAllocatorId GetAllocatorParentId(nsAllocatorId allocatorId);
   static const AllocationInfo& GetAllocationInfo(nsAllocatorId allocatorId, const void* pPtr);
 
@@ -101,4 +110,48 @@ public:
   ///
   /// This is useful to call at the end of an application, to get a debug breakpoint in case of memory leaks.
   static void DumpMemoryLeaks();
+
+  /// \name Allocation Sampling
+  ///
+  /// Records the stack traces of a small, random subset of all allocations, which is cheap enough to keep running in long sessions.
+  /// Works for all allocators with a tracking mode of at least nsAllocatorTrackingMode::Basics.
+  ///
+  /// On average one allocation is sampled every 'sampling interval' bytes. The distance between samples is drawn from an exponential
+  /// distribution, so that no allocation pattern is systematically skipped. Each sample stands for the amount of memory that was
+  /// probably allocated from the same call site between two samples, so the totals per call site are estimates of the real numbers.
+  ///@{
+
+  /// \brief Enables sampling with the given average number of bytes between two samples. Zero disables sampling.
+  ///
+  /// Allocations that were sampled before stay known until they are deallocated or ResetSampledAllocations() is called.
+  static void SetSamplingInterval(nsUInt32 uiBytes);
+
+  static nsUInt32 GetSamplingInterval();
+
+  struct SamplingStats
+  {
+    nsUInt64 m_uiNumLiveSamples = 0;     ///< The number of sampled allocations that were not deallocated yet.
+    nsUInt64 m_uiEstimatedLiveBytes = 0; ///< The estimated size of all allocations that were not deallocated yet.
+    nsUInt32 m_uiNumCallSites = 0;       ///< The number of distinct call sites that had samples.
+  };
+
+  /// \brief Returns the sampling results for one allocator, or for all allocators if the id is invalid.
+  static SamplingStats GetSamplingStats(nsAllocatorId allocatorId = nsAllocatorId());
+
+  /// \brief Writes the estimated live bytes per call site in the 'collapsed stack' format.
+  ///
+  /// Every line holds the allocator name and the resolved stack frames from the outermost to the innermost, separated by semicolons,
+  /// followed by the number of bytes. This is the input format of flame graph tools such as flamegraph.pl, speedscope or Tracy.
+  static nsResult WriteSampledAllocations(nsStreamWriter& inout_stream);
+
+  /// \brief Forgets all samples and call sites.
+  static void ResetSampledAllocations();
+
+  /// \brief Called by allocators for every allocation. Records the allocation, if it is its thread's turn to take a sample.
+  static void SampleAllocation(nsAllocatorId allocatorId, const void* pPtr, size_t uiSize);
+
+  /// \brief Called by allocators for every deallocation.
+  static void RemoveSampledAllocation(const void* pPtr);
+
+  ///@}
 };
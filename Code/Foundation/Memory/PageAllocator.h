@@ -1,13 +1,121 @@
 #pragma once
 
 #include <Foundation/Basics.h>
+#include <Foundation/Types/Bitflags.h>
+
+/// \brief Flags for nsPageAllocator::AllocatePage() and nsPageAllocator::ReservePages().
+struct nsPageAllocationFlags
+{
+  using StorageType = nsUInt8;
+
+  enum Enum
+  {
+    None = 0,
+    TransparentHugePages = NS_BIT(0), ///< Asks the OS to back the memory with huge pages where it can (Linux: madvise(MADV_HUGEPAGE)). Ignored where not supported.
+    ExplicitHugePages = NS_BIT(1),    ///< Takes the memory from the reserved huge page pool (Linux: MAP_HUGETLB, Windows: MEM_LARGE_PAGES). Falls back to regular pages, if that fails.
+    Default = None
+  };
+
+  struct Bits
+  {
+    StorageType TransparentHugePages : 1;
+    StorageType ExplicitHugePages : 1;
+  };
+};
+
+NS_DECLARE_FLAGS_OPERATORS(nsPageAllocationFlags);
 
 /// \brief This helper class can reserve and allocate whole memory pages.
+///
+/// Large, long living allocations with random access patterns (block allocators, frame allocators, image data) can reduce TLB misses
+/// by using huge pages, see nsPageAllocationFlags. On machines with several NUMA nodes, memory can be placed on the node of the threads
+/// that work with it.
 class NS_FOUNDATION_DLL nsPageAllocator
 {
 public:
-  static void* AllocatePage(size_t uiSize);
+  /// \brief Pass this as NUMA node to let the OS decide where to place the memory.
+  static constexpr nsUInt32 AnyNumaNode = 0xFFFFFFFF;
+
+  /// \brief Allocates \a uiSize bytes of whole pages.
+  ///
+  /// The memory is aligned to the page size, or to \a uiAlign, if that is larger. \a uiAlign must be a power of two,
+  /// on Windows it may not be larger than the allocation granularity (64 KB).
+  /// Memory that uses huge pages is additionally aligned to the huge page size, if it is at least that large.
+  static void* AllocatePage(size_t uiSize, size_t uiAlign = 0, nsBitflags<nsPageAllocationFlags> flags = nsPageAllocationFlags::Default, nsUInt32 uiNumaNode = AnyNumaNode);
   static void DeallocatePage(void* pPtr);
 
+  /// \name Reserved address ranges
+  ///
+  /// A large range of address space can be reserved up front and backed with memory incrementally, so that data can grow in place
+  /// without ever being moved. All sizes and offsets must be multiples of the page size.
+  /// ExplicitHugePages is not supported for reserved ranges.
+  ///@{
+
+  /// \brief Reserves \a uiSize bytes of address space without backing it with memory. Returns nullptr, if that fails.
+  static void* ReservePages(size_t uiSize, nsBitflags<nsPageAllocationFlags> flags = nsPageAllocationFlags::Default, nsUInt32 uiNumaNode = AnyNumaNode);
+
+  /// \brief Makes a part of a reserved range usable. The memory is zero initialized. Pages must not be committed twice.
+  static nsResult CommitPages(void* pPtr, size_t uiSize);
+
+  /// \brief Gives the memory of a part of a reserved range back to the OS, the address range stays reserved.
+  static void DecommitPages(void* pPtr, size_t uiSize);
+
+  /// \brief Releases a range that was reserved with ReservePages(). Committed parts don't need to be decommitted before.
+  static void ReleasePages(void* pPtr, size_t uiSize);
+
+  ///@}
+
+  /// \brief The size of a huge page, typically 2 MB. Returns 0, if huge pages are not supported on this platform.
+  static size_t GetHugePageSize();
+
+  /// \brief The number of NUMA nodes of the machine, at least one.
+  static nsUInt32 GetNumaNodeCount();
+
+  /// \brief The NUMA node of the processor that the calling thread currently runs on.
+  static nsUInt32 GetCurrentNumaNode();
+
+  struct Stats
+  {
+    nsUInt64 m_uiAllocatedBytes = 0;             ///< Memory that is currently allocated with AllocatePage(), including the rounding of the OS or heap.
+    nsUInt64 m_uiReservedBytes = 0;              ///< Address space that is currently reserved with ReservePages().
+    nsUInt64 m_uiCommittedBytes = 0;             ///< Memory that is currently committed in reserved ranges.
+    nsUInt64 m_uiHugePageRequestedBytes = 0;     ///< Allocated memory and reserved address space that asked for huge pages.
+    nsUInt64 m_uiExplicitHugePageBytes = 0;      ///< Allocated memory that is backed by the explicit huge page pool.
+    nsUInt64 m_uiNumExplicitHugePageFailures = 0; ///< How often explicit huge pages were requested, but regular pages had to be used.
+
+    /// \brief How much memory of the whole process is actually backed by transparent huge pages, as reported by the OS.
+    ///
+    /// Only available on Linux, zero elsewhere. Compare this to m_uiHugePageRequestedBytes to see whether the OS follows the requests.
+    nsUInt64 m_uiProcessTransparentHugePageBytes = 0;
+  };
+
+  /// \brief Returns statistics about the page allocations, to see how much of the memory uses huge pages.
+  static Stats GetStats();
+
   static nsAllocatorId GetId();
+
+private:
+  struct PageInfo
+  {
+    size_t m_uiSize = 0;
+    nsBitflags<nsPageAllocationFlags> m_Flags;
+    bool m_bExplicitHugePages = false;
+    bool m_bMapped = false; // has to be unmapped with its size instead of being freed
+
+    // plain allocations are only counted, so that frequent span allocations and frees don't have to take a lock
+    bool IsRecorded() const { return m_bMapped || m_bExplicitHugePages || m_Flags.IsAnySet(nsPageAllocationFlags::TransparentHugePages | nsPageAllocationFlags::ExplicitHugePages); }
+  };
+
+  // bookkeeping shared by all platforms, see PageAllocator.cpp
+  static void AddPages(void* pPtr, const PageInfo& info);
+  // returns false for plain allocations, their size has to be passed to RemovePlainPages() instead
+  static bool RemoveRecordedPages(void* pPtr, PageInfo& out_info);
+  static void RemovePlainPages(size_t uiSize);
+  static void AddReservation(void* pPtr, size_t uiSize, bool bHugePages);
+  static void RemoveReservation(void* pPtr);
+  static void AddCommittedBytes(void* pPtr, nsInt64 iBytes);
+  static void AddExplicitHugePageFailure();
+
+  // platform specific
+  static nsUInt64 GetProcessTransparentHugePageBytes();
 };
@@ -16,6 +16,13 @@ public:
     Alignment = 16
   };
 
+  /// \brief A position in the allocator, see GetMarker() and Rewind().
+  struct Marker
+  {
+    nsUInt32 m_uiBucketIndex = 0;
+    nsUInt8* m_pNextAllocation = nullptr;
+  };
+
   NS_FORCE_INLINE nsAllocPolicyLinear(nsAllocator* pParent)
     : m_pParent(pParent)
     , m_uiNextBucketSize(4096)
@@ -102,6 +109,40 @@ public:
     }
   }
 
+  NS_ALWAYS_INLINE Marker GetMarker() const
+  {
+    Marker marker;
+    marker.m_uiBucketIndex = m_uiCurrentBucketIndex;
+    marker.m_pNextAllocation = m_pNextAllocation;
+    return marker;
+  }
+
+  /// \brief Frees all allocations that were made after the marker was taken. The buckets are kept for reuse.
+  NS_FORCE_INLINE void Rewind(const Marker& marker)
+  {
+    NS_ASSERT_DEBUG(marker.m_uiBucketIndex <= m_uiCurrentBucketIndex, "Invalid marker");
+
+    if (m_Buckets.IsEmpty())
+      return;
+
+    // the marker was taken before the first bucket was allocated
+    nsUInt8* pNextAllocation = marker.m_pNextAllocation != nullptr ? marker.m_pNextAllocation : m_Buckets[0].GetPtr();
+
+    if constexpr (OverwriteMemoryOnReset)
+    {
+      auto& bucket = m_Buckets[marker.m_uiBucketIndex];
+      nsMemoryUtils::PatternFill(pNextAllocation, 0xCD, bucket.GetEndPtr() - pNextAllocation);
+
+      for (nsUInt32 i = marker.m_uiBucketIndex + 1; i <= m_uiCurrentBucketIndex; ++i)
+      {
+        nsMemoryUtils::PatternFill(m_Buckets[i].GetPtr(), 0xCD, m_Buckets[i].GetCount());
+      }
+    }
+
+    m_uiCurrentBucketIndex = marker.m_uiBucketIndex;
+    m_pNextAllocation = pNextAllocation;
+  }
+
   NS_FORCE_INLINE void FillStats(nsAllocator::Stats& ref_stats)
   {
     ref_stats.m_uiNumAllocations = m_Buckets.GetCount();
@@ -0,0 +1,117 @@
+#pragma once
+
+#include <Foundation/Basics.h>
+#include <Foundation/Threading/Mutex.h>
+
+/// \brief Allocation policy for many objects of the same size, like tasks, messages or graph nodes.
+///
+/// Every allocation size up to MaxObjectSize, rounded up to a multiple of 16 bytes, is served from its own pool. Each thread keeps a
+/// magazine of free objects per pool, so allocating and deallocating is just a pop or push on a thread local list. When a magazine runs
+/// empty or full, it is exchanged with the pool's global list of magazines, which is shared by all threads and lock-free.
+/// Memory may be freed on a different thread than the one that allocated it. Only growing a pool by another slab takes a lock.
+///
+/// The slabs are requested from the parent allocator, or from nsPageAllocator if there is none, and are only released when the allocator
+/// is destroyed, so a pool never shrinks. Larger allocations and alignments of more than 64 bytes are forwarded to the same place with their
+/// own alignment. The parent must support alignments of SlabSize bytes for the slabs, e.g. the aligned heap.
+///
+/// \see nsPoolAllocator, nsPoolAllocatorWrapper
+class NS_FOUNDATION_DLL nsAllocPolicyPool
+{
+public:
+  nsAllocPolicyPool(nsAllocator* pParent);
+  ~nsAllocPolicyPool();
+
+  void* Allocate(size_t uiSize, size_t uiAlign);
+  void Deallocate(void* pPtr);
+
+  NS_ALWAYS_INLINE nsAllocator* GetParent() const { return m_pParent; }
+
+  /// \brief The size and alignment of the slabs that are requested from the parent allocator or nsPageAllocator.
+  static constexpr size_t SlabSize = 64 * 1024;
+
+  /// \brief Allocations larger than this are forwarded to the parent allocator or nsPageAllocator.
+  static constexpr size_t MaxObjectSize = 1024;
+
+  static constexpr nsUInt32 NumPools = MaxObjectSize / 16;
+
+  /// \brief Returns the number of bytes that are reserved for an allocation of the given size and alignment.
+  static size_t GetAllocationSize(size_t uiSize, size_t uiAlign);
+
+private:
+  NS_DISALLOW_COPY_AND_ASSIGN(nsAllocPolicyPool);
+
+  struct FreeObject;
+  struct SlabHeader;
+  struct ThreadCache;
+  struct ThreadCacheSlots;
+  struct ThreadCacheFlusher;
+  struct CacheSlotTable;
+  struct SlabSet;
+
+  struct Magazine
+  {
+    FreeObject* m_pHead = nullptr;
+    nsUInt32 m_uiCount = 0;
+  };
+
+  struct Pool
+  {
+    // lock-free stack of magazines, the pointer to the first one and a counter against ABA in one value, see PushMagazines()
+    nsInt64 m_iMagazines = 0;
+
+    // taken to grow the pool, protects m_pSlabs
+    nsMutex m_Mutex;
+    SlabHeader* m_pSlabs = nullptr;
+  };
+
+  static nsUInt32 GetPoolIndex(size_t uiSize, size_t uiAlign);
+
+  /// \brief The thread local table of caches, one entry per allocator that got a slot, see m_uiCacheSlot.
+  static ThreadCacheSlots& GetThreadCacheSlots();
+
+  /// \brief The global table that tells which allocator owns which slot.
+  static CacheSlotTable& GetCacheSlotTable();
+
+  /// \brief Returns the calling thread's cache for this allocator, or nullptr if it can't have one.
+  ThreadCache* GetThreadCache();
+  ThreadCache* CreateThreadCache(ThreadCacheSlots& ref_slots);
+
+  /// \brief Gives all magazines of the cache back to the pools and frees the cache itself.
+  void ReleaseThreadCache(ThreadCache* pCache);
+
+  /// \brief Used when the thread has no cache, takes a magazine from the pool and gives back all but one object.
+  void* AllocateUncached(nsUInt32 uiPool);
+
+  /// \brief Returns one object and puts the rest of a magazine from the pool into \a ref_magazine, which must be empty.
+  void* Refill(Magazine& ref_magazine, nsUInt32 uiPool);
+
+  /// \brief Takes a magazine from the pool's global list, or from a new slab, if the list is empty.
+  FreeObject* PopMagazine(nsUInt32 uiPool);
+
+  /// \brief Pushes a chain of magazines, linked through FreeObject::m_pNextMagazine, to the pool's global list.
+  void PushMagazines(nsUInt32 uiPool, FreeObject* pFirst, FreeObject* pLast);
+
+  /// \brief Carves a new slab into magazines and returns the first one, the others are pushed to the global list.
+  FreeObject* Grow(nsUInt32 uiPool);
+
+  /// \brief Whether the slab sized block at the given address is one of the slabs, reads m_iSlabSet without a lock.
+  bool IsSlab(size_t uiAddress) const;
+
+  /// \brief Adds a new slab to m_iSlabSet, before any of its objects are handed out.
+  void AddSlab(void* pSlab);
+
+  /// \brief Allocates from the parent or nsPageAllocator.
+  void* AllocateFromParent(size_t uiSize, size_t uiAlign);
+  void DeallocateFromParent(void* pPtr);
+
+  nsAllocator* m_pParent = nullptr;
+  Pool m_Pools[NumPools];
+
+  // the addresses of all slabs of all pools, a SlabSet* that is only replaced by a larger one under m_SlabSetMutex
+  nsInt64 m_iSlabSet = 0;
+  nsMutex m_SlabSetMutex;
+
+  // which entry of the thread local cache table belongs to this allocator, see GetThreadCache()
+  nsUInt32 m_uiCacheSlot = 0;
+  nsUInt32 m_uiCacheGeneration = 0;
+};
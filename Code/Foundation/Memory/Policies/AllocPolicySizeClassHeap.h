@@ -0,0 +1,103 @@
+#pragma once
+
+#include <Foundation/Basics.h>
+#include <Foundation/Threading/Mutex.h>
+
+/// \brief Heap allocation policy that serves small allocations from per-thread caches of fixed size classes.
+///
+/// Allocations of up to MaxSmallSize bytes are rounded up to one of NumSizeClasses size classes. Every thread has its own cache of free
+/// objects for each class, so in the common case allocating and deallocating is just a push or pop on a thread local list, without any lock.
+/// When a cache runs empty or grows too large, a batch of objects is moved from or to the central free list of that class, which is
+/// shared by all threads and protected by a mutex. New objects are carved out of spans that are requested from nsPageAllocator.
+/// Memory may be freed on a different thread than the one that allocated it, it simply ends up in the cache of the freeing thread.
+///
+/// Larger allocations are forwarded to nsPageAllocator directly. The memory of the spans is kept for reuse and only released when the
+/// allocator is destroyed.
+///
+/// Alignments of up to 256 bytes are served from the size classes, larger alignments (up to half the span size) go through the large path.
+/// Set NS_ALLOC_SIZE_CLASS_HEAP to use this policy for the default and the aligned allocator.
+///
+/// \see nsAllocatorWithPolicy
+class NS_FOUNDATION_DLL nsAllocPolicySizeClassHeap
+{
+public:
+  nsAllocPolicySizeClassHeap(nsAllocator* pParent);
+  ~nsAllocPolicySizeClassHeap();
+
+  void* Allocate(size_t uiSize, size_t uiAlign);
+  void Deallocate(void* pPtr);
+
+  NS_ALWAYS_INLINE nsAllocator* GetParent() const { return nullptr; }
+
+  /// \brief The size and alignment of the blocks that are requested from nsPageAllocator.
+  static constexpr size_t SpanSize = 64 * 1024;
+
+  /// \brief Allocations larger than this are forwarded to nsPageAllocator.
+  static constexpr size_t MaxSmallSize = 8 * 1024;
+
+  static constexpr nsUInt32 NumSizeClasses = 32;
+
+  /// \brief Returns the number of bytes that are reserved for an allocation of the given size and alignment.
+  static size_t GetAllocationSize(size_t uiSize, size_t uiAlign);
+
+private:
+  NS_DISALLOW_COPY_AND_ASSIGN(nsAllocPolicySizeClassHeap);
+
+  struct FreeObject;
+  struct SpanHeader;
+  struct ThreadCache;
+  struct ThreadCacheSlots;
+  struct ThreadCacheFlusher;
+  struct CacheSlotTable;
+
+  struct FreeList
+  {
+    FreeObject* m_pHead = nullptr;
+    nsUInt32 m_uiCount = 0;
+  };
+
+  struct CentralFreeList
+  {
+    nsMutex m_Mutex;
+    FreeList m_List;
+  };
+
+  static nsUInt32 GetSizeClass(size_t uiSize, size_t uiAlign);
+
+  /// \brief The thread local table of caches, one entry per allocator that got a slot, see m_uiCacheSlot.
+  static ThreadCacheSlots& GetThreadCacheSlots();
+
+  /// \brief The global table that tells which allocator owns which slot.
+  static CacheSlotTable& GetCacheSlotTable();
+
+  /// \brief Returns the calling thread's cache for this allocator, or nullptr if it can't have one.
+  ThreadCache* GetThreadCache();
+  ThreadCache* CreateThreadCache(ThreadCacheSlots& ref_slots);
+
+  /// \brief Moves all objects of the cache back to the central lists and frees the cache itself.
+  void ReleaseThreadCache(ThreadCache* pCache);
+
+  void* AllocateFromCentral(nsUInt32 uiSizeClass);
+  void DeallocateToCentral(FreeObject* pObject, nsUInt32 uiSizeClass);
+
+  /// \brief Moves up to a batch of objects from the central list of the size class into \a ref_list and returns one more for the caller.
+  void* FetchFromCentral(FreeList& ref_list, nsUInt32 uiSizeClass);
+
+  /// \brief Moves \a uiCount objects from the front of \a ref_list to the central list of the size class.
+  void ReleaseToCentral(FreeList& ref_list, nsUInt32 uiSizeClass, nsUInt32 uiCount);
+
+  /// \brief Carves a new span into objects of the size class and puts them into the central list. The central mutex must be held.
+  void AllocateSpan(nsUInt32 uiSizeClass);
+
+  static void* AllocateLarge(size_t uiSize, size_t uiAlign);
+
+  CentralFreeList m_CentralLists[NumSizeClasses];
+
+  // all spans of this allocator, linked through their headers
+  nsMutex m_SpanMutex;
+  SpanHeader* m_pSpans = nullptr;
+
+  // which entry of the thread local cache table belongs to this allocator, see GetThreadCache()
+  nsUInt32 m_uiCacheSlot = 0;
+  nsUInt32 m_uiCacheGeneration = 0;
+};
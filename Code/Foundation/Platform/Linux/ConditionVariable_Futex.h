@@ -0,0 +1,91 @@
+#include <Foundation/FoundationInternal.h>
+NS_FOUNDATION_INTERNAL_HEADER
+
+#include <Foundation/Platform/Linux/Futex_Linux.h>
+#include <Foundation/Threading/ConditionVariable.h>
+#include <Foundation/Time/Time.h>
+
+// Every signal increments the sequence number, waiting threads sleep until it changes.
+// The number of waiters lets the signaling thread skip the system call, when nobody is waiting, which is the common case for nsThreadSignal.
+
+nsConditionVariable::nsConditionVariable() = default;
+
+nsConditionVariable::~nsConditionVariable()
+{
+  NS_ASSERT_DEV(m_iLockCount == 0, "Thread-signal must be unlocked during destruction.");
+}
+
+void nsConditionVariable::SignalOne()
+{
+  nsAtomicUtils::Increment(m_Data.m_iSequence);
+
+  if (nsAtomicUtils::Read(m_Data.m_iNumWaiters) > 0)
+  {
+    nsFutex::Wake(m_Data.m_iSequence, 1);
+  }
+}
+
+void nsConditionVariable::SignalAll()
+{
+  nsAtomicUtils::Increment(m_Data.m_iSequence);
+
+  if (nsAtomicUtils::Read(m_Data.m_iNumWaiters) > 0)
+  {
+    nsFutex::Wake(m_Data.m_iSequence, nsMath::MaxValue<nsInt32>());
+  }
+}
+
+static bool WaitForSequenceChange(nsConditionVariableData& ref_data, nsMutexHandle& ref_hMutex, const nsTime* pTimeout)
+{
+  // registered as a waiter and the sequence number read while still holding the lock,
+  // so a signal that is sent after the lock was released is never missed
+  nsAtomicUtils::Increment(ref_data.m_iNumWaiters);
+  const nsInt32 iSequence = nsAtomicUtils::Read(ref_data.m_iSequence);
+
+  const nsInt32 iRecursion = ref_hMutex.m_iRecursion;
+  nsFutex::UnlockMutex(ref_hMutex);
+
+  bool bSignaled = false;
+
+  // signals often arrive right away (e.g. when handing work to another thread), spinning briefly saves going to sleep
+  const nsUInt32 uiSpinCount = nsFutex::GetSpinCount();
+  for (nsUInt32 i = 0; i < uiSpinCount; ++i)
+  {
+    if (nsAtomicUtils::Read(ref_data.m_iSequence) != iSequence)
+    {
+      bSignaled = true;
+      break;
+    }
+
+    nsFutex::Pause();
+  }
+
+  if (!bSignaled)
+  {
+    bSignaled = nsFutex::Wait(ref_data.m_iSequence, iSequence, pTimeout);
+  }
+
+  nsAtomicUtils::Decrement(ref_data.m_iNumWaiters);
+
+  nsFutex::LockMutex(ref_hMutex, iRecursion);
+  return bSignaled;
+}
+
+void nsConditionVariable::UnlockWaitForSignalAndLock() const
+{
+  NS_ASSERT_DEV(m_iLockCount > 0, "nsConditionVariable must be locked when calling UnlockWaitForSignalAndLock.");
+
+  WaitForSequenceChange(m_Data, m_Mutex.GetMutexHandle(), nullptr);
+}
+
+nsConditionVariable::WaitResult nsConditionVariable::UnlockWaitForSignalAndLock(nsTime timeout) const
+{
+  NS_ASSERT_DEV(m_iLockCount > 0, "nsConditionVariable must be locked when calling UnlockWaitForSignalAndLock.");
+
+  if (!WaitForSequenceChange(m_Data, m_Mutex.GetMutexHandle(), &timeout))
+  {
+    return WaitResult::Timeout;
+  }
+
+  return WaitResult::Signaled;
+}
@@ -1,5 +1,9 @@
 #include <Foundation/FoundationPCH.h>
 
 #if NS_ENABLED(NS_PLATFORM_LINUX)
-#  include <Foundation/Platform/Posix/ConditionVariable_Posix.h>
+#  if NS_ENABLED(NS_USE_FUTEX_THREADING)
+#    include <Foundation/Platform/Linux/ConditionVariable_Futex.h>
+#  else
+#    include <Foundation/Platform/Posix/ConditionVariable_Posix.h>
+#  endif
 #endif
@@ -34,6 +34,10 @@
 #undef NS_USE_LINUX_POSIX_EXTENSIONS
 #define NS_USE_LINUX_POSIX_EXTENSIONS NS_ON
 
+/// If set to one, nsMutex, nsConditionVariable (and thus nsThreadSignal) and unnamed nsSemaphores use futexes with bounded spinning, instead of pthreads.
+#undef NS_USE_FUTEX_THREADING
+#define NS_USE_FUTEX_THREADING NS_ON
+
 /// Iterating through the file system is not supported
 #undef NS_SUPPORTS_FILE_ITERATORS
 #define NS_SUPPORTS_FILE_ITERATORS NS_ON
@@ -0,0 +1,81 @@
+#include <Foundation/FoundationPCH.h>
+
+#if NS_ENABLED(NS_PLATFORM_LINUX) && NS_ENABLED(NS_USE_FUTEX_THREADING)
+
+#  include <Foundation/Math/Math.h>
+#  include <Foundation/Platform/Linux/Futex_Linux.h>
+#  include <Foundation/Time/Time.h>
+
+#  include <errno.h>
+#  include <linux/futex.h>
+#  include <sys/syscall.h>
+#  include <unistd.h>
+
+bool nsFutex::Wait(nsInt32& ref_iValue, nsInt32 iExpectedValue, const nsTime* pTimeout /*= nullptr*/)
+{
+  timespec timeout;
+  timespec* pFutexTimeout = nullptr;
+
+  if (pTimeout != nullptr)
+  {
+    // FUTEX_WAIT takes a relative timeout
+    const nsInt64 iNanoSecondsPerSecond = 1000000000LL;
+    const nsInt64 iNanoseconds = nsMath::Max<nsInt64>(0, static_cast<nsInt64>(pTimeout->GetNanoseconds()));
+
+    timeout.tv_sec = iNanoseconds / iNanoSecondsPerSecond;
+    timeout.tv_nsec = iNanoseconds % iNanoSecondsPerSecond;
+    pFutexTimeout = &timeout;
+  }
+
+  // the futexes are never shared with other processes, the private variants are cheaper
+  if (syscall(SYS_futex, &ref_iValue, FUTEX_WAIT_PRIVATE, iExpectedValue, pFutexTimeout, nullptr, 0) == -1)
+  {
+    // EAGAIN: the value was already different, EINTR: interrupted by a signal, both count as a (spurious) wake up
+    return errno != ETIMEDOUT;
+  }
+
+  return true;
+}
+
+void nsFutex::Wake(nsInt32& ref_iValue, nsInt32 iNumThreads)
+{
+  syscall(SYS_futex, &ref_iValue, FUTEX_WAKE_PRIVATE, iNumThreads, nullptr, nullptr, 0);
+}
+
+nsUInt32 nsFutex::GetSpinCount()
+{
+  static const nsUInt32 s_uiSpinCount = sysconf(_SC_NPROCESSORS_ONLN) > 1 ? 128 : 0;
+  return s_uiSpinCount;
+}
+
+void nsFutex::LockMutexContended(nsMutexHandle& ref_hMutex)
+{
+  // the owner is probably only going to hold the lock for a very short time, so check a few times whether it got released,
+  // but stop once other threads are already sleeping, it has been held for too long then
+  const nsUInt32 uiSpinCount = GetSpinCount();
+  for (nsUInt32 i = 0; i < uiSpinCount; ++i)
+  {
+    const nsInt32 iState = nsAtomicUtils::Read(ref_hMutex.m_iState);
+
+    if (iState == nsMutexHandle::Unlocked)
+    {
+      if (nsAtomicUtils::TestAndSet(ref_hMutex.m_iState, nsMutexHandle::Unlocked, nsMutexHandle::Locked))
+        return;
+    }
+    else if (iState == nsMutexHandle::LockedWithSleepers)
+    {
+      break;
+    }
+
+    Pause();
+  }
+
+  // Mark the mutex as contended, so that the thread that unlocks it knows to wake up a sleeping thread.
+  // This may lead to one unnecessary wake up, once the last sleeping thread got the lock, but never to a missed one.
+  while (nsAtomicUtils::Set(ref_hMutex.m_iState, nsMutexHandle::LockedWithSleepers) != nsMutexHandle::Unlocked)
+  {
+    Wait(ref_hMutex.m_iState, nsMutexHandle::LockedWithSleepers);
+  }
+}
+
+#endif
@@ -0,0 +1,81 @@
+#pragma once
+
+#include <Foundation/Basics.h>
+
+#if NS_ENABLED(NS_USE_FUTEX_THREADING)
+
+#  include <Foundation/Threading/AtomicUtils.h>
+#  include <Foundation/Threading/Implementation/ThreadingDeclarations.h>
+
+struct nsTime;
+
+/// \cond
+// Futex based building blocks of the Linux mutex, condition variable and semaphore implementations.
+
+struct NS_FOUNDATION_DLL nsFutex
+{
+  /// \brief How often a thread checks whether a lock got released, before it goes to sleep.
+  ///
+  /// Most critical sections in the engine are only a few instructions long. Spinning for a little while (about a microsecond)
+  /// is much cheaper than a round-trip through the kernel, and only costs the time of a context switch if it doesn't pay off.
+  /// On a machine with a single hardware thread, the lock can't be released while we spin, so this returns zero there.
+  static nsUInt32 GetSpinCount();
+
+  /// \brief Puts the calling thread to sleep, as long as \a ref_iValue holds \a iExpectedValue.
+  ///
+  /// May return spuriously. Returns false, if \a pTimeout was given and has passed.
+  static bool Wait(nsInt32& ref_iValue, nsInt32 iExpectedValue, const nsTime* pTimeout = nullptr);
+
+  /// \brief Wakes up to \a iNumThreads threads that are waiting on \a ref_iValue.
+  static void Wake(nsInt32& ref_iValue, nsInt32 iNumThreads);
+
+  /// \brief Tells the CPU that the calling thread is busy waiting, which lets a hyper-threading sibling use the core.
+  NS_ALWAYS_INLINE static void Pause()
+  {
+#  if NS_ENABLED(NS_PLATFORM_ARCH_X86)
+    __builtin_ia32_pause();
+#  elif NS_ENABLED(NS_PLATFORM_ARCH_ARM)
+    __asm__ __volatile__("yield");
+#  endif
+  }
+
+  /// \brief Called by nsMutex::Lock(), when the mutex is held by another thread. Spins for a while and then goes to sleep.
+  static void LockMutexContended(nsMutexHandle& ref_hMutex);
+
+  /// \brief Acquires the mutex for the calling thread, which must not hold it already.
+  NS_ALWAYS_INLINE static void LockMutex(nsMutexHandle& ref_hMutex, nsInt32 iRecursion)
+  {
+    if (!nsAtomicUtils::TestAndSet(ref_hMutex.m_iState, nsMutexHandle::Unlocked, nsMutexHandle::Locked))
+    {
+      LockMutexContended(ref_hMutex);
+    }
+
+    // other threads only compare the owner against themselves, so this doesn't need any ordering
+    __atomic_store_n(&ref_hMutex.m_uiOwner, GetCurrentThread(), __ATOMIC_RELAXED);
+    ref_hMutex.m_iRecursion = iRecursion;
+  }
+
+  /// \brief Releases the mutex, no matter how often the calling thread has locked it.
+  NS_ALWAYS_INLINE static void UnlockMutex(nsMutexHandle& ref_hMutex)
+  {
+    ref_hMutex.m_iRecursion = 0;
+    __atomic_store_n(&ref_hMutex.m_uiOwner, 0, __ATOMIC_RELAXED);
+
+    if (nsAtomicUtils::Set(ref_hMutex.m_iState, nsMutexHandle::Unlocked) == nsMutexHandle::LockedWithSleepers)
+    {
+      Wake(ref_hMutex.m_iState, 1);
+    }
+  }
+
+  /// \brief Returns whether the calling thread holds the mutex.
+  NS_ALWAYS_INLINE static bool IsMutexOwnedByCurrentThread(const nsMutexHandle& hMutex)
+  {
+    return __atomic_load_n(&hMutex.m_uiOwner, __ATOMIC_RELAXED) == GetCurrentThread();
+  }
+
+  NS_ALWAYS_INLINE static nsUInt64 GetCurrentThread() { return static_cast<nsUInt64>(pthread_self()); }
+};
+
+/// \endcond
+
+#endif
@@ -0,0 +1,55 @@
+#include <Foundation/Platform/Linux/Futex_Linux.h>
+
+// Linux implementation of nsMutex on top of a futex, which spins for a short while before it puts the thread to sleep.
+// Recursive locking is supported, just like with the pthread based implementation.
+
+NS_ALWAYS_INLINE nsMutex::nsMutex() = default;
+
+NS_ALWAYS_INLINE nsMutex::~nsMutex() = default;
+
+NS_ALWAYS_INLINE void nsMutex::Lock()
+{
+  if (nsFutex::IsMutexOwnedByCurrentThread(m_hHandle))
+  {
+    ++m_hHandle.m_iRecursion;
+  }
+  else
+  {
+    nsFutex::LockMutex(m_hHandle, 1);
+  }
+
+  ++m_iLockCount;
+}
+
+NS_ALWAYS_INLINE nsResult nsMutex::TryLock()
+{
+  if (nsFutex::IsMutexOwnedByCurrentThread(m_hHandle))
+  {
+    ++m_hHandle.m_iRecursion;
+  }
+  else
+  {
+    if (!nsAtomicUtils::TestAndSet(m_hHandle.m_iState, nsMutexHandle::Unlocked, nsMutexHandle::Locked))
+      return NS_FAILURE;
+
+    __atomic_store_n(&m_hHandle.m_uiOwner, nsFutex::GetCurrentThread(), __ATOMIC_RELAXED);
+    m_hHandle.m_iRecursion = 1;
+  }
+
+  ++m_iLockCount;
+  return NS_SUCCESS;
+}
+
+NS_ALWAYS_INLINE void nsMutex::Unlock()
+{
+  --m_iLockCount;
+
+  if (m_hHandle.m_iRecursion > 1)
+  {
+    --m_hHandle.m_iRecursion;
+  }
+  else
+  {
+    nsFutex::UnlockMutex(m_hHandle);
+  }
+}
@@ -1,2 +1,6 @@
+#if NS_ENABLED(NS_USE_FUTEX_THREADING)
+#  include <Foundation/Platform/Linux/Mutex_Futex.h>
+#else
 // redirect to shared implementation
-#include <Foundation/Platform/Posix/Mutex_Posix.h>
\ No newline at end of file
+#  include <Foundation/Platform/Posix/Mutex_Posix.h>
+#endif
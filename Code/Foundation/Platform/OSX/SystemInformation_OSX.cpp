@@ -42,6 +42,12 @@ bool nsSystemInformation::IsDebuggerAttached()
   return ((info.kp_proc.p_flag & P_TRACED) != 0);
 }
 
+void nsCpuTopology::Detect(nsUInt32 uiNumLogicalProcessors)
+{
+  // the topology is not queried on this platform yet
+  SetUniform(uiNumLogicalProcessors);
+}
+
 void nsSystemInformation::Initialize()
 {
   if (s_SystemInformation.m_bIsInitialized)
@@ -51,6 +57,7 @@ void nsSystemInformation::Initialize()
 
   // Get system information via various APIs
   s_SystemInformation.m_uiCPUCoreCount = static_cast<nsUInt32>(sysconf(_SC_NPROCESSORS_ONLN));
+  s_SystemInformation.m_CpuTopology.Detect(s_SystemInformation.m_uiCPUCoreCount);
 
   nsUInt64 uiPageSize = sysconf(_SC_PAGE_SIZE);
 
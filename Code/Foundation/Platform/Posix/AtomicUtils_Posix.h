@@ -2,12 +2,12 @@
 
 NS_ALWAYS_INLINE nsInt32 nsAtomicUtils::Read(const nsInt32& src)
 {
-  return __sync_fetch_and_or(const_cast<nsInt32*>(&src), 0);
+  return __atomic_load_n(&src, __ATOMIC_SEQ_CST);
 }
 
 NS_ALWAYS_INLINE nsInt64 nsAtomicUtils::Read(const nsInt64& src)
 {
-  return __sync_fetch_and_or_8(const_cast<nsInt64*>(&src), 0);
+  return __atomic_load_n(&src, __ATOMIC_SEQ_CST);
 }
 
 NS_ALWAYS_INLINE nsInt32 nsAtomicUtils::Increment(nsInt32& dest)
@@ -152,12 +152,12 @@ NS_FORCE_INLINE void nsAtomicUtils::Max(nsInt64& dest, nsInt64 value)
 
 NS_ALWAYS_INLINE nsInt32 nsAtomicUtils::Set(nsInt32& dest, nsInt32 value)
 {
-  return __sync_lock_test_and_set(&dest, value);
+  return __atomic_exchange_n(&dest, value, __ATOMIC_SEQ_CST);
 }
 
 NS_ALWAYS_INLINE nsInt64 nsAtomicUtils::Set(nsInt64& dest, nsInt64 value)
 {
-  return __sync_lock_test_and_set_8(&dest, value);
+  return __atomic_exchange_n(&dest, value, __ATOMIC_SEQ_CST);
 }
 
 
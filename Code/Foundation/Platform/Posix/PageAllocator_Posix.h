@@ -3,19 +3,227 @@
 #include <Foundation/System/SystemInformation.h>
 #include <Foundation/Time/Time.h>
 
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+#if NS_ENABLED(NS_PLATFORM_LINUX) || NS_ENABLED(NS_PLATFORM_ANDROID)
+#  include <malloc.h>
+#  include <sys/syscall.h>
+#  define NS_PAGE_ALLOCATOR_LINUX_FEATURES 1
+#else
+#  include <malloc/malloc.h>
+#  define NS_PAGE_ALLOCATOR_LINUX_FEATURES 0
+#endif
+
+#if NS_PAGE_ALLOCATOR_LINUX_FEATURES && defined(SYS_mbind)
+#  define NS_PAGE_ALLOCATOR_NUMA 1
+#else
+#  define NS_PAGE_ALLOCATOR_NUMA 0
+#endif
+
+namespace
+{
+  // may be called very early and from within other allocators, so files are read without any allocations
+  bool ReadProcFile(const char* szPath, char* pBuffer, nsUInt32 uiBufferSize)
+  {
+    const int fd = open(szPath, O_RDONLY);
+    if (fd < 0)
+      return false;
+
+    const ssize_t iBytesRead = read(fd, pBuffer, uiBufferSize - 1);
+    close(fd);
+
+    if (iBytesRead <= 0)
+      return false;
+
+    pBuffer[iBytesRead] = '\0';
+    return true;
+  }
+
+  // returns the value of a line like 'Hugepagesize:    2048 kB' in bytes
+  nsUInt64 ReadProcFileKiloBytes(const char* szPath, const char* szKey)
+  {
+    char buffer[4096];
+    if (!ReadProcFile(szPath, buffer, NS_ARRAY_SIZE(buffer)))
+      return 0;
+
+    const char* szValue = strstr(buffer, szKey);
+    if (szValue == nullptr)
+      return 0;
+
+    return strtoull(szValue + strlen(szKey), nullptr, 10) * 1024;
+  }
+
+  // the size of the heap block, which is what plain allocations count in the stats
+  size_t GetHeapBlockSize(void* pPtr)
+  {
+#if NS_PAGE_ALLOCATOR_LINUX_FEATURES
+    return malloc_usable_size(pPtr);
+#else
+    return malloc_size(pPtr);
+#endif
+  }
+
+  // maps more than needed and unmaps the parts before and after the aligned range
+  void* MapAlignedPages(size_t uiSize, size_t uiAlign)
+  {
+    const size_t uiMappedSize = uiSize + uiAlign;
+    nsUInt8* pMapped = static_cast<nsUInt8*>(mmap(nullptr, uiMappedSize, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0));
+
+    if (pMapped == MAP_FAILED)
+      return nullptr;
+
+    nsUInt8* pAligned = nsMemoryUtils::AlignForwards(pMapped, uiAlign);
+    nsUInt8* pEnd = pAligned + uiSize;
+
+    if (pAligned > pMapped)
+    {
+      munmap(pMapped, pAligned - pMapped);
+    }
+
+    if (pEnd < pMapped + uiMappedSize)
+    {
+      munmap(pEnd, pMapped + uiMappedSize - pEnd);
+    }
+
+    return pAligned;
+  }
+
+  void BindToNumaNode(void* pPtr, size_t uiSize, nsUInt32 uiNumaNode)
+  {
+#if NS_PAGE_ALLOCATOR_NUMA
+    if (uiNumaNode == nsPageAllocator::AnyNumaNode || uiNumaNode >= 64)
+      return;
+
+    // MPOL_PREFERRED: allocate on the node while it has memory, use other nodes otherwise
+    constexpr int MemoryPolicyPreferred = 1;
+    const unsigned long uiNodeMask = 1ul << uiNumaNode;
+
+    const size_t uiPageSize = nsSystemInformation::Get().GetMemoryPageSize();
+    const size_t uiLength = (uiSize + uiPageSize - 1) & ~(uiPageSize - 1);
+
+    // only affects pages that are not in use yet, so this is only done for fresh mappings before the memory is touched
+    syscall(SYS_mbind, pPtr, uiLength, MemoryPolicyPreferred, &uiNodeMask, 64ul, 0u);
+#else
+    NS_IGNORE_UNUSED(pPtr);
+    NS_IGNORE_UNUSED(uiSize);
+    NS_IGNORE_UNUSED(uiNumaNode);
+#endif
+  }
+
+  void AdviseHugePages(void* pPtr, size_t uiSize)
+  {
+#if defined(MADV_HUGEPAGE)
+    const size_t uiHugePageSize = nsPageAllocator::GetHugePageSize();
+
+    // only whole huge pages can be backed by one
+    const size_t uiLength = uiSize & ~(uiHugePageSize - 1);
+
+    if (uiLength > 0)
+    {
+      madvise(pPtr, uiLength, MADV_HUGEPAGE);
+    }
+#else
+    NS_IGNORE_UNUSED(pPtr);
+    NS_IGNORE_UNUSED(uiSize);
+#endif
+  }
+} // namespace
+
 // static
-void* nsPageAllocator::AllocatePage(size_t uiSize)
+void* nsPageAllocator::AllocatePage(size_t uiSize, size_t uiAlign, nsBitflags<nsPageAllocationFlags> flags, nsUInt32 uiNumaNode)
 {
   nsTime fAllocationTime = nsTime::Now();
 
+  uiAlign = nsMath::Max<size_t>(uiAlign, nsSystemInformation::Get().GetMemoryPageSize());
+
+  const size_t uiHugePageSize = GetHugePageSize();
+  const bool bUseHugePages = flags.IsAnySet(nsPageAllocationFlags::TransparentHugePages | nsPageAllocationFlags::ExplicitHugePages) && uiHugePageSize > 0 && uiSize >= uiHugePageSize;
+
+  if (bUseHugePages)
+  {
+    uiAlign = nsMath::Max(uiAlign, uiHugePageSize);
+  }
+
+  PageInfo info;
+  info.m_uiSize = uiSize;
+  info.m_Flags = flags;
+
   void* ptr = nullptr;
-  size_t uiAlign = nsSystemInformation::Get().GetMemoryPageSize();
-  const int res = posix_memalign(&ptr, uiAlign, uiSize);
-  NS_ASSERT_DEBUG(res == 0, "Failed to align pointer");
-  NS_IGNORE_UNUSED(res);
+
+  if (flags.IsSet(nsPageAllocationFlags::ExplicitHugePages))
+  {
+#if NS_PAGE_ALLOCATOR_LINUX_FEATURES && defined(MAP_HUGETLB)
+    if (uiHugePageSize > 0)
+    {
+      const size_t uiMappedSize = nsMemoryUtils::AlignSize(uiSize, uiHugePageSize);
+      void* pMapped = mmap(nullptr, uiMappedSize, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+
+      if (pMapped != MAP_FAILED && nsMemoryUtils::IsAligned(pMapped, uiAlign))
+      {
+        ptr = pMapped;
+        info.m_uiSize = uiMappedSize;
+        info.m_bExplicitHugePages = true;
+        info.m_bMapped = true;
+      }
+      else if (pMapped != MAP_FAILED)
+      {
+        munmap(pMapped, uiMappedSize);
+      }
+    }
+#endif
+
+    if (ptr == nullptr)
+    {
+      // usually the huge page pool is empty, because it has to be configured by the administrator
+      AddExplicitHugePageFailure();
+    }
+  }
+
+#if NS_PAGE_ALLOCATOR_NUMA
+  if (ptr == nullptr && uiNumaNode != AnyNumaNode)
+  {
+    // heap memory may already be touched or share pages with other heap blocks, so a NUMA policy is only reliable on fresh mappings
+    const size_t uiMappedSize = nsMemoryUtils::AlignSize<size_t>(uiSize, nsSystemInformation::Get().GetMemoryPageSize());
+    ptr = MapAlignedPages(uiMappedSize, uiAlign);
+
+    if (ptr != nullptr)
+    {
+      info.m_uiSize = uiMappedSize;
+      info.m_bMapped = true;
+
+      if (bUseHugePages)
+      {
+        AdviseHugePages(ptr, uiMappedSize);
+      }
+    }
+  }
+#endif
+
+  if (ptr == nullptr)
+  {
+    const int res = posix_memalign(&ptr, uiAlign, uiSize);
+    NS_ASSERT_DEBUG(res == 0, "Failed to align pointer");
+    NS_IGNORE_UNUSED(res);
+
+    info.m_uiSize = GetHeapBlockSize(ptr);
+
+    if (bUseHugePages)
+    {
+      AdviseHugePages(ptr, uiSize);
+    }
+  }
 
   NS_CHECK_ALIGNMENT(ptr, uiAlign);
 
+  if (info.m_bMapped)
+  {
+    BindToNumaNode(ptr, info.m_uiSize, uiNumaNode);
+  }
+
+  AddPages(ptr, info);
+
   if constexpr (nsAllocatorTrackingMode::Default >= nsAllocatorTrackingMode::AllocationStats)
   {
     nsMemoryTracker::AddAllocation(nsPageAllocator::GetId(), nsAllocatorTrackingMode::Default, ptr, uiSize, uiAlign, nsTime::Now() - fAllocationTime);
@@ -32,5 +240,137 @@ void nsPageAllocator::DeallocatePage(void* ptr)
     nsMemoryTracker::RemoveAllocation(nsPageAllocator::GetId(), ptr);
   }
 
-  free(ptr);
+  PageInfo info;
+  if (!RemoveRecordedPages(ptr, info))
+  {
+    RemovePlainPages(GetHeapBlockSize(ptr));
+  }
+
+  if (info.m_bMapped)
+  {
+    munmap(ptr, info.m_uiSize);
+  }
+  else
+  {
+    free(ptr);
+  }
+}
+
+// static
+void* nsPageAllocator::ReservePages(size_t uiSize, nsBitflags<nsPageAllocationFlags> flags, nsUInt32 uiNumaNode)
+{
+  NS_ASSERT_DEV(!flags.IsSet(nsPageAllocationFlags::ExplicitHugePages), "Explicit huge pages can't be reserved");
+
+  void* ptr = mmap(nullptr, uiSize, PROT_NONE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0);
+
+  if (ptr == MAP_FAILED)
+    return nullptr;
+
+  const bool bUseHugePages = flags.IsSet(nsPageAllocationFlags::TransparentHugePages) && GetHugePageSize() > 0;
+
+  if (bUseHugePages)
+  {
+    AdviseHugePages(ptr, uiSize);
+  }
+
+  BindToNumaNode(ptr, uiSize, uiNumaNode);
+
+  AddReservation(ptr, uiSize, bUseHugePages);
+  return ptr;
+}
+
+// static
+nsResult nsPageAllocator::CommitPages(void* pPtr, size_t uiSize)
+{
+  if (mprotect(pPtr, uiSize, PROT_READ | PROT_WRITE) != 0)
+    return NS_FAILURE;
+
+  AddCommittedBytes(pPtr, static_cast<nsInt64>(uiSize));
+  return NS_SUCCESS;
+}
+
+// static
+void nsPageAllocator::DecommitPages(void* pPtr, size_t uiSize)
+{
+#if NS_PAGE_ALLOCATOR_LINUX_FEATURES
+  // drops the pages, the huge page advice and the NUMA policy of the range stay in place
+  madvise(pPtr, uiSize, MADV_DONTNEED);
+  mprotect(pPtr, uiSize, PROT_NONE);
+#else
+  mmap(pPtr, uiSize, PROT_NONE, MAP_FIXED | MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0);
+#endif
+
+  AddCommittedBytes(pPtr, -static_cast<nsInt64>(uiSize));
+}
+
+// static
+void nsPageAllocator::ReleasePages(void* pPtr, size_t uiSize)
+{
+  RemoveReservation(pPtr);
+  munmap(pPtr, uiSize);
+}
+
+// static
+size_t nsPageAllocator::GetHugePageSize()
+{
+#if NS_PAGE_ALLOCATOR_LINUX_FEATURES
+  static size_t s_uiHugePageSize = []()
+  {
+    const nsUInt64 uiSize = ReadProcFileKiloBytes("/proc/meminfo", "Hugepagesize:");
+    return uiSize != 0 ? static_cast<size_t>(uiSize) : static_cast<size_t>(2 * 1024 * 1024);
+  }();
+
+  return s_uiHugePageSize;
+#else
+  return 0;
+#endif
+}
+
+// static
+nsUInt32 nsPageAllocator::GetNumaNodeCount()
+{
+#if NS_PAGE_ALLOCATOR_LINUX_FEATURES
+  static nsUInt32 s_uiNumNodes = []()
+  {
+    // a list like '0' or '0-3'
+    char buffer[256];
+    if (!ReadProcFile("/sys/devices/system/node/online", buffer, NS_ARRAY_SIZE(buffer)))
+      return 1u;
+
+    const char* szLast = strrchr(buffer, '-');
+    if (szLast == nullptr)
+      szLast = strrchr(buffer, ',');
+
+    const unsigned long uiLastNode = strtoul(szLast != nullptr ? szLast + 1 : buffer, nullptr, 10);
+    return static_cast<nsUInt32>(uiLastNode + 1);
+  }();
+
+  return s_uiNumNodes;
+#else
+  return 1;
+#endif
+}
+
+// static
+nsUInt32 nsPageAllocator::GetCurrentNumaNode()
+{
+#if NS_PAGE_ALLOCATOR_LINUX_FEATURES && defined(SYS_getcpu)
+  unsigned int uiCpu = 0;
+  unsigned int uiNode = 0;
+
+  if (syscall(SYS_getcpu, &uiCpu, &uiNode, nullptr) == 0)
+    return uiNode;
+#endif
+
+  return 0;
+}
+
+// static
+nsUInt64 nsPageAllocator::GetProcessTransparentHugePageBytes()
+{
+#if NS_PAGE_ALLOCATOR_LINUX_FEATURES
+  return ReadProcFileKiloBytes("/proc/self/smaps_rollup", "AnonHugePages:");
+#else
+  return 0;
+#endif
 }
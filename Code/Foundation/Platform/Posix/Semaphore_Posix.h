@@ -5,6 +5,10 @@ NS_FOUNDATION_INTERNAL_HEADER
 
 #include <Foundation/Strings/StringBuilder.h>
 
+#if NS_ENABLED(NS_USE_FUTEX_THREADING)
+#  include <Foundation/Platform/Linux/Futex_Linux.h>
+#endif
+
 #include <fcntl.h>
 #include <semaphore.h>
 #include <sys/stat.h>
@@ -23,10 +27,12 @@ nsSemaphore::~nsSemaphore()
     {
       sem_close(m_hSemaphore.m_pNamed);
     }
+#if NS_DISABLED(NS_USE_FUTEX_THREADING)
     else
     {
       sem_destroy(&m_hSemaphore.m_Unnamed);
     }
+#endif
   }
 }
 
@@ -36,12 +42,16 @@ nsResult nsSemaphore::Create(nsUInt32 uiInitialTokenCount, nsStringView sSharedN
   {
     // create an unnamed semaphore
 
+#if NS_ENABLED(NS_USE_FUTEX_THREADING)
+    m_hSemaphore.m_iTokens = static_cast<nsInt32>(uiInitialTokenCount);
+#else
     if (sem_init(&m_hSemaphore.m_Unnamed, 0, uiInitialTokenCount) != 0)
     {
       return NS_FAILURE;
     }
 
     m_hSemaphore.m_pNamedOrUnnamed = &m_hSemaphore.m_Unnamed;
+#endif
   }
   else
   {
@@ -81,18 +91,84 @@ nsResult nsSemaphore::Open(nsStringView sSharedName)
   return NS_SUCCESS;
 }
 
+#if NS_ENABLED(NS_USE_FUTEX_THREADING)
+
+static bool TryTakeToken(nsInt32& ref_iTokens)
+{
+  nsInt32 iTokens = nsAtomicUtils::Read(ref_iTokens);
+
+  while (iTokens > 0)
+  {
+    const nsInt32 iPrevTokens = nsAtomicUtils::CompareAndSwap(ref_iTokens, iTokens, iTokens - 1);
+    if (iPrevTokens == iTokens)
+      return true;
+
+    iTokens = iPrevTokens;
+  }
+
+  return false;
+}
+
+#endif
+
 void nsSemaphore::AcquireToken()
 {
+#if NS_ENABLED(NS_USE_FUTEX_THREADING)
+  if (m_hSemaphore.m_pNamed == nullptr)
+  {
+    const nsUInt32 uiSpinCount = nsFutex::GetSpinCount();
+    for (nsUInt32 i = 0; i < uiSpinCount; ++i)
+    {
+      if (TryTakeToken(m_hSemaphore.m_iTokens))
+        return;
+
+      nsFutex::Pause();
+    }
+
+    nsAtomicUtils::Increment(m_hSemaphore.m_iNumWaiters);
+
+    while (!TryTakeToken(m_hSemaphore.m_iTokens))
+    {
+      // only goes to sleep, if there are still no tokens
+      nsFutex::Wait(m_hSemaphore.m_iTokens, 0);
+    }
+
+    nsAtomicUtils::Decrement(m_hSemaphore.m_iNumWaiters);
+    return;
+  }
+#endif
+
   NS_VERIFY(sem_wait(m_hSemaphore.m_pNamedOrUnnamed) == 0, "Semaphore token acquisition failed.");
 }
 
 void nsSemaphore::ReturnToken()
 {
+#if NS_ENABLED(NS_USE_FUTEX_THREADING)
+  if (m_hSemaphore.m_pNamed == nullptr)
+  {
+    nsAtomicUtils::Increment(m_hSemaphore.m_iTokens);
+
+    if (nsAtomicUtils::Read(m_hSemaphore.m_iNumWaiters) > 0)
+    {
+      nsFutex::Wake(m_hSemaphore.m_iTokens, 1);
+    }
+
+    return;
+  }
+#endif
+
   NS_VERIFY(sem_post(m_hSemaphore.m_pNamedOrUnnamed) == 0, "Returning a semaphore token failed, most likely due to a AcquireToken() / ReturnToken() mismatch.");
 }
 
 nsResult nsSemaphore::TryAcquireToken()
 {
+#if NS_ENABLED(NS_USE_FUTEX_THREADING)
+  if (m_hSemaphore.m_pNamed == nullptr)
+  {
+    return TryTakeToken(m_hSemaphore.m_iTokens) ? NS_SUCCESS : NS_FAILURE;
+  }
+#endif
+
   // documentation is unclear whether one needs to check errno, or not
   // assuming that this will return 0 only when trywait got a token
 
@@ -1,6 +1,8 @@
 #include <Foundation/System/SystemInformation.h>
 
 #include <Foundation/IO/OSFile.h>
+#include <fcntl.h>
+#include <sched.h>
 #include <unistd.h>
 
 bool nsSystemInformation::IsDebuggerAttached()
@@ -34,6 +36,153 @@ bool nsSystemInformation::IsDebuggerAttached()
   return *tracerPid == '0' ? false : true;
 }
 
+namespace
+{
+  // The system information is set up very early, so the topology is read with the plain file functions, without any allocations.
+  bool ReadSysFile(const char* szPath, char* pBuffer, nsUInt32 uiBufferSize)
+  {
+    const int fd = open(szPath, O_RDONLY);
+    if (fd < 0)
+      return false;
+
+    const ssize_t iBytesRead = read(fd, pBuffer, uiBufferSize - 1);
+    close(fd);
+
+    if (iBytesRead <= 0)
+      return false;
+
+    pBuffer[iBytesRead] = '\0';
+    return true;
+  }
+
+  bool ReadSysFileInt(const char* szPath, nsInt32& out_iValue)
+  {
+    char buffer[32];
+    if (!ReadSysFile(szPath, buffer, NS_ARRAY_SIZE(buffer)))
+      return false;
+
+    out_iValue = static_cast<nsInt32>(strtol(buffer, nullptr, 10));
+    return true;
+  }
+
+  // Returns the index of the entry in pKeys that equals iKey, or appends it.
+  nsUInt16 GetDenseIndex(nsInt64* pKeys, nsUInt32& ref_uiNumKeys, nsInt64 iKey)
+  {
+    for (nsUInt32 i = 0; i < ref_uiNumKeys; ++i)
+    {
+      if (pKeys[i] == iKey)
+        return static_cast<nsUInt16>(i);
+    }
+
+    pKeys[ref_uiNumKeys] = iKey;
+    return static_cast<nsUInt16>(ref_uiNumKeys++);
+  }
+} // namespace
+
+void nsCpuTopology::Detect(nsUInt32 uiNumLogicalProcessors)
+{
+  SetUniform(uiNumLogicalProcessors);
+
+  // a list of ranges, e.g. "0-7,16-23"
+  char onlineList[1024];
+  if (!ReadSysFile("/sys/devices/system/cpu/online", onlineList, NS_ARRAY_SIZE(onlineList)))
+    return;
+
+  // only use the processors that this process may run on
+  cpu_set_t allowed;
+  CPU_ZERO(&allowed);
+  const bool bHasAffinity = sched_getaffinity(0, sizeof(allowed), &allowed) == 0;
+
+  nsInt64 coreKeys[MaxLogicalProcessors];
+  nsInt64 cacheKeys[MaxLogicalProcessors];
+  nsInt64 packageKeys[MaxLogicalProcessors];
+  nsUInt32 uiNumCores = 0;
+  nsUInt32 uiNumCaches = 0;
+  nsUInt32 uiNumPackages = 0;
+  nsUInt32 uiNumProcessors = 0;
+
+  char szPath[128];
+  char buffer[1024];
+
+  for (const char* szRange = onlineList; *szRange != '\0' && uiNumProcessors < MaxLogicalProcessors;)
+  {
+    char* szEnd = nullptr;
+    const nsUInt32 uiFirst = static_cast<nsUInt32>(strtoul(szRange, &szEnd, 10));
+    if (szEnd == szRange)
+      break;
+
+    nsUInt32 uiLast = uiFirst;
+    if (*szEnd == '-')
+    {
+      szRange = szEnd + 1;
+      uiLast = static_cast<nsUInt32>(strtoul(szRange, &szEnd, 10));
+    }
+
+    szRange = (*szEnd == ',') ? szEnd + 1 : szEnd;
+
+    for (nsUInt32 uiCpu = uiFirst; uiCpu <= uiLast && uiNumProcessors < MaxLogicalProcessors; ++uiCpu)
+    {
+      if (bHasAffinity && uiCpu < static_cast<nsUInt32>(CPU_SETSIZE) && !CPU_ISSET(uiCpu, &allowed))
+        continue;
+
+      nsInt32 iPackage = 0;
+      snprintf(szPath, NS_ARRAY_SIZE(szPath), "/sys/devices/system/cpu/cpu%u/topology/physical_package_id", uiCpu);
+      ReadSysFileInt(szPath, iPackage);
+
+      nsInt32 iCore = static_cast<nsInt32>(uiCpu);
+      snprintf(szPath, NS_ARRAY_SIZE(szPath), "/sys/devices/system/cpu/cpu%u/topology/core_id", uiCpu);
+      ReadSysFileInt(szPath, iCore);
+
+      // the cache domain is identified by the first processor that shares the highest cache level
+      // without any cache information, all processors of a package are assumed to share a cache
+      nsInt64 iCacheKey = -1 - iPackage;
+      nsInt32 iHighestLevel = 0;
+
+      for (nsUInt32 uiCacheIndex = 0; uiCacheIndex < 16; ++uiCacheIndex)
+      {
+        nsInt32 iLevel = 0;
+        snprintf(szPath, NS_ARRAY_SIZE(szPath), "/sys/devices/system/cpu/cpu%u/cache/index%u/level", uiCpu, uiCacheIndex);
+        if (!ReadSysFileInt(szPath, iLevel))
+          break;
+
+        snprintf(szPath, NS_ARRAY_SIZE(szPath), "/sys/devices/system/cpu/cpu%u/cache/index%u/shared_cpu_list", uiCpu, uiCacheIndex);
+        if (iLevel > iHighestLevel && ReadSysFile(szPath, buffer, NS_ARRAY_SIZE(buffer)))
+        {
+          iHighestLevel = iLevel;
+          iCacheKey = strtol(buffer, nullptr, 10);
+        }
+      }
+
+      LogicalProcessor& lp = m_LogicalProcessors[uiNumProcessors];
+      lp.m_uiProcessorIndex = static_cast<nsUInt16>(uiCpu);
+      lp.m_uiPackage = GetDenseIndex(packageKeys, uiNumPackages, iPackage);
+      lp.m_uiCore = GetDenseIndex(coreKeys, uiNumCores, (static_cast<nsInt64>(iPackage) << 32) | static_cast<nsUInt32>(iCore));
+      lp.m_uiCacheDomain = GetDenseIndex(cacheKeys, uiNumCaches, iCacheKey);
+      lp.m_uiSiblingIndex = 0;
+
+      for (nsUInt32 i = 0; i < uiNumProcessors; ++i)
+      {
+        if (m_LogicalProcessors[i].m_uiCore == lp.m_uiCore)
+          ++lp.m_uiSiblingIndex;
+      }
+
+      ++uiNumProcessors;
+    }
+  }
+
+  if (uiNumProcessors == 0)
+  {
+    SetUniform(uiNumLogicalProcessors);
+    return;
+  }
+
+  m_bDetected = true;
+  m_uiNumLogicalProcessors = uiNumProcessors;
+  m_uiNumCores = uiNumCores;
+  m_uiNumCacheDomains = uiNumCaches;
+  m_uiNumPackages = uiNumPackages;
+}
+
 void nsSystemInformation::Initialize()
 {
   if (s_SystemInformation.m_bIsInitialized)
@@ -43,6 +192,7 @@ void nsSystemInformation::Initialize()
 
   // Get system information via various APIs
   s_SystemInformation.m_uiCPUCoreCount = sysconf(_SC_NPROCESSORS_ONLN);
+  s_SystemInformation.m_CpuTopology.Detect(s_SystemInformation.m_uiCPUCoreCount);
 
   nsUInt64 uiPageCount = sysconf(_SC_PHYS_PAGES);
   nsUInt64 uiPageSize = sysconf(_SC_PAGE_SIZE);
@@ -8,6 +8,7 @@ NS_FOUNDATION_INTERNAL_HEADER
 // Posix implementation of thread helper functions
 
 #include <pthread.h>
+#include <sched.h>
 
 static pthread_t g_MainThread = (pthread_t)0;
 
@@ -23,7 +24,11 @@ void nsThreadUtils::YieldTimeSlice()
 
 void nsThreadUtils::YieldHardwareThread()
 {
-  // No equivalent to mm_pause on linux
+#if NS_ENABLED(NS_PLATFORM_ARCH_X86)
+  __builtin_ia32_pause();
+#elif NS_ENABLED(NS_PLATFORM_ARCH_ARM)
+  __asm__ __volatile__("yield");
+#endif
 }
 
 void nsThreadUtils::Sleep(const nsTime& duration)
@@ -48,3 +53,22 @@ bool nsThreadUtils::IsMainThread()
 {
   return pthread_self() == g_MainThread;
 }
+
+nsResult nsThreadUtils::SetCurrentThreadAffinity(nsUInt32 uiProcessorIndex)
+{
+#if NS_ENABLED(NS_PLATFORM_LINUX) || NS_ENABLED(NS_PLATFORM_ANDROID)
+  if (uiProcessorIndex >= CPU_SETSIZE)
+    return NS_FAILURE;
+
+  cpu_set_t cpuSet;
+  CPU_ZERO(&cpuSet);
+  CPU_SET(uiProcessorIndex, &cpuSet);
+
+  // on Linux a thread ID of zero refers to the calling thread
+  return sched_setaffinity(0, sizeof(cpuSet), &cpuSet) == 0 ? NS_SUCCESS : NS_FAILURE;
+#else
+  // e.g. macOS only supports affinity hints between threads, but no binding to specific processors
+  NS_IGNORE_UNUSED(uiProcessorIndex);
+  return NS_FAILURE;
+#endif
+}
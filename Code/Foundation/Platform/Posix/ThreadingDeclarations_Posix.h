@@ -8,22 +8,59 @@
 
 using nsThreadHandle = pthread_t;
 using nsThreadID = pthread_t;
-using nsMutexHandle = pthread_mutex_t;
 using nsOSThreadEntryPoint = void* (*)(void* pThreadParameter);
 
+#if NS_ENABLED(NS_USE_FUTEX_THREADING)
+
+struct nsMutexHandle
+{
+  enum : nsInt32
+  {
+    Unlocked = 0,
+    Locked = 1,
+    LockedWithSleepers = 2, // other threads may be sleeping in the futex, unlocking has to wake one up
+  };
+
+  nsInt32 m_iState = Unlocked;
+  nsInt32 m_iRecursion = 0; // how often the owner has locked the mutex
+  nsUInt64 m_uiOwner = 0;   // the pthread_t of the owner, zero while unlocked
+};
+
 struct nsSemaphoreHandle
 {
   sem_t* m_pNamedOrUnnamed = nullptr;
   sem_t* m_pNamed = nullptr;
-  sem_t m_Unnamed;
+
+  // unnamed semaphores are implemented with a futex
+  nsInt32 m_iTokens = 0;
+  nsInt32 m_iNumWaiters = 0;
 };
 
-#define NS_THREAD_CLASS_ENTRY_POINT void* nsThreadClassEntryPoint(void* pThreadParameter);
+struct nsConditionVariableData
+{
+  nsInt32 m_iSequence = 0;
+  nsInt32 m_iNumWaiters = 0;
+};
+
+#else
+
+using nsMutexHandle = pthread_mutex_t;
+
+struct nsSemaphoreHandle
+{
+  sem_t* m_pNamedOrUnnamed = nullptr;
+  sem_t* m_pNamed = nullptr;
+  sem_t m_Unnamed;
+};
 
 struct nsConditionVariableData
 {
   pthread_cond_t m_ConditionVariable;
 };
 
+#endif
+
+#define NS_THREAD_CLASS_ENTRY_POINT void* nsThreadClassEntryPoint(void* pThreadParameter);
+
 
 /// \endcond
@@ -34,6 +34,12 @@ bool nsSystemInformation::IsDebuggerAttached()
   return ::IsDebuggerPresent();
 }
 
+void nsCpuTopology::Detect(nsUInt32 uiNumLogicalProcessors)
+{
+  // the topology is not queried on this platform yet
+  SetUniform(uiNumLogicalProcessors);
+}
+
 void nsSystemInformation::Initialize()
 {
   if (s_SystemInformation.m_bIsInitialized)
@@ -49,6 +55,7 @@ void nsSystemInformation::Initialize()
   GetNativeSystemInfo(&sysInfo);
 
   s_SystemInformation.m_uiCPUCoreCount = sysInfo.dwNumberOfProcessors;
+  s_SystemInformation.m_CpuTopology.Detect(s_SystemInformation.m_uiCPUCoreCount);
   s_SystemInformation.m_uiMemoryPageSize = sysInfo.dwPageSize;
 
   MEMORYSTATUSEX memStatus;
@@ -7,17 +7,72 @@
 #  include <Foundation/System/SystemInformation.h>
 #  include <Foundation/Time/Time.h>
 
+namespace
+{
+  void* VirtualAllocOnNode(size_t uiSize, DWORD uiAllocationType, DWORD uiProtection, nsUInt32 uiNumaNode)
+  {
+    if (uiNumaNode != nsPageAllocator::AnyNumaNode)
+    {
+      return ::VirtualAllocExNuma(::GetCurrentProcess(), nullptr, uiSize, uiAllocationType, uiProtection, uiNumaNode);
+    }
+
+    return ::VirtualAlloc(nullptr, uiSize, uiAllocationType, uiProtection);
+  }
+} // namespace
+
 // static
-void* nsPageAllocator::AllocatePage(size_t uiSize)
+void* nsPageAllocator::AllocatePage(size_t uiSize, size_t uiAlign, nsBitflags<nsPageAllocationFlags> flags, nsUInt32 uiNumaNode)
 {
+  // VirtualAlloc places allocations at multiples of the allocation granularity
+  NS_ASSERT_DEV(uiAlign <= 64 * 1024, "Page allocations can't be aligned to more than 64 KB.");
+
   nsTime fAllocationTime = nsTime::Now();
 
-  void* ptr = ::VirtualAlloc(nullptr, uiSize, MEM_COMMIT | MEM_RESERVE, PAGE_READWRITE);
+  PageInfo info;
+  info.m_uiSize = uiSize;
+  info.m_Flags = flags;
+
+  void* ptr = nullptr;
+
+  if (flags.IsSet(nsPageAllocationFlags::ExplicitHugePages))
+  {
+    // needs the 'Lock pages in memory' privilege, which usually only services have
+    const size_t uiLargePageSize = GetHugePageSize();
+
+    if (uiLargePageSize > 0)
+    {
+      const size_t uiLargeSize = nsMemoryUtils::AlignSize(uiSize, uiLargePageSize);
+      ptr = VirtualAllocOnNode(uiLargeSize, MEM_COMMIT | MEM_RESERVE | MEM_LARGE_PAGES, PAGE_READWRITE, uiNumaNode);
+
+      if (ptr != nullptr)
+      {
+        info.m_uiSize = uiLargeSize;
+        info.m_bExplicitHugePages = true;
+      }
+    }
+
+    if (ptr == nullptr)
+    {
+      AddExplicitHugePageFailure();
+    }
+  }
+
+  if (ptr == nullptr)
+  {
+    // Windows has no transparent huge pages
+    ptr = VirtualAllocOnNode(uiSize, MEM_COMMIT | MEM_RESERVE, PAGE_READWRITE, uiNumaNode);
+
+    // the size that VirtualQuery() reports when the pages are freed again
+    info.m_uiSize = nsMemoryUtils::AlignSize<size_t>(uiSize, nsSystemInformation::Get().GetMemoryPageSize());
+  }
+
   NS_ASSERT_DEV(ptr != nullptr, "Could not allocate memory pages. Error Code '{0}'", nsArgErrorCode(::GetLastError()));
 
-  size_t uiAlign = nsSystemInformation::Get().GetMemoryPageSize();
+  uiAlign = nsMath::Max<size_t>(uiAlign, nsSystemInformation::Get().GetMemoryPageSize());
   NS_CHECK_ALIGNMENT(ptr, uiAlign);
 
+  AddPages(ptr, info);
+
   if constexpr (nsAllocatorTrackingMode::Default >= nsAllocatorTrackingMode::AllocationStats)
   {
     nsMemoryTracker::AddAllocation(nsPageAllocator::GetId(), nsAllocatorTrackingMode::Default, ptr, uiSize, uiAlign, nsTime::Now() - fAllocationTime);
@@ -34,7 +89,95 @@ void nsPageAllocator::DeallocatePage(void* pPtr)
     nsMemoryTracker::RemoveAllocation(nsPageAllocator::GetId(), pPtr);
   }
 
+  PageInfo info;
+  if (!RemoveRecordedPages(pPtr, info))
+  {
+    MEMORY_BASIC_INFORMATION memInfo;
+    NS_VERIFY(::VirtualQuery(pPtr, &memInfo, sizeof(memInfo)) != 0, "Could not query memory pages. Error Code '{0}'", nsArgErrorCode(::GetLastError()));
+
+    RemovePlainPages(memInfo.RegionSize);
+  }
+
   NS_VERIFY(::VirtualFree(pPtr, 0, MEM_RELEASE), "Could not free memory pages. Error Code '{0}'", nsArgErrorCode(::GetLastError()));
 }
 
+// static
+void* nsPageAllocator::ReservePages(size_t uiSize, nsBitflags<nsPageAllocationFlags> flags, nsUInt32 uiNumaNode)
+{
+  NS_ASSERT_DEV(!flags.IsSet(nsPageAllocationFlags::ExplicitHugePages), "Explicit huge pages can't be reserved");
+
+  void* ptr = VirtualAllocOnNode(uiSize, MEM_RESERVE, PAGE_NOACCESS, uiNumaNode);
+
+  if (ptr == nullptr)
+    return nullptr;
+
+  AddReservation(ptr, uiSize, false);
+  return ptr;
+}
+
+// static
+nsResult nsPageAllocator::CommitPages(void* pPtr, size_t uiSize)
+{
+  // the NUMA node that was passed to ReservePages() is used for the committed pages as well
+  if (::VirtualAlloc(pPtr, uiSize, MEM_COMMIT, PAGE_READWRITE) == nullptr)
+    return NS_FAILURE;
+
+  AddCommittedBytes(pPtr, static_cast<nsInt64>(uiSize));
+  return NS_SUCCESS;
+}
+
+// static
+void nsPageAllocator::DecommitPages(void* pPtr, size_t uiSize)
+{
+  NS_VERIFY(::VirtualFree(pPtr, uiSize, MEM_DECOMMIT), "Could not decommit memory pages. Error Code '{0}'", nsArgErrorCode(::GetLastError()));
+
+  AddCommittedBytes(pPtr, -static_cast<nsInt64>(uiSize));
+}
+
+// static
+void nsPageAllocator::ReleasePages(void* pPtr, size_t uiSize)
+{
+  NS_IGNORE_UNUSED(uiSize);
+
+  RemoveReservation(pPtr);
+
+  NS_VERIFY(::VirtualFree(pPtr, 0, MEM_RELEASE), "Could not release memory pages. Error Code '{0}'", nsArgErrorCode(::GetLastError()));
+}
+
+// static
+size_t nsPageAllocator::GetHugePageSize()
+{
+  static size_t s_uiLargePageSize = ::GetLargePageMinimum();
+  return s_uiLargePageSize;
+}
+
+// static
+nsUInt32 nsPageAllocator::GetNumaNodeCount()
+{
+  ULONG uiHighestNode = 0;
+  if (!::GetNumaHighestNodeNumber(&uiHighestNode))
+    return 1;
+
+  return static_cast<nsUInt32>(uiHighestNode) + 1;
+}
+
+// static
+nsUInt32 nsPageAllocator::GetCurrentNumaNode()
+{
+  PROCESSOR_NUMBER processor;
+  ::GetCurrentProcessorNumberEx(&processor);
+
+  USHORT uiNode = 0;
+  if (!::GetNumaProcessorNodeEx(&processor, &uiNode) || uiNode == 0xFFFF)
+    return 0;
+
+  return uiNode;
+}
+
+// static
+nsUInt64 nsPageAllocator::GetProcessTransparentHugePageBytes()
+{
+  return 0;
+}
+
 #endif
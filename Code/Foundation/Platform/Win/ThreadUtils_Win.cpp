@@ -37,4 +37,18 @@ bool nsThreadUtils::IsMainThread()
   return GetCurrentThreadID() == g_uiMainThreadID;
 }
 
+nsResult nsThreadUtils::SetCurrentThreadAffinity(nsUInt32 uiProcessorIndex)
+{
+#  if NS_ENABLED(NS_PLATFORM_WINDOWS_DESKTOP) && NS_ENABLED(NS_PLATFORM_64BIT)
+  // processors beyond the first 64 are in other processor groups, which this does not support
+  if (uiProcessorIndex >= 64)
+    return NS_FAILURE;
+
+  return SetThreadAffinityMask(GetCurrentThread(), DWORD_PTR(1) << uiProcessorIndex) != 0 ? NS_SUCCESS : NS_FAILURE;
+#  else
+  NS_IGNORE_UNUSED(uiProcessorIndex);
+  return NS_FAILURE;
+#  endif
+}
+
 #endif
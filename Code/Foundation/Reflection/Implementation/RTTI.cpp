@@ -6,10 +6,11 @@
 #include <Foundation/Communication/Message.h>
 #include <Foundation/Configuration/Startup.h>
 #include <Foundation/Containers/HashTable.h>
+#include <Foundation/Threading/ReadWriteLock.h>
 
 struct nsTypeData
 {
-  nsMutex m_Mutex;
+  nsReadWriteLock m_Lock;
   nsHashTable<nsUInt64, nsRTTI*, nsHashHelper<nsUInt64>, nsStaticsAllocatorWrapper> m_TypeNameHashToType;
   nsDynamicArray<nsRTTI*> m_AllTypes;
 
@@ -237,7 +238,7 @@ void nsRTTI::RegisterType()
   m_uiTypeNameHash = nsHashingUtils::StringHash(m_sTypeName);
 
   auto pData = GetTypeData();
-  NS_LOCK(pData->m_Mutex);
+  NS_LOCK_WRITE(pData->m_Lock);
   pData->m_TypeNameHashToType.Insert(m_uiTypeNameHash, this);
 
   m_uiTypeIndex = pData->m_AllTypes.GetCount();
@@ -247,7 +248,7 @@ void nsRTTI::RegisterType()
 void nsRTTI::UnregisterType()
 {
   auto pData = GetTypeData();
-  NS_LOCK(pData->m_Mutex);
+  NS_LOCK_WRITE(pData->m_Lock);
   pData->m_TypeNameHashToType.Remove(m_uiTypeNameHash);
 
   NS_ASSERT_DEV(pData->m_bIterating == false, "Unregistering types while iterating over types might cause unexpected behavior");
@@ -273,7 +274,7 @@ const nsRTTI* nsRTTI::FindTypeByName(nsStringView sName)
   nsUInt64 uiNameHash = nsHashingUtils::StringHash(sName);
 
   auto pData = GetTypeData();
-  NS_LOCK(pData->m_Mutex);
+  NS_LOCK_READ(pData->m_Lock);
 
   nsRTTI* pType = nullptr;
   pData->m_TypeNameHashToType.TryGetValue(uiNameHash, pType);
@@ -283,7 +284,7 @@ const nsRTTI* nsRTTI::FindTypeByName(nsStringView sName)
 const nsRTTI* nsRTTI::FindTypeByNameHash(nsUInt64 uiNameHash)
 {
   auto pData = GetTypeData();
-  NS_LOCK(pData->m_Mutex);
+  NS_LOCK_READ(pData->m_Lock);
 
   nsRTTI* pType = nullptr;
   pData->m_TypeNameHashToType.TryGetValue(uiNameHash, pType);
@@ -299,7 +300,7 @@ const nsRTTI* nsRTTI::FindTypeByNameHash32(nsUInt32 uiNameHash)
 const nsRTTI* nsRTTI::FindTypeIf(PredicateFunc func)
 {
   auto pData = GetTypeData();
-  NS_LOCK(pData->m_Mutex);
+  NS_LOCK_READ(pData->m_Lock);
 
   for (const nsRTTI* pRtti : pData->m_AllTypes)
   {
@@ -382,7 +383,7 @@ bool nsRTTI::DispatchMessage(const void* pInstance, nsMessage& ref_msg) const
 void nsRTTI::ForEachType(VisitorFunc func, nsBitflags<ForEachOptions> options /*= ForEachOptions::Default*/)
 {
   auto pData = GetTypeData();
-  NS_LOCK(pData->m_Mutex);
+  NS_LOCK_WRITE(pData->m_Lock);
 
   pData->m_bIterating = true;
   // Can't use ranged based for loop here since we might add new types while iterating and the m_AllTypes array might re-allocate.
@@ -403,7 +404,7 @@ void nsRTTI::ForEachType(VisitorFunc func, nsBitflags<ForEachOptions> options /*
 void nsRTTI::ForEachDerivedType(const nsRTTI* pBaseType, VisitorFunc func, nsBitflags<ForEachOptions> options /*= ForEachOptions::Default*/)
 {
   auto pData = GetTypeData();
-  NS_LOCK(pData->m_Mutex);
+  NS_LOCK_WRITE(pData->m_Lock);
 
   pData->m_bIterating = true;
   // Can't use ranged based for loop here since we might add new types while iterating and the m_AllTypes array might re-allocate.
@@ -429,7 +430,7 @@ void nsRTTI::AssignPlugin(nsStringView sPluginName)
   // assigns the given plugin name to every nsRTTI instance that has no plugin assigned yet
 
   auto pData = GetTypeData();
-  NS_LOCK(pData->m_Mutex);
+  NS_LOCK_WRITE(pData->m_Lock);
 
   for (nsRTTI* pRtti : pData->m_AllTypes)
   {
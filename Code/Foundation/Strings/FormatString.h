@@ -9,6 +9,7 @@ class nsStringBuilder;
 #include <Foundation/Strings/StringView.h>
 
 #include <Foundation/Strings/Implementation/FormatStringArgs.h>
+#include <Foundation/Strings/Implementation/FormatStringLiteral.h>
 
 /// \brief Implements formating of strings with placeholders and formatting options.
 ///
@@ -29,6 +30,11 @@ class nsStringBuilder;
 ///
 /// This allows to call MyFunc() without the 'nsFmt' wrapper.
 ///
+/// Wrapping the format string into NS_FMT splits it into literal texts and placeholders at compile time, instead of every time
+/// the text is generated. This also turns invalid placeholders into compile errors:
+///   MyFunc(nsFmt(NS_FMT("Cool Story {}"), "Bro"));
+///   nsLog::Info(NS_FMT("Cool Story {}"), "Bro");
+///
 ///
 /// === Formatting ===
 ///
@@ -86,6 +92,9 @@ public:
   /// \note We can't use nsArrayPtr here because of include order.
   nsStringView BuildFormattedText(nsStringBuilder& ref_sStorage, nsStringView* pArgs, nsUInt32 uiNumArgs) const;
 
+  /// \brief Same as above, but for a format string that was already split into segments at compile time.
+  nsStringView BuildFormattedText(nsStringBuilder& ref_sStorage, const nsFormatStringSegment* pSegments, nsUInt32 uiNumSegments, const nsStringView* pArgs) const;
+
 protected:
   nsStringView m_sString;
 };
@@ -97,3 +106,9 @@ NS_ALWAYS_INLINE nsFormatStringImpl<ARGS...> nsFmt(const char* szFormat, ARGS&&.
 {
   return nsFormatStringImpl<ARGS...>(szFormat, std::forward<ARGS>(args)...);
 }
+
+template <typename FORMAT, typename... ARGS>
+NS_ALWAYS_INLINE nsFormatStringLiteralImpl<FORMAT, ARGS...> nsFmt(nsFormatStringLiteral<FORMAT>, ARGS&&... args)
+{
+  return nsFormatStringLiteralImpl<FORMAT, ARGS...>(std::forward<ARGS>(args)...);
+}
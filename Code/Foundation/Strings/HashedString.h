@@ -14,7 +14,10 @@ class nsTempHashedString;
 /// (it's a pointer comparison).\n
 /// Copying nsHashedString objects around and assigning between them is very fast as well.\n
 /// \n
-/// Assigning from some other string type is rather slow though, as it requires thread synchronization.\n
+/// Assigning from some other string type is slower, as it requires hashing the string and finding it in the central storage.
+/// Finding a string that already exists doesn't take a lock, only the first insertion of a string does. With
+/// NS_HASHED_STRING_REF_COUNTING enabled, finding a string takes a lock that is shared with a fraction of all strings, because
+/// ClearUnusedStrings() may remove entries at any time.\n
 /// You can also get access to the actual string data via GetString().\n
 /// \n
 /// You should use nsHashedString whenever the size of the encapsulating object is important and when changes to the string itself
@@ -26,15 +29,15 @@ class NS_FOUNDATION_DLL nsHashedString
 public:
   struct HashedData
   {
+    nsUInt64 m_uiHash = 0;
 #if NS_ENABLED(NS_HASHED_STRING_REF_COUNTING)
     nsAtomicInteger32 m_iRefCount;
 #endif
     nsString m_sString;
   };
 
-  // Do NOT use a hash-table! The map does not relocate memory when it resizes, which is a vital aspect for the hashed strings to work.
-  using StringStorage = nsMap<nsUInt64, HashedData, nsCompareHelper<nsUInt64>, nsStaticsAllocatorWrapper>;
-  using HashedType = StringStorage::Iterator;
+  // The central storage never moves or deletes its entries (except through ClearUnusedStrings()), so a plain pointer stays valid.
+  using HashedType = HashedData*;
 
 #if NS_ENABLED(NS_HASHED_STRING_REF_COUNTING)
   /// \brief This will remove all hashed strings from the central storage, that are not referenced anymore.
@@ -71,20 +74,21 @@ public:
   /// \brief Moves the given nsHashedString.
   void operator=(nsHashedString&& rhs); // [tested]
 
-  /// \brief Assigning a new string from a string constant is a slow operation, but the hash computation can happen at compile time.
+  /// \brief Assigning a new string from a string constant requires a lookup in the central storage, but the hash computation can happen at
+  /// compile time.
   ///
   /// If you need to create an object to compare nsHashedString objects against, prefer to use nsTempHashedString. It will only compute
-  /// the strings hash value, but does not require any thread synchronization.
+  /// the strings hash value, but does not need to look it up.
   template <size_t N>
   void Assign(const char (&string)[N]); // [tested]
 
   template <size_t N>
   void Assign(char (&string)[N]) = delete;
 
-  /// \brief Assigning a new string from a non-hashed string is a very slow operation, this should be used rarely.
+  /// \brief Assigning a new string from a non-hashed string requires hashing the string and a lookup in the central storage.
   ///
   /// If you need to create an object to compare nsHashedString objects against, prefer to use nsTempHashedString. It will only compute
-  /// the strings hash value, but does not require any thread synchronization.
+  /// the strings hash value, but does not need to look it up.
   void Assign(nsStringView sString); // [tested]
 
   /// \brief Comparing whether two hashed strings are identical is just a pointer comparison. This operation is what nsHashedString is
@@ -136,7 +140,7 @@ public:
 
   /// \brief Attempts to find a known string for the given hash value.
   ///
-  /// Careful, this is a slow operation (involving a mutex). It is only meant for debug output purposes.
+  /// This is only meant for debug output purposes.
   /// The string hash may not be known, if the value was never assigned to any nsHashedString, in which case NS_FAILURE is returned.
   static nsResult LookupStringHash(nsUInt64 uiHash, nsStringView& out_sResult);
 
@@ -169,8 +173,8 @@ nsHashedString nsMakeHashedString(const char (&string)[N]);
 /// \brief A class to use together with nsHashedString for quick comparisons with temporary strings that need not be stored further.
 ///
 /// Whenever you have objects that use nsHashedString members and you need to compare against them with some temporary string,
-/// prefer to use nsTempHashedString instead of nsHashedString, as the latter requires thread synchronization to actually set up the
-/// object.
+/// prefer to use nsTempHashedString instead of nsHashedString, as the latter requires a lookup in the central string storage to actually
+/// set up the object.
 class NS_FOUNDATION_DLL nsTempHashedString
 {
   friend class nsHashedString;
@@ -74,6 +74,37 @@ nsStringView nsFormatString::BuildFormattedText(nsStringBuilder& ref_sStorage, n
   return ref_sStorage.GetView();
 }
 
+nsStringView nsFormatString::BuildFormattedText(nsStringBuilder& ref_sStorage, const nsFormatStringSegment* pSegments, nsUInt32 uiNumSegments, const nsStringView* pArgs) const
+{
+  const char* szFormat = m_sString.GetStartPointer();
+
+  nsUInt32 uiLength = 0;
+  for (nsUInt32 i = 0; i < uiNumSegments; ++i)
+  {
+    uiLength += pSegments[i].m_uiLiteralLength;
+
+    if (pSegments[i].m_uiArgument != nsFormatStringSegment::NoArgument)
+    {
+      uiLength += pArgs[pSegments[i].m_uiArgument].GetElementCount();
+    }
+  }
+
+  ref_sStorage.Clear();
+  ref_sStorage.Reserve(uiLength);
+
+  for (nsUInt32 i = 0; i < uiNumSegments; ++i)
+  {
+    ref_sStorage.Append(nsStringView(szFormat + pSegments[i].m_uiLiteralStart, pSegments[i].m_uiLiteralLength));
+
+    if (pSegments[i].m_uiArgument != nsFormatStringSegment::NoArgument)
+    {
+      ref_sStorage.Append(pArgs[pSegments[i].m_uiArgument]);
+    }
+  }
+
+  return ref_sStorage.GetView();
+}
+
 //////////////////////////////////////////////////////////////////////////
 
 nsStringView BuildString(char* szTmp, nsUInt32 uiLength, const nsArgI& arg)
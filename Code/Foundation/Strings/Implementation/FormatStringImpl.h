@@ -7,6 +7,7 @@
 template <typename... ARGS>
 class nsFormatStringImpl : public nsFormatString
 {
+protected:
   // this is the size of the temp buffer that BuildString functions get for writing their result to.
   // The buffer is always available and allocated on the stack, so this prevents the need for memory allocations.
   // If a BuildString function requires no storage at all, it can return an nsStringView to unrelated memory
@@ -59,7 +60,7 @@ public:
     return BuildFormattedText(out_sString, param, MaxNumParameters).GetStartPointer();
   }
 
-private:
+protected:
   template <nsInt32 N>
   typename std::enable_if<sizeof...(ARGS) != N>::type ReplaceString(char tmp[MaxNumParameters][TempStringLength], nsStringView* pViews) const
   {
@@ -84,3 +85,51 @@ private:
   // stores the arguments
   std::tuple<ARGS...> m_Arguments;
 };
+
+/// \brief Like nsFormatStringImpl, but for a format string that was already split into segments at compile time, see NS_FMT.
+template <typename FORMAT, typename... ARGS>
+class nsFormatStringLiteralImpl : public nsFormatStringImpl<ARGS...>
+{
+  using Literal = nsFormatStringLiteral<FORMAT>;
+  using Base = nsFormatStringImpl<ARGS...>;
+
+  static_assert(Literal::Layout.m_uiNumArguments <= sizeof...(ARGS), "The format string contains more placeholders than arguments are passed in");
+
+public:
+  explicit nsFormatStringLiteralImpl(ARGS&&... args)
+    : Base(Literal::GetFormat(), std::forward<ARGS>(args)...)
+  {
+  }
+
+  virtual nsStringView GetText(nsStringBuilder& ref_sStorage) const override
+  {
+    if constexpr (Literal::NumSegments == 0)
+    {
+      return {};
+    }
+    else if constexpr (Literal::Layout.m_bIsPlainText)
+    {
+      return this->m_sString;
+    }
+    else
+    {
+      return BuildText(ref_sStorage);
+    }
+  }
+
+  virtual const char* GetTextCStr(nsStringBuilder& out_sString) const override
+  {
+    return BuildText(out_sString).GetStartPointer();
+  }
+
+private:
+  nsStringView BuildText(nsStringBuilder& ref_sStorage) const
+  {
+    nsStringView param[Base::MaxNumParameters];
+
+    char tmp[Base::MaxNumParameters][Base::TempStringLength];
+    this->template ReplaceString<0>(tmp, param);
+
+    return this->BuildFormattedText(ref_sStorage, Literal::Layout.m_Segments, Literal::NumSegments, param);
+  }
+};
@@ -0,0 +1,146 @@
+#pragma once
+
+/// \brief A piece of a format string that was split up at compile time: a literal text, followed by an optional argument.
+struct nsFormatStringSegment
+{
+  static constexpr nsUInt32 NoArgument = 0xFFFFFFFF;
+
+  nsUInt32 m_uiLiteralStart = 0;
+  nsUInt32 m_uiLiteralLength = 0;
+  nsUInt32 m_uiArgument = NoArgument;
+};
+
+namespace nsFormatStringDetail
+{
+  // This function is deliberately not constexpr. Reaching it while a format string is parsed at compile time fails the
+  // compilation and the compiler error will name the function, and thus the problem.
+  inline void InvalidFormatString_SinglePercentageSign() {}
+
+  /// \brief Splits szFormat into segments, with the same rules as nsFormatString::BuildFormattedText().
+  ///
+  /// Writes the segments to pSegments, if it is not null, and returns how many there are.
+  constexpr nsUInt32 ParseFormatString(const char* szFormat, nsFormatStringSegment* pSegments)
+  {
+    nsUInt32 uiNumSegments = 0;
+    nsUInt32 uiLastArgument = nsFormatStringSegment::NoArgument;
+    nsUInt32 uiLiteralStart = 0;
+    nsUInt32 uiPos = 0;
+
+    while (szFormat[uiPos] != '\0')
+    {
+      nsUInt32 uiLiteralEnd = uiPos;
+      nsUInt32 uiArgument = nsFormatStringSegment::NoArgument;
+      nsUInt32 uiNext = uiPos;
+
+      if (szFormat[uiPos] == '%')
+      {
+        if (szFormat[uiPos + 1] != '%')
+        {
+          InvalidFormatString_SinglePercentageSign();
+        }
+
+        // the first percentage sign is kept as part of the literal text, the second one is skipped
+        uiLiteralEnd = uiPos + 1;
+        uiNext = uiPos + 2;
+      }
+      else if (szFormat[uiPos] == '{' && szFormat[uiPos + 1] >= '0' && szFormat[uiPos + 1] <= '9' && szFormat[uiPos + 2] == '}')
+      {
+        uiArgument = static_cast<nsUInt32>(szFormat[uiPos + 1] - '0');
+        uiLastArgument = uiArgument;
+        uiNext = uiPos + 3;
+      }
+      else if (szFormat[uiPos] == '{' && szFormat[uiPos + 1] == '}')
+      {
+        uiArgument = ++uiLastArgument;
+        uiNext = uiPos + 2;
+      }
+      else
+      {
+        ++uiPos;
+        continue;
+      }
+
+      if (pSegments != nullptr)
+      {
+        pSegments[uiNumSegments].m_uiLiteralStart = uiLiteralStart;
+        pSegments[uiNumSegments].m_uiLiteralLength = uiLiteralEnd - uiLiteralStart;
+        pSegments[uiNumSegments].m_uiArgument = uiArgument;
+      }
+
+      ++uiNumSegments;
+      uiLiteralStart = uiNext;
+      uiPos = uiNext;
+    }
+
+    if (uiLiteralStart < uiPos)
+    {
+      if (pSegments != nullptr)
+      {
+        pSegments[uiNumSegments].m_uiLiteralStart = uiLiteralStart;
+        pSegments[uiNumSegments].m_uiLiteralLength = uiPos - uiLiteralStart;
+      }
+
+      ++uiNumSegments;
+    }
+
+    return uiNumSegments;
+  }
+
+  /// \brief Holds all segments of a format string. Only meant to be created at compile time, through nsFormatStringLiteral.
+  template <nsUInt32 NumSegments>
+  struct SegmentLayout
+  {
+    constexpr explicit SegmentLayout(const char* szFormat)
+    {
+      ParseFormatString(szFormat, m_Segments);
+
+      for (nsUInt32 i = 0; i < NumSegments; ++i)
+      {
+        if (m_Segments[i].m_uiArgument != nsFormatStringSegment::NoArgument && m_Segments[i].m_uiArgument >= m_uiNumArguments)
+        {
+          m_uiNumArguments = m_Segments[i].m_uiArgument + 1;
+        }
+
+        m_uiLength += m_Segments[i].m_uiLiteralLength;
+      }
+
+      // a single segment without arguments that covers the whole string can be used directly, without formatting it
+      m_bIsPlainText = NumSegments == 1 && m_uiNumArguments == 0 && szFormat[m_uiLength] == '\0';
+    }
+
+    nsFormatStringSegment m_Segments[NumSegments > 0 ? NumSegments : 1] = {};
+    nsUInt32 m_uiNumArguments = 0;
+    nsUInt32 m_uiLength = 0;
+    bool m_bIsPlainText = false;
+  };
+} // namespace nsFormatStringDetail
+
+/// \brief A format string that is split into literal texts and placeholders at compile time. Created through NS_FMT.
+///
+/// Functions that accept an nsFormatStringLiteral instead of a string, e.g. nsLog::Info() and nsStringBuilder::SetFormat(),
+/// don't need to parse the format string every time they are called. Invalid format strings and format strings that reference
+/// more arguments than are passed in, fail to compile.
+///
+/// FORMAT is a type with a static constexpr function GetFormat() that returns the string literal. Every use of NS_FMT creates
+/// a new such type.
+template <typename FORMAT>
+struct nsFormatStringLiteral
+{
+  static constexpr const char* GetFormat() { return FORMAT::GetFormat(); }
+
+  static constexpr nsUInt32 NumSegments = nsFormatStringDetail::ParseFormatString(FORMAT::GetFormat(), nullptr);
+  static constexpr nsFormatStringDetail::SegmentLayout<NumSegments> Layout = nsFormatStringDetail::SegmentLayout<NumSegments>(FORMAT::GetFormat());
+};
+
+/// \brief Turns a string literal into an nsFormatStringLiteral, whose placeholders are parsed at compile time.
+///
+/// Example:
+///   nsLog::Info(NS_FMT("Loaded {} files in {}"), uiNumFiles, tDuration);
+#define NS_FMT(szFormat)                                           \
+  [] {                                                             \
+    struct nsFormatStringLiteralText                               \
+    {                                                              \
+      static constexpr const char* GetFormat() { return szFormat; } \
+    };                                                             \
+    return nsFormatStringLiteral<nsFormatStringLiteralText>();     \
+  }()
@@ -1,19 +1,183 @@
 #include <Foundation/FoundationPCH.h>
 
+#include <Foundation/Containers/DynamicArray.h>
 #include <Foundation/Logging/Log.h>
 #include <Foundation/Strings/HashedString.h>
 #include <Foundation/Threading/Lock.h>
 #include <Foundation/Threading/Mutex.h>
 
+#include <atomic>
+
+// The central storage is split into shards, selected by the upper bits of the hash, so that threads that insert different strings
+// rarely wait for each other. Every shard is an open addressing table of pointers to its entries. Entries are allocated in blocks
+// and are never moved, so finding an existing string only needs to read the slots and never takes a lock.
+// Inserting takes the mutex of the shard. When a shard grows, the new slot array is published atomically and the old one is kept
+// alive, because other threads may still be searching it. Those threads then simply don't find the new string and insert it under
+// the lock, where they find it in the new array.
+// With NS_HASHED_STRING_REF_COUNTING, ClearUnusedStrings() destroys entries and rebuilds the slots of a shard. A lookup that found an
+// entry without the lock could then increase the ref count of a destroyed entry, so in that configuration all lookups take the
+// mutex of the shard as well.
+
+namespace
+{
+  enum
+  {
+    SHARD_BITS = 5,
+    NUM_SHARDS = 1 << SHARD_BITS,
+    INITIAL_SLOTS = 16,
+    ENTRIES_PER_BLOCK = 64,
+  };
+
+  using HashedData = nsHashedString::HashedData;
+  using Slot = std::atomic<HashedData*>;
+
+  // Followed in memory by m_uiMask + 1 slots. The array is at most half full, so every probe sequence ends at an empty slot.
+  struct SlotArray
+  {
+    nsUInt32 m_uiMask = 0;
+    SlotArray* m_pRetired = nullptr; // the previous, smaller array
+
+    NS_ALWAYS_INLINE Slot* GetSlots() { return reinterpret_cast<Slot*>(this + 1); }
+  };
+
+  struct alignas(64) Shard
+  {
+    std::atomic<SlotArray*> m_pSlots{nullptr};
+
+    // everything below is only accessed while m_Mutex is held
+    nsMutex m_Mutex;
+    nsUInt32 m_uiCount = 0;
+    nsUInt32 m_uiBlockEntriesUsed = ENTRIES_PER_BLOCK;
+    HashedData* m_pBlock = nullptr;
+
+#if NS_ENABLED(NS_HASHED_STRING_REF_COUNTING)
+    nsDynamicArray<HashedData*, nsStaticsAllocatorWrapper> m_FreeEntries;
+#endif
+  };
+
+  SlotArray* AllocateSlots(nsUInt32 uiNumSlots)
+  {
+    void* pMemory = nsStaticsAllocatorWrapper::GetAllocator()->Allocate(sizeof(SlotArray) + sizeof(Slot) * uiNumSlots, alignof(SlotArray));
+
+    SlotArray* pSlots = new (pMemory) SlotArray();
+    pSlots->m_uiMask = uiNumSlots - 1;
+
+    Slot* pSlotData = pSlots->GetSlots();
+    for (nsUInt32 i = 0; i < uiNumSlots; ++i)
+    {
+      new (pSlotData + i) Slot(nullptr);
+    }
+
+    return pSlots;
+  }
+
+  HashedData* FindEntry(SlotArray* pSlots, nsUInt64 uiHash)
+  {
+    Slot* pSlotData = pSlots->GetSlots();
+
+    for (nsUInt32 uiIndex = static_cast<nsUInt32>(uiHash) & pSlots->m_uiMask;; uiIndex = (uiIndex + 1) & pSlots->m_uiMask)
+    {
+      // pairs with the release store in InsertEntry(), the entry is fully constructed when we see it
+      HashedData* pEntry = pSlotData[uiIndex].load(std::memory_order_acquire);
+
+      if (pEntry == nullptr || pEntry->m_uiHash == uiHash)
+        return pEntry;
+    }
+  }
+
+  void InsertEntry(SlotArray* pSlots, HashedData* pEntry)
+  {
+    Slot* pSlotData = pSlots->GetSlots();
+
+    nsUInt32 uiIndex = static_cast<nsUInt32>(pEntry->m_uiHash) & pSlots->m_uiMask;
+    while (pSlotData[uiIndex].load(std::memory_order_relaxed) != nullptr)
+    {
+      uiIndex = (uiIndex + 1) & pSlots->m_uiMask;
+    }
+
+    pSlotData[uiIndex].store(pEntry, std::memory_order_release);
+  }
+
+  SlotArray* GrowShard(Shard& ref_shard)
+  {
+    SlotArray* pOldSlots = ref_shard.m_pSlots.load(std::memory_order_relaxed);
+    SlotArray* pNewSlots = AllocateSlots((pOldSlots->m_uiMask + 1) * 2);
+
+    // other threads may still be searching the old array, so it is never deallocated
+    pNewSlots->m_pRetired = pOldSlots;
+
+    Slot* pOldSlotData = pOldSlots->GetSlots();
+    for (nsUInt32 i = 0; i <= pOldSlots->m_uiMask; ++i)
+    {
+      if (HashedData* pEntry = pOldSlotData[i].load(std::memory_order_relaxed))
+      {
+        InsertEntry(pNewSlots, pEntry);
+      }
+    }
+
+    ref_shard.m_pSlots.store(pNewSlots, std::memory_order_release);
+    return pNewSlots;
+  }
+
+  HashedData* AllocateEntry(Shard& ref_shard)
+  {
+#if NS_ENABLED(NS_HASHED_STRING_REF_COUNTING)
+    if (!ref_shard.m_FreeEntries.IsEmpty())
+    {
+      HashedData* pEntry = ref_shard.m_FreeEntries.PeekBack();
+      ref_shard.m_FreeEntries.PopBack();
+      return new (pEntry) HashedData();
+    }
+#endif
+
+    if (ref_shard.m_uiBlockEntriesUsed == ENTRIES_PER_BLOCK)
+    {
+      ref_shard.m_pBlock = static_cast<HashedData*>(nsStaticsAllocatorWrapper::GetAllocator()->Allocate(sizeof(HashedData) * ENTRIES_PER_BLOCK, alignof(HashedData)));
+      ref_shard.m_uiBlockEntriesUsed = 0;
+    }
+
+    return new (ref_shard.m_pBlock + ref_shard.m_uiBlockEntriesUsed++) HashedData();
+  }
+} // namespace
+
 struct HashedStringData
 {
-  nsMutex m_Mutex;
-  nsHashedString::StringStorage m_Storage;
-  nsHashedString::HashedType m_Empty;
+  HashedStringData()
+  {
+    for (Shard& shard : m_Shards)
+    {
+      shard.m_pSlots.store(AllocateSlots(INITIAL_SLOTS), std::memory_order_relaxed);
+    }
+  }
+
+  NS_ALWAYS_INLINE Shard& GetShard(nsUInt64 uiHash) { return m_Shards[uiHash >> (64 - SHARD_BITS)]; }
+
+  Shard m_Shards[NUM_SHARDS];
+  nsHashedString::HashedType m_Empty = nullptr;
 };
 
 static HashedStringData* s_pHSData;
 
+// if the string already exists, just increase the refcount
+static void AddExistingHashedString(nsHashedString::HashedType pData, nsStringView sString, nsUInt64 uiHash)
+{
+  NS_IGNORE_UNUSED(pData);
+  NS_IGNORE_UNUSED(sString);
+  NS_IGNORE_UNUSED(uiHash);
+
+#if NS_ENABLED(NS_COMPILE_FOR_DEVELOPMENT)
+  if (pData->m_sString != sString)
+  {
+    // TODO: I think this should be a more serious issue
+    nsLog::Error("Hash collision encountered: Strings \"{}\" and \"{}\" both hash to {}.", nsArgSensitive(pData->m_sString), nsArgSensitive(sString), uiHash);
+  }
+#endif
+
+#if NS_ENABLED(NS_HASHED_STRING_REF_COUNTING)
+  pData->m_iRefCount.Increment();
+#endif
+}
+
 NS_MSVC_ANALYSIS_WARNING_PUSH
 NS_MSVC_ANALYSIS_WARNING_DISABLE(6011) // Disable warning for null pointer dereference as InitHashedString() will ensure that s_pHSData is set
 
@@ -23,37 +187,46 @@ nsHashedString::HashedType nsHashedString::AddHashedString(nsStringView sString,
   if (s_pHSData == nullptr)
     InitHashedString();
 
-  NS_LOCK(s_pHSData->m_Mutex);
-
-  // try to find the existing string
-  bool bExisted = false;
-  auto ret = s_pHSData->m_Storage.FindOrAdd(uiHash, &bExisted);
+  Shard& shard = s_pHSData->GetShard(uiHash);
 
-  // if it already exists, just increase the refcount
-  if (bExisted)
+#if NS_DISABLED(NS_HASHED_STRING_REF_COUNTING)
+  // most strings already exist, finding them doesn't need a lock
+  if (HashedType pExisting = FindEntry(shard.m_pSlots.load(std::memory_order_acquire), uiHash))
   {
-#if NS_ENABLED(NS_COMPILE_FOR_DEVELOPMENT)
-    if (ret.Value().m_sString != sString)
-    {
-      // TODO: I think this should be a more serious issue
-      nsLog::Error("Hash collision encountered: Strings \"{}\" and \"{}\" both hash to {}.", nsArgSensitive(ret.Value().m_sString), nsArgSensitive(sString), uiHash);
-    }
+    AddExistingHashedString(pExisting, sString, uiHash);
+    return pExisting;
+  }
 #endif
 
-#if NS_ENABLED(NS_HASHED_STRING_REF_COUNTING)
-    ret.Value().m_iRefCount.Increment();
-#endif
+  NS_LOCK(shard.m_Mutex);
+
+  // another thread may have added the string in the meantime
+  SlotArray* pSlots = shard.m_pSlots.load(std::memory_order_relaxed);
+  HashedType pData = FindEntry(pSlots, uiHash);
+
+  if (pData != nullptr)
+  {
+    AddExistingHashedString(pData, sString, uiHash);
+    return pData;
   }
-  else
+
+  if ((shard.m_uiCount + 1) * 2 > pSlots->m_uiMask + 1)
   {
-    nsHashedString::HashedData& d = ret.Value();
+    pSlots = GrowShard(shard);
+  }
+
+  pData = AllocateEntry(shard);
+  pData->m_uiHash = uiHash;
 #if NS_ENABLED(NS_HASHED_STRING_REF_COUNTING)
-    d.m_iRefCount = 1;
+  pData->m_iRefCount = 1;
 #endif
-    d.m_sString = sString;
-  }
+  pData->m_sString = sString;
 
-  return ret;
+  // publishes the entry to all other threads
+  InsertEntry(pSlots, pData);
+  ++shard.m_uiCount;
+
+  return pData;
 }
 
 NS_MSVC_ANALYSIS_WARNING_POP
@@ -72,26 +245,51 @@ void nsHashedString::InitHashedString()
 
 #if NS_ENABLED(NS_HASHED_STRING_REF_COUNTING)
   // this one should never get deleted, so make sure its refcount is 2
-  s_pHSData->m_Empty.Value().m_iRefCount.Increment();
+  s_pHSData->m_Empty->m_iRefCount.Increment();
 #endif
 }
 
 #if NS_ENABLED(NS_HASHED_STRING_REF_COUNTING)
 nsUInt32 nsHashedString::ClearUnusedStrings()
 {
-  NS_LOCK(s_pHSData->m_Mutex);
-
   nsUInt32 uiDeleted = 0;
+  nsDynamicArray<HashedType> usedEntries;
 
-  for (auto it = s_pHSData->m_Storage.GetIterator(); it.IsValid();)
+  for (Shard& shard : s_pHSData->m_Shards)
   {
-    if (it.Value().m_iRefCount == 0)
+    NS_LOCK(shard.m_Mutex);
+
+    SlotArray* pSlots = shard.m_pSlots.load(std::memory_order_relaxed);
+    Slot* pSlotData = pSlots->GetSlots();
+
+    usedEntries.Clear();
+
+    for (nsUInt32 i = 0; i <= pSlots->m_uiMask; ++i)
+    {
+      HashedType pData = pSlotData[i].exchange(nullptr, std::memory_order_relaxed);
+
+      if (pData == nullptr)
+        continue;
+
+      if (pData->m_iRefCount == 0)
+      {
+        pData->~HashedData();
+        shard.m_FreeEntries.PushBack(pData);
+        ++uiDeleted;
+      }
+      else
+      {
+        usedEntries.PushBack(pData);
+      }
+    }
+
+    // removed entries would leave gaps in the probe sequences of the others, so the remaining entries are inserted again
+    for (HashedType pData : usedEntries)
     {
-      it = s_pHSData->m_Storage.Remove(it);
-      ++uiDeleted;
+      InsertEntry(pSlots, pData);
     }
-    else
-      ++it;
+
+    shard.m_uiCount = usedEntries.GetCount();
   }
 
   return uiDeleted;
@@ -112,7 +310,7 @@ nsHashedString::nsHashedString()
 
   m_Data = s_pHSData->m_Empty;
 #if NS_ENABLED(NS_HASHED_STRING_REF_COUNTING)
-  m_Data.Value().m_iRefCount.Increment();
+  m_Data->m_iRefCount.Increment();
 #endif
 }
 
@@ -131,9 +329,9 @@ void nsHashedString::Clear()
     HashedType tmp = m_Data;
 
     m_Data = s_pHSData->m_Empty;
-    m_Data.Value().m_iRefCount.Increment();
+    m_Data->m_iRefCount.Increment();
 
-    tmp.Value().m_iRefCount.Decrement();
+    tmp->m_iRefCount.Decrement();
   }
 #else
   m_Data = s_pHSData->m_Empty;
@@ -142,12 +340,18 @@ void nsHashedString::Clear()
 
 nsResult nsHashedString::LookupStringHash(nsUInt64 uiHash, nsStringView& out_sResult)
 {
-  NS_LOCK(s_pHSData->m_Mutex);
-  auto it = s_pHSData->m_Storage.Find(uiHash);
+  Shard& shard = s_pHSData->GetShard(uiHash);
+
+#if NS_ENABLED(NS_HASHED_STRING_REF_COUNTING)
+  // see the comment at the top, ClearUnusedStrings() may destroy entries at any time
+  NS_LOCK(shard.m_Mutex);
+#endif
+
+  HashedType pData = FindEntry(shard.m_pSlots.load(std::memory_order_acquire), uiHash);
 
-  if (!it.IsValid())
+  if (pData == nullptr)
     return NS_FAILURE;
 
-  out_sResult = it.Value().m_sString;
+  out_sResult = pData->m_sString;
   return NS_SUCCESS;
 }
@@ -9,24 +9,24 @@ inline nsHashedString::nsHashedString(const nsHashedString& rhs)
 #if NS_ENABLED(NS_HASHED_STRING_REF_COUNTING)
   // the string has a refcount of at least one (rhs holds a reference), thus it will definitely not get deleted on some other thread
   // therefore we can simply increase the refcount without locking
-  m_Data.Value().m_iRefCount.Increment();
+  m_Data->m_iRefCount.Increment();
 #endif
 }
 
 NS_FORCE_INLINE nsHashedString::nsHashedString(nsHashedString&& rhs)
 {
   m_Data = rhs.m_Data;
-  rhs.m_Data = HashedType(); // This leaves the string in an invalid state, all operations will fail except the destructor
+  rhs.m_Data = nullptr; // This leaves the string in an invalid state, all operations will fail except the destructor
 }
 
 #if NS_ENABLED(NS_HASHED_STRING_REF_COUNTING)
 inline nsHashedString::~nsHashedString()
 {
   // Explicit check if data is still valid. It can be invalid if this string has been moved.
-  if (m_Data.IsValid())
+  if (m_Data != nullptr)
   {
     // just decrease the refcount of the object that we are set to, it might reach refcount zero, but we don't care about that here
-    m_Data.Value().m_iRefCount.Decrement();
+    m_Data->m_iRefCount.Decrement();
   }
 }
 #endif
@@ -37,9 +37,9 @@ inline void nsHashedString::operator=(const nsHashedString& rhs)
   HashedType tmp = rhs.m_Data;
 
 #if NS_ENABLED(NS_HASHED_STRING_REF_COUNTING)
-  tmp.Value().m_iRefCount.Increment();
+  tmp->m_iRefCount.Increment();
 
-  m_Data.Value().m_iRefCount.Decrement();
+  m_Data->m_iRefCount.Decrement();
 #endif
 
   m_Data = tmp;
@@ -48,11 +48,11 @@ inline void nsHashedString::operator=(const nsHashedString& rhs)
 NS_FORCE_INLINE void nsHashedString::operator=(nsHashedString&& rhs)
 {
 #if NS_ENABLED(NS_HASHED_STRING_REF_COUNTING)
-  m_Data.Value().m_iRefCount.Decrement();
+  m_Data->m_iRefCount.Decrement();
 #endif
 
   m_Data = rhs.m_Data;
-  rhs.m_Data = HashedType();
+  rhs.m_Data = nullptr;
 }
 
 template <size_t N>
@@ -65,7 +65,7 @@ NS_FORCE_INLINE void nsHashedString::Assign(const char (&string)[N])
   m_Data = AddHashedString(string, nsHashingUtils::StringHash(string));
 
 #if NS_ENABLED(NS_HASHED_STRING_REF_COUNTING)
-  tmp.Value().m_iRefCount.Decrement();
+  tmp->m_iRefCount.Decrement();
 #endif
 }
 
@@ -78,7 +78,7 @@ NS_FORCE_INLINE void nsHashedString::Assign(nsStringView sString)
   m_Data = AddHashedString(sString, nsHashingUtils::StringHash(sString));
 
 #if NS_ENABLED(NS_HASHED_STRING_REF_COUNTING)
-  tmp.Value().m_iRefCount.Decrement();
+  tmp->m_iRefCount.Decrement();
 #endif
 }
 
@@ -89,37 +89,37 @@ inline bool nsHashedString::operator==(const nsHashedString& rhs) const
 
 inline bool nsHashedString::operator==(const nsTempHashedString& rhs) const
 {
-  return m_Data.Key() == rhs.m_uiHash;
+  return m_Data->m_uiHash == rhs.m_uiHash;
 }
 
 inline bool nsHashedString::operator!=(const nsTempHashedString& rhs) const
 {
-  return m_Data.Key() != rhs.m_uiHash;
+  return m_Data->m_uiHash != rhs.m_uiHash;
 }
 
 inline bool nsHashedString::operator<(const nsHashedString& rhs) const
 {
-  return m_Data.Key() < rhs.m_Data.Key();
+  return m_Data->m_uiHash < rhs.m_Data->m_uiHash;
 }
 
 inline bool nsHashedString::operator<(const nsTempHashedString& rhs) const
 {
-  return m_Data.Key() < rhs.m_uiHash;
+  return m_Data->m_uiHash < rhs.m_uiHash;
 }
 
 NS_ALWAYS_INLINE const nsString& nsHashedString::GetString() const
 {
-  return m_Data.Value().m_sString;
+  return m_Data->m_sString;
 }
 
 NS_ALWAYS_INLINE const char* nsHashedString::GetData() const
 {
-  return m_Data.Value().m_sString.GetData();
+  return m_Data->m_sString.GetData();
 }
 
 NS_ALWAYS_INLINE nsUInt64 nsHashedString::GetHash() const
 {
-  return m_Data.Key();
+  return m_Data->m_uiHash;
 }
 
 template <size_t N>
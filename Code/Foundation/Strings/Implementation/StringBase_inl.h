@@ -237,7 +237,7 @@ NS_ALWAYS_INLINE std::strong_ordering operator<=>(const nsStringBase<DerivedLhs>
   return lhs.Compare(rhs) <=> 0;
 }
 
-template <typename DerivedLhs, typename DerivedRhs>
+template <typename DerivedLhs>
 NS_ALWAYS_INLINE std::strong_ordering operator<=>(const nsStringBase<DerivedLhs>& lhs, const char* rhs)
 {
   return lhs.Compare(rhs) <=> 0;
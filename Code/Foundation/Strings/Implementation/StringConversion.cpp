@@ -84,16 +84,17 @@ void nsStringWChar::operator=(nsStringView sUtf8)
     // skip any Utf8 Byte Order Mark
     nsUnicodeUtils::SkipUtf8Bom(szUtf8);
 
-    nsUnicodeUtils::UtfInserter<wchar_t, nsHybridArray<wchar_t, BufferSize>> tempInserter(&m_Data);
-
-    while (szUtf8 < sUtf8.GetEndPointer() && *szUtf8 != '\0')
+    // the view may contain a terminator before its end
+    const char* szUtf8End = sUtf8.GetEndPointer();
+    if (szUtf8 < szUtf8End)
     {
-      // decode utf8 to utf32
-      const nsUInt32 uiUtf32 = nsUnicodeUtils::DecodeUtf8ToUtf32(szUtf8);
-
-      // encode utf32 to wchar_t
-      nsUnicodeUtils::EncodeUtf32ToWChar(uiUtf32, tempInserter);
+      if (const void* pTerminator = memchr(szUtf8, '\0', static_cast<size_t>(szUtf8End - szUtf8)))
+        szUtf8End = static_cast<const char*>(pTerminator);
     }
+
+    // every byte produces at most one wchar_t
+    m_Data.SetCountUninitialized(static_cast<nsUInt32>(szUtf8End - szUtf8));
+    m_Data.SetCountUninitialized(nsUnicodeUtils::ConvertUtf8ToWChar(szUtf8, szUtf8End, m_Data.GetData()));
   }
 
   // append terminator
@@ -136,16 +137,11 @@ void nsStringUtf8::operator=(const nsUInt16* pUtf16)
     nsUnicodeUtils::SkipUtf16BomLE(pUtf16);
     NS_ASSERT_DEV(!nsUnicodeUtils::SkipUtf16BomBE(pUtf16), "Utf-16 Big Endian is currently not supported.");
 
-    nsUnicodeUtils::UtfInserter<char, nsHybridArray<char, BufferSize>> tempInserter(&m_Data);
+    const nsUInt32 uiElements = nsStringUtils::GetStringElementCount(pUtf16);
 
-    while (*pUtf16 != '\0')
-    {
-      // decode utf8 to utf32
-      const nsUInt32 uiUtf32 = nsUnicodeUtils::DecodeUtf16ToUtf32(pUtf16);
-
-      // encode utf32 to wchar_t
-      nsUnicodeUtils::EncodeUtf32ToUtf8(uiUtf32, tempInserter);
-    }
+    // every Utf16 element produces at most three bytes
+    m_Data.SetCountUninitialized(uiElements * 3);
+    m_Data.SetCountUninitialized(nsUnicodeUtils::ConvertUtf16ToUtf8(pUtf16, pUtf16 + uiElements, m_Data.GetData()));
   }
 
   // append terminator
@@ -159,17 +155,11 @@ void nsStringUtf8::operator=(const nsUInt32* pUtf32)
 
   if (pUtf32 != nullptr)
   {
-    nsUnicodeUtils::UtfInserter<char, nsHybridArray<char, BufferSize>> tempInserter(&m_Data);
-
-    while (*pUtf32 != '\0')
-    {
-      // decode utf8 to utf32
-      const nsUInt32 uiUtf32 = *pUtf32;
-      ++pUtf32;
+    const nsUInt32 uiElements = nsStringUtils::GetStringElementCount(pUtf32);
 
-      // encode utf32 to wchar_t
-      nsUnicodeUtils::EncodeUtf32ToUtf8(uiUtf32, tempInserter);
-    }
+    // every Utf32 element produces at most four bytes
+    m_Data.SetCountUninitialized(uiElements * 4);
+    m_Data.SetCountUninitialized(nsUnicodeUtils::ConvertUtf32ToUtf8(pUtf32, pUtf32 + uiElements, m_Data.GetData()));
   }
 
   // append terminator
@@ -182,16 +172,11 @@ void nsStringUtf8::operator=(const wchar_t* pWChar)
 
   if (pWChar != nullptr)
   {
-    nsUnicodeUtils::UtfInserter<char, nsHybridArray<char, BufferSize>> tempInserter(&m_Data);
-
-    while (*pWChar != '\0')
-    {
-      // decode utf8 to utf32
-      const nsUInt32 uiUtf32 = nsUnicodeUtils::DecodeWCharToUtf32(pWChar);
+    const nsUInt32 uiElements = nsStringUtils::GetStringElementCount(pWChar);
 
-      // encode utf32 to wchar_t
-      nsUnicodeUtils::EncodeUtf32ToUtf8(uiUtf32, tempInserter);
-    }
+    // every wchar_t produces at most four bytes
+    m_Data.SetCountUninitialized(uiElements * 4);
+    m_Data.SetCountUninitialized(nsUnicodeUtils::ConvertWCharToUtf8(pWChar, pWChar + uiElements, m_Data.GetData()));
   }
 
   // append terminator
@@ -238,16 +223,11 @@ void nsStringUtf16::operator=(const char* szUtf8)
     // skip any Utf8 Byte Order Mark
     nsUnicodeUtils::SkipUtf8Bom(szUtf8);
 
-    nsUnicodeUtils::UtfInserter<nsUInt16, nsHybridArray<nsUInt16, BufferSize>> tempInserter(&m_Data);
+    const nsUInt32 uiElements = nsStringUtils::GetStringElementCount(szUtf8);
 
-    while (*szUtf8 != '\0')
-    {
-      // decode utf8 to utf32
-      const nsUInt32 uiUtf32 = nsUnicodeUtils::DecodeUtf8ToUtf32(szUtf8);
-
-      // encode utf32 to wchar_t
-      nsUnicodeUtils::EncodeUtf32ToUtf16(uiUtf32, tempInserter);
-    }
+    // every byte produces at most one Utf16 element
+    m_Data.SetCountUninitialized(uiElements);
+    m_Data.SetCountUninitialized(nsUnicodeUtils::ConvertUtf8ToUtf16(szUtf8, szUtf8 + uiElements, m_Data.GetData()));
   }
 
   // append terminator
@@ -338,11 +318,11 @@ void nsStringUtf32::operator=(const char* szUtf8)
     // skip any Utf8 Byte Order Mark
     nsUnicodeUtils::SkipUtf8Bom(szUtf8);
 
-    while (*szUtf8 != '\0')
-    {
-      // decode utf8 to utf32
-      m_Data.PushBack(nsUnicodeUtils::DecodeUtf8ToUtf32(szUtf8));
-    }
+    const nsUInt32 uiElements = nsStringUtils::GetStringElementCount(szUtf8);
+
+    // every byte produces at most one Utf32 element
+    m_Data.SetCountUninitialized(uiElements);
+    m_Data.SetCountUninitialized(nsUnicodeUtils::ConvertUtf8ToUtf32(szUtf8, szUtf8 + uiElements, m_Data.GetData()));
   }
 
   // append terminator
@@ -0,0 +1,169 @@
+#include <Foundation/FoundationPCH.h>
+
+#include <Foundation/Strings/Implementation/StringSimd.h>
+#include <Foundation/Strings/StringSearcher.h>
+
+namespace
+{
+  // rough estimate how common a byte is in text, names and paths, higher values are more common
+  nsUInt32 GetByteFrequencyRank(nsUInt8 uiByte)
+  {
+    // lower case letters in the order of their frequency in English text
+    const char* szLetters = "etaoinsrhldcumfpgwybvkxjqz";
+
+    if (uiByte == ' ')
+      return 255;
+
+    if (uiByte >= 'a' && uiByte <= 'z')
+      return 250 - 4 * static_cast<nsUInt32>(strchr(szLetters, uiByte) - szLetters);
+
+    if (uiByte >= 'A' && uiByte <= 'Z')
+      return 150 - 2 * static_cast<nsUInt32>(strchr(szLetters, uiByte - 'A' + 'a') - szLetters);
+
+    if (strchr(".,/\\_-:()\"'\n\t", uiByte) != nullptr)
+      return 140;
+
+    if (uiByte >= '0' && uiByte <= '9')
+      return 120;
+
+    // the lead and continuation bytes of one script repeat a lot in UTF-8 text
+    if (uiByte >= 0x80)
+      return 90;
+
+    return 50;
+  }
+} // namespace
+
+nsStringSearcher::nsStringSearcher()
+{
+  SetPattern(nsStringView());
+}
+
+nsStringSearcher::nsStringSearcher(nsStringView sPattern, bool bCaseSensitive)
+{
+  SetPattern(sPattern, bCaseSensitive);
+}
+
+void nsStringSearcher::SetPattern(nsStringView sPattern, bool bCaseSensitive)
+{
+  // like FindSubString(), only search for the part before a terminator
+  const void* pTerminator = sPattern.IsEmpty() ? nullptr : memchr(sPattern.GetStartPointer(), '\0', sPattern.GetElementCount());
+  if (pTerminator != nullptr)
+  {
+    sPattern = nsStringView(sPattern.GetStartPointer(), static_cast<const char*>(pTerminator));
+  }
+
+  m_sPattern = sPattern;
+  m_bCaseSensitive = bCaseSensitive;
+  m_uiRareOffset0 = 0;
+
+  const nsUInt8* pBytes = reinterpret_cast<const nsUInt8*>(m_sPattern.GetData());
+  const nsUInt32 uiLength = m_sPattern.GetElementCount();
+
+  for (nsUInt32 i = 1; i < uiLength; ++i)
+  {
+    if (GetByteFrequencyRank(pBytes[i]) < GetByteFrequencyRank(pBytes[m_uiRareOffset0]))
+      m_uiRareOffset0 = i;
+  }
+
+  // a second byte with the same value would not filter out any more candidates, it is only used when all bytes are the same
+  m_uiRareOffset1 = m_uiRareOffset0;
+  nsUInt32 uiBestRank = 0xFFFFFFFF;
+
+  for (nsUInt32 i = 0; i < uiLength; ++i)
+  {
+    if (pBytes[i] != pBytes[m_uiRareOffset0] && GetByteFrequencyRank(pBytes[i]) < uiBestRank)
+    {
+      uiBestRank = GetByteFrequencyRank(pBytes[i]);
+      m_uiRareOffset1 = i;
+    }
+  }
+}
+
+const char* nsStringSearcher::FindIn(nsStringView sText) const
+{
+  if (m_sPattern.IsEmpty() || sText.IsEmpty())
+    return nullptr;
+
+  const char* pText = sText.GetStartPointer();
+  const char* pTextEnd = sText.GetEndPointer();
+
+  if (const void* pTerminator = memchr(pText, '\0', sText.GetElementCount()))
+  {
+    pTextEnd = static_cast<const char*>(pTerminator);
+  }
+
+  if (m_bCaseSensitive)
+    return FindBytes(pText, pTextEnd);
+
+  const char* szPattern = m_sPattern.GetData();
+  return nsStringUtils::FindSubString_NoCase(pText, szPattern, pTextEnd, szPattern + m_sPattern.GetElementCount());
+}
+
+const char* nsStringSearcher::FindBytes(const char* pText, const char* pTextEnd) const
+{
+  const char* pPattern = m_sPattern.GetData();
+  const nsUInt32 uiLength = m_sPattern.GetElementCount();
+
+  if (pTextEnd - pText < static_cast<std::ptrdiff_t>(uiLength))
+    return nullptr;
+
+  const char* pLastStart = pTextEnd - uiLength;
+  const char cRare0 = pPattern[m_uiRareOffset0];
+  const char cRare1 = pPattern[m_uiRareOffset1];
+  const char* pCur = pText;
+
+#if NS_ENABLED(NS_STRING_SIMD)
+  nsUInt32 uiMismatches = 0;
+
+  // memchr is hard to beat while the rarest byte really is rare, otherwise filtering for both bytes at once is faster
+  while (pCur <= pLastStart && uiMismatches < 16)
+#else
+  while (pCur <= pLastStart)
+#endif
+  {
+    const void* pFound = memchr(pCur + m_uiRareOffset0, cRare0, static_cast<size_t>(pLastStart - pCur + 1));
+    if (pFound == nullptr)
+      return nullptr;
+
+    const char* pCandidate = static_cast<const char*>(pFound) - m_uiRareOffset0;
+    if (pCandidate[m_uiRareOffset1] == cRare1 && memcmp(pCandidate, pPattern, uiLength) == 0)
+      return pCandidate;
+
+    pCur = pCandidate + 1;
+
+#if NS_ENABLED(NS_STRING_SIMD)
+    ++uiMismatches;
+#endif
+  }
+
+#if NS_ENABLED(NS_STRING_SIMD)
+  using namespace nsStringSimd;
+
+  const Block rare0 = Splat(static_cast<nsUInt8>(cRare0));
+  const Block rare1 = Splat(static_cast<nsUInt8>(cRare1));
+
+  // the loaded blocks must not reach over the end of the text
+  for (; pLastStart - pCur >= static_cast<std::ptrdiff_t>(BlockSize - 1); pCur += BlockSize)
+  {
+    Mask candidates = GetMask(And(Equal(LoadBlock(pCur + m_uiRareOffset0), rare0), Equal(LoadBlock(pCur + m_uiRareOffset1), rare1)));
+
+    while (candidates != 0)
+    {
+      const char* pCandidate = pCur + MaskFirstByte(candidates);
+      if (memcmp(pCandidate, pPattern, uiLength) == 0)
+        return pCandidate;
+
+      candidates = MaskClearFirstByte(candidates);
+    }
+  }
+
+  for (; pCur <= pLastStart; ++pCur)
+  {
+    if (pCur[m_uiRareOffset0] == cRare0 && pCur[m_uiRareOffset1] == cRare1 && memcmp(pCur, pPattern, uiLength) == 0)
+      return pCur;
+  }
+#endif
+
+  return nullptr;
+}
@@ -0,0 +1,127 @@
+#pragma once
+
+/// \file
+/// Internal helpers for the vectorized code paths of nsStringUtils and nsUnicodeUtils. Only meant to be included from their
+/// implementation files.
+///
+/// All functions work on blocks of 16 bytes and wrap the few operations that the string algorithms need, so that those only
+/// have to be written once for SSE and NEON. Comparisons return 0xFF for every byte where they are true and 0x00 otherwise,
+/// GetMask() turns such a result into a bit mask, which can be inspected with the Mask... functions independent of how many
+/// bits the platform uses per byte.
+
+#include <Foundation/Math/Math.h>
+
+#if NS_SIMD_IMPLEMENTATION == NS_SIMD_IMPLEMENTATION_SSE && NS_SSE_LEVEL >= NS_SSE_41
+#  include <smmintrin.h>
+#  define NS_STRING_SIMD_SSE NS_ON
+#  define NS_STRING_SIMD_NEON NS_OFF
+#elif NS_ENABLED(NS_PLATFORM_ARCH_ARM) && NS_ENABLED(NS_PLATFORM_64BIT) && defined(__ARM_NEON)
+#  include <arm_neon.h>
+#  define NS_STRING_SIMD_SSE NS_OFF
+#  define NS_STRING_SIMD_NEON NS_ON
+#else
+#  define NS_STRING_SIMD_SSE NS_OFF
+#  define NS_STRING_SIMD_NEON NS_OFF
+#endif
+
+#if NS_ENABLED(NS_STRING_SIMD_SSE) || NS_ENABLED(NS_STRING_SIMD_NEON)
+#  define NS_STRING_SIMD NS_ON
+#else
+#  define NS_STRING_SIMD NS_OFF
+#endif
+
+#if NS_ENABLED(NS_STRING_SIMD)
+
+namespace nsStringSimd
+{
+  constexpr nsUInt32 BlockSize = 16;
+
+#  if NS_ENABLED(NS_STRING_SIMD_SSE)
+
+  using Block = __m128i;
+  using Mask = nsUInt32;
+  constexpr nsUInt32 MaskBitsPerByte = 1;
+
+  NS_ALWAYS_INLINE Block LoadBlock(const void* p) { return _mm_loadu_si128(static_cast<const __m128i*>(p)); }
+  NS_ALWAYS_INLINE Block Splat(nsUInt8 uiValue) { return _mm_set1_epi8(static_cast<char>(uiValue)); }
+  NS_ALWAYS_INLINE Block And(Block a, Block b) { return _mm_and_si128(a, b); }
+  NS_ALWAYS_INLINE Block AndNot(Block a, Block b) { return _mm_andnot_si128(b, a); }
+  NS_ALWAYS_INLINE Block Or(Block a, Block b) { return _mm_or_si128(a, b); }
+  NS_ALWAYS_INLINE Block Xor(Block a, Block b) { return _mm_xor_si128(a, b); }
+  NS_ALWAYS_INLINE Block Sub(Block a, Block b) { return _mm_sub_epi8(a, b); }
+  NS_ALWAYS_INLINE Block SubSaturate(Block a, Block b) { return _mm_subs_epu8(a, b); }
+  NS_ALWAYS_INLINE Block Equal(Block a, Block b) { return _mm_cmpeq_epi8(a, b); }
+  NS_ALWAYS_INLINE Block GreaterSigned(Block a, Block b) { return _mm_cmpgt_epi8(a, b); }
+  NS_ALWAYS_INLINE Block HighNibbles(Block a) { return _mm_and_si128(_mm_srli_epi16(a, 4), Splat(0x0F)); }
+  NS_ALWAYS_INLINE Block Lookup(Block table, Block indices) { return _mm_shuffle_epi8(table, indices); }
+  NS_ALWAYS_INLINE bool IsAscii(Block a) { return _mm_movemask_epi8(a) == 0; }
+  NS_ALWAYS_INLINE bool IsZero(Block a) { return _mm_testz_si128(a, a) != 0; }
+  NS_ALWAYS_INLINE Mask GetMask(Block comparison) { return static_cast<Mask>(_mm_movemask_epi8(comparison)); }
+
+  /// \brief Returns the input shifted by N bytes, with the last N bytes of the previous input shifted in.
+  template <int N>
+  NS_ALWAYS_INLINE Block Prev(Block input, Block prevInput)
+  {
+    return _mm_alignr_epi8(input, prevInput, 16 - N);
+  }
+
+#  else
+
+  using Block = uint8x16_t;
+  using Mask = nsUInt64;
+  constexpr nsUInt32 MaskBitsPerByte = 4;
+
+  NS_ALWAYS_INLINE Block LoadBlock(const void* p) { return vld1q_u8(static_cast<const nsUInt8*>(p)); }
+  NS_ALWAYS_INLINE Block Splat(nsUInt8 uiValue) { return vdupq_n_u8(uiValue); }
+  NS_ALWAYS_INLINE Block And(Block a, Block b) { return vandq_u8(a, b); }
+  NS_ALWAYS_INLINE Block AndNot(Block a, Block b) { return vbicq_u8(a, b); }
+  NS_ALWAYS_INLINE Block Or(Block a, Block b) { return vorrq_u8(a, b); }
+  NS_ALWAYS_INLINE Block Xor(Block a, Block b) { return veorq_u8(a, b); }
+  NS_ALWAYS_INLINE Block Sub(Block a, Block b) { return vsubq_u8(a, b); }
+  NS_ALWAYS_INLINE Block SubSaturate(Block a, Block b) { return vqsubq_u8(a, b); }
+  NS_ALWAYS_INLINE Block Equal(Block a, Block b) { return vceqq_u8(a, b); }
+  NS_ALWAYS_INLINE Block GreaterSigned(Block a, Block b) { return vcgtq_s8(vreinterpretq_s8_u8(a), vreinterpretq_s8_u8(b)); }
+  NS_ALWAYS_INLINE Block HighNibbles(Block a) { return vshrq_n_u8(a, 4); }
+  NS_ALWAYS_INLINE Block Lookup(Block table, Block indices) { return vqtbl1q_u8(table, indices); }
+  NS_ALWAYS_INLINE bool IsAscii(Block a) { return vmaxvq_u8(a) < 0x80; }
+  NS_ALWAYS_INLINE bool IsZero(Block a) { return vmaxvq_u8(a) == 0; }
+
+  NS_ALWAYS_INLINE Mask GetMask(Block comparison)
+  {
+    // narrows every byte to 4 bits, NEON has no direct equivalent to movemask
+    const uint8x8_t nibbles = vshrn_n_u16(vreinterpretq_u16_u8(comparison), 4);
+    return vget_lane_u64(vreinterpret_u64_u8(nibbles), 0);
+  }
+
+  /// \brief Returns the input shifted by N bytes, with the last N bytes of the previous input shifted in.
+  template <int N>
+  NS_ALWAYS_INLINE Block Prev(Block input, Block prevInput)
+  {
+    return vextq_u8(prevInput, input, 16 - N);
+  }
+
+#  endif
+
+  constexpr Mask FullMask = static_cast<Mask>(~Mask(0) >> (sizeof(Mask) * 8 - BlockSize * MaskBitsPerByte));
+
+  /// \brief Returns the index of the first byte that is set in the mask. The mask must not be zero.
+  NS_ALWAYS_INLINE nsUInt32 MaskFirstByte(Mask mask) { return nsMath::FirstBitLow(mask) / MaskBitsPerByte; }
+
+  /// \brief Removes the first byte from the mask, to iterate over all bytes that are set.
+  NS_ALWAYS_INLINE Mask MaskClearFirstByte(Mask mask)
+  {
+    constexpr Mask byteBits = (Mask(1) << MaskBitsPerByte) - 1;
+    return mask & ~(byteBits << (nsMath::FirstBitLow(mask) & ~(MaskBitsPerByte - 1)));
+  }
+
+  NS_ALWAYS_INLINE nsUInt32 MaskCountBytes(Mask mask) { return nsMath::CountBits(mask) / MaskBitsPerByte; }
+
+  /// \brief Converts ASCII letters to upper case and leaves all other bytes unchanged.
+  NS_ALWAYS_INLINE Block ToUpperAscii(Block a)
+  {
+    const Block isLower = And(GreaterSigned(a, Splat('a' - 1)), GreaterSigned(Splat('z' + 1), a));
+    return Sub(a, And(isLower, Splat('a' - 'A')));
+  }
+} // namespace nsStringSimd
+
+#endif
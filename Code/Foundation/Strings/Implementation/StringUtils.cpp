@@ -1,5 +1,6 @@
 #include <Foundation/FoundationPCH.h>
 
+#include <Foundation/Strings/Implementation/StringSimd.h>
 #include <Foundation/Strings/StringView.h>
 #include <Foundation/Utilities/ConversionUtils.h>
 
@@ -216,12 +217,228 @@ nsUInt32 nsStringUtils::ToLowerString(char* pString, const char* pStringEnd)
 
 #define ToSignedInt(c) ((nsInt32)((unsigned char)c))
 
+// The comparison and search functions first handle as many bytes as possible in blocks and only fall back to decoding
+// Utf8 characters when they hit a difference, a terminator or, for the case insensitive versions, a non-ASCII character.
+// Blocks are only read where the end pointers guarantee that the memory belongs to the string.
+namespace
+{
+#if NS_ENABLED(NS_STRING_SIMD)
+  using namespace nsStringSimd;
+
+  constexpr nsUInt32 CompareBlockSize = BlockSize;
+#else
+  // without SIMD, 8 bytes are compared at once in a 64 bit register (this assumes little endian)
+  constexpr nsUInt32 CompareBlockSize = 8;
+
+  constexpr nsUInt64 OneBits64 = 0x0101010101010101ull;
+  constexpr nsUInt64 LowBits64 = 0x7F7F7F7F7F7F7F7Full;
+  constexpr nsUInt64 HighBits64 = 0x8080808080808080ull;
+
+  NS_ALWAYS_INLINE nsUInt64 LoadUInt64(const char* p)
+  {
+    nsUInt64 uiValue;
+    memcpy(&uiValue, p, sizeof(uiValue));
+    return uiValue;
+  }
+
+  // returns the high bit of every byte that is not zero
+  NS_ALWAYS_INLINE nsUInt64 GetNonZeroBytes(nsUInt64 uiValue)
+  {
+    return (((uiValue & LowBits64) + LowBits64) | uiValue) & HighBits64;
+  }
+
+  // returns the high bit of every byte that is zero, bytes after the first zero byte may be reported wrongly
+  NS_ALWAYS_INLINE nsUInt64 GetFirstZeroByte(nsUInt64 uiValue)
+  {
+    return (uiValue - OneBits64) & ~uiValue & HighBits64;
+  }
+
+  // converts ASCII letters to upper case, carries from non-ASCII bytes may change the bytes after them
+  NS_ALWAYS_INLINE nsUInt64 ToUpperAscii(nsUInt64 uiValue)
+  {
+    const nsUInt64 uiIsLower = (uiValue + 0x1F1F1F1F1F1F1F1Full) & ~(uiValue + 0x0505050505050505ull) & HighBits64;
+    return uiValue - (uiIsLower >> 2);
+  }
+
+  NS_ALWAYS_INLINE nsUInt32 GetFirstByte(nsUInt64 uiHighBits)
+  {
+    return uiHighBits == 0 ? CompareBlockSize : nsMath::FirstBitLow(uiHighBits) / 8;
+  }
+#endif
+
+  // returns how many bytes at the start of both strings are equal and not zero, up to CompareBlockSize
+  NS_ALWAYS_INLINE nsUInt32 GetEqualPrefixLength(const char* pString1, const char* pString2)
+  {
+#if NS_ENABLED(NS_STRING_SIMD)
+    const Block a = LoadBlock(pString1);
+    const Block b = LoadBlock(pString2);
+    const Mask equal = GetMask(AndNot(Equal(a, b), Equal(a, Splat(0))));
+    return equal == FullMask ? BlockSize : MaskFirstByte(~equal);
+#else
+    const nsUInt64 a = LoadUInt64(pString1);
+    const nsUInt64 b = LoadUInt64(pString2);
+    return GetFirstByte(GetNonZeroBytes(a ^ b) | GetFirstZeroByte(a));
+#endif
+  }
+
+  // returns how many bytes at the start of both strings are ASCII, not zero and equal when ignoring the case, up to CompareBlockSize
+  NS_ALWAYS_INLINE nsUInt32 GetEqualAsciiPrefixLength_NoCase(const char* pString1, const char* pString2)
+  {
+#if NS_ENABLED(NS_STRING_SIMD)
+    const Block a = LoadBlock(pString1);
+    const Block b = LoadBlock(pString2);
+
+    // a non-ASCII byte in b can't be equal to an upper case ASCII byte of a
+    const Mask equal = GetMask(And(Equal(ToUpperAscii(a), ToUpperAscii(b)), GreaterSigned(a, Splat(0))));
+    return equal == FullMask ? BlockSize : MaskFirstByte(~equal);
+#else
+    const nsUInt64 a = LoadUInt64(pString1);
+    const nsUInt64 b = LoadUInt64(pString2);
+    const nsUInt64 uiNonAscii = (a | b) & HighBits64;
+    return GetFirstByte(uiNonAscii | GetNonZeroBytes(ToUpperAscii(a) ^ ToUpperAscii(b)) | GetFirstZeroByte(a));
+#endif
+  }
+
+  NS_ALWAYS_INLINE bool CanReadBlocks(const char* pString1End, const char* pString2End)
+  {
+    // without an end pointer only the terminator tells where the string ends, so nothing behind it may be read
+    return pString1End != nsUnicodeUtils::GetMaxStringEnd<char>() && pString2End != nsUnicodeUtils::GetMaxStringEnd<char>();
+  }
+
+  NS_ALWAYS_INLINE bool HasBlock(const char* pString1, const char* pString1End, const char* pString2, const char* pString2End)
+  {
+    return (pString1End - pString1 >= static_cast<std::ptrdiff_t>(CompareBlockSize)) && (pString2End - pString2 >= static_cast<std::ptrdiff_t>(CompareBlockSize));
+  }
+
+  NS_ALWAYS_INLINE char ToUpperAsciiChar(char c)
+  {
+    return (c >= 'a' && c <= 'z') ? static_cast<char>(c - ('a' - 'A')) : c;
+  }
+
+  // returns the position of the terminator or the end pointer, whichever comes first
+  const char* FindStringEnd(const char* szString, const char* pStringEnd)
+  {
+    if (pStringEnd == nsUnicodeUtils::GetMaxStringEnd<char>())
+      return szString + strlen(szString);
+
+    if (pStringEnd <= szString)
+      return szString;
+
+    const void* pTerminator = memchr(szString, '\0', static_cast<size_t>(pStringEnd - szString));
+    return pTerminator != nullptr ? static_cast<const char*>(pTerminator) : pStringEnd;
+  }
+
+#if NS_ENABLED(NS_STRING_SIMD)
+  // finds the first occurrence of the byte sequence, by filtering blocks for the first and last byte of it and only comparing
+  // the rest at those positions
+  const char* FindBytesInBlocks(const char* pCur, const char* pTextEnd, const char* pSearch, nsUInt32 uiSearchLength)
+  {
+    const char* pLastStart = pTextEnd - uiSearchLength;
+    const Block first = Splat(static_cast<nsUInt8>(pSearch[0]));
+    const Block last = Splat(static_cast<nsUInt8>(pSearch[uiSearchLength - 1]));
+
+    // the block with the last bytes must not reach over the end of the text
+    for (; pLastStart - pCur >= static_cast<std::ptrdiff_t>(BlockSize - 1); pCur += BlockSize)
+    {
+      Mask candidates = GetMask(And(Equal(LoadBlock(pCur), first), Equal(LoadBlock(pCur + uiSearchLength - 1), last)));
+
+      while (candidates != 0)
+      {
+        const char* pCandidate = pCur + MaskFirstByte(candidates);
+        if (memcmp(pCandidate + 1, pSearch + 1, uiSearchLength - 2) == 0)
+          return pCandidate;
+
+        candidates = MaskClearFirstByte(candidates);
+      }
+    }
+
+    for (; pCur <= pLastStart; ++pCur)
+    {
+      if (memcmp(pCur, pSearch, uiSearchLength) == 0)
+        return pCur;
+    }
+
+    return nullptr;
+  }
+#endif
+
+  // finds the first occurrence of the byte sequence, by jumping to the occurrences of its first byte and comparing the rest there
+  const char* FindBytes(const char* pText, const char* pTextEnd, const char* pSearch, nsUInt32 uiSearchLength)
+  {
+    if (pTextEnd - pText < static_cast<std::ptrdiff_t>(uiSearchLength))
+      return nullptr;
+
+    if (uiSearchLength == 1)
+      return static_cast<const char*>(memchr(pText, pSearch[0], static_cast<size_t>(pTextEnd - pText)));
+
+    const char* pLastStart = pTextEnd - uiSearchLength;
+    const char* pCur = pText;
+
+#if NS_ENABLED(NS_STRING_SIMD)
+    nsUInt32 uiMismatches = 0;
+#endif
+
+    while (pCur <= pLastStart)
+    {
+#if NS_ENABLED(NS_STRING_SIMD)
+      // memchr is hard to beat when the first byte is rare, but when it is frequent, most of the comparisons fail and filtering
+      // for two bytes at once is faster
+      if (uiMismatches >= 16)
+        return FindBytesInBlocks(pCur, pTextEnd, pSearch, uiSearchLength);
+#endif
+
+      pCur = static_cast<const char*>(memchr(pCur, pSearch[0], static_cast<size_t>(pLastStart - pCur + 1)));
+      if (pCur == nullptr)
+        return nullptr;
+
+      if (memcmp(pCur + 1, pSearch + 1, uiSearchLength - 1) == 0)
+        return pCur;
+
+      ++pCur;
+
+#if NS_ENABLED(NS_STRING_SIMD)
+      ++uiMismatches;
+#endif
+    }
+
+    return nullptr;
+  }
+
+  const char* FindSubStringUnicode_NoCase(const char* szSource, const char* szStringToFind, const char* pSourceEnd, const char* szStringToFindEnd)
+  {
+    const char* pCurPos = &szSource[0];
+
+    while ((pCurPos < pSourceEnd) && (*pCurPos != '\0'))
+    {
+      if (nsStringUtils::StartsWith_NoCase(pCurPos, szStringToFind, pSourceEnd, szStringToFindEnd))
+        return pCurPos;
+
+      nsUnicodeUtils::MoveToNextUtf8(pCurPos, pSourceEnd).AssertSuccess();
+    }
+
+    return nullptr;
+  }
+} // namespace
+
 nsInt32 nsStringUtils::Compare(const char* pString1, const char* pString2, const char* pString1End, const char* pString2End)
 {
   NS_STRINGCOMPARE_HANDLE_NULL_PTRS(pString1, pString2, 0, -1, 1, pString1End, pString2End);
 
+  const bool bCanReadBlocks = CanReadBlocks(pString1End, pString2End);
+
   while ((pString1 < pString1End) && (pString2 < pString2End) && (*pString1 != '\0') && (*pString2 != '\0'))
   {
+    if (bCanReadBlocks && HasBlock(pString1, pString1End, pString2, pString2End))
+    {
+      const nsUInt32 uiEqualBytes = GetEqualPrefixLength(pString1, pString2);
+      pString1 += uiEqualBytes;
+      pString2 += uiEqualBytes;
+
+      // the loop condition handles the terminators
+      if (uiEqualBytes == CompareBlockSize || *pString1 == '\0' || *pString2 == '\0')
+        continue;
+    }
+
     if (*pString1 != *pString2)
       return ToSignedInt(*pString1) - ToSignedInt(*pString2);
 
@@ -253,8 +470,22 @@ nsInt32 nsStringUtils::CompareN(
 
   NS_STRINGCOMPARE_HANDLE_NULL_PTRS(pString1, pString2, 0, -1, 1, pString1End, pString2End);
 
+  const bool bCanReadBlocks = CanReadBlocks(pString1End, pString2End);
+
   while ((uiCharsToCompare > 0) && (pString1 < pString1End) && (pString2 < pString2End) && (*pString1 != '\0') && (*pString2 != '\0'))
   {
+    // a block never contains more characters than bytes, so it can't overshoot
+    if (bCanReadBlocks && uiCharsToCompare >= CompareBlockSize && HasBlock(pString1, pString1End, pString2, pString2End))
+    {
+      const nsUInt32 uiEqualBytes = GetEqualPrefixLength(pString1, pString2);
+      uiCharsToCompare -= nsUnicodeUtils::CountUtf8Characters(pString1, pString1 + uiEqualBytes);
+      pString1 += uiEqualBytes;
+      pString2 += uiEqualBytes;
+
+      if (uiEqualBytes == CompareBlockSize || *pString1 == '\0' || *pString2 == '\0')
+        continue;
+    }
+
     if (*pString1 != *pString2)
       return ToSignedInt(*pString1) - ToSignedInt(*pString2);
 
@@ -288,8 +519,21 @@ nsInt32 nsStringUtils::Compare_NoCase(const char* pString1, const char* pString2
 {
   NS_STRINGCOMPARE_HANDLE_NULL_PTRS(pString1, pString2, 0, -1, 1, pString1End, pString2End);
 
+  const bool bCanReadBlocks = CanReadBlocks(pString1End, pString2End);
+
   while ((pString1 < pString1End) && (pString2 < pString2End) && (*pString1 != '\0') && (*pString2 != '\0'))
   {
+    if (bCanReadBlocks && HasBlock(pString1, pString1End, pString2, pString2End))
+    {
+      const nsUInt32 uiEqualBytes = GetEqualAsciiPrefixLength_NoCase(pString1, pString2);
+      pString1 += uiEqualBytes;
+      pString2 += uiEqualBytes;
+
+      // a difference or non-ASCII characters are handled by the code below
+      if (uiEqualBytes == CompareBlockSize || *pString1 == '\0' || *pString2 == '\0')
+        continue;
+    }
+
     // utf8::next will already advance the iterators
     const nsUInt32 uiChar1 = nsUnicodeUtils::DecodeUtf8ToUtf32(pString1);
     const nsUInt32 uiChar2 = nsUnicodeUtils::DecodeUtf8ToUtf32(pString2);
@@ -326,8 +570,22 @@ nsInt32 nsStringUtils::CompareN_NoCase(
 
   NS_STRINGCOMPARE_HANDLE_NULL_PTRS(pString1, pString2, 0, -1, 1, pString1End, pString2End);
 
+  const bool bCanReadBlocks = CanReadBlocks(pString1End, pString2End);
+
   while ((uiCharsToCompare > 0) && (pString1 < pString1End) && (pString2 < pString2End) && (*pString1 != '\0') && (*pString2 != '\0'))
   {
+    if (bCanReadBlocks && uiCharsToCompare >= CompareBlockSize && HasBlock(pString1, pString1End, pString2, pString2End))
+    {
+      // all equal bytes are ASCII characters
+      const nsUInt32 uiEqualBytes = GetEqualAsciiPrefixLength_NoCase(pString1, pString2);
+      uiCharsToCompare -= uiEqualBytes;
+      pString1 += uiEqualBytes;
+      pString2 += uiEqualBytes;
+
+      if (uiEqualBytes == CompareBlockSize || *pString1 == '\0' || *pString2 == '\0')
+        continue;
+    }
+
     // utf8::next will already advance the iterators
     const nsUInt32 uiChar1 = nsUnicodeUtils::DecodeUtf8ToUtf32(pString1);
     const nsUInt32 uiChar2 = nsUnicodeUtils::DecodeUtf8ToUtf32(pString2);
@@ -554,17 +812,15 @@ const char* nsStringUtils::FindSubString(const char* szSource, const char* szStr
   if ((IsNullOrEmpty(szSource)) || (IsNullOrEmpty(szStringToFind)))
     return nullptr;
 
-  const char* pCurPos = &szSource[0];
+  pSourceEnd = FindStringEnd(szSource, pSourceEnd);
+  szStringToFindEnd = FindStringEnd(szStringToFind, szStringToFindEnd);
 
-  while ((pCurPos < pSourceEnd) && (*pCurPos != '\0'))
-  {
-    if (nsStringUtils::StartsWith(pCurPos, szStringToFind, pSourceEnd, szStringToFindEnd))
-      return pCurPos;
-
-    nsUnicodeUtils::MoveToNextUtf8(pCurPos, pSourceEnd).AssertSuccess();
-  }
+  // an empty search string is found at the start
+  if (szStringToFind == szStringToFindEnd)
+    return szSource < pSourceEnd ? szSource : nullptr;
 
-  return nullptr;
+  // a match of a valid Utf8 string always starts at a character boundary, so the bytes can be searched directly
+  return FindBytes(szSource, pSourceEnd, szStringToFind, static_cast<nsUInt32>(szStringToFindEnd - szStringToFind));
 }
 
 const char* nsStringUtils::FindSubString_NoCase(const char* szSource, const char* szStringToFind, const char* pSourceEnd, const char* szStringToFindEnd)
@@ -573,14 +829,57 @@ const char* nsStringUtils::FindSubString_NoCase(const char* szSource, const char
   if ((IsNullOrEmpty(szSource)) || (IsNullOrEmpty(szStringToFind)))
     return nullptr;
 
-  const char* pCurPos = &szSource[0];
+  pSourceEnd = FindStringEnd(szSource, pSourceEnd);
+  szStringToFindEnd = FindStringEnd(szStringToFind, szStringToFindEnd);
 
-  while ((pCurPos < pSourceEnd) && (*pCurPos != '\0'))
+  if (szStringToFind == szStringToFindEnd)
+    return szSource < pSourceEnd ? szSource : nullptr;
+
+  // a non-ASCII first character may be equal to an ASCII character when ignoring the case
+  if (static_cast<nsUInt8>(szStringToFind[0]) >= 0x80)
+    return FindSubStringUnicode_NoCase(szSource, szStringToFind, pSourceEnd, szStringToFindEnd);
+
+  // Only positions where the first character matches, or where a non-ASCII character starts, need a full comparison.
+  // The latter are rare in most texts, but they may be equal to an ASCII character when ignoring the case.
+  const char cFirstUpper = ToUpperAsciiChar(szStringToFind[0]);
+  const char* pCur = szSource;
+
+#if NS_ENABLED(NS_STRING_SIMD)
+  const Block first = Splat(static_cast<nsUInt8>(cFirstUpper));
+
+  // The byte after a candidate must match the second character as well, or be non-ASCII. This is only known for an ASCII
+  // second character, otherwise the second check lets everything pass.
+  const bool bCheckSecond = szStringToFindEnd - szStringToFind >= 2 && static_cast<nsUInt8>(szStringToFind[1]) < 0x80;
+  const Block second = Splat(static_cast<nsUInt8>(ToUpperAsciiChar(bCheckSecond ? szStringToFind[1] : 0)));
+  const Block ignoreSecond = Splat(bCheckSecond ? 0x00 : 0xFF);
+
+  for (; pSourceEnd - pCur >= static_cast<std::ptrdiff_t>(BlockSize + 1); pCur += BlockSize)
   {
-    if (nsStringUtils::StartsWith_NoCase(pCurPos, szStringToFind, pSourceEnd, szStringToFindEnd))
-      return pCurPos;
+    const Block text = LoadBlock(pCur);
+    const Block next = LoadBlock(pCur + 1);
+    const Block isLeadByte = And(GreaterSigned(text, Splat(0xBF)), GreaterSigned(Splat(0), text));
+    const Block secondMatches = Or(Or(Equal(ToUpperAscii(next), second), GreaterSigned(Splat(0), next)), ignoreSecond);
+
+    Mask candidates = GetMask(And(Or(Equal(ToUpperAscii(text), first), isLeadByte), secondMatches));
+
+    while (candidates != 0)
+    {
+      const char* pCandidate = pCur + MaskFirstByte(candidates);
+      if (StartsWith_NoCase(pCandidate, szStringToFind, pSourceEnd, szStringToFindEnd))
+        return pCandidate;
 
-    nsUnicodeUtils::MoveToNextUtf8(pCurPos, pSourceEnd).AssertSuccess();
+      candidates = MaskClearFirstByte(candidates);
+    }
+  }
+#endif
+
+  for (; pCur < pSourceEnd; ++pCur)
+  {
+    if (ToUpperAsciiChar(*pCur) == cFirstUpper || static_cast<nsUInt8>(*pCur) >= 0xC0)
+    {
+      if (StartsWith_NoCase(pCur, szStringToFind, pSourceEnd, szStringToFindEnd))
+        return pCur;
+    }
   }
 
   return nullptr;
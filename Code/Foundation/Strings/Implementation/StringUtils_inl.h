@@ -80,20 +80,9 @@ nsUInt32 nsStringUtils::GetStringElementCount(const T* pString, const T* pString
 
 inline nsUInt32 nsStringUtils::GetCharacterCount(const char* szUtf8, const char* pStringEnd)
 {
-  if (IsNullOrEmpty(szUtf8))
-    return 0;
-
   nsUInt32 uiCharacters = 0;
-
-  while ((*szUtf8 != '\0') && (szUtf8 < pStringEnd))
-  {
-    // skip all the Utf8 continuation bytes
-    if (!nsUnicodeUtils::IsUtf8ContinuationByte(*szUtf8))
-      ++uiCharacters;
-
-    ++szUtf8;
-  }
-
+  nsUInt32 uiElements = 0;
+  GetCharacterAndElementCount(szUtf8, uiCharacters, uiElements, pStringEnd);
   return uiCharacters;
 }
 
@@ -102,24 +91,21 @@ inline void nsStringUtils::GetCharacterAndElementCount(const char* szUtf8, nsUIn
   ref_uiCharacterCount = 0;
   ref_uiElementCount = 0;
 
-  if (IsNullOrEmpty(szUtf8))
+  if (IsNullOrEmpty(szUtf8) || szUtf8 >= pStringEnd)
     return;
 
-  while (szUtf8 < pStringEnd)
+  // find the end first, so that the characters can be counted in blocks
+  if (pStringEnd == nsUnicodeUtils::GetMaxStringEnd<char>())
   {
-    char uiByte = *szUtf8;
-    if (uiByte == '\0')
-    {
-      break;
-    }
-
-    // skip all the Utf8 continuation bytes
-    if (!nsUnicodeUtils::IsUtf8ContinuationByte(uiByte))
-      ++ref_uiCharacterCount;
-
-    ++szUtf8;
-    ++ref_uiElementCount;
+    pStringEnd = szUtf8 + strlen(szUtf8);
   }
+  else if (const void* pTerminator = memchr(szUtf8, '\0', static_cast<size_t>(pStringEnd - szUtf8)))
+  {
+    pStringEnd = static_cast<const char*>(pTerminator);
+  }
+
+  ref_uiElementCount = static_cast<nsUInt32>(pStringEnd - szUtf8);
+  ref_uiCharacterCount = nsUnicodeUtils::CountUtf8Characters(szUtf8, pStringEnd);
 }
 
 NS_ALWAYS_INLINE bool nsStringUtils::IsEqual(const char* pString1, const char* pString2, const char* pString1End, const char* pString2End)
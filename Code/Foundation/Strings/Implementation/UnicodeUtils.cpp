@@ -0,0 +1,600 @@
+#include <Foundation/FoundationPCH.h>
+
+#include <Foundation/Strings/Implementation/StringSimd.h>
+
+namespace
+{
+  constexpr nsUInt64 HighBits64 = 0x8080808080808080ull;
+
+  NS_ALWAYS_INLINE nsUInt64 LoadUInt64(const char* p)
+  {
+    nsUInt64 uiValue;
+    memcpy(&uiValue, p, sizeof(uiValue));
+    return uiValue;
+  }
+
+  // the number of bytes that DecodeUtf8ToUtf32() consumes for the given non-ASCII byte, invalid bytes are skipped one at a time
+  NS_ALWAYS_INLINE nsUInt32 GetSequenceLength(nsUInt8 uiLeadByte)
+  {
+    if (uiLeadByte < 0xC0 || uiLeadByte >= 0xF8)
+      return 1;
+
+    return uiLeadByte < 0xE0 ? 2 : (uiLeadByte < 0xF0 ? 3 : 4);
+  }
+
+#if NS_ENABLED(NS_STRING_SIMD)
+
+  using namespace nsStringSimd;
+
+  NS_ALWAYS_INLINE nsUInt32 CountLeadBytes(Block a)
+  {
+    // continuation bytes are the only ones that are <= 0xBF as signed bytes
+    return MaskCountBytes(GetMask(GreaterSigned(a, Splat(0xBF))));
+  }
+
+  NS_ALWAYS_INLINE nsUInt32 GetFirstNonAscii(Block a)
+  {
+    return MaskFirstByte(GetMask(GreaterSigned(Splat(0), a)));
+  }
+
+#  if NS_ENABLED(NS_STRING_SIMD_SSE)
+
+  template <typename Char16>
+  NS_ALWAYS_INLINE void StoreAsUtf16(Block a, Char16* pOutput)
+  {
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(pOutput), _mm_unpacklo_epi8(a, _mm_setzero_si128()));
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(pOutput + 8), _mm_unpackhi_epi8(a, _mm_setzero_si128()));
+  }
+
+  template <typename Char32>
+  NS_ALWAYS_INLINE void StoreAsUtf32(Block a, Char32* pOutput)
+  {
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(pOutput), _mm_cvtepu8_epi32(a));
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(pOutput + 4), _mm_cvtepu8_epi32(_mm_srli_si128(a, 4)));
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(pOutput + 8), _mm_cvtepu8_epi32(_mm_srli_si128(a, 8)));
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(pOutput + 12), _mm_cvtepu8_epi32(_mm_srli_si128(a, 12)));
+  }
+
+  // converts 8 Utf16 elements, if they are all ASCII
+  template <typename Char16>
+  NS_ALWAYS_INLINE bool NarrowAsciiUtf16(const Char16* pInput, char* pOutput)
+  {
+    const Block a = LoadBlock(pInput);
+    if (!_mm_testz_si128(a, _mm_set1_epi16(static_cast<short>(0xFF80))))
+      return false;
+
+    _mm_storel_epi64(reinterpret_cast<__m128i*>(pOutput), _mm_packus_epi16(a, a));
+    return true;
+  }
+
+  // converts 4 Utf32 elements, if they are all ASCII
+  template <typename Char32>
+  NS_ALWAYS_INLINE bool NarrowAsciiUtf32(const Char32* pInput, char* pOutput)
+  {
+    const Block a = LoadBlock(pInput);
+    if (!_mm_testz_si128(a, _mm_set1_epi32(static_cast<int>(0xFFFFFF80))))
+      return false;
+
+    const Block a16 = _mm_packus_epi32(a, a);
+    const nsInt32 iBytes = _mm_cvtsi128_si32(_mm_packus_epi16(a16, a16));
+    memcpy(pOutput, &iBytes, 4);
+    return true;
+  }
+
+#  else
+
+  template <typename Char16>
+  NS_ALWAYS_INLINE void StoreAsUtf16(Block a, Char16* pOutput)
+  {
+    vst1q_u16(reinterpret_cast<nsUInt16*>(pOutput), vmovl_u8(vget_low_u8(a)));
+    vst1q_u16(reinterpret_cast<nsUInt16*>(pOutput + 8), vmovl_u8(vget_high_u8(a)));
+  }
+
+  template <typename Char32>
+  NS_ALWAYS_INLINE void StoreAsUtf32(Block a, Char32* pOutput)
+  {
+    const uint16x8_t low = vmovl_u8(vget_low_u8(a));
+    const uint16x8_t high = vmovl_u8(vget_high_u8(a));
+    vst1q_u32(reinterpret_cast<nsUInt32*>(pOutput), vmovl_u16(vget_low_u16(low)));
+    vst1q_u32(reinterpret_cast<nsUInt32*>(pOutput + 4), vmovl_u16(vget_high_u16(low)));
+    vst1q_u32(reinterpret_cast<nsUInt32*>(pOutput + 8), vmovl_u16(vget_low_u16(high)));
+    vst1q_u32(reinterpret_cast<nsUInt32*>(pOutput + 12), vmovl_u16(vget_high_u16(high)));
+  }
+
+  // converts 8 Utf16 elements, if they are all ASCII
+  template <typename Char16>
+  NS_ALWAYS_INLINE bool NarrowAsciiUtf16(const Char16* pInput, char* pOutput)
+  {
+    const uint16x8_t a = vld1q_u16(reinterpret_cast<const nsUInt16*>(pInput));
+    if (vmaxvq_u16(a) >= 0x80)
+      return false;
+
+    vst1_u8(reinterpret_cast<nsUInt8*>(pOutput), vmovn_u16(a));
+    return true;
+  }
+
+  // converts 4 Utf32 elements, if they are all ASCII
+  template <typename Char32>
+  NS_ALWAYS_INLINE bool NarrowAsciiUtf32(const Char32* pInput, char* pOutput)
+  {
+    const uint32x4_t a = vld1q_u32(reinterpret_cast<const nsUInt32*>(pInput));
+    if (vmaxvq_u32(a) >= 0x80)
+      return false;
+
+    const uint16x4_t a16 = vmovn_u32(a);
+    const nsUInt32 uiBytes = vget_lane_u32(vreinterpret_u32_u8(vmovn_u16(vcombine_u16(a16, a16))), 0);
+    memcpy(pOutput, &uiBytes, 4);
+    return true;
+  }
+
+#  endif
+
+  // Validates 16 bytes at a time with the lookup algorithm from "Validating UTF-8 In Less Than One Instruction Per Byte"
+  // (Keiser, Lemire). Three table lookups on the high and low nibble of the previous byte and the high nibble of the current byte
+  // classify all errors that can be detected from two consecutive bytes. Missing or superfluous continuation bytes of three and
+  // four byte sequences are found by comparing against the lead bytes two and three positions earlier.
+  class nsUtf8Validator
+  {
+  public:
+    void CheckBlock(Block input)
+    {
+      if (IsAscii(input))
+      {
+        // a sequence that was started in the previous block did not get finished
+        m_Error = Or(m_Error, m_PrevIncomplete);
+        m_PrevIncomplete = Splat(0);
+      }
+      else
+      {
+        const Block prev1 = Prev<1>(input, m_PrevInput);
+        const Block specialCases = CheckSpecialCases(input, prev1);
+        m_Error = Or(m_Error, CheckMultiByteLengths(input, m_PrevInput, specialCases));
+        m_PrevIncomplete = IsIncomplete(input);
+      }
+
+      m_PrevInput = input;
+    }
+
+    bool IsValid() const { return IsZero(Or(m_Error, m_PrevIncomplete)); }
+
+  private:
+    enum : nsUInt8
+    {
+      TOO_SHORT = 1 << 0,      // 11______ 0_______ or 11______ 11______
+      TOO_LONG = 1 << 1,       // 0_______ 10______
+      OVERLONG_3 = 1 << 2,     // 11100000 100_____
+      TOO_LARGE = 1 << 3,      // 11110100 1001____ or 11110100 101_____ or 11110101+ 10______
+      SURROGATE = 1 << 4,      // 11101101 101_____
+      OVERLONG_2 = 1 << 5,     // 1100000_ 10______
+      TOO_LARGE_1000 = 1 << 6, // 11110101+ 1000____
+      OVERLONG_4 = 1 << 6,     // 11110000 1000____
+      TWO_CONTS = 1 << 7,      // 10______ 10______
+      CARRY = TOO_SHORT | TOO_LONG | TWO_CONTS,
+    };
+
+    static Block CheckSpecialCases(Block input, Block prev1)
+    {
+      alignas(16) static constexpr nsUInt8 s_Byte1High[16] = {
+        // 0_______ ________
+        TOO_LONG, TOO_LONG, TOO_LONG, TOO_LONG, TOO_LONG, TOO_LONG, TOO_LONG, TOO_LONG,
+        // 10______ ________
+        TWO_CONTS, TWO_CONTS, TWO_CONTS, TWO_CONTS,
+        // 1100____ ________
+        TOO_SHORT | OVERLONG_2,
+        // 1101____ ________
+        TOO_SHORT,
+        // 1110____ ________
+        TOO_SHORT | OVERLONG_3 | SURROGATE,
+        // 1111____ ________
+        TOO_SHORT | TOO_LARGE | TOO_LARGE_1000 | OVERLONG_4};
+
+      alignas(16) static constexpr nsUInt8 s_Byte1Low[16] = {
+        // ____0000 ________
+        CARRY | OVERLONG_3 | OVERLONG_2 | OVERLONG_4,
+        // ____0001 ________
+        CARRY | OVERLONG_2,
+        // ____001_ ________
+        CARRY, CARRY,
+        // ____0100 ________
+        CARRY | TOO_LARGE,
+        // ____0101 ________ to ____1100 ________
+        CARRY | TOO_LARGE | TOO_LARGE_1000, CARRY | TOO_LARGE | TOO_LARGE_1000, CARRY | TOO_LARGE | TOO_LARGE_1000,
+        CARRY | TOO_LARGE | TOO_LARGE_1000, CARRY | TOO_LARGE | TOO_LARGE_1000, CARRY | TOO_LARGE | TOO_LARGE_1000,
+        CARRY | TOO_LARGE | TOO_LARGE_1000, CARRY | TOO_LARGE | TOO_LARGE_1000,
+        // ____1101 ________
+        CARRY | TOO_LARGE | TOO_LARGE_1000 | SURROGATE,
+        // ____111_ ________
+        CARRY | TOO_LARGE | TOO_LARGE_1000, CARRY | TOO_LARGE | TOO_LARGE_1000};
+
+      alignas(16) static constexpr nsUInt8 s_Byte2High[16] = {
+        // ________ 0_______
+        TOO_SHORT, TOO_SHORT, TOO_SHORT, TOO_SHORT, TOO_SHORT, TOO_SHORT, TOO_SHORT, TOO_SHORT,
+        // ________ 1000____
+        TOO_LONG | OVERLONG_2 | TWO_CONTS | OVERLONG_3 | TOO_LARGE_1000 | OVERLONG_4,
+        // ________ 1001____
+        TOO_LONG | OVERLONG_2 | TWO_CONTS | OVERLONG_3 | TOO_LARGE,
+        // ________ 101_____
+        TOO_LONG | OVERLONG_2 | TWO_CONTS | SURROGATE | TOO_LARGE, TOO_LONG | OVERLONG_2 | TWO_CONTS | SURROGATE | TOO_LARGE,
+        // ________ 11______
+        TOO_SHORT, TOO_SHORT, TOO_SHORT, TOO_SHORT};
+
+      const Block byte1High = Lookup(LoadBlock(s_Byte1High), HighNibbles(prev1));
+      const Block byte1Low = Lookup(LoadBlock(s_Byte1Low), And(prev1, Splat(0x0F)));
+      const Block byte2High = Lookup(LoadBlock(s_Byte2High), HighNibbles(input));
+
+      return And(And(byte1High, byte1Low), byte2High);
+    }
+
+    static Block CheckMultiByteLengths(Block input, Block prevInput, Block specialCases)
+    {
+      // only 111_____ in the byte two positions earlier and 1111____ in the byte three positions earlier end up >= 0x80
+      const Block isThirdByte = SubSaturate(Prev<2>(input, prevInput), Splat(0xE0 - 0x80));
+      const Block isFourthByte = SubSaturate(Prev<3>(input, prevInput), Splat(0xF0 - 0x80));
+
+      // these bytes must be continuation bytes, which is exactly the TWO_CONTS case from the lookup
+      return Xor(And(Or(isThirdByte, isFourthByte), Splat(0x80)), specialCases);
+    }
+
+    static Block IsIncomplete(Block input)
+    {
+      // non-zero, if one of the last three bytes starts a sequence that doesn't fit into the block
+      alignas(16) static constexpr nsUInt8 s_MaxValue[16] = {
+        0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xF0 - 1, 0xE0 - 1, 0xC0 - 1};
+
+      return SubSaturate(input, LoadBlock(s_MaxValue));
+    }
+
+    Block m_Error = Splat(0);
+    Block m_PrevInput = Splat(0);
+    Block m_PrevIncomplete = Splat(0);
+  };
+
+  template <typename Char16>
+  NS_ALWAYS_INLINE bool WidenAsciiToUtf16(const char* pInput, Char16* pOutput)
+  {
+    const Block a = LoadBlock(pInput);
+    if (!IsAscii(a))
+      return false;
+
+    StoreAsUtf16(a, pOutput);
+    return true;
+  }
+
+  template <typename Char32>
+  NS_ALWAYS_INLINE bool WidenAsciiToUtf32(const char* pInput, Char32* pOutput)
+  {
+    const Block a = LoadBlock(pInput);
+    if (!IsAscii(a))
+      return false;
+
+    StoreAsUtf32(a, pOutput);
+    return true;
+  }
+
+#else
+
+  // without SIMD, the block functions always fall back to converting one character at a time
+
+  template <typename Char16>
+  NS_ALWAYS_INLINE bool WidenAsciiToUtf16(const char*, Char16*)
+  {
+    return false;
+  }
+
+  template <typename Char32>
+  NS_ALWAYS_INLINE bool WidenAsciiToUtf32(const char*, Char32*)
+  {
+    return false;
+  }
+
+  template <typename Char16>
+  NS_ALWAYS_INLINE bool NarrowAsciiUtf16(const Char16*, char*)
+  {
+    return false;
+  }
+
+  template <typename Char32>
+  NS_ALWAYS_INLINE bool NarrowAsciiUtf32(const Char32*, char*)
+  {
+    return false;
+  }
+
+#endif
+
+  template <typename Char16>
+  nsUInt32 ConvertUtf8ToUtf16Impl(const char* pStart, const char* pEnd, Char16* pOutput)
+  {
+    const char* p = pStart;
+    Char16* pWrite = pOutput;
+
+    while (p < pEnd)
+    {
+      const char* pBlockEnd = pEnd;
+
+      if (pEnd - p >= 16)
+      {
+        if (WidenAsciiToUtf16(p, pWrite))
+        {
+          p += 16;
+          pWrite += 16;
+          continue;
+        }
+
+        pBlockEnd = p + 16;
+      }
+
+      // the block contains non-ASCII characters, convert it one character at a time
+      while (p < pBlockEnd)
+      {
+        const nsUInt8 uiByte = static_cast<nsUInt8>(*p);
+
+        if (uiByte < 0x80)
+        {
+          *pWrite++ = static_cast<Char16>(uiByte);
+          ++p;
+          continue;
+        }
+
+        if (static_cast<nsUInt32>(pEnd - p) < GetSequenceLength(uiByte))
+          return static_cast<nsUInt32>(pWrite - pOutput);
+
+        nsUnicodeUtils::EncodeUtf32ToUtf16(nsUnicodeUtils::DecodeUtf8ToUtf32(p), pWrite);
+      }
+    }
+
+    return static_cast<nsUInt32>(pWrite - pOutput);
+  }
+
+  template <typename Char32>
+  nsUInt32 ConvertUtf8ToUtf32Impl(const char* pStart, const char* pEnd, Char32* pOutput)
+  {
+    const char* p = pStart;
+    Char32* pWrite = pOutput;
+
+    while (p < pEnd)
+    {
+      const char* pBlockEnd = pEnd;
+
+      if (pEnd - p >= 16)
+      {
+        if (WidenAsciiToUtf32(p, pWrite))
+        {
+          p += 16;
+          pWrite += 16;
+          continue;
+        }
+
+        pBlockEnd = p + 16;
+      }
+
+      // the block contains non-ASCII characters, convert it one character at a time
+      while (p < pBlockEnd)
+      {
+        const nsUInt8 uiByte = static_cast<nsUInt8>(*p);
+
+        if (uiByte < 0x80)
+        {
+          *pWrite++ = static_cast<Char32>(uiByte);
+          ++p;
+          continue;
+        }
+
+        if (static_cast<nsUInt32>(pEnd - p) < GetSequenceLength(uiByte))
+          return static_cast<nsUInt32>(pWrite - pOutput);
+
+        *pWrite++ = static_cast<Char32>(nsUnicodeUtils::DecodeUtf8ToUtf32(p));
+      }
+    }
+
+    return static_cast<nsUInt32>(pWrite - pOutput);
+  }
+
+  template <typename Char16>
+  nsUInt32 ConvertUtf16ToUtf8Impl(const Char16* pStart, const Char16* pEnd, char* pOutput)
+  {
+    const Char16* p = pStart;
+    char* pWrite = pOutput;
+
+    while (p < pEnd)
+    {
+      const Char16* pBlockEnd = pEnd;
+
+      if (pEnd - p >= 8)
+      {
+        if (NarrowAsciiUtf16(p, pWrite))
+        {
+          p += 8;
+          pWrite += 8;
+          continue;
+        }
+
+        pBlockEnd = p + 8;
+      }
+
+      while (p < pBlockEnd)
+      {
+        const nsUInt32 uiElement = static_cast<nsUInt16>(*p);
+
+        if (uiElement < 0x80)
+        {
+          *pWrite++ = static_cast<char>(uiElement);
+          ++p;
+          continue;
+        }
+
+        if (!nsUnicodeUtils::IsUtf16Surrogate(p))
+        {
+          pWrite = utf8::unchecked::append(uiElement, pWrite);
+          ++p;
+          continue;
+        }
+
+        if (pEnd - p < 2)
+          return static_cast<nsUInt32>(pWrite - pOutput);
+
+        pWrite = utf8::unchecked::append(nsUnicodeUtils::DecodeUtf16ToUtf32(p), pWrite);
+      }
+    }
+
+    return static_cast<nsUInt32>(pWrite - pOutput);
+  }
+
+  template <typename Char32>
+  nsUInt32 ConvertUtf32ToUtf8Impl(const Char32* pStart, const Char32* pEnd, char* pOutput)
+  {
+    const Char32* p = pStart;
+    char* pWrite = pOutput;
+
+    while (p < pEnd)
+    {
+      const Char32* pBlockEnd = pEnd;
+
+      if (pEnd - p >= 4)
+      {
+        if (NarrowAsciiUtf32(p, pWrite))
+        {
+          p += 4;
+          pWrite += 4;
+          continue;
+        }
+
+        pBlockEnd = p + 4;
+      }
+
+      while (p < pBlockEnd)
+      {
+        pWrite = utf8::unchecked::append(static_cast<nsUInt32>(*p), pWrite);
+        ++p;
+      }
+    }
+
+    return static_cast<nsUInt32>(pWrite - pOutput);
+  }
+} // namespace
+
+// static
+bool nsUnicodeUtils::ValidateUtf8(const char* pStart, const char* pEnd)
+{
+#if NS_ENABLED(NS_STRING_SIMD)
+  nsUtf8Validator validator;
+
+  const char* p = pStart;
+  for (; pEnd - p >= 16; p += 16)
+  {
+    validator.CheckBlock(LoadBlock(p));
+  }
+
+  if (p < pEnd)
+  {
+    // the zeros behind the last bytes count as ASCII, so a truncated sequence is detected just like in the middle of the text
+    alignas(16) char lastBlock[16] = {};
+    memcpy(lastBlock, p, static_cast<size_t>(pEnd - p));
+    validator.CheckBlock(LoadBlock(lastBlock));
+  }
+
+  return validator.IsValid();
+#else
+  return utf8::is_valid(pStart, pEnd);
+#endif
+}
+
+// static
+const char* nsUnicodeUtils::SkipAscii(const char* pStart, const char* pEnd)
+{
+  const char* p = pStart;
+
+#if NS_ENABLED(NS_STRING_SIMD)
+  for (; pEnd - p >= 16; p += 16)
+  {
+    const Block block = LoadBlock(p);
+    if (!IsAscii(block))
+      return p + GetFirstNonAscii(block);
+  }
+#endif
+
+  for (; pEnd - p >= 8; p += 8)
+  {
+    const nsUInt64 uiHighBits = LoadUInt64(p) & HighBits64;
+    if (uiHighBits != 0)
+      return p + nsMath::FirstBitLow(uiHighBits) / 8;
+  }
+
+  while (p < pEnd && static_cast<nsUInt8>(*p) < 0x80)
+  {
+    ++p;
+  }
+
+  return p;
+}
+
+// static
+nsUInt32 nsUnicodeUtils::CountUtf8Characters(const char* pStart, const char* pEnd)
+{
+  const char* p = pStart;
+  nsUInt32 uiCharacters = 0;
+
+#if NS_ENABLED(NS_STRING_SIMD)
+  for (; pEnd - p >= 16; p += 16)
+  {
+    uiCharacters += CountLeadBytes(LoadBlock(p));
+  }
+#endif
+
+  for (; pEnd - p >= 8; p += 8)
+  {
+    // continuation bytes have the high bit set and the one below cleared
+    const nsUInt64 uiValue = LoadUInt64(p);
+    const nsUInt64 uiContinuationBytes = uiValue & ~(uiValue << 1) & HighBits64;
+    uiCharacters += 8 - nsMath::CountBits(uiContinuationBytes);
+  }
+
+  for (; p < pEnd; ++p)
+  {
+    if (!IsUtf8ContinuationByte(*p))
+      ++uiCharacters;
+  }
+
+  return uiCharacters;
+}
+
+// static
+nsUInt32 nsUnicodeUtils::ConvertUtf8ToUtf16(const char* pStart, const char* pEnd, nsUInt16* pOutput)
+{
+  return ConvertUtf8ToUtf16Impl(pStart, pEnd, pOutput);
+}
+
+// static
+nsUInt32 nsUnicodeUtils::ConvertUtf8ToUtf32(const char* pStart, const char* pEnd, nsUInt32* pOutput)
+{
+  return ConvertUtf8ToUtf32Impl(pStart, pEnd, pOutput);
+}
+
+// static
+nsUInt32 nsUnicodeUtils::ConvertUtf8ToWChar(const char* pStart, const char* pEnd, wchar_t* pOutput)
+{
+  if constexpr (sizeof(wchar_t) == 2)
+    return ConvertUtf8ToUtf16Impl(pStart, pEnd, pOutput);
+  else
+    return ConvertUtf8ToUtf32Impl(pStart, pEnd, pOutput);
+}
+
+// static
+nsUInt32 nsUnicodeUtils::ConvertUtf16ToUtf8(const nsUInt16* pStart, const nsUInt16* pEnd, char* pOutput)
+{
+  return ConvertUtf16ToUtf8Impl(pStart, pEnd, pOutput);
+}
+
+// static
+nsUInt32 nsUnicodeUtils::ConvertUtf32ToUtf8(const nsUInt32* pStart, const nsUInt32* pEnd, char* pOutput)
+{
+  return ConvertUtf32ToUtf8Impl(pStart, pEnd, pOutput);
+}
+
+// static
+nsUInt32 nsUnicodeUtils::ConvertWCharToUtf8(const wchar_t* pStart, const wchar_t* pEnd, char* pOutput)
+{
+  if constexpr (sizeof(wchar_t) == 2)
+    return ConvertUtf16ToUtf8Impl(pStart, pEnd, pOutput);
+  else
+    return ConvertUtf32ToUtf8Impl(pStart, pEnd, pOutput);
+}
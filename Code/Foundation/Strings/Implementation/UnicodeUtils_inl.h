@@ -153,7 +153,7 @@ NS_ALWAYS_INLINE bool nsUnicodeUtils::IsValidUtf8(const char* szString, const ch
   if (szStringEnd == GetMaxStringEnd<char>())
     szStringEnd = szString + strlen(szString);
 
-  return utf8::is_valid(szString, szStringEnd);
+  return ValidateUtf8(szString, szStringEnd);
 #else
   NS_IGNORE_UNUSED(szString);
   NS_IGNORE_UNUSED(szStringEnd);
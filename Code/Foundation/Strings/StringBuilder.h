@@ -232,6 +232,13 @@ public:
     SetFormat(nsFormatStringImpl<ARGS...>(szFormat, std::forward<ARGS>(args)...));
   }
 
+  /// \brief Overload of SetFormat() for format strings that are parsed at compile time, see NS_FMT.
+  template <typename FORMAT, typename... ARGS>
+  void SetFormat(nsFormatStringLiteral<FORMAT>, ARGS&&... args)
+  {
+    SetFormat(nsFormatStringLiteralImpl<FORMAT, ARGS...>(std::forward<ARGS>(args)...));
+  }
+
   /// \brief Appends a formatted string. Uses '{}' formatting placeholders, see nsFormatString for details.
   void AppendFormat(const nsFormatString& string);
 
@@ -242,6 +249,13 @@ public:
     AppendFormat(nsFormatStringImpl<ARGS...>(szFormat, std::forward<ARGS>(args)...));
   }
 
+  /// \brief Overload of AppendFormat() for format strings that are parsed at compile time, see NS_FMT.
+  template <typename FORMAT, typename... ARGS>
+  void AppendFormat(nsFormatStringLiteral<FORMAT>, ARGS&&... args)
+  {
+    AppendFormat(nsFormatStringLiteralImpl<FORMAT, ARGS...>(std::forward<ARGS>(args)...));
+  }
+
   /// \brief Prepends a formatted string. Uses '{}' formatting placeholders, see nsFormatString for details.
   void PrependFormat(const nsFormatString& string);
 
@@ -252,6 +266,13 @@ public:
     PrependFormat(nsFormatStringImpl<ARGS...>(szFormat, std::forward<ARGS>(args)...));
   }
 
+  /// \brief Overload of PrependFormat() for format strings that are parsed at compile time, see NS_FMT.
+  template <typename FORMAT, typename... ARGS>
+  void PrependFormat(nsFormatStringLiteral<FORMAT>, ARGS&&... args)
+  {
+    PrependFormat(nsFormatStringLiteralImpl<FORMAT, ARGS...>(std::forward<ARGS>(args)...));
+  }
+
   /// \brief Removes the first n and last m characters from this string.
   ///
   /// This function will never reallocate data.
@@ -0,0 +1,45 @@
+#pragma once
+
+#include <Foundation/Basics.h>
+#include <Foundation/Strings/String.h>
+
+/// \brief Searches for the same string in many or long texts, e.g. when filtering lists by a search text.
+///
+/// nsStringUtils::FindSubString() always jumps to the occurrences of the first byte of the pattern, which is often a very common
+/// one. SetPattern() instead picks the two bytes of the pattern that are least likely to occur in typical text. Case sensitive
+/// searches jump to the occurrences of the rarest one with memchr and check the second one before comparing the whole pattern.
+/// When that still produces many failed candidates, blocks of the text are filtered for both bytes at once with SIMD
+/// instructions, where available.
+///
+/// Case insensitive searches are passed on to FindSubString_NoCase(), because Unicode case conversion may change the length of
+/// characters, so that bytes at fixed offsets in the pattern can't be used as a filter.
+///
+/// The results are always identical to those of FindSubString() and FindSubString_NoCase().
+class NS_FOUNDATION_DLL nsStringSearcher
+{
+public:
+  nsStringSearcher(); // [tested]
+  explicit nsStringSearcher(nsStringView sPattern, bool bCaseSensitive = true); // [tested]
+
+  /// \brief Sets the string to search for and picks the bytes that candidate positions are filtered by.
+  void SetPattern(nsStringView sPattern, bool bCaseSensitive = true); // [tested]
+
+  const nsString& GetPattern() const { return m_sPattern; }
+  bool IsCaseSensitive() const { return m_bCaseSensitive; }
+
+  /// \brief Returns the position of the first occurrence of the pattern in sText, or nullptr if it doesn't occur.
+  ///
+  /// An empty pattern is never found, just like with FindSubString().
+  const char* FindIn(nsStringView sText) const; // [tested]
+
+  /// \brief Returns whether sText contains the pattern.
+  bool IsContainedIn(nsStringView sText) const { return FindIn(sText) != nullptr; } // [tested]
+
+private:
+  const char* FindBytes(const char* pText, const char* pTextEnd) const;
+
+  nsString m_sPattern;
+  nsUInt32 m_uiRareOffset0 = 0; ///< Offset of the byte in the pattern that is least likely to occur in a text.
+  nsUInt32 m_uiRareOffset1 = 0; ///< Offset of the next rarest byte, with a different value where possible.
+  bool m_bCaseSensitive = true;
+};
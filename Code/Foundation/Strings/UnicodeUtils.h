@@ -58,8 +58,40 @@ public:
   static nsResult MoveToPriorUtf8(const char*& ref_szUtf8, const char* szUtf8Start, nsUInt32 uiNumCharacters = 1); // [tested]
 
   /// \brief Returns false if the given string does not contain a completely valid Utf8 string.
+  ///
+  /// Only does the check if NS_USE_STRING_VALIDATION is enabled, otherwise it always returns true.
   static bool IsValidUtf8(const char* szString, const char* szStringEnd = GetMaxStringEnd<char>());
 
+  /// \brief Returns whether the bytes in the range [pStart; pEnd) are valid Utf8, independent of NS_USE_STRING_VALIDATION.
+  ///
+  /// Rejects truncated and overlong sequences, surrogates and code points beyond U+10FFFF. Checks 16 bytes at a time with SSE or NEON.
+  static bool ValidateUtf8(const char* pStart, const char* pEnd); // [tested]
+
+  /// \brief Returns a pointer to the first byte in [pStart; pEnd) that is not an ASCII character, or pEnd if there is none.
+  static const char* SkipAscii(const char* pStart, const char* pEnd); // [tested]
+
+  /// \brief Returns the number of characters in the range [pStart; pEnd), ie. the number of bytes that are not Utf8 continuation bytes.
+  ///
+  /// Zero bytes are counted like any other character.
+  static nsUInt32 CountUtf8Characters(const char* pStart, const char* pEnd); // [tested]
+
+  /// \name Bulk transcoding
+  ///
+  /// These functions convert a whole range of valid Utf8, Utf16 or Utf32 text at once and return the number of elements that were
+  /// written to the output. Runs of ASCII characters are converted 16 at a time with SSE or NEON, everything else is converted one
+  /// character at a time. No terminator is written. The output buffer must be large enough for the worst case: one element per Utf8
+  /// byte when converting from Utf8, three bytes per Utf16 element and four bytes per Utf32 element when converting to Utf8.
+  ///@{
+
+  static nsUInt32 ConvertUtf8ToUtf16(const char* pStart, const char* pEnd, nsUInt16* pOutput); // [tested]
+  static nsUInt32 ConvertUtf8ToUtf32(const char* pStart, const char* pEnd, nsUInt32* pOutput); // [tested]
+  static nsUInt32 ConvertUtf8ToWChar(const char* pStart, const char* pEnd, wchar_t* pOutput); // [tested]
+  static nsUInt32 ConvertUtf16ToUtf8(const nsUInt16* pStart, const nsUInt16* pEnd, char* pOutput); // [tested]
+  static nsUInt32 ConvertUtf32ToUtf8(const nsUInt32* pStart, const nsUInt32* pEnd, char* pOutput); // [tested]
+  static nsUInt32 ConvertWCharToUtf8(const wchar_t* pStart, const wchar_t* pEnd, char* pOutput); // [tested]
+
+  ///@}
+
   /// \brief If the given string starts with a Utf8 Bom, the pointer is incremented behind the Bom, and the function returns true.
   ///
   /// Otherwise the pointer is unchanged and false is returned.
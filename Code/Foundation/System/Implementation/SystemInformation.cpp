@@ -1,5 +1,6 @@
 #include <Foundation/FoundationPCH.h>
 
+#include <Foundation/Math/Math.h>
 #include <Foundation/System/SystemInformation.h>
 
 // Storage for the current configuration
@@ -170,3 +171,19 @@ void nsCpuFeatures::Detect()
 }
 
 #endif
+
+void nsCpuTopology::SetUniform(nsUInt32 uiNumLogicalProcessors)
+{
+  m_bDetected = false;
+  m_uiNumLogicalProcessors = nsMath::Clamp<nsUInt32>(uiNumLogicalProcessors, 1, MaxLogicalProcessors);
+  m_uiNumCores = m_uiNumLogicalProcessors;
+  m_uiNumCacheDomains = 1;
+  m_uiNumPackages = 1;
+
+  for (nsUInt32 i = 0; i < m_uiNumLogicalProcessors; ++i)
+  {
+    m_LogicalProcessors[i] = {};
+    m_LogicalProcessors[i].m_uiProcessorIndex = static_cast<nsUInt16>(i);
+    m_LogicalProcessors[i].m_uiCore = static_cast<nsUInt16>(i);
+  }
+}
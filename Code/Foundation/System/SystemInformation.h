@@ -89,6 +89,42 @@ struct nsCpuFeatures
   void Detect();
 };
 
+/// \brief Describes how the logical processors of the system are grouped into physical cores, shared caches and packages (sockets).
+///
+/// Threads that run on processors of the same cache domain share the last level cache, so handing work over between them is cheap.
+/// Crossing a cache domain (e.g. a CCX or another socket) means that all the data has to be fetched again.
+/// On platforms where the topology cannot be queried, every logical processor is treated as a separate core in a single cache domain.
+struct nsCpuTopology
+{
+  static constexpr nsUInt32 MaxLogicalProcessors = 512;
+
+  struct LogicalProcessor
+  {
+    nsUInt16 m_uiProcessorIndex = 0; ///< The index that the OS uses for this processor, e.g. for thread affinity.
+    nsUInt16 m_uiCore = 0;           ///< Logical processors with the same core index are hardware threads (SMT siblings) of one core.
+    nsUInt16 m_uiSiblingIndex = 0;   ///< Which hardware thread of its core this processor is (0 for the first one).
+    nsUInt16 m_uiCacheDomain = 0;    ///< Logical processors with the same cache domain index share the last level cache.
+    nsUInt16 m_uiPackage = 0;        ///< The physical package (socket) of the processor.
+  };
+
+  /// \brief Whether the OS reported the topology. If not, the data is the fallback described above.
+  bool m_bDetected = false;
+
+  nsUInt32 m_uiNumLogicalProcessors = 0;
+  nsUInt32 m_uiNumCores = 0;
+  nsUInt32 m_uiNumCacheDomains = 0;
+  nsUInt32 m_uiNumPackages = 0;
+
+  /// \brief All available logical processors, sorted by their processor index.
+  LogicalProcessor m_LogicalProcessors[MaxLogicalProcessors];
+
+  /// \brief Queries the topology from the OS, if the platform supports that. Otherwise sets up \a uiNumLogicalProcessors independent cores.
+  void Detect(nsUInt32 uiNumLogicalProcessors);
+
+  /// \brief Sets up \a uiNumLogicalProcessors cores without hardware threads, that all share one cache and package.
+  void SetUniform(nsUInt32 uiNumLogicalProcessors);
+};
+
 /// \brief The system configuration class encapsulates information about the system the
 /// application is running on.
 ///
@@ -127,6 +163,9 @@ public:
   /// features (SIMD support).
   const nsCpuFeatures& GetCpuFeatures() const { return m_CpuFeatures; }
 
+  /// \brief Returns how the logical processors are grouped into cores, shared caches and packages.
+  const nsCpuTopology& GetCpuTopology() const { return m_CpuTopology; }
+
 public:
   /// \brief Returns whether a debugger is currently attached to this process.
   static bool IsDebuggerAttached();
@@ -151,6 +190,7 @@ private:
   bool m_bB64BitOS;
   bool m_bIsInitialized;
   nsCpuFeatures m_CpuFeatures;
+  nsCpuTopology m_CpuTopology;
 
   static void Initialize();
 
@@ -7,10 +7,13 @@ template <typename IndexType, typename Callback>
 class IndexedTask final : public nsTask
 {
 public:
-  IndexedTask(IndexType uiStartIndex, IndexType uiNumItems, Callback taskCallback, IndexType uiItemsPerInvocation)
+  IndexedTask(IndexType uiStartIndex, IndexType uiNumItems, Callback taskCallback, IndexType uiItemsPerInvocation,
+    nsParallelForSplitting splitting = nsParallelForSplitting::Static, nsUInt32 uiNumInvocations = 1)
     : m_uiStartIndex(uiStartIndex)
     , m_uiNumItems(uiNumItems)
     , m_uiItemsPerInvocation(uiItemsPerInvocation)
+    , m_Splitting(splitting)
+    , m_Cursor(uiNumItems, uiItemsPerInvocation, uiNumInvocations)
     , m_TaskCallback(std::move(taskCallback))
   {
   }
@@ -23,6 +26,18 @@ public:
 
   void ExecuteWithMultiplicity(nsUInt32 uiInvocation) const override
   {
+    if (m_Splitting == nsParallelForSplitting::Adaptive)
+    {
+      // keep claiming chunks until all items are taken, the invocation index is meaningless here
+      nsUInt64 uiFirst, uiEnd;
+      while (m_Cursor.ClaimChunk(uiFirst, uiEnd))
+      {
+        m_TaskCallback(m_uiStartIndex + static_cast<IndexType>(uiFirst), m_uiStartIndex + static_cast<IndexType>(uiEnd));
+      }
+
+      return;
+    }
+
     const IndexType uiSliceStartIndex = uiInvocation * m_uiItemsPerInvocation;
     const IndexType uiSliceEndIndex = nsMath::Min(uiSliceStartIndex + m_uiItemsPerInvocation, m_uiStartIndex + m_uiNumItems);
 
@@ -36,6 +51,8 @@ private:
   IndexType m_uiStartIndex;
   IndexType m_uiNumItems;
   IndexType m_uiItemsPerInvocation;
+  nsParallelForSplitting m_Splitting;
+  mutable nsParallelForRangeCursor m_Cursor;
   Callback m_TaskCallback;
 };
 
@@ -65,9 +82,9 @@ void ParallelForIndexedInternal(IndexType uiStartIndex, IndexType uiNumItems, co
     nsUInt64 uiItemsPerInvocation;
     params.DetermineThreading(uiNumItems, uiMultiplicity, uiItemsPerInvocation);
 
-    nsAllocator* pAllocator = (params.m_pTaskAllocator != nullptr) ? params.m_pTaskAllocator : nsFoundation::GetDefaultAllocator();
+    nsAllocator* pAllocator = (params.m_pTaskAllocator != nullptr) ? params.m_pTaskAllocator : nsTaskSystem::GetTaskAllocator();
 
-    nsSharedPtr<Task> pIndexedTask = NS_NEW(pAllocator, Task, uiStartIndex, uiNumItems, std::move(taskCallback), static_cast<IndexType>(uiItemsPerInvocation));
+    nsSharedPtr<Task> pIndexedTask = NS_NEW(pAllocator, Task, uiStartIndex, uiNumItems, std::move(taskCallback), static_cast<IndexType>(uiItemsPerInvocation), params.m_Splitting, uiMultiplicity);
     pIndexedTask->ConfigureTask(szTaskName, taskNesting);
 
     pIndexedTask->SetMultiplicity(uiMultiplicity);
@@ -82,9 +99,19 @@ void nsParallelForParams::DetermineThreading(nsUInt64 uiNumItemsToExecute, nsUIn
   // so that it gets scheduled M times, which is effectively the same as creating M tasks
 
   const nsUInt32 uiNumWorkerThreads = nsTaskSystem::GetWorkerThreadCount(nsWorkerThreadType::ShortTasks);
-  const nsUInt64 uiMaxTasksToUse = uiNumWorkerThreads * m_uiMaxTasksPerThread;
   const nsUInt64 uiMaxExecutionsRequired = nsMath::Max(1llu, uiNumItemsToExecute / m_uiBinSize);
 
+  if (m_Splitting == nsParallelForSplitting::Adaptive)
+  {
+    // one invocation per thread that may work on it (the workers plus the waiting thread), they claim chunks until all items are done
+    // more invocations would only add scheduling overhead, since the chunks are balanced dynamically anyway
+    out_uiNumTasksToRun = static_cast<nsUInt32>(nsMath::Min<nsUInt64>(uiNumWorkerThreads + 1, uiMaxExecutionsRequired));
+    out_uiNumItemsPerTask = m_uiBinSize;
+    return;
+  }
+
+  const nsUInt64 uiMaxTasksToUse = uiNumWorkerThreads * m_uiMaxTasksPerThread;
+
   if (uiMaxExecutionsRequired >= uiMaxTasksToUse)
   {
     // if we have more items to execute, than the upper limit of tasks that we want to spawn, clamp the number of tasks
@@ -7,9 +7,12 @@ template <typename ElemType>
 class ArrayPtrTask final : public nsTask
 {
 public:
-  ArrayPtrTask(nsArrayPtr<ElemType> payload, nsParallelForFunction<ElemType> taskCallback, nsUInt32 uiItemsPerInvocation)
+  ArrayPtrTask(nsArrayPtr<ElemType> payload, nsParallelForFunction<ElemType> taskCallback, nsUInt32 uiItemsPerInvocation,
+    nsParallelForSplitting splitting = nsParallelForSplitting::Static, nsUInt32 uiNumInvocations = 1)
     : m_Payload(payload)
     , m_uiItemsPerInvocation(uiItemsPerInvocation)
+    , m_Splitting(splitting)
+    , m_Cursor(payload.GetCount(), uiItemsPerInvocation, uiNumInvocations)
     , m_TaskCallback(std::move(taskCallback))
   {
   }
@@ -22,6 +25,18 @@ public:
 
   void ExecuteWithMultiplicity(nsUInt32 uiInvocation) const override
   {
+    if (m_Splitting == nsParallelForSplitting::Adaptive)
+    {
+      // keep claiming chunks until all items are taken, the invocation index is meaningless here
+      nsUInt64 uiFirst, uiEnd;
+      while (m_Cursor.ClaimChunk(uiFirst, uiEnd))
+      {
+        m_TaskCallback(static_cast<nsUInt32>(uiFirst), m_Payload.GetSubArray(static_cast<nsUInt32>(uiFirst), static_cast<nsUInt32>(uiEnd - uiFirst)));
+      }
+
+      return;
+    }
+
     const nsUInt32 uiSliceStartIndex = uiInvocation * m_uiItemsPerInvocation;
 
     const nsUInt32 uiRemainingItems = uiSliceStartIndex > m_Payload.GetCount() ? 0 : m_Payload.GetCount() - uiSliceStartIndex;
@@ -38,6 +53,8 @@ public:
 private:
   nsArrayPtr<ElemType> m_Payload;
   nsUInt32 m_uiItemsPerInvocation;
+  nsParallelForSplitting m_Splitting;
+  mutable nsParallelForRangeCursor m_Cursor;
   nsParallelForFunction<ElemType> m_TaskCallback;
 };
 
@@ -58,9 +75,9 @@ void nsTaskSystem::ParallelForInternal(nsArrayPtr<ElemType> taskItems, nsParalle
     nsUInt64 uiItemsPerInvocation;
     params.DetermineThreading(taskItems.GetCount(), uiMultiplicity, uiItemsPerInvocation);
 
-    nsAllocator* pAllocator = (params.m_pTaskAllocator != nullptr) ? params.m_pTaskAllocator : nsFoundation::GetDefaultAllocator();
+    nsAllocator* pAllocator = (params.m_pTaskAllocator != nullptr) ? params.m_pTaskAllocator : nsTaskSystem::GetTaskAllocator();
 
-    nsSharedPtr<ArrayPtrTask<ElemType>> pArrayPtrTask = NS_NEW(pAllocator, ArrayPtrTask<ElemType>, taskItems, std::move(taskCallback), static_cast<nsUInt32>(uiItemsPerInvocation));
+    nsSharedPtr<ArrayPtrTask<ElemType>> pArrayPtrTask = NS_NEW(pAllocator, ArrayPtrTask<ElemType>, taskItems, std::move(taskCallback), static_cast<nsUInt32>(uiItemsPerInvocation), params.m_Splitting, uiMultiplicity);
     pArrayPtrTask->ConfigureTask(taskName ? taskName : "Generic ArrayPtr Task", params.m_NestingMode);
 
     pArrayPtrTask->SetMultiplicity(uiMultiplicity);
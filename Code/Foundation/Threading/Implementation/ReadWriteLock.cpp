@@ -0,0 +1,163 @@
+#include <Foundation/FoundationPCH.h>
+
+#include <Foundation/Threading/ReadWriteLock.h>
+#include <Foundation/Threading/ThreadUtils.h>
+
+namespace
+{
+  // a lock on which the current thread holds read locks, and how many
+  struct HeldReadLock
+  {
+    const nsReadWriteLock* m_pLock;
+    nsUInt32 m_uiDepth;
+  };
+
+  constexpr nsUInt32 MaxHeldReadLocks = 16;
+
+  thread_local HeldReadLock t_HeldReadLocks[MaxHeldReadLocks];
+  thread_local nsUInt32 t_uiNumHeldReadLocks = 0;
+
+  // returns how many read locks the current thread holds on pLock, including the new one
+  nsUInt32 AddHeldReadLock(const nsReadWriteLock* pLock)
+  {
+    // the most recently taken locks are the most likely ones to be taken again
+    for (nsUInt32 i = t_uiNumHeldReadLocks; i > 0; --i)
+    {
+      if (t_HeldReadLocks[i - 1].m_pLock == pLock)
+        return ++t_HeldReadLocks[i - 1].m_uiDepth;
+    }
+
+    NS_ASSERT_DEV(t_uiNumHeldReadLocks < MaxHeldReadLocks, "A thread can't hold read locks on more than {} nsReadWriteLocks at the same time.", MaxHeldReadLocks);
+
+    t_HeldReadLocks[t_uiNumHeldReadLocks] = {pLock, 1};
+    ++t_uiNumHeldReadLocks;
+    return 1;
+  }
+
+  void RemoveHeldReadLock(const nsReadWriteLock* pLock)
+  {
+    for (nsUInt32 i = t_uiNumHeldReadLocks; i > 0; --i)
+    {
+      HeldReadLock& lock = t_HeldReadLocks[i - 1];
+
+      if (lock.m_pLock == pLock)
+      {
+        if (--lock.m_uiDepth == 0)
+        {
+          lock = t_HeldReadLocks[t_uiNumHeldReadLocks - 1];
+          --t_uiNumHeldReadLocks;
+        }
+
+        return;
+      }
+    }
+
+    NS_ASSERT_DEV(false, "The read-write lock is not locked for reading by this thread.");
+  }
+} // namespace
+
+nsReadWriteLock::nsReadWriteLock() = default;
+
+nsReadWriteLock::~nsReadWriteLock()
+{
+  NS_ASSERT_DEV(m_iState == 0, "The read-write lock is destroyed while it is still locked.");
+}
+
+void nsReadWriteLock::LockRead()
+{
+  const nsUInt32 uiDepth = AddHeldReadLock(this);
+
+  const nsInt32 iState = m_iState.Increment();
+
+  if ((iState & WriterPendingBit) == 0)
+    return;
+
+  // A writer waits for the active readers to finish. If this thread already holds a read lock on this lock, it is one of them,
+  // so it must not wait for the writer. The writer only becomes active once the reader count is zero, which our increment prevents.
+  if ((iState & WriterActiveBit) == 0 && uiDepth > 1)
+    return;
+
+  // back off, so that the writer doesn't have to wait for us
+  m_iState.Decrement();
+  LockReadContended();
+}
+
+void nsReadWriteLock::UnlockRead()
+{
+  RemoveHeldReadLock(this);
+
+  if ((m_iState & WriterBits) != 0)
+  {
+    UnlockReadContended();
+    return;
+  }
+
+  m_iState.Decrement();
+}
+
+void nsReadWriteLock::LockReadContended()
+{
+  m_WriterMutex.Lock();
+
+  if (m_uiWriteRecursion > 0)
+  {
+    // this thread holds the write lock, so it may read as well
+    // the mutex stays locked until UnlockRead(), which is how UnlockRead() can tell this case apart
+    return;
+  }
+
+  // no writer can become pending while we hold the mutex
+  m_iState.Increment();
+  m_WriterMutex.Unlock();
+}
+
+void nsReadWriteLock::UnlockReadContended()
+{
+  if (m_WriterMutex.TryLock().Succeeded())
+  {
+    if (m_uiWriteRecursion > 0)
+    {
+      // the read lock was taken by the writer itself, see LockReadContended()
+      m_WriterMutex.Unlock();
+      m_WriterMutex.Unlock();
+      return;
+    }
+
+    m_WriterMutex.Unlock();
+  }
+
+  m_iState.Decrement();
+}
+
+void nsReadWriteLock::LockWrite()
+{
+  m_WriterMutex.Lock();
+
+  if (++m_uiWriteRecursion > 1)
+    return;
+
+  m_iState.Add(WriterPendingBit);
+
+  // new readers back off now, wait until the active ones are done
+  for (nsUInt32 uiSpin = 0; !m_iState.TestAndSet(WriterPendingBit, WriterBits); ++uiSpin)
+  {
+    if (uiSpin < 64)
+      nsThreadUtils::YieldHardwareThread();
+    else
+      nsThreadUtils::YieldTimeSlice();
+  }
+}
+
+void nsReadWriteLock::UnlockWrite()
+{
+  NS_ASSERT_DEV(m_uiWriteRecursion > 0, "The read-write lock is not locked for writing.");
+
+  if (--m_uiWriteRecursion == 0)
+  {
+    m_iState.Subtract(WriterBits);
+  }
+
+  m_WriterMutex.Unlock();
+}
+
+NS_STATICLINK_FILE(Foundation, Foundation_Threading_Implementation_ReadWriteLock);
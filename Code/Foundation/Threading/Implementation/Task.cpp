@@ -9,6 +9,8 @@ nsTask::~nsTask() = default;
 void nsTask::Reset()
 {
   m_iRemainingRuns = (int)nsMath::Max(1u, m_uiMultiplicity);
+  ++m_uiScheduleGeneration;
+  m_iScheduleState = MakeScheduleState(m_uiScheduleGeneration, NotScheduled);
   m_bCancelExecution = false;
   m_bTaskIsScheduled = false;
   m_bUsesMultiplicity = m_uiMultiplicity > 0;
@@ -29,15 +31,10 @@ void nsTask::SetMultiplicity(nsUInt32 uiMultiplicity)
   m_bUsesMultiplicity = m_uiMultiplicity > 0;
 }
 
-void nsTask::Run(nsUInt32 uiInvocation)
+bool nsTask::Run(nsUInt32 uiInvocation)
 {
-  // actually this should not be possible to happen
-  if (m_iRemainingRuns == 0 || m_bCancelExecution)
-  {
-    m_iRemainingRuns = 0;
-    return;
-  }
-
+  // runs that were already picked up by a thread when the task got canceled still have to be counted down
+  if (!m_bCancelExecution)
   {
     nsStringBuilder scopeName = m_sTaskName;
 
@@ -56,5 +53,5 @@ void nsTask::Run(nsUInt32 uiInvocation)
     }
   }
 
-  m_iRemainingRuns.Decrement();
+  return m_iRemainingRuns.Decrement() == 0;
 }
@@ -3,6 +3,7 @@
 #include <Foundation/Strings/String.h>
 #include <Foundation/Threading/AtomicInteger.h>
 #include <Foundation/Threading/Implementation/TaskSystemDeclarations.h>
+#include <Foundation/Time/Time.h>
 #include <Foundation/Types/RefCounted.h>
 
 /// \brief Base class for custom tasks.
@@ -44,6 +45,26 @@ public:
   /// \sa SetMultiplicity
   nsUInt32 GetMultiplicity() const { return m_uiMultiplicity; } // [tested]
 
+  /// \brief Sets the point in time (in nsTime::Now() terms) by which the task should be finished. Zero (the default) means no deadline.
+  ///
+  /// Within the same priority, tasks with a deadline are executed before tasks without one, and the task that has to be started first
+  /// to still meet its deadline (see SetEstimatedCost()) is executed first. The task system counts how many tasks finished too late,
+  /// see nsTaskSystem::GetTaskDeadlineStats(), and measures how long they took, see nsTaskSystem::GetEstimatedTaskCost().
+  ///
+  /// Just like the multiplicity, the deadline has to be set before the task is scheduled.
+  void SetDeadline(nsTime deadline) { m_Deadline = deadline; } // [tested]
+
+  /// \sa SetDeadline
+  nsTime GetDeadline() const { return m_Deadline; } // [tested]
+
+  /// \brief Sets how long a single run of the task is expected to take. This is only used for tasks with a deadline.
+  ///
+  /// If this is zero (the default), the duration that was measured for previous runs of tasks with the same name is used instead.
+  void SetEstimatedCost(nsTime cost) { m_EstimatedCost = cost; } // [tested]
+
+  /// \sa SetEstimatedCost
+  nsTime GetEstimatedCost() const { return m_EstimatedCost; }
+
   /// \brief Returns whether the task has been finished. This includes being canceled.
   ///
   /// \note This function is only reliable when you KNOW that the task has not been reused.
@@ -79,15 +100,37 @@ private:
   // The task system and its worker threads implement most of the functionality of the task handling.
   // Therefore they are allowed to modify all this internal state.
   friend class nsTaskSystem;
+  friend class nsTaskGraph;
 
   void Reset();
 
-  /// \brief Called by nsTaskSystem to execute the task. Calls 'Execute' internally.
-  void Run(nsUInt32 uiInvocation);
+  /// \brief Called by nsTaskSystem to execute the task. Calls 'Execute' internally. Returns true, if this was the last remaining run.
+  bool Run(nsUInt32 uiInvocation);
 
   /// \brief Decremented when a task is finished, set to zero when canceled.
   nsAtomicInteger32 m_iRemainingRuns;
 
+  /// \brief Special values for the lower half of m_iScheduleState.
+  static constexpr nsUInt32 NotScheduled = 0xFFFFFFFF;
+  static constexpr nsUInt32 BeingScheduled = 0xFFFFFFFE;
+
+  static constexpr nsInt64 MakeScheduleState(nsUInt32 uiGeneration, nsUInt32 uiRuns)
+  {
+    return static_cast<nsInt64>((static_cast<nsUInt64>(uiGeneration) << 32) | uiRuns);
+  }
+
+  static constexpr nsUInt32 GetScheduleGeneration(nsInt64 iState) { return static_cast<nsUInt32>(static_cast<nsUInt64>(iState) >> 32); }
+  static constexpr nsUInt32 GetScheduledRuns(nsInt64 iState) { return static_cast<nsUInt32>(static_cast<nsUInt64>(iState)); }
+
+  /// \brief The schedule generation (upper 32 bits) and the number of queued runs that have not been picked up by any thread yet (lower 32 bits).
+  ///
+  /// Worker threads and CancelTask() race for the queued runs through this value. Queue entries that were canceled stay in the
+  /// work-stealing queues, the generation allows to detect such stale entries, even after the task has been reused.
+  nsAtomicInteger64 m_iScheduleState;
+
+  /// \brief Incremented every time the task is added to a task group.
+  nsUInt32 m_uiScheduleGeneration = 0;
+
   /// \brief Set to true when the task is SUPPOSED to cancel. Whether the task is able to do that, depends on its implementation.
   bool m_bCancelExecution = false;
 
@@ -108,5 +151,12 @@ private:
   /// \brief The parent group to which this task belongs.
   nsTaskGroupID m_BelongsToGroup;
 
+  /// \brief The index of the task's node, while the task is executed as part of an nsTaskGraph.
+  nsUInt32 m_uiTaskGraphNode = 0xFFFFFFFF;
+
+  /// \brief See SetDeadline() and SetEstimatedCost().
+  nsTime m_Deadline;
+  nsTime m_EstimatedCost;
+
   nsString m_sTaskName;
 };
@@ -0,0 +1,351 @@
+#include <Foundation/FoundationPCH.h>
+
+#include <Foundation/Threading/Implementation/TaskAllocator.h>
+#include <Foundation/Threading/Lock.h>
+
+namespace
+{
+  // stored directly in front of every block that is handed out
+  struct BlockHeader
+  {
+    nsUInt32 m_uiSizeClass;
+    nsUInt32 m_uiOffset;
+  };
+
+  constexpr size_t s_uiBlockPrefix = 16;
+  constexpr nsUInt32 s_uiLargeAllocation = 0xFFFFFFFF;
+
+  // how many pools can have thread caches at the same time, the others use their shared lists directly
+  constexpr nsUInt32 MaxCachedPools = 8;
+
+  BlockHeader* GetHeader(void* pPtr)
+  {
+    return reinterpret_cast<BlockHeader*>(static_cast<nsUInt8*>(pPtr) - sizeof(BlockHeader));
+  }
+} // namespace
+
+struct nsAllocPolicyTaskPool::ThreadCache
+{
+  FreeBlock* m_pFirst[NumSizeClasses];
+  nsUInt32 m_uiCount[NumSizeClasses];
+};
+
+struct nsAllocPolicyTaskPool::ThreadCacheSlots
+{
+  ThreadCache m_Caches[MaxCachedPools];
+
+  // a cache is only valid, if its generation matches the one of the pool, otherwise it belonged to a destroyed pool
+  nsUInt32 m_uiGenerations[MaxCachedPools];
+
+  bool m_bThreadExited;
+};
+
+struct nsAllocPolicyTaskPool::CacheSlotTable
+{
+  nsMutex m_Mutex;
+  nsAllocPolicyTaskPool* m_pOwners[MaxCachedPools] = {};
+  nsUInt32 m_uiGenerations[MaxCachedPools] = {};
+};
+
+struct nsAllocPolicyTaskPool::ThreadCacheFlusher
+{
+  ~ThreadCacheFlusher()
+  {
+    ThreadCacheSlots& slots = GetThreadCacheSlots();
+    CacheSlotTable& table = GetCacheSlotTable();
+
+    // a pool can't be destroyed while its blocks are handed back, it invalidates its slot under the same lock
+    NS_LOCK(table.m_Mutex);
+
+    for (nsUInt32 i = 0; i < MaxCachedPools; ++i)
+    {
+      if (slots.m_uiGenerations[i] != 0 && slots.m_uiGenerations[i] == table.m_uiGenerations[i] && table.m_pOwners[i] != nullptr)
+      {
+        table.m_pOwners[i]->ReturnAllBlocks(slots.m_Caches[i]);
+      }
+
+      slots.m_uiGenerations[i] = 0;
+    }
+
+    // thread local objects that get destroyed after this one may still release tasks, they have to use the shared lists
+    slots.m_bThreadExited = true;
+  }
+};
+
+nsAllocPolicyTaskPool::ThreadCacheSlots& nsAllocPolicyTaskPool::GetThreadCacheSlots()
+{
+  static thread_local ThreadCacheSlots s_Slots;
+  return s_Slots;
+}
+
+nsAllocPolicyTaskPool::CacheSlotTable& nsAllocPolicyTaskPool::GetCacheSlotTable()
+{
+  // never destroyed, threads may exit after the static destructors ran
+  alignas(CacheSlotTable) static nsUInt8 s_TableBuffer[sizeof(CacheSlotTable)];
+  static CacheSlotTable* s_pTable = new (s_TableBuffer) CacheSlotTable();
+  return *s_pTable;
+}
+
+nsAllocPolicyTaskPool::nsAllocPolicyTaskPool(nsAllocator* pParent)
+  : m_pParent(pParent)
+{
+  NS_ASSERT_ALWAYS(m_pParent != nullptr, "Parent allocator must not be nullptr");
+
+  CacheSlotTable& table = GetCacheSlotTable();
+  NS_LOCK(table.m_Mutex);
+
+  for (nsUInt32 i = 0; i < MaxCachedPools; ++i)
+  {
+    if (table.m_pOwners[i] == nullptr)
+    {
+      // zero is reserved for 'no cache'
+      if (++table.m_uiGenerations[i] == 0)
+        ++table.m_uiGenerations[i];
+
+      table.m_pOwners[i] = this;
+      m_uiCacheSlot = i;
+      m_uiCacheGeneration = table.m_uiGenerations[i];
+      break;
+    }
+  }
+}
+
+nsAllocPolicyTaskPool::~nsAllocPolicyTaskPool()
+{
+  if (m_uiCacheGeneration != 0)
+  {
+    CacheSlotTable& table = GetCacheSlotTable();
+    NS_LOCK(table.m_Mutex);
+
+    // the caches of all threads become invalid, each thread drops its blocks the next time it looks at the slot
+    table.m_pOwners[m_uiCacheSlot] = nullptr;
+    ++table.m_uiGenerations[m_uiCacheSlot];
+  }
+
+  for (void* pSlab : m_Slabs)
+  {
+    m_pParent->Deallocate(pSlab);
+  }
+}
+
+void* nsAllocPolicyTaskPool::Allocate(size_t uiSize, size_t uiAlign)
+{
+  const size_t uiBlockSize = uiSize + s_uiBlockPrefix;
+
+  if (uiAlign > s_uiBlockPrefix || uiBlockSize > (SmallestBlockSize << (NumSizeClasses - 1)))
+  {
+    m_iNumLargeAllocations.Increment();
+
+    const size_t uiPrefix = nsMath::Max(uiAlign, s_uiBlockPrefix);
+    nsUInt8* pMem = static_cast<nsUInt8*>(m_pParent->Allocate(uiSize + uiPrefix, uiPrefix));
+
+    void* pPtr = pMem + uiPrefix;
+    GetHeader(pPtr)->m_uiSizeClass = s_uiLargeAllocation;
+    GetHeader(pPtr)->m_uiOffset = static_cast<nsUInt32>(uiPrefix);
+    return pPtr;
+  }
+
+  nsUInt32 uiSizeClass = 0;
+  while ((static_cast<size_t>(SmallestBlockSize) << uiSizeClass) < uiBlockSize)
+  {
+    ++uiSizeClass;
+  }
+
+  FreeBlock* pBlock = nullptr;
+
+  if (ThreadCache* pCache = GetThreadCache())
+  {
+    if (pCache->m_pFirst[uiSizeClass] == nullptr)
+    {
+      RefillThreadCache(*pCache, uiSizeClass);
+    }
+
+    pBlock = pCache->m_pFirst[uiSizeClass];
+    pCache->m_pFirst[uiSizeClass] = pBlock->m_pNext;
+    --pCache->m_uiCount[uiSizeClass];
+  }
+  else
+  {
+    pBlock = AllocateUncached(uiSizeClass);
+  }
+
+  void* pPtr = reinterpret_cast<nsUInt8*>(pBlock) + s_uiBlockPrefix;
+  GetHeader(pPtr)->m_uiSizeClass = uiSizeClass;
+  GetHeader(pPtr)->m_uiOffset = s_uiBlockPrefix;
+  return pPtr;
+}
+
+void nsAllocPolicyTaskPool::Deallocate(void* pPtr)
+{
+  if (pPtr == nullptr)
+    return;
+
+  const BlockHeader header = *GetHeader(pPtr);
+  void* pBlock = static_cast<nsUInt8*>(pPtr) - header.m_uiOffset;
+
+  if (header.m_uiSizeClass == s_uiLargeAllocation)
+  {
+    m_pParent->Deallocate(pBlock);
+    return;
+  }
+
+  FreeBlock* pFreeBlock = static_cast<FreeBlock*>(pBlock);
+
+  ThreadCache* pCache = GetThreadCache();
+
+  if (pCache == nullptr)
+  {
+    DeallocateUncached(pFreeBlock, header.m_uiSizeClass);
+    return;
+  }
+
+  pFreeBlock->m_pNext = pCache->m_pFirst[header.m_uiSizeClass];
+  pCache->m_pFirst[header.m_uiSizeClass] = pFreeBlock;
+
+  if (++pCache->m_uiCount[header.m_uiSizeClass] > MaxCachedBlocks)
+  {
+    ReturnBlocks(*pCache, header.m_uiSizeClass, BatchSize);
+  }
+}
+
+nsTaskAllocatorStats nsAllocPolicyTaskPool::GetPoolStats() const
+{
+  nsTaskAllocatorStats stats;
+  stats.m_uiNumLargeAllocations = static_cast<nsUInt64>(static_cast<nsInt64>(m_iNumLargeAllocations));
+
+  NS_LOCK(m_Mutex);
+  stats.m_uiNumSlabAllocations = m_uiNumSlabAllocations;
+  stats.m_uiReservedMemory = m_uiNumSlabAllocations * SlabSize;
+  return stats;
+}
+
+nsAllocPolicyTaskPool::ThreadCache* nsAllocPolicyTaskPool::GetThreadCache()
+{
+  if (m_uiCacheGeneration == 0)
+    return nullptr;
+
+  ThreadCacheSlots& slots = GetThreadCacheSlots();
+
+  if (slots.m_uiGenerations[m_uiCacheSlot] == m_uiCacheGeneration)
+    return &slots.m_Caches[m_uiCacheSlot];
+
+  return CreateThreadCache(slots);
+}
+
+nsAllocPolicyTaskPool::ThreadCache* nsAllocPolicyTaskPool::CreateThreadCache(ThreadCacheSlots& ref_slots)
+{
+  if (ref_slots.m_bThreadExited)
+    return nullptr;
+
+  // returns the thread's blocks to their pools when the thread exits
+  static thread_local ThreadCacheFlusher s_Flusher;
+  NS_IGNORE_UNUSED(s_Flusher);
+
+  // blocks that are still in the slot belonged to a destroyed pool, their memory is gone already
+  ThreadCache& cache = ref_slots.m_Caches[m_uiCacheSlot];
+  nsMemoryUtils::ZeroFillArray(cache.m_pFirst);
+  nsMemoryUtils::ZeroFillArray(cache.m_uiCount);
+
+  ref_slots.m_uiGenerations[m_uiCacheSlot] = m_uiCacheGeneration;
+  return &cache;
+}
+
+void nsAllocPolicyTaskPool::RefillThreadCache(ThreadCache& ref_cache, nsUInt32 uiSizeClass)
+{
+  NS_LOCK(m_Mutex);
+
+  SharedFreeList& shared = m_SharedFreeLists[uiSizeClass];
+
+  if (shared.m_pFirst == nullptr)
+  {
+    Grow(uiSizeClass);
+  }
+
+  for (nsUInt32 i = 0; i < BatchSize && shared.m_pFirst != nullptr; ++i)
+  {
+    FreeBlock* pBlock = shared.m_pFirst;
+    shared.m_pFirst = pBlock->m_pNext;
+    --shared.m_uiCount;
+
+    pBlock->m_pNext = ref_cache.m_pFirst[uiSizeClass];
+    ref_cache.m_pFirst[uiSizeClass] = pBlock;
+    ++ref_cache.m_uiCount[uiSizeClass];
+  }
+}
+
+void nsAllocPolicyTaskPool::ReturnBlocks(ThreadCache& ref_cache, nsUInt32 uiSizeClass, nsUInt32 uiNumBlocks)
+{
+  if (uiNumBlocks == 0)
+    return;
+
+  NS_LOCK(m_Mutex);
+
+  SharedFreeList& shared = m_SharedFreeLists[uiSizeClass];
+
+  for (nsUInt32 i = 0; i < uiNumBlocks; ++i)
+  {
+    FreeBlock* pBlock = ref_cache.m_pFirst[uiSizeClass];
+    ref_cache.m_pFirst[uiSizeClass] = pBlock->m_pNext;
+    --ref_cache.m_uiCount[uiSizeClass];
+
+    pBlock->m_pNext = shared.m_pFirst;
+    shared.m_pFirst = pBlock;
+    ++shared.m_uiCount;
+  }
+}
+
+void nsAllocPolicyTaskPool::ReturnAllBlocks(ThreadCache& ref_cache)
+{
+  for (nsUInt32 uiSizeClass = 0; uiSizeClass < NumSizeClasses; ++uiSizeClass)
+  {
+    ReturnBlocks(ref_cache, uiSizeClass, ref_cache.m_uiCount[uiSizeClass]);
+  }
+}
+
+nsAllocPolicyTaskPool::FreeBlock* nsAllocPolicyTaskPool::AllocateUncached(nsUInt32 uiSizeClass)
+{
+  NS_LOCK(m_Mutex);
+
+  SharedFreeList& shared = m_SharedFreeLists[uiSizeClass];
+
+  if (shared.m_pFirst == nullptr)
+  {
+    Grow(uiSizeClass);
+  }
+
+  FreeBlock* pBlock = shared.m_pFirst;
+  shared.m_pFirst = pBlock->m_pNext;
+  --shared.m_uiCount;
+  return pBlock;
+}
+
+void nsAllocPolicyTaskPool::DeallocateUncached(FreeBlock* pBlock, nsUInt32 uiSizeClass)
+{
+  NS_LOCK(m_Mutex);
+
+  SharedFreeList& shared = m_SharedFreeLists[uiSizeClass];
+  pBlock->m_pNext = shared.m_pFirst;
+  shared.m_pFirst = pBlock;
+  ++shared.m_uiCount;
+}
+
+void nsAllocPolicyTaskPool::Grow(nsUInt32 uiSizeClass)
+{
+  SharedFreeList& shared = m_SharedFreeLists[uiSizeClass];
+
+  // cut a new slab into blocks
+  const nsUInt32 uiBlockSize = SmallestBlockSize << uiSizeClass;
+  nsUInt8* pSlab = static_cast<nsUInt8*>(m_pParent->Allocate(SlabSize, s_uiBlockPrefix));
+  m_Slabs.PushBack(pSlab);
+  ++m_uiNumSlabAllocations;
+
+  for (nsUInt32 uiOffset = 0; uiOffset + uiBlockSize <= SlabSize; uiOffset += uiBlockSize)
+  {
+    FreeBlock* pBlock = reinterpret_cast<FreeBlock*>(pSlab + uiOffset);
+    pBlock->m_pNext = shared.m_pFirst;
+    shared.m_pFirst = pBlock;
+    ++shared.m_uiCount;
+  }
+}
+
+NS_STATICLINK_FILE(Foundation, Foundation_Threading_Implementation_TaskAllocator);
@@ -0,0 +1,103 @@
+#pragma once
+
+#include <Foundation/Containers/HybridArray.h>
+#include <Foundation/Memory/AllocatorWithPolicy.h>
+#include <Foundation/Threading/Implementation/TaskSystemDeclarations.h>
+#include <Foundation/Threading/Mutex.h>
+
+/// \internal Allocation policy that recycles the memory of task objects.
+///
+/// Requests are rounded up to a few block sizes. Every thread keeps a small cache of free blocks per size, so allocating and freeing
+/// a task usually touches neither a lock nor the parent allocator. When a thread's cache runs empty or overflows, it exchanges a batch
+/// of blocks with a shared pool, which only allocates new memory (in large slabs) from the parent allocator when it runs empty as well.
+/// Since tasks are typically created on one thread and released on another, blocks migrate between the caches through the shared pool.
+///
+/// Each pool instance gets its own slot in a thread local table of caches, so a thread can use several pools without them evicting each
+/// other's caches. Only the owning thread ever touches its caches. When a thread exits, the blocks in its caches are returned to the
+/// shared pools. If all slots are taken, or the thread is already exiting, the pool falls back to the shared lists.
+///
+/// Requests that are too large or need a large alignment are forwarded to the parent allocator, which therefore has to support
+/// alignments of at least 16 bytes (e.g. nsAlignedHeapAllocator).
+/// Slabs are only freed when the policy is destroyed, so all tasks that use it must be released before that.
+class NS_FOUNDATION_DLL nsAllocPolicyTaskPool
+{
+public:
+  nsAllocPolicyTaskPool(nsAllocator* pParent);
+  ~nsAllocPolicyTaskPool();
+
+  void* Allocate(size_t uiSize, size_t uiAlign);
+  void Deallocate(void* pPtr);
+
+  nsAllocator* GetParent() const { return m_pParent; }
+
+  nsTaskAllocatorStats GetPoolStats() const;
+
+private:
+  static constexpr nsUInt32 NumSizeClasses = 5;
+  static constexpr nsUInt32 SmallestBlockSize = 128;
+  static constexpr nsUInt32 SlabSize = 64 * 1024;
+  static constexpr nsUInt32 BatchSize = 16;
+  static constexpr nsUInt32 MaxCachedBlocks = 4 * BatchSize;
+
+  struct ThreadCache;
+  struct ThreadCacheSlots;
+  struct ThreadCacheFlusher;
+  struct CacheSlotTable;
+
+  struct FreeBlock
+  {
+    FreeBlock* m_pNext;
+  };
+
+  struct SharedFreeList
+  {
+    FreeBlock* m_pFirst = nullptr;
+    nsUInt32 m_uiCount = 0;
+  };
+
+  /// \brief The thread local table of caches, one entry per pool that got a slot, see m_uiCacheSlot.
+  static ThreadCacheSlots& GetThreadCacheSlots();
+
+  /// \brief The global table that tells which pool owns which slot.
+  static CacheSlotTable& GetCacheSlotTable();
+
+  /// \brief Returns the calling thread's cache for this pool, or nullptr if it can't have one.
+  ThreadCache* GetThreadCache();
+  ThreadCache* CreateThreadCache(ThreadCacheSlots& ref_slots);
+
+  void RefillThreadCache(ThreadCache& ref_cache, nsUInt32 uiSizeClass);
+  void ReturnBlocks(ThreadCache& ref_cache, nsUInt32 uiSizeClass, nsUInt32 uiNumBlocks);
+  void ReturnAllBlocks(ThreadCache& ref_cache);
+
+  /// \brief Takes a single block from the shared list, used when the thread has no cache.
+  FreeBlock* AllocateUncached(nsUInt32 uiSizeClass);
+  void DeallocateUncached(FreeBlock* pBlock, nsUInt32 uiSizeClass);
+
+  /// \brief Cuts a new slab into blocks of the given size class, m_Mutex must be locked.
+  void Grow(nsUInt32 uiSizeClass);
+
+  nsAllocator* m_pParent = nullptr;
+
+  // which entry of the thread local cache table belongs to this pool, see GetThreadCache()
+  nsUInt32 m_uiCacheSlot = 0;
+  nsUInt32 m_uiCacheGeneration = 0;
+
+  mutable nsMutex m_Mutex;
+  SharedFreeList m_SharedFreeLists[NumSizeClasses];
+  nsHybridArray<void*, 16> m_Slabs;
+  nsUInt64 m_uiNumSlabAllocations = 0;
+
+  nsAtomicInteger64 m_iNumLargeAllocations;
+};
+
+/// \internal The allocator that nsTaskSystem::GetTaskAllocator() returns.
+class nsTaskAllocator : public nsAllocatorWithPolicy<nsAllocPolicyTaskPool, nsAllocatorTrackingMode::Basics>
+{
+public:
+  nsTaskAllocator(nsStringView sName, nsAllocator* pParent)
+    : nsAllocatorWithPolicy<nsAllocPolicyTaskPool, nsAllocatorTrackingMode::Basics>(sName, pParent)
+  {
+  }
+
+  nsTaskAllocatorStats GetPoolStats() const { return m_allocator.GetPoolStats(); }
+};
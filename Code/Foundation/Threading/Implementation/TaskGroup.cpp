@@ -22,6 +22,9 @@ void nsTaskGroup::WaitForFinish(nsTaskGroupID group) const
 
 void nsTaskGroup::Reuse(nsTaskPriority::Enum priority, nsOnTaskGroupFinishedCallback callback)
 {
+  // nsTaskSystem::WriteStateSnapshotToDGML() reads the groups while holding this lock
+  NS_LOCK(m_CondVarGroupFinished);
+
   m_bInUse = true;
   m_bStartedByUser = false;
   m_uiGroupCounter += 2; // even if it wraps around, it will never be zero, thus zero stays an invalid group counter
@@ -29,6 +32,7 @@ void nsTaskGroup::Reuse(nsTaskPriority::Enum priority, nsOnTaskGroupFinishedCall
   m_DependsOnGroups.Clear();
   m_OthersDependingOnMe.Clear();
   m_Priority = priority;
+  m_pTaskGraph = nullptr;
   m_OnFinishedCallback = callback;
 }
 
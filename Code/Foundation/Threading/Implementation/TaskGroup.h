@@ -17,6 +17,7 @@ public:
 
 private:
   friend class nsTaskSystem;
+  friend class nsTaskSystemState;
 
 #if NS_ENABLED(NS_COMPILE_FOR_DEBUG)
   static void DebugCheckTaskGroup(nsTaskGroupID groupID, nsMutex& mutex);
@@ -34,7 +35,8 @@ private:
 
   bool m_bInUse = true;
   bool m_bStartedByUser = false;
-  nsUInt16 m_uiTaskGroupIndex = 0xFFFF; // only there as a debugging aid
+  nsUInt32 m_uiTaskGroupIndex = 0xFFFFFFFF;
+  nsUInt32 m_uiNextFreeGroup = 0; // index + 1 of the next group on the free list, see nsTaskSystemState::m_iFreeTaskGroups
   nsUInt32 m_uiGroupCounter = 1;
   nsHybridArray<nsSharedPtr<nsTask>, 16> m_Tasks;
   nsHybridArray<nsTaskGroupID, 4> m_DependsOnGroups;
@@ -43,5 +45,6 @@ private:
   nsAtomicInteger32 m_iNumRemainingTasks;
   nsOnTaskGroupFinishedCallback m_OnFinishedCallback;
   nsTaskPriority::Enum m_Priority = nsTaskPriority::ThisFrame;
+  nsTaskGraph* m_pTaskGraph = nullptr; // set while the group represents the execution of a task graph, its tasks are not in m_Tasks
   mutable nsConditionVariable m_CondVarGroupFinished;
 };
@@ -0,0 +1,191 @@
+#include <Foundation/FoundationPCH.h>
+
+#include <Foundation/Threading/Implementation/TaskQueue.h>
+
+// the number of entries of the first buffer that a queue allocates, must be a power of two
+static constexpr nsInt64 s_iInitialQueueSize = 32;
+
+nsTaskQueue::nsTaskQueue() = default;
+
+nsTaskQueue::~nsTaskQueue()
+{
+  if (Buffer* pBuffer = m_pBuffer)
+  {
+    const nsInt64 iBottom = m_iBottom;
+
+    for (nsInt64 i = m_iTop; i < iBottom; ++i)
+    {
+      nsMemoryUtils::Destruct(&pBuffer->m_pEntries[i & pBuffer->m_iMask], 1);
+    }
+
+    m_RetiredBuffers.PushBack(pBuffer);
+  }
+
+  for (Buffer* pBuffer : m_RetiredBuffers)
+  {
+    NS_DEFAULT_DELETE_RAW_BUFFER(pBuffer->m_pEntries);
+    NS_DEFAULT_DELETE(pBuffer);
+  }
+}
+
+void nsTaskQueue::PushBottom(TaskData&& entry)
+{
+  const nsInt64 iBottom = m_iBottom;
+  const nsInt64 iTop = m_iTop;
+  Buffer* pBuffer = m_pBuffer;
+
+  if (pBuffer == nullptr || iBottom - iTop > pBuffer->m_iMask)
+  {
+    pBuffer = Grow(pBuffer, iTop, iBottom);
+  }
+
+  // relocate the entry into the buffer and leave an empty entry behind
+  nsMemoryUtils::RawByteCopy(&pBuffer->m_pEntries[iBottom & pBuffer->m_iMask], &entry, sizeof(TaskData));
+  new (&entry) TaskData();
+
+  // publishes the entry to the thieves
+  m_iBottom = iBottom + 1;
+}
+
+bool nsTaskQueue::PopBottom(TaskData& out_entry, Filter filter, const void* pUserData)
+{
+  NS_ASSERT_DEBUG(out_entry.m_pTask == nullptr, "The output entry must be empty");
+
+  Buffer* pBuffer = m_pBuffer;
+  if (pBuffer == nullptr)
+    return false;
+
+  // reserve the bottom entry first, then check whether a thief got there already
+  const nsInt64 iBottom = m_iBottom - 1;
+  m_iBottom = iBottom;
+  const nsInt64 iTop = m_iTop;
+
+  if (iTop > iBottom)
+  {
+    m_iBottom = iBottom + 1;
+    return false;
+  }
+
+  TaskData& entry = pBuffer->m_pEntries[iBottom & pBuffer->m_iMask];
+
+  if (filter != nullptr && !filter(entry, pUserData))
+  {
+    m_iBottom = iBottom + 1;
+    return false;
+  }
+
+  if (iTop == iBottom)
+  {
+    // this is the last entry, thieves may try to take it as well
+    const bool bWon = m_iTop.TestAndSet(iTop, iTop + 1);
+    m_iBottom = iBottom + 1;
+
+    if (!bWon)
+      return false;
+  }
+
+  nsMemoryUtils::RawByteCopy(&out_entry, &entry, sizeof(TaskData));
+  return true;
+}
+
+bool nsTaskQueue::StealTop(TaskData& out_entry, Filter filter, const void* pUserData)
+{
+  NS_ASSERT_DEBUG(out_entry.m_pTask == nullptr, "The output entry must be empty");
+
+  const nsInt64 iTop = m_iTop;
+  const nsInt64 iBottom = m_iBottom;
+
+  if (iTop >= iBottom)
+    return false;
+
+  Buffer* pBuffer = m_pBuffer;
+
+  // the entry only becomes ours once the top index has been advanced, until then it may be taken or overwritten by someone else
+  // so work on a bitwise copy and never destruct it
+  alignas(TaskData) nsUInt8 candidate[sizeof(TaskData)];
+  nsMemoryUtils::RawByteCopy(candidate, &pBuffer->m_pEntries[iTop & pBuffer->m_iMask], sizeof(TaskData));
+
+  if (filter != nullptr && !filter(*reinterpret_cast<const TaskData*>(candidate), pUserData))
+    return false;
+
+  if (!m_iTop.TestAndSet(iTop, iTop + 1))
+    return false;
+
+  nsMemoryUtils::RawByteCopy(&out_entry, candidate, sizeof(TaskData));
+  return true;
+}
+
+bool nsTaskQueue::IsEmpty() const
+{
+  return m_iTop >= m_iBottom;
+}
+
+nsTaskQueue::Buffer* nsTaskQueue::Grow(Buffer* pOld, nsInt64 iTop, nsInt64 iBottom)
+{
+  const nsInt64 iNewSize = (pOld != nullptr) ? (pOld->m_iMask + 1) * 2 : s_iInitialQueueSize;
+
+  Buffer* pNew = NS_DEFAULT_NEW(Buffer);
+  pNew->m_iMask = iNewSize - 1;
+  pNew->m_pEntries = NS_DEFAULT_NEW_RAW_BUFFER(TaskData, static_cast<size_t>(iNewSize));
+
+  // thieves may still copy entries out of the old buffer, so it is left untouched and only freed in the destructor
+  for (nsInt64 i = iTop; i < iBottom; ++i)
+  {
+    nsMemoryUtils::RawByteCopy(&pNew->m_pEntries[i & pNew->m_iMask], &pOld->m_pEntries[i & pOld->m_iMask], sizeof(TaskData));
+  }
+
+  if (pOld != nullptr)
+  {
+    m_RetiredBuffers.PushBack(pOld);
+  }
+
+  NS_VERIFY(nsAtomicUtils::TestAndSet(reinterpret_cast<void**>(const_cast<Buffer**>(&m_pBuffer)), pOld, pNew), "Only the owner may grow the queue");
+  return pNew;
+}
+
+//////////////////////////////////////////////////////////////////////////
+
+nsUInt32 nsTaskQueueLevel::FromFrameSlot(nsUInt32 uiFrame, nsInt32 iFrameOffset, nsUInt32 uiSubLevel)
+{
+  const nsUInt32 uiSlot = (uiFrame + static_cast<nsUInt32>(iFrameOffset)) % FrameSlots;
+  return uiSlot * SubLevelsPerFrame + uiSubLevel;
+}
+
+nsUInt32 nsTaskQueueLevel::FromPriority(nsTaskPriority::Enum priority, nsUInt32 uiFrame)
+{
+  if (priority <= nsTaskPriority::LateNextFrame)
+  {
+    // EarlyThisFrame to LateNextFrame: two frames with three sub-levels each
+    const nsUInt32 uiPriority = static_cast<nsUInt32>(priority);
+    return FromFrameSlot(uiFrame, static_cast<nsInt32>(uiPriority / SubLevelsPerFrame), uiPriority % SubLevelsPerFrame);
+  }
+
+  if (priority <= nsTaskPriority::In9Frames)
+  {
+    // 'In2Frames' becomes 'LateNextFrame' in the next frame
+    const nsInt32 iFrameOffset = 2 + (priority - nsTaskPriority::In2Frames);
+    return FromFrameSlot(uiFrame, iFrameOffset, SubLevelsPerFrame - 1);
+  }
+
+  return FirstFixedLevel + (priority - nsTaskPriority::LongRunningHighPriority);
+}
+
+void nsTaskQueueLevel::GetLevelsToSearch(nsTaskPriority::Enum first, nsTaskPriority::Enum last, nsUInt32 uiFrame, nsHybridArray<nsUInt32, 64>& out_levels)
+{
+  for (nsUInt32 prio = first; prio <= static_cast<nsUInt32>(last); ++prio)
+  {
+    if (prio == nsTaskPriority::EarlyThisFrame)
+    {
+      // left-over tasks from previous frames come first, oldest first
+      for (nsInt32 iFrameOffset = -static_cast<nsInt32>(OverdueFrameSlots); iFrameOffset < 0; ++iFrameOffset)
+      {
+        for (nsUInt32 uiSubLevel = 0; uiSubLevel < SubLevelsPerFrame; ++uiSubLevel)
+        {
+          out_levels.PushBack(FromFrameSlot(uiFrame, iFrameOffset, uiSubLevel));
+        }
+      }
+    }
+
+    out_levels.PushBack(FromPriority(static_cast<nsTaskPriority::Enum>(prio), uiFrame));
+  }
+}
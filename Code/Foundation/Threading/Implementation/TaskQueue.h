@@ -0,0 +1,97 @@
+#pragma once
+
+#include <Foundation/Containers/HybridArray.h>
+#include <Foundation/Threading/TaskSystem.h>
+
+/// \internal Lock-free work-stealing deque (Chase-Lev) that stores scheduled task invocations.
+///
+/// Exactly one thread (the owner) may call PushBottom() and PopBottom(). Any number of threads may call StealTop() concurrently,
+/// including the owner itself. The owner works LIFO on its own tasks, whereas thieves take the oldest entries from the other end.
+///
+/// Entries are relocated bitwise in and out of the ring buffer, nsTaskSystem::TaskData only holds memory-relocatable members.
+/// When the ring buffer runs full, the owner switches to a buffer of twice the size. Old buffers are kept alive until the queue is
+/// destroyed, because thieves may still read from them.
+class nsTaskQueue
+{
+  NS_DISALLOW_COPY_AND_ASSIGN(nsTaskQueue);
+
+public:
+  using TaskData = nsTaskSystem::TaskData;
+
+  /// \brief Decides whether an entry may be taken. Thieves call this on a copy that may be outdated by the time the function runs,
+  /// so it must only look at the inline members of TaskData and must not dereference the task pointer.
+  using Filter = bool (*)(const TaskData& entry, const void* pUserData);
+
+  nsTaskQueue();
+  ~nsTaskQueue();
+
+  /// \brief [owner only] Appends an entry at the owner's end of the queue.
+  void PushBottom(TaskData&& entry);
+
+  /// \brief [owner only] Takes the most recently pushed entry, if it passes the filter. \a out_entry must be empty.
+  bool PopBottom(TaskData& out_entry, Filter filter, const void* pUserData);
+
+  /// \brief [any thread] Takes the oldest entry, if it passes the filter. \a out_entry must be empty.
+  ///
+  /// Returns false when the queue is empty, when the oldest entry is rejected by the filter or when another thread was faster.
+  bool StealTop(TaskData& out_entry, Filter filter, const void* pUserData);
+
+  /// \brief Returns whether the queue currently holds no entries. Only a hint, unless no other thread accesses the queue.
+  bool IsEmpty() const;
+
+private:
+  struct Buffer
+  {
+    nsInt64 m_iMask = 0;
+    TaskData* m_pEntries = nullptr;
+  };
+
+  Buffer* Grow(Buffer* pOld, nsInt64 iTop, nsInt64 iBottom);
+
+  alignas(64) nsAtomicInteger64 m_iTop;
+  alignas(64) nsAtomicInteger64 m_iBottom;
+  Buffer* volatile m_pBuffer = nullptr;
+
+  // only accessed by the owner
+  nsHybridArray<Buffer*, 2> m_RetiredBuffers;
+};
+
+/// \internal Maps task priorities to the individual queues of an nsTaskQueueSet.
+///
+/// The frame-relative priorities (EarlyThisFrame to In9Frames) are stored in a ring of frame slots, each with an 'early', a 'normal'
+/// and a 'late' queue. Advancing the frame (see nsTaskSystem::ReprioritizeFrameTasks()) turns all 'next frame' queues into
+/// 'this frame' queues at once, without touching any of the queued tasks. Slots of frames that have already passed are 'overdue'
+/// and get searched before all others, just like left-over tasks used to be moved into the 'EarlyThisFrame' list.
+struct nsTaskQueueLevel
+{
+  enum : nsUInt32
+  {
+    MaxFrameOffset = nsTaskPriority::In9Frames - nsTaskPriority::LateNextFrame + 1,
+    FrameSlots = 16,
+    OverdueFrameSlots = FrameSlots - MaxFrameOffset - 1,
+    SubLevelsPerFrame = 3,
+    FirstFixedLevel = FrameSlots * SubLevelsPerFrame,
+    Count = FirstFixedLevel + nsTaskPriority::ENUM_COUNT - nsTaskPriority::LongRunningHighPriority,
+  };
+
+  /// \brief Returns the queue level that tasks with the given priority are pushed into, while \a uiFrame is the current frame.
+  static nsUInt32 FromPriority(nsTaskPriority::Enum priority, nsUInt32 uiFrame);
+
+  /// \brief Returns the queue level for the given sub-level (early, normal, late) of the frame that is \a iFrameOffset frames away from \a uiFrame.
+  static nsUInt32 FromFrameSlot(nsUInt32 uiFrame, nsInt32 iFrameOffset, nsUInt32 uiSubLevel);
+
+  /// \brief Appends all queue levels that have to be searched for tasks of priority \a first to \a last, in the order of importance.
+  static void GetLevelsToSearch(nsTaskPriority::Enum first, nsTaskPriority::Enum last, nsUInt32 uiFrame, nsHybridArray<nsUInt32, 64>& out_levels);
+};
+
+/// \internal One work-stealing queue per queue level. The main thread and every task worker thread own one such set.
+///
+/// The queues are cache-line aligned, so the sets have to be allocated with an aligned allocator.
+class nsTaskQueueSet
+{
+public:
+  nsTaskQueue m_Queues[nsTaskQueueLevel::Count];
+
+  // The cache domain of the processor that the owning thread is pinned to, -1 if it is not pinned. Used to pick whom to steal from first.
+  nsAtomicInteger32 m_iCacheDomain = -1;
+};
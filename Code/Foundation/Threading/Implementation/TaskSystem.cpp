@@ -34,13 +34,30 @@ NS_BEGIN_SUBSYSTEM_DECLARATION(Foundation, TaskSystem)
 NS_END_SUBSYSTEM_DECLARATION;
 // clang-format on
 
+nsTaskSystemState::~nsTaskSystemState()
+{
+  for (nsUInt32 uiBlock = 0; uiBlock < MaxTaskGroupBlocks && m_TaskGroupBlocks[uiBlock] != nullptr; ++uiBlock)
+  {
+    nsArrayPtr<nsTaskGroup> groups(m_TaskGroupBlocks[uiBlock], TaskGroupsPerBlock);
+    NS_DEFAULT_DELETE_ARRAY(groups);
+  }
+}
+
 void nsTaskSystem::Startup()
 {
   s_pThreadState = NS_DEFAULT_NEW(nsTaskSystemThreadState);
-  s_pState = NS_DEFAULT_NEW(nsTaskSystemState);
+  s_pState = NS_NEW(&s_pThreadState->m_Allocator, nsTaskSystemState);
+
+  // the injection queues and the main thread's queues are always the first two queue sets
+  s_pThreadState->m_pInjectionQueues = NS_NEW(&s_pThreadState->m_Allocator, nsTaskQueueSet);
+  s_pThreadState->m_pMainThreadQueues = NS_NEW(&s_pThreadState->m_Allocator, nsTaskQueueSet);
+  s_pThreadState->m_QueueSets[0] = s_pThreadState->m_pInjectionQueues;
+  s_pThreadState->m_QueueSets[1] = s_pThreadState->m_pMainThreadQueues;
+  s_pThreadState->m_iNumQueueSets = 2;
 
   tl_TaskWorkerInfo.m_WorkerType = nsWorkerThreadType::MainThread;
   tl_TaskWorkerInfo.m_iWorkerIndex = 0;
+  tl_TaskWorkerInfo.m_pQueues = s_pThreadState->m_pMainThreadQueues;
 
   // initialize with the default number of worker threads
   SetWorkerThreadCount();
@@ -53,6 +70,14 @@ void nsTaskSystem::Shutdown()
 
   StopWorkerThreads();
 
+  tl_TaskWorkerInfo.m_pQueues = nullptr;
+
+  // this also deallocates all tasks that are still queued
+  for (nsUInt32 i = 0; i < (nsUInt32)s_pThreadState->m_iNumQueueSets; ++i)
+  {
+    NS_DELETE(&s_pThreadState->m_Allocator, s_pThreadState->m_QueueSets[i]);
+  }
+
   s_pState.Clear();
   s_pThreadState.Clear();
 }
@@ -62,4 +87,20 @@ void nsTaskSystem::SetTargetFrameTime(nsTime targetFrameTime)
   s_pState->m_TargetFrameTime = targetFrameTime;
 }
 
+nsAllocator* nsTaskSystem::GetTaskAllocator()
+{
+  if (s_pThreadState == nullptr)
+    return nsFoundation::GetDefaultAllocator();
+
+  return &s_pThreadState->m_TaskAllocator;
+}
+
+nsTaskAllocatorStats nsTaskSystem::GetTaskAllocatorStats()
+{
+  if (s_pThreadState == nullptr)
+    return nsTaskAllocatorStats();
+
+  return s_pThreadState->m_TaskAllocator.GetPoolStats();
+}
+
 NS_STATICLINK_FILE(Foundation, Foundation_Threading_Implementation_TaskSystem);
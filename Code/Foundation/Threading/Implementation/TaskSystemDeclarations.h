@@ -1,6 +1,7 @@
 #pragma once
 
 #include <Foundation/Containers/HybridArray.h>
+#include <Foundation/Threading/AtomicInteger.h>
 #include <Foundation/Threading/ConditionVariable.h>
 #include <Foundation/Time/Time.h>
 #include <Foundation/Types/Delegate.h>
@@ -9,6 +10,7 @@
 
 class nsTask;
 class nsTaskGroup;
+class nsTaskGraph;
 class nsTaskWorkerThread;
 class nsTaskSystemState;
 class nsTaskSystemThreadState;
@@ -70,6 +72,8 @@ struct nsTaskPriority
     ENUM_COUNT
   };
   // clang-format on
+
+  static const char* GetPriorityName(nsTaskPriority::Enum priority);
 };
 
 /// \brief Enum that describes what to do when waiting for or canceling tasks, that have already started execution.
@@ -162,6 +166,19 @@ enum class nsTaskNesting
   Never,
 };
 
+/// \brief Describes how nsTaskSystem::ParallelFor distributes the items among its task invocations.
+enum class nsParallelForSplitting
+{
+  /// Every task invocation gets an equally sized range of items up front, see nsParallelForParams::DetermineThreading().
+  /// Has the least overhead, if all items take about the same amount of time.
+  Static,
+
+  /// The task invocations repeatedly claim chunks of items from a shared cursor, until all items are taken.
+  /// Each chunk is a share of the remaining items, so the chunks get smaller towards the end of the range.
+  /// Keeps all threads busy until the end, if the items take vastly different amounts of time.
+  Adaptive,
+};
+
 /// \brief Settings for nsTaskSystem::ParallelFor invocations.
 struct NS_FOUNDATION_DLL nsParallelForParams
 {
@@ -182,12 +199,84 @@ struct NS_FOUNDATION_DLL nsParallelForParams
 
   nsTaskNesting m_NestingMode = nsTaskNesting::Never;
 
-  /// The allocator used to for the tasks that the parallel-for uses internally. If null, will use the default allocator.
+  /// How the items are distributed among the tasks. With nsParallelForSplitting::Adaptive, m_uiBinSize is the smallest chunk
+  /// that a task claims at once and m_uiMaxTasksPerThread is ignored.
+  nsParallelForSplitting m_Splitting = nsParallelForSplitting::Static;
+
+  /// The allocator used to for the tasks that the parallel-for uses internally. If null, will use nsTaskSystem::GetTaskAllocator().
   nsAllocator* m_pTaskAllocator = nullptr;
 
+  /// \brief Computes the multiplicity of the task and the number of items per task invocation.
+  ///
+  /// For nsParallelForSplitting::Adaptive, out_uiNumItemsPerTask is the smallest chunk size instead.
   void DetermineThreading(nsUInt64 uiNumItemsToExecute, nsUInt32& out_uiNumTasksToRun, nsUInt64& out_uiNumItemsPerTask) const;
 };
 
+/// \brief Counters of the allocator that the task system uses for task objects, see nsTaskSystem::GetTaskAllocator().
+///
+/// The pool only requests memory from its parent allocator when it grows, so in a steady state these values stay constant from frame to frame.
+struct nsTaskAllocatorStats
+{
+  nsUInt64 m_uiNumSlabAllocations = 0;  ///< How often the pool had to request a new slab of memory for small task objects.
+  nsUInt64 m_uiNumLargeAllocations = 0; ///< How many task objects were too large for the pool and were forwarded to the parent allocator.
+  nsUInt64 m_uiReservedMemory = 0;      ///< The size of all slabs in bytes.
+};
+
+/// \brief Counters of the tasks that had a deadline, see nsTask::SetDeadline() and nsTaskSystem::GetTaskDeadlineStats().
+///
+/// The counters only ever grow, comparing them between two frames shows how many deadlines were missed in between.
+struct nsTaskDeadlineStats
+{
+  nsUInt64 m_uiNumExecuted = 0; ///< How many runs of tasks with a deadline were executed. Canceled runs are not counted.
+  nsUInt64 m_uiNumMissed = 0;   ///< How many of those runs finished after the deadline of their task.
+};
+
+/// \brief Hands out consecutive chunks of an index range to the invocations of an adaptive parallel-for.
+///
+/// Every claim takes a fraction of the items that are still left, but at least the minimum chunk size.
+/// Thus the first chunks are large (little overhead) and the last ones are small, so that no thread is left with a big piece of work
+/// while the others already ran out of items.
+class nsParallelForRangeCursor
+{
+public:
+  nsParallelForRangeCursor(nsUInt64 uiNumItems, nsUInt64 uiMinChunkSize, nsUInt32 uiNumInvocations)
+    : m_uiNumItems(uiNumItems)
+    , m_uiMinChunkSize(nsMath::Max<nsUInt64>(uiMinChunkSize, 1))
+    , m_uiDivisor(nsMath::Max<nsUInt64>(uiNumInvocations, 1) * 2)
+  {
+  }
+
+  /// \brief Claims the next chunk of items. Returns false once all items have been handed out.
+  ///
+  /// The range [out_uiFirst; out_uiEnd) is relative to the start of the whole range.
+  bool ClaimChunk(nsUInt64& out_uiFirst, nsUInt64& out_uiEnd)
+  {
+    while (true)
+    {
+      const nsUInt64 uiFirst = static_cast<nsUInt64>(static_cast<nsInt64>(m_iNextItem));
+
+      if (uiFirst >= m_uiNumItems)
+        return false;
+
+      const nsUInt64 uiRemaining = m_uiNumItems - uiFirst;
+      const nsUInt64 uiChunkSize = nsMath::Min(uiRemaining, nsMath::Max(m_uiMinChunkSize, uiRemaining / m_uiDivisor));
+
+      if (m_iNextItem.TestAndSet(static_cast<nsInt64>(uiFirst), static_cast<nsInt64>(uiFirst + uiChunkSize)))
+      {
+        out_uiFirst = uiFirst;
+        out_uiEnd = uiFirst + uiChunkSize;
+        return true;
+      }
+    }
+  }
+
+private:
+  nsAtomicInteger64 m_iNextItem;
+  const nsUInt64 m_uiNumItems;
+  const nsUInt64 m_uiMinChunkSize;
+  const nsUInt64 m_uiDivisor;
+};
+
 using nsParallelForIndexedFunction32 = nsDelegate<void(nsUInt32, nsUInt32), 48>;
 using nsParallelForIndexedFunction64 = nsDelegate<void(nsUInt64, nsUInt64), 48>;
 
@@ -200,3 +289,16 @@ enum class nsTaskWorkerState
   Idle = 1,
   Blocked = 2,
 };
+
+/// \brief Where a task worker thread runs, see nsTaskSystem::GetWorkerThreadPlacement().
+///
+/// All values are -1 for threads that are not pinned to a logical processor. The indices refer to nsCpuTopology.
+struct nsTaskWorkerPlacement
+{
+  nsInt32 m_iProcessorIndex = -1;
+  nsInt32 m_iCore = -1;
+  nsInt32 m_iCacheDomain = -1;
+  nsInt32 m_iPackage = -1;
+
+  bool IsPinned() const { return m_iProcessorIndex >= 0; }
+};
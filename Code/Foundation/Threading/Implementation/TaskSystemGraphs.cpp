@@ -0,0 +1,286 @@
+#include <Foundation/FoundationPCH.h>
+
+#include <Foundation/Containers/HashSet.h>
+#include <Foundation/Logging/Log.h>
+#include <Foundation/Threading/Implementation/TaskGroup.h>
+#include <Foundation/Threading/Implementation/TaskSystemState.h>
+#include <Foundation/Threading/TaskGraph.h>
+#include <Foundation/Utilities/DGMLWriter.h>
+
+nsTaskGraph::nsTaskGraph() = default;
+
+nsTaskGraph::~nsTaskGraph()
+{
+  NS_ASSERT_DEV(!m_ExecutionID.IsValid() || !IsExecuting(), "A task graph must not be destroyed while it is executing.");
+}
+
+void nsTaskGraph::Clear()
+{
+  NS_ASSERT_DEV(!m_ExecutionID.IsValid() || !IsExecuting(), "A task graph must not be modified while it is executing.");
+
+  m_bFinalized = false;
+  m_Nodes.Clear();
+  m_Dependencies.Clear();
+  m_Successors.Clear();
+  m_RootNodes.Clear();
+}
+
+nsTaskGraph::NodeIndex nsTaskGraph::AddNode(const nsSharedPtr<nsTask>& pTask, nsTaskPriority::Enum priority)
+{
+  NS_ASSERT_DEV(pTask != nullptr, "Cannot add nullptr tasks.");
+  NS_ASSERT_DEV(!pTask->m_sTaskName.IsEmpty(), "Every task should have a name");
+  NS_ASSERT_DEV(priority >= nsTaskPriority::EarlyThisFrame && priority < nsTaskPriority::ENUM_COUNT, "Invalid task priority");
+  NS_ASSERT_DEV(!m_ExecutionID.IsValid() || !IsExecuting(), "A task graph must not be modified while it is executing.");
+
+  m_bFinalized = false;
+
+  Node& node = m_Nodes.ExpandAndGetRef();
+  node.m_pTask = pTask;
+  node.m_Priority = priority;
+
+  return m_Nodes.GetCount() - 1;
+}
+
+void nsTaskGraph::AddDependency(NodeIndex node, NodeIndex dependsOn)
+{
+  NS_ASSERT_DEV(node < m_Nodes.GetCount() && dependsOn < m_Nodes.GetCount(), "Invalid node index");
+  NS_ASSERT_DEV(node != dependsOn, "A node cannot depend on itself");
+  NS_ASSERT_DEV(!m_ExecutionID.IsValid() || !IsExecuting(), "A task graph must not be modified while it is executing.");
+
+  m_bFinalized = false;
+  m_Dependencies.PushBack({node, dependsOn});
+}
+
+nsResult nsTaskGraph::Finalize()
+{
+  NS_ASSERT_DEV(!m_ExecutionID.IsValid() || !IsExecuting(), "A task graph must not be modified while it is executing.");
+
+  m_bFinalized = false;
+  m_Successors.Clear();
+  m_RootNodes.Clear();
+
+  {
+    nsHashSet<const nsTask*> tasks;
+    for (const Node& node : m_Nodes)
+    {
+      if (tasks.Insert(node.m_pTask.Borrow()))
+      {
+        nsLog::Error("Task '{}' has been added to the task graph multiple times.", node.m_pTask->m_sTaskName);
+        return NS_FAILURE;
+      }
+    }
+  }
+
+  for (Node& node : m_Nodes)
+  {
+    node.m_uiNumDependencies = 0;
+    node.m_uiNumSuccessors = 0;
+  }
+
+  for (const Dependency& dep : m_Dependencies)
+  {
+    ++m_Nodes[dep.m_Node].m_uiNumDependencies;
+    ++m_Nodes[dep.m_DependsOn].m_uiNumSuccessors;
+  }
+
+  // store the successors of each node in one consecutive range
+  nsDynamicArray<nsUInt32> nextSuccessor;
+  nextSuccessor.SetCountUninitialized(m_Nodes.GetCount());
+
+  nsUInt32 uiFirstSuccessor = 0;
+  for (nsUInt32 i = 0; i < m_Nodes.GetCount(); ++i)
+  {
+    m_Nodes[i].m_uiFirstSuccessor = uiFirstSuccessor;
+    nextSuccessor[i] = uiFirstSuccessor;
+    uiFirstSuccessor += m_Nodes[i].m_uiNumSuccessors;
+
+    if (m_Nodes[i].m_uiNumDependencies == 0)
+    {
+      m_RootNodes.PushBack(i);
+    }
+  }
+
+  m_Successors.SetCountUninitialized(m_Dependencies.GetCount());
+  for (const Dependency& dep : m_Dependencies)
+  {
+    m_Successors[nextSuccessor[dep.m_DependsOn]++] = dep.m_Node;
+  }
+
+  // visit the nodes in the order in which they could be executed, nodes that are part of a cycle are never reached
+  nsDynamicArray<nsUInt32> remainingDependencies;
+  remainingDependencies.SetCountUninitialized(m_Nodes.GetCount());
+  for (nsUInt32 i = 0; i < m_Nodes.GetCount(); ++i)
+  {
+    remainingDependencies[i] = m_Nodes[i].m_uiNumDependencies;
+  }
+
+  nsDynamicArray<nsUInt32> ready = m_RootNodes;
+  nsUInt32 uiNumVisited = 0;
+
+  while (!ready.IsEmpty())
+  {
+    const Node& node = m_Nodes[ready.PeekBack()];
+    ready.PopBack();
+    ++uiNumVisited;
+
+    for (nsUInt32 i = 0; i < node.m_uiNumSuccessors; ++i)
+    {
+      const NodeIndex successor = m_Successors[node.m_uiFirstSuccessor + i];
+
+      if (--remainingDependencies[successor] == 0)
+      {
+        ready.PushBack(successor);
+      }
+    }
+  }
+
+  if (uiNumVisited != m_Nodes.GetCount())
+  {
+    nsLog::Error("The dependencies of the task graph contain a cycle, {} of its {} nodes could never be executed.", m_Nodes.GetCount() - uiNumVisited, m_Nodes.GetCount());
+    return NS_FAILURE;
+  }
+
+  m_bFinalized = true;
+  return NS_SUCCESS;
+}
+
+nsTaskGroupID nsTaskGraph::Execute(nsOnTaskGroupFinishedCallback callback)
+{
+  NS_ASSERT_DEV(m_bFinalized, "The task graph has to be finalized before it can be executed.");
+  NS_ASSERT_DEV(!m_ExecutionID.IsValid() || !IsExecuting(), "The previous execution of the task graph has not finished yet.");
+
+  return nsTaskSystem::ExecuteTaskGraph(*this, callback);
+}
+
+void nsTaskGraph::WriteToDGML(nsDGMLGraph& ref_graph, nsStringView sTitle) const
+{
+  nsDGMLGraph::NodeDesc taskGroupND;
+  taskGroupND.m_Color = nsColor::CornflowerBlue;
+  taskGroupND.m_Shape = nsDGMLGraph::NodeShape::Rectangle;
+
+  nsDGMLGraph::NodeDesc taskNodeND;
+  taskNodeND.m_Color = nsColor::OrangeRed;
+  taskNodeND.m_Shape = nsDGMLGraph::NodeShape::RoundedRectangle;
+
+  const nsDGMLGraph::PropertyId priorityId = ref_graph.AddPropertyType("Priority");
+  const nsDGMLGraph::PropertyId multiplicityId = ref_graph.AddPropertyType("Multiplicity");
+  const nsDGMLGraph::PropertyId dependenciesId = ref_graph.AddPropertyType("Dependencies");
+
+  const nsDGMLGraph::NodeId graphNodeId = ref_graph.AddGroup(sTitle, nsDGMLGraph::GroupType::Expanded, &taskGroupND);
+
+  nsDynamicArray<nsDGMLGraph::NodeId> nodeIds;
+  nodeIds.Reserve(m_Nodes.GetCount());
+
+  for (const Node& node : m_Nodes)
+  {
+    const nsDGMLGraph::NodeId taskNodeId = ref_graph.AddNode(node.m_pTask->m_sTaskName, &taskNodeND);
+    nodeIds.PushBack(taskNodeId);
+
+    ref_graph.AddNodeToGroup(taskNodeId, graphNodeId);
+    ref_graph.AddNodeProperty(taskNodeId, priorityId, nsTaskPriority::GetPriorityName(node.m_Priority));
+    ref_graph.AddNodeProperty(taskNodeId, multiplicityId, nsFmt("{}", node.m_pTask->GetMultiplicity()));
+    ref_graph.AddNodeProperty(taskNodeId, dependenciesId, nsFmt("{}", node.m_uiNumDependencies));
+  }
+
+  for (const Dependency& dep : m_Dependencies)
+  {
+    ref_graph.AddConnection(nodeIds[dep.m_DependsOn], nodeIds[dep.m_Node]);
+  }
+}
+
+nsTaskGroupID nsTaskSystem::ExecuteTaskGraph(nsTaskGraph& ref_graph, nsOnTaskGroupFinishedCallback callback)
+{
+  NS_ASSERT_DEV(s_pThreadState->m_Workers[nsWorkerThreadType::ShortTasks].GetCount() > 0, "No worker threads started.");
+
+  // the whole execution is tracked by a single group, the nodes are scheduled individually instead of through the group's task list
+  const nsTaskGroupID groupID = CreateTaskGroup(nsTaskPriority::ThisFrame, callback);
+  nsTaskGroup* pGroup = groupID.m_pTaskGroup;
+  pGroup->m_pTaskGraph = &ref_graph;
+  pGroup->m_bStartedByUser = true;
+
+  ref_graph.m_ExecutionID = groupID;
+
+  nsInt32 iRemainingRuns = 0;
+
+  for (nsUInt32 i = 0; i < ref_graph.m_Nodes.GetCount(); ++i)
+  {
+    nsTaskGraph::Node& node = ref_graph.m_Nodes[i];
+    nsTask* pTask = node.m_pTask.Borrow();
+
+    NS_ASSERT_DEV(pTask->IsTaskFinished(), "Task '{}' of the task graph has not finished yet, it cannot be reused.", pTask->m_sTaskName);
+
+    pTask->Reset();
+    pTask->m_BelongsToGroup = groupID;
+    pTask->m_uiTaskGraphNode = i;
+
+    node.m_uiNumRuns = nsMath::Max(1u, pTask->m_uiMultiplicity);
+    node.m_iRemainingDependencies = static_cast<nsInt32>(node.m_uiNumDependencies);
+
+    iRemainingRuns += static_cast<nsInt32>(node.m_uiNumRuns);
+  }
+
+  // all runs of all nodes are counted up front, so that the group cannot finish before the last node has been scheduled
+  // plus one, which is only removed below, such that the group cannot finish while the root nodes are still being scheduled
+  pGroup->m_iNumRemainingTasks = iRemainingRuns + 1;
+
+  for (const nsUInt32 uiNode : ref_graph.m_RootNodes)
+  {
+    ScheduleTaskGraphNode(ref_graph, pGroup, uiNode);
+  }
+
+  TaskHasFinished(nullptr, pGroup, 1);
+  return groupID;
+}
+
+void nsTaskSystem::ScheduleTaskGraphNode(nsTaskGraph& ref_graph, nsTaskGroup* pGroup, nsUInt32 uiNode)
+{
+  const nsTaskGraph::Node& node = ref_graph.m_Nodes[uiNode];
+  nsTask* pTask = node.m_pTask.Borrow();
+
+  const nsUInt32 uiGeneration = pTask->m_uiScheduleGeneration;
+
+  if (!pTask->m_iScheduleState.TestAndSet(nsTask::MakeScheduleState(uiGeneration, nsTask::NotScheduled), nsTask::MakeScheduleState(uiGeneration, nsTask::BeingScheduled)))
+  {
+    // CancelTask() has marked the task as finished before it got scheduled, so its runs have not been counted down yet
+    // this also schedules the nodes that depend on it
+    TaskHasFinished(nsSharedPtr<nsTask>(node.m_pTask), pGroup, node.m_uiNumRuns);
+    return;
+  }
+
+  pTask->m_bTaskIsScheduled = true;
+
+  // from now on the runs can be taken by worker threads or CancelTask()
+  pTask->m_iScheduleState = nsTask::MakeScheduleState(uiGeneration, node.m_uiNumRuns);
+
+  nsHybridArray<TaskData, 16> tasks;
+
+  for (nsUInt32 mult = 0; mult < node.m_uiNumRuns; ++mult)
+  {
+    TaskData& td = tasks.ExpandAndGetRef();
+    td.m_pBelongsToGroup = pGroup;
+    td.m_pTask = node.m_pTask;
+    td.m_uiInvocation = mult;
+    td.m_uiScheduleGeneration = uiGeneration;
+    td.m_NestingMode = pTask->m_NestingMode;
+  }
+
+  QueueTasks(tasks, nsTaskQueueLevel::FromPriority(node.m_Priority, s_pState->m_iCurrentFrame), node.m_Priority);
+}
+
+void nsTaskSystem::TaskGraphNodeHasFinished(nsTaskGroup* pGroup, nsUInt32 uiNode)
+{
+  nsTaskGraph& graph = *pGroup->m_pTaskGraph;
+  const nsTaskGraph::Node& node = graph.m_Nodes[uiNode];
+
+  for (nsUInt32 i = 0; i < node.m_uiNumSuccessors; ++i)
+  {
+    const nsUInt32 uiSuccessor = graph.m_Successors[node.m_uiFirstSuccessor + i];
+
+    if (graph.m_Nodes[uiSuccessor].m_iRemainingDependencies.Decrement() == 0)
+    {
+      ScheduleTaskGraphNode(graph, pGroup, uiSuccessor);
+    }
+  }
+}
+
+NS_STATICLINK_FILE(Foundation, Foundation_Threading_Implementation_TaskSystemGraphs);
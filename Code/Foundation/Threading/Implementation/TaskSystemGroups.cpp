@@ -9,32 +9,68 @@
 #include <Foundation/Threading/TaskSystem.h>
 
 
-nsTaskGroupID nsTaskSystem::CreateTaskGroup(nsTaskPriority::Enum priority, nsOnTaskGroupFinishedCallback callback)
+nsTaskGroup* nsTaskSystemState::AcquireTaskGroup()
 {
-  NS_LOCK(s_TaskSystemMutex);
+  while (true)
+  {
+    const nsUInt64 uiHead = static_cast<nsUInt64>(static_cast<nsInt64>(m_iFreeTaskGroups));
+    const nsUInt32 uiFirstFree = static_cast<nsUInt32>(uiHead);
+
+    if (uiFirstFree == 0)
+      break;
 
-  nsUInt32 i = 0;
+    nsTaskGroup& group = GetTaskGroup(uiFirstFree - 1);
+
+    // if another thread takes the group in the meantime, m_uiNextFreeGroup may be outdated,
+    // but then the counter in the upper bits has changed as well and the swap fails
+    const nsUInt64 uiNewHead = (((uiHead >> 32) + 1) << 32) | group.m_uiNextFreeGroup;
+
+    if (m_iFreeTaskGroups.TestAndSet(static_cast<nsInt64>(uiHead), static_cast<nsInt64>(uiNewHead)))
+      return &group;
+  }
 
-  // this search could be speed up with a stack of free groups
-  for (; i < s_pState->m_TaskGroups.GetCount(); ++i)
+  // no free group available, create a new one
+  NS_LOCK(m_TaskGroupAllocationMutex);
+
+  const nsUInt32 uiIndex = m_uiNumTaskGroups;
+  const nsUInt32 uiBlock = uiIndex / TaskGroupsPerBlock;
+
+  NS_ASSERT_ALWAYS(uiBlock < MaxTaskGroupBlocks, "Max number of task groups ({}) exceeded.", MaxTaskGroupBlocks * TaskGroupsPerBlock);
+
+  if (m_TaskGroupBlocks[uiBlock] == nullptr)
   {
-    if (!s_pState->m_TaskGroups[i].m_bInUse)
-    {
-      goto foundtaskgroup;
-    }
+    m_TaskGroupBlocks[uiBlock] = NS_DEFAULT_NEW_ARRAY(nsTaskGroup, TaskGroupsPerBlock).GetPtr();
   }
 
-  // no free group found, create a new one
-  s_pState->m_TaskGroups.ExpandAndGetRef();
-  s_pState->m_TaskGroups[i].m_uiTaskGroupIndex = static_cast<nsUInt16>(i);
+  ++m_uiNumTaskGroups;
 
-foundtaskgroup:
+  nsTaskGroup& group = GetTaskGroup(uiIndex);
+  group.m_uiTaskGroupIndex = uiIndex;
+  return &group;
+}
 
-  s_pState->m_TaskGroups[i].Reuse(priority, callback);
+void nsTaskSystemState::ReleaseTaskGroup(nsTaskGroup* pGroup)
+{
+  while (true)
+  {
+    const nsUInt64 uiHead = static_cast<nsUInt64>(static_cast<nsInt64>(m_iFreeTaskGroups));
+    const nsUInt64 uiNewHead = (((uiHead >> 32) + 1) << 32) | (pGroup->m_uiTaskGroupIndex + 1);
+
+    pGroup->m_uiNextFreeGroup = static_cast<nsUInt32>(uiHead);
+
+    if (m_iFreeTaskGroups.TestAndSet(static_cast<nsInt64>(uiHead), static_cast<nsInt64>(uiNewHead)))
+      return;
+  }
+}
+
+nsTaskGroupID nsTaskSystem::CreateTaskGroup(nsTaskPriority::Enum priority, nsOnTaskGroupFinishedCallback callback)
+{
+  nsTaskGroup* pGroup = s_pState->AcquireTaskGroup();
+  pGroup->Reuse(priority, callback);
 
   nsTaskGroupID id;
-  id.m_pTaskGroup = &s_pState->m_TaskGroups[i];
-  id.m_uiGroupCounter = s_pState->m_TaskGroups[i].m_uiGroupCounter;
+  id.m_pTaskGroup = pGroup;
+  id.m_uiGroupCounter = pGroup->m_uiGroupCounter;
   return id;
 }
 
@@ -48,6 +84,9 @@ void nsTaskSystem::AddTaskToGroup(nsTaskGroupID groupID, const nsSharedPtr<nsTas
 
   pTask->Reset();
   pTask->m_BelongsToGroup = groupID;
+
+  // WriteStateSnapshotToDGML() may read the task list at any time
+  NS_LOCK(groupID.m_pTaskGroup->m_CondVarGroupFinished);
   groupID.m_pTaskGroup->m_Tasks.PushBack(pTask);
 }
 
@@ -58,6 +97,7 @@ void nsTaskSystem::AddTaskGroupDependency(nsTaskGroupID groupID, nsTaskGroupID d
 
   nsTaskGroup::DebugCheckTaskGroup(groupID, s_TaskSystemMutex);
 
+  NS_LOCK(groupID.m_pTaskGroup->m_CondVarGroupFinished);
   groupID.m_pTaskGroup->m_DependsOnGroups.PushBack(dependsOn);
 }
 
@@ -80,46 +120,42 @@ void nsTaskSystem::StartTaskGroup(nsTaskGroupID groupID)
 
   nsTaskGroup::DebugCheckTaskGroup(groupID, s_TaskSystemMutex);
 
-  nsInt32 iActiveDependencies = 0;
-
-  {
-    NS_LOCK(s_TaskSystemMutex);
+  nsTaskGroup& tg = *groupID.m_pTaskGroup;
 
-    nsTaskGroup& tg = *groupID.m_pTaskGroup;
+  tg.m_bStartedByUser = true;
 
-    tg.m_bStartedByUser = true;
+  if (tg.m_DependsOnGroups.IsEmpty())
+  {
+    ScheduleGroupTasks(&tg);
+    return;
+  }
 
-    for (nsUInt32 i = 0; i < tg.m_DependsOnGroups.GetCount(); ++i)
-    {
-      if (!IsTaskGroupFinished(tg.m_DependsOnGroups[i]))
-      {
-        nsTaskGroup& Dependency = *tg.m_DependsOnGroups[i].m_pTaskGroup;
+  // one additional dependency that is only removed below
+  // prevents the group from getting scheduled by a finishing dependency, while the other dependencies are still being registered
+  tg.m_iNumActiveDependencies = 1;
 
-        // add this task group to the list of dependencies, such that when that group finishes, this task group can get woken up
-        Dependency.m_OthersDependingOnMe.PushBack(groupID);
+  for (nsUInt32 i = 0; i < tg.m_DependsOnGroups.GetCount(); ++i)
+  {
+    nsTaskGroup& Dependency = *tg.m_DependsOnGroups[i].m_pTaskGroup;
 
-        // count how many other groups need to finish before this task group can be executed
-        ++iActiveDependencies;
-      }
-    }
+    // TaskHasFinished() marks a group as finished while holding this lock, and only reads m_OthersDependingOnMe after that
+    NS_LOCK(Dependency.m_CondVarGroupFinished);
 
-    if (iActiveDependencies != 0)
+    if (!IsTaskGroupFinished(tg.m_DependsOnGroups[i]))
     {
-      // atomic integers are quite slow, so do not use them in the loop, where they are not yet needed
-      tg.m_iNumActiveDependencies = iActiveDependencies;
+      // add this task group to the list of dependencies, such that when that group finishes, this task group can get woken up
+      Dependency.m_OthersDependingOnMe.PushBack(groupID);
+
+      // count how many other groups need to finish before this task group can be executed
+      tg.m_iNumActiveDependencies.Increment();
     }
   }
 
-  if (iActiveDependencies == 0)
-  {
-    ScheduleGroupTasks(groupID.m_pTaskGroup, false);
-  }
+  DependencyHasFinished(&tg);
 }
 
 void nsTaskSystem::StartTaskGroupBatch(nsArrayPtr<const nsTaskGroupID> batch)
 {
-  NS_LOCK(s_TaskSystemMutex);
-
   for (const nsTaskGroupID& group : batch)
   {
     StartTaskGroup(group);
@@ -132,97 +168,154 @@ bool nsTaskSystem::IsTaskGroupFinished(nsTaskGroupID group)
   return (group.m_pTaskGroup == nullptr) || (group.m_pTaskGroup->m_uiGroupCounter != group.m_uiGroupCounter);
 }
 
-void nsTaskSystem::ScheduleGroupTasks(nsTaskGroup* pGroup, bool bHighPriority)
+void nsTaskSystem::ScheduleGroupTasks(nsTaskGroup* pGroup)
 {
-  if (pGroup->m_Tasks.IsEmpty())
+  // tasks may get canceled concurrently (see CancelTask()), so first claim all tasks that are still waiting to be scheduled
+  nsInt32 iRemainingTasks = 0;
+
+  for (const auto& pTask : pGroup->m_Tasks)
   {
-    pGroup->m_iNumRemainingTasks = 1;
+    const nsUInt32 uiGeneration = pTask->m_uiScheduleGeneration;
 
-    // "finish" one task -> will finish the task group and kick off dependent groups
-    TaskHasFinished(nullptr, pGroup);
-    return;
+    if (pTask->m_iScheduleState.TestAndSet(nsTask::MakeScheduleState(uiGeneration, nsTask::NotScheduled), nsTask::MakeScheduleState(uiGeneration, nsTask::BeingScheduled)))
+    {
+      iRemainingTasks += nsMath::Max(1u, pTask->m_uiMultiplicity);
+    }
   }
 
-  nsInt32 iRemainingTasks = 0;
+  // store how many tasks from this groups still need to be processed
+  // plus one, which is only removed at the very end, such that the group cannot finish while its tasks are still being iterated over
+  pGroup->m_iNumRemainingTasks = iRemainingTasks + 1;
 
-  // add all the tasks to the task list, so that they will be processed
+  if (iRemainingTasks > 0)
   {
-    NS_LOCK(s_TaskSystemMutex);
-
+    const nsUInt32 uiQueueLevel = nsTaskQueueLevel::FromPriority(pGroup->m_Priority, s_pState->m_iCurrentFrame);
 
-    // store how many tasks from this groups still need to be processed
+    nsHybridArray<TaskData, 16> tasks;
 
-    for (auto pTask : pGroup->m_Tasks)
+    for (const auto& pTask : pGroup->m_Tasks)
     {
-      iRemainingTasks += nsMath::Max(1u, pTask->m_uiMultiplicity);
-      pTask->m_iRemainingRuns = nsMath::Max(1u, pTask->m_uiMultiplicity);
-    }
+      const nsUInt32 uiGeneration = pTask->m_uiScheduleGeneration;
 
-    pGroup->m_iNumRemainingTasks = iRemainingTasks;
+      if (pTask->m_iScheduleState != nsTask::MakeScheduleState(uiGeneration, nsTask::BeingScheduled))
+        continue;
 
+      const nsUInt32 uiNumRuns = nsMath::Max(1u, pTask->m_uiMultiplicity);
 
-    for (nsUInt32 task = 0; task < pGroup->m_Tasks.GetCount(); ++task)
-    {
-      auto& pTask = pGroup->m_Tasks[task];
+      pTask->m_iRemainingRuns = uiNumRuns;
+      pTask->m_bTaskIsScheduled = true;
+
+      // from now on the runs can be taken by worker threads or CancelTask()
+      pTask->m_iScheduleState = nsTask::MakeScheduleState(uiGeneration, uiNumRuns);
 
-      for (nsUInt32 mult = 0; mult < nsMath::Max(1u, pTask->m_uiMultiplicity); ++mult)
+      for (nsUInt32 mult = 0; mult < uiNumRuns; ++mult)
       {
-        TaskData td;
+        TaskData& td = tasks.ExpandAndGetRef();
         td.m_pBelongsToGroup = pGroup;
         td.m_pTask = pTask;
-        td.m_pTask->m_bTaskIsScheduled = true;
         td.m_uiInvocation = mult;
-
-        if (bHighPriority)
-          s_pState->m_Tasks[pGroup->m_Priority].PushFront(td);
-        else
-          s_pState->m_Tasks[pGroup->m_Priority].PushBack(td);
+        td.m_uiScheduleGeneration = uiGeneration;
+        td.m_NestingMode = pTask->m_NestingMode;
       }
     }
 
-    // send the proper thread signal, to make sure one of the correct worker threads is awake
-    switch (pGroup->m_Priority)
+    QueueTasks(tasks, uiQueueLevel, pGroup->m_Priority);
+  }
+
+  // "finish" the additional task -> will finish the task group and kick off dependent groups, if it has no (more) tasks to execute
+  TaskHasFinished(nullptr, pGroup, 1);
+}
+
+void nsTaskSystem::QueueTasks(nsArrayPtr<TaskData> tasks, nsUInt32 uiQueueLevel, nsTaskPriority::Enum priority)
+{
+  // tasks with a deadline are ordered by the point in time at which they have to be started at the latest
+  // all entries of a task with multiplicity are next to each other, so the estimate only needs to be looked up once per task
+  const nsTask* pEstimatedTask = nullptr;
+  nsTime latestStart;
+
+  for (TaskData& td : tasks)
+  {
+    const nsTask* pTask = td.m_pTask.Borrow();
+
+    if (!pTask->m_Deadline.IsPositive())
+      continue;
+
+    if (pTask != pEstimatedTask)
     {
-      case nsTaskPriority::EarlyThisFrame:
-      case nsTaskPriority::ThisFrame:
-      case nsTaskPriority::LateThisFrame:
-      case nsTaskPriority::EarlyNextFrame:
-      case nsTaskPriority::NextFrame:
-      case nsTaskPriority::LateNextFrame:
-      case nsTaskPriority::In2Frames:
-      case nsTaskPriority::In3Frames:
-      case nsTaskPriority::In4Frames:
-      case nsTaskPriority::In5Frames:
-      case nsTaskPriority::In6Frames:
-      case nsTaskPriority::In7Frames:
-      case nsTaskPriority::In8Frames:
-      case nsTaskPriority::In9Frames:
-      {
-        WakeUpThreads(nsWorkerThreadType::ShortTasks, iRemainingTasks);
-        break;
-      }
+      pEstimatedTask = pTask;
+      latestStart = pTask->m_Deadline - EstimateTaskCost(*pTask);
+    }
 
-      case nsTaskPriority::LongRunning:
-      case nsTaskPriority::LongRunningHighPriority:
-      {
-        WakeUpThreads(nsWorkerThreadType::LongTasks, iRemainingTasks);
-        break;
-      }
+    s_pState->m_DeadlineQueues[uiQueueLevel].Push(std::move(td), latestStart);
+  }
 
-      case nsTaskPriority::FileAccess:
-      case nsTaskPriority::FileAccessHighPriority:
-      {
-        WakeUpThreads(nsWorkerThreadType::FileAccess, iRemainingTasks);
-        break;
-      }
+  // threads that are not managed by the task system do not own any queues and have to share the injection queues
+  // entries that went into the deadline queue are empty now
+  nsTaskQueueSet* pQueues = tl_TaskWorkerInfo.m_pQueues;
 
-      case nsTaskPriority::SomeFrameMainThread:
-      case nsTaskPriority::ThisFrameMainThread:
-      case nsTaskPriority::ENUM_COUNT:
-        // nothing to do for these enum values
-        break;
+  if (pQueues != nullptr)
+  {
+    for (TaskData& td : tasks)
+    {
+      if (td.m_pTask != nullptr)
+        pQueues->m_Queues[uiQueueLevel].PushBottom(std::move(td));
     }
   }
+  else
+  {
+    NS_LOCK(s_pThreadState->m_InjectionMutex);
+
+    for (TaskData& td : tasks)
+    {
+      if (td.m_pTask != nullptr)
+        s_pThreadState->m_pInjectionQueues->m_Queues[uiQueueLevel].PushBottom(std::move(td));
+    }
+  }
+
+  s_pState->m_QueuedTasks[uiQueueLevel].m_iCount.Add(tasks.GetCount());
+
+  // send the proper thread signal, to make sure one of the correct worker threads is awake
+  switch (priority)
+  {
+    case nsTaskPriority::EarlyThisFrame:
+    case nsTaskPriority::ThisFrame:
+    case nsTaskPriority::LateThisFrame:
+    case nsTaskPriority::EarlyNextFrame:
+    case nsTaskPriority::NextFrame:
+    case nsTaskPriority::LateNextFrame:
+    case nsTaskPriority::In2Frames:
+    case nsTaskPriority::In3Frames:
+    case nsTaskPriority::In4Frames:
+    case nsTaskPriority::In5Frames:
+    case nsTaskPriority::In6Frames:
+    case nsTaskPriority::In7Frames:
+    case nsTaskPriority::In8Frames:
+    case nsTaskPriority::In9Frames:
+    {
+      WakeUpThreads(nsWorkerThreadType::ShortTasks, tasks.GetCount());
+      break;
+    }
+
+    case nsTaskPriority::LongRunning:
+    case nsTaskPriority::LongRunningHighPriority:
+    {
+      WakeUpThreads(nsWorkerThreadType::LongTasks, tasks.GetCount());
+      break;
+    }
+
+    case nsTaskPriority::FileAccess:
+    case nsTaskPriority::FileAccessHighPriority:
+    {
+      WakeUpThreads(nsWorkerThreadType::FileAccess, tasks.GetCount());
+      break;
+    }
+
+    case nsTaskPriority::SomeFrameMainThread:
+    case nsTaskPriority::ThisFrameMainThread:
+    case nsTaskPriority::ENUM_COUNT:
+      // nothing to do for these enum values
+      break;
+  }
 }
 
 void nsTaskSystem::DependencyHasFinished(nsTaskGroup* pGroup)
@@ -231,7 +324,7 @@ void nsTaskSystem::DependencyHasFinished(nsTaskGroup* pGroup)
   if (pGroup->m_iNumActiveDependencies.Decrement() == 0)
   {
     // if there are no remaining dependencies, kick off all tasks in this group
-    ScheduleGroupTasks(pGroup, true);
+    ScheduleGroupTasks(pGroup);
   }
 }
 
@@ -242,11 +335,19 @@ nsResult nsTaskSystem::CancelGroup(nsTaskGroupID group, nsOnTaskRunning::Enum on
 
   NS_PROFILE_SCOPE("CancelGroup");
 
-  NS_LOCK(s_TaskSystemMutex);
+  nsHybridArray<nsSharedPtr<nsTask>, 16> TasksCopy;
 
-  nsResult res = NS_SUCCESS;
+  {
+    // TaskHasFinished() clears the task list only after marking the group as finished while holding this lock
+    NS_LOCK(group.m_pTaskGroup->m_CondVarGroupFinished);
+
+    if (nsTaskSystem::IsTaskGroupFinished(group))
+      return NS_SUCCESS;
 
-  auto TasksCopy = group.m_pTaskGroup->m_Tasks;
+    TasksCopy = group.m_pTaskGroup->m_Tasks;
+  }
+
+  nsResult res = NS_SUCCESS;
 
   // first cancel ALL the tasks in the group, without waiting for anything
   for (nsUInt32 task = 0; task < TasksCopy.GetCount(); ++task)
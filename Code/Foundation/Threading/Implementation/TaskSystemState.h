@@ -1,5 +1,11 @@
 #pragma once
 
+#include <Foundation/Containers/HashTable.h>
+#include <Foundation/Memory/CommonAllocators.h>
+#include <Foundation/Threading/Implementation/TaskAllocator.h>
+#include <Foundation/Threading/Implementation/TaskGroup.h>
+#include <Foundation/Threading/Implementation/TaskQueue.h>
+#include <Foundation/Threading/ReadWriteLock.h>
 #include <Foundation/Threading/TaskSystem.h>
 
 class nsTaskSystemThreadState
@@ -8,6 +14,16 @@ private:
   friend class nsTaskSystem;
   friend class nsTaskWorkerThread;
 
+  // 1 injection set + 1 main thread set + the maximum number of short, long and file access worker threads
+  static constexpr nsUInt32 MaxQueueSets = 2 + 1024 + 1024 + 128;
+
+  // Allocates the task system data that contains cache-line aligned members (the queue sets and nsTaskSystemState)
+  // and the slabs of m_TaskAllocator.
+  nsAlignedHeapAllocator m_Allocator{"TaskSystem"};
+
+  // Recycles the memory of task objects, see nsTaskSystem::GetTaskAllocator().
+  nsTaskAllocator m_TaskAllocator{"TaskObjects", &m_Allocator};
+
   // The arrays of all the active worker threads.
   nsDynamicArray<nsTaskWorkerThread*> m_Workers[nsWorkerThreadType::ENUM_COUNT];
 
@@ -16,19 +32,106 @@ private:
 
   // the maximum number of worker threads that should be non-idle (and not blocked) at any time
   nsUInt32 m_uiMaxWorkersToUse[nsWorkerThreadType::ENUM_COUNT] = {};
+
+  // Whether short task workers get pinned to logical processors, see nsTaskSystem::SetWorkerThreadPinning().
+  bool m_bPinShortTaskWorkers = false;
+
+  // Indices into nsCpuTopology::m_LogicalProcessors, in the order in which the short task workers are placed on them.
+  nsDynamicArray<nsUInt16> m_PlacementOrder;
+
+  // All queue sets that threads may steal tasks from. Sets are only ever added (while holding the task system mutex),
+  // so other threads can iterate over the first m_iNumQueueSets entries without a lock.
+  nsTaskQueueSet* m_QueueSets[MaxQueueSets] = {};
+  nsAtomicInteger32 m_iNumQueueSets;
+
+  // The queue sets owned by the worker threads, by worker index. They outlive their threads and get reused when threads are re-allocated.
+  nsDynamicArray<nsTaskQueueSet*> m_WorkerQueueSets[nsWorkerThreadType::ENUM_COUNT];
+
+  // The main thread's queue set.
+  nsTaskQueueSet* m_pMainThreadQueues = nullptr;
+
+  // Threads that are not managed by the task system push their tasks into this set, m_InjectionMutex serializes them.
+  // Tasks that were still queued in the sets of worker threads that get shut down are moved here as well.
+  nsTaskQueueSet* m_pInjectionQueues = nullptr;
+  nsMutex m_InjectionMutex;
 };
 
 class nsTaskSystemState
 {
+public:
+  ~nsTaskSystemState();
+
 private:
   friend class nsTaskSystem;
 
+  static constexpr nsUInt32 TaskGroupsPerBlock = 256;
+  static constexpr nsUInt32 MaxTaskGroupBlocks = 1024;
+
+  nsTaskGroup& GetTaskGroup(nsUInt32 uiIndex) { return m_TaskGroupBlocks[uiIndex / TaskGroupsPerBlock][uiIndex % TaskGroupsPerBlock]; }
+
+  /// \brief Returns an unused task group. Only takes a lock, if all existing groups are in use.
+  nsTaskGroup* AcquireTaskGroup();
+
+  /// \brief Puts a finished task group back onto the free list.
+  void ReleaseTaskGroup(nsTaskGroup* pGroup);
+
   // The target frame time used by FinishFrameTasks()
   nsTime m_TargetFrameTime = nsTime::MakeFromSeconds(1.0 / 40.0); // => 25 ms
 
-  // The deque can grow without relocating existing data, therefore the nsTaskGroupID's can store pointers directly to the data
-  nsDeque<nsTaskGroup> m_TaskGroups;
+  // The groups are allocated in blocks that never move, therefore the nsTaskGroupID's can store pointers directly to the data
+  nsTaskGroup* m_TaskGroupBlocks[MaxTaskGroupBlocks] = {};
+  nsUInt32 m_uiNumTaskGroups = 0;
+  nsMutex m_TaskGroupAllocationMutex;
+
+  // Lock-free stack of unused task groups.
+  // The lower 32 bits store the index + 1 of the first free group (zero if empty), the upper 32 bits a counter against the ABA problem.
+  alignas(64) nsAtomicInteger64 m_iFreeTaskGroups;
+
+  // Incremented once per frame by FinishFrameTasks(), determines which queue levels hold the 'this frame' tasks. See nsTaskQueueLevel.
+  alignas(64) nsAtomicInteger32 m_iCurrentFrame;
+
+  struct alignas(64) QueuedTaskCounter
+  {
+    nsAtomicInteger32 m_iCount;
+  };
+
+  // The number of entries in each queue level, over all queue sets. Incremented after pushing and decremented after taking
+  // entries, so it may be off for a moment, but never stays zero while entries are queued.
+  QueuedTaskCounter m_QueuedTasks[nsTaskQueueLevel::Count];
+
+  // Tasks with a deadline don't go into the work-stealing queues, but into one binary heap per queue level, ordered by the latest
+  // point in time at which they can be started to still meet their deadline (earliest deadline first, corrected by the estimated cost).
+  // Their entries are counted in m_QueuedTasks as well.
+  struct alignas(64) DeadlineQueue
+  {
+    struct Entry
+    {
+      nsTaskSystem::TaskData m_Task;
+      nsTime m_LatestStart;
+    };
+
+    void Push(nsTaskSystem::TaskData&& task, nsTime latestStart);
+
+    /// \brief Takes the entry that has to be started first, unless \a filter rejects it.
+    bool Pop(nsTaskSystem::TaskData& out_task, nsTaskQueue::Filter filter, const void* pUserData);
+
+    /// \brief Moves all entries into \a ref_target and returns how many there were.
+    nsUInt32 MoveAllTo(DeadlineQueue& ref_target);
+
+    nsMutex m_Mutex;
+    nsDynamicArray<Entry> m_Heap;
+
+    // The size of m_Heap, so that threads can skip empty queues without locking them.
+    nsAtomicInteger32 m_iCount;
+  };
+
+  DeadlineQueue m_DeadlineQueues[nsTaskQueueLevel::Count];
+
+  // How long the runs of tasks with a deadline took recently (exponential moving average), by the hash of the task name.
+  nsReadWriteLock m_TaskCostLock;
+  nsHashTable<nsUInt64, nsTime> m_TaskCosts;
 
-  // The lists of all scheduled tasks, for each priority.
-  nsList<nsTaskSystem::TaskData> m_Tasks[nsTaskPriority::ENUM_COUNT];
+  // See nsTaskDeadlineStats.
+  nsAtomicInteger64 m_iNumDeadlineTasksExecuted;
+  nsAtomicInteger64 m_iNumDeadlinesMissed;
 };
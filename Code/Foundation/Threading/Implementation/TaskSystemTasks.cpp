@@ -1,6 +1,8 @@
 #include <Foundation/FoundationPCH.h>
 
+#include <Foundation/Algorithm/HashingUtils.h>
 #include <Foundation/Profiling/Profiling.h>
+#include <Foundation/Threading/DelegateTask.h>
 #include <Foundation/Threading/Implementation/TaskGroup.h>
 #include <Foundation/Threading/Implementation/TaskSystemState.h>
 #include <Foundation/Threading/Implementation/TaskWorkerThread.h>
@@ -26,48 +28,80 @@ nsTaskGroupID nsTaskSystem::StartSingleTask(
   return Group;
 }
 
-void nsTaskSystem::TaskHasFinished(nsSharedPtr<nsTask>&& pTask, nsTaskGroup* pGroup)
+nsTaskGroupID nsTaskSystem::StartSingleTask(const char* szTaskName, nsTaskPriority::Enum priority, nsDelegate<void()> func, nsTaskNesting taskNesting)
+{
+  nsSharedPtr<nsTask> pTask = NS_NEW(GetTaskAllocator(), nsDelegateTask<void>, szTaskName, taskNesting, std::move(func));
+  return StartSingleTask(pTask, priority);
+}
+
+static nsInt32 SubtractAndGet(nsAtomicInteger32& ref_iValue, nsInt32 iSubtract)
+{
+  if (iSubtract == 1)
+    return ref_iValue.Decrement();
+
+  while (true)
+  {
+    const nsInt32 iOldValue = ref_iValue;
+
+    if (ref_iValue.TestAndSet(iOldValue, iOldValue - iSubtract))
+      return iOldValue - iSubtract;
+  }
+}
+
+void nsTaskSystem::TaskHasFinished(nsSharedPtr<nsTask>&& pTask, nsTaskGroup* pGroup, nsUInt32 uiNumInvocations)
 {
   // call task finished callback and deallocate the task (if last reference)
-  if (pTask && pTask->m_iRemainingRuns == 0)
+  if (pTask)
   {
+    NS_ASSERT_DEBUG(pTask->IsTaskFinished(), "Only finished tasks may be passed in");
+
     if (pTask->m_OnTaskFinished.IsValid())
     {
       pTask->m_OnTaskFinished(pTask);
     }
 
+    const nsUInt32 uiTaskGraphNode = pTask->m_uiTaskGraphNode;
+
     // make sure to clear the task sharedptr BEFORE we mark the task (group) as finished,
     // so that if this is the last reference, the task gets deallocated first
     pTask.Clear();
+
+    // the nodes that depend on this task get scheduled before the graph's group can finish
+    if (pGroup->m_pTaskGraph != nullptr)
+    {
+      TaskGraphNodeHasFinished(pGroup, uiTaskGraphNode);
+    }
   }
 
-  if (pGroup->m_iNumRemainingTasks.Decrement() == 0)
+  if (SubtractAndGet(pGroup->m_iNumRemainingTasks, static_cast<nsInt32>(uiNumInvocations)) == 0)
   {
     // If this was the last task that had to be finished from this group, make sure all dependent groups are started
 
     nsUInt32 groupCounter = 0;
+    nsHybridArray<nsSharedPtr<nsTask>, 16> finishedTasks;
     {
       // see nsTaskGroup::WaitForFinish() for why we need this lock here
       // without it, there would be a race condition between these two places, reading and writing m_uiGroupCounter and waiting/signaling
       // m_CondVarGroupFinished
+      // StartTaskGroup(), CancelGroup() and WriteStateSnapshotToDGML() rely on this lock as well
       NS_LOCK(pGroup->m_CondVarGroupFinished);
 
       groupCounter = pGroup->m_uiGroupCounter;
 
       // set this task group to be finished such that no one tries to append further dependencies
       pGroup->m_uiGroupCounter += 2;
-    }
 
-    {
-      NS_LOCK(s_TaskSystemMutex);
+      // the task list may only change while holding the lock, but the tasks are released outside of it
+      finishedTasks.Swap(pGroup->m_Tasks);
+    }
 
-      // unless an outside reference is held onto a task, this will deallocate the tasks
-      pGroup->m_Tasks.Clear();
+    // unless an outside reference is held onto a task, this will deallocate the tasks
+    finishedTasks.Clear();
 
-      for (nsUInt32 dep = 0; dep < pGroup->m_OthersDependingOnMe.GetCount(); ++dep)
-      {
-        DependencyHasFinished(pGroup->m_OthersDependingOnMe[dep].m_pTaskGroup);
-      }
+    // since the group is marked as finished, m_OthersDependingOnMe can't change anymore
+    for (nsUInt32 dep = 0; dep < pGroup->m_OthersDependingOnMe.GetCount(); ++dep)
+    {
+      DependencyHasFinished(pGroup->m_OthersDependingOnMe[dep].m_pTaskGroup);
     }
 
     // wake up all threads that are waiting for this group
@@ -82,10 +116,183 @@ void nsTaskSystem::TaskHasFinished(nsSharedPtr<nsTask>&& pTask, nsTaskGroup* pGr
     }
 
     // set this task available for reuse
-    pGroup->m_bInUse = false;
+    {
+      NS_LOCK(pGroup->m_CondVarGroupFinished);
+      pGroup->m_bInUse = false;
+    }
+
+    s_pState->ReleaseTaskGroup(pGroup);
   }
 }
 
+static bool OnlyTasksThatNeverWait(const nsTaskSystem::TaskData& td, const void* pWaitingForGroup)
+{
+  return td.m_NestingMode == nsTaskNesting::Never || td.m_pBelongsToGroup == pWaitingForGroup;
+}
+
+static nsUInt32 GetRandomStealIndex()
+{
+  // xorshift, seeded differently on each thread
+  nsUInt32 x = tl_TaskWorkerInfo.m_uiStealSeed;
+
+  if (x == 0)
+  {
+    x = static_cast<nsUInt32>(reinterpret_cast<size_t>(&tl_TaskWorkerInfo) >> 4) | 1;
+  }
+
+  x ^= x << 13;
+  x ^= x >> 17;
+  x ^= x << 5;
+
+  tl_TaskWorkerInfo.m_uiStealSeed = x;
+  return x;
+}
+
+void nsTaskSystemState::DeadlineQueue::Push(nsTaskSystem::TaskData&& task, nsTime latestStart)
+{
+  NS_LOCK(m_Mutex);
+
+  // sift the new entry up from the end of the heap
+  nsUInt32 uiIndex = m_Heap.GetCount();
+  m_Heap.ExpandAndGetRef();
+
+  while (uiIndex > 0)
+  {
+    const nsUInt32 uiParent = (uiIndex - 1) / 2;
+
+    if (m_Heap[uiParent].m_LatestStart <= latestStart)
+      break;
+
+    m_Heap[uiIndex] = std::move(m_Heap[uiParent]);
+    uiIndex = uiParent;
+  }
+
+  m_Heap[uiIndex].m_Task = std::move(task);
+  m_Heap[uiIndex].m_LatestStart = latestStart;
+
+  m_iCount.Increment();
+}
+
+bool nsTaskSystemState::DeadlineQueue::Pop(nsTaskSystem::TaskData& out_task, nsTaskQueue::Filter filter, const void* pUserData)
+{
+  if (m_iCount == 0)
+    return false;
+
+  NS_LOCK(m_Mutex);
+
+  // only the first entry is considered, if it is filtered out, the thread takes an entry without a deadline instead
+  if (m_Heap.IsEmpty() || (filter != nullptr && !filter(m_Heap[0].m_Task, pUserData)))
+    return false;
+
+  out_task = std::move(m_Heap[0].m_Task);
+
+  // sift the last entry down from the top of the heap
+  Entry last = std::move(m_Heap.PeekBack());
+  m_Heap.PopBack();
+
+  const nsUInt32 uiCount = m_Heap.GetCount();
+  nsUInt32 uiIndex = 0;
+
+  if (uiCount > 0)
+  {
+    while (true)
+    {
+      nsUInt32 uiChild = uiIndex * 2 + 1;
+
+      if (uiChild >= uiCount)
+        break;
+
+      if (uiChild + 1 < uiCount && m_Heap[uiChild + 1].m_LatestStart < m_Heap[uiChild].m_LatestStart)
+        ++uiChild;
+
+      if (last.m_LatestStart <= m_Heap[uiChild].m_LatestStart)
+        break;
+
+      m_Heap[uiIndex] = std::move(m_Heap[uiChild]);
+      uiIndex = uiChild;
+    }
+
+    m_Heap[uiIndex] = std::move(last);
+  }
+
+  m_iCount.Decrement();
+  return true;
+}
+
+nsUInt32 nsTaskSystemState::DeadlineQueue::MoveAllTo(DeadlineQueue& ref_target)
+{
+  nsDynamicArray<Entry> entries;
+
+  {
+    NS_LOCK(m_Mutex);
+    entries.Swap(m_Heap);
+    m_iCount = 0;
+  }
+
+  for (Entry& entry : entries)
+  {
+    ref_target.Push(std::move(entry.m_Task), entry.m_LatestStart);
+  }
+
+  return entries.GetCount();
+}
+
+bool nsTaskSystem::TakeQueuedTask(nsUInt32 uiQueueLevel, bool bOnlyTasksThatNeverWait, const nsTaskGroup* pWaitingForGroup, TaskData& out_task)
+{
+  const nsTaskQueue::Filter filter = bOnlyTasksThatNeverWait ? &OnlyTasksThatNeverWait : nullptr;
+
+  // the most recently queued task of this thread is the most likely one to still be in the cache
+  if (nsTaskQueueSet* pOwnQueues = tl_TaskWorkerInfo.m_pQueues)
+  {
+    if (pOwnQueues->m_Queues[uiQueueLevel].PopBottom(out_task, filter, pWaitingForGroup))
+      return true;
+  }
+
+  // otherwise steal the oldest task from some other thread, start at a random one to spread the contention
+  const nsUInt32 uiNumQueueSets = s_pThreadState->m_iNumQueueSets;
+  const nsUInt32 uiFirstQueueSet = GetRandomStealIndex() % uiNumQueueSets;
+  const nsInt32 iCacheDomain = tl_TaskWorkerInfo.m_iCacheDomain;
+
+  // pinned threads first try the threads that share their cache, the data of those tasks is more likely to be in it already
+  if (iCacheDomain >= 0)
+  {
+    for (nsUInt32 i = 0; i < uiNumQueueSets; ++i)
+    {
+      nsTaskQueueSet* pQueues = s_pThreadState->m_QueueSets[(uiFirstQueueSet + i) % uiNumQueueSets];
+
+      if (pQueues->m_iCacheDomain == iCacheDomain && pQueues->m_Queues[uiQueueLevel].StealTop(out_task, filter, pWaitingForGroup))
+        return true;
+    }
+  }
+
+  for (nsUInt32 i = 0; i < uiNumQueueSets; ++i)
+  {
+    nsTaskQueueSet* pQueues = s_pThreadState->m_QueueSets[(uiFirstQueueSet + i) % uiNumQueueSets];
+
+    if (iCacheDomain >= 0 && pQueues->m_iCacheDomain == iCacheDomain)
+      continue;
+
+    if (pQueues->m_Queues[uiQueueLevel].StealTop(out_task, filter, pWaitingForGroup))
+      return true;
+  }
+
+  return false;
+}
+
+bool nsTaskSystem::HasQueuedTasks(nsTaskPriority::Enum FirstPriority, nsTaskPriority::Enum LastPriority)
+{
+  nsHybridArray<nsUInt32, 64> levels;
+  nsTaskQueueLevel::GetLevelsToSearch(FirstPriority, LastPriority, s_pState->m_iCurrentFrame, levels);
+
+  for (const nsUInt32 uiLevel : levels)
+  {
+    if (s_pState->m_QueuedTasks[uiLevel].m_iCount > 0)
+      return true;
+  }
+
+  return false;
+}
+
 nsTaskSystem::TaskData nsTaskSystem::GetNextTask(nsTaskPriority::Enum FirstPriority, nsTaskPriority::Enum LastPriority, bool bOnlyTasksThatNeverWait,
   const nsTaskGroupID& WaitingForGroup, nsAtomicInteger32* pWorkerState)
 {
@@ -94,20 +301,39 @@ nsTaskSystem::TaskData nsTaskSystem::GetNextTask(nsTaskPriority::Enum FirstPrior
   NS_ASSERT_DEV(FirstPriority >= nsTaskPriority::EarlyThisFrame && LastPriority < nsTaskPriority::ENUM_COUNT, "Priority Range is invalid: {0} to {1}",
     FirstPriority, LastPriority);
 
-  NS_LOCK(s_TaskSystemMutex);
+  nsHybridArray<nsUInt32, 64> levels;
+  nsTaskQueueLevel::GetLevelsToSearch(FirstPriority, LastPriority, s_pState->m_iCurrentFrame, levels);
+
+  const nsTaskQueue::Filter filter = bOnlyTasksThatNeverWait ? &OnlyTasksThatNeverWait : nullptr;
+  TaskData td;
 
-  // go through all the task lists that this thread is willing to work on
-  for (nsUInt32 prio = FirstPriority; prio <= (nsUInt32)LastPriority; ++prio)
+  // go through all the task queues that this thread is willing to work on
+  // within each level the tasks with a deadline come first
+  for (const nsUInt32 uiLevel : levels)
   {
-    for (auto it = s_pState->m_Tasks[prio].GetIterator(); it.IsValid(); ++it)
+    while (s_pState->m_QueuedTasks[uiLevel].m_iCount > 0 &&
+           (s_pState->m_DeadlineQueues[uiLevel].Pop(td, filter, WaitingForGroup.m_pTaskGroup) ||
+             TakeQueuedTask(uiLevel, bOnlyTasksThatNeverWait, WaitingForGroup.m_pTaskGroup, td)))
     {
-      if (!bOnlyTasksThatNeverWait || (it->m_pTask->m_NestingMode == nsTaskNesting::Never) || it->m_pBelongsToGroup == WaitingForGroup.m_pTaskGroup)
+      s_pState->m_QueuedTasks[uiLevel].m_iCount.Decrement();
+
+      // claim one of the queued runs of the task, this fails if the task was canceled (and maybe even reused) in the meantime
+      nsTask* pTask = td.m_pTask.Borrow();
+
+      while (true)
       {
-        TaskData td = *it;
+        const nsInt64 iState = pTask->m_iScheduleState;
+        const nsUInt32 uiRuns = nsTask::GetScheduledRuns(iState);
+
+        if (nsTask::GetScheduleGeneration(iState) != td.m_uiScheduleGeneration || uiRuns == 0 || uiRuns >= nsTask::BeingScheduled)
+          break;
 
-        s_pState->m_Tasks[prio].Remove(it);
-        return td;
+        if (pTask->m_iScheduleState.TestAndSet(iState, iState - 1))
+          return td;
       }
+
+      // drop the stale entry
+      td = TaskData();
     }
   }
 
@@ -122,38 +348,115 @@ nsTaskSystem::TaskData nsTaskSystem::GetNextTask(nsTaskPriority::Enum FirstPrior
 bool nsTaskSystem::ExecuteTask(nsTaskPriority::Enum FirstPriority, nsTaskPriority::Enum LastPriority, bool bOnlyTasksThatNeverWait,
   const nsTaskGroupID& WaitingForGroup, nsAtomicInteger32* pWorkerState)
 {
-  // const nsWorkerThreadType::Enum workerType = (tl_TaskWorkerInfo.m_WorkerType == nsWorkerThreadType::Unknown) ? nsWorkerThreadType::ShortTasks :
-  // tl_TaskWorkerInfo.m_WorkerType;
-
   nsTaskSystem::TaskData td = GetNextTask(FirstPriority, LastPriority, bOnlyTasksThatNeverWait, WaitingForGroup, pWorkerState);
 
   if (td.m_pTask == nullptr)
     return false;
 
-  if (bOnlyTasksThatNeverWait && td.m_pTask->m_NestingMode != nsTaskNesting::Never)
+  if (bOnlyTasksThatNeverWait && td.m_NestingMode != nsTaskNesting::Never)
   {
     NS_ASSERT_DEV(td.m_pBelongsToGroup == WaitingForGroup.m_pTaskGroup, "");
   }
 
-  tl_TaskWorkerInfo.m_bAllowNestedTasks = td.m_pTask->m_NestingMode != nsTaskNesting::Never;
+  // only tasks with a deadline get timed
+  const bool bHasDeadline = td.m_pTask->m_Deadline.IsPositive();
+  const nsTime startTime = bHasDeadline ? nsTime::Now() : nsTime::MakeZero();
+
+  tl_TaskWorkerInfo.m_bAllowNestedTasks = td.m_NestingMode != nsTaskNesting::Never;
   tl_TaskWorkerInfo.m_szTaskName = td.m_pTask->m_sTaskName;
-  td.m_pTask->Run(td.m_uiInvocation);
+  const bool bLastRun = td.m_pTask->Run(td.m_uiInvocation);
   tl_TaskWorkerInfo.m_bAllowNestedTasks = true;
   tl_TaskWorkerInfo.m_szTaskName = nullptr;
 
+  if (bHasDeadline)
+  {
+    DeadlineTaskHasRun(*td.m_pTask, startTime, nsTime::Now());
+  }
+
+  // only the thread that finished the last run of a task triggers its 'finished' callback
+  if (!bLastRun)
+  {
+    td.m_pTask.Clear();
+  }
+
   // notify the group, that a task is finished, which might trigger other tasks to be executed
-  TaskHasFinished(std::move(td.m_pTask), td.m_pBelongsToGroup);
+  TaskHasFinished(std::move(td.m_pTask), td.m_pBelongsToGroup, 1);
 
   return true;
 }
 
+nsTime nsTaskSystem::EstimateTaskCost(const nsTask& task)
+{
+  if (task.m_EstimatedCost.IsPositive())
+    return task.m_EstimatedCost;
+
+  // the costs are remembered per task name, only tasks with a deadline pay for hashing it
+  const nsUInt64 uiNameHash = nsHashingUtils::StringHash(task.m_sTaskName.GetView());
+
+  NS_LOCK_READ(s_pState->m_TaskCostLock);
+
+  nsTime cost;
+  s_pState->m_TaskCosts.TryGetValue(uiNameHash, cost);
+  return cost;
+}
+
+void nsTaskSystem::DeadlineTaskHasRun(const nsTask& task, nsTime startTime, nsTime endTime)
+{
+  // runs that were canceled returned early, their duration says nothing about the task
+  if (task.m_bCancelExecution)
+    return;
+
+  s_pState->m_iNumDeadlineTasksExecuted.Increment();
+
+  if (endTime > task.m_Deadline)
+  {
+    s_pState->m_iNumDeadlinesMissed.Increment();
+  }
+
+  const nsTime duration = endTime - startTime;
+  const nsUInt64 uiNameHash = nsHashingUtils::StringHash(task.m_sTaskName.GetView());
+
+  NS_LOCK_WRITE(s_pState->m_TaskCostLock);
+
+  bool bExisted = false;
+  nsTime& ref_cost = s_pState->m_TaskCosts.FindOrAdd(uiNameHash, &bExisted);
+
+  // the moving average adapts within a few runs, but single outliers don't throw it off completely
+  ref_cost = bExisted ? ref_cost + (duration - ref_cost) * 0.125 : duration;
+}
+
+nsTaskDeadlineStats nsTaskSystem::GetTaskDeadlineStats()
+{
+  nsTaskDeadlineStats stats;
+
+  if (s_pState != nullptr)
+  {
+    stats.m_uiNumExecuted = static_cast<nsUInt64>(s_pState->m_iNumDeadlineTasksExecuted);
+    stats.m_uiNumMissed = static_cast<nsUInt64>(s_pState->m_iNumDeadlinesMissed);
+  }
+
+  return stats;
+}
+
+nsTime nsTaskSystem::GetEstimatedTaskCost(nsStringView sTaskName)
+{
+  if (s_pState == nullptr)
+    return nsTime::MakeZero();
+
+  NS_LOCK_READ(s_pState->m_TaskCostLock);
+
+  nsTime cost;
+  s_pState->m_TaskCosts.TryGetValue(nsHashingUtils::StringHash(sTaskName), cost);
+  return cost;
+}
+
 
 nsResult nsTaskSystem::CancelTask(const nsSharedPtr<nsTask>& pTask, nsOnTaskRunning::Enum onTaskRunning)
 {
   if (pTask->IsTaskFinished())
     return NS_SUCCESS;
 
-  // pTask may actually finish between here and the lock below
+  // pTask may actually finish while we try to cancel it
   // in that case we will return failure, as in we had to 'wait' for a task,
   // but it will be handled correctly
 
@@ -162,41 +465,52 @@ nsResult nsTaskSystem::CancelTask(const nsSharedPtr<nsTask>& pTask, nsOnTaskRunn
   // we set the cancel flag, to make sure that tasks that support canceling will terminate asap
   pTask->m_bCancelExecution = true;
 
+  // take away all runs of the task that have not been picked up by any thread yet
+  // their entries stay in the task queues, but will be skipped
+  while (true)
   {
-    NS_LOCK(s_TaskSystemMutex);
+    const nsInt64 iState = pTask->m_iScheduleState;
+    const nsInt64 iCanceledState = nsTask::MakeScheduleState(nsTask::GetScheduleGeneration(iState), 0);
+    const nsUInt32 uiRuns = nsTask::GetScheduledRuns(iState);
+
+    if (uiRuns == 0)
+    {
+      // all runs are already being executed (or finished)
+      break;
+    }
 
-    // if the task is still in the queue of its group, it had not yet been scheduled
-    if (!pTask->m_bTaskIsScheduled && pTask->m_BelongsToGroup.m_pTaskGroup->m_Tasks.RemoveAndSwap(pTask))
+    if (uiRuns == nsTask::BeingScheduled)
     {
-      // we set the task to finished, even though it was not executed
-      pTask->m_iRemainingRuns = 0;
-      return NS_SUCCESS;
+      // ScheduleGroupTasks() is just about to queue this task
+      nsThreadUtils::YieldTimeSlice();
+      continue;
     }
 
-    // check if the task has already been scheduled for execution
-    // if so, remove it from the work queue
+    if (uiRuns == nsTask::NotScheduled)
     {
-      for (nsUInt32 i = 0; i < nsTaskPriority::ENUM_COUNT; ++i)
+      // the task's group is still waiting for its dependencies, ScheduleGroupTasks() will skip the task
+      if (pTask->m_iScheduleState.TestAndSet(iState, iCanceledState))
       {
-        auto it = s_pState->m_Tasks[i].GetIterator();
+        // we set the task to finished, even though it was not executed
+        pTask->m_iRemainingRuns = 0;
+        return NS_SUCCESS;
+      }
 
-        while (it.IsValid())
-        {
-          if (it->m_pTask == pTask)
-          {
-            // we set the task to finished, even though it was not executed
-            pTask->m_iRemainingRuns = 0;
+      continue;
+    }
 
-            // tell the system that one task of that group is 'finished', to ensure its dependencies will get scheduled
-            TaskHasFinished(std::move(it->m_pTask), it->m_pBelongsToGroup);
+    if (pTask->m_iScheduleState.TestAndSet(iState, iCanceledState))
+    {
+      // we count the runs as finished, even though they were not executed
+      const bool bTaskFinished = SubtractAndGet(pTask->m_iRemainingRuns, static_cast<nsInt32>(uiRuns)) == 0;
 
-            s_pState->m_Tasks[i].Remove(it);
-            return NS_SUCCESS;
-          }
+      // tell the system that these tasks of that group are 'finished', to ensure its dependencies will get scheduled
+      TaskHasFinished(bTaskFinished ? nsSharedPtr<nsTask>(pTask) : nsSharedPtr<nsTask>(), pTask->m_BelongsToGroup.m_pTaskGroup, uiRuns);
 
-          ++it;
-        }
-      }
+      if (bTaskFinished)
+        return NS_SUCCESS;
+
+      break;
     }
   }
 
@@ -226,57 +540,39 @@ bool nsTaskSystem::HelpExecutingTasks(const nsTaskGroupID& WaitingForGroup)
 
 void nsTaskSystem::ReprioritizeFrameTasks()
 {
-  // There should usually be no 'this frame tasks' left at this time
-  // however, while we waited to enter the lock, such tasks might have appeared
-  // In this case we move them into the highest-priority 'this frame' queue, to ensure they will be executed asap
-  for (nsUInt32 i = (nsUInt32)nsTaskPriority::ThisFrame; i <= (nsUInt32)nsTaskPriority::LateThisFrame; ++i)
-  {
-    auto it = s_pState->m_Tasks[i].GetIterator();
+  const nsUInt32 uiFrame = s_pState->m_iCurrentFrame;
 
-    // move all 'this frame' tasks into the 'early this frame' queue
-    while (it.IsValid())
-    {
-      s_pState->m_Tasks[nsTaskPriority::EarlyThisFrame].PushBack(*it);
+  // Once the frame is advanced, the slot of the oldest overdue frame is used for 'In9Frames' tasks.
+  // There should be no tasks left in it, but if there are, move them into the 'early this frame' queue of the new frame.
+  const nsUInt32 uiTargetLevel = nsTaskQueueLevel::FromFrameSlot(uiFrame + 1, 0, 0);
+  nsTaskQueueSet* pOwnQueues = tl_TaskWorkerInfo.m_pQueues;
 
-      ++it;
-    }
-
-    // remove the tasks from their current queue
-    s_pState->m_Tasks[i].Clear();
-  }
-
-  for (nsUInt32 i = (nsUInt32)nsTaskPriority::EarlyNextFrame; i <= (nsUInt32)nsTaskPriority::LateNextFrame; ++i)
+  for (nsUInt32 uiSubLevel = 0; uiSubLevel < nsTaskQueueLevel::SubLevelsPerFrame; ++uiSubLevel)
   {
-    auto it = s_pState->m_Tasks[i].GetIterator();
+    const nsUInt32 uiLevel = nsTaskQueueLevel::FromFrameSlot(uiFrame, -static_cast<nsInt32>(nsTaskQueueLevel::OverdueFrameSlots), uiSubLevel);
 
-    // move all 'next frame' tasks into the 'this frame' queues
-    while (it.IsValid())
+    TaskData td;
+    while (s_pState->m_QueuedTasks[uiLevel].m_iCount > 0 && TakeQueuedTask(uiLevel, false, nullptr, td))
     {
-      s_pState->m_Tasks[i - 3].PushBack(*it);
+      s_pState->m_QueuedTasks[uiLevel].m_iCount.Decrement();
 
-      ++it;
+      pOwnQueues->m_Queues[uiTargetLevel].PushBottom(std::move(td));
+      s_pState->m_QueuedTasks[uiTargetLevel].m_iCount.Increment();
     }
 
-    // remove the tasks from their current queue
-    s_pState->m_Tasks[i].Clear();
-  }
-
-  for (nsUInt32 i = (nsUInt32)nsTaskPriority::In2Frames; i <= (nsUInt32)nsTaskPriority::In9Frames; ++i)
-  {
-    auto it = s_pState->m_Tasks[i].GetIterator();
+    // the tasks with a deadline keep their order
+    const nsInt32 iNumDeadlineTasks = static_cast<nsInt32>(s_pState->m_DeadlineQueues[uiLevel].MoveAllTo(s_pState->m_DeadlineQueues[uiTargetLevel]));
 
-    // move all 'in N frames' tasks into the 'in N-1 frames' queues
-    // moves 'In2Frames' into 'LateNextFrame'
-    while (it.IsValid())
+    if (iNumDeadlineTasks > 0)
     {
-      s_pState->m_Tasks[i - 1].PushBack(*it);
-
-      ++it;
+      s_pState->m_QueuedTasks[uiLevel].m_iCount.Subtract(iNumDeadlineTasks);
+      s_pState->m_QueuedTasks[uiTargetLevel].m_iCount.Add(iNumDeadlineTasks);
     }
-
-    // remove the tasks from their current queue
-    s_pState->m_Tasks[i].Clear();
   }
+
+  // this turns all 'next frame' queues into 'this frame' queues, all 'in 2 frames' queues into 'next frame' queues and so on
+  // tasks that are still in the 'this frame' queues are now overdue and get picked up before everything else
+  s_pState->m_iCurrentFrame.Increment();
 }
 
 void nsTaskSystem::ExecuteSomeFrameTasks(nsTime smoothFrameTime)
@@ -313,16 +609,13 @@ void nsTaskSystem::ExecuteSomeFrameTasks(nsTime smoothFrameTime)
     CurTime = nsTime::Now();
   }
 
-  nsUInt32 uiNumTasksTodo = 0;
+  const nsInt32 iNumTasksTodo = s_pState->m_QueuedTasks[nsTaskQueueLevel::FromPriority(nsTaskPriority::SomeFrameMainThread, 0)].m_iCount;
 
-  {
-    NS_LOCK(s_TaskSystemMutex);
-    uiNumTasksTodo = s_pState->m_Tasks[nsTaskPriority::SomeFrameMainThread].GetCount();
-  }
-
-  if (uiNumTasksTodo == 0)
+  if (iNumTasksTodo <= 0)
     return;
 
+  const nsUInt32 uiNumTasksTodo = static_cast<nsUInt32>(iNumTasksTodo);
+
   if (CurTime - LastTime < s_FrameTimeThreshold) // the accumulating threshold has caught up with us
   {
     // don't reset the threshold, from now on we execute at least one task per frame
@@ -381,11 +674,7 @@ void nsTaskSystem::FinishFrameTasks()
 
   // all the important tasks for this frame should be finished or worked on by now
   // so we can now re-prioritize the tasks for the next frame
-  {
-    NS_LOCK(s_TaskSystemMutex);
-
-    ReprioritizeFrameTasks();
-  }
+  ReprioritizeFrameTasks();
 
   ExecuteSomeFrameTasks(s_pState->m_TargetFrameTime);
 
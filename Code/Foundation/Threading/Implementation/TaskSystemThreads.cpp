@@ -22,7 +22,7 @@ void nsTaskSystem::SetWorkerThreadCount(nsInt32 iShortTasks, nsInt32 iLongTasks)
   * NOTE(Mikael A.): So, for ApertureUI, we allocate threads based on the requested amount from the user.
   * TODO:
   */
-  nsSystemInformation info = nsSystemInformation::Get();
+  const nsSystemInformation& info = nsSystemInformation::Get();
 
   // these settings are supposed to be a sensible default for most applications
   // an app can of course change that to optimize for its own usage
@@ -107,6 +107,28 @@ void nsTaskSystem::StopWorkerThreads()
     s_pThreadState->m_uiMaxWorkersToUse[type] = 0;
     s_pThreadState->m_Workers[type].Clear();
   }
+
+  // tasks that are still queued in the queues of the stopped threads are moved into the injection queues, where any thread can take them
+  {
+    NS_LOCK(s_pThreadState->m_InjectionMutex);
+
+    nsTaskQueueSet* pInjectionQueues = s_pThreadState->m_pInjectionQueues;
+
+    for (nsUInt32 type = 0; type < nsWorkerThreadType::ENUM_COUNT; ++type)
+    {
+      for (nsTaskQueueSet* pQueues : s_pThreadState->m_WorkerQueueSets[type])
+      {
+        for (nsUInt32 uiLevel = 0; uiLevel < nsTaskQueueLevel::Count; ++uiLevel)
+        {
+          TaskData td;
+          while (pQueues->m_Queues[uiLevel].PopBottom(td, nullptr, nullptr))
+          {
+            pInjectionQueues->m_Queues[uiLevel].PushBottom(std::move(td));
+          }
+        }
+      }
+    }
+  }
 }
 
 void nsTaskSystem::AllocateThreads(nsWorkerThreadType::Enum type, nsUInt32 uiAddThreads)
@@ -122,9 +144,26 @@ void nsTaskSystem::AllocateThreads(nsWorkerThreadType::Enum type, nsUInt32 uiAdd
     NS_ASSERT_ALWAYS(uiNextThreadIdx + uiAddThreads <= s_pThreadState->m_Workers[type].GetCount(), "Max number of worker threads ({}) exceeded.",
       s_pThreadState->m_Workers[type].GetCount());
 
+    nsDynamicArray<nsTaskQueueSet*>& queueSets = s_pThreadState->m_WorkerQueueSets[type];
+
     for (nsUInt32 i = 0; i < uiAddThreads; ++i)
     {
-      s_pThreadState->m_Workers[type][uiNextThreadIdx] = NS_DEFAULT_NEW(nsTaskWorkerThread, (nsWorkerThreadType::Enum)type, uiNextThreadIdx);
+      if (uiNextThreadIdx == queueSets.GetCount())
+      {
+        const nsUInt32 uiQueueSetIdx = s_pThreadState->m_iNumQueueSets;
+        NS_ASSERT_ALWAYS(uiQueueSetIdx < nsTaskSystemThreadState::MaxQueueSets, "Max number of task queue sets exceeded.");
+
+        nsTaskQueueSet* pQueues = NS_NEW(&s_pThreadState->m_Allocator, nsTaskQueueSet);
+        queueSets.PushBack(pQueues);
+
+        // make the new queues visible to the other threads only after the pointer has been stored
+        s_pThreadState->m_QueueSets[uiQueueSetIdx] = pQueues;
+        s_pThreadState->m_iNumQueueSets = uiQueueSetIdx + 1;
+      }
+
+      const nsTaskWorkerPlacement placement = ComputeWorkerPlacement(type, uiNextThreadIdx);
+
+      s_pThreadState->m_Workers[type][uiNextThreadIdx] = NS_DEFAULT_NEW(nsTaskWorkerThread, (nsWorkerThreadType::Enum)type, uiNextThreadIdx, queueSets[uiNextThreadIdx], placement);
       s_pThreadState->m_Workers[type][uiNextThreadIdx]->Start();
 
       ++uiNextThreadIdx;
@@ -197,6 +236,80 @@ double nsTaskSystem::GetThreadUtilization(nsWorkerThreadType::Enum type, nsUInt3
   return s_pThreadState->m_Workers[type][uiThreadIndex]->GetThreadUtilization(pNumTasksExecuted);
 }
 
+void nsTaskSystem::SetWorkerThreadPinning(bool bPinShortTaskWorkers)
+{
+  if (s_pThreadState->m_bPinShortTaskWorkers == bPinShortTaskWorkers)
+    return;
+
+  const nsUInt32 uiShortTasks = s_pThreadState->m_uiMaxWorkersToUse[nsWorkerThreadType::ShortTasks];
+  const nsUInt32 uiLongTasks = s_pThreadState->m_uiMaxWorkersToUse[nsWorkerThreadType::LongTasks];
+
+  // the workers only pin themselves when they start
+  StopWorkerThreads();
+
+  s_pThreadState->m_bPinShortTaskWorkers = bPinShortTaskWorkers;
+  s_pThreadState->m_PlacementOrder.Clear();
+
+  if (bPinShortTaskWorkers)
+  {
+    const nsCpuTopology& topology = nsSystemInformation::Get().GetCpuTopology();
+
+    for (nsUInt32 i = 0; i < topology.m_uiNumLogicalProcessors; ++i)
+    {
+      s_pThreadState->m_PlacementOrder.PushBack(static_cast<nsUInt16>(i));
+    }
+
+    // one hardware thread of every core first, so that workers don't compete for the same core,
+    // and cache domain by cache domain, so that the workers share as few caches as possible
+    s_pThreadState->m_PlacementOrder.Sort([&](nsUInt16 a, nsUInt16 b)
+      {
+        const nsCpuTopology::LogicalProcessor& lpA = topology.m_LogicalProcessors[a];
+        const nsCpuTopology::LogicalProcessor& lpB = topology.m_LogicalProcessors[b];
+
+        if (lpA.m_uiSiblingIndex != lpB.m_uiSiblingIndex)
+          return lpA.m_uiSiblingIndex < lpB.m_uiSiblingIndex;
+        if (lpA.m_uiPackage != lpB.m_uiPackage)
+          return lpA.m_uiPackage < lpB.m_uiPackage;
+        if (lpA.m_uiCacheDomain != lpB.m_uiCacheDomain)
+          return lpA.m_uiCacheDomain < lpB.m_uiCacheDomain;
+
+        return a < b;
+      });
+  }
+
+  nsLog::Dev("{} the short task worker threads.", bPinShortTaskWorkers ? "Pinning" : "Unpinning");
+
+  SetWorkerThreadCount(uiShortTasks, uiLongTasks);
+}
+
+bool nsTaskSystem::GetWorkerThreadPinning()
+{
+  return s_pThreadState->m_bPinShortTaskWorkers;
+}
+
+nsTaskWorkerPlacement nsTaskSystem::GetWorkerThreadPlacement(nsWorkerThreadType::Enum type, nsUInt32 uiThreadIndex)
+{
+  return s_pThreadState->m_Workers[type][uiThreadIndex]->GetPlacement();
+}
+
+nsTaskWorkerPlacement nsTaskSystem::ComputeWorkerPlacement(nsWorkerThreadType::Enum type, nsUInt32 uiThreadIndex)
+{
+  nsTaskWorkerPlacement placement;
+
+  if (type != nsWorkerThreadType::ShortTasks || s_pThreadState->m_PlacementOrder.IsEmpty())
+    return placement;
+
+  // additional threads that replace blocked ones start over at the first processors, those workers are rarely all active at the same time
+  const nsCpuTopology& topology = nsSystemInformation::Get().GetCpuTopology();
+  const nsCpuTopology::LogicalProcessor& lp = topology.m_LogicalProcessors[s_pThreadState->m_PlacementOrder[uiThreadIndex % s_pThreadState->m_PlacementOrder.GetCount()]];
+
+  placement.m_iProcessorIndex = lp.m_uiProcessorIndex;
+  placement.m_iCore = lp.m_uiCore;
+  placement.m_iCacheDomain = lp.m_uiCacheDomain;
+  placement.m_iPackage = lp.m_uiPackage;
+  return placement;
+}
+
 void nsTaskSystem::DetermineTasksToExecuteOnThread(nsTaskPriority::Enum& out_FirstPriority, nsTaskPriority::Enum& out_LastPriority)
 {
   switch (tl_TaskWorkerInfo.m_WorkerType)
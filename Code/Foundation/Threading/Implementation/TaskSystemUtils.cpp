@@ -27,10 +27,122 @@ const char* nsWorkerThreadType::GetThreadTypeName(nsWorkerThreadType::Enum threa
   }
 }
 
+const char* nsTaskPriority::GetPriorityName(nsTaskPriority::Enum priority)
+{
+  switch (priority)
+  {
+    case nsTaskPriority::EarlyThisFrame:
+      return "EarlyThisFrame";
+
+    case nsTaskPriority::ThisFrame:
+      return "ThisFrame";
+
+    case nsTaskPriority::LateThisFrame:
+      return "LateThisFrame";
+
+    case nsTaskPriority::EarlyNextFrame:
+      return "EarlyNextFrame";
+
+    case nsTaskPriority::NextFrame:
+      return "NextFrame";
+
+    case nsTaskPriority::LateNextFrame:
+      return "LateNextFrame";
+
+    case nsTaskPriority::In2Frames:
+      return "In 2 Frames";
+
+    case nsTaskPriority::In3Frames:
+      return "In 3 Frames";
+
+    case nsTaskPriority::In4Frames:
+      return "In 4 Frames";
+
+    case nsTaskPriority::In5Frames:
+      return "In 5 Frames";
+
+    case nsTaskPriority::In6Frames:
+      return "In 6 Frames";
+
+    case nsTaskPriority::In7Frames:
+      return "In 7 Frames";
+
+    case nsTaskPriority::In8Frames:
+      return "In 8 Frames";
+
+    case nsTaskPriority::In9Frames:
+      return "In 9 Frames";
+
+    case nsTaskPriority::LongRunningHighPriority:
+      return "LongRunningHighPriority";
+
+    case nsTaskPriority::LongRunning:
+      return "LongRunning";
+
+    case nsTaskPriority::FileAccessHighPriority:
+      return "FileAccessHighPriority";
+
+    case nsTaskPriority::FileAccess:
+      return "FileAccess";
+
+    case nsTaskPriority::ThisFrameMainThread:
+      return "ThisFrameMainThread";
+
+    case nsTaskPriority::SomeFrameMainThread:
+      return "SomeFrameMainThread";
+
+    default:
+      NS_REPORT_FAILURE("Invalid Task Priority");
+      return "unknown";
+  }
+}
+
+namespace
+{
+  struct nsTaskGroupSnapshot
+  {
+    const nsTaskGroup* m_pGroup = nullptr;
+    nsUInt32 m_uiIndex = 0;
+    nsUInt32 m_uiGroupCounter = 0;
+    bool m_bStartedByUser = false;
+    nsInt32 m_iNumActiveDependencies = 0;
+    nsTaskPriority::Enum m_Priority = nsTaskPriority::ThisFrame;
+    nsHybridArray<nsSharedPtr<nsTask>, 16> m_Tasks;
+    nsHybridArray<nsTaskGroupID, 4> m_DependsOnGroups;
+  };
+} // namespace
+
 void nsTaskSystem::WriteStateSnapshotToDGML(nsDGMLGraph& ref_graph)
 {
-  NS_LOCK(s_TaskSystemMutex);
+  nsDynamicArray<nsTaskGroupSnapshot> groups;
+
+  {
+    // prevents new task groups from being allocated
+    NS_LOCK(s_pState->m_TaskGroupAllocationMutex);
+
+    for (nsUInt32 g = 0; g < s_pState->m_uiNumTaskGroups; ++g)
+    {
+      const nsTaskGroup& tg = s_pState->GetTaskGroup(g);
+
+      // the task and dependency arrays are only modified while holding this lock, see AddTaskToGroup() and TaskHasFinished()
+      NS_LOCK(tg.m_CondVarGroupFinished);
 
+      if (!tg.m_bInUse)
+        continue;
+
+      nsTaskGroupSnapshot& snapshot = groups.ExpandAndGetRef();
+      snapshot.m_pGroup = &tg;
+      snapshot.m_uiIndex = g;
+      snapshot.m_uiGroupCounter = tg.m_uiGroupCounter;
+      snapshot.m_bStartedByUser = tg.m_bStartedByUser;
+      snapshot.m_iNumActiveDependencies = tg.m_iNumActiveDependencies;
+      snapshot.m_Priority = tg.m_Priority;
+      snapshot.m_Tasks = tg.m_Tasks;
+      snapshot.m_DependsOnGroups = tg.m_DependsOnGroups;
+    }
+  }
+
+  nsHashTable<const nsTaskGroup*, const nsTaskGroupSnapshot*> snapshotByGroup;
   nsHashTable<const nsTaskGroup*, nsDGMLGraph::NodeId> groupNodeIds;
 
   nsStringBuilder title, tmp;
@@ -51,44 +163,19 @@ void nsTaskSystem::WriteStateSnapshotToDGML(nsDGMLGraph& ref_graph)
   const nsDGMLGraph::PropertyId remainingRunsId = ref_graph.AddPropertyType("RemainingRuns");
   const nsDGMLGraph::PropertyId priorityId = ref_graph.AddPropertyType("GroupPriority");
 
-  const char* szTaskPriorityNames[nsTaskPriority::ENUM_COUNT] = {};
-  szTaskPriorityNames[nsTaskPriority::EarlyThisFrame] = "EarlyThisFrame";
-  szTaskPriorityNames[nsTaskPriority::ThisFrame] = "ThisFrame";
-  szTaskPriorityNames[nsTaskPriority::LateThisFrame] = "LateThisFrame";
-  szTaskPriorityNames[nsTaskPriority::EarlyNextFrame] = "EarlyNextFrame";
-  szTaskPriorityNames[nsTaskPriority::NextFrame] = "NextFrame";
-  szTaskPriorityNames[nsTaskPriority::LateNextFrame] = "LateNextFrame";
-  szTaskPriorityNames[nsTaskPriority::In2Frames] = "In 2 Frames";
-  szTaskPriorityNames[nsTaskPriority::In3Frames] = "In 3 Frames";
-  szTaskPriorityNames[nsTaskPriority::In4Frames] = "In 4 Frames";
-  szTaskPriorityNames[nsTaskPriority::In5Frames] = "In 5 Frames";
-  szTaskPriorityNames[nsTaskPriority::In6Frames] = "In 6 Frames";
-  szTaskPriorityNames[nsTaskPriority::In7Frames] = "In 7 Frames";
-  szTaskPriorityNames[nsTaskPriority::In8Frames] = "In 8 Frames";
-  szTaskPriorityNames[nsTaskPriority::In9Frames] = "In 9 Frames";
-  szTaskPriorityNames[nsTaskPriority::LongRunningHighPriority] = "LongRunningHighPriority";
-  szTaskPriorityNames[nsTaskPriority::LongRunning] = "LongRunning";
-  szTaskPriorityNames[nsTaskPriority::FileAccessHighPriority] = "FileAccessHighPriority";
-  szTaskPriorityNames[nsTaskPriority::FileAccess] = "FileAccess";
-  szTaskPriorityNames[nsTaskPriority::ThisFrameMainThread] = "ThisFrameMainThread";
-  szTaskPriorityNames[nsTaskPriority::SomeFrameMainThread] = "SomeFrameMainThread";
-
-  for (nsUInt32 g = 0; g < s_pState->m_TaskGroups.GetCount(); ++g)
+  for (const nsTaskGroupSnapshot& tg : groups)
   {
-    const nsTaskGroup& tg = s_pState->m_TaskGroups[g];
-
-    if (!tg.m_bInUse)
-      continue;
-
-    title.SetFormat("Group {}", g);
+    title.SetFormat("Group {}", tg.m_uiIndex);
 
     const nsDGMLGraph::NodeId taskGroupId = ref_graph.AddGroup(title, nsDGMLGraph::GroupType::Expanded, &taskGroupND);
-    groupNodeIds[&tg] = taskGroupId;
+    groupNodeIds[tg.m_pGroup] = taskGroupId;
+    snapshotByGroup[tg.m_pGroup] = &tg;
 
     ref_graph.AddNodeProperty(taskGroupId, startedByUserId, tg.m_bStartedByUser ? "true" : "false");
-    ref_graph.AddNodeProperty(taskGroupId, priorityId, szTaskPriorityNames[tg.m_Priority]);
+    ref_graph.AddNodeProperty(taskGroupId, priorityId, nsTaskPriority::GetPriorityName(tg.m_Priority));
     ref_graph.AddNodeProperty(taskGroupId, activeDepsId, nsFmt("{}", tg.m_iNumActiveDependencies));
 
+    // the snapshot holds a reference to the tasks, their state may still change while it is read
     for (nsUInt32 t = 0; t < tg.m_Tasks.GetCount(); ++t)
     {
       const nsTask& task = *tg.m_Tasks[t];
@@ -107,26 +194,19 @@ void nsTaskSystem::WriteStateSnapshotToDGML(nsDGMLGraph& ref_graph)
     }
   }
 
-  for (nsUInt32 g = 0; g < s_pState->m_TaskGroups.GetCount(); ++g)
+  for (const nsTaskGroupSnapshot& tg : groups)
   {
-    const nsTaskGroup& tg = s_pState->m_TaskGroups[g];
-
-    if (!tg.m_bInUse)
-      continue;
-
-    const nsDGMLGraph::NodeId ownNodeId = groupNodeIds[&tg];
+    const nsDGMLGraph::NodeId ownNodeId = groupNodeIds[tg.m_pGroup];
 
     for (const nsTaskGroupID& dependsOn : tg.m_DependsOnGroups)
     {
-      nsDGMLGraph::NodeId otherNodeId;
+      const nsTaskGroupSnapshot* pOther = nullptr;
 
       // filter out already fulfilled dependencies
-      if (dependsOn.m_pTaskGroup->m_uiGroupCounter != dependsOn.m_uiGroupCounter)
+      if (!snapshotByGroup.TryGetValue(dependsOn.m_pTaskGroup, pOther) || pOther->m_uiGroupCounter != dependsOn.m_uiGroupCounter)
         continue;
 
-      // filter out already fulfilled dependencies
-      if (!groupNodeIds.TryGetValue(dependsOn.m_pTaskGroup, otherNodeId))
-        continue;
+      const nsDGMLGraph::NodeId otherNodeId = groupNodeIds[dependsOn.m_pTaskGroup];
 
       NS_ASSERT_DEBUG(otherNodeId != ownNodeId, "");
 
@@ -13,12 +13,15 @@ static nsString GenerateThreadName(nsWorkerThreadType::Enum threadType, nsUInt32
   return sTemp;
 }
 
-nsTaskWorkerThread::nsTaskWorkerThread(nsWorkerThreadType::Enum threadType, nsUInt32 uiThreadNumber)
+nsTaskWorkerThread::nsTaskWorkerThread(
+  nsWorkerThreadType::Enum threadType, nsUInt32 uiThreadNumber, nsTaskQueueSet* pQueues, const nsTaskWorkerPlacement& placement)
   // We need at least 256 kb of stack size, otherwise the shader compilation tasks will run out of stack space.
   : nsThread(GenerateThreadName(threadType, uiThreadNumber), 256 * 1024)
 {
   m_WorkerType = threadType;
   m_uiWorkerThreadNumber = uiThreadNumber & 0xFFFF;
+  m_pQueues = pQueues;
+  m_Placement = placement;
 }
 
 nsTaskWorkerThread::~nsTaskWorkerThread() = default;
@@ -49,6 +52,17 @@ nsUInt32 nsTaskWorkerThread::Run()
   tl_TaskWorkerInfo.m_WorkerType = m_WorkerType;
   tl_TaskWorkerInfo.m_iWorkerIndex = m_uiWorkerThreadNumber;
   tl_TaskWorkerInfo.m_pWorkerState = &m_iWorkerState;
+  tl_TaskWorkerInfo.m_pQueues = m_pQueues;
+
+  if (m_Placement.IsPinned() && nsThreadUtils::SetCurrentThreadAffinity(m_Placement.m_iProcessorIndex).Failed())
+  {
+    // e.g. the process is not allowed to run on that processor, the thread just keeps floating then
+    m_Placement = nsTaskWorkerPlacement();
+  }
+
+  // the queue set may have belonged to a thread with a different placement before
+  tl_TaskWorkerInfo.m_iCacheDomain = m_Placement.m_iCacheDomain;
+  m_pQueues->m_iCacheDomain = m_Placement.m_iCacheDomain;
 
   const bool bIsReserve = m_uiWorkerThreadNumber >= nsTaskSystem::s_pThreadState->m_uiMaxWorkersToUse[m_WorkerType];
 
@@ -68,6 +82,15 @@ nsUInt32 nsTaskWorkerThread::Run()
 
     if (!nsTaskSystem::ExecuteTask(FirstPriority, LastPriority, false, nsTaskGroupID(), &m_iWorkerState))
     {
+      // Tasks are queued without a lock, so some may have been queued after this thread looked for work, but before it was marked as idle.
+      // The scheduling thread only looks at the worker states after queuing its tasks, so either it sees this thread as idle and wakes it up,
+      // or this check sees the new tasks.
+      if (nsTaskSystem::HasQueuedTasks(FirstPriority, LastPriority) &&
+          m_iWorkerState.TestAndSet((int)nsTaskWorkerState::Idle, (int)nsTaskWorkerState::Active))
+      {
+        continue;
+      }
+
       WaitForWork();
     }
     else
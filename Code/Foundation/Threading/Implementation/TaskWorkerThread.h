@@ -5,6 +5,8 @@
 #include <Foundation/Threading/Thread.h>
 #include <Foundation/Threading/ThreadSignal.h>
 
+class nsTaskQueueSet;
+
 /// \internal Internal task worker thread class.
 class nsTaskWorkerThread final : public nsThread
 {
@@ -14,13 +16,16 @@ class nsTaskWorkerThread final : public nsThread
   ///@{
 
 public:
-  /// \brief Tells the worker thread what tasks to execute and which thread index it has.
-  nsTaskWorkerThread(nsWorkerThreadType::Enum threadType, nsUInt32 uiThreadNumber);
+  /// \brief Tells the worker thread what tasks to execute, which thread index it has, which task queues it owns and where it should run.
+  nsTaskWorkerThread(nsWorkerThreadType::Enum threadType, nsUInt32 uiThreadNumber, nsTaskQueueSet* pQueues, const nsTaskWorkerPlacement& placement);
   ~nsTaskWorkerThread();
 
   /// \brief Deactivates the thread. Returns failure, if the thread is currently still running.
   nsResult DeactivateWorker();
 
+  /// \brief Returns where the thread runs. Only pinned, once the thread has started and was able to set its affinity.
+  const nsTaskWorkerPlacement& GetPlacement() const { return m_Placement; }
+
 private:
   // Which types of tasks this thread should work on.
   nsWorkerThreadType::Enum m_WorkerType;
@@ -31,6 +36,12 @@ private:
   // For display purposes.
   nsUInt16 m_uiWorkerThreadNumber = 0xFFFF;
 
+  // The work-stealing queues that this thread pushes new tasks into and prefers to take tasks from.
+  nsTaskQueueSet* m_pQueues = nullptr;
+
+  // The logical processor that this thread pins itself to, reset in Run() if that fails.
+  nsTaskWorkerPlacement m_Placement;
+
   ///@}
 
   /// \name Thread Utilization
@@ -85,6 +96,9 @@ struct nsTaskWorkerInfo
   nsInt32 m_iWorkerIndex = -1;
   const char* m_szTaskName = nullptr;
   nsAtomicInteger32* m_pWorkerState = nullptr;
+  nsTaskQueueSet* m_pQueues = nullptr; // null for threads that are not managed by the task system
+  nsUInt32 m_uiStealSeed = 0;          // random state for picking the threads to steal tasks from
+  nsInt32 m_iCacheDomain = -1;         // the cache domain of the processor that the thread is pinned to, -1 if it is not pinned
 };
 
 extern thread_local nsTaskWorkerInfo tl_TaskWorkerInfo;
@@ -23,3 +23,51 @@ private:
 
 /// \brief Shortcut for nsLock<Type> l(lock)
 #define NS_LOCK(lock) nsLock<decltype(lock)> NS_PP_CONCAT(l_, NS_SOURCE_LINE)(lock)
+
+/// \brief Manages a shared lock on a read-write lock (e.g. nsReadWriteLock) and releases it as the lock object goes out of scope.
+template <typename T>
+class nsReadLock
+{
+public:
+  NS_ALWAYS_INLINE explicit nsReadLock(T& ref_lock)
+    : m_Lock(ref_lock)
+  {
+    m_Lock.LockRead();
+  }
+
+  NS_ALWAYS_INLINE ~nsReadLock() { m_Lock.UnlockRead(); }
+
+private:
+  nsReadLock();
+  nsReadLock(const nsReadLock<T>& rhs);
+  void operator=(const nsReadLock<T>& rhs);
+
+  T& m_Lock;
+};
+
+/// \brief Manages an exclusive lock on a read-write lock (e.g. nsReadWriteLock) and releases it as the lock object goes out of scope.
+template <typename T>
+class nsWriteLock
+{
+public:
+  NS_ALWAYS_INLINE explicit nsWriteLock(T& ref_lock)
+    : m_Lock(ref_lock)
+  {
+    m_Lock.LockWrite();
+  }
+
+  NS_ALWAYS_INLINE ~nsWriteLock() { m_Lock.UnlockWrite(); }
+
+private:
+  nsWriteLock();
+  nsWriteLock(const nsWriteLock<T>& rhs);
+  void operator=(const nsWriteLock<T>& rhs);
+
+  T& m_Lock;
+};
+
+/// \brief Shortcut for nsReadLock<Type> l(lock)
+#define NS_LOCK_READ(lock) nsReadLock<decltype(lock)> NS_PP_CONCAT(l_, NS_SOURCE_LINE)(lock)
+
+/// \brief Shortcut for nsWriteLock<Type> l(lock)
+#define NS_LOCK_WRITE(lock) nsWriteLock<decltype(lock)> NS_PP_CONCAT(l_, NS_SOURCE_LINE)(lock)
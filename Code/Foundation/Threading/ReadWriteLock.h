@@ -0,0 +1,64 @@
+#pragma once
+
+#include <Foundation/Threading/AtomicInteger.h>
+#include <Foundation/Threading/Mutex.h>
+
+/// \brief A lock that can be held by many readers at the same time, or by a single writer.
+///
+/// Meant for data that is read very often from many threads and modified rarely, such as registries that are filled during startup.
+/// As long as no writer is active, taking a read lock costs one atomic increment on the shared state plus a look-up in a small
+/// thread-local table, so readers don't serialize on each other. That table records on which locks the thread holds read locks,
+/// which may be at most 16 different locks at the same time. Threads that already hold a read lock on the same lock are let in even
+/// while a writer is pending, so that nested read locks can't deadlock with it.
+///
+/// Writers are serialized through a mutex. A pending writer blocks new readers, which then wait on the writer mutex. The writer itself
+/// doesn't sleep on anything while the active readers finish, it spins and then repeatedly yields its time slice. That is fine for
+/// short read sections, but long read sections make a waiting writer burn CPU time.
+///
+/// The write lock is recursive, and a thread that holds the write lock may also take read locks.
+/// A thread that holds a read lock must not try to take the write lock, that would deadlock.
+///
+/// Use NS_LOCK_READ and NS_LOCK_WRITE to make sure the lock is always properly released.
+///
+/// \sa nsMutex, nsSeqLock
+class NS_FOUNDATION_DLL nsReadWriteLock
+{
+  NS_DISALLOW_COPY_AND_ASSIGN(nsReadWriteLock);
+
+public:
+  nsReadWriteLock();
+  ~nsReadWriteLock();
+
+  /// \brief Acquires a shared lock. Blocks while another thread holds the write lock.
+  void LockRead();
+
+  /// \brief Releases a shared lock that has been previously acquired with LockRead().
+  void UnlockRead();
+
+  /// \brief Acquires the exclusive lock. Blocks until all readers and other writers have released the lock.
+  void LockWrite();
+
+  /// \brief Releases the exclusive lock that has been previously acquired with LockWrite().
+  void UnlockWrite();
+
+  /// \brief Returns true, if the write lock is currently acquired. Can be used to assert that a lock was entered.
+  ///
+  /// Same as nsMutex::IsLocked(), this check is not thread-safe.
+  bool IsLockedForWriting() const { return (m_iState & WriterActiveBit) != 0; }
+
+private:
+  enum
+  {
+    WriterActiveBit = 1 << 29,
+    WriterPendingBit = 1 << 30,
+    WriterBits = WriterActiveBit | WriterPendingBit,
+  };
+
+  void LockReadContended();
+  void UnlockReadContended();
+
+  // the number of active readers, plus the writer bits while a writer waits for or holds the lock
+  nsAtomicInteger32 m_iState;
+  nsMutex m_WriterMutex;
+  nsUInt32 m_uiWriteRecursion = 0;
+};
@@ -0,0 +1,90 @@
+#pragma once
+
+#include <Foundation/Threading/AtomicInteger.h>
+#include <Foundation/Threading/ThreadUtils.h>
+
+#include <atomic>
+
+/// \brief Protects a small, trivially copyable value that is written rarely and read very often from many threads.
+///
+/// Readers never block and never write to shared memory. They copy the value and retry, if a writer modified it in the meantime.
+/// This makes reads much cheaper than with a mutex or nsReadWriteLock, because the cache line with the lock is never contended.
+/// In exchange, a read copies the whole value, so this is only a good fit for small data, e.g. a few settings or a time value.
+///
+/// Writers are serialized among each other through the sequence counter, but they should be rare.
+template <typename T>
+class nsSeqLock
+{
+  static_assert(std::is_trivially_copyable<T>::value, "nsSeqLock only supports trivially copyable types.");
+
+  NS_DISALLOW_COPY_AND_ASSIGN(nsSeqLock);
+
+public:
+  nsSeqLock() = default;
+
+  explicit nsSeqLock(const T& value)
+    : m_Value(value)
+  {
+  }
+
+  /// \brief Returns a consistent copy of the value.
+  T Read() const
+  {
+    T result;
+
+    while (true)
+    {
+      const nsInt32 iSequence = m_iSequence;
+
+      if ((iSequence & 1) == 0)
+      {
+        nsMemoryUtils::RawByteCopy(&result, &m_Value, sizeof(T));
+
+        // the copy above must be done before the sequence is read again
+        std::atomic_thread_fence(std::memory_order_acquire);
+
+        if (m_iSequence == iSequence)
+          return result;
+      }
+
+      nsThreadUtils::YieldHardwareThread();
+    }
+  }
+
+  /// \brief Replaces the value. Readers that run at the same time will retry.
+  void Write(const T& value)
+  {
+    const nsInt32 iSequence = BeginWrite();
+    nsMemoryUtils::RawByteCopy(&m_Value, &value, sizeof(T));
+    EndWrite(iSequence);
+  }
+
+  /// \brief Modifies the value in place through \a func, which is called with a reference to the value.
+  template <typename Func>
+  void Modify(Func func)
+  {
+    const nsInt32 iSequence = BeginWrite();
+    func(m_Value);
+    EndWrite(iSequence);
+  }
+
+private:
+  nsInt32 BeginWrite()
+  {
+    while (true)
+    {
+      const nsInt32 iSequence = m_iSequence;
+
+      // an odd sequence means another writer is active
+      if ((iSequence & 1) == 0 && m_iSequence.TestAndSet(iSequence, iSequence + 1))
+        return iSequence + 1;
+
+      nsThreadUtils::YieldHardwareThread();
+    }
+  }
+
+  void EndWrite(nsInt32 iSequence) { m_iSequence = iSequence + 1; }
+
+  nsAtomicInteger32 m_iSequence;
+  T m_Value = {};
+};
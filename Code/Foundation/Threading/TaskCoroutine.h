@@ -0,0 +1,365 @@
+#pragma once
+
+#include <Foundation/Threading/DelegateTask.h>
+#include <Foundation/Threading/TaskSystem.h>
+
+// Coroutines need C++20, while the engine itself is compiled as C++17. Everything in this file is header-only, so a library that opts
+// into C++20 can use it without Foundation being built with a different language standard. For C++17 code the file is empty.
+#if defined(__cpp_impl_coroutine) && __cpp_impl_coroutine >= 201902L && __has_include(<coroutine>)
+#  define NS_TASK_COROUTINES NS_ON
+#else
+#  define NS_TASK_COROUTINES NS_OFF
+#endif
+
+#if NS_ENABLED(NS_TASK_COROUTINES)
+
+#  include <coroutine>
+
+template <typename T>
+class nsTaskCoroutine;
+
+namespace nsInternal
+{
+  /// \internal Resumes \a hCoroutine on a thread that picks up tasks of the given priority, once \a dependency has finished.
+  inline void ResumeAsTask(std::coroutine_handle<> hCoroutine, nsTaskPriority::Enum priority, nsTaskGroupID dependency = nsTaskGroupID())
+  {
+    nsSharedPtr<nsTask> pTask = NS_NEW(nsTaskSystem::GetTaskAllocator(), nsDelegateTask<void>, "nsTaskCoroutine", nsTaskNesting::Maybe,
+      [hCoroutine]()
+      { hCoroutine.resume(); });
+
+    if (dependency.IsValid())
+      nsTaskSystem::StartSingleTask(pTask, priority, dependency);
+    else
+      nsTaskSystem::StartSingleTask(pTask, priority);
+  }
+
+  /// \internal The part of the coroutine promise that doesn't depend on the result type.
+  class nsTaskCoroutinePromiseBase
+  {
+  public:
+    /// \brief The priority with which the coroutine is resumed after it was suspended by one of the task system awaitables.
+    nsTaskPriority::Enum m_Priority = nsTaskPriority::ThisFrame;
+
+    bool m_bStarted = false;
+
+    // Either 0 (nobody awaits the coroutine), Finished, or the address of the coroutine that awaits this one.
+    nsAtomicInteger64 m_iContinuation;
+
+    // The priority of the awaiting coroutine, ENUM_COUNT if it isn't an nsTaskCoroutine. Written before m_iContinuation is set.
+    nsTaskPriority::Enum m_ContinuationPriority = nsTaskPriority::ENUM_COUNT;
+
+    static constexpr nsInt64 Finished = 1;
+
+    bool IsFinished() const { return m_iContinuation == Finished; }
+
+    struct FinalAwaiter
+    {
+      bool await_ready() const noexcept { return false; }
+
+      template <typename Promise>
+      std::coroutine_handle<> await_suspend(std::coroutine_handle<Promise> hCoroutine) noexcept
+      {
+        nsTaskCoroutinePromiseBase& promise = hCoroutine.promise();
+
+        // without a continuation the owner may destroy the frame as soon as the marker is set, so the promise must not be touched
+        // afterwards. Otherwise the owner is the suspended awaiting coroutine, which only continues once it gets resumed below.
+        const nsInt64 iContinuation = promise.m_iContinuation.Set(Finished);
+
+        if (iContinuation == 0)
+          return std::noop_coroutine();
+
+        std::coroutine_handle<> hContinuation = std::coroutine_handle<>::from_address(reinterpret_cast<void*>(iContinuation));
+
+        // the coroutine may have moved to another priority, the awaiting one must not silently continue on that thread
+        if (promise.m_ContinuationPriority != nsTaskPriority::ENUM_COUNT && promise.m_ContinuationPriority != promise.m_Priority)
+        {
+          ResumeAsTask(hContinuation, promise.m_ContinuationPriority);
+          return std::noop_coroutine();
+        }
+
+        return hContinuation;
+      }
+
+      void await_resume() const noexcept {}
+    };
+
+    std::suspend_always initial_suspend() const noexcept { return {}; }
+    FinalAwaiter final_suspend() const noexcept { return {}; }
+
+    void unhandled_exception() { NS_REPORT_FAILURE("Exceptions must not leave an nsTaskCoroutine."); }
+  };
+
+  template <typename T>
+  class nsTaskCoroutinePromise : public nsTaskCoroutinePromiseBase
+  {
+  public:
+    ~nsTaskCoroutinePromise()
+    {
+      if (m_bHasResult)
+      {
+        GetResult().~T();
+      }
+    }
+
+    nsTaskCoroutine<T> get_return_object();
+
+    template <typename U>
+    void return_value(U&& value)
+    {
+      new (m_Result) T(std::forward<U>(value));
+      m_bHasResult = true;
+    }
+
+    T& GetResult()
+    {
+      NS_ASSERT_DEV(m_bHasResult, "The coroutine has not returned a value yet.");
+      return *reinterpret_cast<T*>(m_Result);
+    }
+
+  private:
+    alignas(T) nsUInt8 m_Result[sizeof(T)];
+    bool m_bHasResult = false;
+  };
+
+  template <>
+  class nsTaskCoroutinePromise<void> : public nsTaskCoroutinePromiseBase
+  {
+  public:
+    nsTaskCoroutine<void> get_return_object();
+
+    void return_void() {}
+
+    void GetResult() {}
+  };
+
+  /// \internal Returns the priority of the awaiting coroutine, if it is an nsTaskCoroutine, otherwise \a fallback.
+  template <typename Promise>
+  nsTaskPriority::Enum GetAwaitingPriority(std::coroutine_handle<Promise> hAwaiting, nsTaskPriority::Enum fallback)
+  {
+    if constexpr (std::is_base_of_v<nsTaskCoroutinePromiseBase, Promise>)
+      return hAwaiting.promise().m_Priority;
+    else
+      return fallback;
+  }
+} // namespace nsInternal
+
+/// \brief A coroutine that runs on the task system and can suspend itself until task groups or other coroutines have finished.
+///
+/// Instead of blocking a worker thread in nsTaskSystem::WaitForGroup(), a coroutine can 'co_await' an nsTaskGroupID. The coroutine is
+/// then suspended and the thread is free to work on other tasks. Once the group has finished, the coroutine gets resumed by a task
+/// of the coroutine's priority, so a coroutine started with a main thread priority always continues on the main thread.
+///
+/// A coroutine does nothing until it is either started through Start() or awaited by another coroutine. An awaited coroutine runs
+/// with the priority of the coroutine that awaits it and hands control back to it when it returns. If it moved to another priority
+/// in the mean time, the awaiting coroutine is resumed by a task of its own priority instead.
+///
+/// The nsTaskCoroutine object owns the coroutine state. It must not be destroyed while the coroutine is suspended somewhere in
+/// between, use Wait() or IsFinished() to make sure it has returned.
+///
+/// \code{.cpp}
+///   nsTaskCoroutine<nsUInt32> LoadAndCount()
+///   {
+///     co_await nsTaskSystem::StartSingleTask(pLoadTask, nsTaskPriority::LongRunning);
+///     co_return CountEntries();
+///   }
+/// \endcode
+template <typename T = void>
+class nsTaskCoroutine
+{
+  NS_DISALLOW_COPY_AND_ASSIGN(nsTaskCoroutine);
+
+public:
+  using promise_type = nsInternal::nsTaskCoroutinePromise<T>;
+  using Handle = std::coroutine_handle<promise_type>;
+
+  nsTaskCoroutine() = default;
+
+  explicit nsTaskCoroutine(Handle hCoroutine)
+    : m_hCoroutine(hCoroutine)
+  {
+  }
+
+  nsTaskCoroutine(nsTaskCoroutine&& other)
+    : m_hCoroutine(other.m_hCoroutine)
+  {
+    other.m_hCoroutine = nullptr;
+  }
+
+  ~nsTaskCoroutine() { Destroy(); }
+
+  void operator=(nsTaskCoroutine&& other)
+  {
+    if (this != &other)
+    {
+      Destroy();
+      m_hCoroutine = other.m_hCoroutine;
+      other.m_hCoroutine = nullptr;
+    }
+  }
+
+  /// \brief Returns whether this object refers to a coroutine.
+  bool IsValid() const { return m_hCoroutine != nullptr; }
+
+  /// \brief Returns whether the coroutine has been started or awaited.
+  bool IsStarted() const { return m_hCoroutine.promise().m_bStarted; }
+
+  /// \brief Returns whether the coroutine has returned.
+  bool IsFinished() const { return m_hCoroutine.promise().IsFinished(); }
+
+  /// \brief Schedules the coroutine to run as a task with the given priority. The same priority is used whenever it gets resumed.
+  void Start(nsTaskPriority::Enum priority = nsTaskPriority::ThisFrame)
+  {
+    promise_type& promise = m_hCoroutine.promise();
+    NS_ASSERT_DEV(!promise.m_bStarted, "The coroutine has already been started.");
+
+    promise.m_bStarted = true;
+    promise.m_Priority = priority;
+    nsInternal::ResumeAsTask(m_hCoroutine, priority);
+  }
+
+  /// \brief Starts the coroutine, unless that already happened, and blocks until it has finished.
+  ///
+  /// Like nsTaskSystem::WaitForCondition(), this keeps the thread busy with other tasks in the mean time.
+  void Wait()
+  {
+    if (!IsStarted())
+    {
+      Start();
+    }
+
+    nsTaskSystem::WaitForCondition([this]()
+      { return IsFinished(); });
+  }
+
+  /// \brief Returns the value that the coroutine returned. Only allowed once it has finished.
+  decltype(auto) GetResult()
+  {
+    NS_ASSERT_DEV(IsFinished(), "The coroutine has not finished yet.");
+    return m_hCoroutine.promise().GetResult();
+  }
+
+  struct Awaiter
+  {
+    Handle m_hCoroutine;
+
+    bool await_ready() const { return m_hCoroutine.promise().IsFinished(); }
+
+    template <typename Promise>
+    std::coroutine_handle<> await_suspend(std::coroutine_handle<Promise> hAwaiting)
+    {
+      promise_type& promise = m_hCoroutine.promise();
+      promise.m_ContinuationPriority = nsInternal::GetAwaitingPriority(hAwaiting, nsTaskPriority::ENUM_COUNT);
+
+      if (!promise.m_bStarted)
+      {
+        // run the awaited coroutine right here, it continues the awaiting one when it returns
+        promise.m_bStarted = true;
+        promise.m_Priority = nsInternal::GetAwaitingPriority(hAwaiting, promise.m_Priority);
+        promise.m_iContinuation = reinterpret_cast<nsInt64>(hAwaiting.address());
+        return m_hCoroutine;
+      }
+
+      if (promise.m_iContinuation.TestAndSet(0, reinterpret_cast<nsInt64>(hAwaiting.address())))
+        return std::noop_coroutine();
+
+      // finished in the mean time
+      return hAwaiting;
+    }
+
+    decltype(auto) await_resume() { return m_hCoroutine.promise().GetResult(); }
+  };
+
+  /// \brief Suspends the awaiting coroutine until this one has finished and returns its result.
+  Awaiter operator co_await() const { return Awaiter{m_hCoroutine}; }
+
+private:
+  void Destroy()
+  {
+    if (m_hCoroutine)
+    {
+      NS_ASSERT_DEV(!IsStarted() || IsFinished(), "An nsTaskCoroutine must not be destroyed while it is running.");
+      m_hCoroutine.destroy();
+      m_hCoroutine = nullptr;
+    }
+  }
+
+  Handle m_hCoroutine = nullptr;
+};
+
+template <typename T>
+nsTaskCoroutine<T> nsInternal::nsTaskCoroutinePromise<T>::get_return_object()
+{
+  return nsTaskCoroutine<T>(nsTaskCoroutine<T>::Handle::from_promise(*this));
+}
+
+inline nsTaskCoroutine<void> nsInternal::nsTaskCoroutinePromise<void>::get_return_object()
+{
+  return nsTaskCoroutine<void>(nsTaskCoroutine<void>::Handle::from_promise(*this));
+}
+
+/// \brief Awaitable that suspends the coroutine until the given task group has finished.
+///
+/// The coroutine is resumed by a task with the given priority. By default that is the priority of the coroutine itself.
+struct nsWaitForTaskGroup
+{
+  explicit nsWaitForTaskGroup(nsTaskGroupID group, nsTaskPriority::Enum priority = nsTaskPriority::ENUM_COUNT)
+    : m_Group(group)
+    , m_Priority(priority)
+  {
+  }
+
+  bool await_ready() const { return !m_Group.IsValid() || nsTaskSystem::IsTaskGroupFinished(m_Group); }
+
+  template <typename Promise>
+  void await_suspend(std::coroutine_handle<Promise> hAwaiting)
+  {
+    if (m_Priority != nsTaskPriority::ENUM_COUNT)
+    {
+      if constexpr (std::is_base_of_v<nsInternal::nsTaskCoroutinePromiseBase, Promise>)
+        hAwaiting.promise().m_Priority = m_Priority;
+    }
+
+    // the coroutine may already run on another thread when this returns, so the awaiter must not be accessed afterwards
+    const nsTaskPriority::Enum priority = (m_Priority != nsTaskPriority::ENUM_COUNT) ? m_Priority : nsInternal::GetAwaitingPriority(hAwaiting, nsTaskPriority::ThisFrame);
+    nsInternal::ResumeAsTask(hAwaiting, priority, m_Group);
+  }
+
+  void await_resume() const {}
+
+  nsTaskGroupID m_Group;
+  nsTaskPriority::Enum m_Priority;
+};
+
+/// \brief Awaitable that moves the coroutine onto a task with the given priority, e.g. to continue on the main thread.
+///
+/// The priority is also used for all following suspensions of the coroutine.
+struct nsResumeOnTaskSystem
+{
+  explicit nsResumeOnTaskSystem(nsTaskPriority::Enum priority)
+    : m_Priority(priority)
+  {
+  }
+
+  bool await_ready() const { return false; }
+
+  template <typename Promise>
+  void await_suspend(std::coroutine_handle<Promise> hAwaiting)
+  {
+    if constexpr (std::is_base_of_v<nsInternal::nsTaskCoroutinePromiseBase, Promise>)
+      hAwaiting.promise().m_Priority = m_Priority;
+
+    nsInternal::ResumeAsTask(hAwaiting, m_Priority);
+  }
+
+  void await_resume() const {}
+
+  nsTaskPriority::Enum m_Priority;
+};
+
+/// \brief Allows to 'co_await' a task group directly, the coroutine continues with its own priority once the group has finished.
+inline nsWaitForTaskGroup operator co_await(nsTaskGroupID group)
+{
+  return nsWaitForTaskGroup(group);
+}
+
+#endif
@@ -0,0 +1,102 @@
+#pragma once
+
+#include <Foundation/Containers/DynamicArray.h>
+#include <Foundation/Threading/TaskSystem.h>
+
+/// \brief A fixed set of tasks and the dependencies between them, which is set up once and then executed many times.
+///
+/// Work that runs every frame in the same shape (e.g. the update pipeline of a world) would otherwise create the same task groups
+/// and dependencies over and over again. A task graph stores the nodes (a task and its priority) and edges only once.
+/// Finalize() validates the graph and prepares it for execution. After that, every Execute() only resets a few counters.
+/// The tasks of the graph are scheduled as soon as their own dependencies have finished, not group by group.
+///
+/// The whole execution is represented by a single task group, so the ID that Execute() returns can be used with
+/// nsTaskSystem::WaitForGroup(), nsTaskSystem::IsTaskGroupFinished() and as a dependency of other task groups.
+///
+/// The tasks are referenced by the graph and reused in every execution. The multiplicity of a task is read when Execute() is called.
+/// A graph must not be modified or destroyed while it is executing.
+class NS_FOUNDATION_DLL nsTaskGraph
+{
+  NS_DISALLOW_COPY_AND_ASSIGN(nsTaskGraph);
+
+public:
+  using NodeIndex = nsUInt32;
+
+  nsTaskGraph();
+  ~nsTaskGraph();
+
+  /// \brief Removes all nodes and dependencies.
+  void Clear();
+
+  /// \brief Adds a node that executes \a pTask with the given priority. Returns the index with which to refer to the node.
+  ///
+  /// A task may only be added to one node.
+  NodeIndex AddNode(const nsSharedPtr<nsTask>& pTask, nsTaskPriority::Enum priority = nsTaskPriority::ThisFrame);
+
+  /// \brief Makes sure that \a node is only scheduled after \a dependsOn has finished.
+  void AddDependency(NodeIndex node, NodeIndex dependsOn);
+
+  /// \brief Checks that the graph is valid and prepares it for execution. Has to be called again after the graph has been modified.
+  ///
+  /// Returns NS_FAILURE, if the dependencies contain a cycle. Such a graph cannot be executed.
+  nsResult Finalize();
+
+  /// \brief Whether Finalize() has been called successfully after the last modification.
+  bool IsFinalized() const { return m_bFinalized; }
+
+  /// \brief Starts all tasks of the graph, in the order given by its dependencies.
+  ///
+  /// The previous execution has to be finished. Returns the ID of the task group that represents this execution.
+  /// The optional \a callback is executed once all tasks of the graph have finished.
+  nsTaskGroupID Execute(nsOnTaskGroupFinishedCallback callback = nsOnTaskGroupFinishedCallback());
+
+  /// \brief Returns whether the last execution is still running.
+  bool IsExecuting() const { return !nsTaskSystem::IsTaskGroupFinished(m_ExecutionID); }
+
+  /// \brief Returns the ID of the task group of the last execution.
+  nsTaskGroupID GetExecutionID() const { return m_ExecutionID; }
+
+  nsUInt32 GetNodeCount() const { return m_Nodes.GetCount(); }
+
+  /// \brief Writes the nodes and dependencies of the graph as a DGML graph, using the same layout as nsTaskSystem::WriteStateSnapshotToDGML().
+  void WriteToDGML(nsDGMLGraph& ref_graph, nsStringView sTitle = "Task Graph") const;
+
+private:
+  friend class nsTaskSystem;
+
+  struct Node
+  {
+    nsSharedPtr<nsTask> m_pTask;
+    nsTaskPriority::Enum m_Priority = nsTaskPriority::ThisFrame;
+
+    // the range of m_Successors that holds the nodes that depend on this one
+    nsUInt32 m_uiFirstSuccessor = 0;
+    nsUInt32 m_uiNumSuccessors = 0;
+
+    nsUInt32 m_uiNumDependencies = 0;
+
+    // the number of runs of the task in the current execution, see nsTask::SetMultiplicity()
+    nsUInt32 m_uiNumRuns = 1;
+
+    // counted down while the graph executes, the node gets scheduled when it reaches zero
+    nsAtomicInteger32 m_iRemainingDependencies;
+  };
+
+  struct Dependency
+  {
+    NS_DECLARE_POD_TYPE();
+
+    NodeIndex m_Node;
+    NodeIndex m_DependsOn;
+  };
+
+  bool m_bFinalized = false;
+  nsDynamicArray<Node> m_Nodes;
+  nsDynamicArray<Dependency> m_Dependencies;
+
+  // set up by Finalize()
+  nsDynamicArray<NodeIndex> m_Successors;
+  nsDynamicArray<NodeIndex> m_RootNodes;
+
+  nsTaskGroupID m_ExecutionID;
+};
@@ -38,6 +38,13 @@ public:
   static nsTaskGroupID StartSingleTask(const nsSharedPtr<nsTask>& pTask, nsTaskPriority::Enum priority, nsTaskGroupID dependency,
     nsOnTaskGroupFinishedCallback callback = nsOnTaskGroupFinishedCallback()); // [tested]
 
+  /// \brief Starts a task that calls \a func. Returns ID of the Group into which the task has been put.
+  ///
+  /// The task object is taken from GetTaskAllocator(), so in the common case this doesn't allocate from the heap.
+  /// For that, the task name should be short and the captures of \a func should fit into the delegate.
+  static nsTaskGroupID StartSingleTask(const char* szTaskName, nsTaskPriority::Enum priority, nsDelegate<void()> func,
+    nsTaskNesting taskNesting = nsTaskNesting::Never); // [tested]
+
   /// \brief Call this function once at the end of a frame. It will ensure that all tasks for 'this frame' get finished properly.
   ///
   /// Calling this function is crucial for several reasons. It is the central function to execute 'main thread' tasks.
@@ -74,11 +81,20 @@ public:
   /// in a way that allows for quick canceling.
   static nsResult CancelTask(const nsSharedPtr<nsTask>& pTask, nsOnTaskRunning::Enum onTaskRunning = nsOnTaskRunning::WaitTillFinished); // [tested]
 
+  /// \brief One queued invocation of a task.
+  ///
+  /// Entries are moved bitwise through the work-stealing queues, so all members must be memory-relocatable.
   struct TaskData
   {
     nsSharedPtr<nsTask> m_pTask;
     nsTaskGroup* m_pBelongsToGroup = nullptr;
     nsUInt32 m_uiInvocation = 0;
+
+    /// \brief The task's schedule generation at the time the entry was queued. Entries of a different generation are stale.
+    nsUInt32 m_uiScheduleGeneration = 0;
+
+    /// \brief Copy of the task's nesting mode, so that threads can filter entries without touching the task.
+    nsTaskNesting m_NestingMode = nsTaskNesting::Maybe;
   };
 
 private:
@@ -86,14 +102,28 @@ private:
   static TaskData GetNextTask(nsTaskPriority::Enum FirstPriority, nsTaskPriority::Enum LastPriority, bool bOnlyTasksThatNeverWait,
     const nsTaskGroupID& WaitingForGroup, nsAtomicInteger32* pWorkerState);
 
+  /// \brief Takes a queued entry of the given queue level, preferably from the calling thread's own queue, otherwise from another thread's.
+  static bool TakeQueuedTask(nsUInt32 uiQueueLevel, bool bOnlyTasksThatNeverWait, const nsTaskGroup* pWaitingForGroup, TaskData& out_task);
+
+  /// \brief Returns the estimated cost of a run of the given task, for ordering the tasks with a deadline.
+  static nsTime EstimateTaskCost(const nsTask& task);
+
+  /// \brief Counts the run of a task with a deadline and updates the measured cost of tasks with its name.
+  static void DeadlineTaskHasRun(const nsTask& task, nsTime startTime, nsTime endTime);
+
+  /// \brief Returns whether tasks of priority between \a FirstPriority and \a LastPriority (inclusive) are queued.
+  static bool HasQueuedTasks(nsTaskPriority::Enum FirstPriority, nsTaskPriority::Enum LastPriority);
+
   /// \brief Executes some task of priority between \a FirstPriority and \a LastPriority (inclusive). Returns true, if any such task was available.
   static bool ExecuteTask(nsTaskPriority::Enum FirstPriority, nsTaskPriority::Enum LastPriority, bool bOnlyTasksThatNeverWait,
     const nsTaskGroupID& WaitingForGroup, nsAtomicInteger32* pWorkerState);
 
-  /// \brief Called whenever a task has been finished/canceled. Makes sure that groups are marked as finished when all tasks are done.
-  static void TaskHasFinished(nsSharedPtr<nsTask>&& pTask, nsTaskGroup* pGroup);
+  /// \brief Called whenever task invocations have been finished/canceled. Makes sure that groups are marked as finished when all tasks are done.
+  ///
+  /// \a pTask must only be passed in, when its last remaining run has finished. In that case its 'finished' callback gets executed.
+  static void TaskHasFinished(nsSharedPtr<nsTask>&& pTask, nsTaskGroup* pGroup, nsUInt32 uiNumInvocations);
 
-  /// \brief Moves all 'next frame' tasks into the 'this frame' queues.
+  /// \brief Advances the current frame, which turns all 'next frame' tasks into 'this frame' tasks.
   static void ReprioritizeFrameTasks();
 
   /// \brief Executes tasks of priority 'SomeFrameMainThread', as long as the last duration between frames is no longer than fSmoothFrameMS.
@@ -170,12 +200,32 @@ public:
   static void WaitForCondition(nsDelegate<bool()> condition);
 
 private:
-  /// \brief Takes all the tasks in the given group and schedules them for execution, by inserting them into the proper task lists.
-  static void ScheduleGroupTasks(nsTaskGroup* pGroup, bool bHighPriority);
+  /// \brief Takes all the tasks in the given group and schedules them for execution, by inserting them into the proper task queues.
+  static void ScheduleGroupTasks(nsTaskGroup* pGroup);
 
   /// \brief Is called whenever a dependency of pGroup has finished. Once all dependencies are finished, the group's tasks will get scheduled.
   static void DependencyHasFinished(nsTaskGroup* pGroup);
 
+  /// \brief Pushes the entries into the queues of the given level and wakes up a worker thread for each of them.
+  static void QueueTasks(nsArrayPtr<TaskData> tasks, nsUInt32 uiQueueLevel, nsTaskPriority::Enum priority);
+
+  ///@}
+
+  /// \name Task Graphs
+  ///@{
+
+private:
+  friend class nsTaskGraph;
+
+  /// \brief Resets the counters of the graph and schedules all nodes without dependencies. See nsTaskGraph::Execute().
+  static nsTaskGroupID ExecuteTaskGraph(nsTaskGraph& ref_graph, nsOnTaskGroupFinishedCallback callback);
+
+  /// \brief Schedules the task of a graph node whose dependencies have all finished.
+  static void ScheduleTaskGraphNode(nsTaskGraph& ref_graph, nsTaskGroup* pGroup, nsUInt32 uiNode);
+
+  /// \brief Called when the task of a graph node has finished, schedules all nodes that were only waiting for it.
+  static void TaskGraphNodeHasFinished(nsTaskGroup* pGroup, nsUInt32 uiNode);
+
   ///@}
 
   /// \name Thread Management
@@ -214,6 +264,22 @@ public:
   /// Also optionally returns the number of tasks that were finished during the last frame.
   static double GetThreadUtilization(nsWorkerThreadType::Enum type, nsUInt32 uiThreadIndex, nsUInt32* pNumTasksExecuted = nullptr);
 
+  /// \brief Sets whether the short task worker threads get pinned to individual logical processors.
+  ///
+  /// The workers are placed on distinct physical cores first, filling up one cache domain (see nsCpuTopology) before using the next one,
+  /// and only then on the remaining hardware threads of those cores. Idle workers steal tasks from workers in the same cache domain first.
+  /// This keeps short tasks, and the data they work on, within as few caches as possible.
+  /// Long running and file access workers are never pinned, as they mostly wait or run for a long time anyway.
+  ///
+  /// Changing the setting restarts all worker threads. Pinning is disabled by default.
+  static void SetWorkerThreadPinning(bool bPinShortTaskWorkers);
+
+  /// \brief Returns whether the short task worker threads are pinned to logical processors, see SetWorkerThreadPinning().
+  static bool GetWorkerThreadPinning();
+
+  /// \brief Returns on which logical processor, core, cache domain and package the given worker thread runs, if it is pinned.
+  static nsTaskWorkerPlacement GetWorkerThreadPlacement(nsWorkerThreadType::Enum type, nsUInt32 uiThreadIndex);
+
   /// \brief [internal] Wakes up or allocates up to \a uiNumThreads, unless enough threads are currently active and not blocked
   static void WakeUpThreads(nsWorkerThreadType::Enum type, nsUInt32 uiNumThreads);
 
@@ -223,6 +289,9 @@ private:
   /// \brief Allocates \a uiAddThreads additional threads of \a type
   static void AllocateThreads(nsWorkerThreadType::Enum type, nsUInt32 uiAddThreads);
 
+  /// \brief Determines where the worker thread \a uiThreadIndex of \a type should be placed, see SetWorkerThreadPinning().
+  static nsTaskWorkerPlacement ComputeWorkerPlacement(nsWorkerThreadType::Enum type, nsUInt32 uiThreadIndex);
+
   /// \brief Shuts down all worker threads. Does NOT finish the remaining tasks that were not started yet. Does not clear them either, though.
   static void StopWorkerThreads();
 
@@ -300,6 +369,23 @@ public:
   /// \see FinishFrameTasks() for more details.
   static void SetTargetFrameTime(nsTime targetFrameTime = nsTime::MakeFromSeconds(1.0 / 40.0) /* 40 FPS -> 25 ms */);
 
+  /// \brief Returns an allocator that recycles the memory of task objects, without going through the heap in the common case.
+  ///
+  /// ParallelFor uses it, unless nsParallelForParams::m_pTaskAllocator is set. It can be used with NS_NEW for custom tasks as well,
+  /// but all tasks allocated with it must be released before the task system shuts down.
+  static nsAllocator* GetTaskAllocator();
+
+  /// \brief Returns the counters of GetTaskAllocator(). Comparing them between two frames shows whether any task memory had to be allocated.
+  static nsTaskAllocatorStats GetTaskAllocatorStats();
+
+  /// \brief Returns how many runs of tasks with a deadline were executed and how many of them missed it, see nsTask::SetDeadline().
+  static nsTaskDeadlineStats GetTaskDeadlineStats(); // [tested]
+
+  /// \brief Returns how long a run of a task with the given name and a deadline took on average recently. Zero, if no such task has run yet.
+  ///
+  /// This is used to order the tasks with a deadline, unless a task has an explicit estimate, see nsTask::SetEstimatedCost().
+  static nsTime GetEstimatedTaskCost(nsStringView sTaskName); // [tested]
+
 private:
   NS_MAKE_SUBSYSTEM_STARTUP_FRIEND(Foundation, TaskSystem);
 
@@ -307,7 +393,8 @@ private:
   static void Shutdown();
 
 private:
-  /// One mutex to rule them all.
+  /// Protects the allocation of worker threads and the debug validation of task groups.
+  /// Scheduling and executing tasks does not need it, that is handled by lock-free work-stealing queues.
   static nsMutex s_TaskSystemMutex;
 
   static nsUniquePtr<nsTaskSystemState> s_pState;
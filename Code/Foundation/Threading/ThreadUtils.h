@@ -26,6 +26,11 @@ public:
   /// \brief Returns an identifier for the currently running thread.
   static nsThreadID GetCurrentThreadID();
 
+  /// \brief Restricts the currently running thread to the given logical processor (see nsCpuTopology::LogicalProcessor::m_uiProcessorIndex).
+  ///
+  /// Returns NS_FAILURE if the platform does not support this or the processor may not be used by this process.
+  static nsResult SetCurrentThreadAffinity(nsUInt32 uiProcessorIndex);
+
 private:
   NS_MAKE_SUBSYSTEM_STARTUP_FRIEND(Foundation, ThreadUtils);
 
@@ -23,7 +23,7 @@ const nsTag& nsTagRegistry::RegisterTag(nsStringView sTagString)
 
 const nsTag& nsTagRegistry::RegisterTag(const nsHashedString& sTagString)
 {
-  NS_LOCK(m_TagRegistryMutex);
+  NS_LOCK_WRITE(m_TagRegistryLock);
 
   // Early out if the tag is already registered
   const nsTag* pResult = GetTagByName(sTagString);
@@ -50,7 +50,7 @@ const nsTag& nsTagRegistry::RegisterTag(const nsHashedString& sTagString)
 
 const nsTag* nsTagRegistry::GetTagByName(const nsTempHashedString& sTagString) const
 {
-  NS_LOCK(m_TagRegistryMutex);
+  NS_LOCK_READ(m_TagRegistryLock);
 
   auto It = m_RegisteredTags.Find(sTagString);
   if (It.IsValid())
@@ -63,7 +63,7 @@ const nsTag* nsTagRegistry::GetTagByName(const nsTempHashedString& sTagString) c
 
 const nsTag* nsTagRegistry::GetTagByMurmurHash(nsUInt32 uiMurmurHash) const
 {
-  NS_LOCK(m_TagRegistryMutex);
+  NS_LOCK_READ(m_TagRegistryLock);
 
   for (nsTag* pTag : m_TagsByIndex)
   {
@@ -78,19 +78,19 @@ const nsTag* nsTagRegistry::GetTagByMurmurHash(nsUInt32 uiMurmurHash) const
 
 const nsTag* nsTagRegistry::GetTagByIndex(nsUInt32 uiIndex) const
 {
-  NS_LOCK(m_TagRegistryMutex);
+  NS_LOCK_READ(m_TagRegistryLock);
   return m_TagsByIndex[uiIndex];
 }
 
 nsUInt32 nsTagRegistry::GetNumTags() const
 {
-  NS_LOCK(m_TagRegistryMutex);
+  NS_LOCK_READ(m_TagRegistryLock);
   return m_TagsByIndex.GetCount();
 }
 
 nsResult nsTagRegistry::Load(nsStreamReader& inout_stream)
 {
-  NS_LOCK(m_TagRegistryMutex);
+  NS_LOCK_WRITE(m_TagRegistryLock);
 
   nsUInt8 uiVersion = 0;
   inout_stream >> uiVersion;
@@ -8,7 +8,7 @@ class nsStreamWriter;
 class nsStreamReader;
 
 #include <Foundation/Containers/Map.h>
-#include <Foundation/Threading/Mutex.h>
+#include <Foundation/Threading/ReadWriteLock.h>
 
 /// \brief The tag registry for tags in tag sets.
 ///
@@ -17,7 +17,8 @@ class nsStreamReader;
 /// Certain special cases (e.g. tests) may actually need their own instance of the tag registry.
 /// Note however that tags which were registered with one registry shouldn't be used with tag sets filled
 /// with tags from another registry since there may be conflicting tag assignments.
-/// The tag registry registration and tag retrieval functions are thread safe due to a mutex.
+/// The tag registry registration and tag retrieval functions are thread safe. Retrieving tags only takes a shared lock,
+/// so it doesn't serialize threads that look up tags at the same time.
 class NS_FOUNDATION_DLL nsTagRegistry
 {
 public:
@@ -48,7 +49,7 @@ public:
   nsResult Load(nsStreamReader& inout_stream);
 
 protected:
-  mutable nsMutex m_TagRegistryMutex;
+  mutable nsReadWriteLock m_TagRegistryLock;
 
   nsMap<nsTempHashedString, nsTag> m_RegisteredTags;
   nsDeque<nsTag*> m_TagsByIndex;
@@ -43,6 +43,9 @@ struct nsTypedObject
 class NS_FOUNDATION_DLL nsVariant
 {
 public:
+  // Inlined values are POD or mem-relocatable and shared values are only referenced through a pointer.
+  NS_DECLARE_MEM_RELOCATABLE_TYPE();
+
   using Type = nsVariantType;
   template <typename T>
   using TypeDeduction = nsVariantTypeDeduction<T>;
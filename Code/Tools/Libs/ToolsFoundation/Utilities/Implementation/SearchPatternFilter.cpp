@@ -13,12 +13,14 @@ void nsSearchPatternFilter::SetSearchText(nsStringView sSearchText)
   for (auto& searchPart : searchParts)
   {
     auto& part = m_Parts.ExpandAndGetRef();
-    part.m_sPart = searchPart;
-    if (part.m_sPart.StartsWith("-"))
+    if (searchPart.StartsWith("-"))
     {
-      part.m_sPart.Shrink(1, 0);
+      searchPart.Shrink(1, 0);
       part.m_bExclude = true;
     }
+
+    // the same parts are searched for in many texts, so prepare them once
+    part.m_Searcher.SetPattern(searchPart, false);
   }
 }
 
@@ -38,7 +40,7 @@ bool nsSearchPatternFilter::PassesFilters(nsStringView sText) const
   for (auto& part : m_Parts)
   {
     bool failureResult = part.m_bExclude;
-    if ((sText.FindSubString_NoCase(part.m_sPart) != nullptr) == failureResult)
+    if (part.m_Searcher.IsContainedIn(sText) == failureResult)
       return false;
   }
 
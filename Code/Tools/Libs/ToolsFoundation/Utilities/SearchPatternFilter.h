@@ -1,6 +1,7 @@
 #pragma once
 
 #include <Foundation/Strings/String.h>
+#include <Foundation/Strings/StringSearcher.h>
 #include <ToolsFoundation/ToolsFoundationDLL.h>
 
 /// \brief A small helper class to implement a simple search pattern filter that can contain multiple parts.
@@ -29,7 +30,7 @@ private:
 
   struct Part
   {
-    nsStringView m_sPart;
+    nsStringSearcher m_Searcher;
     bool m_bExclude = false;
   };
 
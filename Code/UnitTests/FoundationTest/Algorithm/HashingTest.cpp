@@ -11,6 +11,34 @@ NS_CREATE_SIMPLE_TEST_GROUP(Algorithm);
 // Todo: Why is this not happening elsewhere?
 #pragma warning(disable : 4307)
 
+namespace
+{
+  // the expected string hashes depend on the hash function that is selected by NS_HASHING_VERSION
+#if NS_HASHING_VERSION >= 2
+  constexpr nsUInt64 uiStringHashShort = 0xb79e57a9f5acb608ULL;
+  constexpr nsUInt64 uiStringHashLong = 0xa672f005daaefde4ULL;
+  constexpr nsUInt32 uiStringHash32 = 0xd9912961;
+  constexpr nsUInt32 uiStringHash32Lower = 0x038ad889;
+#else
+  constexpr nsUInt64 uiStringHashShort = 0xcf0f91eece7c88feULL;
+  constexpr nsUInt64 uiStringHashLong = 0xb85d007925299bacULL;
+  constexpr nsUInt32 uiStringHash32 = 0x0bf32020;
+  constexpr nsUInt32 uiStringHash32Lower = 0x19404167;
+#endif
+
+  /// Compares the compile time implementation of XXH3 with the runtime implementation, for all length ranges that XXH3 distinguishes.
+  template <size_t N>
+  void TestXxHash3String(const char (&str)[N])
+  {
+    NS_TEST_INT(nsHashingUtils::xxHash3_64String(str), nsHashingUtils::xxHash3_64(str, N - 1));
+    NS_TEST_INT(nsHashingUtils::xxHash3_64String(str), nsHashingUtils::xxHash3_64String(nsStringView(str, N - 1)));
+    NS_TEST_INT(nsHashingUtils::xxHash3_64String(str, 0x123456789ULL), nsHashingUtils::xxHash3_64(str, N - 1, 0x123456789ULL));
+  }
+} // namespace
+
+#define NS_HASH_TEST_TEXT_64 "0123456789abcdefghijklmnopqrstuvwxyzABCDEFGHIJKLMNOPQRSTUVWXYZ+-"
+#define NS_HASH_TEST_TEXT_512 NS_HASH_TEST_TEXT_64 NS_HASH_TEST_TEXT_64 NS_HASH_TEST_TEXT_64 NS_HASH_TEST_TEXT_64 NS_HASH_TEST_TEXT_64 NS_HASH_TEST_TEXT_64 NS_HASH_TEST_TEXT_64 NS_HASH_TEST_TEXT_64
+
 NS_CREATE_SIMPLE_TEST(Algorithm, Hashing)
 {
   // check whether compile time hashing gives the same value as runtime hashing
@@ -58,17 +86,32 @@ NS_CREATE_SIMPLE_TEST(Algorithm, Hashing)
     }
 
     {
-      // Test short inputs (< 32 characters) of xx hash 64 at compile time
-      nsUInt64 uixxHash64RT = nsHashingUtils::StringHash(nsStringView("Test string"));
-      nsUInt64 uixxHash64CT = nsHashingUtils::StringHash("Test string");
-      NS_TEST_INT(uixxHash64RT, uixxHash64CT);
-      static_assert(nsHashingUtils::StringHash("Test string") == 0xcf0f91eece7c88feULL);
+      // Test short inputs of XXH3 at compile time
+      nsUInt64 uixxHash3RT = nsHashingUtils::xxHash3_64("Test string", 11, 0);
+      nsUInt64 uixxHash3CT = nsHashingUtils::xxHash3_64String("Test string", 0);
+      NS_TEST_INT(uixxHash3RT, uixxHash3CT);
+      static_assert(nsHashingUtils::xxHash3_64String("Test string") == 0xb79e57a9f5acb608ULL);
+      static_assert(nsHashingUtils::xxHash3_64String("Test string", 42) == 0x3527bf976328c09fULL);
+
+      // Test long inputs of XXH3 at compile time
+      nsUInt64 uixxHash3RTLong = nsHashingUtils::xxHash3_64String(nsStringView("This is a longer test string for 64-bit. 123456"));
+      nsUInt64 uixxHash3CTLong = nsHashingUtils::xxHash3_64String("This is a longer test string for 64-bit. 123456");
+      NS_TEST_INT(uixxHash3RTLong, uixxHash3CTLong);
+      static_assert(nsHashingUtils::xxHash3_64String("This is a longer test string for 64-bit. 123456") == 0xa672f005daaefde4ULL);
+    }
 
-      // Test long inputs ( > 32 characters) of xx hash 64 at compile time
-      nsUInt64 uixxHash64RTLong = nsHashingUtils::StringHash(nsStringView("This is a longer test string for 64-bit. 123456"));
-      nsUInt64 uixxHash64CTLong = nsHashingUtils::StringHash("This is a longer test string for 64-bit. 123456");
-      NS_TEST_INT(uixxHash64RTLong, uixxHash64CTLong);
-      static_assert(nsHashingUtils::StringHash("This is a longer test string for 64-bit. 123456") == 0xb85d007925299bacULL);
+    {
+      // Test short inputs of the string hash at compile time
+      nsUInt64 uiStringHashRT = nsHashingUtils::StringHash(nsStringView("Test string"));
+      nsUInt64 uiStringHashCT = nsHashingUtils::StringHash("Test string");
+      NS_TEST_INT(uiStringHashRT, uiStringHashCT);
+      static_assert(nsHashingUtils::StringHash("Test string") == uiStringHashShort);
+
+      // Test long inputs of the string hash at compile time
+      nsUInt64 uiStringHashRTLong = nsHashingUtils::StringHash(nsStringView("This is a longer test string for 64-bit. 123456"));
+      nsUInt64 uiStringHashCTLong = nsHashingUtils::StringHash("This is a longer test string for 64-bit. 123456");
+      NS_TEST_INT(uiStringHashRTLong, uiStringHashCTLong);
+      static_assert(nsHashingUtils::StringHash("This is a longer test string for 64-bit. 123456") == uiStringHashLong);
     }
 
     // Check MurmurHash for unaligned inputs
@@ -139,33 +182,110 @@ NS_CREATE_SIMPLE_TEST(Algorithm, Hashing)
     nsUInt64 uixxHash64RTEmpty = nsHashingUtils::xxHash64("", 0, 0);
     nsUInt64 uixxHash64CTEmpty = nsHashingUtils::xxHash64String("", 0);
     NS_TEST_BOOL(uixxHash64RTEmpty == uixxHash64CTEmpty);
+
+    // 64 Bit XXH3
+    const nsUInt64 uiXXHash3 = nsHashingUtils::xxHash3_64(sb.GetData(), sb.GetElementCount());
+    NS_TEST_INT(uiXXHash3, 0x3075d155d9912961);
+
+    // Check XXH3 for unaligned inputs
+    uiHash1_64 = nsHashingUtils::xxHash3_64(alignmentTestString, 8);
+    uiHash2_64 = nsHashingUtils::xxHash3_64(alignmentTestString + 9, 8);
+    uiHash3_64 = nsHashingUtils::xxHash3_64(alignmentTestString + 19, 8);
+    uiHash4_64 = nsHashingUtils::xxHash3_64(alignmentTestString + 30, 8);
+    NS_TEST_INT(uiHash1_64, uiHash2_64);
+    NS_TEST_INT(uiHash1_64, uiHash3_64);
+    NS_TEST_INT(uiHash1_64, uiHash4_64);
+
+    // 128 Bit XXH3
+    const nsHashingUtils::Hash128 xxHash3_128 = nsHashingUtils::xxHash3_128(sb.GetData(), sb.GetElementCount());
+    NS_TEST_INT(xxHash3_128.m_uiLow, 0x6c7495112652a1c2);
+    NS_TEST_INT(xxHash3_128.m_uiHigh, 0x1cc922c641a39cb3);
+    NS_TEST_BOOL(xxHash3_128 != nsHashingUtils::xxHash3_128(sb.GetData(), sb.GetElementCount(), 1));
+  }
+
+  NS_TEST_BLOCK(nsTestBlock::Enabled, "XXH3 compile time")
+  {
+    // every length range of XXH3 has a separate code path
+    TestXxHash3String("");
+    TestXxHash3String("a");
+    TestXxHash3String("abc");
+    TestXxHash3String("abcd");
+    TestXxHash3String("abcdefgh");
+    TestXxHash3String("abcdefghi");
+    TestXxHash3String("abcdefghijklmnop");
+    TestXxHash3String("abcdefghijklmnopq");
+    TestXxHash3String("\xc3\xa4\xc3\xb6\xc3\xbc \xe2\x82\xac"); // non-ASCII characters must not be sign extended
+    TestXxHash3String(NS_HASH_TEST_TEXT_64);
+    TestXxHash3String(NS_HASH_TEST_TEXT_64 "1");
+    TestXxHash3String(NS_HASH_TEST_TEXT_64 NS_HASH_TEST_TEXT_64);
+    TestXxHash3String(NS_HASH_TEST_TEXT_64 NS_HASH_TEST_TEXT_64 "1");
+    TestXxHash3String(NS_HASH_TEST_TEXT_64 NS_HASH_TEST_TEXT_64 NS_HASH_TEST_TEXT_64 "0123456789abcdefghijklmnopqrstuvwxyzABCDEFGHIJKL");
+    TestXxHash3String(NS_HASH_TEST_TEXT_64 NS_HASH_TEST_TEXT_64 NS_HASH_TEST_TEXT_64 "0123456789abcdefghijklmnopqrstuvwxyzABCDEFGHIJKLM");
+    TestXxHash3String(NS_HASH_TEST_TEXT_512);
+    TestXxHash3String(NS_HASH_TEST_TEXT_512 NS_HASH_TEST_TEXT_512);
+    TestXxHash3String(NS_HASH_TEST_TEXT_512 NS_HASH_TEST_TEXT_512 "1");
+    TestXxHash3String(NS_HASH_TEST_TEXT_512 NS_HASH_TEST_TEXT_512 NS_HASH_TEST_TEXT_512 NS_HASH_TEST_TEXT_512 NS_HASH_TEST_TEXT_64 "12345");
+  }
+
+  NS_TEST_BLOCK(nsTestBlock::Enabled, "CRC32C")
+  {
+    // standard check value of CRC-32C
+    NS_TEST_INT(nsHashingUtils::CRC32cHash("123456789", 9), 0xe3069283);
+    NS_TEST_INT(nsHashingUtils::CRC32cHash("", 0), 0);
+
+    const nsUInt32 uiCrc = nsHashingUtils::CRC32cHash(sb.GetData(), sb.GetElementCount());
+
+    // continuing the checksum over several pieces gives the same result
+    const nsUInt32 uiCrcHalf = nsHashingUtils::CRC32cHash(sb.GetData(), 10);
+    NS_TEST_INT(nsHashingUtils::CRC32cHash(sb.GetData() + 10, sb.GetElementCount() - 10, uiCrcHalf), uiCrc);
+
+    // the hardware and software paths have to agree for all lengths and alignments
+    nsUInt32 uiBitwiseCrc = 0xFFFFFFFF;
+    const char* szText = NS_HASH_TEST_TEXT_512;
+    for (nsUInt32 i = 0; i < 100; ++i)
+    {
+      uiBitwiseCrc ^= static_cast<nsUInt8>(szText[i + 3]);
+      for (nsUInt32 bit = 0; bit < 8; ++bit)
+      {
+        uiBitwiseCrc = (uiBitwiseCrc >> 1) ^ ((uiBitwiseCrc & 1) ? 0x82F63B78u : 0u);
+      }
+
+      NS_TEST_INT(nsHashingUtils::CRC32cHash(szText + 3, i + 1), ~uiBitwiseCrc);
+    }
+
+    // Check crc32c for unaligned inputs
+    const char* alignmentTestString = "12345678_12345678__12345678___12345678";
+    const nsUInt32 uiHash1 = nsHashingUtils::CRC32cHash(alignmentTestString, 8);
+    NS_TEST_INT(uiHash1, nsHashingUtils::CRC32cHash(alignmentTestString + 9, 8));
+    NS_TEST_INT(uiHash1, nsHashingUtils::CRC32cHash(alignmentTestString + 19, 8));
+    NS_TEST_INT(uiHash1, nsHashingUtils::CRC32cHash(alignmentTestString + 30, 8));
   }
 
   NS_TEST_BLOCK(nsTestBlock::Enabled, "HashHelper")
   {
     nsUInt32 uiHash = nsHashHelper<nsStringBuilder>::Hash(sb);
-    NS_TEST_INT(uiHash, 0x0bf32020);
+    NS_TEST_INT(uiHash, uiStringHash32);
 
     const char* szTest = "This is a test string. 1234";
     uiHash = nsHashHelper<const char*>::Hash(szTest);
-    NS_TEST_INT(uiHash, 0x0bf32020);
+    NS_TEST_INT(uiHash, uiStringHash32);
     NS_TEST_BOOL(nsHashHelper<const char*>::Equal(szTest, sb.GetData()));
 
     nsHashedString hs;
     hs.Assign(szTest);
     uiHash = nsHashHelper<nsHashedString>::Hash(hs);
-    NS_TEST_INT(uiHash, 0x0bf32020);
+    NS_TEST_INT(uiHash, uiStringHash32);
 
     nsTempHashedString ths(szTest);
     uiHash = nsHashHelper<nsHashedString>::Hash(ths);
-    NS_TEST_INT(uiHash, 0x0bf32020);
+    NS_TEST_INT(uiHash, uiStringHash32);
     NS_TEST_BOOL(nsHashHelper<nsHashedString>::Equal(hs, ths));
   }
 
   NS_TEST_BLOCK(nsTestBlock::Enabled, "HashHelperString_NoCase")
   {
     const nsUInt32 uiHash = nsHashHelper<const char*>::Hash(szStringLower);
-    NS_TEST_INT(uiHash, 0x19404167);
+    NS_TEST_INT(uiHash, uiStringHash32Lower);
     NS_TEST_INT(uiHash, nsHashHelperString_NoCase::Hash(szString));
     NS_TEST_INT(uiHash, nsHashHelperString_NoCase::Hash(szStringLower));
     NS_TEST_INT(uiHash, nsHashHelperString_NoCase::Hash(szString2));
@@ -302,7 +422,11 @@ NS_CREATE_SIMPLE_TEST(Algorithm, Hashing)
     test(false, &uiHash2);
     NS_TEST_INT(uiHash1, uiHash2);
 
+#if NS_HASHING_VERSION >= 2
+    const nsUInt64 uiHash3 = nsHashingUtils::xxHash3_64(szTest, std::strlen(szTest));
+#else
     const nsUInt64 uiHash3 = nsHashingUtils::xxHash64(szTest, std::strlen(szTest));
+#endif
     NS_TEST_INT(uiHash1, uiHash3);
   }
 }
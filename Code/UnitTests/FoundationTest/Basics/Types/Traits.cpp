@@ -1,5 +1,9 @@
 #include <FoundationTest/FoundationTestPCH.h>
 
+#include <Foundation/Containers/HashSet.h>
+#include <Foundation/Containers/HashTable.h>
+#include <Foundation/Types/Variant.h>
+
 // This test does not actually run, it tests compile time stuff
 
 namespace
@@ -57,4 +61,14 @@ namespace
   static_assert(nsGetTypeClass<AggregateMemRelocateable>::value == nsTypeIsMemRelocatable::value);
   static_assert(nsGetTypeClass<ClassType>::value == nsTypeIsClass::value);
   static_assert(nsGetTypeClass<AggregateClass>::value == nsTypeIsClass::value);
+
+  // containers store these with memcpy / memmove instead of moving them one by one
+  static_assert(nsGetTypeClass<nsVariant>::value == nsTypeIsMemRelocatable::value);
+  static_assert(nsGetTypeClass<nsDynamicArray<nsString>>::value == nsTypeIsMemRelocatable::value);
+  static_assert(nsGetTypeClass<nsHashTable<nsString, nsVariant>>::value == nsTypeIsMemRelocatable::value);
+  static_assert(nsGetTypeClass<nsHashSet<nsString>>::value == nsTypeIsMemRelocatable::value);
+
+  // these point into their own inline storage
+  static_assert(nsGetTypeClass<nsString>::value == nsTypeIsClass::value);
+  static_assert(nsGetTypeClass<nsHybridArray<nsInt32, 4>>::value == nsTypeIsClass::value);
 } // namespace
@@ -106,4 +106,40 @@ NS_CREATE_SIMPLE_TEST(Communication, MessageQueue)
       NS_DEFAULT_DELETE(pMsg);
     }
   }
+
+  NS_TEST_BLOCK(nsTestBlock::Enabled, "Lock-free Message Queue")
+  {
+    nsLockFreeMessageQueue<MetaData> lq(100);
+    NS_TEST_INT(lq.GetCapacity(), 128);
+    NS_TEST_BOOL(lq.IsEmpty());
+
+    for (nsUInt32 i = 0; i < 128; ++i)
+    {
+      TestMessage* pMsg = NS_DEFAULT_NEW(TestMessage);
+      pMsg->x = i;
+
+      MetaData md;
+      md.receiver = i % 10;
+
+      NS_TEST_BOOL(lq.TryEnqueue(pMsg, md));
+    }
+
+    // the queue is full
+    NS_TEST_BOOL(!lq.TryEnqueue(nullptr, MetaData()));
+    NS_TEST_INT(lq.GetCount(), 128);
+
+    nsMessage* pMsg = nullptr;
+    MetaData md;
+
+    for (nsUInt32 i = 0; i < 128; ++i)
+    {
+      NS_TEST_BOOL(lq.TryDequeue(pMsg, md));
+      NS_TEST_INT(static_cast<TestMessage*>(pMsg)->x, i);
+      NS_TEST_INT(md.receiver, i % 10);
+      NS_DEFAULT_DELETE(pMsg);
+    }
+
+    NS_TEST_BOOL(!lq.TryDequeue(pMsg, md));
+    NS_TEST_BOOL(lq.IsEmpty());
+  }
 }
@@ -17,6 +17,46 @@ namespace DequeTestDetail
 
     return a;
   }
+
+  static nsInt32 GetValue(nsInt32 iValue) { return iValue; }
+  static nsInt32 GetValue(const st& value) { return value.m_iData; }
+  static nsInt32 GetValue(const nsConstructionCounterRelocatable& value) { return value.m_iData; }
+
+  /// Inserts and removes at positions all over a deque that spans several chunks and compares the result against an array.
+  template <typename T>
+  static void TestInsertRemoveInTheMiddle()
+  {
+    nsDeque<T> deque;
+    nsDynamicArray<nsInt32> expected;
+
+    nsUInt32 uiRandom = 17;
+    const auto NextIndex = [&uiRandom](nsUInt32 uiCount)
+    {
+      uiRandom = uiRandom * 1664525u + 1013904223u;
+      return (uiRandom >> 8) % (uiCount + 1);
+    };
+
+    for (nsInt32 i = 0; i < 3000; ++i)
+    {
+      const nsUInt32 uiIndex = NextIndex(expected.GetCount());
+      deque.InsertAt(uiIndex, T(i));
+      expected.InsertAt(uiIndex, i);
+    }
+
+    for (nsInt32 i = 0; i < 2000; ++i)
+    {
+      const nsUInt32 uiIndex = NextIndex(expected.GetCount() - 1);
+      deque.RemoveAtAndCopy(uiIndex);
+      expected.RemoveAtAndCopy(uiIndex);
+    }
+
+    NS_TEST_INT(deque.GetCount(), expected.GetCount());
+
+    for (nsUInt32 i = 0; i < expected.GetCount(); ++i)
+    {
+      NS_TEST_INT(GetValue(deque[i]), expected[i]);
+    }
+  }
 } // namespace DequeTestDetail
 
 NS_CREATE_SIMPLE_TEST(Containers, Deque)
@@ -619,6 +659,17 @@ NS_CREATE_SIMPLE_TEST(Containers, Deque)
       NS_TEST_BOOL(nsMath::IsEven(a1[i]));
   }
 
+  NS_TEST_BLOCK(nsTestBlock::Enabled, "InsertAt / RemoveAtAndCopy across chunks")
+  {
+    DequeTestDetail::TestInsertRemoveInTheMiddle<nsInt32>();
+
+    DequeTestDetail::TestInsertRemoveInTheMiddle<nsConstructionCounterRelocatable>();
+    NS_TEST_BOOL(nsConstructionCounterRelocatable::HasAllDestructed());
+
+    DequeTestDetail::TestInsertRemoveInTheMiddle<DequeTestDetail::st>();
+    NS_TEST_BOOL(DequeTestDetail::st::HasAllDestructed());
+  }
+
   NS_TEST_BLOCK(nsTestBlock::Enabled, "ExpandAndGetRef")
   {
     nsDeque<nsInt32> a1;
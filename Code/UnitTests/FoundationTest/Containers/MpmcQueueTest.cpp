@@ -0,0 +1,189 @@
+#include <FoundationTest/FoundationTestPCH.h>
+
+#include <Foundation/Containers/MpmcQueue.h>
+#include <Foundation/Threading/Thread.h>
+#include <Foundation/Types/UniquePtr.h>
+
+using cc = nsConstructionCounter;
+
+namespace
+{
+  constexpr nsUInt32 s_uiNumThreads = 4;
+  constexpr nsUInt32 s_uiNumPushesPerThread = 20000;
+
+  class MpmcProducerThread : public nsThread
+  {
+  public:
+    MpmcProducerThread()
+      : nsThread("MPMC Producer")
+    {
+    }
+
+    virtual nsUInt32 Run()
+    {
+      for (nsUInt32 i = 0; i < s_uiNumPushesPerThread;)
+      {
+        // encode the producer, so that the consumers can check the order per producer
+        if (m_pQueue->TryPush(m_uiIndex * s_uiNumPushesPerThread + i))
+          ++i;
+        else
+          nsThreadUtils::YieldTimeSlice();
+      }
+
+      return 0;
+    }
+
+    nsMpmcQueue<nsUInt32>* m_pQueue = nullptr;
+    nsUInt32 m_uiIndex = 0;
+  };
+
+  class MpmcConsumerThread : public nsThread
+  {
+  public:
+    MpmcConsumerThread()
+      : nsThread("MPMC Consumer")
+    {
+    }
+
+    virtual nsUInt32 Run()
+    {
+      nsUInt32 uiLastValue[s_uiNumThreads];
+      for (nsUInt32& uiValue : uiLastValue)
+      {
+        uiValue = nsInvalidIndex;
+      }
+
+      nsUInt32 uiValue = 0;
+      while (m_pNumPopped->PostIncrement() < static_cast<nsInt32>(s_uiNumThreads * s_uiNumPushesPerThread))
+      {
+        while (!m_pQueue->TryPop(uiValue))
+        {
+          nsThreadUtils::YieldTimeSlice();
+        }
+
+        m_pSum->Add(uiValue);
+
+        // elements from the same producer arrive in order
+        const nsUInt32 uiProducer = uiValue / s_uiNumPushesPerThread;
+        if (uiLastValue[uiProducer] != nsInvalidIndex && uiLastValue[uiProducer] >= uiValue)
+        {
+          m_pOutOfOrder->Increment();
+        }
+
+        uiLastValue[uiProducer] = uiValue;
+      }
+
+      return 0;
+    }
+
+    nsMpmcQueue<nsUInt32>* m_pQueue = nullptr;
+    nsAtomicInteger32* m_pNumPopped = nullptr;
+    nsAtomicInteger64* m_pSum = nullptr;
+    nsAtomicInteger32* m_pOutOfOrder = nullptr;
+  };
+} // namespace
+
+NS_CREATE_SIMPLE_TEST(Containers, MpmcQueue)
+{
+  NS_TEST_BLOCK(nsTestBlock::Enabled, "Constructor / Destructor")
+  {
+    NS_TEST_BOOL(cc::HasAllDestructed());
+
+    {
+      nsMpmcQueue<cc> q(5);
+      NS_TEST_INT(q.GetCapacity(), 8);
+      NS_TEST_BOOL(q.IsEmpty());
+
+      NS_TEST_BOOL(q.TryPush(cc(1)));
+      NS_TEST_BOOL(q.TryPush(cc(2)));
+      NS_TEST_INT(q.GetCount(), 2);
+    }
+
+    // the destructor destructs the remaining elements
+    NS_TEST_BOOL(cc::HasAllDestructed());
+  }
+
+  NS_TEST_BLOCK(nsTestBlock::Enabled, "TryPush / TryPop")
+  {
+    nsMpmcQueue<nsInt32> q(4);
+
+    nsInt32 iValue = 0;
+    NS_TEST_BOOL(!q.TryPop(iValue));
+
+    // wrap around several times
+    for (nsInt32 iRound = 0; iRound < 10; ++iRound)
+    {
+      for (nsInt32 i = 0; i < 4; ++i)
+      {
+        NS_TEST_BOOL(q.TryPush(iRound * 4 + i));
+      }
+
+      NS_TEST_BOOL(!q.TryPush(-1));
+      NS_TEST_INT(q.GetCount(), 4);
+
+      for (nsInt32 i = 0; i < 4; ++i)
+      {
+        NS_TEST_BOOL(q.TryPop(iValue));
+        NS_TEST_INT(iValue, iRound * 4 + i);
+      }
+
+      NS_TEST_BOOL(q.IsEmpty());
+    }
+  }
+
+  NS_TEST_BLOCK(nsTestBlock::Enabled, "Move-only Elements")
+  {
+    nsMpmcQueue<nsUniquePtr<nsUInt32>> q(1);
+    NS_TEST_INT(q.GetCapacity(), 2);
+
+    NS_TEST_BOOL(q.TryPush(nsUniquePtr<nsUInt32>(NS_DEFAULT_NEW(nsUInt32, 1))));
+    NS_TEST_BOOL(q.TryPush(nsUniquePtr<nsUInt32>(NS_DEFAULT_NEW(nsUInt32, 2))));
+
+    // a failed push leaves the element untouched
+    nsUniquePtr<nsUInt32> pRejected(NS_DEFAULT_NEW(nsUInt32, 3));
+    NS_TEST_BOOL(!q.TryPush(std::move(pRejected)));
+    NS_TEST_BOOL(pRejected != nullptr);
+
+    nsUniquePtr<nsUInt32> pValue;
+    NS_TEST_BOOL(q.TryPop(pValue));
+    NS_TEST_INT(*pValue, 1);
+    NS_TEST_BOOL(q.TryPop(pValue));
+    NS_TEST_INT(*pValue, 2);
+    NS_TEST_BOOL(!q.TryPop(pValue));
+  }
+
+  NS_TEST_BLOCK(nsTestBlock::Enabled, "Multiple Producers / Consumers")
+  {
+    nsMpmcQueue<nsUInt32> q(64);
+    nsAtomicInteger32 iNumPopped;
+    nsAtomicInteger64 iSum;
+    nsAtomicInteger32 iOutOfOrder;
+
+    MpmcProducerThread producers[s_uiNumThreads];
+    MpmcConsumerThread consumers[s_uiNumThreads];
+
+    for (nsUInt32 i = 0; i < s_uiNumThreads; ++i)
+    {
+      consumers[i].m_pQueue = &q;
+      consumers[i].m_pNumPopped = &iNumPopped;
+      consumers[i].m_pSum = &iSum;
+      consumers[i].m_pOutOfOrder = &iOutOfOrder;
+      consumers[i].Start();
+
+      producers[i].m_pQueue = &q;
+      producers[i].m_uiIndex = i;
+      producers[i].Start();
+    }
+
+    for (nsUInt32 i = 0; i < s_uiNumThreads; ++i)
+    {
+      producers[i].Join();
+      consumers[i].Join();
+    }
+
+    const nsUInt64 uiNumValues = s_uiNumThreads * s_uiNumPushesPerThread;
+    NS_TEST_BOOL(iSum == static_cast<nsInt64>(uiNumValues * (uiNumValues - 1) / 2));
+    NS_TEST_INT(iOutOfOrder, 0);
+    NS_TEST_BOOL(q.IsEmpty());
+  }
+}
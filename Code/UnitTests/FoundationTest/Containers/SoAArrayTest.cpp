@@ -0,0 +1,310 @@
+#include <FoundationTest/FoundationTestPCH.h>
+
+#include <Foundation/Containers/SoAArray.h>
+#include <Foundation/Memory/CommonAllocators.h>
+#include <Foundation/SimdMath/SimdVec4f.h>
+#include <Foundation/Strings/String.h>
+#include <Foundation/Threading/TaskSystem.h>
+
+namespace
+{
+  using st = nsConstructionCounter;
+
+  struct alignas(32) OverAligned
+  {
+    NS_DECLARE_POD_TYPE();
+
+    float m_fValues[8];
+  };
+} // namespace
+
+NS_CREATE_SIMPLE_TEST(Containers, SoAArray)
+{
+  NS_TEST_BLOCK(nsTestBlock::Enabled, "Constructor")
+  {
+    nsSoAArray<float, nsInt32> a1;
+    NS_TEST_BOOL(a1.IsEmpty());
+    NS_TEST_INT(a1.GetCount(), 0);
+    NS_TEST_INT(a1.GetCapacity(), 0);
+    NS_TEST_INT(a1.GetHeapMemoryUsage(), 0);
+    NS_TEST_BOOL(a1.GetAllocator() == nsFoundation::GetAlignedAllocator());
+
+    nsAlignedHeapAllocator allocator("SoAArrayTest");
+    nsSoAArray<float, nsInt32> a2(&allocator);
+    NS_TEST_BOOL(a2.GetAllocator() == &allocator);
+
+    NS_TEST_INT((nsSoAArray<float, nsInt32, nsString>::NumColumns), 3);
+  }
+
+  NS_TEST_BLOCK(nsTestBlock::Enabled, "PushBack / Get / GetColumn")
+  {
+    nsSoAArray<float, nsInt32, nsString> a;
+
+    nsStringBuilder sName;
+    for (nsInt32 i = 0; i < 100; ++i)
+    {
+      sName.SetFormat("Item{0}", i);
+      NS_TEST_INT(a.PushBack(static_cast<float>(i) * 0.5f, i, nsString(sName)), i);
+    }
+
+    const nsString sLast = "Last";
+    NS_TEST_INT(a.PushBack(1.0f, -1, sLast), 100);
+
+    NS_TEST_INT(a.GetCount(), 101);
+    NS_TEST_BOOL(a.GetCapacity() >= 101);
+    NS_TEST_BOOL(nsMemoryUtils::IsSizeAligned(a.GetCapacity(), 16u));
+
+    for (nsInt32 i = 0; i < 100; ++i)
+    {
+      NS_TEST_FLOAT(a.Get<0>(i), static_cast<float>(i) * 0.5f, 0.0f);
+      NS_TEST_INT(a.Get<1>(i), i);
+
+      sName.SetFormat("Item{0}", i);
+      NS_TEST_STRING(a.Get<2>(i), sName);
+    }
+
+    NS_TEST_STRING(a.Get<2>(100), "Last");
+
+    nsArrayPtr<nsInt32> ints = a.GetColumn<1>();
+    NS_TEST_INT(ints.GetCount(), 101);
+    NS_TEST_INT(ints[42], 42);
+
+    ints[42] = 1000;
+    NS_TEST_INT(a.Get<1>(42), 1000);
+
+    const auto& ca = a;
+    nsArrayPtr<const nsString> names = ca.GetColumn<2>();
+    NS_TEST_STRING(names[7], "Item7");
+
+    NS_TEST_BOOL(nsMemoryUtils::IsAligned(a.GetColumn<0>().GetPtr(), 16));
+    NS_TEST_BOOL(nsMemoryUtils::IsAligned(a.GetColumn<1>().GetPtr(), 16));
+    NS_TEST_BOOL(nsMemoryUtils::IsAligned(a.GetColumn<2>().GetPtr(), 16));
+  }
+
+  NS_TEST_BLOCK(nsTestBlock::Enabled, "Over-aligned column")
+  {
+    nsSoAArray<nsUInt8, OverAligned, nsUInt8> a;
+
+    for (nsUInt32 i = 0; i < 50; ++i)
+    {
+      OverAligned value;
+      value.m_fValues[0] = static_cast<float>(i);
+      a.PushBack(static_cast<nsUInt8>(i), value, static_cast<nsUInt8>(i + 1));
+    }
+
+    NS_TEST_BOOL(nsMemoryUtils::IsAligned(a.GetColumn<1>().GetPtr(), 32));
+    NS_TEST_BOOL(nsMemoryUtils::IsAligned(a.GetColumn<2>().GetPtr(), 16));
+
+    for (nsUInt32 i = 0; i < 50; ++i)
+    {
+      NS_TEST_INT(a.Get<0>(i), i);
+      NS_TEST_FLOAT(a.Get<1>(i).m_fValues[0], static_cast<float>(i), 0.0f);
+      NS_TEST_INT(a.Get<2>(i), i + 1);
+    }
+  }
+
+  NS_TEST_BLOCK(nsTestBlock::Enabled, "SetCount / ExpandAndGetIndex / PopBack / Clear")
+  {
+    NS_TEST_BOOL(st::HasAllDestructed());
+
+    {
+      nsSoAArray<st, nsInt32> a;
+
+      a.SetCount(10);
+      NS_TEST_BOOL(st::HasDone(10, 0));
+      NS_TEST_INT(a.GetCount(), 10);
+      NS_TEST_INT(a.Get<1>(9), 0);
+
+      NS_TEST_INT(a.ExpandAndGetIndex(), 10);
+      NS_TEST_BOOL(st::HasDone(1, 0));
+
+      a.PopBack();
+      NS_TEST_BOOL(st::HasDone(0, 1));
+      NS_TEST_INT(a.GetCount(), 10);
+
+      a.SetCount(4);
+      NS_TEST_BOOL(st::HasDone(0, 6));
+
+      const nsUInt32 uiCapacity = a.GetCapacity();
+      a.Clear();
+      NS_TEST_BOOL(st::HasDone(0, 4));
+      NS_TEST_BOOL(a.IsEmpty());
+      NS_TEST_INT(a.GetCapacity(), uiCapacity);
+
+      a.PushBack(st(3), 3);
+      NS_TEST_BOOL(st::HasDone(2, 1)); // temporary + moved value
+    }
+
+    NS_TEST_BOOL(st::HasAllDestructed());
+  }
+
+  NS_TEST_BLOCK(nsTestBlock::Enabled, "Growth keeps values")
+  {
+    {
+      nsSoAArray<nsConstructionCounterRelocatable, nsString> a;
+
+      for (nsInt32 i = 0; i < 1000; ++i)
+      {
+        a.PushBack(nsConstructionCounterRelocatable(i), nsString("x"));
+      }
+
+      // relocatable columns are moved with memcpy when growing
+      NS_TEST_BOOL(nsConstructionCounterRelocatable::HasDone(1000, 0));
+
+      for (nsInt32 i = 0; i < 1000; ++i)
+      {
+        NS_TEST_INT(a.Get<0>(i).m_iData, i);
+        NS_TEST_STRING(a.Get<1>(i), "x");
+      }
+    }
+
+    NS_TEST_BOOL(nsConstructionCounterRelocatable::HasAllDestructed());
+  }
+
+  NS_TEST_BLOCK(nsTestBlock::Enabled, "RemoveAtAndSwap / RemoveAtAndCopy")
+  {
+    {
+      nsSoAArray<st, nsInt32> a;
+
+      for (nsInt32 i = 0; i < 10; ++i)
+      {
+        a.PushBack(st(i), i);
+      }
+
+      st::HasDone(0, 0); // reset
+
+      a.RemoveAtAndSwap(2);
+      NS_TEST_BOOL(st::HasDone(0, 1));
+      NS_TEST_INT(a.GetCount(), 9);
+      NS_TEST_INT(a.Get<0>(2).m_iData, 9);
+      NS_TEST_INT(a.Get<1>(2), 9);
+
+      a.RemoveAtAndSwap(8);
+      NS_TEST_BOOL(st::HasDone(0, 1));
+      NS_TEST_INT(a.GetCount(), 8);
+
+      // 0 1 9 3 4 5 6 7
+      a.RemoveAtAndCopy(1);
+      NS_TEST_BOOL(st::HasDone(0, 1));
+      NS_TEST_INT(a.GetCount(), 7);
+
+      const nsInt32 expected[] = {0, 9, 3, 4, 5, 6, 7};
+      for (nsUInt32 i = 0; i < 7; ++i)
+      {
+        NS_TEST_INT(a.Get<0>(i).m_iData, expected[i]);
+        NS_TEST_INT(a.Get<1>(i), expected[i]);
+      }
+
+      a.RemoveAtAndCopy(6);
+      a.RemoveAtAndSwap(0);
+      NS_TEST_INT(a.GetCount(), 5);
+      NS_TEST_INT(a.Get<1>(0), 6);
+    }
+
+    NS_TEST_BOOL(st::HasAllDestructed());
+  }
+
+  NS_TEST_BLOCK(nsTestBlock::Enabled, "Copy / Move / Swap")
+  {
+    nsAlignedHeapAllocator allocator("SoAArrayTest");
+
+    {
+      nsSoAArray<nsInt32, nsString> a;
+      a.PushBack(1, nsString("a"));
+      a.PushBack(2, nsString("b"));
+
+      nsSoAArray<nsInt32, nsString> b(a);
+      NS_TEST_INT(b.GetCount(), 2);
+      NS_TEST_INT(b.Get<0>(1), 2);
+      NS_TEST_STRING(b.Get<1>(1), "b");
+
+      b.PushBack(3, nsString("c"));
+
+      a = b;
+      NS_TEST_INT(a.GetCount(), 3);
+      NS_TEST_STRING(a.Get<1>(2), "c");
+
+      nsSoAArray<nsInt32, nsString> c(std::move(a));
+      NS_TEST_INT(c.GetCount(), 3);
+      NS_TEST_INT(a.GetCount(), 0);
+      NS_TEST_INT(a.GetHeapMemoryUsage(), 0);
+
+      nsSoAArray<nsInt32, nsString> d(&allocator);
+      d.PushBack(7, nsString("other allocator"));
+
+      // different allocators, the data is copied
+      d = std::move(c);
+      NS_TEST_INT(d.GetCount(), 3);
+      NS_TEST_INT(c.GetCount(), 0);
+      NS_TEST_BOOL(d.GetAllocator() == &allocator);
+      NS_TEST_STRING(d.Get<1>(0), "a");
+
+      a.Swap(d);
+      NS_TEST_INT(a.GetCount(), 3);
+      NS_TEST_INT(d.GetCount(), 0);
+      NS_TEST_BOOL(a.GetAllocator() == &allocator);
+      NS_TEST_STRING(a.Get<1>(2), "c");
+    }
+  }
+
+  NS_TEST_BLOCK(nsTestBlock::Enabled, "Reserve / Compact / GetHeapMemoryUsage")
+  {
+    nsSoAArray<nsUInt8, double> a;
+
+    a.Reserve(100);
+    NS_TEST_INT(a.GetCapacity(), 112);
+
+    // the double column starts at the next 16 byte boundary after the bytes
+    NS_TEST_INT(a.GetHeapMemoryUsage(), 112 + 112 * sizeof(double));
+
+    a.SetCount(20);
+    a.Compact();
+    NS_TEST_INT(a.GetCapacity(), 32);
+    NS_TEST_INT(a.Get<1>(19), 0.0);
+
+    a.Clear();
+    a.Compact();
+    NS_TEST_INT(a.GetCapacity(), 0);
+    NS_TEST_INT(a.GetHeapMemoryUsage(), 0);
+  }
+
+  NS_TEST_BLOCK(nsTestBlock::Enabled, "SIMD and ParallelFor column access")
+  {
+    nsSoAArray<float, float, nsUInt32> a;
+
+    for (nsUInt32 i = 0; i < 37; ++i)
+    {
+      a.PushBack(static_cast<float>(i), 2.0f, i);
+    }
+
+    // the capacity is padded, so the last group of four may be processed without a scalar tail
+    float* pPositions = a.GetColumn<0>().GetPtr();
+    const float* pVelocities = a.GetColumn<1>().GetPtr();
+
+    for (nsUInt32 i = 0; i < a.GetCount(); i += 4)
+    {
+      nsSimdVec4f pos, vel;
+      pos.Load<4>(pPositions + i);
+      vel.Load<4>(pVelocities + i);
+      pos = pos + vel;
+      pos.Store<4>(pPositions + i);
+    }
+
+    nsParallelForParams params;
+    params.m_uiBinSize = 8;
+    nsTaskSystem::ParallelFor(
+      a.GetColumn<2>(), [](nsArrayPtr<nsUInt32> ids)
+      {
+        for (nsUInt32& id : ids)
+        {
+          id *= 2;
+        } },
+      "SoAArrayTest", params);
+
+    for (nsUInt32 i = 0; i < 37; ++i)
+    {
+      NS_TEST_FLOAT(a.Get<0>(i), static_cast<float>(i) + 2.0f, 0.0f);
+      NS_TEST_INT(a.Get<2>(i), i * 2);
+    }
+  }
+}
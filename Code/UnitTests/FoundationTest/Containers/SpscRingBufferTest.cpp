@@ -0,0 +1,138 @@
+#include <FoundationTest/FoundationTestPCH.h>
+
+#include <Foundation/Containers/SpscRingBuffer.h>
+#include <Foundation/Threading/Thread.h>
+#include <Foundation/Types/UniquePtr.h>
+
+using cc = nsConstructionCounter;
+
+namespace
+{
+  constexpr nsUInt32 s_uiNumTransfers = 100000;
+
+  class SpscProducerThread : public nsThread
+  {
+  public:
+    SpscProducerThread(nsSpscRingBuffer<nsUInt32>& ref_queue)
+      : nsThread("SPSC Producer")
+      , m_Queue(ref_queue)
+    {
+    }
+
+    virtual nsUInt32 Run()
+    {
+      for (nsUInt32 i = 0; i < s_uiNumTransfers;)
+      {
+        if (m_Queue.TryPush(i))
+          ++i;
+        else
+          nsThreadUtils::YieldTimeSlice();
+      }
+
+      return 0;
+    }
+
+    nsSpscRingBuffer<nsUInt32>& m_Queue;
+  };
+} // namespace
+
+NS_CREATE_SIMPLE_TEST(Containers, SpscRingBuffer)
+{
+  NS_TEST_BLOCK(nsTestBlock::Enabled, "Constructor / Destructor")
+  {
+    NS_TEST_BOOL(cc::HasAllDestructed());
+
+    {
+      nsSpscRingBuffer<cc> q(10);
+      NS_TEST_INT(q.GetCapacity(), 16);
+      NS_TEST_BOOL(q.IsEmpty());
+
+      NS_TEST_BOOL(q.TryPush(cc(1)));
+      NS_TEST_BOOL(q.TryPush(cc(2)));
+      NS_TEST_INT(q.GetCount(), 2);
+    }
+
+    // the destructor destructs the remaining elements
+    NS_TEST_BOOL(cc::HasAllDestructed());
+  }
+
+  NS_TEST_BLOCK(nsTestBlock::Enabled, "TryPush / TryPop / TryPeek")
+  {
+    nsSpscRingBuffer<nsInt32> q(4);
+
+    nsInt32 iValue = 0;
+    NS_TEST_BOOL(!q.TryPop(iValue));
+    NS_TEST_BOOL(q.TryPeek() == nullptr);
+
+    // wrap around several times
+    for (nsInt32 iRound = 0; iRound < 10; ++iRound)
+    {
+      for (nsInt32 i = 0; i < 4; ++i)
+      {
+        NS_TEST_BOOL(q.TryPush(iRound * 4 + i));
+      }
+
+      NS_TEST_BOOL(!q.TryPush(-1));
+      NS_TEST_INT(q.GetCount(), 4);
+      NS_TEST_INT(*q.TryPeek(), iRound * 4);
+
+      for (nsInt32 i = 0; i < 4; ++i)
+      {
+        NS_TEST_BOOL(q.TryPop(iValue));
+        NS_TEST_INT(iValue, iRound * 4 + i);
+      }
+
+      NS_TEST_BOOL(q.IsEmpty());
+    }
+  }
+
+  NS_TEST_BLOCK(nsTestBlock::Enabled, "Move-only Elements")
+  {
+    nsSpscRingBuffer<nsUniquePtr<nsUInt32>> q(2);
+
+    NS_TEST_BOOL(q.TryPush(nsUniquePtr<nsUInt32>(NS_DEFAULT_NEW(nsUInt32, 1))));
+    NS_TEST_BOOL(q.TryPush(nsUniquePtr<nsUInt32>(NS_DEFAULT_NEW(nsUInt32, 2))));
+
+    // a failed push leaves the element untouched
+    nsUniquePtr<nsUInt32> pRejected(NS_DEFAULT_NEW(nsUInt32, 3));
+    NS_TEST_BOOL(!q.TryPush(std::move(pRejected)));
+    NS_TEST_BOOL(pRejected != nullptr);
+
+    nsUniquePtr<nsUInt32> pValue;
+    NS_TEST_BOOL(q.TryPop(pValue));
+    NS_TEST_INT(*pValue, 1);
+    NS_TEST_BOOL(q.TryPop(pValue));
+    NS_TEST_INT(*pValue, 2);
+    NS_TEST_BOOL(!q.TryPop(pValue));
+  }
+
+  NS_TEST_BLOCK(nsTestBlock::Enabled, "Producer / Consumer")
+  {
+    nsSpscRingBuffer<nsUInt32> q(64);
+
+    SpscProducerThread producer(q);
+    producer.Start();
+
+    nsUInt32 uiExpected = 0;
+    nsUInt32 uiValue = 0;
+    bool bInOrder = true;
+
+    while (uiExpected < s_uiNumTransfers)
+    {
+      if (q.TryPop(uiValue))
+      {
+        bInOrder &= (uiValue == uiExpected);
+        ++uiExpected;
+      }
+      else
+      {
+        nsThreadUtils::YieldTimeSlice();
+      }
+    }
+
+    producer.Join();
+
+    NS_TEST_BOOL(bInOrder);
+    NS_TEST_BOOL(q.IsEmpty());
+  }
+}
@@ -0,0 +1,237 @@
+#include <FoundationTest/FoundationTestPCH.h>
+
+#include <Foundation/Containers/DynamicArray.h>
+#include <Foundation/Containers/HashSet.h>
+#include <Foundation/Containers/SwissHashSet.h>
+#include <Foundation/Math/Random.h>
+
+// the control bytes are shared with nsSwissHashTable and tested there, these tests are about how the set uses them
+
+namespace SwissHashSetTestDetail
+{
+  /// all keys end up with the same hash, so every lookup has to go through H2 collisions and along the same probe sequence
+  /// 12 is mixed into a hash that starts probing at the last slot of a table with capacity 16
+  struct ConstantHasher
+  {
+    NS_ALWAYS_INLINE static nsUInt32 Hash(nsUInt32 uiKey)
+    {
+      NS_IGNORE_UNUSED(uiKey);
+      return 12;
+    }
+
+    NS_ALWAYS_INLINE static bool Equal(nsUInt32 a, nsUInt32 b) { return a == b; }
+  };
+
+  template <typename Set>
+  nsUInt32 GetIterationIndex(const Set& set, nsUInt32 uiKey)
+  {
+    nsUInt32 uiIndex = 0;
+    for (auto it = set.GetIterator(); it.IsValid(); ++it, ++uiIndex)
+    {
+      if (it.Key() == uiKey)
+        return uiIndex;
+    }
+
+    return nsInvalidIndex;
+  }
+} // namespace SwissHashSetTestDetail
+
+static_assert(nsGetTypeClass<nsSwissHashSet<nsUInt32>>::value == nsTypeIsMemRelocatable::value);
+
+NS_CREATE_SIMPLE_TEST(Containers, SwissHashSet)
+{
+  using namespace SwissHashSetTestDetail;
+
+  NS_TEST_BLOCK(nsTestBlock::Enabled, "H2 Collisions")
+  {
+    nsSwissHashSet<nsUInt32, ConstantHasher> set;
+    for (nsUInt32 i = 0; i < 200; ++i)
+    {
+      NS_TEST_BOOL(!set.Insert(i));
+    }
+
+    NS_TEST_BOOL(set.Insert(17));
+    NS_TEST_INT(set.GetCount(), 200);
+    NS_TEST_BOOL(!set.Contains(200));
+
+    for (nsUInt32 i = 0; i < 200; i += 2)
+    {
+      NS_TEST_BOOL(set.Remove(i));
+    }
+
+    for (nsUInt32 i = 0; i < 200; ++i)
+    {
+      NS_TEST_BOOL(set.Contains(i) == (i % 2 == 1));
+    }
+  }
+
+  NS_TEST_BLOCK(nsTestBlock::Enabled, "Tombstone Reuse")
+  {
+    nsSwissHashSet<nsUInt32, ConstantHasher> set;
+    for (nsUInt32 i = 0; i < 50; ++i)
+    {
+      set.Insert(i);
+    }
+
+    const nsUInt64 uiMemory = set.GetHeapMemoryUsage();
+    const nsUInt32 uiSlot = GetIterationIndex(set, 20);
+
+    // removing through the iterator frees the slot just like removing the key
+    auto it = set.GetIterator();
+    while (it.Key() != 20)
+    {
+      ++it;
+    }
+
+    it = set.Remove(it);
+    NS_TEST_BOOL(!set.Contains(20));
+
+    set.Insert(500);
+    NS_TEST_INT(GetIterationIndex(set, 500), uiSlot);
+    NS_TEST_INT(set.GetHeapMemoryUsage(), uiMemory);
+  }
+
+  NS_TEST_BLOCK(nsTestBlock::Enabled, "Rehash In Place")
+  {
+    nsSwissHashSet<nsUInt32> set;
+    for (nsUInt32 i = 0; i < 45; ++i)
+    {
+      set.Insert(i);
+    }
+
+    const nsUInt64 uiMemory = set.GetHeapMemoryUsage();
+
+    for (nsUInt32 i = 0; i < 10000; ++i)
+    {
+      NS_TEST_BOOL(set.Remove(i));
+      NS_TEST_BOOL(!set.Insert(i + 45));
+    }
+
+    NS_TEST_INT(set.GetCount(), 45);
+    NS_TEST_INT(set.GetHeapMemoryUsage(), uiMemory);
+
+    for (nsUInt32 i = 10000; i < 10045; ++i)
+    {
+      NS_TEST_BOOL(set.Contains(i));
+    }
+  }
+
+  NS_TEST_BLOCK(nsTestBlock::Enabled, "Wrap Around")
+  {
+    nsSwissHashSet<nsUInt32, ConstantHasher> set;
+    for (nsUInt32 i = 0; i < 14; ++i)
+    {
+      set.Insert(i);
+    }
+
+    const nsUInt64 uiMemory = set.GetHeapMemoryUsage();
+
+    // the first key goes into the last slot, the others continue at the start through the mirrored control bytes
+    NS_TEST_INT(GetIterationIndex(set, 0), 13);
+    NS_TEST_INT(GetIterationIndex(set, 1), 0);
+    NS_TEST_INT(GetIterationIndex(set, 13), 12);
+
+    nsUInt32 uiSum = 0;
+    for (nsUInt32 uiKey : set)
+    {
+      uiSum += uiKey;
+    }
+    NS_TEST_INT(uiSum, 91);
+
+    for (nsUInt32 i = 0; i < 14; ++i)
+    {
+      NS_TEST_BOOL(set.Remove(i));
+      set.Insert(i + 100);
+    }
+
+    NS_TEST_INT(set.GetHeapMemoryUsage(), uiMemory);
+
+    for (nsUInt32 i = 0; i < 14; ++i)
+    {
+      NS_TEST_BOOL(set.Contains(i + 100));
+    }
+
+    // the maximum load of capacity 16 is reached
+    set.Insert(200);
+    NS_TEST_BOOL(set.GetHeapMemoryUsage() > uiMemory);
+    NS_TEST_INT(set.GetCount(), 15);
+  }
+
+  NS_TEST_BLOCK(nsTestBlock::Enabled, "Same Results As nsHashSet")
+  {
+    nsRandom rnd;
+    rnd.Initialize(0xC0FFEE);
+
+    nsSwissHashSet<nsUInt32> swiss, swiss2;
+    nsHashSet<nsUInt32> reference, reference2;
+
+    for (nsUInt32 i = 0; i < 3000; ++i)
+    {
+      const nsUInt32 uiKey = rnd.UIntInRange(500);
+
+      switch (rnd.UIntInRange(3))
+      {
+        case 0:
+          NS_TEST_BOOL(swiss.Insert(uiKey) == reference.Insert(uiKey));
+          break;
+
+        case 1:
+          NS_TEST_BOOL(swiss.Remove(uiKey) == reference.Remove(uiKey));
+          break;
+
+        case 2:
+          swiss2.Insert(uiKey);
+          reference2.Insert(uiKey);
+          break;
+      }
+    }
+
+    auto Compare = [&](const nsSwissHashSet<nsUInt32>& s, const nsHashSet<nsUInt32>& r)
+    {
+      NS_TEST_INT(s.GetCount(), r.GetCount());
+
+      for (nsUInt32 uiKey : r)
+      {
+        NS_TEST_BOOL(s.Contains(uiKey));
+      }
+    };
+
+    Compare(swiss, reference);
+    NS_TEST_BOOL(swiss.ContainsSet(swiss2) == reference.ContainsSet(reference2));
+
+    nsSwissHashSet<nsUInt32> swissUnion = swiss;
+    nsHashSet<nsUInt32> referenceUnion = reference;
+    swissUnion.Union(swiss2);
+    referenceUnion.Union(reference2);
+    Compare(swissUnion, referenceUnion);
+    NS_TEST_BOOL(swissUnion.ContainsSet(swiss2));
+
+    nsSwissHashSet<nsUInt32> swissDifference = swiss;
+    nsHashSet<nsUInt32> referenceDifference = reference;
+    swissDifference.Difference(swiss2);
+    referenceDifference.Difference(reference2);
+    Compare(swissDifference, referenceDifference);
+
+    swiss.Intersection(swiss2);
+    reference.Intersection(reference2);
+    Compare(swiss, reference);
+  }
+
+  NS_TEST_BLOCK(nsTestBlock::Enabled, "Relocatable")
+  {
+    // the array relocates its elements with memcpy / memmove when it grows or shifts them
+    nsDynamicArray<nsSwissHashSet<nsUInt32>> sets;
+    for (nsUInt32 i = 0; i < 100; ++i)
+    {
+      sets.ExpandAndGetRef().Insert(i);
+    }
+
+    sets.RemoveAtAndCopy(0);
+
+    for (nsUInt32 i = 0; i < 99; ++i)
+    {
+      NS_TEST_BOOL(sets[i].Contains(i + 1));
+      NS_TEST_INT(sets[i].GetCount(), 1);
+    }
+  }
+}
@@ -0,0 +1,408 @@
+#include <FoundationTest/FoundationTestPCH.h>
+
+#include <Foundation/Containers/DynamicArray.h>
+#include <Foundation/Containers/HashTable.h>
+#include <Foundation/Containers/SwissHashTable.h>
+#include <Foundation/Math/Random.h>
+#include <Foundation/Strings/String.h>
+
+namespace SwissHashTableTestDetail
+{
+  using Control = nsInternal::nsSwissTable;
+
+  /// all keys end up with the same hash, so every lookup has to go through H2 collisions and along the same probe sequence
+  struct ConstantHasher
+  {
+    NS_ALWAYS_INLINE static nsUInt32 Hash(nsUInt32 uiKey)
+    {
+      NS_IGNORE_UNUSED(uiKey);
+      return 42;
+    }
+
+    NS_ALWAYS_INLINE static bool Equal(nsUInt32 a, nsUInt32 b) { return a == b; }
+  };
+
+  /// returns the position at which the key is visited by the iterator, which is the order of the slots
+  template <typename Table>
+  nsUInt32 GetIterationIndex(const Table& table, nsUInt32 uiKey)
+  {
+    nsUInt32 uiIndex = 0;
+    for (auto it = table.GetIterator(); it.IsValid(); ++it, ++uiIndex)
+    {
+      if (it.Key() == uiKey)
+        return uiIndex;
+    }
+
+    return nsInvalidIndex;
+  }
+} // namespace SwissHashTableTestDetail
+
+static_assert(nsGetTypeClass<nsSwissHashTable<nsUInt32, nsUInt32>>::value == nsTypeIsMemRelocatable::value);
+
+NS_CREATE_SIMPLE_TEST(Containers, SwissHashTable)
+{
+  using namespace SwissHashTableTestDetail;
+
+  NS_TEST_BLOCK(nsTestBlock::Enabled, "Control Bytes")
+  {
+    constexpr nsUInt32 uiCapacity = 32;
+    nsUInt8 control[uiCapacity + Control::GroupWidth];
+    Control::ResetControl(control, uiCapacity);
+
+    Control::SetControl(control, uiCapacity, 3, 0x11);
+    Control::SetControl(control, uiCapacity, 7, 0x11);
+    Control::SetControl(control, uiCapacity, 9, 0x22);
+    Control::SetControl(control, uiCapacity, 12, Control::Deleted);
+
+    const Control::Group group(control);
+
+    Control::BitMask mask = group.Match(0x11);
+    NS_TEST_INT(mask.GetLowest(), 3);
+    NS_TEST_INT(mask.GetHighest(), 7);
+    mask.ClearLowest();
+    NS_TEST_INT(mask.GetLowest(), 7);
+    mask.ClearLowest();
+    NS_TEST_BOOL(!mask.HasAny());
+
+    NS_TEST_BOOL(!group.Match(0x33).HasAny());
+    NS_TEST_INT(group.MatchEmpty().GetLowest(), 0);
+    NS_TEST_INT(group.MatchFull().GetHighest(), 9);
+
+    // the deleted slot is neither empty nor full
+    mask = group.MatchEmptyOrDeleted();
+    mask.m_uiMask &= ~group.MatchEmpty().m_uiMask;
+    NS_TEST_INT(mask.GetLowest(), 12);
+    mask.ClearLowest();
+    NS_TEST_BOOL(!mask.HasAny());
+
+    // only the first GroupWidth - 1 slots are mirrored behind the table
+    NS_TEST_INT(control[uiCapacity + 3], 0x11);
+    NS_TEST_INT(control[uiCapacity + 12], Control::Deleted);
+    Control::SetControl(control, uiCapacity, 20, 0x44);
+    NS_TEST_INT(control[uiCapacity + Control::GroupWidth - 1], Control::Empty);
+  }
+
+  NS_TEST_BLOCK(nsTestBlock::Enabled, "Erase To Empty Or Deleted")
+  {
+    constexpr nsUInt32 uiCapacity = 64;
+    nsUInt8 control[uiCapacity + Control::GroupWidth];
+
+    // no window of GroupWidth slots around slot 8 was full, so a search can never have passed it
+    Control::ResetControl(control, uiCapacity);
+    for (nsUInt32 i = 1; i < 16; ++i)
+    {
+      Control::SetControl(control, uiCapacity, i, 0x01);
+    }
+
+    NS_TEST_BOOL(Control::EraseControl(control, uiCapacity, 8));
+    NS_TEST_INT(control[8], Control::Empty);
+
+    // slots 0 to 15 are all full, so searches may have continued past slot 8
+    Control::ResetControl(control, uiCapacity);
+    for (nsUInt32 i = 0; i < 16; ++i)
+    {
+      Control::SetControl(control, uiCapacity, i, 0x01);
+    }
+
+    NS_TEST_BOOL(!Control::EraseControl(control, uiCapacity, 8));
+    NS_TEST_INT(control[8], Control::Deleted);
+    NS_TEST_INT(control[uiCapacity + 8], Control::Deleted);
+
+    // the full window wraps around the end of the table
+    Control::ResetControl(control, uiCapacity);
+    for (nsUInt32 i = 56; i < 72; ++i)
+    {
+      Control::SetControl(control, uiCapacity, i % uiCapacity, 0x01);
+    }
+
+    NS_TEST_BOOL(!Control::EraseControl(control, uiCapacity, 2));
+    NS_TEST_INT(control[2], Control::Deleted);
+    NS_TEST_BOOL(!Control::EraseControl(control, uiCapacity, 60));
+    NS_TEST_INT(control[60], Control::Deleted);
+
+    // deleted slots don't end a search, so the window is still considered full
+    NS_TEST_BOOL(!Control::EraseControl(control, uiCapacity, 7));
+    NS_TEST_INT(control[7], Control::Deleted);
+  }
+
+  NS_TEST_BLOCK(nsTestBlock::Enabled, "Probing")
+  {
+    // a group that starts near the end of the table reads the mirrored bytes of its first slots
+    constexpr nsUInt32 uiCapacity = 16;
+    nsUInt8 control[uiCapacity + Control::GroupWidth];
+    Control::ResetControl(control, uiCapacity);
+
+    for (nsUInt32 i = 0; i < uiCapacity; ++i)
+    {
+      if (i != 2)
+      {
+        Control::SetControl(control, uiCapacity, i, 0x01);
+      }
+    }
+
+    NS_TEST_INT(Control::FindFirstNonFull(control, uiCapacity, 10), 2);
+    NS_TEST_INT(Control::FindFirstNonFull(control, uiCapacity, 1), 2);
+
+    // deleted slots are reused before an empty slot further along the probe sequence
+    constexpr nsUInt32 uiCapacity2 = 64;
+    nsUInt8 control2[uiCapacity2 + Control::GroupWidth];
+    Control::ResetControl(control2, uiCapacity2);
+
+    for (nsUInt32 i = 0; i < 16; ++i)
+    {
+      Control::SetControl(control2, uiCapacity2, i, i == 4 ? Control::Deleted : 0x01);
+    }
+
+    NS_TEST_INT(Control::FindFirstNonFull(control2, uiCapacity2, 0), 4);
+
+    // the triangular probe sequence visits every group once
+    Control::ProbeSequence seq(0, 128);
+    nsUInt32 uiVisited = 0;
+    for (nsUInt32 i = 0; i < 128 / Control::GroupWidth; ++i)
+    {
+      NS_TEST_INT(seq.GetOffset() % Control::GroupWidth, 0);
+      uiVisited |= 1u << (seq.GetOffset() / Control::GroupWidth);
+      seq.Next();
+    }
+    NS_TEST_INT(uiVisited, 0xFF);
+
+    // maximum load of 87.5%
+    NS_TEST_INT(Control::GetMaxLoad(16), 14);
+    NS_TEST_INT(Control::GetCapacityForCount(14), 16);
+    NS_TEST_INT(Control::GetCapacityForCount(15), 32);
+    NS_TEST_BOOL(Control::ShouldRehashInPlace(90, 128));
+    NS_TEST_BOOL(!Control::ShouldRehashInPlace(110, 128));
+  }
+
+  NS_TEST_BLOCK(nsTestBlock::Enabled, "H2 Collisions")
+  {
+    // keys with the same H2, but different hashes
+    const nsUInt8 uiH2 = Control::H2(Control::MixHash(nsHashHelper<nsUInt32>::Hash(0)));
+
+    nsDynamicArray<nsUInt32> keys;
+    for (nsUInt32 uiKey = 0; keys.GetCount() < 41; ++uiKey)
+    {
+      if (Control::H2(Control::MixHash(nsHashHelper<nsUInt32>::Hash(uiKey))) == uiH2)
+      {
+        keys.PushBack(uiKey);
+      }
+    }
+
+    // the last one is never inserted
+    nsSwissHashTable<nsUInt32, nsUInt32> table;
+    for (nsUInt32 i = 0; i < 40; ++i)
+    {
+      NS_TEST_BOOL(!table.Insert(keys[i], i));
+    }
+
+    for (nsUInt32 i = 0; i < 40; ++i)
+    {
+      NS_TEST_INT(*table.GetValue(keys[i]), i);
+    }
+
+    NS_TEST_BOOL(!table.Contains(keys[40]));
+
+    for (nsUInt32 i = 0; i < 40; i += 2)
+    {
+      NS_TEST_BOOL(table.Remove(keys[i]));
+    }
+
+    for (nsUInt32 i = 0; i < 40; ++i)
+    {
+      NS_TEST_BOOL(table.Contains(keys[i]) == (i % 2 == 1));
+    }
+
+    // identical hashes for all keys
+    nsSwissHashTable<nsUInt32, nsUInt32, ConstantHasher> sameHash;
+    for (nsUInt32 i = 0; i < 100; ++i)
+    {
+      NS_TEST_BOOL(!sameHash.Insert(i, i * 10));
+    }
+
+    for (nsUInt32 i = 0; i < 100; ++i)
+    {
+      NS_TEST_INT(*sameHash.GetValue(i), i * 10);
+    }
+
+    NS_TEST_BOOL(!sameHash.Contains(100));
+
+    for (nsUInt32 i = 0; i < 100; i += 3)
+    {
+      NS_TEST_BOOL(sameHash.Remove(i));
+    }
+
+    for (nsUInt32 i = 0; i < 100; ++i)
+    {
+      NS_TEST_BOOL(sameHash.Contains(i) == (i % 3 != 0));
+    }
+  }
+
+  NS_TEST_BLOCK(nsTestBlock::Enabled, "Tombstone Reuse")
+  {
+    // all keys are on the same probe sequence, so the slots in front of a removed one are all in use
+    nsSwissHashTable<nsUInt32, nsUInt32, ConstantHasher> table;
+    for (nsUInt32 i = 0; i < 100; ++i)
+    {
+      table.Insert(i, i);
+    }
+
+    const nsUInt64 uiMemory = table.GetHeapMemoryUsage();
+    const nsUInt32 uiSlot = GetIterationIndex(table, 50);
+
+    NS_TEST_BOOL(table.Remove(50));
+    NS_TEST_BOOL(!table.Contains(50));
+    NS_TEST_INT(GetIterationIndex(table, 50), nsInvalidIndex);
+
+    // the next key takes the slot of the removed one
+    table.Insert(1000, 1000);
+    NS_TEST_INT(GetIterationIndex(table, 1000), uiSlot);
+    NS_TEST_INT(table.GetCount(), 100);
+    NS_TEST_INT(table.GetHeapMemoryUsage(), uiMemory);
+
+    for (nsUInt32 i = 0; i < 2000; ++i)
+    {
+      table.Remove(1000 + i);
+      table.Insert(1001 + i, i);
+    }
+
+    NS_TEST_INT(table.GetCount(), 100);
+    NS_TEST_INT(table.GetHeapMemoryUsage(), uiMemory);
+    NS_TEST_INT(*table.GetValue(3000), 1999);
+  }
+
+  NS_TEST_BLOCK(nsTestBlock::Enabled, "Rehash In Place")
+  {
+    // while the number of entries stays the same, removing and inserting other keys leaves deleted slots behind,
+    // they must be cleaned up without growing the table
+    nsSwissHashTable<nsUInt32, nsUInt32> table;
+    for (nsUInt32 i = 0; i < 90; ++i)
+    {
+      table.Insert(i, i);
+    }
+
+    const nsUInt64 uiMemory = table.GetHeapMemoryUsage();
+
+    for (nsUInt32 i = 0; i < 20000; ++i)
+    {
+      NS_TEST_BOOL(table.Remove(i));
+      NS_TEST_BOOL(!table.Insert(i + 90, i + 90));
+    }
+
+    NS_TEST_INT(table.GetCount(), 90);
+    NS_TEST_INT(table.GetHeapMemoryUsage(), uiMemory);
+
+    for (nsUInt32 i = 20000; i < 20090; ++i)
+    {
+      NS_TEST_INT(*table.GetValue(i), i);
+    }
+
+    NS_TEST_BOOL(!table.Contains(19999));
+  }
+
+  NS_TEST_BLOCK(nsTestBlock::Enabled, "Wrap Around")
+  {
+    // the smallest table is a single group, the probing starts somewhere in it and wraps around through the mirrored bytes
+    nsSwissHashTable<nsUInt32, nsUInt32, ConstantHasher> table;
+    for (nsUInt32 i = 0; i < 14; ++i)
+    {
+      table.Insert(i, i);
+    }
+
+    const nsUInt64 uiMemory = table.GetHeapMemoryUsage();
+
+    nsUInt32 uiNumIterated = 0;
+    for (auto it : table)
+    {
+      NS_TEST_INT(it.Key(), it.Value());
+      ++uiNumIterated;
+    }
+    NS_TEST_INT(uiNumIterated, 14);
+
+    for (nsUInt32 i = 0; i < 14; ++i)
+    {
+      NS_TEST_BOOL(table.Remove(i));
+      NS_TEST_BOOL(!table.Contains(i));
+      table.Insert(i + 100, i);
+    }
+
+    // a single group is never full, so nothing is ever marked as deleted and the table doesn't need to grow
+    NS_TEST_INT(table.GetHeapMemoryUsage(), uiMemory);
+
+    for (nsUInt32 i = 0; i < 14; ++i)
+    {
+      NS_TEST_INT(*table.GetValue(i + 100), i);
+    }
+
+    // the 15th entry exceeds the maximum load
+    table.Insert(200, 200);
+    NS_TEST_BOOL(table.GetHeapMemoryUsage() > uiMemory);
+    NS_TEST_INT(table.GetCount(), 15);
+  }
+
+  NS_TEST_BLOCK(nsTestBlock::Enabled, "Same Results As nsHashTable")
+  {
+    nsRandom rnd;
+    rnd.Initialize(0x5EED5EED);
+
+    nsSwissHashTable<nsString, nsUInt32> swiss;
+    nsHashTable<nsString, nsUInt32> reference;
+
+    nsStringBuilder sKey;
+    for (nsUInt32 i = 0; i < 5000; ++i)
+    {
+      sKey.SetFormat("Key{}", rnd.UIntInRange(1000));
+      const nsUInt32 uiValue = rnd.UInt();
+
+      switch (rnd.UIntInRange(4))
+      {
+        case 0:
+        case 1:
+          NS_TEST_BOOL(swiss.Insert(sKey, uiValue) == reference.Insert(sKey, uiValue));
+          break;
+
+        case 2:
+          NS_TEST_BOOL(swiss.Remove(sKey) == reference.Remove(sKey));
+          break;
+
+        case 3:
+          NS_TEST_BOOL(swiss.Contains(sKey) == reference.Contains(sKey));
+          break;
+      }
+    }
+
+    NS_TEST_INT(swiss.GetCount(), reference.GetCount());
+
+    for (auto it : reference)
+    {
+      const nsUInt32* pValue = swiss.GetValue(it.Key());
+      NS_TEST_BOOL(pValue != nullptr && *pValue == it.Value());
+    }
+
+    nsSwissHashTable<nsString, nsUInt32> copy = swiss;
+    NS_TEST_BOOL(copy == swiss);
+
+    copy.Compact();
+    NS_TEST_BOOL(copy == swiss);
+
+    nsSwissHashTable<nsString, nsUInt32> moved = std::move(copy);
+    NS_TEST_BOOL(moved == swiss);
+    NS_TEST_BOOL(copy.IsEmpty());
+  }
+
+  NS_TEST_BLOCK(nsTestBlock::Enabled, "Relocatable")
+  {
+    // the array relocates its elements with memcpy / memmove when it grows or shifts them
+    nsDynamicArray<nsSwissHashTable<nsUInt32, nsUInt32>> tables;
+    for (nsUInt32 i = 0; i < 100; ++i)
+    {
+      tables.ExpandAndGetRef().Insert(i, i * 2);
+    }
+
+    tables.RemoveAtAndCopy(0);
+
+    for (nsUInt32 i = 0; i < 99; ++i)
+    {
+      NS_TEST_INT(*tables[i].GetValue(i + 1), (i + 1) * 2);
+    }
+  }
+}
@@ -10,6 +10,13 @@
 
 static nsVariant CreateVariant(nsVariant::Type::Enum t, const void* pData);
 
+// temp hashed strings are stored as their hash, which depends on the hash function that is selected by NS_HASHING_VERSION
+#if NS_HASHING_VERSION >= 2
+#  define NS_DDL_TEST_HASH_GHIJK "1430966432680255535"
+#else
+#  define NS_DDL_TEST_HASH_GHIJK "2720389094277464445"
+#endif
+
 NS_CREATE_SIMPLE_TEST(IO, DdlUtils)
 {
   NS_TEST_BLOCK(nsTestBlock::Enabled, "nsOpenDdlUtils::ConvertToColor")
@@ -354,7 +361,7 @@ Data $v1 { string { \"Hello World\" } }\
   NS_TEST_BLOCK(nsTestBlock::Enabled, "nsOpenDdlUtils::ConvertToTempHashedString")
   {
     const char* szTestData = "\
-Data $v1 { uint64 { 2720389094277464445 } }\
+Data $v1 { uint64 { " NS_DDL_TEST_HASH_GHIJK " } }\
 ";
 
     StringStream stream(szTestData);
@@ -385,7 +392,7 @@ Quat $v10 { float { 0.1, 2, 3.2, 44.5 } }\
 Uuid $v11 { unsigned_int64 { 12345678910, 10987654321 } }\
 Angle $v12 { float { 45.23 } }\
 HashedString $v13 { string { \"Soo much string\" } }\
-TempHashedString $v14 { uint64 { 2720389094277464445 } }\
+TempHashedString $v14 { uint64 { " NS_DDL_TEST_HASH_GHIJK " } }\
 ";
 
     StringStream stream(szTestData);
@@ -593,7 +600,7 @@ TempHashedString $v14 { uint64 { 2720389094277464445 } }\
 
   NS_TEST_BLOCK(nsTestBlock::Enabled, "StoreTempHashedString")
   {
-    StreamComparer sc("TempHashedString $v1{uint64{2720389094277464445}}\n");
+    StreamComparer sc("TempHashedString $v1{uint64{" NS_DDL_TEST_HASH_GHIJK "}}\n");
 
     nsOpenDdlWriter js;
     js.SetOutputStream(&sc);
@@ -51,16 +51,25 @@ namespace JSONReaderTestDetail
 
         const nsVariantDictionary& vd = var.Get<nsVariantDictionary>();
 
+        // the order of a hash table depends on the hash function, so the keys are visited in sorted order
+        nsDynamicArray<nsString> keys;
         for (auto it = vd.GetIterator(); it.IsValid(); ++it)
+        {
+          keys.PushBack(it.Key());
+        }
+
+        keys.Sort();
+
+        for (const nsString& sKey : keys)
         {
           if (ref_compare.IsEmpty())
             return;
 
-          // nsLog::Printf("Expect: %s - Is: %s\n", it.Key().GetData(), Compare.PeekFront().GetData());
-          NS_TEST_STRING(ref_compare.PeekFront().GetData(), it.Key().GetData());
+          // nsLog::Printf("Expect: %s - Is: %s\n", sKey.GetData(), Compare.PeekFront().GetData());
+          NS_TEST_STRING(ref_compare.PeekFront().GetData(), sKey.GetData());
           ref_compare.PopFront();
 
-          TraverseTree(it.Value(), ref_compare);
+          TraverseTree(*vd.GetValue(sKey), ref_compare);
         }
 
         if (ref_compare.IsEmpty())
@@ -408,9 +417,7 @@ NS_CREATE_SIMPLE_TEST(IO, JSONReader)
 }");
     const char* szTestData = sTD.GetData();
 
-    // NOTE: The way this test is implemented, it might break, if the HashMap uses another insertion algorithm.
-    // nsVariantDictionary is an nsHashmap and this test currently relies on one exact order in of the result.
-    // If this should ever change (or be arbitrary at runtime), the test needs to be implemented in a more robust way.
+    // NOTE: nsVariantDictionary is a hash table, TraverseTree() visits its entries sorted by key, independent of the hash function.
 
     JSONReaderTestDetail::StringStream stream(szTestData);
 
@@ -419,14 +426,25 @@ NS_CREATE_SIMPLE_TEST(IO, JSONReader)
 
     nsDeque<nsString> sCompare;
     sCompare.PushBack("<object>");
-    sCompare.PushBack("int");
-    sCompare.PushBack("double 23.0000");
+
+    sCompare.PushBack(nsStringUtf8(L"MyNüll").GetData()); // unicode literal
+    sCompare.PushBack("null");
+
     sCompare.PushBack("String");
     sCompare.PushBack(nsStringUtf8(L"testvälue").GetData()); // unicode literal
 
+    sCompare.PushBack("bool");
+    sCompare.PushBack("bool true");
+
     sCompare.PushBack("double");
     sCompare.PushBack("double 43.5600");
 
+    sCompare.PushBack("float");
+    sCompare.PushBack("double 64.7200");
+
+    sCompare.PushBack("int");
+    sCompare.PushBack("double 23.0000");
+
     sCompare.PushBack("myarray");
     sCompare.PushBack("<array>");
     sCompare.PushBack("double 1.0000");
@@ -436,6 +454,12 @@ NS_CREATE_SIMPLE_TEST(IO, JSONReader)
     sCompare.PushBack("ende");
     sCompare.PushBack("</array>");
 
+    sCompare.PushBack("myarray2");
+    sCompare.PushBack("<array>");
+    sCompare.PushBack("");
+    sCompare.PushBack("double 2.2000");
+    sCompare.PushBack("</array>");
+
     sCompare.PushBack("object");
     sCompare.PushBack("<object>");
 
@@ -461,7 +485,6 @@ NS_CREATE_SIMPLE_TEST(IO, JSONReader)
 
     sCompare.PushBack("</array>");
 
-
     sCompare.PushBack("variable in subobject");
     sCompare.PushBack("blub\r\f\n\b\t"); // escaped special characters
 
@@ -472,24 +495,9 @@ NS_CREATE_SIMPLE_TEST(IO, JSONReader)
 
     sCompare.PushBack("</object>");
 
-    sCompare.PushBack("float");
-    sCompare.PushBack("double 64.7200");
-
-    sCompare.PushBack("myarray2");
-    sCompare.PushBack("<array>");
-    sCompare.PushBack("");
-    sCompare.PushBack("double 2.2000");
-    sCompare.PushBack("</array>");
-
-    sCompare.PushBack(nsStringUtf8(L"MyNüll").GetData()); // unicode literal
-    sCompare.PushBack("null");
-
     sCompare.PushBack("test");
     sCompare.PushBack("text");
 
-    sCompare.PushBack("bool");
-    sCompare.PushBack("bool true");
-
     sCompare.PushBack("</object>");
 
     if (NS_TEST_BOOL(reader.GetTopLevelElementType() == nsJSONReader::ElementType::Dictionary))
@@ -504,10 +512,6 @@ NS_CREATE_SIMPLE_TEST(IO, JSONReader)
   {
     const char* szTestData = "[\"a\",\"b\"]";
 
-    // NOTE: The way this test is implemented, it might break, if the HashMap uses another insertion algorithm.
-    // nsVariantDictionary is an nsHashmap and this test currently relies on one exact order in of the result.
-    // If this should ever change (or be arbitrary at runtime), the test needs to be implemented in a more robust way.
-
     JSONReaderTestDetail::StringStream stream(szTestData);
 
     nsJSONReader reader;
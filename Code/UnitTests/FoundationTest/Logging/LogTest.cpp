@@ -61,6 +61,21 @@ namespace
     nsStringBuilder m_Result;
   };
 
+  // counts how often it is turned into a string, to check that filtered messages are never formatted
+  struct CountedLogArg
+  {
+    nsUInt32* m_pNumFormatted = nullptr;
+  };
+
+  nsStringView BuildString(char* szTmp, nsUInt32 uiLength, const CountedLogArg& arg)
+  {
+    NS_IGNORE_UNUSED(szTmp);
+    NS_IGNORE_UNUSED(uiLength);
+
+    ++(*arg.m_pNumFormatted);
+    return "counted";
+  }
+
 } // namespace
 
 NS_CREATE_SIMPLE_TEST(Logging, Log)
@@ -254,3 +269,51 @@ NS_CREATE_SIMPLE_TEST(Logging, GlobalTestLog)
     }
   }
 }
+
+NS_CREATE_SIMPLE_TEST(Logging, LogLevel)
+{
+  LogTestLogInterface log;
+  nsLogSystemScope logScope(&log);
+
+  nsUInt32 uiNumFormatted = 0;
+  CountedLogArg arg{&uiNumFormatted};
+
+  NS_TEST_BLOCK(nsTestBlock::Enabled, "IsLogLevelEnabled")
+  {
+    log.SetLogLevel(nsLogMsgType::WarningMsg);
+
+    NS_TEST_BOOL(nsLog::IsLogLevelEnabled(nsLogMsgType::ErrorMsg));
+    NS_TEST_BOOL(nsLog::IsLogLevelEnabled(nsLogMsgType::WarningMsg));
+    NS_TEST_BOOL(!nsLog::IsLogLevelEnabled(nsLogMsgType::InfoMsg));
+    NS_TEST_BOOL(!nsLog::IsLogLevelEnabled(nsLogMsgType::ErrorMsg, nullptr));
+
+    const nsLogMsgType::Enum prevDefault = nsLog::GetDefaultLogLevel();
+    nsLog::SetDefaultLogLevel(nsLogMsgType::InfoMsg);
+    log.SetLogLevel(nsLogMsgType::GlobalDefault);
+
+    NS_TEST_BOOL(nsLog::IsLogLevelEnabled(nsLogMsgType::InfoMsg, &log));
+    NS_TEST_BOOL(!nsLog::IsLogLevelEnabled(nsLogMsgType::DevMsg, &log));
+
+    nsLog::SetDefaultLogLevel(prevDefault);
+  }
+
+  NS_TEST_BLOCK(nsTestBlock::Enabled, "Filtered messages are not formatted")
+  {
+    log.SetLogLevel(nsLogMsgType::WarningMsg);
+    log.m_Result.Clear();
+    uiNumFormatted = 0;
+
+    nsLog::Info("Info {}", arg);
+    nsLog::Info(&log, "Info {}", arg);
+    nsLog::Success(NS_FMT("Success {}"), arg);
+    nsLog::Success(&log, NS_FMT("Success {}"), arg);
+    NS_TEST_INT(uiNumFormatted, 0);
+    NS_TEST_BOOL(log.m_Result.IsEmpty());
+
+    nsLog::Warning("Warning {}", arg);
+    nsLog::Error(NS_FMT("Error {0} {0}"), arg);
+    nsLog::SeriousWarning(&log, NS_FMT("[Tag]Serious Warning"));
+    NS_TEST_INT(uiNumFormatted, 2);
+    NS_TEST_STRING(log.m_Result, "W: Warning counted\nE: Error counted counted\nSW:Tag Serious Warning\n");
+  }
+}
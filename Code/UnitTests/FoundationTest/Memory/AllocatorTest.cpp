@@ -1,8 +1,12 @@
 #include <FoundationTest/FoundationTestPCH.h>
 
+#include <Foundation/IO/MemoryStream.h>
 #include <Foundation/Memory/CommonAllocators.h>
+#include <Foundation/Memory/FrameAllocator.h>
 #include <Foundation/Memory/LargeBlockAllocator.h>
 #include <Foundation/Memory/LinearAllocator.h>
+#include <Foundation/Memory/PageAllocator.h>
+#include <Foundation/Threading/Thread.h>
 
 struct alignas(NS_ALIGNMENT_MINIMUM) NonAlignedVector
 {
@@ -82,8 +86,126 @@ void TestAlignmentHelper(size_t uiExpectedAlignment)
   }
 }
 
+// frees the allocations that another thread made
+class nsSizeClassHeapFreeThread : public nsThread
+{
+public:
+  nsSizeClassHeapFreeThread()
+    : nsThread("SizeClassHeap Free Thread")
+  {
+  }
+
+  nsAllocator* m_pAllocator = nullptr;
+  nsDynamicArray<void*> m_Allocations;
+
+private:
+  virtual nsUInt32 Run() override
+  {
+    for (void* pPtr : m_Allocations)
+    {
+      m_pAllocator->Deallocate(pPtr);
+    }
+
+    // allocate some on this thread as well, they are freed again when the thread's cache is released
+    for (nsUInt32 i = 0; i < 100; ++i)
+    {
+      m_Allocations[i] = m_pAllocator->Allocate(24, 8);
+    }
+
+    for (nsUInt32 i = 0; i < 100; ++i)
+    {
+      m_pAllocator->Deallocate(m_Allocations[i]);
+    }
+
+    return 0;
+  }
+};
+
+class nsTrackedAllocationThread : public nsThread
+{
+public:
+  nsTrackedAllocationThread(nsAllocator* pAllocator)
+    : nsThread("Tracked Allocation Thread")
+    , m_pAllocator(pAllocator)
+  {
+  }
+
+  static constexpr nsUInt32 NumAllocations = 500;
+  static constexpr nsUInt32 NumRounds = 20;
+
+private:
+  virtual nsUInt32 Run() override
+  {
+    void* allocations[NumAllocations];
+
+    for (nsUInt32 uiRound = 0; uiRound < NumRounds; ++uiRound)
+    {
+      for (nsUInt32 i = 0; i < NumAllocations; ++i)
+      {
+        allocations[i] = m_pAllocator->Allocate(16 + i, 8);
+      }
+
+      for (nsUInt32 i = 0; i < NumAllocations; ++i)
+      {
+        if (m_pAllocator->AllocatedSize(allocations[i]) != 16 + i)
+          m_uiNumErrors++;
+
+        m_pAllocator->Deallocate(allocations[i]);
+      }
+    }
+
+    return 0;
+  }
+
+public:
+  nsAllocator* m_pAllocator;
+  nsUInt32 m_uiNumErrors = 0;
+};
+
 NS_CREATE_SIMPLE_TEST_GROUP(Memory);
 
+class nsFrameAllocatorThread : public nsThread
+{
+public:
+  nsFrameAllocatorThread(nsAllocator* pObjectAllocator, nsConstructionCounter* pObject)
+    : nsThread("Frame Allocator Thread")
+    , m_pObjectAllocator(pObjectAllocator)
+    , m_pObject(pObject)
+  {
+  }
+
+  nsThreadLinearAllocator* m_pThreadAllocator = nullptr;
+  nsUInt32 m_uiNumErrors = 0;
+
+private:
+  virtual nsUInt32 Run() override
+  {
+    // deleting an object of another thread's allocator
+    NS_DELETE(m_pObjectAllocator, m_pObject);
+
+    m_pThreadAllocator = nsFrameAllocator::GetThreadAllocator();
+
+    for (nsUInt32 i = 0; i < 100; ++i)
+    {
+      nsFrameAllocatorScope scope;
+
+      nsUInt8* pData = static_cast<nsUInt8*>(scope.GetAllocator()->Allocate(1024, 16));
+      nsMemoryUtils::PatternFill(pData, static_cast<nsUInt8>(i), 1024);
+
+      if (pData[1023] != static_cast<nsUInt8>(i))
+        m_uiNumErrors++;
+    }
+
+    if (m_pThreadAllocator->GetUsedBytes() != 0)
+      m_uiNumErrors++;
+
+    return 0;
+  }
+
+  nsAllocator* m_pObjectAllocator;
+  nsConstructionCounter* m_pObject;
+};
+
 NS_CREATE_SIMPLE_TEST(Memory, Allocator)
 {
   NS_TEST_BLOCK(nsTestBlock::Enabled, "Alignment")
@@ -167,6 +289,390 @@ NS_CREATE_SIMPLE_TEST(Memory, Allocator)
     NS_TEST_BOOL(stats.m_uiAllocationSize == 0);
   }
 
+  NS_TEST_BLOCK(nsTestBlock::Enabled, "PageAllocator")
+  {
+    const size_t uiPageSize = nsSystemInformation::Get().GetMemoryPageSize();
+    const nsPageAllocator::Stats statsBefore = nsPageAllocator::GetStats();
+
+    // transparent huge pages are only a hint, the memory must be usable either way
+    {
+      const size_t uiSize = 4 * 1024 * 1024;
+      nsUInt8* pData = static_cast<nsUInt8*>(nsPageAllocator::AllocatePage(uiSize, 0, nsPageAllocationFlags::TransparentHugePages));
+      NS_TEST_BOOL(pData != nullptr);
+      NS_TEST_BOOL(nsMemoryUtils::IsAligned(pData, uiPageSize));
+
+      if (nsPageAllocator::GetHugePageSize() > 0)
+      {
+        NS_TEST_BOOL(nsMemoryUtils::IsAligned(pData, nsPageAllocator::GetHugePageSize()));
+      }
+
+      nsMemoryUtils::PatternFill(pData, 0xAB, static_cast<nsUInt32>(uiSize));
+      NS_TEST_INT(pData[uiSize - 1], 0xAB);
+
+      // other threads may allocate pages at the same time and the heap may hand out a larger block than requested
+      const nsPageAllocator::Stats stats = nsPageAllocator::GetStats();
+      NS_TEST_BOOL(stats.m_uiAllocatedBytes >= statsBefore.m_uiAllocatedBytes + uiSize);
+      NS_TEST_BOOL(stats.m_uiHugePageRequestedBytes >= statsBefore.m_uiHugePageRequestedBytes + uiSize);
+
+      nsPageAllocator::DeallocatePage(pData);
+    }
+
+    // the huge page pool is usually empty, then regular pages are used instead
+    {
+      const size_t uiSize = 2 * 1024 * 1024;
+      nsUInt8* pData = static_cast<nsUInt8*>(nsPageAllocator::AllocatePage(uiSize, 0, nsPageAllocationFlags::ExplicitHugePages));
+      NS_TEST_BOOL(pData != nullptr);
+
+      nsMemoryUtils::PatternFill(pData, 0xCD, static_cast<nsUInt32>(uiSize));
+      NS_TEST_INT(pData[uiSize - 1], 0xCD);
+
+      const nsPageAllocator::Stats stats = nsPageAllocator::GetStats();
+      NS_TEST_BOOL(stats.m_uiExplicitHugePageBytes > statsBefore.m_uiExplicitHugePageBytes || stats.m_uiNumExplicitHugePageFailures > statsBefore.m_uiNumExplicitHugePageFailures);
+
+      nsPageAllocator::DeallocatePage(pData);
+    }
+
+    {
+      const nsPageAllocator::Stats stats = nsPageAllocator::GetStats();
+      NS_TEST_BOOL(stats.m_uiHugePageRequestedBytes == statsBefore.m_uiHugePageRequestedBytes);
+      NS_TEST_BOOL(stats.m_uiExplicitHugePageBytes == statsBefore.m_uiExplicitHugePageBytes);
+    }
+
+    // reserve a large range and only commit parts of it
+    {
+      const size_t uiReserveSize = 64 * 1024 * 1024;
+      const size_t uiCommitSize = 1024 * 1024;
+
+      nsUInt8* pRange = static_cast<nsUInt8*>(nsPageAllocator::ReservePages(uiReserveSize));
+      NS_TEST_BOOL(pRange != nullptr);
+      NS_TEST_BOOL(nsMemoryUtils::IsAligned(pRange, uiPageSize));
+
+      nsPageAllocator::Stats stats = nsPageAllocator::GetStats();
+      NS_TEST_BOOL(stats.m_uiReservedBytes - statsBefore.m_uiReservedBytes == uiReserveSize);
+      NS_TEST_BOOL(stats.m_uiCommittedBytes == statsBefore.m_uiCommittedBytes);
+
+      nsUInt8* pCommitted = pRange + uiReserveSize / 2;
+      NS_TEST_BOOL(nsPageAllocator::CommitPages(pCommitted, uiCommitSize).Succeeded());
+
+      // committed memory is zero initialized
+      NS_TEST_INT(pCommitted[0], 0);
+      NS_TEST_INT(pCommitted[uiCommitSize - 1], 0);
+
+      nsMemoryUtils::PatternFill(pCommitted, 0xEF, static_cast<nsUInt32>(uiCommitSize));
+      NS_TEST_INT(pCommitted[uiCommitSize - 1], 0xEF);
+
+      stats = nsPageAllocator::GetStats();
+      NS_TEST_BOOL(stats.m_uiCommittedBytes - statsBefore.m_uiCommittedBytes == uiCommitSize);
+
+      nsPageAllocator::DecommitPages(pCommitted, uiCommitSize);
+
+      stats = nsPageAllocator::GetStats();
+      NS_TEST_BOOL(stats.m_uiCommittedBytes == statsBefore.m_uiCommittedBytes);
+
+      // can be committed again after it was decommitted
+      NS_TEST_BOOL(nsPageAllocator::CommitPages(pCommitted, uiCommitSize).Succeeded());
+      NS_TEST_INT(pCommitted[0], 0);
+
+      nsPageAllocator::ReleasePages(pRange, uiReserveSize);
+
+      stats = nsPageAllocator::GetStats();
+      NS_TEST_BOOL(stats.m_uiReservedBytes == statsBefore.m_uiReservedBytes);
+      NS_TEST_BOOL(stats.m_uiCommittedBytes == statsBefore.m_uiCommittedBytes);
+    }
+
+    // NUMA placement
+    {
+      const nsUInt32 uiNumNodes = nsPageAllocator::GetNumaNodeCount();
+      NS_TEST_BOOL(uiNumNodes >= 1);
+
+      const nsUInt32 uiNode = nsPageAllocator::GetCurrentNumaNode();
+      NS_TEST_BOOL(uiNode < uiNumNodes);
+
+      nsUInt8* pData = static_cast<nsUInt8*>(nsPageAllocator::AllocatePage(64 * 1024, 0, nsPageAllocationFlags::Default, uiNode));
+      NS_TEST_BOOL(pData != nullptr);
+
+      nsMemoryUtils::PatternFill(pData, 0x12, 64 * 1024);
+      NS_TEST_INT(pData[64 * 1024 - 1], 0x12);
+
+      // sizes that are not a multiple of the page size, with a larger alignment
+      nsUInt8* pData2 = static_cast<nsUInt8*>(nsPageAllocator::AllocatePage(64 * 1024 + 100, 64 * 1024, nsPageAllocationFlags::Default, uiNode));
+      NS_TEST_BOOL(nsMemoryUtils::IsAligned(pData2, 64 * 1024));
+
+      nsMemoryUtils::PatternFill(pData2, 0x34, 64 * 1024 + 100);
+      NS_TEST_INT(pData2[64 * 1024 + 99], 0x34);
+
+      nsPageAllocator::DeallocatePage(pData);
+      nsPageAllocator::DeallocatePage(pData2);
+    }
+  }
+
+  NS_TEST_BLOCK(nsTestBlock::Enabled, "SizeClassHeapAllocator")
+  {
+    nsSizeClassHeapAllocator allocator("TestSizeClassHeap");
+
+    const size_t sizes[] = {1, 8, 16, 17, 100, 128, 129, 1000, 4096, 8192, 8193, 100000};
+    const size_t alignments[] = {1, 8, 16, 64, 256, 4096};
+
+    nsDynamicArray<void*> allocations;
+
+    for (const size_t uiSize : sizes)
+    {
+      for (const size_t uiAlign : alignments)
+      {
+        NS_TEST_BOOL(nsAllocPolicySizeClassHeap::GetAllocationSize(uiSize, uiAlign) >= uiSize);
+
+        void* pPtr = allocator.Allocate(uiSize, uiAlign);
+        NS_TEST_BOOL(pPtr != nullptr);
+        NS_TEST_BOOL(nsMemoryUtils::IsAligned(pPtr, uiAlign));
+
+        nsMemoryUtils::PatternFill(static_cast<nsUInt8*>(pPtr), 0xAB, static_cast<nsUInt32>(uiSize));
+        allocations.PushBack(pPtr);
+      }
+    }
+
+    // objects are handed out again once they are freed
+    void* pFirst = allocator.Allocate(48, 8);
+    allocator.Deallocate(pFirst);
+    NS_TEST_BOOL(allocator.Allocate(48, 8) == pFirst);
+    allocator.Deallocate(pFirst);
+
+    for (void* pPtr : allocations)
+    {
+      allocator.Deallocate(pPtr);
+    }
+
+    // more objects than fit into a thread cache or a single span, freed on another thread
+    nsSizeClassHeapFreeThread thread;
+    thread.m_pAllocator = &allocator;
+
+    for (nsUInt32 i = 0; i < 10000; ++i)
+    {
+      void* pPtr = allocator.Allocate(16 + (i % 8) * 16, 8);
+      nsMemoryUtils::PatternFill(static_cast<nsUInt8*>(pPtr), static_cast<nsUInt8>(i), 16);
+      thread.m_Allocations.PushBack(pPtr);
+    }
+
+    thread.Start();
+    thread.Join();
+
+    // the freed objects are available to this thread again
+    for (nsUInt32 i = 0; i < 10000; ++i)
+    {
+      thread.m_Allocations[i] = allocator.Allocate(16 + (i % 8) * 16, 8);
+    }
+
+    for (void* pPtr : thread.m_Allocations)
+    {
+      allocator.Deallocate(pPtr);
+    }
+
+    if constexpr (nsAllocatorTrackingMode::Default >= nsAllocatorTrackingMode::AllocationStats)
+    {
+      const nsAllocator::Stats stats = allocator.GetStats();
+      NS_TEST_INT(stats.m_uiNumAllocations - stats.m_uiNumDeallocations, 0);
+      NS_TEST_INT(stats.m_uiAllocationSize, 0);
+    }
+  }
+
+  NS_TEST_BLOCK(nsTestBlock::Enabled, "PoolAllocator")
+  {
+    nsPoolAllocator allocator("TestPool");
+
+    const size_t sizes[] = {1, 8, 16, 17, 48, 100, 128, 1000, 1024, 1025, 100000};
+    const size_t alignments[] = {1, 8, 16, 64, 256};
+
+    nsDynamicArray<void*> allocations;
+
+    for (const size_t uiSize : sizes)
+    {
+      for (const size_t uiAlign : alignments)
+      {
+        NS_TEST_BOOL(nsAllocPolicyPool::GetAllocationSize(uiSize, uiAlign) >= uiSize);
+
+        void* pPtr = allocator.Allocate(uiSize, uiAlign);
+        NS_TEST_BOOL(pPtr != nullptr);
+        NS_TEST_BOOL(nsMemoryUtils::IsAligned(pPtr, uiAlign));
+
+        nsMemoryUtils::PatternFill(static_cast<nsUInt8*>(pPtr), 0xAB, static_cast<nsUInt32>(uiSize));
+        allocations.PushBack(pPtr);
+      }
+    }
+
+    for (void* pPtr : allocations)
+    {
+      allocator.Deallocate(pPtr);
+    }
+
+    // large and over-aligned allocations are forwarded with their own size and alignment, instead of getting a slab
+    {
+      nsAllocatorWithPolicy<nsAllocPolicyAlignedHeap, nsAllocatorTrackingMode::AllocationStats> parent("TestPoolParent");
+      nsAllocatorWithPolicy<nsAllocPolicyPool> pool("TestPoolWithParent", &parent);
+
+      void* pLarge = pool.Allocate(5000, 8);
+      void* pAligned = pool.Allocate(32, 256);
+      NS_TEST_BOOL(nsMemoryUtils::IsAligned(pAligned, 256));
+      NS_TEST_INT(parent.GetStats().m_uiNumAllocations, 2);
+      NS_TEST_BOOL(parent.GetStats().m_uiAllocationSize < nsAllocPolicyPool::SlabSize);
+
+      // pooled objects and forwarded allocations can be freed in any order
+      void* pSmall = pool.Allocate(32, 8);
+      const nsAllocator::Stats statsWithSlabs = parent.GetStats();
+      NS_TEST_BOOL(statsWithSlabs.m_uiAllocationSize >= nsAllocPolicyPool::SlabSize);
+
+      pool.Deallocate(pLarge);
+      pool.Deallocate(pSmall);
+      pool.Deallocate(pAligned);
+
+      // only the forwarded allocations are returned to the parent, the slabs stay until the pool is destroyed
+      const nsAllocator::Stats statsAfter = parent.GetStats();
+      NS_TEST_INT(statsAfter.m_uiNumDeallocations, statsWithSlabs.m_uiNumDeallocations + 2);
+      NS_TEST_INT(statsAfter.m_uiAllocationSize, statsWithSlabs.m_uiAllocationSize - 5000 - 32);
+    }
+
+    // objects of the same size are handed out again once they are freed
+    void* pFirst = allocator.Allocate(40, 8);
+    allocator.Deallocate(pFirst);
+    NS_TEST_BOOL(allocator.Allocate(40, 8) == pFirst);
+    allocator.Deallocate(pFirst);
+
+    // NS_NEW and NS_DELETE
+    {
+      nsConstructionCounter* pCounter = NS_NEW(&allocator, nsConstructionCounter);
+      NS_TEST_BOOL(nsConstructionCounter::HasConstructed(1));
+
+      NS_DELETE(&allocator, pCounter);
+      NS_TEST_BOOL(nsConstructionCounter::HasDestructed(1));
+    }
+
+    // containers with many nodes
+    {
+      nsMap<nsUInt32, nsUInt32, nsCompareHelper<nsUInt32>, nsPoolAllocatorWrapper> map;
+
+      for (nsUInt32 i = 0; i < 10000; ++i)
+      {
+        map[i] = i * 2;
+      }
+
+      for (nsUInt32 i = 0; i < 10000; i += 2)
+      {
+        map.Remove(i);
+      }
+
+      NS_TEST_INT(map.GetCount(), 5000);
+      NS_TEST_INT(map[9999], 19998);
+    }
+
+    // more objects than fit into a magazine or a single slab, freed on another thread
+    nsSizeClassHeapFreeThread thread;
+    thread.m_pAllocator = &allocator;
+
+    for (nsUInt32 i = 0; i < 10000; ++i)
+    {
+      void* pPtr = allocator.Allocate(16 + (i % 8) * 16, 8);
+      nsMemoryUtils::PatternFill(static_cast<nsUInt8*>(pPtr), static_cast<nsUInt8>(i), 16);
+      thread.m_Allocations.PushBack(pPtr);
+    }
+
+    thread.Start();
+    thread.Join();
+
+    // the freed objects are available to this thread again
+    for (nsUInt32 i = 0; i < 10000; ++i)
+    {
+      thread.m_Allocations[i] = allocator.Allocate(16 + (i % 8) * 16, 8);
+    }
+
+    for (void* pPtr : thread.m_Allocations)
+    {
+      allocator.Deallocate(pPtr);
+    }
+
+    if constexpr (nsAllocatorTrackingMode::Default >= nsAllocatorTrackingMode::AllocationStats)
+    {
+      const nsAllocator::Stats stats = allocator.GetStats();
+      NS_TEST_INT(stats.m_uiNumAllocations - stats.m_uiNumDeallocations, 0);
+      NS_TEST_INT(stats.m_uiAllocationSize, 0);
+    }
+  }
+
+  NS_TEST_BLOCK(nsTestBlock::Enabled, "Allocation tracking on multiple threads")
+  {
+    nsAllocatorWithPolicy<nsAllocPolicyHeap, nsAllocatorTrackingMode::AllocationStats> allocator("TestTrackedAllocator");
+
+    nsTrackedAllocationThread thread0(&allocator);
+    nsTrackedAllocationThread thread1(&allocator);
+    nsTrackedAllocationThread thread2(&allocator);
+    nsTrackedAllocationThread thread3(&allocator);
+
+    thread0.Start();
+    thread1.Start();
+    thread2.Start();
+    thread3.Start();
+
+    thread0.Join();
+    thread1.Join();
+    thread2.Join();
+    thread3.Join();
+
+    NS_TEST_INT(thread0.m_uiNumErrors + thread1.m_uiNumErrors + thread2.m_uiNumErrors + thread3.m_uiNumErrors, 0);
+
+    const nsUInt64 uiExpectedAllocations = 4 * nsTrackedAllocationThread::NumAllocations * nsTrackedAllocationThread::NumRounds;
+
+    nsAllocator::Stats stats = allocator.GetStats();
+    NS_TEST_INT(stats.m_uiNumAllocations, uiExpectedAllocations);
+    NS_TEST_INT(stats.m_uiNumDeallocations, uiExpectedAllocations);
+    NS_TEST_INT(stats.m_uiAllocationSize, 0);
+
+    void* pPtr = allocator.Allocate(100, 8);
+    NS_TEST_INT(allocator.AllocatedSize(pPtr), 100);
+    NS_TEST_INT(allocator.GetStats().m_uiAllocationSize, 100);
+    allocator.Deallocate(pPtr);
+    NS_TEST_INT(allocator.GetStats().m_uiAllocationSize, 0);
+  }
+
+  NS_TEST_BLOCK(nsTestBlock::Enabled, "Allocation sampling")
+  {
+    nsAllocatorWithPolicy<nsAllocPolicyHeap, nsAllocatorTrackingMode::Basics> allocator("TestSampledAllocator");
+
+    nsMemoryTracker::SetSamplingInterval(4096);
+    NS_TEST_INT(nsMemoryTracker::GetSamplingInterval(), 4096);
+
+    nsDynamicArray<void*> allocations;
+    for (nsUInt32 i = 0; i < 2000; ++i)
+    {
+      allocations.PushBack(allocator.Allocate(1000, 8));
+    }
+
+    // roughly 400 samples are expected, so the estimate should be well within 20 percent
+    nsMemoryTracker::SamplingStats stats = nsMemoryTracker::GetSamplingStats(allocator.GetId());
+    NS_TEST_BOOL(stats.m_uiNumLiveSamples > 200 && stats.m_uiNumLiveSamples < 800);
+    NS_TEST_BOOL(stats.m_uiEstimatedLiveBytes > 1600000 && stats.m_uiEstimatedLiveBytes < 2400000);
+    NS_TEST_BOOL(stats.m_uiNumCallSites >= 1);
+
+    nsContiguousMemoryStreamStorage storage;
+    nsMemoryStreamWriter writer(&storage);
+    NS_TEST_BOOL(nsMemoryTracker::WriteSampledAllocations(writer).Succeeded());
+
+    nsStringBuilder sOutput;
+    sOutput.SetSubString_ElementCount(reinterpret_cast<const char*>(storage.GetData()), storage.GetStorageSize32());
+    NS_TEST_BOOL(sOutput.FindSubString("TestSampledAllocator;") != nullptr);
+    NS_TEST_BOOL(sOutput.EndsWith("\n"));
+
+    for (void* pPtr : allocations)
+    {
+      allocator.Deallocate(pPtr);
+    }
+
+    stats = nsMemoryTracker::GetSamplingStats(allocator.GetId());
+    NS_TEST_INT(stats.m_uiNumLiveSamples, 0);
+    NS_TEST_INT(stats.m_uiEstimatedLiveBytes, 0);
+
+    nsMemoryTracker::SetSamplingInterval(0);
+    nsMemoryTracker::ResetSampledAllocations();
+
+    NS_TEST_INT(nsMemoryTracker::GetSamplingStats().m_uiNumCallSites, 0);
+  }
+
   NS_TEST_BLOCK(nsTestBlock::Enabled, "StackAllocator")
   {
     nsLinearAllocator<> allocator("TestStackAllocator", nsFoundation::GetAlignedAllocator());
@@ -242,4 +748,85 @@ NS_CREATE_SIMPLE_TEST(Memory, Allocator)
 
     NS_TEST_BOOL(nsConstructionCounter::HasDestructed(50));
   }
+
+  NS_TEST_BLOCK(nsTestBlock::Enabled, "ThreadFrameAllocator")
+  {
+    nsThreadLinearAllocator* pAllocator = nsFrameAllocator::GetThreadAllocator();
+    NS_TEST_BOOL(pAllocator != nullptr);
+    NS_TEST_BOOL(pAllocator == nsFrameAllocator::GetThreadAllocator());
+
+    const nsUInt64 uiUsedBefore = pAllocator->GetUsedBytes();
+
+    {
+      nsFrameAllocatorScope scope;
+      NS_TEST_BOOL(scope.GetAllocator() == pAllocator);
+
+      void* pData = pAllocator->Allocate(100, 16);
+      NS_TEST_BOOL(nsMemoryUtils::IsAligned(pData, 16));
+      NS_TEST_INT(pAllocator->GetUsedBytes() - uiUsedBefore, 112);
+
+      {
+        nsFrameAllocatorScope innerScope;
+        pAllocator->Allocate(1000, 16);
+        NS_TEST_INT(pAllocator->GetUsedBytes() - uiUsedBefore, 112 + 1008);
+      }
+
+      NS_TEST_INT(pAllocator->GetUsedBytes() - uiUsedBefore, 112);
+      NS_TEST_BOOL(pAllocator->GetHighWaterMark() >= uiUsedBefore + 112 + 1008);
+    }
+
+    NS_TEST_INT(pAllocator->GetUsedBytes(), uiUsedBefore);
+
+    // objects that are still alive are destroyed at the end of the scope, objects that were deleted on another thread are not
+    {
+      nsFrameAllocatorScope scope;
+
+      nsConstructionCounter* pCounter0 = NS_NEW(pAllocator, nsConstructionCounter);
+      NS_NEW(pAllocator, nsConstructionCounter);
+      NS_NEW(pAllocator, nsConstructionCounter);
+      NS_TEST_BOOL(nsConstructionCounter::HasConstructed(3));
+
+      nsFrameAllocatorThread thread(pAllocator, pCounter0);
+      thread.Start();
+      thread.Join();
+
+      NS_TEST_BOOL(nsConstructionCounter::HasDestructed(1));
+      NS_TEST_INT(thread.m_uiNumErrors, 0);
+      NS_TEST_BOOL(thread.m_pThreadAllocator != nullptr);
+      NS_TEST_BOOL(thread.m_pThreadAllocator != pAllocator);
+    }
+
+    NS_TEST_BOOL(nsConstructionCounter::HasDestructed(2));
+
+    // the stats of the last frame are collected on swap
+    {
+      pAllocator->Allocate(4096, 16);
+
+      nsFrameAllocator::Swap();
+      NS_TEST_BOOL(nsFrameAllocator::GetThreadAllocator() != pAllocator);
+
+      nsDynamicArray<nsFrameAllocator::ThreadStats> stats;
+      nsFrameAllocator::GetThreadStats(stats);
+      NS_TEST_BOOL(stats.GetCount() >= 2);
+
+      bool bFound = false;
+      for (const auto& threadStats : stats)
+      {
+        if (threadStats.m_ThreadID == nsThreadUtils::GetCurrentThreadID())
+        {
+          bFound = true;
+          NS_TEST_BOOL(threadStats.m_uiLastFrameBytes >= 4096);
+          NS_TEST_BOOL(threadStats.m_uiLastFrameHighWaterMark >= threadStats.m_uiLastFrameBytes);
+          NS_TEST_BOOL(threadStats.m_uiHighWaterMark >= threadStats.m_uiLastFrameHighWaterMark);
+          NS_TEST_BOOL(threadStats.m_uiReservedBytes >= 4096);
+        }
+      }
+
+      NS_TEST_BOOL(bFound);
+
+      nsFrameAllocator::Swap();
+      NS_TEST_BOOL(nsFrameAllocator::GetThreadAllocator() == pAllocator);
+      NS_TEST_INT(pAllocator->GetUsedBytes(), 0);
+    }
+  }
 }
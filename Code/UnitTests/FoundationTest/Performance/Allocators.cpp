@@ -0,0 +1,138 @@
+#include <FoundationTest/FoundationTestPCH.h>
+
+#include <Foundation/Logging/Log.h>
+#include <Foundation/Memory/CommonAllocators.h>
+#include <Foundation/Threading/Thread.h>
+#include <Foundation/Time/Time.h>
+#include <Foundation/Types/UniquePtr.h>
+
+namespace
+{
+  enum constants
+  {
+#if NS_ENABLED(NS_COMPILE_FOR_DEBUG)
+    NUM_ROUNDS = 20,
+#else
+    NUM_ROUNDS = 200,
+#endif
+    NUM_LIVE_ALLOCATIONS = 1000,
+    MAX_THREADS = 4,
+  };
+
+  // Allocates and frees like containers do when they grow and shrink: mostly small sizes, a few larger ones, with many allocations alive.
+  // With fixed sizes only the node sizes of typical maps, lists and sets are used.
+  class nsAllocatorChurnThread final : public nsThread
+  {
+  public:
+    nsAllocatorChurnThread(nsAllocator* pAllocator, nsUInt32 uiSeed, bool bFixedSizes)
+      : nsThread("Allocator Churn Thread")
+      , m_pAllocator(pAllocator)
+      , m_uiSeed(uiSeed)
+      , m_bFixedSizes(bFixedSizes)
+    {
+    }
+
+  private:
+    virtual nsUInt32 Run() override
+    {
+      void* allocations[NUM_LIVE_ALLOCATIONS] = {};
+      nsUInt32 x = m_uiSeed * 7919 + 1;
+
+      for (nsUInt32 uiRound = 0; uiRound < NUM_ROUNDS; ++uiRound)
+      {
+        for (nsUInt32 i = 0; i < NUM_LIVE_ALLOCATIONS; ++i)
+        {
+          x ^= x << 13;
+          x ^= x >> 17;
+          x ^= x << 5;
+
+          if (allocations[i] != nullptr)
+          {
+            m_pAllocator->Deallocate(allocations[i]);
+          }
+
+          size_t uiSize = 0;
+          if (m_bFixedSizes)
+            uiSize = 32 + (x % 4) * 32;
+          else
+            uiSize = (x % 16 == 0) ? 256 + x % 4096 : 8 + x % 192;
+
+          allocations[i] = m_pAllocator->Allocate(uiSize, 8);
+          static_cast<nsUInt8*>(allocations[i])[0] = 1;
+        }
+      }
+
+      for (void* pPtr : allocations)
+      {
+        m_pAllocator->Deallocate(pPtr);
+      }
+
+      return 0;
+    }
+
+    nsAllocator* m_pAllocator;
+    nsUInt32 m_uiSeed;
+    bool m_bFixedSizes;
+  };
+
+  void MeasureAllocator(nsStringView sName, nsAllocator* pAllocator, bool bFixedSizes = false)
+  {
+    for (nsUInt32 uiNumThreads = 1; uiNumThreads <= MAX_THREADS; uiNumThreads *= 2)
+    {
+      nsHybridArray<nsUniquePtr<nsAllocatorChurnThread>, MAX_THREADS> threads;
+
+      for (nsUInt32 i = 0; i < uiNumThreads; ++i)
+      {
+        threads.PushBack(NS_DEFAULT_NEW(nsAllocatorChurnThread, pAllocator, i, bFixedSizes));
+      }
+
+      const nsTime tStart = nsTime::Now();
+
+      for (auto& pThread : threads)
+      {
+        pThread->Start();
+      }
+
+      for (auto& pThread : threads)
+      {
+        pThread->Join();
+      }
+
+      const nsTime tDuration = nsTime::Now() - tStart;
+      const double fNumOperations = static_cast<double>(NUM_ROUNDS) * static_cast<double>(NUM_LIVE_ALLOCATIONS);
+
+      nsLog::Info("[test]{0}, {1} thread(s): {2}ns per allocation and deallocation", sName, uiNumThreads, nsArgF(tDuration.GetNanoseconds() / fNumOperations, 2));
+    }
+  }
+} // namespace
+
+NS_CREATE_SIMPLE_TEST(Performance, Allocators)
+{
+  NS_TEST_BLOCK(nsTestBlock::Enabled, "Heap vs. Size Class Heap")
+  {
+    // without per allocation tracking, so that only the allocation policies are compared
+    nsAllocatorWithPolicy<nsAllocPolicyHeap, nsAllocatorTrackingMode::Basics> heapAllocator("Benchmark Heap");
+    nsAllocatorWithPolicy<nsAllocPolicySizeClassHeap, nsAllocatorTrackingMode::Basics> sizeClassAllocator("Benchmark Size Class Heap");
+
+    MeasureAllocator("nsAllocPolicyHeap", &heapAllocator);
+    MeasureAllocator("nsAllocPolicySizeClassHeap", &sizeClassAllocator);
+  }
+
+  NS_TEST_BLOCK(nsTestBlock::Enabled, "Heap vs. Pool")
+  {
+    nsAllocatorWithPolicy<nsAllocPolicyHeap, nsAllocatorTrackingMode::Basics> heapAllocator("Benchmark Heap");
+    nsAllocatorWithPolicy<nsAllocPolicyPool, nsAllocatorTrackingMode::Basics> poolAllocator("Benchmark Pool");
+
+    MeasureAllocator("nsAllocPolicyHeap (fixed sizes)", &heapAllocator, true);
+    MeasureAllocator("nsAllocPolicyPool (fixed sizes)", &poolAllocator, true);
+  }
+
+  NS_TEST_BLOCK(nsTestBlock::Enabled, "Allocation Tracking")
+  {
+    nsAllocatorWithPolicy<nsAllocPolicyHeap, nsAllocatorTrackingMode::Basics> untrackedAllocator("Benchmark Untracked");
+    nsAllocatorWithPolicy<nsAllocPolicyHeap, nsAllocatorTrackingMode::AllocationStats> trackedAllocator("Benchmark Tracked");
+
+    MeasureAllocator("Basics", &untrackedAllocator);
+    MeasureAllocator("AllocationStats", &trackedAllocator);
+  }
+}
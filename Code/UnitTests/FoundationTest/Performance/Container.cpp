@@ -1,6 +1,10 @@
 #include <FoundationTest/FoundationTestPCH.h>
 
+#include <Foundation/Containers/BTreeMap.h>
 #include <Foundation/Containers/DynamicArray.h>
+#include <Foundation/Containers/HashTable.h>
+#include <Foundation/Containers/Map.h>
+#include <Foundation/Containers/SwissHashTable.h>
 #include <Foundation/Logging/Log.h>
 #include <Foundation/Reflection/Reflection.h>
 #include <Foundation/Strings/String.h>
@@ -75,6 +79,100 @@ namespace
 
   nsUInt32 SomeBigObject::constructionCount = 0;
   nsUInt32 SomeBigObject::destructionCount = 0;
+
+  /// The first half of the keys is inserted, the second half is used for failing lookups and for replacing the first half.
+  template <typename MapType, typename KeyType>
+  void HashMapInsertFindErase(nsStringView sName, const nsDynamicArray<KeyType>& keys)
+  {
+    const nsUInt32 uiNumKeys = keys.GetCount() / 2;
+    nsUInt64 sum = 0;
+
+    MapType map;
+
+    nsTime t0 = nsTime::Now();
+    for (nsUInt32 i = 0; i < uiNumKeys; ++i)
+    {
+      map.Insert(keys[i], i);
+    }
+
+    nsTime t1 = nsTime::Now();
+    for (nsUInt32 i = 0; i < uiNumKeys; ++i)
+    {
+      if (const nsUInt32* pValue = map.GetValue(keys[i]))
+        sum += *pValue;
+
+      if (map.Contains(keys[uiNumKeys + i]))
+        ++sum;
+    }
+
+    nsTime t2 = nsTime::Now();
+    for (nsUInt32 i = 0; i < uiNumKeys; ++i)
+    {
+      map.Remove(keys[i]);
+      map.Insert(keys[uiNumKeys + i], i);
+    }
+
+    // all removed keys are misses now, which have to skip over the deleted entries
+    nsTime t3 = nsTime::Now();
+    for (nsUInt32 i = 0; i < uiNumKeys; ++i)
+    {
+      if (map.Contains(keys[i]))
+        ++sum;
+
+      if (const nsUInt32* pValue = map.GetValue(keys[uiNumKeys + i]))
+        sum += *pValue;
+    }
+
+    nsTime t4 = nsTime::Now();
+
+    const double fNumKeys = static_cast<double>(uiNumKeys);
+    nsLog::Info("[test]{0} {1} entries: insert {2}ns, find {3}ns, remove+insert {4}ns, find after remove {5}ns", sName, uiNumKeys,
+      nsArgF((t1 - t0).GetNanoseconds() / fNumKeys, 1), nsArgF((t2 - t1).GetNanoseconds() / (fNumKeys * 2), 1),
+      nsArgF((t3 - t2).GetNanoseconds() / fNumKeys, 1), nsArgF((t4 - t3).GetNanoseconds() / (fNumKeys * 2), 1), sum);
+  }
+
+  /// Inserts all keys in the given order, then looks up every key, iterates over the map in order and removes every other key.
+  template <typename MapType>
+  void OrderedMapInsertFindIterate(nsStringView sName, const nsDynamicArray<nsUInt32>& keys)
+  {
+    const nsUInt32 uiNumKeys = keys.GetCount();
+    nsUInt64 sum = 0;
+
+    MapType map;
+
+    nsTime t0 = nsTime::Now();
+    for (nsUInt32 i = 0; i < uiNumKeys; ++i)
+    {
+      map.Insert(keys[i], i);
+    }
+
+    nsTime t1 = nsTime::Now();
+    for (nsUInt32 i = 0; i < uiNumKeys; ++i)
+    {
+      if (const nsUInt32* pValue = map.GetValue(keys[i]))
+        sum += *pValue;
+    }
+
+    nsTime t2 = nsTime::Now();
+    for (auto it = map.GetIterator(); it.IsValid(); ++it)
+    {
+      sum += it.Value();
+    }
+
+    nsTime t3 = nsTime::Now();
+    for (nsUInt32 i = 0; i < uiNumKeys; i += 2)
+    {
+      map.Remove(keys[i]);
+    }
+
+    nsTime t4 = nsTime::Now();
+
+    const double fNumKeys = static_cast<double>(uiNumKeys);
+    nsLog::Info("[test]{0} {1} entries: insert {2}ns, find {3}ns, iterate {4}ns, remove {5}ns, memory {6} bytes per entry", sName, uiNumKeys,
+      nsArgF((t1 - t0).GetNanoseconds() / fNumKeys, 1), nsArgF((t2 - t1).GetNanoseconds() / fNumKeys, 1),
+      nsArgF((t3 - t2).GetNanoseconds() / fNumKeys, 2), nsArgF((t4 - t3).GetNanoseconds() / (fNumKeys / 2), 1),
+      nsArgF(static_cast<double>(map.GetHeapMemoryUsage()) / map.GetCount(), 1), sum);
+  }
 } // namespace
 
 // Enable when needed
@@ -419,4 +517,89 @@ NS_CREATE_SIMPLE_TEST(Performance, Container)
         nsArgF((t1 - t0).GetMilliseconds() / static_cast<double>(NUM_SAMPLES), 4), sum);
     }
   }
+
+  NS_TEST_BLOCK(nsTestBlock::DisabledNoWarning, "nsHashTable vs. nsSwissHashTable (pointer keys)")
+  {
+    for (nsUInt32 uiNumKeys = 1000; uiNumKeys <= 10000000; uiNumKeys *= 10)
+    {
+      // the addresses of objects with a size of 48 bytes, in a shuffled order
+      nsDynamicArray<void*> keys;
+      keys.SetCountUninitialized(uiNumKeys * 2);
+
+      for (nsUInt32 i = 0; i < keys.GetCount(); ++i)
+      {
+        keys[i] = reinterpret_cast<void*>(0x10000000ull + i * 48ull);
+      }
+
+      for (nsUInt32 i = keys.GetCount() - 1; i > 0; --i)
+      {
+        nsMath::Swap(keys[i], keys[nsHashingUtils::xxHash32(&i, sizeof(i)) % (i + 1)]);
+      }
+
+      HashMapInsertFindErase<nsHashTable<void*, nsUInt32>>("nsHashTable<void*, nsUInt32>", keys);
+      HashMapInsertFindErase<nsSwissHashTable<void*, nsUInt32>>("nsSwissHashTable<void*, nsUInt32>", keys);
+    }
+  }
+
+  NS_TEST_BLOCK(nsTestBlock::DisabledNoWarning, "nsHashTable vs. nsSwissHashTable (string keys)")
+  {
+    // 10 million strings would need several GB of memory, so this stops at 1 million
+    for (nsUInt32 uiNumKeys = 1000; uiNumKeys <= 1000000; uiNumKeys *= 10)
+    {
+      nsDynamicArray<nsString> keys;
+      keys.SetCount(uiNumKeys * 2);
+
+      nsStringBuilder tmp;
+      for (nsUInt32 i = 0; i < keys.GetCount(); ++i)
+      {
+        tmp.SetFormat("Objects/Level{}/Entity_{}", i % 17, i);
+        keys[i] = tmp;
+      }
+
+      HashMapInsertFindErase<nsHashTable<nsString, nsUInt32>>("nsHashTable<nsString, nsUInt32>", keys);
+      HashMapInsertFindErase<nsSwissHashTable<nsString, nsUInt32>>("nsSwissHashTable<nsString, nsUInt32>", keys);
+    }
+  }
+
+  NS_TEST_BLOCK(nsTestBlock::DisabledNoWarning, "nsMap vs. nsBTreeMap")
+  {
+    for (nsUInt32 uiNumKeys = 1000; uiNumKeys <= 1000000; uiNumKeys *= 10)
+    {
+      // unique keys in a shuffled order
+      nsDynamicArray<nsUInt32> keys;
+      keys.SetCountUninitialized(uiNumKeys);
+
+      for (nsUInt32 i = 0; i < uiNumKeys; ++i)
+      {
+        keys[i] = i * 7;
+      }
+
+      for (nsUInt32 i = uiNumKeys - 1; i > 0; --i)
+      {
+        nsMath::Swap(keys[i], keys[nsHashingUtils::xxHash32(&i, sizeof(i)) % (i + 1)]);
+      }
+
+      OrderedMapInsertFindIterate<nsMap<nsUInt32, nsUInt32>>("nsMap<nsUInt32, nsUInt32>", keys);
+      OrderedMapInsertFindIterate<nsBTreeMap<nsUInt32, nsUInt32>>("nsBTreeMap<nsUInt32, nsUInt32>", keys);
+
+      nsDynamicArray<nsUInt32> sortedKeys;
+      nsDynamicArray<nsUInt32> values;
+      sortedKeys.SetCountUninitialized(uiNumKeys);
+      values.SetCountUninitialized(uiNumKeys);
+
+      for (nsUInt32 i = 0; i < uiNumKeys; ++i)
+      {
+        sortedKeys[i] = i * 7;
+        values[i] = i;
+      }
+
+      nsTime t0 = nsTime::Now();
+      nsBTreeMap<nsUInt32, nsUInt32> map;
+      map.BulkLoad(sortedKeys, values);
+      nsTime t1 = nsTime::Now();
+
+      nsLog::Info("[test]nsBTreeMap<nsUInt32, nsUInt32> {0} entries: bulk load {1}ns", uiNumKeys,
+        nsArgF((t1 - t0).GetNanoseconds() / static_cast<double>(uiNumKeys), 1));
+    }
+  }
 }
@@ -0,0 +1,78 @@
+#include <FoundationTest/FoundationTestPCH.h>
+
+#include <Foundation/Logging/Log.h>
+#include <Foundation/Strings/StringBuilder.h>
+#include <Foundation/Time/Time.h>
+
+namespace
+{
+  enum constants
+  {
+#if NS_ENABLED(NS_COMPILE_FOR_DEBUG)
+    NUM_FORMATS = 20000,
+#else
+    NUM_FORMATS = 500000,
+#endif
+  };
+
+  void ReportFormat(const char* szName, nsTime tDuration, nsUInt32 uiChecksum)
+  {
+    nsLog::Info("[test]{0}: {1} ns per call (checksum {2})", szName, nsArgF(tDuration.GetNanoseconds() / static_cast<double>(NUM_FORMATS), 1), nsArgU(uiChecksum & 0xFF));
+  }
+} // namespace
+
+NS_CREATE_SIMPLE_TEST(Performance, FormatString)
+{
+  nsStringBuilder sb;
+
+  NS_TEST_BLOCK(nsTestBlock::Enabled, "SetFormat")
+  {
+    nsUInt32 uiChecksum = 0;
+    nsTime tStart = nsTime::Now();
+
+    for (nsUInt32 i = 0; i < NUM_FORMATS; ++i)
+    {
+      sb.SetFormat("Loaded resource '{}' ({} of {}) in {} ms", "Textures/Rock.dds", i, (nsUInt32)NUM_FORMATS, 17);
+      uiChecksum += sb.GetElementCount();
+    }
+
+    ReportFormat("SetFormat(const char*)", nsTime::Now() - tStart, uiChecksum);
+
+    const nsUInt32 uiExpected = uiChecksum;
+    uiChecksum = 0;
+    tStart = nsTime::Now();
+
+    for (nsUInt32 i = 0; i < NUM_FORMATS; ++i)
+    {
+      sb.SetFormat(NS_FMT("Loaded resource '{}' ({} of {}) in {} ms"), "Textures/Rock.dds", i, (nsUInt32)NUM_FORMATS, 17);
+      uiChecksum += sb.GetElementCount();
+    }
+
+    ReportFormat("SetFormat(NS_FMT)", nsTime::Now() - tStart, uiChecksum);
+    NS_TEST_INT(uiChecksum, uiExpected);
+  }
+
+  NS_TEST_BLOCK(nsTestBlock::Enabled, "Filtered Log Messages")
+  {
+    nsMuteLog muteLog;
+    nsLogSystemScope logScope(&muteLog);
+
+    nsTime tStart = nsTime::Now();
+
+    for (nsUInt32 i = 0; i < NUM_FORMATS; ++i)
+    {
+      nsLog::Info("Loaded resource '{}' ({} of {}) in {} ms", "Textures/Rock.dds", i, (nsUInt32)NUM_FORMATS, nsArgF(17.0, 2));
+    }
+
+    ReportFormat("nsLog::Info (filtered)", nsTime::Now() - tStart, 0);
+
+    tStart = nsTime::Now();
+
+    for (nsUInt32 i = 0; i < NUM_FORMATS; ++i)
+    {
+      nsLog::Info(NS_FMT("Loaded resource '{}' ({} of {}) in {} ms"), "Textures/Rock.dds", i, (nsUInt32)NUM_FORMATS, nsArgF(17.0, 2));
+    }
+
+    ReportFormat("nsLog::Info(NS_FMT) (filtered)", nsTime::Now() - tStart, 0);
+  }
+}
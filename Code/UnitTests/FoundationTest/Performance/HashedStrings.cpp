@@ -0,0 +1,136 @@
+#include <FoundationTest/FoundationTestPCH.h>
+
+#include <Foundation/Logging/Log.h>
+#include <Foundation/Strings/HashedString.h>
+#include <Foundation/Threading/Thread.h>
+#include <Foundation/Time/Time.h>
+#include <Foundation/Types/UniquePtr.h>
+
+namespace
+{
+  enum constants
+  {
+#if NS_ENABLED(NS_COMPILE_FOR_DEBUG)
+    NUM_NEW_STRINGS_PER_THREAD = 10000,
+    NUM_LOOKUPS_PER_THREAD = 100000,
+#else
+    NUM_NEW_STRINGS_PER_THREAD = 50000,
+    NUM_LOOKUPS_PER_THREAD = 1000000,
+#endif
+    NUM_SHARED_STRINGS = 1024,
+    MAX_THREADS = 8,
+  };
+
+  class nsInternThread final : public nsThread
+  {
+  public:
+    nsInternThread(const nsDynamicArray<nsString>& names, nsUInt32 uiNumAssignments, nsUInt32 uiThreadIndex)
+      : nsThread("Intern Thread")
+      , m_Names(names)
+      , m_uiNumAssignments(uiNumAssignments)
+      , m_uiThreadIndex(uiThreadIndex)
+    {
+    }
+
+  private:
+    virtual nsUInt32 Run() override
+    {
+      nsHashedString sHashed;
+
+      for (nsUInt32 i = 0; i < m_uiNumAssignments; ++i)
+      {
+        sHashed.Assign(m_Names[(i + m_uiThreadIndex * 7) % m_Names.GetCount()]);
+      }
+
+      return 0;
+    }
+
+    const nsDynamicArray<nsString>& m_Names;
+    nsUInt32 m_uiNumAssignments;
+    nsUInt32 m_uiThreadIndex;
+  };
+
+  // Every thread does the same amount of work, so with enough cores the time per string should stay about the same with more threads.
+  nsTime RunThreads(const nsDynamicArray<nsDynamicArray<nsString>>& names, nsUInt32 uiNumAssignments)
+  {
+    nsHybridArray<nsUniquePtr<nsInternThread>, MAX_THREADS> threads;
+
+    for (nsUInt32 i = 0; i < names.GetCount(); ++i)
+    {
+      threads.PushBack(NS_DEFAULT_NEW(nsInternThread, names[i], uiNumAssignments, i));
+    }
+
+    const nsTime tStart = nsTime::Now();
+
+    for (auto& pThread : threads)
+    {
+      pThread->Start();
+    }
+
+    for (auto& pThread : threads)
+    {
+      pThread->Join();
+    }
+
+    return nsTime::Now() - tStart;
+  }
+} // namespace
+
+NS_CREATE_SIMPLE_TEST(Performance, HashedStrings)
+{
+  NS_TEST_BLOCK(nsTestBlock::Enabled, "Interning new strings")
+  {
+    nsUInt32 uiRun = 0;
+    nsStringBuilder sName;
+
+    for (nsUInt32 uiNumThreads = 1; uiNumThreads <= MAX_THREADS; uiNumThreads *= 2)
+    {
+      // each thread inserts its own strings, none of them exist yet
+      nsDynamicArray<nsDynamicArray<nsString>> names;
+      names.SetCount(uiNumThreads);
+
+      for (nsUInt32 t = 0; t < uiNumThreads; ++t)
+      {
+        names[t].Reserve(NUM_NEW_STRINGS_PER_THREAD);
+
+        for (nsUInt32 i = 0; i < NUM_NEW_STRINGS_PER_THREAD; ++i)
+        {
+          sName.SetFormat("Benchmark/Intern/{0}/{1}/{2}", uiRun, t, i);
+          names[t].PushBack(sName);
+        }
+      }
+
+      ++uiRun;
+
+      const nsTime tDuration = RunThreads(names, NUM_NEW_STRINGS_PER_THREAD);
+
+      nsLog::Info("[test]New strings, {0} thread(s): {1}ns per string", uiNumThreads, nsArgF(tDuration.GetNanoseconds() / static_cast<double>(NUM_NEW_STRINGS_PER_THREAD), 2));
+    }
+  }
+
+  NS_TEST_BLOCK(nsTestBlock::Enabled, "Interning existing strings")
+  {
+    nsDynamicArray<nsString> sharedNames;
+    nsStringBuilder sName;
+
+    for (nsUInt32 i = 0; i < NUM_SHARED_STRINGS; ++i)
+    {
+      sName.SetFormat("Benchmark/Shared/{0}", i);
+      sharedNames.PushBack(sName);
+
+      nsHashedString sHashed;
+      sHashed.Assign(sName);
+    }
+
+    for (nsUInt32 uiNumThreads = 1; uiNumThreads <= MAX_THREADS; uiNumThreads *= 2)
+    {
+      // all threads look up the same strings
+      nsDynamicArray<nsDynamicArray<nsString>> names;
+      names.SetCount(uiNumThreads, sharedNames);
+
+      const nsTime tDuration = RunThreads(names, NUM_LOOKUPS_PER_THREAD);
+
+      nsLog::Info("[test]Existing strings, {0} thread(s): {1}ns per string", uiNumThreads, nsArgF(tDuration.GetNanoseconds() / static_cast<double>(NUM_LOOKUPS_PER_THREAD), 2));
+    }
+  }
+}
@@ -0,0 +1,107 @@
+#include <FoundationTest/FoundationTestPCH.h>
+
+#include <Foundation/Algorithm/HashingUtils.h>
+#include <Foundation/Containers/DynamicArray.h>
+#include <Foundation/Logging/Log.h>
+#include <Foundation/Time/Time.h>
+
+namespace
+{
+  enum constants
+  {
+#if NS_ENABLED(NS_COMPILE_FOR_DEBUG)
+    NUM_SHORT_KEY_BYTES = 1024 * 1024 * 4,
+    NUM_LARGE_BUFFER_ROUNDS = 4,
+#else
+    NUM_SHORT_KEY_BYTES = 1024 * 1024 * 64,
+    NUM_LARGE_BUFFER_ROUNDS = 64,
+#endif
+    LARGE_BUFFER_SIZE = 1024 * 1024,
+  };
+
+  using HashFunc = nsUInt64 (*)(const void* pData, size_t uiSize);
+
+  struct HashFunction
+  {
+    const char* m_szName;
+    HashFunc m_Func;
+  };
+
+  // clang-format off
+  const HashFunction s_HashFunctions[] = {
+    {"CRC32", [](const void* pData, size_t uiSize) -> nsUInt64 { return nsHashingUtils::CRC32Hash(pData, uiSize); }},
+    {"CRC32C", [](const void* pData, size_t uiSize) -> nsUInt64 { return nsHashingUtils::CRC32cHash(pData, uiSize); }},
+    {"MurmurHash64", [](const void* pData, size_t uiSize) -> nsUInt64 { return nsHashingUtils::MurmurHash64(pData, uiSize); }},
+    {"xxHash64", [](const void* pData, size_t uiSize) -> nsUInt64 { return nsHashingUtils::xxHash64(pData, uiSize); }},
+    {"XXH3-64", [](const void* pData, size_t uiSize) -> nsUInt64 { return nsHashingUtils::xxHash3_64(pData, uiSize); }},
+    {"XXH3-128", [](const void* pData, size_t uiSize) -> nsUInt64 { return nsHashingUtils::xxHash3_128(pData, uiSize).m_uiLow; }},
+  };
+  // clang-format on
+
+  void FillBuffer(nsDynamicArray<nsUInt8>& ref_buffer, nsUInt32 uiSize)
+  {
+    ref_buffer.SetCountUninitialized(uiSize);
+
+    nsUInt32 x = 0x12345678;
+    for (nsUInt8& value : ref_buffer)
+    {
+      x ^= x << 13;
+      x ^= x >> 17;
+      x ^= x << 5;
+      value = static_cast<nsUInt8>(x);
+    }
+  }
+} // namespace
+
+NS_CREATE_SIMPLE_TEST(Performance, Hashing)
+{
+  nsDynamicArray<nsUInt8> buffer;
+  FillBuffer(buffer, LARGE_BUFFER_SIZE);
+
+  NS_TEST_BLOCK(nsTestBlock::Enabled, "Short Keys")
+  {
+    const nsUInt32 keySizes[] = {8, 16, 32, 64};
+
+    for (const HashFunction& hash : s_HashFunctions)
+    {
+      for (nsUInt32 uiKeySize : keySizes)
+      {
+        const nsUInt32 uiNumKeys = NUM_SHORT_KEY_BYTES / uiKeySize;
+        const nsUInt32 uiOffsetMask = LARGE_BUFFER_SIZE / 2 - 1;
+
+        nsUInt64 uiSum = 0;
+        const nsTime tStart = nsTime::Now();
+
+        for (nsUInt32 i = 0; i < uiNumKeys; ++i)
+        {
+          // hash different keys, so that the results can't be reused, but stay within the cache
+          uiSum += hash.m_Func(buffer.GetData() + ((i * 16) & uiOffsetMask), uiKeySize);
+        }
+
+        const nsTime tDuration = nsTime::Now() - tStart;
+
+        nsLog::Info("[test]{0}, {1} byte keys: {2}ns per key, {3} MB/s (checksum {4})", hash.m_szName, uiKeySize,
+          nsArgF(tDuration.GetNanoseconds() / uiNumKeys, 2), nsArgF(static_cast<double>(NUM_SHORT_KEY_BYTES) / tDuration.GetSeconds() / (1024.0 * 1024.0), 0), nsArgU(uiSum & 0xFF));
+      }
+    }
+  }
+
+  NS_TEST_BLOCK(nsTestBlock::Enabled, "Large Buffers")
+  {
+    for (const HashFunction& hash : s_HashFunctions)
+    {
+      nsUInt64 uiSum = 0;
+      const nsTime tStart = nsTime::Now();
+
+      for (nsUInt32 i = 0; i < NUM_LARGE_BUFFER_ROUNDS; ++i)
+      {
+        uiSum += hash.m_Func(buffer.GetData(), buffer.GetCount());
+      }
+
+      const nsTime tDuration = nsTime::Now() - tStart;
+      const double fMegaBytes = static_cast<double>(NUM_LARGE_BUFFER_ROUNDS) * static_cast<double>(LARGE_BUFFER_SIZE) / (1024.0 * 1024.0);
+
+      nsLog::Info("[test]{0}, 1 MB buffer: {1} MB/s (checksum {2})", hash.m_szName, nsArgF(fMegaBytes / tDuration.GetSeconds(), 0), nsArgU(uiSum & 0xFF));
+    }
+  }
+}
@@ -0,0 +1,259 @@
+#include <FoundationTest/FoundationTestPCH.h>
+
+#include <Foundation/Logging/Log.h>
+#include <Foundation/Threading/Mutex.h>
+#include <Foundation/Threading/Semaphore.h>
+#include <Foundation/Threading/Thread.h>
+#include <Foundation/Threading/ThreadSignal.h>
+#include <Foundation/Time/Time.h>
+#include <Foundation/Types/UniquePtr.h>
+
+#if NS_ENABLED(NS_PLATFORM_LINUX)
+#  include <pthread.h>
+#  include <semaphore.h>
+#endif
+
+namespace
+{
+  enum constants
+  {
+#if NS_ENABLED(NS_COMPILE_FOR_DEBUG)
+    NUM_LOCKS_PER_THREAD = 20000,
+    NUM_ROUND_TRIPS = 2000,
+#else
+    NUM_LOCKS_PER_THREAD = 200000,
+    NUM_ROUND_TRIPS = 20000,
+#endif
+    NUM_THREADS = 4,
+  };
+
+  using BenchmarkFunction = nsDelegate<void(), 48>;
+
+  class nsBenchmarkThread final : public nsThread
+  {
+  public:
+    nsBenchmarkThread(const BenchmarkFunction& func)
+      : nsThread("Benchmark Thread")
+      , m_Func(func)
+    {
+    }
+
+  private:
+    virtual nsUInt32 Run() override
+    {
+      m_Func();
+      return 0;
+    }
+
+    BenchmarkFunction m_Func;
+  };
+
+  nsTime RunOnThreads(nsUInt32 uiNumThreads, const BenchmarkFunction& func)
+  {
+    nsHybridArray<nsUniquePtr<nsBenchmarkThread>, NUM_THREADS> threads;
+
+    for (nsUInt32 i = 0; i < uiNumThreads; ++i)
+    {
+      threads.PushBack(NS_DEFAULT_NEW(nsBenchmarkThread, func));
+    }
+
+    const nsTime tStart = nsTime::Now();
+
+    for (auto& pThread : threads)
+    {
+      pThread->Start();
+    }
+
+    for (auto& pThread : threads)
+    {
+      pThread->Join();
+    }
+
+    return nsTime::Now() - tStart;
+  }
+
+  // Like most locks in the engine (task queues, message queues, the hashed string table), the lock only protects a few instructions.
+  template <typename LockType>
+  nsTime MeasureContendedLock(LockType& ref_lock)
+  {
+    nsUInt32 uiCounter = 0;
+
+    const nsTime tDuration = RunOnThreads(NUM_THREADS, [&]()
+      {
+        for (nsUInt32 i = 0; i < NUM_LOCKS_PER_THREAD; ++i)
+        {
+          ref_lock.Lock();
+          ++uiCounter;
+          ref_lock.Unlock();
+        }
+      });
+
+    NS_TEST_INT(uiCounter, NUM_THREADS * NUM_LOCKS_PER_THREAD);
+    return tDuration;
+  }
+
+  // Two threads hand a token back and forth, which is how work gets passed to (idle) worker threads.
+  template <typename SignalType>
+  nsTime MeasureRoundTrips(SignalType& ref_ping, SignalType& ref_pong)
+  {
+    nsBenchmarkThread responder([&]()
+      {
+        for (nsUInt32 i = 0; i < NUM_ROUND_TRIPS; ++i)
+        {
+          ref_ping.WaitForSignal();
+          ref_pong.RaiseSignal();
+        }
+      });
+
+    responder.Start();
+
+    const nsTime tStart = nsTime::Now();
+
+    for (nsUInt32 i = 0; i < NUM_ROUND_TRIPS; ++i)
+    {
+      ref_ping.RaiseSignal();
+      ref_pong.WaitForSignal();
+    }
+
+    const nsTime tDuration = nsTime::Now() - tStart;
+    responder.Join();
+    return tDuration;
+  }
+
+  // A bounded producer / consumer queue, where the semaphores count the free and the filled slots.
+  template <typename SemaphoreType>
+  nsTime MeasureProducerConsumer(SemaphoreType& ref_freeSlots, SemaphoreType& ref_filledSlots)
+  {
+    nsBenchmarkThread consumer([&]()
+      {
+        for (nsUInt32 i = 0; i < NUM_ROUND_TRIPS; ++i)
+        {
+          ref_filledSlots.AcquireToken();
+          ref_freeSlots.ReturnToken();
+        }
+      });
+
+    const nsTime tStart = nsTime::Now();
+    consumer.Start();
+
+    for (nsUInt32 i = 0; i < NUM_ROUND_TRIPS; ++i)
+    {
+      ref_freeSlots.AcquireToken();
+      ref_filledSlots.ReturnToken();
+    }
+
+    consumer.Join();
+    return nsTime::Now() - tStart;
+  }
+
+#if NS_ENABLED(NS_PLATFORM_LINUX)
+  // The primitives that the Linux implementations used to wrap directly, for comparison.
+
+  class nsPthreadMutex
+  {
+  public:
+    nsPthreadMutex()
+    {
+      pthread_mutexattr_t mutexAttributes;
+      pthread_mutexattr_init(&mutexAttributes);
+      pthread_mutexattr_settype(&mutexAttributes, PTHREAD_MUTEX_RECURSIVE);
+      pthread_mutex_init(&m_Mutex, &mutexAttributes);
+      pthread_mutexattr_destroy(&mutexAttributes);
+    }
+
+    ~nsPthreadMutex() { pthread_mutex_destroy(&m_Mutex); }
+
+    void Lock() { pthread_mutex_lock(&m_Mutex); }
+    void Unlock() { pthread_mutex_unlock(&m_Mutex); }
+
+    pthread_mutex_t m_Mutex;
+  };
+
+  class nsPthreadSignal
+  {
+  public:
+    nsPthreadSignal() { pthread_cond_init(&m_Condition, nullptr); }
+    ~nsPthreadSignal() { pthread_cond_destroy(&m_Condition); }
+
+    void WaitForSignal()
+    {
+      m_Mutex.Lock();
+      while (!m_bSignaled)
+      {
+        pthread_cond_wait(&m_Condition, &m_Mutex.m_Mutex);
+      }
+      m_bSignaled = false;
+      m_Mutex.Unlock();
+    }
+
+    void RaiseSignal()
+    {
+      m_Mutex.Lock();
+      m_bSignaled = true;
+      m_Mutex.Unlock();
+      pthread_cond_signal(&m_Condition);
+    }
+
+  private:
+    nsPthreadMutex m_Mutex;
+    pthread_cond_t m_Condition;
+    bool m_bSignaled = false;
+  };
+
+  class nsPosixSemaphore
+  {
+  public:
+    nsPosixSemaphore(nsUInt32 uiInitialTokens) { sem_init(&m_Semaphore, 0, uiInitialTokens); }
+    ~nsPosixSemaphore() { sem_destroy(&m_Semaphore); }
+
+    void AcquireToken() { sem_wait(&m_Semaphore); }
+    void ReturnToken() { sem_post(&m_Semaphore); }
+
+  private:
+    sem_t m_Semaphore;
+  };
+#endif
+
+  void LogResult(const char* szWhat, const char* szImplementation, nsTime duration, nsUInt32 uiNumOperations)
+  {
+    nsLog::Info("[test]{0} ({1}): {2}ns per operation", szWhat, szImplementation, nsArgF(duration.GetNanoseconds() / uiNumOperations, 1));
+  }
+} // namespace
+
+NS_CREATE_SIMPLE_TEST(Performance, Locks)
+{
+  NS_TEST_BLOCK(nsTestBlock::Enabled, "Contended Mutex")
+  {
+    nsMutex mutex;
+    LogResult("Contended lock", "nsMutex", MeasureContendedLock(mutex), NUM_THREADS * NUM_LOCKS_PER_THREAD);
+
+#if NS_ENABLED(NS_PLATFORM_LINUX)
+    nsPthreadMutex pthreadMutex;
+    LogResult("Contended lock", "pthread", MeasureContendedLock(pthreadMutex), NUM_THREADS * NUM_LOCKS_PER_THREAD);
+#endif
+  }
+
+  NS_TEST_BLOCK(nsTestBlock::Enabled, "Thread Signal Round Trips")
+  {
+    nsThreadSignal ping, pong;
+    LogResult("Signal round trip", "nsThreadSignal", MeasureRoundTrips(ping, pong), NUM_ROUND_TRIPS);
+
+#if NS_ENABLED(NS_PLATFORM_LINUX)
+    nsPthreadSignal pthreadPing, pthreadPong;
+    LogResult("Signal round trip", "pthread", MeasureRoundTrips(pthreadPing, pthreadPong), NUM_ROUND_TRIPS);
+#endif
+  }
+
+  NS_TEST_BLOCK(nsTestBlock::Enabled, "Semaphore Producer Consumer")
+  {
+    nsSemaphore freeSlots, filledSlots;
+    NS_TEST_BOOL(freeSlots.Create(8).Succeeded());
+    NS_TEST_BOOL(filledSlots.Create(0).Succeeded());
+    LogResult("Semaphore hand-off", "nsSemaphore", MeasureProducerConsumer(freeSlots, filledSlots), NUM_ROUND_TRIPS);
+
+#if NS_ENABLED(NS_PLATFORM_LINUX)
+    nsPosixSemaphore posixFreeSlots(8), posixFilledSlots(0);
+    LogResult("Semaphore hand-off", "sem_t", MeasureProducerConsumer(posixFreeSlots, posixFilledSlots), NUM_ROUND_TRIPS);
+#endif
+  }
+}
@@ -0,0 +1,145 @@
+#include <FoundationTest/FoundationTestPCH.h>
+
+#include <Foundation/Logging/Log.h>
+#include <Foundation/Threading/Lock.h>
+#include <Foundation/Threading/Mutex.h>
+#include <Foundation/Threading/TaskSystem.h>
+#include <Foundation/Time/Time.h>
+
+namespace
+{
+  enum constants
+  {
+#if NS_ENABLED(NS_COMPILE_FOR_DEBUG)
+    NUM_SAMPLES = 8,
+    NUM_ITEMS = 1024 * 4,
+#else
+    NUM_SAMPLES = 32,
+    NUM_ITEMS = 1024 * 16,
+#endif
+    NUM_WORKERS = 4,
+  };
+
+  // The first eighth of the items costs 32 times as much as the rest, similar to image rows where only a small part has content.
+  // With the static split, the task that gets this part determines the duration of the whole loop.
+  nsUInt32 GetItemCost(nsUInt32 uiItem)
+  {
+    return (uiItem < NUM_ITEMS / 8) ? 32 * 64 : 64;
+  }
+
+  nsUInt32 SimulateWork(nsUInt32 uiItem)
+  {
+    nsUInt32 uiValue = uiItem;
+    for (nsUInt32 i = 0; i < GetItemCost(uiItem); ++i)
+    {
+      uiValue = uiValue * 1664525u + 1013904223u;
+    }
+
+    return uiValue;
+  }
+
+  struct ImbalanceResult
+  {
+    nsTime m_Duration;
+    nsTime m_Tail;
+  };
+
+  // Returns the duration of the whole loop and its 'tail', i.e. the time between the first thread running out of items and the
+  // last item being finished. During the tail, some cores are idle.
+  ImbalanceResult RunImbalancedLoop(nsParallelForSplitting splitting)
+  {
+    nsParallelForParams params;
+    params.m_uiBinSize = 16;
+    params.m_uiMaxTasksPerThread = 1;
+    params.m_Splitting = splitting;
+
+    struct ThreadFinishTime
+    {
+      nsThreadID m_ThreadID;
+      nsTime m_LastFinished;
+    };
+
+    nsMutex finishTimesMutex;
+    nsHybridArray<ThreadFinishTime, 16> finishTimes;
+    nsAtomicInteger32 iResult;
+
+    const nsTime tStart = nsTime::Now();
+
+    nsTaskSystem::ParallelForIndexed(
+      0u, static_cast<nsUInt32>(NUM_ITEMS),
+      [&](nsUInt32 uiStartIndex, nsUInt32 uiEndIndex)
+      {
+        nsUInt32 uiValue = 0;
+        for (nsUInt32 i = uiStartIndex; i < uiEndIndex; ++i)
+        {
+          uiValue += SimulateWork(i);
+        }
+
+        iResult.Add(static_cast<nsInt32>(uiValue & 0xFF));
+
+        // a thread may process several ranges, it only goes idle after its last one
+        const nsThreadID threadID = nsThreadUtils::GetCurrentThreadID();
+        const nsTime tNow = nsTime::Now();
+
+        NS_LOCK(finishTimesMutex);
+
+        for (ThreadFinishTime& finishTime : finishTimes)
+        {
+          if (finishTime.m_ThreadID == threadID)
+          {
+            finishTime.m_LastFinished = tNow;
+            return;
+          }
+        }
+
+        finishTimes.PushBack({threadID, tNow});
+      },
+      "Imbalanced Loop", nsTaskNesting::Never, params);
+
+    const nsTime tEnd = nsTime::Now();
+
+    nsTime tFirstIdle = tEnd;
+    for (const ThreadFinishTime& finishTime : finishTimes)
+    {
+      tFirstIdle = nsMath::Min(tFirstIdle, finishTime.m_LastFinished);
+    }
+
+    ImbalanceResult res;
+    res.m_Duration = tEnd - tStart;
+    res.m_Tail = tEnd - tFirstIdle;
+    return res;
+  }
+
+  void MeasureImbalance(nsParallelForSplitting splitting, const char* szName)
+  {
+    nsTime tDuration, tTail;
+
+    for (nsUInt32 n = 0; n < NUM_SAMPLES; n++)
+    {
+      const ImbalanceResult res = RunImbalancedLoop(splitting);
+      tDuration += res.m_Duration;
+      tTail += res.m_Tail;
+    }
+
+    nsLog::Info("[test]Imbalanced ParallelFor ({0}): {1}ms, tail {2}ms", szName, nsArgF(tDuration.GetMilliseconds() / static_cast<double>(NUM_SAMPLES), 3),
+      nsArgF(tTail.GetMilliseconds() / static_cast<double>(NUM_SAMPLES), 3));
+  }
+} // namespace
+
+NS_CREATE_SIMPLE_TEST(Performance, ParallelFor)
+{
+  nsTaskSystem::SetWorkerThreadCount(NUM_WORKERS, NUM_WORKERS);
+
+  // warm up the worker threads
+  RunImbalancedLoop(nsParallelForSplitting::Static);
+
+  NS_TEST_BLOCK(nsTestBlock::Enabled, "Load Imbalance (Static Split)")
+  {
+    MeasureImbalance(nsParallelForSplitting::Static, "static");
+  }
+
+  NS_TEST_BLOCK(nsTestBlock::Enabled, "Load Imbalance (Adaptive Split)")
+  {
+    MeasureImbalance(nsParallelForSplitting::Adaptive, "adaptive");
+  }
+}
@@ -0,0 +1,183 @@
+#include <FoundationTest/FoundationTestPCH.h>
+
+#include <Foundation/Containers/HashTable.h>
+#include <Foundation/Logging/Log.h>
+#include <Foundation/Reflection/Reflection.h>
+#include <Foundation/Strings/HashedString.h>
+#include <Foundation/Threading/Lock.h>
+#include <Foundation/Threading/Mutex.h>
+#include <Foundation/Threading/ReadWriteLock.h>
+#include <Foundation/Threading/Thread.h>
+#include <Foundation/Time/Time.h>
+#include <Foundation/Types/Tag.h>
+#include <Foundation/Types/UniquePtr.h>
+
+namespace
+{
+  enum constants
+  {
+#if NS_ENABLED(NS_COMPILE_FOR_DEBUG)
+    NUM_LOOKUPS_PER_THREAD = 20000,
+#else
+    NUM_LOOKUPS_PER_THREAD = 200000,
+#endif
+    NUM_NAMES = 64,
+    MAX_THREADS = 4,
+  };
+
+  // returns whether the lookup found what it was looking for
+  using LookupFunction = nsDelegate<bool(nsUInt32), 48>;
+
+  class nsLookupThread final : public nsThread
+  {
+  public:
+    nsLookupThread(const LookupFunction& func, nsUInt32 uiThreadIndex, nsAtomicInteger32& ref_iFailedLookups)
+      : nsThread("Lookup Thread")
+      , m_Func(func)
+      , m_uiThreadIndex(uiThreadIndex)
+      , m_iFailedLookups(ref_iFailedLookups)
+    {
+    }
+
+  private:
+    virtual nsUInt32 Run() override
+    {
+      nsInt32 iFailedLookups = 0;
+
+      for (nsUInt32 i = 0; i < NUM_LOOKUPS_PER_THREAD; ++i)
+      {
+        if (!m_Func((i + m_uiThreadIndex * 7) % NUM_NAMES))
+          ++iFailedLookups;
+      }
+
+      m_iFailedLookups.Add(iFailedLookups);
+      return 0;
+    }
+
+    LookupFunction m_Func;
+    nsUInt32 m_uiThreadIndex;
+    nsAtomicInteger32& m_iFailedLookups;
+  };
+
+  // All threads do the same number of lookups. With a lock that lets readers run in parallel, the time per lookup
+  // should stay about the same with more threads, as long as there are enough cores.
+  void MeasureLookups(nsStringView sName, const LookupFunction& func)
+  {
+    for (nsUInt32 uiNumThreads = 1; uiNumThreads <= MAX_THREADS; uiNumThreads *= 2)
+    {
+      nsHybridArray<nsUniquePtr<nsLookupThread>, MAX_THREADS> threads;
+      nsAtomicInteger32 iFailedLookups;
+
+      for (nsUInt32 i = 0; i < uiNumThreads; ++i)
+      {
+        threads.PushBack(NS_DEFAULT_NEW(nsLookupThread, func, i, iFailedLookups));
+      }
+
+      const nsTime tStart = nsTime::Now();
+
+      for (auto& pThread : threads)
+      {
+        pThread->Start();
+      }
+
+      for (auto& pThread : threads)
+      {
+        pThread->Join();
+      }
+
+      const nsTime tDuration = nsTime::Now() - tStart;
+      NS_TEST_INT(iFailedLookups, 0);
+
+      nsLog::Info("[test]{0}, {1} thread(s): {2}ns per lookup", sName, uiNumThreads, nsArgF(tDuration.GetNanoseconds() / static_cast<double>(NUM_LOOKUPS_PER_THREAD), 2));
+    }
+  }
+
+  template <typename LockType>
+  struct nsLockedTable
+  {
+    mutable LockType m_Lock;
+    nsHashTable<nsUInt64, nsUInt32> m_Table;
+  };
+} // namespace
+
+NS_CREATE_SIMPLE_TEST(Performance, RegistryLookups)
+{
+  NS_TEST_BLOCK(nsTestBlock::Enabled, "Mutex vs. ReadWriteLock")
+  {
+    nsLockedTable<nsMutex> mutexTable;
+    nsLockedTable<nsReadWriteLock> rwTable;
+
+    for (nsUInt32 i = 0; i < NUM_NAMES; ++i)
+    {
+      mutexTable.m_Table.Insert(i * 31, i);
+      rwTable.m_Table.Insert(i * 31, i);
+    }
+
+    MeasureLookups("Hash table with nsMutex", [&](nsUInt32 uiIndex)
+      {
+        NS_LOCK(mutexTable.m_Lock);
+        return mutexTable.m_Table.Contains(uiIndex * 31);
+      });
+
+    MeasureLookups("Hash table with nsReadWriteLock", [&](nsUInt32 uiIndex)
+      {
+        NS_LOCK_READ(rwTable.m_Lock);
+        return rwTable.m_Table.Contains(uiIndex * 31);
+      });
+  }
+
+  NS_TEST_BLOCK(nsTestBlock::Enabled, "RTTI")
+  {
+    nsDynamicArray<nsString> typeNames;
+    nsRTTI::ForEachType([&](const nsRTTI* pRtti)
+      {
+        if (typeNames.GetCount() < NUM_NAMES)
+          typeNames.PushBack(pRtti->GetTypeName());
+      });
+
+    NS_TEST_INT(typeNames.GetCount(), NUM_NAMES);
+
+    MeasureLookups("nsRTTI::FindTypeByName", [&](nsUInt32 uiIndex)
+      { return nsRTTI::FindTypeByName(typeNames[uiIndex]) != nullptr; });
+  }
+
+  NS_TEST_BLOCK(nsTestBlock::Enabled, "Tags")
+  {
+    nsTagRegistry registry;
+    nsDynamicArray<nsTempHashedString> tagNames;
+
+    for (nsUInt32 i = 0; i < NUM_NAMES; ++i)
+    {
+      nsStringBuilder sName;
+      sName.SetFormat("Benchmark Tag {0}", i);
+      registry.RegisterTag(sName);
+      tagNames.PushBack(nsTempHashedString(sName));
+    }
+
+    MeasureLookups("nsTagRegistry::GetTagByName", [&](nsUInt32 uiIndex)
+      { return registry.GetTagByName(tagNames[uiIndex]) != nullptr; });
+  }
+
+  NS_TEST_BLOCK(nsTestBlock::Enabled, "Hashed Strings")
+  {
+    nsDynamicArray<nsString> names;
+    nsDynamicArray<nsHashedString> hashedNames;
+
+    for (nsUInt32 i = 0; i < NUM_NAMES; ++i)
+    {
+      nsStringBuilder sName;
+      sName.SetFormat("Benchmark String {0}", i);
+      names.PushBack(sName);
+
+      // keeps the strings alive, so the benchmark only measures finding existing strings
+      hashedNames.ExpandAndGetRef().Assign(sName);
+    }
+
+    MeasureLookups("nsHashedString::Assign", [&](nsUInt32 uiIndex)
+      {
+        nsHashedString sHashed;
+        sHashed.Assign(names[uiIndex]);
+        return sHashed == hashedNames[uiIndex];
+      });
+  }
+}
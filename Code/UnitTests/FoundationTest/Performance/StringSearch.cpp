@@ -0,0 +1,156 @@
+#include <FoundationTest/FoundationTestPCH.h>
+
+#include <Foundation/Containers/DynamicArray.h>
+#include <Foundation/Logging/Log.h>
+#include <Foundation/Strings/StringSearcher.h>
+#include <Foundation/Time/Time.h>
+
+#include <string_view>
+
+namespace
+{
+  enum constants
+  {
+#if NS_ENABLED(NS_COMPILE_FOR_DEBUG)
+    NUM_ROUNDS = 4,
+#else
+    NUM_ROUNDS = 64,
+#endif
+    TEXT_SIZE = 1024 * 1024,
+  };
+
+  // fills the buffer with words of random letters, the search patterns don't occur in it
+  void FillSearchText(nsDynamicArray<char>& ref_text)
+  {
+    ref_text.Clear();
+    ref_text.Reserve(TEXT_SIZE + 1);
+
+    nsUInt32 x = 0x12345678;
+    while (ref_text.GetCount() < TEXT_SIZE)
+    {
+      x ^= x << 13;
+      x ^= x >> 17;
+      x ^= x << 5;
+
+      ref_text.PushBack((x % 7 == 0) ? ' ' : static_cast<char>('a' + (x >> 8) % 20));
+    }
+
+    ref_text.PushBack('\0');
+  }
+
+  void ReportSearch(const char* szName, const char* szPattern, nsTime tDuration, nsUInt32 uiChecksum)
+  {
+    const double fMegaBytes = static_cast<double>(NUM_ROUNDS) * static_cast<double>(TEXT_SIZE) / (1024.0 * 1024.0);
+    nsLog::Info("[test]{0}, '{1}': {2} MB/s (checksum {3})", szName, szPattern, nsArgF(fMegaBytes / tDuration.GetSeconds(), 0), nsArgU(uiChecksum & 0xFF));
+  }
+} // namespace
+
+NS_CREATE_SIMPLE_TEST(Performance, StringSearch)
+{
+  nsDynamicArray<char> text;
+  FillSearchText(text);
+
+  const char* pStart = text.GetData();
+  const char* pEnd = pStart + TEXT_SIZE;
+
+  const char* patterns[] = {"xyz", "zealous", "somewhat longer search text"};
+
+  for (const char* szPattern : patterns)
+  {
+    const char* szPatternEnd = szPattern + nsStringUtils::GetStringElementCount(szPattern);
+
+    NS_TEST_BLOCK(nsTestBlock::Enabled, "Case Sensitive")
+    {
+      nsUInt32 uiChecksum = 0;
+      nsTime tStart = nsTime::Now();
+
+      for (nsUInt32 i = 0; i < NUM_ROUNDS; ++i)
+      {
+        uiChecksum += static_cast<nsUInt32>(std::string_view(pStart, TEXT_SIZE).find(szPattern));
+      }
+
+      ReportSearch("std::string_view::find", szPattern, nsTime::Now() - tStart, uiChecksum);
+
+      uiChecksum = 0;
+      tStart = nsTime::Now();
+
+      for (nsUInt32 i = 0; i < NUM_ROUNDS; ++i)
+      {
+        uiChecksum += nsStringUtils::FindSubString(pStart, szPattern, pEnd, szPatternEnd) == nullptr ? 1 : 0;
+      }
+
+      ReportSearch("nsStringUtils::FindSubString", szPattern, nsTime::Now() - tStart, uiChecksum);
+      NS_TEST_INT(uiChecksum, NUM_ROUNDS);
+
+      nsStringSearcher searcher(szPattern);
+      uiChecksum = 0;
+      tStart = nsTime::Now();
+
+      for (nsUInt32 i = 0; i < NUM_ROUNDS; ++i)
+      {
+        uiChecksum += searcher.FindIn(nsStringView(pStart, pEnd)) == nullptr ? 1 : 0;
+      }
+
+      ReportSearch("nsStringSearcher::FindIn", szPattern, nsTime::Now() - tStart, uiChecksum);
+      NS_TEST_INT(uiChecksum, NUM_ROUNDS);
+    }
+
+    NS_TEST_BLOCK(nsTestBlock::Enabled, "Case Insensitive")
+    {
+      nsUInt32 uiChecksum = 0;
+      nsTime tStart = nsTime::Now();
+
+      for (nsUInt32 i = 0; i < NUM_ROUNDS; ++i)
+      {
+        uiChecksum += nsStringUtils::FindSubString_NoCase(pStart, szPattern, pEnd, szPatternEnd) == nullptr ? 1 : 0;
+      }
+
+      ReportSearch("nsStringUtils::FindSubString_NoCase", szPattern, nsTime::Now() - tStart, uiChecksum);
+      NS_TEST_INT(uiChecksum, NUM_ROUNDS);
+
+      nsStringSearcher searcher(szPattern, false);
+      uiChecksum = 0;
+      tStart = nsTime::Now();
+
+      for (nsUInt32 i = 0; i < NUM_ROUNDS; ++i)
+      {
+        uiChecksum += searcher.FindIn(nsStringView(pStart, pEnd)) == nullptr ? 1 : 0;
+      }
+
+      ReportSearch("nsStringSearcher::FindIn (no case)", szPattern, nsTime::Now() - tStart, uiChecksum);
+      NS_TEST_INT(uiChecksum, NUM_ROUNDS);
+    }
+  }
+
+  NS_TEST_BLOCK(nsTestBlock::Enabled, "Compare")
+  {
+    nsDynamicArray<char> copy = text;
+    nsDynamicArray<char> upper = text;
+    for (char& c : upper)
+    {
+      c = static_cast<char>(nsStringUtils::ToUpperChar(c));
+    }
+
+    nsUInt32 uiChecksum = 0;
+    nsTime tStart = nsTime::Now();
+
+    for (nsUInt32 i = 0; i < NUM_ROUNDS; ++i)
+    {
+      uiChecksum += nsStringUtils::IsEqual(pStart, copy.GetData(), pEnd, copy.GetData() + TEXT_SIZE) ? 1 : 0;
+    }
+
+    ReportSearch("nsStringUtils::IsEqual", "", nsTime::Now() - tStart, uiChecksum);
+    NS_TEST_INT(uiChecksum, NUM_ROUNDS);
+
+    uiChecksum = 0;
+    tStart = nsTime::Now();
+
+    for (nsUInt32 i = 0; i < NUM_ROUNDS; ++i)
+    {
+      uiChecksum += nsStringUtils::IsEqual_NoCase(pStart, upper.GetData(), pEnd, upper.GetData() + TEXT_SIZE) ? 1 : 0;
+    }
+
+    ReportSearch("nsStringUtils::IsEqual_NoCase", "", nsTime::Now() - tStart, uiChecksum);
+    NS_TEST_INT(uiChecksum, NUM_ROUNDS);
+  }
+}
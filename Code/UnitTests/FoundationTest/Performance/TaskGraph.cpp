@@ -0,0 +1,140 @@
+#include <FoundationTest/FoundationTestPCH.h>
+
+#include <Foundation/Logging/Log.h>
+#include <Foundation/Threading/TaskGraph.h>
+#include <Foundation/Threading/TaskSystem.h>
+#include <Foundation/Time/Time.h>
+
+namespace
+{
+  enum constants
+  {
+#if NS_ENABLED(NS_COMPILE_FOR_DEBUG)
+    NUM_FRAMES = 100,
+#else
+    NUM_FRAMES = 1000,
+#endif
+    NUM_LAYERS = 8,
+    NODES_PER_LAYER = 8,
+    NUM_WORKERS = 4,
+  };
+
+  class nsPipelineTask final : public nsTask
+  {
+  public:
+    nsPipelineTask(nsAtomicInteger32* pCounter)
+      : m_pCounter(pCounter)
+    {
+      ConfigureTask("Pipeline Task", nsTaskNesting::Never);
+    }
+
+  private:
+    virtual void Execute() override { m_pCounter->Increment(); }
+
+    nsAtomicInteger32* m_pCounter;
+  };
+
+  // A pipeline with a few layers, where every node depends on all nodes of the previous layer. The tasks themselves do no work,
+  // so the measured time is dominated by setting up and scheduling the tasks.
+  nsTime RunWithTaskGroups(nsDynamicArray<nsSharedPtr<nsTask>>& ref_tasks)
+  {
+    const nsTime tStart = nsTime::Now();
+
+    for (nsUInt32 uiFrame = 0; uiFrame < NUM_FRAMES; ++uiFrame)
+    {
+      nsTaskGroupID groups[NUM_LAYERS * NODES_PER_LAYER];
+      nsHybridArray<nsTaskGroupDependency, 512> dependencies;
+
+      for (nsUInt32 uiLayer = 0; uiLayer < NUM_LAYERS; ++uiLayer)
+      {
+        for (nsUInt32 uiNode = 0; uiNode < NODES_PER_LAYER; ++uiNode)
+        {
+          const nsUInt32 uiIndex = uiLayer * NODES_PER_LAYER + uiNode;
+          groups[uiIndex] = nsTaskSystem::CreateTaskGroup(nsTaskPriority::ThisFrame);
+          nsTaskSystem::AddTaskToGroup(groups[uiIndex], ref_tasks[uiIndex]);
+
+          if (uiLayer > 0)
+          {
+            for (nsUInt32 uiPrev = 0; uiPrev < NODES_PER_LAYER; ++uiPrev)
+            {
+              dependencies.PushBack({groups[uiIndex], groups[(uiLayer - 1) * NODES_PER_LAYER + uiPrev]});
+            }
+          }
+        }
+      }
+
+      nsTaskSystem::AddTaskGroupDependencyBatch(dependencies);
+      nsTaskSystem::StartTaskGroupBatch(nsArrayPtr<const nsTaskGroupID>(groups));
+
+      for (const nsTaskGroupID& group : groups)
+      {
+        nsTaskSystem::WaitForGroup(group);
+      }
+    }
+
+    return nsTime::Now() - tStart;
+  }
+
+  nsTime RunWithTaskGraph(nsDynamicArray<nsSharedPtr<nsTask>>& ref_tasks)
+  {
+    nsTaskGraph graph;
+
+    for (nsUInt32 uiLayer = 0; uiLayer < NUM_LAYERS; ++uiLayer)
+    {
+      for (nsUInt32 uiNode = 0; uiNode < NODES_PER_LAYER; ++uiNode)
+      {
+        const nsTaskGraph::NodeIndex node = graph.AddNode(ref_tasks[uiLayer * NODES_PER_LAYER + uiNode]);
+
+        if (uiLayer > 0)
+        {
+          for (nsUInt32 uiPrev = 0; uiPrev < NODES_PER_LAYER; ++uiPrev)
+          {
+            graph.AddDependency(node, (uiLayer - 1) * NODES_PER_LAYER + uiPrev);
+          }
+        }
+      }
+    }
+
+    NS_TEST_BOOL(graph.Finalize().Succeeded());
+
+    const nsTime tStart = nsTime::Now();
+
+    for (nsUInt32 uiFrame = 0; uiFrame < NUM_FRAMES; ++uiFrame)
+    {
+      nsTaskSystem::WaitForGroup(graph.Execute());
+    }
+
+    return nsTime::Now() - tStart;
+  }
+} // namespace
+
+NS_CREATE_SIMPLE_TEST(Performance, TaskGraph)
+{
+  nsTaskSystem::SetWorkerThreadCount(NUM_WORKERS, NUM_WORKERS);
+
+  nsAtomicInteger32 iCounter;
+
+  nsDynamicArray<nsSharedPtr<nsTask>> tasks;
+  for (nsUInt32 i = 0; i < NUM_LAYERS * NODES_PER_LAYER; ++i)
+  {
+    tasks.PushBack(NS_DEFAULT_NEW(nsPipelineTask, &iCounter));
+  }
+
+  NS_TEST_BLOCK(nsTestBlock::Enabled, "Rebuilt Task Groups")
+  {
+    iCounter = 0;
+    const nsTime tDuration = RunWithTaskGroups(tasks);
+    NS_TEST_INT(iCounter, NUM_FRAMES * NUM_LAYERS * NODES_PER_LAYER);
+
+    nsLog::Info("[test]Pipeline with task groups: {0}us per frame", nsArgF(tDuration.GetMicroseconds() / static_cast<double>(NUM_FRAMES), 2));
+  }
+
+  NS_TEST_BLOCK(nsTestBlock::Enabled, "Replayed Task Graph")
+  {
+    iCounter = 0;
+    const nsTime tDuration = RunWithTaskGraph(tasks);
+    NS_TEST_INT(iCounter, NUM_FRAMES * NUM_LAYERS * NODES_PER_LAYER);
+
+    nsLog::Info("[test]Pipeline with task graph: {0}us per frame", nsArgF(tDuration.GetMicroseconds() / static_cast<double>(NUM_FRAMES), 2));
+  }
+}
@@ -0,0 +1,175 @@
+#include <FoundationTest/FoundationTestPCH.h>
+
+#include <Foundation/Containers/DynamicArray.h>
+#include <Foundation/Logging/Log.h>
+#include <Foundation/Time/Time.h>
+
+namespace
+{
+  enum constants
+  {
+#if NS_ENABLED(NS_COMPILE_FOR_DEBUG)
+    NUM_ROUNDS = 4,
+#else
+    NUM_ROUNDS = 64,
+#endif
+    TEXT_SIZE = 1024 * 1024,
+  };
+
+  // fills the buffer with text, where roughly every uiNonAsciiRatio'th character is not ASCII
+  void FillText(nsDynamicArray<char>& ref_text, nsUInt32 uiNonAsciiRatio)
+  {
+    ref_text.Clear();
+    ref_text.Reserve(TEXT_SIZE + 4);
+
+    nsUInt32 x = 0x12345678;
+    while (ref_text.GetCount() < TEXT_SIZE)
+    {
+      x ^= x << 13;
+      x ^= x >> 17;
+      x ^= x << 5;
+
+      const nsUInt32 uiChar = (uiNonAsciiRatio != 0 && x % uiNonAsciiRatio == 0) ? 0xA0 + (x >> 8) % 0x2000 : 0x20 + (x >> 8) % 0x5F;
+
+      char szBuffer[4];
+      char* pWrite = szBuffer;
+      nsUnicodeUtils::EncodeUtf32ToUtf8(uiChar, pWrite);
+      ref_text.PushBackRange(nsArrayPtr<const char>(szBuffer, static_cast<nsUInt32>(pWrite - szBuffer)));
+    }
+  }
+
+  void Report(const char* szName, const char* szText, nsTime tDuration, nsUInt32 uiChecksum)
+  {
+    const double fMegaBytes = static_cast<double>(NUM_ROUNDS) * static_cast<double>(TEXT_SIZE) / (1024.0 * 1024.0);
+    nsLog::Info("[test]{0}, {1}: {2} MB/s (checksum {3})", szName, szText, nsArgF(fMegaBytes / tDuration.GetSeconds(), 0), nsArgU(uiChecksum & 0xFF));
+  }
+} // namespace
+
+NS_CREATE_SIMPLE_TEST(Performance, Unicode)
+{
+  struct TextType
+  {
+    const char* m_szName;
+    nsUInt32 m_uiNonAsciiRatio;
+  };
+
+  const TextType textTypes[] = {{"ASCII", 0}, {"Mostly ASCII", 50}, {"Mixed", 3}};
+
+  nsDynamicArray<char> text;
+  nsDynamicArray<nsUInt16> utf16;
+  nsDynamicArray<char> utf8;
+
+  for (const TextType& type : textTypes)
+  {
+    FillText(text, type.m_uiNonAsciiRatio);
+    const char* pStart = text.GetData();
+    const char* pEnd = pStart + text.GetCount();
+
+    NS_TEST_BLOCK(nsTestBlock::Enabled, "Validation")
+    {
+      nsUInt32 uiChecksum = 0;
+      nsTime tStart = nsTime::Now();
+
+      for (nsUInt32 i = 0; i < NUM_ROUNDS; ++i)
+      {
+        uiChecksum += utf8::is_valid(pStart, pEnd) ? 1 : 0;
+      }
+
+      Report("utf8::is_valid", type.m_szName, nsTime::Now() - tStart, uiChecksum);
+
+      uiChecksum = 0;
+      tStart = nsTime::Now();
+
+      for (nsUInt32 i = 0; i < NUM_ROUNDS; ++i)
+      {
+        uiChecksum += nsUnicodeUtils::ValidateUtf8(pStart, pEnd) ? 1 : 0;
+      }
+
+      Report("nsUnicodeUtils::ValidateUtf8", type.m_szName, nsTime::Now() - tStart, uiChecksum);
+      NS_TEST_INT(uiChecksum, NUM_ROUNDS);
+    }
+
+    NS_TEST_BLOCK(nsTestBlock::Enabled, "Character Count")
+    {
+      nsUInt32 uiChecksum = 0;
+      nsTime tStart = nsTime::Now();
+
+      for (nsUInt32 i = 0; i < NUM_ROUNDS; ++i)
+      {
+        uiChecksum += static_cast<nsUInt32>(utf8::unchecked::distance(pStart, pEnd));
+      }
+
+      Report("utf8::unchecked::distance", type.m_szName, nsTime::Now() - tStart, uiChecksum);
+
+      const nsUInt32 uiExpected = uiChecksum;
+      uiChecksum = 0;
+      tStart = nsTime::Now();
+
+      for (nsUInt32 i = 0; i < NUM_ROUNDS; ++i)
+      {
+        uiChecksum += nsUnicodeUtils::CountUtf8Characters(pStart, pEnd);
+      }
+
+      Report("nsUnicodeUtils::CountUtf8Characters", type.m_szName, nsTime::Now() - tStart, uiChecksum);
+      NS_TEST_INT(uiChecksum, uiExpected);
+    }
+
+    NS_TEST_BLOCK(nsTestBlock::Enabled, "Utf8 to Utf16")
+    {
+      utf16.SetCountUninitialized(text.GetCount());
+
+      nsUInt32 uiChecksum = 0;
+      nsTime tStart = nsTime::Now();
+
+      for (nsUInt32 i = 0; i < NUM_ROUNDS; ++i)
+      {
+        uiChecksum += static_cast<nsUInt32>(utf8::unchecked::utf8to16(pStart, pEnd, utf16.GetData()) - utf16.GetData());
+      }
+
+      Report("utf8::unchecked::utf8to16", type.m_szName, nsTime::Now() - tStart, uiChecksum);
+
+      const nsUInt32 uiExpected = uiChecksum;
+      uiChecksum = 0;
+      tStart = nsTime::Now();
+
+      for (nsUInt32 i = 0; i < NUM_ROUNDS; ++i)
+      {
+        uiChecksum += nsUnicodeUtils::ConvertUtf8ToUtf16(pStart, pEnd, utf16.GetData());
+      }
+
+      Report("nsUnicodeUtils::ConvertUtf8ToUtf16", type.m_szName, nsTime::Now() - tStart, uiChecksum);
+      NS_TEST_INT(uiChecksum, uiExpected);
+    }
+
+    NS_TEST_BLOCK(nsTestBlock::Enabled, "Utf16 to Utf8")
+    {
+      utf16.SetCountUninitialized(nsUnicodeUtils::ConvertUtf8ToUtf16(pStart, pEnd, utf16.GetData()));
+      utf8.SetCountUninitialized(utf16.GetCount() * 3);
+
+      const nsUInt16* pUtf16Start = utf16.GetData();
+      const nsUInt16* pUtf16End = pUtf16Start + utf16.GetCount();
+
+      nsUInt32 uiChecksum = 0;
+      nsTime tStart = nsTime::Now();
+
+      for (nsUInt32 i = 0; i < NUM_ROUNDS; ++i)
+      {
+        uiChecksum += static_cast<nsUInt32>(utf8::unchecked::utf16to8(pUtf16Start, pUtf16End, utf8.GetData()) - utf8.GetData());
+      }
+
+      Report("utf8::unchecked::utf16to8", type.m_szName, nsTime::Now() - tStart, uiChecksum);
+
+      const nsUInt32 uiExpected = uiChecksum;
+      uiChecksum = 0;
+      tStart = nsTime::Now();
+
+      for (nsUInt32 i = 0; i < NUM_ROUNDS; ++i)
+      {
+        uiChecksum += nsUnicodeUtils::ConvertUtf16ToUtf8(pUtf16Start, pUtf16End, utf8.GetData());
+      }
+
+      Report("nsUnicodeUtils::ConvertUtf16ToUtf8", type.m_szName, nsTime::Now() - tStart, uiChecksum);
+      NS_TEST_INT(uiChecksum, uiExpected);
+    }
+  }
+}
@@ -236,6 +236,56 @@ NS_CREATE_SIMPLE_TEST(Strings, FormatString)
     }
   }
 
+  NS_TEST_BLOCK(nsTestBlock::Enabled, "Compile Time Format Strings")
+  {
+    static_assert(nsFormatStringDetail::ParseFormatString("", nullptr) == 0);
+    static_assert(nsFormatStringDetail::ParseFormatString("text", nullptr) == 1);
+    static_assert(nsFormatStringDetail::ParseFormatString("{}", nullptr) == 1);
+    static_assert(nsFormatStringDetail::ParseFormatString("a {} b {1}", nullptr) == 2);
+    static_assert(nsFormatStringDetail::ParseFormatString("a {} b {1} c", nullptr) == 3);
+    static_assert(nsFormatStringDetail::ParseFormatString("100%%", nullptr) == 1);
+    static_assert(nsFormatStringDetail::ParseFormatString("{x} {12}", nullptr) == 1);
+
+    auto format1 = NS_FMT("{1}, {}");
+    auto format2 = NS_FMT("{3}, {1}");
+    auto format3 = NS_FMT("Plain text");
+    auto format4 = NS_FMT("100%%");
+    static_assert(decltype(format1)::Layout.m_uiNumArguments == 3);
+    static_assert(decltype(format2)::Layout.m_uiNumArguments == 4);
+    static_assert(decltype(format3)::Layout.m_bIsPlainText);
+    static_assert(!decltype(format4)::Layout.m_bIsPlainText);
+
+    // the compile time parsed format strings give the same results as the ones that are parsed at runtime
+    TestFormat(nsFmt(NS_FMT("")), "");
+    TestFormat(nsFmt(NS_FMT("No formatting at all")), "No formatting at all");
+    TestFormat(nsFmt(NS_FMT("{0}, {1}, {2}, {3}"), nsInt8(-1), nsInt16(-2), nsInt32(-3), nsInt64(-4)), "-1, -2, -3, -4");
+    TestFormat(nsFmt(NS_FMT("{3}, {1}, {0}, {2}"), nsArgF(23.12345f, 1), nsArgI(42), 17, 12.34f), "12.34, 42, 23.1, 17");
+    TestFormat(nsFmt(NS_FMT("{2}, {}, {1}, {}"), nsUInt8(1), nsUInt16(2), nsUInt32(3), nsUInt64(4), nsUInt64(5)), "3, 4, 2, 3");
+    TestFormat(nsFmt(NS_FMT("{}{}{}"), "a", "b", "c"), "abc");
+    TestFormat(nsFmt(NS_FMT("100%% of {}%%"), 42), "100% of 42%");
+    TestFormat(nsFmt(NS_FMT("{x} {12} { } {"), 1), "{x} {12} { } {");
+    TestFormat(nsFmt(NS_FMT("Unused arguments: {1}"), 1, 2, 3), "Unused arguments: 2");
+    TestFormat(nsFmt(NS_FMT("\xc3\xb6\xc3\xa4\xc3\xbc {} \xc3\x9f"), "\xc3\x96"), "\xc3\xb6\xc3\xa4\xc3\xbc \xc3\x96 \xc3\x9f");
+
+    nsStringBuilder sb;
+    NS_TEST_STRING(nsFmt(NS_FMT("{} and {}"), "this", "that").GetTextCStr(sb), "this and that");
+    NS_TEST_STRING(nsFmt(NS_FMT("Plain text")).GetTextCStr(sb), "Plain text");
+
+    sb.SetFormat(NS_FMT("{}-{}"), 1, 2);
+    NS_TEST_STRING(sb, "1-2");
+
+    sb.AppendFormat(NS_FMT(", {}"), nsArgC('x'));
+    NS_TEST_STRING(sb, "1-2, x");
+
+    sb.PrependFormat(NS_FMT("{}: "), "Values");
+    NS_TEST_STRING(sb, "Values: 1-2, x");
+
+    // placeholders that reference more arguments than are passed in, or single percentage signs don't compile:
+    // sb.SetFormat(NS_FMT("{} and {}"), 1);
+    // sb.SetFormat(NS_FMT("{2}"), 1, 2);
+    // sb.SetFormat(NS_FMT("100%"));
+  }
+
   NS_TEST_BLOCK(nsTestBlock::Enabled, "Sensitive Info")
   {
     auto prev = nsArgSensitive::s_BuildStringCB;
@@ -1,6 +1,23 @@
 #include <FoundationTest/FoundationTestPCH.h>
 
 #include <Foundation/Strings/HashedString.h>
+#include <Foundation/Threading/TaskSystem.h>
+
+namespace
+{
+  // the expected hashes depend on the hash function that is selected by NS_HASHING_VERSION
+#if NS_HASHING_VERSION >= 2
+  constexpr nsUInt64 uiHashEmpty = 0x2d06800538d394c2llu;
+  constexpr nsUInt64 uiHashTest = 0x9ec9f7918d7dfc40llu;
+  constexpr nsUInt64 uiHashTest2 = 0x8ae77bf80f94a3dallu;
+  constexpr nsUInt64 uiHashTestUpper = 0xb3f5bb77a55fad5ellu;
+#else
+  constexpr nsUInt64 uiHashEmpty = 0xef46db3751d8e999llu;
+  constexpr nsUInt64 uiHashTest = 0x4fdcca5ddb678139llu;
+  constexpr nsUInt64 uiHashTest2 = 0x890e0a4c7111eb87llu;
+  constexpr nsUInt64 uiHashTestUpper = 0xda83efc38a8922b4llu;
+#endif
+} // namespace
 
 NS_CREATE_SIMPLE_TEST(Strings, HashedString)
 {
@@ -11,19 +28,19 @@ NS_CREATE_SIMPLE_TEST(Strings, HashedString)
 
     s2.Assign("test"); // compile time hashing
 
-    NS_TEST_INT(s.GetHash(), 0xef46db3751d8e999llu);
+    NS_TEST_INT(s.GetHash(), uiHashEmpty);
     NS_TEST_STRING(s.GetString().GetData(), "");
     NS_TEST_BOOL(s.GetString().IsEmpty());
 
     nsTempHashedString ts("test"); // compile time hashing
-    NS_TEST_INT(ts.GetHash(), 0x4fdcca5ddb678139llu);
+    NS_TEST_INT(ts.GetHash(), uiHashTest);
 
     nsStringBuilder sb = "test2";
     nsTempHashedString ts2(sb.GetData()); // runtime hashing
-    NS_TEST_INT(ts2.GetHash(), 0x890e0a4c7111eb87llu);
+    NS_TEST_INT(ts2.GetHash(), uiHashTest2);
 
     nsTempHashedString ts3(s2);
-    NS_TEST_INT(ts3.GetHash(), 0x4fdcca5ddb678139llu);
+    NS_TEST_INT(ts3.GetHash(), uiHashTest);
   }
 
   NS_TEST_BLOCK(nsTestBlock::Enabled, "Assign")
@@ -32,22 +49,22 @@ NS_CREATE_SIMPLE_TEST(Strings, HashedString)
     s.Assign("Test"); // compile time hashing
 
     NS_TEST_STRING(s.GetString().GetData(), "Test");
-    NS_TEST_INT(s.GetHash(), 0xda83efc38a8922b4llu);
+    NS_TEST_INT(s.GetHash(), uiHashTestUpper);
 
     nsStringBuilder sb = "test2";
     s.Assign(sb.GetData()); // runtime hashing
     NS_TEST_STRING(s.GetString().GetData(), "test2");
-    NS_TEST_INT(s.GetHash(), 0x890e0a4c7111eb87llu);
+    NS_TEST_INT(s.GetHash(), uiHashTest2);
 
     nsTempHashedString ts("dummy");
     ts = "test";       // compile time hashing
-    NS_TEST_INT(ts.GetHash(), 0x4fdcca5ddb678139llu);
+    NS_TEST_INT(ts.GetHash(), uiHashTest);
 
     ts = sb.GetData(); // runtime hashing
-    NS_TEST_INT(ts.GetHash(), 0x890e0a4c7111eb87llu);
+    NS_TEST_INT(ts.GetHash(), uiHashTest2);
 
     s.Assign("");
-    NS_TEST_INT(s.GetHash(), 0xef46db3751d8e999llu);
+    NS_TEST_INT(s.GetHash(), uiHashEmpty);
     NS_TEST_STRING(s.GetString().GetData(), "");
     NS_TEST_BOOL(s.GetString().IsEmpty());
   }
@@ -59,16 +76,16 @@ NS_CREATE_SIMPLE_TEST(Strings, HashedString)
 
     NS_TEST_INT(ts.GetHash(), hs.GetHash());
 
-    NS_TEST_INT(ts.GetHash(), 0xef46db3751d8e999llu);
+    NS_TEST_INT(ts.GetHash(), uiHashEmpty);
 
     ts = "Test";
     nsTempHashedString ts2 = ts;
-    NS_TEST_INT(ts.GetHash(), 0xda83efc38a8922b4llu);
+    NS_TEST_INT(ts.GetHash(), uiHashTestUpper);
 
     ts = "";
     ts2.Clear();
-    NS_TEST_INT(ts.GetHash(), 0xef46db3751d8e999llu);
-    NS_TEST_INT(ts2.GetHash(), 0xef46db3751d8e999llu);
+    NS_TEST_INT(ts.GetHash(), uiHashEmpty);
+    NS_TEST_INT(ts2.GetHash(), uiHashEmpty);
   }
 
   NS_TEST_BLOCK(nsTestBlock::Enabled, "operator== / operator!=")
@@ -185,6 +202,70 @@ NS_CREATE_SIMPLE_TEST(Strings, HashedString)
     NS_TEST_STRING(s3.GetString().GetData(), "tut");
   }
 
+  NS_TEST_BLOCK(nsTestBlock::Enabled, "Many strings / LookupStringHash")
+  {
+    // enough strings to grow the central storage several times
+    nsDynamicArray<nsHashedString> strings;
+    nsStringBuilder sb;
+
+    for (nsUInt32 i = 0; i < 5000; ++i)
+    {
+      sb.SetFormat("Many Strings {0}", i);
+      strings.ExpandAndGetRef().Assign(sb);
+    }
+
+    for (nsUInt32 i = 0; i < 5000; ++i)
+    {
+      sb.SetFormat("Many Strings {0}", i);
+
+      nsHashedString s;
+      s.Assign(sb);
+      NS_TEST_BOOL(s == strings[i]);
+      NS_TEST_STRING(strings[i].GetData(), sb);
+
+      nsStringView sLookup;
+      NS_TEST_BOOL(nsHashedString::LookupStringHash(nsHashingUtils::StringHash(sb), sLookup).Succeeded());
+      NS_TEST_STRING(sLookup, sb);
+    }
+
+    nsStringView sLookup;
+    NS_TEST_BOOL(nsHashedString::LookupStringHash(nsHashingUtils::StringHash("Many Strings 5000"), sLookup).Failed());
+  }
+
+  NS_TEST_BLOCK(nsTestBlock::Enabled, "Multi-threaded")
+  {
+    constexpr nsUInt32 uiNumStrings = 1000;
+    constexpr nsUInt32 uiNumItems = uiNumStrings * 8;
+
+    // every string is created by several threads at the same time, they must all end up with the same entry
+    nsDynamicArray<nsHashedString> strings;
+    strings.SetCount(uiNumItems);
+
+    nsParallelForParams params;
+    params.m_uiBinSize = 64;
+
+    nsTaskSystem::ParallelForIndexed(
+      0, uiNumItems, [&](nsUInt32 uiStartIndex, nsUInt32 uiEndIndex)
+      {
+        nsStringBuilder sb;
+        for (nsUInt32 i = uiStartIndex; i < uiEndIndex; ++i)
+        {
+          sb.SetFormat("Multi-threaded {0}", (i * 7) % uiNumStrings);
+          strings[i].Assign(sb);
+        } },
+      "HashedStringTest", nsTaskNesting::Never, params);
+
+    nsStringBuilder sb;
+    for (nsUInt32 i = 0; i < uiNumItems; ++i)
+    {
+      const nsUInt32 uiString = (i * 7) % uiNumStrings;
+      sb.SetFormat("Multi-threaded {0}", uiString);
+
+      NS_TEST_STRING(strings[i].GetData(), sb);
+      NS_TEST_BOOL(strings[i] == strings[i % uiNumStrings]);
+    }
+  }
+
 #if NS_ENABLED(NS_HASHED_STRING_REF_COUNTING)
   NS_TEST_BLOCK(nsTestBlock::Enabled, "ClearUnusedStrings")
   {
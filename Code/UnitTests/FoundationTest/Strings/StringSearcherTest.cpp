@@ -0,0 +1,145 @@
+#include <FoundationTest/FoundationTestPCH.h>
+
+#include <Foundation/Math/Random.h>
+#include <Foundation/Strings/StringSearcher.h>
+
+namespace
+{
+  void BuildSearcherText(nsRandom& ref_rnd, nsUInt32 uiNumCharacters, nsArrayPtr<const char* const> alphabet, nsStringBuilder& out_sText)
+  {
+    out_sText.Clear();
+    for (nsUInt32 i = 0; i < uiNumCharacters; ++i)
+    {
+      out_sText.Append(alphabet[ref_rnd.UIntInRange(alphabet.GetCount())]);
+    }
+  }
+} // namespace
+
+NS_CREATE_SIMPLE_TEST(Strings, StringSearcher)
+{
+  NS_TEST_BLOCK(nsTestBlock::Enabled, "Constructor / SetPattern")
+  {
+    nsStringSearcher searcher;
+    NS_TEST_BOOL(searcher.GetPattern().IsEmpty());
+    NS_TEST_BOOL(searcher.IsCaseSensitive());
+
+    searcher.SetPattern("Needle", false);
+    NS_TEST_STRING(searcher.GetPattern(), "Needle");
+    NS_TEST_BOOL(!searcher.IsCaseSensitive());
+
+    nsStringSearcher searcher2("Hay");
+    NS_TEST_STRING(searcher2.GetPattern(), "Hay");
+    NS_TEST_BOOL(searcher2.IsCaseSensitive());
+
+    // only the part before a terminator is searched for
+    const char szPattern[] = "ab\0cd";
+    searcher2.SetPattern(nsStringView(szPattern, szPattern + 5));
+    NS_TEST_STRING(searcher2.GetPattern(), "ab");
+  }
+
+  NS_TEST_BLOCK(nsTestBlock::Enabled, "FindIn")
+  {
+    const char* szText = "There is a needle in this haystack, and another needle.";
+
+    nsStringSearcher searcher("needle");
+    NS_TEST_BOOL(searcher.FindIn(szText) == szText + 11);
+    NS_TEST_BOOL(searcher.FindIn(nsStringView(szText + 12)) == szText + 48);
+    NS_TEST_BOOL(searcher.FindIn(nsStringView(szText + 12, szText + 53)) == nullptr);
+    NS_TEST_BOOL(searcher.IsContainedIn(szText));
+    NS_TEST_BOOL(!searcher.IsContainedIn("Needle"));
+    NS_TEST_BOOL(!searcher.IsContainedIn("needl"));
+    NS_TEST_BOOL(!searcher.IsContainedIn(""));
+    NS_TEST_BOOL(!searcher.IsContainedIn(nsStringView()));
+
+    searcher.SetPattern("a");
+    NS_TEST_BOOL(searcher.FindIn(szText) == szText + 9);
+
+    searcher.SetPattern(nsStringUtf8(L"äöü").GetData());
+    nsStringUtf8 sUmlauts(L"aouÄÖÜäöü");
+    NS_TEST_BOOL(searcher.FindIn(sUmlauts.GetData()) == sUmlauts.GetData() + 9);
+
+    // an empty pattern is never found
+    searcher.SetPattern("");
+    NS_TEST_BOOL(searcher.FindIn(szText) == nullptr);
+
+    // the rarest byte of the pattern is at its end and all other bytes are very common in the text
+    nsStringBuilder sCommon;
+    for (nsUInt32 i = 0; i < 200; ++i)
+    {
+      sCommon.Append("eeee ");
+    }
+    sCommon.Append("eeeez eeee");
+
+    searcher.SetPattern("eee eeeez");
+    NS_TEST_BOOL(searcher.FindIn(sCommon) == sCommon.GetData() + 996);
+    NS_TEST_BOOL(searcher.FindIn(sCommon) == sCommon.GetView().FindSubString("eee eeeez"));
+
+    searcher.SetPattern("eeeeeeeez");
+    NS_TEST_BOOL(searcher.FindIn(sCommon) == nullptr);
+
+    // the text is only searched up to a terminator
+    const char szTerminated[] = "abc\0needle";
+    searcher.SetPattern("needle");
+    NS_TEST_BOOL(searcher.FindIn(nsStringView(szTerminated, szTerminated + 10)) == nullptr);
+  }
+
+  NS_TEST_BLOCK(nsTestBlock::Enabled, "FindIn (case insensitive)")
+  {
+    const char* szText = "There is a NeEdLe in this haystack.";
+
+    nsStringSearcher searcher("nEEDLE", false);
+    NS_TEST_BOOL(searcher.FindIn(szText) == szText + 11);
+    NS_TEST_BOOL(searcher.IsContainedIn("NEEDLE"));
+    NS_TEST_BOOL(!searcher.IsContainedIn("NEEDL"));
+
+    searcher.SetPattern("[@`{", false);
+    NS_TEST_BOOL(!searcher.IsContainedIn("{`@["));
+    NS_TEST_BOOL(searcher.IsContainedIn("x[@`{"));
+
+    // non-ASCII texts and patterns are compared with full Unicode case folding
+    nsStringUtf8 sText(L"Größenänderung");
+    searcher.SetPattern(nsStringUtf8(L"ÖSSEN").GetData(), false);
+    NS_TEST_BOOL(searcher.FindIn(sText.GetData()) == nullptr);
+
+    searcher.SetPattern(nsStringUtf8(L"ÖßEN").GetData(), false);
+    NS_TEST_BOOL(searcher.FindIn(sText.GetData()) == sText.GetData() + 2);
+
+    searcher.SetPattern("ENAN", false);
+    NS_TEST_BOOL(searcher.FindIn(sText.GetData()) == nullptr);
+
+    searcher.SetPattern("ENDERUNG", false);
+    NS_TEST_BOOL(searcher.FindIn(sText.GetData()) == nullptr);
+
+    searcher.SetPattern("DERUNG", false);
+    NS_TEST_BOOL(searcher.FindIn(sText.GetData()) == sText.GetData() + 11);
+  }
+
+  NS_TEST_BLOCK(nsTestBlock::Enabled, "FindIn (random texts)")
+  {
+    nsRandom rnd;
+    rnd.Initialize(0x2545F491);
+    nsStringBuilder sText, sPattern;
+
+    nsStringUtf8 sOUmlaut(L"ö");
+    nsStringUtf8 sOUmlautUpper(L"Ö");
+
+    const char* asciiAlphabet[] = {"a", "b", "c", "A", "B", "C"};
+    const char* unicodeAlphabet[] = {"a", "b", "A", "B", sOUmlaut.GetData(), sOUmlautUpper.GetData()};
+
+    nsStringSearcher searcher;
+
+    for (nsUInt32 i = 0; i < 2000; ++i)
+    {
+      nsArrayPtr<const char* const> alphabet = (i % 2 == 0) ? nsArrayPtr<const char* const>(asciiAlphabet) : nsArrayPtr<const char* const>(unicodeAlphabet);
+
+      BuildSearcherText(rnd, rnd.UIntInRange(300), alphabet, sText);
+      BuildSearcherText(rnd, 1 + rnd.UIntInRange(10), alphabet, sPattern);
+
+      searcher.SetPattern(sPattern, true);
+      NS_TEST_BOOL(searcher.FindIn(sText) == sText.GetView().FindSubString(sPattern));
+
+      searcher.SetPattern(sPattern, false);
+      NS_TEST_BOOL(searcher.FindIn(sText) == sText.GetView().FindSubString_NoCase(sPattern));
+    }
+  }
+}
@@ -1,9 +1,39 @@
 #include <FoundationTest/FoundationTestPCH.h>
 
+#include <Foundation/Math/Random.h>
 #include <Foundation/Strings/String.h>
 
+#include <string_view>
+
 NS_CREATE_SIMPLE_TEST_GROUP(Strings);
 
+namespace
+{
+  void BuildRandomSearchText(nsRandom& ref_rnd, nsUInt32 uiNumCharacters, nsArrayPtr<const char* const> alphabet, nsStringBuilder& out_sText)
+  {
+    out_sText.Clear();
+    for (nsUInt32 i = 0; i < uiNumCharacters; ++i)
+    {
+      out_sText.Append(alphabet[ref_rnd.UIntInRange(alphabet.GetCount())]);
+    }
+  }
+
+  // the straight forward search, that checks every character position
+  const char* FindSubStringReference_NoCase(nsStringView sText, nsStringView sSearch)
+  {
+    const char* pCur = sText.GetStartPointer();
+    while (pCur < sText.GetEndPointer())
+    {
+      if (nsStringUtils::StartsWith_NoCase(pCur, sSearch.GetStartPointer(), sText.GetEndPointer(), sSearch.GetEndPointer()))
+        return pCur;
+
+      nsUnicodeUtils::MoveToNextUtf8(pCur, sText.GetEndPointer()).AssertSuccess();
+    }
+
+    return nullptr;
+  }
+} // namespace
+
 NS_CREATE_SIMPLE_TEST(Strings, StringUtils)
 {
   NS_TEST_BLOCK(nsTestBlock::Enabled, "IsNullOrEmpty")
@@ -877,4 +907,116 @@ NS_CREATE_SIMPLE_TEST(Strings, StringUtils)
     NS_TEST_BOOL(nsStringUtils::IsValidIdentifierName("asdf1"));
     NS_TEST_BOOL(nsStringUtils::IsValidIdentifierName("_asdf"));
   }
+
+  NS_TEST_BLOCK(nsTestBlock::Enabled, "Compare long strings")
+  {
+    // long enough to be compared in several blocks, with differences at every position
+    const nsStringBuilder sLower(nsStringUtf8(L"abcdefghijklmnopqrstuvwxyzöäü0123456789abcdefghijklmnopqrstuvwxyzß-abcdefghijklmnop").GetData());
+    nsStringBuilder sUpper = sLower;
+    sUpper.ToUpper();
+
+    NS_TEST_BOOL(nsStringUtils::IsEqual_NoCase(sLower.GetData(), sUpper.GetData(), sLower.GetData() + sLower.GetElementCount(), sUpper.GetData() + sUpper.GetElementCount()));
+    NS_TEST_BOOL(!nsStringUtils::IsEqual(sLower.GetData(), sUpper.GetData(), sLower.GetData() + sLower.GetElementCount(), sUpper.GetData() + sUpper.GetElementCount()));
+
+    nsStringBuilder sModified;
+    nsUInt32 uiCharacterIndex = 0;
+
+    for (auto it = sLower.GetIteratorFront(); it.IsValid(); ++it, ++uiCharacterIndex)
+    {
+      if (!nsUnicodeUtils::IsASCII(it.GetCharacter()))
+        continue;
+
+      const nsUInt32 uiOffset = static_cast<nsUInt32>(it.GetData() - sLower.GetData());
+
+      sModified = sLower;
+      sModified.ReplaceSubString(sModified.GetData() + uiOffset, sModified.GetData() + uiOffset + 1, "#");
+
+      const char* szModified = sModified.GetData();
+      const char* szModifiedEnd = szModified + sModified.GetElementCount();
+
+      const nsInt32 iExpected = nsStringUtils::CompareChars_NoCase('#', it.GetCharacter());
+      const nsInt32 iResult = nsStringUtils::Compare_NoCase(szModified, sUpper.GetData(), szModifiedEnd, sUpper.GetData() + sUpper.GetElementCount());
+      NS_TEST_BOOL((iExpected < 0) == (iResult < 0) && (iExpected > 0) == (iResult > 0));
+
+      NS_TEST_BOOL(nsStringUtils::IsEqualN_NoCase(szModified, sUpper.GetData(), uiCharacterIndex, szModifiedEnd, sUpper.GetData() + sUpper.GetElementCount()));
+      NS_TEST_BOOL(!nsStringUtils::IsEqualN_NoCase(szModified, sUpper.GetData(), uiCharacterIndex + 1, szModifiedEnd, sUpper.GetData() + sUpper.GetElementCount()));
+
+      NS_TEST_BOOL(nsStringUtils::Compare(szModified, sLower.GetData(), szModifiedEnd, sLower.GetData() + sLower.GetElementCount()) == '#' - static_cast<nsInt32>(it.GetCharacter()));
+      NS_TEST_BOOL(nsStringUtils::IsEqualN(szModified, sLower.GetData(), uiCharacterIndex, szModifiedEnd, sLower.GetData() + sLower.GetElementCount()));
+      NS_TEST_BOOL(!nsStringUtils::IsEqualN(szModified, sLower.GetData(), uiCharacterIndex + 1, szModifiedEnd, sLower.GetData() + sLower.GetElementCount()));
+    }
+
+    // the comparison stops at a terminator before the end pointer
+    char szText1[64] = "0123456789abcdefghijklmnopqrstuvwxyz";
+    char szText2[64] = "0123456789ABCDEFGHIJKLMNOPQRSTUVWXYZ";
+    szText1[20] = '\0';
+    szText2[20] = '\0';
+    szText1[30] = 'x';
+
+    NS_TEST_INT(nsStringUtils::Compare_NoCase(szText1, szText2, szText1 + 64, szText2 + 64), 0);
+    NS_TEST_BOOL(nsStringUtils::IsEqualN_NoCase(szText1, szText2, 40, szText1 + 64, szText2 + 64));
+    NS_TEST_BOOL(nsStringUtils::Compare(szText1, szText2, szText1 + 64, szText2 + 64) > 0);
+
+    szText2[20] = 'k';
+    NS_TEST_BOOL(nsStringUtils::Compare_NoCase(szText1, szText2, szText1 + 64, szText2 + 64) < 0);
+    NS_TEST_BOOL(nsStringUtils::Compare_NoCase(szText2, szText1, szText2 + 64, szText1 + 64) > 0);
+  }
+
+  NS_TEST_BLOCK(nsTestBlock::Enabled, "FindSubString in long texts")
+  {
+    nsRandom rnd;
+    rnd.Initialize(0x9E3779B9);
+    nsStringBuilder sText, sSearch;
+
+    const char* alphabet[] = {"a", "b", "c", "A", "B"};
+
+    for (nsUInt32 i = 0; i < 1000; ++i)
+    {
+      BuildRandomSearchText(rnd, rnd.UIntInRange(200), alphabet, sText);
+      BuildRandomSearchText(rnd, 1 + rnd.UIntInRange(8), alphabet, sSearch);
+
+      const std::string_view text(sText.GetData(), sText.GetElementCount());
+      const size_t uiExpected = text.find(std::string_view(sSearch.GetData(), sSearch.GetElementCount()));
+      const char* szExpected = (uiExpected == std::string_view::npos) ? nullptr : sText.GetData() + uiExpected;
+
+      NS_TEST_BOOL(nsStringUtils::FindSubString(sText.GetData(), sSearch.GetData()) == szExpected);
+      NS_TEST_BOOL(sText.GetView().FindSubString(sSearch) == szExpected);
+    }
+
+    // the search string at every position of a longer text
+    for (nsUInt32 uiPos = 0; uiPos < 100; ++uiPos)
+    {
+      sText = nsStringView("----------------------------------------------------------------------------------------------------", uiPos);
+      sText.Append("Needle-Needle");
+      sText.Append("----------------------------------------------------------------------------------------------------");
+
+      NS_TEST_BOOL(sText.GetView().FindSubString("Needle") == sText.GetData() + uiPos);
+      NS_TEST_BOOL(sText.GetView().FindSubString("needle") == nullptr);
+      NS_TEST_BOOL(sText.GetView().FindSubString_NoCase("nEEDLE") == sText.GetData() + uiPos);
+      NS_TEST_BOOL(sText.GetView().FindSubString_NoCase("nEEDLE-nEEDLE-") == sText.GetData() + uiPos);
+      NS_TEST_BOOL(sText.GetView().FindSubString_NoCase("nEEDLE-nEEDLE--") == sText.GetData() + uiPos);
+      NS_TEST_BOOL(sText.GetView().FindSubString_NoCase("nEEDLE-nEEDLEx") == nullptr);
+    }
+  }
+
+  NS_TEST_BLOCK(nsTestBlock::Enabled, "FindSubString_NoCase in long texts")
+  {
+    nsRandom rnd;
+    rnd.Initialize(0x7F4A7C15);
+    nsStringBuilder sText, sSearch;
+
+    nsStringUtf8 sOUmlaut(L"ö");
+    nsStringUtf8 sOUmlautUpper(L"Ö");
+    nsStringUtf8 sLongS(L"ſ");
+
+    const char* alphabet[] = {"a", "b", "s", "A", "B", "S", sOUmlaut.GetData(), sOUmlautUpper.GetData(), sLongS.GetData()};
+
+    for (nsUInt32 i = 0; i < 1000; ++i)
+    {
+      BuildRandomSearchText(rnd, rnd.UIntInRange(200), alphabet, sText);
+      BuildRandomSearchText(rnd, 1 + rnd.UIntInRange(6), alphabet, sSearch);
+
+      NS_TEST_BOOL(sText.GetView().FindSubString_NoCase(sSearch) == FindSubStringReference_NoCase(sText, sSearch));
+    }
+  }
 }
@@ -796,7 +796,7 @@ NS_CREATE_SIMPLE_TEST(Strings, StringView)
 
   NS_TEST_BLOCK(nsTestBlock::Enabled, "GetSubString")
   {
-    nsStringView s = u8"Пожалуйста, дай мне очень длинные Unicode-стринги!";
+    nsStringView s = (const char*)u8"Пожалуйста, дай мне очень длинные Unicode-стринги!";
 
     NS_TEST_BOOL(s.GetElementCount() > nsStringUtils::GetCharacterCount(s.GetStartPointer(), s.GetEndPointer()));
 
@@ -807,11 +807,11 @@ NS_CREATE_SIMPLE_TEST(Strings, StringView)
     nsStringView w5 = s.GetSubString(34, 20);
     nsStringView w6 = s.GetSubString(100, 10);
 
-    NS_TEST_BOOL(w1 == nsStringView(u8"Пожалуйста"));
-    NS_TEST_BOOL(w2 == nsStringView(u8"дай"));
-    NS_TEST_BOOL(w3 == nsStringView(u8"очень"));
-    NS_TEST_BOOL(w4 == nsStringView(u8"Unicode-стринги"));
-    NS_TEST_BOOL(w5 == nsStringView(u8"Unicode-стринги!"));
+    NS_TEST_BOOL(w1 == nsStringView((const char*)u8"Пожалуйста"));
+    NS_TEST_BOOL(w2 == nsStringView((const char*)u8"дай"));
+    NS_TEST_BOOL(w3 == nsStringView((const char*)u8"очень"));
+    NS_TEST_BOOL(w4 == nsStringView((const char*)u8"Unicode-стринги"));
+    NS_TEST_BOOL(w5 == nsStringView((const char*)u8"Unicode-стринги!"));
     NS_TEST_BOOL(!w6.IsValid());
     NS_TEST_BOOL(w6 == nsStringView(""));
   }
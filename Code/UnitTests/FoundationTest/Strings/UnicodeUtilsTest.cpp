@@ -2,8 +2,43 @@
 
 // NOTE: always save as Unicode UTF-8 with signature
 
+#include <Foundation/Math/Random.h>
 #include <Foundation/Strings/String.h>
 
+namespace
+{
+  // builds a valid string with a mix of ASCII and multi-byte characters of all lengths
+  void BuildRandomUtf8(nsRandom& ref_rnd, nsUInt32 uiNumCharacters, nsDynamicArray<char>& out_utf8)
+  {
+    out_utf8.Clear();
+
+    for (nsUInt32 i = 0; i < uiNumCharacters; ++i)
+    {
+      nsUInt32 uiChar = 0;
+      switch (ref_rnd.UIntInRange(8))
+      {
+        case 0:
+          uiChar = 0x80 + ref_rnd.UIntInRange(0x800 - 0x80);
+          break;
+        case 1:
+          uiChar = 0x800 + ref_rnd.UIntInRange(0xD800 - 0x800);
+          break;
+        case 2:
+          uiChar = 0x10000 + ref_rnd.UIntInRange(0x110000 - 0x10000);
+          break;
+        default:
+          uiChar = 1 + ref_rnd.UIntInRange(0x7F);
+          break;
+      }
+
+      char szBuffer[4];
+      char* pWrite = szBuffer;
+      nsUnicodeUtils::EncodeUtf32ToUtf8(uiChar, pWrite);
+      out_utf8.PushBackRange(nsArrayPtr<const char>(szBuffer, static_cast<nsUInt32>(pWrite - szBuffer)));
+    }
+  }
+} // namespace
+
 NS_CREATE_SIMPLE_TEST(Strings, UnicodeUtils)
 {
   NS_TEST_BLOCK(nsTestBlock::Enabled, "IsASCII")
@@ -304,4 +339,206 @@ NS_CREATE_SIMPLE_TEST(Strings, UnicodeUtils)
     NS_TEST_BOOL(nsUnicodeUtils::IsUtf16Surrogate(szNoSurrogate) == false);
     NS_TEST_BOOL(nsUnicodeUtils::IsUtf16Surrogate(szSurrogate) == true);
   }
+
+  NS_TEST_BLOCK(nsTestBlock::Enabled, "ValidateUtf8")
+  {
+    // clang-format off
+    const char* invalidSequences[] = {
+      "\x80",             // lone continuation byte
+      "\xBF\x80",         // two continuation bytes
+      "\xC3",             // truncated 2 byte sequence
+      "\xE2\x82",         // truncated 3 byte sequence
+      "\xF0\x9F\x98",     // truncated 4 byte sequence
+      "\xC3\xB6\xB6",     // superfluous continuation byte
+      "\xC0\xAF",         // overlong 2 byte sequence
+      "\xC1\xBF",         // overlong 2 byte sequence
+      "\xE0\x80\xAF",     // overlong 3 byte sequence
+      "\xF0\x80\x80\xAF", // overlong 4 byte sequence
+      "\xED\xA0\x80",     // surrogate
+      "\xED\xBF\xBF",     // surrogate
+      "\xF4\x90\x80\x80", // larger than U+10FFFF
+      "\xF5\x80\x80\x80", // invalid lead byte
+      "\xF8\x88\x80\x80\x80",
+      "\xFF",
+      "\xE2\x82\x41",     // ASCII instead of continuation byte
+      "\xC3\xC3\xB6",     // lead byte instead of continuation byte
+    };
+
+    const char* validSequences[] = {
+      "\xC2\x80",
+      "\xDF\xBF",
+      "\xE0\xA0\x80",
+      "\xED\x9F\xBF",
+      "\xEE\x80\x80",
+      "\xEF\xBF\xBF",
+      "\xF0\x90\x80\x80",
+      "\xF4\x8F\xBF\xBF",
+      "\xC3\xB6\xE2\x82\xAC\xF0\x9F\x98\x80",
+    };
+    // clang-format on
+
+    // move the sequences across the 16 byte boundaries that the vectorized version works with, the text is built in a plain array,
+    // because string builders don't accept invalid Utf8
+    const char* szPadding = "abcdefghijklmnopqrstuvwxyzabcdefghijklmnopqrstuvwxyz";
+    nsDynamicArray<char> text;
+
+    auto Validate = [&](const char* szSequence, bool bAppendText)
+    {
+      text.Clear();
+      text.PushBackRange(nsArrayPtr<const char>(szPadding, nsStringUtils::GetStringElementCount(szPadding)));
+      text.PushBackRange(nsArrayPtr<const char>(szSequence, nsStringUtils::GetStringElementCount(szSequence)));
+
+      if (bAppendText)
+        text.PushBackRange(nsArrayPtr<const char>("0123456789abcdefghijklmnopqrstuvwxyz", 36));
+
+      return nsUnicodeUtils::ValidateUtf8(text.GetData(), text.GetData() + text.GetCount());
+    };
+
+    for (nsUInt32 uiPrefix = 0; uiPrefix < 40; ++uiPrefix)
+    {
+      szPadding = "abcdefghijklmnopqrstuvwxyzabcdefghijklmnopqrstuvwxyz" + uiPrefix;
+
+      for (const char* szSequence : invalidSequences)
+      {
+        NS_TEST_BOOL(!Validate(szSequence, false));
+        NS_TEST_BOOL(!Validate(szSequence, true));
+      }
+
+      for (const char* szSequence : validSequences)
+      {
+        NS_TEST_BOOL(Validate(szSequence, false));
+        NS_TEST_BOOL(Validate(szSequence, true));
+      }
+    }
+
+    NS_TEST_BOOL(nsUnicodeUtils::ValidateUtf8(nullptr, nullptr));
+
+    // compare against the scalar implementation on random and randomly damaged strings
+    nsRandom rnd;
+    rnd.Initialize(0x87654321);
+    nsDynamicArray<char> utf8;
+
+    for (nsUInt32 i = 0; i < 2000; ++i)
+    {
+      BuildRandomUtf8(rnd, rnd.UIntInRange(100), utf8);
+
+      const char* pStart = utf8.GetData();
+      const char* pEnd = pStart + utf8.GetCount();
+      NS_TEST_BOOL(nsUnicodeUtils::ValidateUtf8(pStart, pEnd));
+
+      if (utf8.IsEmpty())
+        continue;
+
+      utf8[rnd.UIntInRange(utf8.GetCount())] = static_cast<char>(rnd.UIntInRange(256));
+
+      pStart = utf8.GetData();
+      pEnd = pStart + utf8.GetCount();
+      NS_TEST_BOOL(nsUnicodeUtils::ValidateUtf8(pStart, pEnd) == utf8::is_valid(pStart, pEnd));
+    }
+  }
+
+  NS_TEST_BLOCK(nsTestBlock::Enabled, "SkipAscii")
+  {
+    const char* szText = "abcdefghijklmnopqrstuvwxyz0123456789abcdefghijklmnopqrstuvwxyz\xC3\xB6";
+    const char* szEnd = szText + nsStringUtils::GetStringElementCount(szText);
+
+    for (nsUInt32 i = 0; i <= 62; ++i)
+    {
+      NS_TEST_BOOL(nsUnicodeUtils::SkipAscii(szText + i, szEnd) == szText + 62);
+      NS_TEST_BOOL(nsUnicodeUtils::SkipAscii(szText, szText + i) == szText + i);
+    }
+
+    NS_TEST_BOOL(nsUnicodeUtils::SkipAscii(szEnd, szEnd) == szEnd);
+  }
+
+  NS_TEST_BLOCK(nsTestBlock::Enabled, "CountUtf8Characters")
+  {
+    nsRandom rnd;
+    rnd.Initialize(0x13579BDF);
+    nsDynamicArray<char> utf8;
+
+    for (nsUInt32 i = 0; i < 500; ++i)
+    {
+      const nsUInt32 uiNumCharacters = rnd.UIntInRange(200);
+      BuildRandomUtf8(rnd, uiNumCharacters, utf8);
+
+      NS_TEST_INT(nsUnicodeUtils::CountUtf8Characters(utf8.GetData(), utf8.GetData() + utf8.GetCount()), uiNumCharacters);
+    }
+
+    const char* szText = "a\xC3\xB6\xE2\x82\xAC\xF0\x9F\x98\x80";
+    NS_TEST_INT(nsUnicodeUtils::CountUtf8Characters(szText, szText + 10), 4);
+    NS_TEST_INT(nsUnicodeUtils::CountUtf8Characters(szText, szText + 3), 2);
+    NS_TEST_INT(nsUnicodeUtils::CountUtf8Characters(szText, szText), 0);
+  }
+
+  NS_TEST_BLOCK(nsTestBlock::Enabled, "Bulk transcoding")
+  {
+    nsRandom rnd;
+    rnd.Initialize(0x2468ACE1);
+    nsDynamicArray<char> utf8;
+    nsDynamicArray<nsUInt16> utf16;
+    nsDynamicArray<nsUInt32> utf32;
+    nsDynamicArray<wchar_t> wchar;
+    nsDynamicArray<char> result;
+
+    for (nsUInt32 i = 0; i < 500; ++i)
+    {
+      // every other string is plain ASCII, to exercise the block conversion
+      if (i % 2 == 0)
+      {
+        BuildRandomUtf8(rnd, rnd.UIntInRange(200), utf8);
+      }
+      else
+      {
+        utf8.SetCount(rnd.UIntInRange(200));
+        for (char& c : utf8)
+        {
+          c = static_cast<char>(1 + rnd.UIntInRange(0x7F));
+        }
+      }
+
+      const char* pStart = utf8.GetData();
+      const char* pEnd = pStart + utf8.GetCount();
+      const nsUInt32 uiNumCharacters = nsUnicodeUtils::CountUtf8Characters(pStart, pEnd);
+
+      utf32.SetCountUninitialized(utf8.GetCount());
+      utf32.SetCountUninitialized(nsUnicodeUtils::ConvertUtf8ToUtf32(pStart, pEnd, utf32.GetData()));
+      NS_TEST_INT(utf32.GetCount(), uiNumCharacters);
+
+      bool bUtf32Correct = true;
+      const char* pRead = pStart;
+      for (nsUInt32 uiChar : utf32)
+      {
+        bUtf32Correct &= (uiChar == nsUnicodeUtils::DecodeUtf8ToUtf32(pRead));
+      }
+      NS_TEST_BOOL(bUtf32Correct);
+
+      utf16.SetCountUninitialized(utf8.GetCount());
+      utf16.SetCountUninitialized(nsUnicodeUtils::ConvertUtf8ToUtf16(pStart, pEnd, utf16.GetData()));
+
+      wchar.SetCountUninitialized(utf8.GetCount());
+      wchar.SetCountUninitialized(nsUnicodeUtils::ConvertUtf8ToWChar(pStart, pEnd, wchar.GetData()));
+
+      result.SetCountUninitialized(utf16.GetCount() * 3);
+      result.SetCountUninitialized(nsUnicodeUtils::ConvertUtf16ToUtf8(utf16.GetData(), utf16.GetData() + utf16.GetCount(), result.GetData()));
+      NS_TEST_BOOL(result == utf8);
+
+      result.SetCountUninitialized(utf32.GetCount() * 4);
+      result.SetCountUninitialized(nsUnicodeUtils::ConvertUtf32ToUtf8(utf32.GetData(), utf32.GetData() + utf32.GetCount(), result.GetData()));
+      NS_TEST_BOOL(result == utf8);
+
+      result.SetCountUninitialized(wchar.GetCount() * 4);
+      result.SetCountUninitialized(nsUnicodeUtils::ConvertWCharToUtf8(wchar.GetData(), wchar.GetData() + wchar.GetCount(), result.GetData()));
+      NS_TEST_BOOL(result == utf8);
+    }
+
+    // a truncated sequence at the end is dropped
+    const char* szTruncated = "0123456789abcdef\xE2\x82";
+    nsUInt16 truncated16[32];
+    NS_TEST_INT(nsUnicodeUtils::ConvertUtf8ToUtf16(szTruncated, szTruncated + 18, truncated16), 16);
+
+    const nsUInt16 loneSurrogate[] = {'a', 0xD83D};
+    char truncated8[8];
+    NS_TEST_INT(nsUnicodeUtils::ConvertUtf16ToUtf8(loneSurrogate, loneSurrogate + 2, truncated8), 1);
+  }
 }
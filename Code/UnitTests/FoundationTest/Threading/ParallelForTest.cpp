@@ -221,4 +221,75 @@ NS_CREATE_SIMPLE_TEST(Threading, ParallelFor)
     // check the resulting sum
     NS_TEST_INT(uiNumbersSum, 4 * uiNumbersCheckSum);
   }
+
+  NS_TEST_BLOCK(nsTestBlock::Enabled, "Parallel For (Indexed, Adaptive)")
+  {
+    constexpr nsUInt32 uiStartIndex = 100;
+    constexpr nsUInt32 uiNumItems = 1000;
+
+    nsStaticArray<nsAtomicInteger32, uiNumItems> visited;
+    visited.SetCount(uiNumItems);
+
+    nsParallelForParams adaptiveParams;
+    adaptiveParams.m_uiBinSize = 4;
+    adaptiveParams.m_Splitting = nsParallelForSplitting::Adaptive;
+
+    nsAtomicInteger32 iNumSmallChunks;
+
+    // every item must be handed out exactly once, all chunks but the last one have at least the bin size
+    nsTaskSystem::ParallelForIndexed(
+      uiStartIndex, uiNumItems,
+      [&](nsUInt32 uiFirstIndex, nsUInt32 uiEndIndex)
+      {
+        NS_TEST_BOOL(uiFirstIndex >= uiStartIndex && uiFirstIndex < uiEndIndex && uiEndIndex <= uiStartIndex + uiNumItems);
+
+        if (uiEndIndex - uiFirstIndex < adaptiveParams.m_uiBinSize)
+        {
+          iNumSmallChunks.Increment();
+        }
+
+        for (nsUInt32 uiIndex = uiFirstIndex; uiIndex < uiEndIndex; ++uiIndex)
+        {
+          visited[uiIndex - uiStartIndex].Increment();
+
+          // make the items expensive in a few places
+          if (uiIndex % 100 == 0)
+          {
+            nsThreadUtils::Sleep(nsTime::MakeFromMilliseconds(1));
+          }
+        }
+      },
+      "ParallelForIndexed Adaptive Test", nsTaskNesting::Never, adaptiveParams);
+
+    for (nsUInt32 i = 0; i < uiNumItems; ++i)
+    {
+      NS_TEST_INT(visited[i], 1);
+    }
+
+    NS_TEST_BOOL(iNumSmallChunks <= 1);
+  }
+
+  NS_TEST_BLOCK(nsTestBlock::Enabled, "Parallel For (Array, Single, Index, Adaptive)")
+  {
+    // reset
+    ResetSharedVariables();
+
+    nsParallelForParams adaptiveParams;
+    adaptiveParams.m_uiBinSize = 3;
+    adaptiveParams.m_Splitting = nsParallelForSplitting::Adaptive;
+
+    // test
+    // sum up the numbers and the indices they were handed in with
+    nsTaskSystem::ParallelForSingleIndex(
+      numbers.GetArrayPtr(),
+      [&dataAccessMutex, &uiNumbersSum](nsUInt32 uiIndex, nsUInt32 uiNumber)
+      {
+        NS_LOCK(dataAccessMutex);
+        uiNumbersSum += uiNumber + (uiIndex + 1);
+      },
+      "ParallelFor Array Single Index Adaptive Test", adaptiveParams);
+
+    // check the resulting sum
+    NS_TEST_INT(uiNumbersSum, 2 * uiNumbersCheckSum);
+  }
 }
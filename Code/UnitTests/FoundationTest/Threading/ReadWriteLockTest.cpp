@@ -0,0 +1,279 @@
+#include <FoundationTest/FoundationTestPCH.h>
+
+#include <Foundation/Threading/Lock.h>
+#include <Foundation/Threading/ReadWriteLock.h>
+#include <Foundation/Threading/SeqLock.h>
+#include <Foundation/Threading/Thread.h>
+
+namespace
+{
+  struct SharedState
+  {
+    nsReadWriteLock m_Lock;
+    nsUInt32 m_uiValueA = 0;
+    nsUInt32 m_uiValueB = 0;
+
+    nsAtomicInteger32 m_iActiveReaders;
+    nsAtomicInteger32 m_iMaxActiveReaders;
+    nsAtomicInteger32 m_iInconsistentReads;
+    nsAtomicBool m_bWritersDone;
+  };
+
+  class ReaderThread : public nsThread
+  {
+  public:
+    ReaderThread()
+      : nsThread("Reader Thread")
+    {
+    }
+
+    SharedState* m_pState = nullptr;
+
+    virtual nsUInt32 Run()
+    {
+      while (!m_pState->m_bWritersDone)
+      {
+        NS_LOCK_READ(m_pState->m_Lock);
+
+        m_pState->m_iMaxActiveReaders.Max(m_pState->m_iActiveReaders.Increment());
+
+        if (m_pState->m_uiValueA != m_pState->m_uiValueB)
+        {
+          m_pState->m_iInconsistentReads.Increment();
+        }
+
+        // nested reads are allowed
+        {
+          NS_LOCK_READ(m_pState->m_Lock);
+          nsThreadUtils::YieldHardwareThread();
+        }
+
+        m_pState->m_iActiveReaders.Decrement();
+      }
+
+      return 0;
+    }
+  };
+
+  class WriterThread : public nsThread
+  {
+  public:
+    WriterThread()
+      : nsThread("Writer Thread")
+    {
+    }
+
+    SharedState* m_pState = nullptr;
+
+    virtual nsUInt32 Run()
+    {
+      for (nsUInt32 i = 0; i < 2000; ++i)
+      {
+        NS_LOCK_WRITE(m_pState->m_Lock);
+
+        // no reader may be active while the write lock is held
+        if (m_pState->m_iActiveReaders != 0)
+        {
+          m_pState->m_iInconsistentReads.Increment();
+        }
+
+        ++m_pState->m_uiValueA;
+        nsThreadUtils::YieldHardwareThread();
+        ++m_pState->m_uiValueB;
+      }
+
+      return 0;
+    }
+  };
+
+  struct SeqLockValue
+  {
+    nsUInt32 m_uiValue;
+    nsUInt32 m_uiDouble;
+    nsUInt64 m_uiInverted;
+  };
+
+  class SeqLockReaderThread : public nsThread
+  {
+  public:
+    SeqLockReaderThread()
+      : nsThread("SeqLock Reader Thread")
+    {
+    }
+
+    nsSeqLock<SeqLockValue>* m_pValue = nullptr;
+    nsAtomicBool* m_pWriterDone = nullptr;
+    nsAtomicInteger32* m_pInconsistentReads = nullptr;
+
+    virtual nsUInt32 Run()
+    {
+      nsUInt32 uiLastValue = 0;
+
+      while (!*m_pWriterDone)
+      {
+        const SeqLockValue value = m_pValue->Read();
+
+        if (value.m_uiDouble != value.m_uiValue * 2 || value.m_uiInverted != ~static_cast<nsUInt64>(value.m_uiValue) || value.m_uiValue < uiLastValue)
+        {
+          m_pInconsistentReads->Increment();
+        }
+
+        uiLastValue = value.m_uiValue;
+      }
+
+      return 0;
+    }
+  };
+} // namespace
+
+NS_CREATE_SIMPLE_TEST(Threading, ReadWriteLock)
+{
+  NS_TEST_BLOCK(nsTestBlock::Enabled, "Recursion")
+  {
+    nsReadWriteLock lock;
+    NS_TEST_BOOL(!lock.IsLockedForWriting());
+
+    {
+      NS_LOCK_READ(lock);
+      NS_LOCK_READ(lock);
+      NS_TEST_BOOL(!lock.IsLockedForWriting());
+    }
+
+    {
+      NS_LOCK_WRITE(lock);
+      NS_TEST_BOOL(lock.IsLockedForWriting());
+
+      {
+        NS_LOCK_WRITE(lock);
+        NS_LOCK_READ(lock);
+        NS_TEST_BOOL(lock.IsLockedForWriting());
+      }
+
+      NS_TEST_BOOL(lock.IsLockedForWriting());
+    }
+
+    NS_TEST_BOOL(!lock.IsLockedForWriting());
+
+    // a read lock can be taken again once the writer is gone
+    lock.LockRead();
+    lock.UnlockRead();
+  }
+
+  NS_TEST_BLOCK(nsTestBlock::Enabled, "Read Locks On Several Locks")
+  {
+    // nesting is tracked per lock, the locks may be released in any order
+    nsReadWriteLock locks[4];
+
+    for (nsUInt32 i = 0; i < 8; ++i)
+    {
+      locks[i % 4].LockRead();
+    }
+
+    locks[0].UnlockRead();
+    locks[2].UnlockRead();
+    locks[3].UnlockRead();
+    locks[1].UnlockRead();
+    locks[0].UnlockRead();
+    locks[3].UnlockRead();
+    locks[1].UnlockRead();
+    locks[2].UnlockRead();
+
+    for (nsReadWriteLock& lock : locks)
+    {
+      NS_LOCK_WRITE(lock);
+      NS_TEST_BOOL(lock.IsLockedForWriting());
+    }
+  }
+
+  NS_TEST_BLOCK(nsTestBlock::Enabled, "Readers and Writers")
+  {
+    SharedState state;
+
+    ReaderThread readers[4];
+    WriterThread writers[2];
+
+    for (ReaderThread& reader : readers)
+    {
+      reader.m_pState = &state;
+      reader.Start();
+    }
+
+    for (WriterThread& writer : writers)
+    {
+      writer.m_pState = &state;
+      writer.Start();
+    }
+
+    for (WriterThread& writer : writers)
+    {
+      writer.Join();
+    }
+
+    state.m_bWritersDone = true;
+
+    for (ReaderThread& reader : readers)
+    {
+      reader.Join();
+    }
+
+    NS_TEST_INT(state.m_uiValueA, 2 * 2000);
+    NS_TEST_INT(state.m_uiValueB, 2 * 2000);
+    NS_TEST_INT(state.m_iInconsistentReads, 0);
+    NS_TEST_INT(state.m_iActiveReaders, 0);
+    NS_TEST_BOOL(state.m_iMaxActiveReaders >= 1);
+    NS_TEST_BOOL(!state.m_Lock.IsLockedForWriting());
+  }
+}
+
+NS_CREATE_SIMPLE_TEST(Threading, SeqLock)
+{
+  NS_TEST_BLOCK(nsTestBlock::Enabled, "Read and Write")
+  {
+    nsSeqLock<SeqLockValue> value(SeqLockValue{1, 2, ~1ull});
+    NS_TEST_INT(value.Read().m_uiDouble, 2);
+
+    value.Write(SeqLockValue{3, 6, ~3ull});
+    NS_TEST_INT(value.Read().m_uiValue, 3);
+
+    value.Modify([](SeqLockValue& ref_value)
+      {
+        ++ref_value.m_uiValue;
+        ref_value.m_uiDouble = ref_value.m_uiValue * 2;
+        ref_value.m_uiInverted = ~static_cast<nsUInt64>(ref_value.m_uiValue);
+      });
+
+    NS_TEST_INT(value.Read().m_uiValue, 4);
+    NS_TEST_INT(value.Read().m_uiDouble, 8);
+  }
+
+  NS_TEST_BLOCK(nsTestBlock::Enabled, "Concurrent Readers")
+  {
+    nsSeqLock<SeqLockValue> value(SeqLockValue{0, 0, ~0ull});
+    nsAtomicBool bWriterDone;
+    nsAtomicInteger32 iInconsistentReads;
+
+    SeqLockReaderThread readers[4];
+    for (SeqLockReaderThread& reader : readers)
+    {
+      reader.m_pValue = &value;
+      reader.m_pWriterDone = &bWriterDone;
+      reader.m_pInconsistentReads = &iInconsistentReads;
+      reader.Start();
+    }
+
+    for (nsUInt32 i = 1; i <= 100000; ++i)
+    {
+      value.Write(SeqLockValue{i, i * 2, ~static_cast<nsUInt64>(i)});
+    }
+
+    bWriterDone = true;
+
+    for (SeqLockReaderThread& reader : readers)
+    {
+      reader.Join();
+    }
+
+    NS_TEST_INT(iInconsistentReads, 0);
+    NS_TEST_INT(value.Read().m_uiValue, 100000);
+  }
+}
@@ -0,0 +1,120 @@
+#include <FoundationTest/FoundationTestPCH.h>
+
+#include <Foundation/Threading/TaskCoroutine.h>
+#include <Foundation/Threading/Thread.h>
+
+#if NS_ENABLED(NS_TASK_COROUTINES)
+
+namespace
+{
+  nsTaskCoroutine<nsInt32> Add(nsInt32 a, nsInt32 b)
+  {
+    co_return a + b;
+  }
+
+  nsTaskCoroutine<nsInt32> AddThreeTimes(nsInt32 iValue)
+  {
+    nsInt32 iResult = co_await Add(iValue, 1);
+    iResult = co_await Add(iResult, 2);
+    iResult = co_await Add(iResult, 3);
+    co_return iResult;
+  }
+
+  nsTaskCoroutine<> AwaitSlowTask(nsAtomicInteger32& ref_iCounter)
+  {
+    nsTaskGroupID group = nsTaskSystem::StartSingleTask("Slow Task", nsTaskPriority::ThisFrame,
+      [&ref_iCounter]()
+      {
+        nsThreadUtils::Sleep(nsTime::MakeFromMilliseconds(20));
+        ref_iCounter.Increment();
+      });
+
+    co_await group;
+
+    // the group has finished, so its task must have run
+    NS_TEST_INT(ref_iCounter, 1);
+    ref_iCounter.Increment();
+  }
+
+  nsTaskCoroutine<bool> ContinueOnMainThread()
+  {
+    co_await nsResumeOnTaskSystem(nsTaskPriority::ThisFrameMainThread);
+    co_return nsThreadUtils::IsMainThread();
+  }
+
+  nsTaskCoroutine<nsInt32> AwaitMainThreadCoroutine()
+  {
+    const bool bChildOnMainThread = co_await ContinueOnMainThread();
+
+    // the child moved itself to the main thread, this coroutine must still continue with its own priority
+    co_return (bChildOnMainThread ? 1 : 0) + (nsThreadUtils::IsMainThread() ? 2 : 0);
+  }
+} // namespace
+
+NS_CREATE_SIMPLE_TEST(Threading, TaskCoroutine)
+{
+  NS_TEST_BLOCK(nsTestBlock::Enabled, "Lazy Start")
+  {
+    nsTaskCoroutine<nsInt32> c = Add(3, 4);
+    NS_TEST_BOOL(!c.IsStarted());
+    NS_TEST_BOOL(!c.IsFinished());
+
+    c.Wait();
+
+    NS_TEST_BOOL(c.IsFinished());
+    NS_TEST_INT(c.GetResult(), 7);
+  }
+
+  NS_TEST_BLOCK(nsTestBlock::Enabled, "Await Coroutines")
+  {
+    nsTaskCoroutine<nsInt32> c = AddThreeTimes(10);
+    c.Start(nsTaskPriority::LateThisFrame);
+    c.Wait();
+
+    NS_TEST_INT(c.GetResult(), 16);
+  }
+
+  NS_TEST_BLOCK(nsTestBlock::Enabled, "Await Task Group")
+  {
+    nsAtomicInteger32 iCounter;
+
+    nsTaskCoroutine<> c = AwaitSlowTask(iCounter);
+    c.Start();
+    c.Wait();
+
+    NS_TEST_INT(iCounter, 2);
+  }
+
+  NS_TEST_BLOCK(nsTestBlock::Enabled, "Resume On Main Thread")
+  {
+    nsTaskCoroutine<bool> c = ContinueOnMainThread();
+    c.Start(nsTaskPriority::LongRunning);
+
+    // main thread tasks are executed at the end of the frame
+    for (nsUInt32 i = 0; i < 100 && !c.IsFinished(); ++i)
+    {
+      nsTaskSystem::FinishFrameTasks();
+      nsThreadUtils::Sleep(nsTime::MakeFromMilliseconds(1));
+    }
+
+    NS_TEST_BOOL(c.IsFinished());
+    NS_TEST_BOOL(c.GetResult());
+  }
+
+  NS_TEST_BLOCK(nsTestBlock::Enabled, "Continuation Keeps Priority")
+  {
+    nsTaskCoroutine<nsInt32> c = AwaitMainThreadCoroutine();
+    c.Start(nsTaskPriority::LongRunning);
+
+    for (nsUInt32 i = 0; i < 100 && !c.IsFinished(); ++i)
+    {
+      nsTaskSystem::FinishFrameTasks();
+      nsThreadUtils::Sleep(nsTime::MakeFromMilliseconds(1));
+    }
+
+    NS_TEST_BOOL(c.IsFinished());
+    NS_TEST_INT(c.GetResult(), 1);
+  }
+}
+
+#endif
@@ -2,9 +2,15 @@
 
 #include <Foundation/IO/FileSystem/DataDirTypeFolder.h>
 #include <Foundation/IO/FileSystem/FileWriter.h>
+#include <Foundation/System/SystemInformation.h>
+#include <Foundation/Threading/DelegateTask.h>
+#include <Foundation/Threading/Implementation/TaskAllocator.h>
+#include <Foundation/Threading/TaskGraph.h>
 #include <Foundation/Threading/TaskSystem.h>
+#include <Foundation/Threading/Thread.h>
 #include <Foundation/Time/Time.h>
 #include <Foundation/Utilities/DGMLWriter.h>
+#include <TestFramework/Utilities/TestLogInterface.h>
 
 class nsTestTask final : public nsTask
 {
@@ -76,6 +82,95 @@ public:
   nsAtomicInteger32* m_pInt;
 };
 
+// records in which order the tasks of a task graph were executed
+class nsTaskGraphTestTask final : public nsTask
+{
+public:
+  nsTaskGraphTestTask(const char* szName, nsAtomicInteger32* pCounter)
+    : m_pCounter(pCounter)
+  {
+    ConfigureTask(szName, nsTaskNesting::Never);
+  }
+
+  // the position of the last run of this task in the execution order
+  mutable nsAtomicInteger32 m_iOrder;
+  mutable nsAtomicInteger32 m_iNumRuns;
+  nsUInt32 m_uiSleepMS = 0;
+
+private:
+  nsAtomicInteger32* m_pCounter;
+
+  void Record() const
+  {
+    if (m_uiSleepMS > 0)
+      nsThreadUtils::Sleep(nsTime::MakeFromMilliseconds(m_uiSleepMS));
+
+    m_iNumRuns.Increment();
+    m_iOrder.Max(m_pCounter->Increment());
+  }
+
+  virtual void Execute() override { Record(); }
+  virtual void ExecuteWithMultiplicity(nsUInt32 uiInvocation) const override { Record(); }
+};
+
+static nsAtomicInteger32 s_iNumSmallTasksExecuted;
+
+static void ExecuteSmallTask()
+{
+  s_iNumSmallTasksExecuted.Increment();
+}
+
+// a thread that is not managed by the task system, its tasks go through the injection queues
+class nsTaskSpawningThread : public nsThread
+{
+public:
+  nsTaskSpawningThread()
+    : nsThread("Task Spawning Thread")
+  {
+  }
+
+private:
+  virtual nsUInt32 Run() override
+  {
+    nsTaskGroupID group = nsTaskSystem::CreateTaskGroup(nsTaskPriority::ThisFrame);
+
+    for (nsUInt32 i = 0; i < 100; ++i)
+    {
+      nsTaskSystem::AddTaskToGroup(group, NS_DEFAULT_NEW(nsDelegateTask<void>, "Small Task", nsTaskNesting::Never, &ExecuteSmallTask));
+    }
+
+    nsTaskSystem::StartTaskGroup(group);
+    nsTaskSystem::WaitForGroup(group);
+    return 0;
+  }
+};
+
+// frees task memory on another thread, whose cache has to be returned to the pool when it exits
+class nsTaskFreeingThread : public nsThread
+{
+public:
+  nsTaskFreeingThread(nsAllocator* pAllocator, nsArrayPtr<void*> blocks)
+    : nsThread("Task Freeing Thread")
+    , m_pAllocator(pAllocator)
+    , m_Blocks(blocks)
+  {
+  }
+
+private:
+  virtual nsUInt32 Run() override
+  {
+    for (void* pBlock : m_Blocks)
+    {
+      m_pAllocator->Deallocate(pBlock);
+    }
+
+    return 0;
+  }
+
+  nsAllocator* m_pAllocator;
+  nsArrayPtr<void*> m_Blocks;
+};
+
 NS_CREATE_SIMPLE_TEST(Threading, TaskSystem)
 {
   nsInt8 iWorkersShort = 4;
@@ -374,6 +469,67 @@ NS_CREATE_SIMPLE_TEST(Threading, TaskSystem)
     }
   }
 
+  NS_TEST_BLOCK(nsTestBlock::Enabled, "Tasks with Deadlines")
+  {
+    nsAtomicInteger32 iCounter;
+    const nsTime tNow = nsTime::Now();
+    const nsTaskDeadlineStats statsBefore = nsTaskSystem::GetTaskDeadlineStats();
+
+    nsSharedPtr<nsTaskGraphTestTask> tNoDeadline = NS_DEFAULT_NEW(nsTaskGraphTestTask, "No Deadline Task", &iCounter);
+
+    // the task with the latest deadline has to be started second, because it takes so long
+    nsSharedPtr<nsTaskGraphTestTask> tExpensive = NS_DEFAULT_NEW(nsTaskGraphTestTask, "Expensive Deadline Task", &iCounter);
+    tExpensive->SetDeadline(tNow + nsTime::MakeFromSeconds(20));
+    tExpensive->SetEstimatedCost(nsTime::MakeFromSeconds(15));
+    NS_TEST_BOOL(tExpensive->GetDeadline() == tNow + nsTime::MakeFromSeconds(20));
+    NS_TEST_BOOL(tExpensive->GetEstimatedCost() == nsTime::MakeFromSeconds(15));
+
+    nsSharedPtr<nsTaskGraphTestTask> t[4];
+    for (nsUInt32 i = 0; i < 4; ++i)
+    {
+      t[i] = NS_DEFAULT_NEW(nsTaskGraphTestTask, "Deadline Task", &iCounter);
+      t[i]->SetDeadline(tNow + nsTime::MakeFromSeconds(10.0 - 2.0 * i));
+      t[i]->m_uiSleepMS = 1;
+    }
+
+    // main thread tasks only get executed in FinishFrameTasks(), so they are all queued before the first one runs
+    nsTaskSystem::StartSingleTask(tNoDeadline, nsTaskPriority::ThisFrameMainThread);
+    nsTaskSystem::StartSingleTask(tExpensive, nsTaskPriority::ThisFrameMainThread);
+
+    for (nsUInt32 i = 0; i < 4; ++i)
+    {
+      nsTaskSystem::StartSingleTask(t[i], nsTaskPriority::ThisFrameMainThread);
+    }
+
+    nsTaskSystem::FinishFrameTasks();
+
+    NS_TEST_INT(t[3]->m_iOrder, 1);
+    NS_TEST_INT(tExpensive->m_iOrder, 2);
+    NS_TEST_INT(t[2]->m_iOrder, 3);
+    NS_TEST_INT(t[1]->m_iOrder, 4);
+    NS_TEST_INT(t[0]->m_iOrder, 5);
+    NS_TEST_INT(tNoDeadline->m_iOrder, 6);
+
+    const nsTaskDeadlineStats statsMet = nsTaskSystem::GetTaskDeadlineStats();
+    NS_TEST_INT(statsMet.m_uiNumExecuted - statsBefore.m_uiNumExecuted, 5);
+    NS_TEST_INT(statsMet.m_uiNumMissed - statsBefore.m_uiNumMissed, 0);
+
+    // the cost is learned from the previous runs
+    NS_TEST_BOOL(nsTaskSystem::GetEstimatedTaskCost("Deadline Task") >= nsTime::MakeFromMilliseconds(0.5));
+    NS_TEST_BOOL(nsTaskSystem::GetEstimatedTaskCost("No Deadline Task").IsZero());
+
+    nsSharedPtr<nsTaskGraphTestTask> tLate = NS_DEFAULT_NEW(nsTaskGraphTestTask, "Late Deadline Task", &iCounter);
+    tLate->SetDeadline(nsTime::Now() + nsTime::MakeFromMilliseconds(1));
+    tLate->m_uiSleepMS = 5;
+
+    nsTaskSystem::StartSingleTask(tLate, nsTaskPriority::ThisFrameMainThread);
+    nsTaskSystem::FinishFrameTasks();
+
+    const nsTaskDeadlineStats statsMissed = nsTaskSystem::GetTaskDeadlineStats();
+    NS_TEST_INT(statsMissed.m_uiNumExecuted - statsMet.m_uiNumExecuted, 1);
+    NS_TEST_INT(statsMissed.m_uiNumMissed - statsMet.m_uiNumMissed, 1);
+  }
+
   NS_TEST_BLOCK(nsTestBlock::Enabled, "Canceling Tasks")
   {
     const nsUInt32 uiNumTasks = 20;
@@ -550,6 +706,420 @@ NS_CREATE_SIMPLE_TEST(Threading, TaskSystem)
     NS_TEST_BOOL(t[2]->IsMultiplicityDone());
   }
 
+  NS_TEST_BLOCK(nsTestBlock::Enabled, "Tasks Started From Different Threads")
+  {
+    // tasks get queued on the main thread, on worker threads and on a foreign thread and have to be picked up by whoever is idle
+    s_iNumSmallTasksExecuted = 0;
+
+    nsTaskSpawningThread spawningThread;
+    spawningThread.Start();
+
+    nsTaskGroupID group = nsTaskSystem::CreateTaskGroup(nsTaskPriority::ThisFrame);
+
+    for (nsUInt32 i = 0; i < 50; ++i)
+    {
+      auto spawnTasks = []()
+      {
+        nsTaskGroupID subGroup = nsTaskSystem::CreateTaskGroup(nsTaskPriority::ThisFrame);
+
+        for (nsUInt32 j = 0; j < 20; ++j)
+        {
+          nsTaskSystem::AddTaskToGroup(subGroup, NS_DEFAULT_NEW(nsDelegateTask<void>, "Small Task", nsTaskNesting::Never, &ExecuteSmallTask));
+        }
+
+        nsTaskSystem::StartTaskGroup(subGroup);
+        nsTaskSystem::WaitForGroup(subGroup);
+
+        ExecuteSmallTask();
+      };
+
+      nsTaskSystem::AddTaskToGroup(group, NS_DEFAULT_NEW(nsDelegateTask<void>, "Spawning Task", nsTaskNesting::Maybe, spawnTasks));
+    }
+
+    nsTaskSystem::StartTaskGroup(group);
+    nsTaskSystem::WaitForGroup(group);
+
+    spawningThread.Join();
+
+    NS_TEST_INT(s_iNumSmallTasksExecuted, 50 * 21 + 100);
+  }
+
+  NS_TEST_BLOCK(nsTestBlock::Enabled, "In N Frames Tasks")
+  {
+    // keep all short task workers busy, so that only FinishFrameTasks() executes the frame tasks
+    nsAtomicInteger32 iNumBlockersStarted;
+    nsAtomicBool bReleaseBlockers;
+
+    auto blockWorker = [&]()
+    {
+      iNumBlockersStarted.Increment();
+
+      while (!bReleaseBlockers)
+      {
+        nsThreadUtils::YieldTimeSlice();
+      }
+    };
+
+    nsTaskGroupID blockers = nsTaskSystem::CreateTaskGroup(nsTaskPriority::ThisFrame);
+    for (nsInt32 i = 0; i < iWorkersShort; ++i)
+    {
+      nsTaskSystem::AddTaskToGroup(blockers, NS_DEFAULT_NEW(nsDelegateTask<void>, "Blocker", nsTaskNesting::Never, blockWorker));
+    }
+    nsTaskSystem::StartTaskGroup(blockers);
+
+    while (iNumBlockersStarted < iWorkersShort)
+    {
+      nsThreadUtils::YieldTimeSlice();
+    }
+
+    // t[i] is due i frames from now
+    nsSharedPtr<nsTestTask> t[10];
+    for (nsUInt32 i = 0; i < 10; ++i)
+    {
+      t[i] = NS_DEFAULT_NEW(nsTestTask);
+      t[i]->m_uiIterations = 1;
+    }
+
+    nsTaskSystem::StartSingleTask(t[0], nsTaskPriority::ThisFrame);
+    nsTaskSystem::StartSingleTask(t[1], nsTaskPriority::NextFrame);
+    for (nsUInt32 i = 2; i < 10; ++i)
+    {
+      nsTaskSystem::StartSingleTask(t[i], static_cast<nsTaskPriority::Enum>(nsTaskPriority::In2Frames + i - 2));
+    }
+
+    for (nsUInt32 uiFrame = 0; uiFrame < 10; ++uiFrame)
+    {
+      nsTaskSystem::FinishFrameTasks();
+
+      for (nsUInt32 i = 0; i < 10; ++i)
+      {
+        NS_TEST_BOOL(t[i]->IsTaskFinished() == (i <= uiFrame));
+      }
+    }
+
+    bReleaseBlockers = true;
+    nsTaskSystem::WaitForGroup(blockers);
+  }
+
+  NS_TEST_BLOCK(nsTestBlock::Enabled, "Task Allocator")
+  {
+    nsTaskAllocator allocator("TaskAllocatorTest", nsFoundation::GetAlignedAllocator());
+
+    // one slab holds 512 blocks of the smallest size
+    nsDynamicArray<void*> blocks;
+    blocks.SetCount(1024);
+
+    auto allocateAndFree = [&]()
+    {
+      for (nsUInt32 i = 0; i < blocks.GetCount(); ++i)
+      {
+        blocks[i] = allocator.Allocate(64 + (i % 4) * 100, 8);
+      }
+
+      for (void* pBlock : blocks)
+      {
+        allocator.Deallocate(pBlock);
+      }
+    };
+
+    allocateAndFree();
+    const nsTaskAllocatorStats statsBefore = allocator.GetPoolStats();
+    NS_TEST_BOOL(statsBefore.m_uiNumSlabAllocations > 0);
+    NS_TEST_INT(statsBefore.m_uiNumLargeAllocations, 0);
+
+    // from now on, all blocks are recycled
+    for (nsUInt32 i = 0; i < 100; ++i)
+    {
+      allocateAndFree();
+    }
+
+    const nsTaskAllocatorStats statsAfter = allocator.GetPoolStats();
+    NS_TEST_INT(statsAfter.m_uiNumSlabAllocations, statsBefore.m_uiNumSlabAllocations);
+    NS_TEST_INT(statsAfter.m_uiReservedMemory, statsBefore.m_uiReservedMemory);
+    NS_TEST_INT(statsAfter.m_uiNumLargeAllocations, 0);
+
+    void* pLarge = allocator.Allocate(4000, 8);
+    void* pAligned = allocator.Allocate(64, 64);
+    NS_TEST_BOOL(nsMemoryUtils::IsAligned(pAligned, 64));
+    allocator.Deallocate(pLarge);
+    allocator.Deallocate(pAligned);
+    NS_TEST_INT(allocator.GetPoolStats().m_uiNumLargeAllocations, 2);
+  }
+
+  NS_TEST_BLOCK(nsTestBlock::Enabled, "Task Allocator Thread Exit")
+  {
+    nsTaskAllocator allocator("TaskAllocatorTest", nsFoundation::GetAlignedAllocator());
+
+    // exactly two slabs, so any block that stays in the cache of the other thread would require a third one
+    nsDynamicArray<void*> blocks;
+    blocks.SetCount(1024);
+
+    for (void*& pBlock : blocks)
+    {
+      pBlock = allocator.Allocate(64, 8);
+    }
+
+    const nsTaskAllocatorStats statsBefore = allocator.GetPoolStats();
+    NS_TEST_INT(statsBefore.m_uiNumSlabAllocations, 2);
+
+    nsTaskFreeingThread thread(&allocator, blocks.GetArrayPtr());
+    thread.Start();
+    thread.Join();
+
+    for (void*& pBlock : blocks)
+    {
+      pBlock = allocator.Allocate(64, 8);
+    }
+
+    NS_TEST_INT(allocator.GetPoolStats().m_uiNumSlabAllocations, 2);
+
+    for (void* pBlock : blocks)
+    {
+      allocator.Deallocate(pBlock);
+    }
+  }
+
+  NS_TEST_BLOCK(nsTestBlock::Enabled, "Task Allocator Several Pools")
+  {
+    // every pool has its own thread cache, so using one doesn't evict the blocks of the other
+    nsTaskAllocator allocatorA("TaskAllocatorTestA", nsFoundation::GetAlignedAllocator());
+
+    nsDynamicArray<void*> blocksA;
+    nsDynamicArray<void*> blocksB;
+
+    {
+      nsTaskAllocator allocatorB("TaskAllocatorTestB", nsFoundation::GetAlignedAllocator());
+
+      for (nsUInt32 uiRound = 0; uiRound < 10; ++uiRound)
+      {
+        for (nsUInt32 i = 0; i < 100; ++i)
+        {
+          blocksA.PushBack(allocatorA.Allocate(64, 8));
+          blocksB.PushBack(allocatorB.Allocate(64, 8));
+        }
+
+        for (nsUInt32 i = 0; i < 100; ++i)
+        {
+          allocatorA.Deallocate(blocksA.PeekBack());
+          blocksA.PopBack();
+          allocatorB.Deallocate(blocksB.PeekBack());
+          blocksB.PopBack();
+        }
+      }
+
+      NS_TEST_INT(allocatorA.GetPoolStats().m_uiNumSlabAllocations, 1);
+      NS_TEST_INT(allocatorB.GetPoolStats().m_uiNumSlabAllocations, 1);
+    }
+
+    // a new pool may get the slot of the destroyed one, the blocks that are still cached for it must not be handed out
+    nsTaskAllocator allocatorC("TaskAllocatorTestC", nsFoundation::GetAlignedAllocator());
+    void* pBlockC = allocatorC.Allocate(64, 8);
+    NS_TEST_INT(allocatorC.GetPoolStats().m_uiNumSlabAllocations, 1);
+    allocatorC.Deallocate(pBlockC);
+
+    void* pBlockA = allocatorA.Allocate(64, 8);
+    allocatorA.Deallocate(pBlockA);
+    NS_TEST_INT(allocatorA.GetPoolStats().m_uiNumSlabAllocations, 1);
+  }
+
+  NS_TEST_BLOCK(nsTestBlock::Enabled, "Pooled Tasks")
+  {
+    nsAtomicInteger32 iNumExecuted;
+
+    nsParallelForParams params;
+    params.m_uiBinSize = 10;
+
+    const nsTaskAllocatorStats statsBefore = nsTaskSystem::GetTaskAllocatorStats();
+
+    for (nsUInt32 uiFrame = 0; uiFrame < 10; ++uiFrame)
+    {
+      nsTaskSystem::ParallelForIndexed(
+        0u, 100u, [&iNumExecuted](nsUInt32 uiStartIndex, nsUInt32 uiEndIndex)
+        { iNumExecuted.Add(static_cast<nsInt32>(uiEndIndex - uiStartIndex)); },
+        "Pooled ParallelFor", nsTaskNesting::Never, params);
+
+      nsTaskSystem::WaitForGroup(nsTaskSystem::StartSingleTask("Pooled Task", nsTaskPriority::ThisFrame, [&iNumExecuted]()
+        { iNumExecuted.Increment(); }));
+    }
+
+    NS_TEST_INT(iNumExecuted, 10 * (100 + 1));
+
+    // the task objects are small enough for the pool
+    NS_TEST_INT(nsTaskSystem::GetTaskAllocatorStats().m_uiNumLargeAllocations, statsBefore.m_uiNumLargeAllocations);
+  }
+
+  NS_TEST_BLOCK(nsTestBlock::Enabled, "Task Graph")
+  {
+    nsAtomicInteger32 iCounter;
+
+    nsSharedPtr<nsTaskGraphTestTask> tA = NS_DEFAULT_NEW(nsTaskGraphTestTask, "A", &iCounter);
+    nsSharedPtr<nsTaskGraphTestTask> tB = NS_DEFAULT_NEW(nsTaskGraphTestTask, "B", &iCounter);
+    nsSharedPtr<nsTaskGraphTestTask> tC = NS_DEFAULT_NEW(nsTaskGraphTestTask, "C", &iCounter);
+    nsSharedPtr<nsTaskGraphTestTask> tD = NS_DEFAULT_NEW(nsTaskGraphTestTask, "D", &iCounter);
+    tC->SetMultiplicity(4);
+
+    // A -> (B, C) -> D
+    nsTaskGraph graph;
+    const nsTaskGraph::NodeIndex a = graph.AddNode(tA);
+    const nsTaskGraph::NodeIndex b = graph.AddNode(tB, nsTaskPriority::LateThisFrame);
+    const nsTaskGraph::NodeIndex c = graph.AddNode(tC);
+    const nsTaskGraph::NodeIndex d = graph.AddNode(tD, nsTaskPriority::EarlyThisFrame);
+    graph.AddDependency(b, a);
+    graph.AddDependency(c, a);
+    graph.AddDependency(d, b);
+    graph.AddDependency(d, c);
+
+    NS_TEST_BOOL(!graph.IsFinalized());
+    NS_TEST_BOOL(graph.Finalize().Succeeded());
+    NS_TEST_BOOL(graph.IsFinalized());
+
+    for (nsInt32 iExecution = 1; iExecution <= 20; ++iExecution)
+    {
+      const nsTaskGroupID id = graph.Execute();
+      NS_TEST_BOOL(id == graph.GetExecutionID());
+
+      nsTaskSystem::WaitForGroup(id);
+
+      NS_TEST_BOOL(!graph.IsExecuting());
+      NS_TEST_INT(tA->m_iNumRuns, iExecution);
+      NS_TEST_INT(tB->m_iNumRuns, iExecution);
+      NS_TEST_INT(tC->m_iNumRuns, iExecution * 4);
+      NS_TEST_INT(tD->m_iNumRuns, iExecution);
+
+      NS_TEST_BOOL(tA->m_iOrder < tB->m_iOrder);
+      NS_TEST_BOOL(tA->m_iOrder < tC->m_iOrder);
+      NS_TEST_BOOL(tB->m_iOrder < tD->m_iOrder);
+      NS_TEST_BOOL(tC->m_iOrder < tD->m_iOrder);
+    }
+
+    // regular task groups can depend on the execution of a graph
+    {
+      nsSharedPtr<nsTaskGraphTestTask> tE = NS_DEFAULT_NEW(nsTaskGraphTestTask, "E", &iCounter);
+
+      const nsTaskGroupID id = graph.Execute();
+      const nsTaskGroupID other = nsTaskSystem::StartSingleTask(tE, nsTaskPriority::ThisFrame, id);
+
+      nsTaskSystem::WaitForGroup(other);
+
+      NS_TEST_BOOL(nsTaskSystem::IsTaskGroupFinished(id));
+      NS_TEST_BOOL(tD->m_iOrder < tE->m_iOrder);
+    }
+
+    // a task that gets canceled before it is scheduled is skipped, the nodes depending on it still run
+    {
+      tA->m_uiSleepMS = 50;
+      const nsInt32 iRunsC = tC->m_iNumRuns;
+      const nsInt32 iRunsD = tD->m_iNumRuns;
+
+      const nsTaskGroupID id = graph.Execute();
+      NS_TEST_BOOL(nsTaskSystem::CancelTask(tC, nsOnTaskRunning::ReturnWithoutBlocking).Succeeded());
+
+      nsTaskSystem::WaitForGroup(id);
+      tA->m_uiSleepMS = 0;
+
+      NS_TEST_INT(tC->m_iNumRuns, iRunsC);
+      NS_TEST_INT(tD->m_iNumRuns, iRunsD + 1);
+    }
+
+    nsDGMLGraph dgml;
+    graph.WriteToDGML(dgml);
+
+    nsStringBuilder sDGML;
+    NS_TEST_BOOL(nsDGMLGraphWriter::WriteGraphToString(sDGML, dgml).Succeeded());
+    NS_TEST_BOOL(sDGML.FindSubString("LateThisFrame") != nullptr);
+  }
+
+  NS_TEST_BLOCK(nsTestBlock::Enabled, "Task Graph With Cycle")
+  {
+    nsAtomicInteger32 iCounter;
+
+    nsTaskGraph graph;
+    const nsTaskGraph::NodeIndex a = graph.AddNode(NS_DEFAULT_NEW(nsTaskGraphTestTask, "A", &iCounter));
+    const nsTaskGraph::NodeIndex b = graph.AddNode(NS_DEFAULT_NEW(nsTaskGraphTestTask, "B", &iCounter));
+    const nsTaskGraph::NodeIndex c = graph.AddNode(NS_DEFAULT_NEW(nsTaskGraphTestTask, "C", &iCounter));
+    graph.AddDependency(b, a);
+    graph.AddDependency(c, b);
+    graph.AddDependency(b, c);
+
+    nsTestLogInterface log;
+    nsTestLogSystemScope logSystemScope(&log);
+    log.ExpectMessage("The dependencies of the task graph contain a cycle", nsLogMsgType::ErrorMsg);
+
+    NS_TEST_BOOL(graph.Finalize().Failed());
+    NS_TEST_BOOL(!graph.IsFinalized());
+  }
+
+  NS_TEST_BLOCK(nsTestBlock::Enabled, "Worker Thread Placement")
+  {
+    const nsCpuTopology& topology = nsSystemInformation::Get().GetCpuTopology();
+
+    NS_TEST_BOOL(topology.m_uiNumLogicalProcessors >= 1);
+    NS_TEST_BOOL(topology.m_uiNumCores >= 1 && topology.m_uiNumCores <= topology.m_uiNumLogicalProcessors);
+    NS_TEST_BOOL(topology.m_uiNumCacheDomains >= 1 && topology.m_uiNumCacheDomains <= topology.m_uiNumCores);
+    NS_TEST_BOOL(topology.m_uiNumPackages >= 1 && topology.m_uiNumPackages <= topology.m_uiNumCacheDomains);
+
+    for (nsUInt32 i = 0; i < topology.m_uiNumLogicalProcessors; ++i)
+    {
+      const nsCpuTopology::LogicalProcessor& lp = topology.m_LogicalProcessors[i];
+      NS_TEST_BOOL(lp.m_uiCore < topology.m_uiNumCores);
+      NS_TEST_BOOL(lp.m_uiCacheDomain < topology.m_uiNumCacheDomains);
+      NS_TEST_BOOL(lp.m_uiPackage < topology.m_uiNumPackages);
+
+      if (i > 0)
+      {
+        NS_TEST_BOOL(lp.m_uiProcessorIndex > topology.m_LogicalProcessors[i - 1].m_uiProcessorIndex);
+      }
+    }
+
+    NS_TEST_BOOL(!nsTaskSystem::GetWorkerThreadPinning());
+    NS_TEST_BOOL(!nsTaskSystem::GetWorkerThreadPlacement(nsWorkerThreadType::ShortTasks, 0).IsPinned());
+
+    nsTaskSystem::SetWorkerThreadPinning(true);
+    NS_TEST_BOOL(nsTaskSystem::GetWorkerThreadPinning());
+    NS_TEST_INT(nsTaskSystem::GetWorkerThreadCount(nsWorkerThreadType::ShortTasks), iWorkersShort);
+    NS_TEST_INT(nsTaskSystem::GetWorkerThreadCount(nsWorkerThreadType::LongTasks), iWorkersLong);
+
+    // give the threads time to start and pin themselves
+    nsAtomicInteger32 iCounter;
+    nsTaskSystem::ParallelForIndexed(0u, 1000u, [&](nsUInt32 uiStart, nsUInt32 uiEnd)
+      { iCounter.Add(uiEnd - uiStart); });
+    NS_TEST_INT(iCounter, 1000);
+    nsThreadUtils::Sleep(nsTime::MakeFromMilliseconds(100));
+
+    for (nsUInt32 i = 0; i < nsTaskSystem::GetNumAllocatedWorkerThreads(nsWorkerThreadType::ShortTasks); ++i)
+    {
+      const nsTaskWorkerPlacement placement = nsTaskSystem::GetWorkerThreadPlacement(nsWorkerThreadType::ShortTasks, i);
+
+      // pinning may not be supported, but if it is, the placement has to match the topology
+      if (placement.IsPinned())
+      {
+        bool bFound = false;
+        for (nsUInt32 lp = 0; lp < topology.m_uiNumLogicalProcessors; ++lp)
+        {
+          if (topology.m_LogicalProcessors[lp].m_uiProcessorIndex == static_cast<nsUInt32>(placement.m_iProcessorIndex))
+          {
+            bFound = true;
+            NS_TEST_INT(topology.m_LogicalProcessors[lp].m_uiCore, placement.m_iCore);
+            NS_TEST_INT(topology.m_LogicalProcessors[lp].m_uiCacheDomain, placement.m_iCacheDomain);
+            NS_TEST_INT(topology.m_LogicalProcessors[lp].m_uiPackage, placement.m_iPackage);
+          }
+        }
+
+        NS_TEST_BOOL(bFound);
+      }
+    }
+
+    for (nsUInt32 i = 0; i < nsTaskSystem::GetNumAllocatedWorkerThreads(nsWorkerThreadType::LongTasks); ++i)
+    {
+      NS_TEST_BOOL(!nsTaskSystem::GetWorkerThreadPlacement(nsWorkerThreadType::LongTasks, i).IsPinned());
+    }
+
+    nsTaskSystem::SetWorkerThreadPinning(false);
+    NS_TEST_BOOL(!nsTaskSystem::GetWorkerThreadPinning());
+    NS_TEST_BOOL(!nsTaskSystem::GetWorkerThreadPlacement(nsWorkerThreadType::ShortTasks, 0).IsPinned());
+    NS_TEST_INT(nsTaskSystem::GetWorkerThreadCount(nsWorkerThreadType::ShortTasks), iWorkersShort);
+  }
+
   // capture profiling info for testing
   /*nsStringBuilder sOutputPath = nsTestFramework::GetInstance()->GetAbsOutputPath();
 
@@ -1,7 +1,9 @@
 #include <FoundationTest/FoundationTestPCH.h>
 
 #include <Foundation/Profiling/Profiling.h>
+#include <Foundation/Threading/Lock.h>
 #include <Foundation/Threading/Mutex.h>
+#include <Foundation/Threading/Semaphore.h>
 #include <Foundation/Threading/Thread.h>
 #include <Foundation/Time/Time.h>
 
@@ -45,6 +47,38 @@ namespace
       return 0;
     }
   };
+
+  class LockingThread : public nsThread
+  {
+  public:
+    LockingThread()
+      : nsThread("Locking Thread")
+    {
+    }
+
+    nsMutex* m_pMutex = nullptr;
+    nsSemaphore* m_pSemaphore = nullptr;
+    nsUInt32* m_pCounter = nullptr;
+
+    virtual nsUInt32 Run()
+    {
+      for (nsUInt32 i = 0; i < 10000; ++i)
+      {
+        // locked recursively, the counter itself is not atomic
+        NS_LOCK(*m_pMutex);
+        NS_LOCK(*m_pMutex);
+        ++(*m_pCounter);
+      }
+
+      // hand out one token per iteration, the main thread waits for all of them
+      for (nsUInt32 i = 0; i < 1000; ++i)
+      {
+        m_pSemaphore->ReturnToken();
+      }
+
+      return 0;
+    }
+  };
 } // namespace
 
 NS_CREATE_SIMPLE_TEST_GROUP(Threading);
@@ -113,6 +147,42 @@ NS_CREATE_SIMPLE_TEST(Threading, Thread)
     NS_TEST_INT(g_iCrossThreadVariable, g_uiIncrementSteps * 2 + 1);
   }
 
+  NS_TEST_BLOCK(nsTestBlock::Enabled, "Contended Mutex and Semaphore")
+  {
+    nsMutex mutex;
+    nsSemaphore semaphore;
+    NS_TEST_BOOL(semaphore.Create(0).Succeeded());
+    NS_TEST_BOOL(semaphore.TryAcquireToken().Failed());
+
+    nsUInt32 uiCounter = 0;
+
+    LockingThread threads[4];
+    for (LockingThread& thread : threads)
+    {
+      thread.m_pMutex = &mutex;
+      thread.m_pSemaphore = &semaphore;
+      thread.m_pCounter = &uiCounter;
+      thread.Start();
+    }
+
+    for (nsUInt32 i = 0; i < 4 * 1000; ++i)
+    {
+      semaphore.AcquireToken();
+    }
+
+    for (LockingThread& thread : threads)
+    {
+      thread.Join();
+    }
+
+    NS_TEST_INT(uiCounter, 4 * 10000);
+    NS_TEST_BOOL(!mutex.IsLocked());
+    NS_TEST_BOOL(semaphore.TryAcquireToken().Failed());
+
+    semaphore.ReturnToken();
+    NS_TEST_BOOL(semaphore.TryAcquireToken().Succeeded());
+  }
+
   NS_TEST_BLOCK(nsTestBlock::Enabled, "Thread Sleeping")
   {
     const nsTime start = nsTime::Now();